@@ -96,6 +96,7 @@ void NotificationController::Shutdown() {
   mPresShell = nullptr;
 
   mTextHash.Clear();
+  mPendingInsertions.Clear();
   mContentInsertions.Clear();
   mNotifications.Clear();
   mEvents.Clear();
@@ -430,6 +431,23 @@ void NotificationController::ScheduleContentInsertion(
   }
 }
 
+void NotificationController::ScheduleContentInsertion(
+    nsIContent* aStartChildNode, nsIContent* aEndChildNode) {
+  // The frame constructor guarantees that only ranges with the same parent
+  // arrive here in presence of dynamic changes to the page, see
+  // nsCSSFrameConstructor::IssueSingleInsertNotifications' callers.
+  bool scheduled = false;
+  for (nsIContent* node = aStartChildNode; node != aEndChildNode;
+       node = node->GetNextSibling()) {
+    mPendingInsertions.AppendElement(node);
+    scheduled = true;
+  }
+
+  if (scheduled) {
+    ScheduleProcessing();
+  }
+}
+
 void NotificationController::ScheduleProcessing() {
   // If notification flush isn't planed yet start notification flush
   // asynchronously (after style and layout).
@@ -447,7 +465,7 @@ bool NotificationController::IsUpdatePending() {
   return mPresShell->IsLayoutFlushObserver() ||
          mObservingState == eRefreshProcessingForUpdate || WaitingForParent() ||
          mContentInsertions.Count() != 0 || mNotifications.Length() != 0 ||
-         mTextHash.Count() != 0 ||
+         mPendingInsertions.Length() != 0 || mTextHash.Count() != 0 ||
          !mDocument->HasLoadState(DocAccessible::eTreeConstructed);
 }
 
@@ -649,6 +667,20 @@ void NotificationController::WillRefresh(mozilla::TimeStamp aTime) {
                  "isn't created!");
   }
 
+  // Run the pruning walk over content insertions accumulated since the last
+  // tick and group the surviving insertion roots by their container
+  // accessible. This happens before rendered text processing since the latter
+  // may schedule more insertions for containers discovered here.
+  if (!mPendingInsertions.IsEmpty()) {
+    nsTArray<nsCOMPtr<nsIContent>> insertions(std::move(mPendingInsertions));
+    for (uint32_t idx = 0; idx < insertions.Length(); idx++) {
+      mDocument->ProcessPendingInsertion(insertions[idx]);
+      if (!mDocument) {
+        return;
+      }
+    }
+  }
+
   // Process rendered text change notifications.
   for (auto iter = mTextHash.Iter(); !iter.Done(); iter.Next()) {
     nsCOMPtrHashKey<nsIContent>* entry = iter.Get();
@@ -194,6 +194,15 @@ class NotificationController final : public EventQueue,
   void ScheduleContentInsertion(Accessible* aContainer,
                                 nsTArray<nsCOMPtr<nsIContent>>& aInsertions);
 
+  /**
+   * Pend accessible tree update for a range of inserted siblings. The
+   * pruning walk over the inserted subtrees is deferred to the refresh tick,
+   * so a burst of frame construction notifications is handled in a single
+   * pass over the accumulated set.
+   */
+  void ScheduleContentInsertion(nsIContent* aStartChildNode,
+                                nsIContent* aEndChildNode);
+
   /**
    * Pend an accessible subtree relocation.
    */
@@ -364,6 +373,13 @@ class NotificationController final : public EventQueue,
   nsClassHashtable<nsRefPtrHashKey<Accessible>, nsTArray<nsCOMPtr<nsIContent>>>
       mContentInsertions;
 
+  /**
+   * Scheduled insertion roots that are still waiting for the pruning walk.
+   * The walk runs once per refresh tick and groups the surviving roots into
+   * mContentInsertions.
+   */
+  nsTArray<nsCOMPtr<nsIContent>> mPendingInsertions;
+
   template <class T>
   class nsCOMPtrHashKey : public PLDHashEntryHdr {
    public:
@@ -1370,10 +1370,18 @@ void DocAccessible::ContentInserted(nsIContent* aStartChildNode,
     return;
   }
 
-  // The frame constructor guarantees that only ranges with the same parent
-  // arrive here in presence of dynamic changes to the page, see
-  // nsCSSFrameConstructor::IssueSingleInsertNotifications' callers.
-  nsINode* parent = aStartChildNode->GetFlattenedTreeParentNode();
+  // Don't walk the inserted subtrees here; the frame constructor may fire a
+  // burst of these notifications for a single DOM change. The pruning walk
+  // runs once per refresh tick over the accumulated set, see
+  // ProcessPendingInsertion.
+  mNotificationController->ScheduleContentInsertion(aStartChildNode,
+                                                    aEndChildNode);
+}
+
+void DocAccessible::ProcessPendingInsertion(nsIContent* aChildNode) {
+  // The node may have been removed or reparented since the insertion was
+  // scheduled, so re-derive its container from the current DOM state.
+  nsINode* parent = aChildNode->GetFlattenedTreeParentNode();
   if (!parent) {
     return;
   }
@@ -1383,16 +1391,11 @@ void DocAccessible::ContentInserted(nsIContent* aStartChildNode,
     return;
   }
 
-  AutoTArray<nsCOMPtr<nsIContent>, 10> list;
-  for (nsIContent* node = aStartChildNode; node != aEndChildNode;
-       node = node->GetNextSibling()) {
-    MOZ_ASSERT(parent == node->GetFlattenedTreeParentNode());
-    if (PruneOrInsertSubtree(node)) {
-      list.AppendElement(node);
-    }
+  if (PruneOrInsertSubtree(aChildNode)) {
+    AutoTArray<nsCOMPtr<nsIContent>, 1> list;
+    list.AppendElement(aChildNode);
+    mNotificationController->ScheduleContentInsertion(container, list);
   }
-
-  mNotificationController->ScheduleContentInsertion(container, list);
 }
 
 bool DocAccessible::PruneOrInsertSubtree(nsIContent* aRoot) {
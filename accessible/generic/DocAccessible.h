@@ -490,6 +490,13 @@ class DocAccessible : public HyperTextAccessibleWrap,
   void ProcessContentInserted(Accessible* aContainer,
                               nsIContent* aInsertedContent);
 
+  /**
+   * Run the pruning walk for an insertion root scheduled by ContentInserted()
+   * and pend surviving roots under their container accessible, called from
+   * the notification controller on the refresh tick.
+   */
+  void ProcessPendingInsertion(nsIContent* aChildNode);
+
   /**
    * Used to notify the document to make it process the invalidation list.
    *
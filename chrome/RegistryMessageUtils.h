@@ -7,6 +7,7 @@
 #define mozilla_RegistryMessageUtils_h
 
 #include "ipc/IPCMessageUtils.h"
+#include "nsReadableUtils.h"
 #include "nsString.h"
 
 struct SerializedURI {
@@ -32,6 +33,58 @@ struct ChromePackage {
   }
 };
 
+// The package mapping table is shipped to content processes as a read-only
+// SharedStringMap snapshot keyed on package name. Each value encodes the
+// package's flags in decimal, followed by the content, locale and skin base
+// URI specs, separated by the unit separator character (which can never
+// occur in a serialized URI).
+constexpr char16_t kChromePackageFieldSep = 0x1f;
+
+inline void EncodeChromePackageValue(const ChromePackage& aPackage,
+                                     nsString& aResult) {
+  aResult.Truncate();
+  aResult.AppendInt(aPackage.flags);
+  aResult.Append(kChromePackageFieldSep);
+  AppendUTF8toUTF16(aPackage.contentBaseURI.spec, aResult);
+  aResult.Append(kChromePackageFieldSep);
+  AppendUTF8toUTF16(aPackage.localeBaseURI.spec, aResult);
+  aResult.Append(kChromePackageFieldSep);
+  AppendUTF8toUTF16(aPackage.skinBaseURI.spec, aResult);
+}
+
+// Decodes a value produced by EncodeChromePackageValue into aPackage,
+// leaving aPackage.package untouched. Returns false if the value is
+// malformed.
+inline bool DecodeChromePackageValue(const nsAString& aValue,
+                                     ChromePackage& aPackage) {
+  int32_t flagsEnd = aValue.FindChar(kChromePackageFieldSep);
+  if (flagsEnd < 0) {
+    return false;
+  }
+  int32_t contentEnd = aValue.FindChar(kChromePackageFieldSep, flagsEnd + 1);
+  if (contentEnd < 0) {
+    return false;
+  }
+  int32_t localeEnd = aValue.FindChar(kChromePackageFieldSep, contentEnd + 1);
+  if (localeEnd < 0) {
+    return false;
+  }
+
+  nsresult rv;
+  aPackage.flags =
+      nsAutoString(Substring(aValue, 0, flagsEnd)).ToInteger(&rv);
+  if (NS_FAILED(rv)) {
+    return false;
+  }
+
+  CopyUTF16toUTF8(Substring(aValue, flagsEnd + 1, contentEnd - flagsEnd - 1),
+                  aPackage.contentBaseURI.spec);
+  CopyUTF16toUTF8(Substring(aValue, contentEnd + 1, localeEnd - contentEnd - 1),
+                  aPackage.localeBaseURI.spec);
+  CopyUTF16toUTF8(Substring(aValue, localeEnd + 1), aPackage.skinBaseURI.spec);
+  return true;
+}
+
 struct SubstitutionMapping {
   nsCString scheme;
   nsCString path;
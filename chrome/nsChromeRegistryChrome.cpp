@@ -40,6 +40,8 @@
 using namespace mozilla;
 using mozilla::dom::ContentParent;
 using mozilla::dom::PContentParent;
+using mozilla::dom::ipc::SharedStringMap;
+using mozilla::dom::ipc::SharedStringMapBuilder;
 using mozilla::intl::LocaleService;
 
 // We use a "best-fit" algorithm for matching locales and themes.
@@ -209,6 +211,7 @@ nsChromeRegistryChrome::CheckForNewChrome() {
   }
 
   mPackagesHash.Clear();
+  mPackagesMap = nullptr;
   mOverrideTable.Clear();
 
   mDynamicRegistration = false;
@@ -227,18 +230,34 @@ static void SerializeURI(nsIURI* aURI, SerializedURI& aSerializedURI) {
   aURI->GetSpec(aSerializedURI.spec);
 }
 
+RefPtr<SharedStringMap> nsChromeRegistryChrome::GetPackagesMap() {
+  if (!mPackagesMap) {
+    SharedStringMapBuilder builder;
+    for (auto iter = mPackagesHash.Iter(); !iter.Done(); iter.Next()) {
+      ChromePackage chromePackage;
+      ChromePackageFromPackageEntry(iter.Key(), iter.UserData(),
+                                    &chromePackage, SKIN);
+
+      nsAutoString value;
+      EncodeChromePackageValue(chromePackage, value);
+      builder.Add(nsCString(iter.Key()), value);
+    }
+    mPackagesMap = new SharedStringMap(std::move(builder));
+  }
+  return mPackagesMap;
+}
+
 void nsChromeRegistryChrome::SendRegisteredChrome(
     mozilla::dom::PContentParent* aParent) {
-  nsTArray<ChromePackage> packages;
   nsTArray<SubstitutionMapping> resources;
   nsTArray<OverrideMapping> overrides;
 
-  for (auto iter = mPackagesHash.Iter(); !iter.Done(); iter.Next()) {
-    ChromePackage chromePackage;
-    ChromePackageFromPackageEntry(iter.Key(), iter.UserData(), &chromePackage,
-                                  SKIN);
-    packages.AppendElement(chromePackage);
+  // A reset broadcast follows a locale or skin change, which alters the
+  // provider URIs baked into the snapshot, so always rebuild it.
+  if (!aParent) {
+    mPackagesMap = nullptr;
   }
+  RefPtr<SharedStringMap> packagesMap = GetPackagesMap();
 
   // If we were passed a parent then a new child process has been created and
   // has requested all of the chrome so send it the resources too. Otherwise
@@ -271,8 +290,9 @@ void nsChromeRegistryChrome::SendRegisteredChrome(
   LocaleService::GetInstance()->GetAppLocaleAsBCP47(appLocale);
 
   if (aParent) {
-    bool success = aParent->SendRegisterChrome(packages, resources, overrides,
-                                               appLocale, false);
+    bool success = aParent->SendRegisterChrome(
+        packagesMap->CloneFileDescriptor(), packagesMap->MapSize(), resources,
+        overrides, appLocale, false);
     NS_ENSURE_TRUE_VOID(success);
   } else {
     nsTArray<ContentParent*> parents;
@@ -281,7 +301,8 @@ void nsChromeRegistryChrome::SendRegisteredChrome(
 
     for (uint32_t i = 0; i < parents.Length(); i++) {
       DebugOnly<bool> success = parents[i]->SendRegisterChrome(
-          packages, resources, overrides, appLocale, true);
+          packagesMap->CloneFileDescriptor(), packagesMap->MapSize(),
+          resources, overrides, appLocale, true);
       NS_WARNING_ASSERTION(success,
                            "couldn't reset a child's registered chrome");
     }
@@ -479,6 +500,7 @@ void nsChromeRegistryChrome::ManifestContent(ManifestProcessingContext& cx,
   PackageEntry* entry = mPackagesHash.LookupOrAdd(packageName);
   entry->baseURI = resolved;
   entry->flags = flags;
+  mPackagesMap = nullptr;
 
   if (mDynamicRegistration) {
     ChromePackage chromePackage;
@@ -515,6 +537,7 @@ void nsChromeRegistryChrome::ManifestLocale(ManifestProcessingContext& cx,
   nsDependentCString packageName(package);
   PackageEntry* entry = mPackagesHash.LookupOrAdd(packageName);
   entry->locales.SetBase(nsDependentCString(provider), resolved);
+  mPackagesMap = nullptr;
 
   if (mDynamicRegistration) {
     ChromePackage chromePackage;
@@ -560,6 +583,7 @@ void nsChromeRegistryChrome::ManifestSkin(ManifestProcessingContext& cx,
   nsDependentCString packageName(package);
   PackageEntry* entry = mPackagesHash.LookupOrAdd(packageName);
   entry->skins.SetBase(nsDependentCString(provider), resolved);
+  mPackagesMap = nullptr;
 
   if (mDynamicRegistration) {
     ChromePackage chromePackage;
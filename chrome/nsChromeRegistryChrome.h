@@ -12,6 +12,7 @@
 #include "nsChromeRegistry.h"
 #include "nsClassHashtable.h"
 #include "nsTArray.h"
+#include "mozilla/dom/ipc/SharedStringMap.h"
 
 namespace mozilla {
 namespace dom {
@@ -49,6 +50,13 @@ class nsChromeRegistryChrome : public nsChromeRegistry {
                                             ChromePackage* aChromePackage,
                                             const nsCString& aSelectedSkin);
 
+  // Returns the shared memory snapshot of the package mapping table which
+  // content processes consult for chrome URI resolution, building it from
+  // mPackagesHash if no current snapshot exists. The snapshot bakes in the
+  // current app locale and skin, so it is dropped whenever the registry
+  // contents change; reset broadcasts then deliver the rebuilt map.
+  RefPtr<mozilla::dom::ipc::SharedStringMap> GetPackagesMap();
+
   nsresult OverrideLocalePackage(const nsACString& aPackage,
                                  nsACString& aOverride);
   nsIURI* GetBaseURIFromPackage(const nsCString& aPackage,
@@ -106,6 +114,10 @@ class nsChromeRegistryChrome : public nsChromeRegistry {
   // Hash of package names ("global") to PackageEntry objects
   nsClassHashtable<nsCStringHashKey, PackageEntry> mPackagesHash;
 
+  // Lazily built read-only snapshot of mPackagesHash shared with content
+  // processes. Null whenever the hash has changed since the last build.
+  RefPtr<mozilla::dom::ipc::SharedStringMap> mPackagesMap;
+
   virtual void ManifestContent(ManifestProcessingContext& cx, int lineno,
                                char* const* argv, int flags) override;
   virtual void ManifestLocale(ManifestProcessingContext& cx, int lineno,
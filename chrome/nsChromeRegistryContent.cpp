@@ -12,7 +12,7 @@
 nsChromeRegistryContent::nsChromeRegistryContent() {}
 
 void nsChromeRegistryContent::RegisterRemoteChrome(
-    const nsTArray<ChromePackage>& aPackages,
+    const mozilla::ipc::FileDescriptor& aPackagesMap, uint32_t aPackagesMapSize,
     const nsTArray<SubstitutionMapping>& aSubstitutions,
     const nsTArray<OverrideMapping>& aOverrides, const nsACString& aLocale,
     bool aReset) {
@@ -24,9 +24,9 @@ void nsChromeRegistryContent::RegisterRemoteChrome(
     // XXX Can't clear resources.
   }
 
-  for (uint32_t i = aPackages.Length(); i > 0;) {
-    --i;
-    RegisterPackage(aPackages[i]);
+  if (aPackagesMapSize) {
+    mPackagesMap = new mozilla::dom::ipc::SharedStringMap(aPackagesMap,
+                                                          aPackagesMapSize);
   }
 
   for (uint32_t i = aSubstitutions.Length(); i > 0;) {
@@ -106,11 +106,43 @@ void nsChromeRegistryContent::RegisterOverride(
   mOverrideTable.Put(chromeURI, overrideURI);
 }
 
+nsChromeRegistryContent::PackageEntry* nsChromeRegistryContent::GetPackageEntry(
+    const nsCString& aPackage) {
+  PackageEntry* entry;
+  if (mPackagesHash.Get(aPackage, &entry)) {
+    return entry;
+  }
+
+  // Not seen yet; decode the package's record from the shared snapshot, if
+  // there is one, and cache the parsed URIs so that repeated lookups don't
+  // re-parse the specs.
+  if (!mPackagesMap) {
+    return nullptr;
+  }
+
+  nsAutoString value;
+  if (!mPackagesMap->Get(aPackage, value)) {
+    return nullptr;
+  }
+
+  ChromePackage chromePackage;
+  if (NS_WARN_IF(!DecodeChromePackageValue(value, chromePackage))) {
+    return nullptr;
+  }
+  chromePackage.package = aPackage;
+
+  RegisterPackage(chromePackage);
+  if (!mPackagesHash.Get(aPackage, &entry)) {
+    return nullptr;
+  }
+  return entry;
+}
+
 nsIURI* nsChromeRegistryContent::GetBaseURIFromPackage(
     const nsCString& aPackage, const nsCString& aProvider,
     const nsCString& aPath) {
-  PackageEntry* entry;
-  if (!mPackagesHash.Get(aPackage, &entry)) {
+  PackageEntry* entry = GetPackageEntry(aPackage);
+  if (!entry) {
     return nullptr;
   }
 
@@ -126,8 +158,8 @@ nsIURI* nsChromeRegistryContent::GetBaseURIFromPackage(
 
 nsresult nsChromeRegistryContent::GetFlagsFromPackage(const nsCString& aPackage,
                                                       uint32_t* aFlags) {
-  PackageEntry* entry;
-  if (!mPackagesHash.Get(aPackage, &entry)) {
+  PackageEntry* entry = GetPackageEntry(aPackage);
+  if (!entry) {
     return NS_ERROR_FAILURE;
   }
   *aFlags = entry->flags;
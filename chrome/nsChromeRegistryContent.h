@@ -8,6 +8,7 @@
 
 #include "nsChromeRegistry.h"
 #include "nsClassHashtable.h"
+#include "mozilla/dom/ipc/SharedStringMap.h"
 
 struct ChromePackage;
 struct SubstitutionMapping;
@@ -17,7 +18,8 @@ class nsChromeRegistryContent : public nsChromeRegistry {
  public:
   nsChromeRegistryContent();
 
-  void RegisterRemoteChrome(const nsTArray<ChromePackage>& aPackages,
+  void RegisterRemoteChrome(const mozilla::ipc::FileDescriptor& aPackagesMap,
+                            uint32_t aPackagesMapSize,
                             const nsTArray<SubstitutionMapping>& aResources,
                             const nsTArray<OverrideMapping>& aOverrides,
                             const nsACString& aLocale, bool aReset);
@@ -50,7 +52,21 @@ class nsChromeRegistryContent : public nsChromeRegistry {
   nsresult GetFlagsFromPackage(const nsCString& aPackage,
                                uint32_t* aFlags) override;
 
+  // Returns the entry for aPackage, either from mPackagesHash or, on first
+  // use of a package, by decoding its record from the shared snapshot and
+  // caching the parsed URIs in the hash. Dynamically registered packages
+  // live only in the hash, which is consulted first, so they take
+  // precedence over the snapshot.
+  PackageEntry* GetPackageEntry(const nsCString& aPackage);
+
+  // Chrome package entries which have either been looked up already or were
+  // delivered by a dynamic registration after startup.
   nsClassHashtable<nsCStringHashKey, PackageEntry> mPackagesHash;
+
+  // Read-only snapshot of the parent's package mapping table, shared with
+  // every content process.
+  RefPtr<mozilla::dom::ipc::SharedStringMap> mPackagesMap;
+
   nsCString mLocale;
 
   virtual void ManifestContent(ManifestProcessingContext& cx, int lineno,
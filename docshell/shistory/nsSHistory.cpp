@@ -1257,6 +1257,21 @@ void nsSHistory::EvictOutOfRangeWindowContentViewers(int32_t aIndex) {
       EvictContentViewerForEntry(entry);
     }
   }
+
+  // Entries outside the safe range won't need their layout history state
+  // (scroll positions and form state) until the user navigates back to them,
+  // so pack it into its compact serialized form. It is inflated again
+  // transparently on first access.
+  for (int32_t i = 0; i < Length(); i++) {
+    if (i >= startSafeIndex && i <= endSafeIndex) {
+      continue;
+    }
+    nsCOMPtr<nsILayoutHistoryState> layoutState;
+    mEntries[i]->GetLayoutHistoryState(getter_AddRefs(layoutState));
+    if (layoutState) {
+      layoutState->Compact();
+    }
+  }
 }
 
 namespace {
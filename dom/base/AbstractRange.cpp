@@ -78,7 +78,10 @@ NS_IMPL_CYCLE_COLLECTION_TRACE_WRAPPERCACHE(AbstractRange)
 // NOTE: If you need to change default value of members of AbstractRange,
 //       update nsRange::Create(nsINode* aNode) and ClearForReuse() too.
 AbstractRange::AbstractRange(nsINode* aNode)
-    : mIsPositioned(false), mIsGenerated(false), mCalledByJS(false) {
+    : mIsPositioned(false),
+      mIsGenerated(false),
+      mCalledByJS(false),
+      mNotifySelectionListenersPending(false) {
   Init(aNode);
 }
 
@@ -219,6 +222,7 @@ void AbstractRange::ClearForReuse() {
   mIsPositioned = false;
   mIsGenerated = false;
   mCalledByJS = false;
+  mNotifySelectionListenersPending = false;
 }
 
 }  // namespace mozilla::dom
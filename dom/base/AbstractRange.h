@@ -122,6 +122,10 @@ class AbstractRange : public nsISupports, public nsWrapperCache {
   bool mIsGenerated;
   // Used by nsRange, but this should have this for minimizing the size.
   bool mCalledByJS;
+  // Used by nsRange to coalesce the selection listener notifications it
+  // queues from DoSetRange: while one is pending, further boundary updates
+  // (e.g. during a bulk edit mutating the range repeatedly) don't queue more.
+  bool mNotifySelectionListenersPending;
 
   static bool sHasShutDown;
 };
@@ -29,6 +29,7 @@
 #include "nsIStreamLoader.h"
 #include "nsNetUtil.h"
 #include "nsProxyRelease.h"
+#include "nsThreadUtils.h"
 
 // Undefine the macro of CreateFile to avoid FileCreatorHelper#CreateFile being
 // replaced by FileCreatorHelper#CreateFileW.
@@ -40,6 +41,11 @@ namespace mozilla::dom {
 
 namespace {
 
+// Bodies smaller than this are decoded to UTF-16 directly on the target
+// thread; below this size the round trip through a background thread costs
+// more than the decode itself.
+constexpr uint32_t kOffThreadDecodeThreshold = 16 * 1024;
+
 class BeginConsumeBodyRunnable final : public Runnable {
  public:
   BeginConsumeBodyRunnable(BodyConsumer* aConsumer,
@@ -213,6 +219,14 @@ class ConsumeBodyDoneObserver final : public nsIStreamLoaderObserver,
 
     // Main-thread.
     if (!mWorkerRef) {
+      // Large text/JSON bodies are decoded to UTF-16 on a background thread
+      // first, so the main thread only pays for the parse.
+      if (mBodyConsumer->BeginOffThreadDecode(aStatus, aResultLength,
+                                              nonconstResult)) {
+        // The decode task took ownership of the data.
+        return NS_SUCCESS_ADOPTED_DATA;
+      }
+
       mBodyConsumer->ContinueConsumeBody(aStatus, aResultLength,
                                          nonconstResult);
       // The caller is responsible for data.
@@ -631,6 +645,51 @@ void BodyConsumer::DispatchContinueConsumeBlobBody(
   Unused << NS_WARN_IF(!r->Dispatch());
 }
 
+/*
+ * For text and JSON consumers the UTF-8 -> UTF-16 decode of the body is the
+ * bulk of the work left on the target thread once the network read has
+ * finished. When a main-thread consumer's body is large enough, run the
+ * decode on a background thread and come back to the target thread with the
+ * ready-made UTF-16 buffer, so ContinueConsumeBody() (and JS_ParseJSON for
+ * CONSUME_JSON) only pays for the parse itself. Worker consumers already
+ * decode off the main thread on their own thread, so they keep the direct
+ * path.
+ */
+bool BodyConsumer::BeginOffThreadDecode(nsresult aStatus, uint32_t aLength,
+                                        uint8_t* aResult) {
+  MOZ_ASSERT(NS_IsMainThread());
+
+  if (mConsumeType != CONSUME_TEXT && mConsumeType != CONSUME_JSON) {
+    return false;
+  }
+
+  if (NS_FAILED(aStatus) || aLength < kOffThreadDecodeThreshold) {
+    return false;
+  }
+
+  RefPtr<BodyConsumer> self = this;
+  nsresult rv = NS_DispatchBackgroundTask(NS_NewRunnableFunction(
+      "BodyConsumer::OffThreadDecode", [self, aStatus, aLength, aResult]() {
+        nsString decoded;
+        nsresult rv = BodyUtil::ConsumeText(aLength, aResult, decoded);
+        free(aResult);
+
+        nsCOMPtr<nsIRunnable> r = NS_NewRunnableFunction(
+            "BodyConsumer::ContinueConsumeDecodedBody",
+            [self, aStatus, rv, decoded = std::move(decoded)]() mutable {
+              if (NS_FAILED(rv)) {
+                self->ContinueConsumeBody(rv, 0, nullptr);
+                return;
+              }
+
+              self->mDecodedText.emplace(std::move(decoded));
+              self->ContinueConsumeBody(aStatus, 0, nullptr);
+            });
+        self->mTargetThread->Dispatch(r.forget(), NS_DISPATCH_NORMAL);
+      }));
+  return NS_SUCCEEDED(rv);
+}
+
 /*
  * ContinueConsumeBody() is to be called on the target thread whenever the
  * final result of the fetch is known. The fetch promise is resolved or
@@ -678,7 +737,7 @@ void BodyConsumer::ContinueConsumeBody(nsresult aStatus, uint32_t aResultLength,
   }
 
   // Finish successfully consuming body according to type.
-  MOZ_ASSERT(aResult);
+  MOZ_ASSERT(aResult || mDecodedText.isSome());
 
   AutoJSAPI jsapi;
   if (!jsapi.Init(mGlobal)) {
@@ -725,8 +784,13 @@ void BodyConsumer::ContinueConsumeBody(nsresult aStatus, uint32_t aResultLength,
       // fall through handles early exit.
     case CONSUME_JSON: {
       nsString decoded;
-      if (NS_SUCCEEDED(
-              BodyUtil::ConsumeText(aResultLength, aResult, decoded))) {
+      nsresult rv = NS_OK;
+      if (mDecodedText.isSome()) {
+        decoded = mDecodedText.extract();
+      } else {
+        rv = BodyUtil::ConsumeText(aResultLength, aResult, decoded);
+      }
+      if (NS_SUCCEEDED(rv)) {
         if (mConsumeType == CONSUME_TEXT) {
           localPromise->MaybeResolve(decoded);
         } else {
@@ -9,6 +9,7 @@
 
 #include "mozilla/dom/AbortSignal.h"
 #include "mozilla/dom/MutableBlobStorage.h"
+#include "mozilla/Maybe.h"
 #include "nsIInputStreamPump.h"
 #include "nsIObserver.h"
 #include "nsWeakReference.h"
@@ -76,6 +77,17 @@ class BodyConsumer final : public nsIObserver,
   void ContinueConsumeBody(nsresult aStatus, uint32_t aLength, uint8_t* aResult,
                            bool aShuttingDown = false);
 
+  /**
+   * For large CONSUME_TEXT/CONSUME_JSON bodies consumed on the main thread,
+   * moves the UTF-8 -> UTF-16 decode of the completed body to a background
+   * thread and re-dispatches to the target thread with the decoded buffer in
+   * mDecodedText. Returns false when the body should instead be handed to
+   * ContinueConsumeBody() directly; returns true when the decode task has
+   * taken ownership of aResult.
+   */
+  bool BeginOffThreadDecode(nsresult aStatus, uint32_t aLength,
+                            uint8_t* aResult);
+
   void ContinueConsumeBlobBody(BlobImpl* aBlobImpl, bool aShuttingDown = false);
 
   void DispatchContinueConsumeBlobBody(BlobImpl* aBlobImpl,
@@ -129,6 +141,11 @@ class BodyConsumer final : public nsIObserver,
   // touched only on the target thread.
   bool mBodyConsumed;
 
+  // UTF-16 body decoded off the main thread by BeginOffThreadDecode(), set
+  // just before ContinueConsumeBody() runs. Touched only on the target
+  // thread.
+  Maybe<nsString> mDecodedText;
+
   // touched only on the main-thread.
   bool mShuttingDown;
 };
@@ -111,6 +111,7 @@
 #include "mozilla/StaticAnalysisFunctions.h"
 #include "mozilla/StaticPrefs_apz.h"
 #include "mozilla/StaticPrefs_browser.h"
+#include "mozilla/StaticPrefs_docshell.h"
 #include "mozilla/StaticPrefs_dom.h"
 #include "mozilla/StaticPrefs_full_screen_api.h"
 #include "mozilla/StaticPrefs_layout.h"
@@ -1258,6 +1259,117 @@ void Document::SelectorCache::NotifyExpired(SelectorCacheKey* aSelector) {
   delete aSelector;
 }
 
+// Bounds for the innerHTML fragment cache. Widget-framework templates are
+// short and few; anything beyond this is unlikely to be assigned repeatedly
+// and would just hold on to memory.
+static const size_t kInnerHTMLFragmentCacheMaxEntries = 8;
+static const size_t kInnerHTMLFragmentCacheMaxMarkupLength = 1024;
+
+// Whether a freshly parsed innerHTML subtree can be cached and later deep
+// cloned in place of reparsing without observable differences. Scripts are
+// excluded because a clone would have to replicate their already-started
+// state, custom elements because parsing and cloning enqueue different
+// reactions, and browsing-context containers because cloning them clones
+// loaded state rather than starting a fresh load.
+static bool IsCacheableInnerHTMLContent(nsIContent* aParent) {
+  for (nsIContent* node = aParent->GetFirstChild(); node;
+       node = node->GetNextNode(aParent)) {
+    if (!node->IsElement()) {
+      continue;
+    }
+    if (node->IsAnyOfHTMLElements(nsGkAtoms::script, nsGkAtoms::iframe,
+                                  nsGkAtoms::frame, nsGkAtoms::embed,
+                                  nsGkAtoms::object)) {
+      return false;
+    }
+    if (node->AsElement()->HasAttr(kNameSpaceID_None, nsGkAtoms::is) ||
+        nsContentUtils::IsCustomElementName(node->NodeInfo()->NameAtom(),
+                                            node->GetNameSpaceID())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+already_AddRefed<DocumentFragment> Document::GetCachedInnerHTMLFragment(
+    const nsAString& aMarkup, nsAtom* aContextLocalName,
+    int32_t aContextNamespace, bool aQuirks) {
+  for (size_t i = 0; i < mInnerHTMLFragmentCache.Length(); ++i) {
+    InnerHTMLFragmentCacheEntry& entry = mInnerHTMLFragmentCache[i];
+    if (entry.mContextLocalName == aContextLocalName &&
+        entry.mContextNamespace == aContextNamespace &&
+        entry.mQuirks == aQuirks && entry.mMarkup.Equals(aMarkup)) {
+      if (!entry.mFragment) {
+        return nullptr;
+      }
+      RefPtr<DocumentFragment> fragment = entry.mFragment;
+      // Keep the list in most-recently-used order.
+      if (i != 0) {
+        InnerHTMLFragmentCacheEntry moved = std::move(entry);
+        mInnerHTMLFragmentCache.RemoveElementAt(i);
+        mInnerHTMLFragmentCache.InsertElementAt(0, std::move(moved));
+      }
+      return fragment.forget();
+    }
+  }
+  return nullptr;
+}
+
+void Document::NoteParsedInnerHTMLFragment(const nsAString& aMarkup,
+                                           nsAtom* aContextLocalName,
+                                           int32_t aContextNamespace,
+                                           bool aQuirks,
+                                           nsIContent* aParsedContent) {
+  if (aMarkup.Length() > kInnerHTMLFragmentCacheMaxMarkupLength) {
+    return;
+  }
+
+  for (size_t i = 0; i < mInnerHTMLFragmentCache.Length(); ++i) {
+    InnerHTMLFragmentCacheEntry& entry = mInnerHTMLFragmentCache[i];
+    if (entry.mContextLocalName != aContextLocalName ||
+        entry.mContextNamespace != aContextNamespace ||
+        entry.mQuirks != aQuirks || !entry.mMarkup.Equals(aMarkup)) {
+      continue;
+    }
+    if (entry.mDoNotCache || entry.mFragment) {
+      return;
+    }
+    // Second parse of the same markup; snapshot the result.
+    if (!IsCacheableInnerHTMLContent(aParsedContent)) {
+      entry.mDoNotCache = true;
+      return;
+    }
+    RefPtr<DocumentFragment> fragment =
+        new (NodeInfoManager()) DocumentFragment(NodeInfoManager());
+    for (nsIContent* child = aParsedContent->GetFirstChild(); child;
+         child = child->GetNextSibling()) {
+      IgnoredErrorResult rv;
+      nsCOMPtr<nsINode> clone = child->CloneNode(true, rv);
+      if (!rv.Failed()) {
+        fragment->AppendChild(*clone, rv);
+      }
+      if (rv.Failed()) {
+        entry.mDoNotCache = true;
+        return;
+      }
+    }
+    entry.mFragment = std::move(fragment);
+    return;
+  }
+
+  // First sight of this markup: note it, but don't pay for a snapshot yet.
+  if (mInnerHTMLFragmentCache.Length() >= kInnerHTMLFragmentCacheMaxEntries) {
+    mInnerHTMLFragmentCache.RemoveLastElement();
+  }
+  InnerHTMLFragmentCacheEntry* entry =
+      mInnerHTMLFragmentCache.InsertElementAt(0);
+  entry->mMarkup = aMarkup;
+  entry->mContextLocalName = aContextLocalName;
+  entry->mContextNamespace = aContextNamespace;
+  entry->mQuirks = aQuirks;
+  entry->mDoNotCache = false;
+}
+
 Document::FrameRequest::FrameRequest(FrameRequestCallback& aCallback,
                                      int32_t aHandle)
     : mCallback(&aCallback), mHandle(aHandle) {
@@ -2389,6 +2501,10 @@ NS_IMPL_CYCLE_COLLECTION_TRAVERSE_BEGIN_INTERNAL(Document)
   NS_IMPL_CYCLE_COLLECTION_TRAVERSE(mDocumentTimeline)
   NS_IMPL_CYCLE_COLLECTION_TRAVERSE(mPendingAnimationTracker)
   NS_IMPL_CYCLE_COLLECTION_TRAVERSE(mTemplateContentsOwner)
+  for (auto& entry : tmp->mInnerHTMLFragmentCache) {
+    ImplCycleCollectionTraverse(cb, entry.mFragment,
+                                "mInnerHTMLFragmentCache[i].mFragment");
+  }
   NS_IMPL_CYCLE_COLLECTION_TRAVERSE(mChildrenCollection)
   NS_IMPL_CYCLE_COLLECTION_TRAVERSE(mImages);
   NS_IMPL_CYCLE_COLLECTION_TRAVERSE(mEmbeds);
@@ -2516,6 +2632,7 @@ NS_IMPL_CYCLE_COLLECTION_UNLINK_BEGIN(Document)
   NS_IMPL_CYCLE_COLLECTION_UNLINK(mDocumentTimeline)
   NS_IMPL_CYCLE_COLLECTION_UNLINK(mPendingAnimationTracker)
   NS_IMPL_CYCLE_COLLECTION_UNLINK(mTemplateContentsOwner)
+  tmp->mInnerHTMLFragmentCache.Clear();
   NS_IMPL_CYCLE_COLLECTION_UNLINK(mChildrenCollection)
   NS_IMPL_CYCLE_COLLECTION_UNLINK(mImages);
   NS_IMPL_CYCLE_COLLECTION_UNLINK(mEmbeds);
@@ -6587,6 +6704,24 @@ bool Document::ShouldThrottleFrameRequests() const {
   return false;
 }
 
+bool Document::ShouldReduceFrameRequestRate() const {
+  if (IsTopLevelContentDocument() || mUserHasInteracted) {
+    return false;
+  }
+
+  const Document* top = GetTopLevelContentDocument();
+  if (!top) {
+    // Not embedded in a content document (or our embedder is in another
+    // process); we can't tell whether we're same-origin with the top, so
+    // don't reduce.
+    return false;
+  }
+
+  // Cross-origin subdocuments the user has never interacted with don't get
+  // to tick their frame request callbacks on every refresh.
+  return !NodePrincipal()->Equals(top->NodePrincipal());
+}
+
 void Document::DeletePresShell() {
   mExternalResourceMap.HideViewers();
   if (nsPresContext* presContext = mPresShell->GetPresContext()) {
@@ -10717,15 +10852,19 @@ bool Document::CanSavePresentation(nsIRequest* aNewRequest,
     ret = false;
   }
 
-  // Check our event listener manager for unload/beforeunload listeners.
-  nsCOMPtr<EventTarget> piTarget = do_QueryInterface(mScriptGlobalObject);
-  if (piTarget) {
-    EventListenerManager* manager = piTarget->GetExistingListenerManager();
-    if (manager && manager->HasUnloadListeners()) {
-      MOZ_LOG(gPageCacheLog, mozilla::LogLevel::Verbose,
-              ("Save of %s blocked due to unload handlers", uri.get()));
-      aBFCacheCombo |= BFCacheStatus::UNLOAD_LISTENER;
-      ret = false;
+  // Check our event listener manager for unload/beforeunload listeners. When
+  // the pref opts into caching such pages anyway, the listeners simply don't
+  // run if the page is evicted without being restored.
+  if (!StaticPrefs::docshell_shistory_bfcache_allow_unload_listeners()) {
+    nsCOMPtr<EventTarget> piTarget = do_QueryInterface(mScriptGlobalObject);
+    if (piTarget) {
+      EventListenerManager* manager = piTarget->GetExistingListenerManager();
+      if (manager && manager->HasUnloadListeners()) {
+        MOZ_LOG(gPageCacheLog, mozilla::LogLevel::Verbose,
+                ("Save of %s blocked due to unload handlers", uri.get()));
+        aBFCacheCombo |= BFCacheStatus::UNLOAD_LISTENER;
+        ret = false;
+      }
     }
   }
 
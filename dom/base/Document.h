@@ -1657,6 +1657,29 @@ class Document : public nsINode,
     }
     return *mSelectorCache;
   }
+
+  /**
+   * Returns a cached fragment for innerHTML markup that has been parsed with
+   * the same context repeatedly, or null. The caller is expected to deep
+   * clone the result rather than insert it.
+   */
+  already_AddRefed<DocumentFragment> GetCachedInnerHTMLFragment(
+      const nsAString& aMarkup, nsAtom* aContextLocalName,
+      int32_t aContextNamespace, bool aQuirks);
+
+  /**
+   * Called after fragment-parsing markup for an innerHTML assignment;
+   * aParsedContent is the node whose children are the parse result. The
+   * first time a markup string is seen it is only noted; when it is parsed
+   * again, a snapshot of the parsed children is cached so that one-off
+   * assignments don't pay for the snapshot clone. Markup whose parse result
+   * cannot be cloned without observable differences (scripts, custom
+   * elements, browsing-context containers) is never cached.
+   */
+  void NoteParsedInnerHTMLFragment(const nsAString& aMarkup,
+                                   nsAtom* aContextLocalName,
+                                   int32_t aContextNamespace, bool aQuirks,
+                                   nsIContent* aParsedContent);
   // Get the root <html> element, or return null if there isn't one (e.g.
   // if the root isn't <html>)
   Element* GetHtmlElement() const;
@@ -3101,6 +3124,14 @@ class Document : public nsINode,
    */
   bool ShouldThrottleFrameRequests() const;
 
+  /**
+   * @return true if this document's frame request callbacks should run at a
+   * reduced rate rather than on every refresh driver tick. This applies to
+   * visible cross-origin subdocuments the user has never interacted with
+   * (commonly ad iframes), which don't get to drive animations at full rate.
+   */
+  bool ShouldReduceFrameRequestRate() const;
+
   // This returns true when the document tree is being teared down.
   bool InUnlinkOrDeletion() { return mInUnlinkOrDeletion; }
 
@@ -4210,6 +4241,21 @@ class Document : public nsINode,
   UniquePtr<SelectorCache> mSelectorCache;
   UniquePtr<ServoStyleSet> mStyleSet;
 
+  struct InnerHTMLFragmentCacheEntry {
+    nsString mMarkup;
+    RefPtr<nsAtom> mContextLocalName;
+    int32_t mContextNamespace;
+    bool mQuirks;
+    // Set when the parse result was found unsuitable for cloning, so that we
+    // don't walk it again on every reparse.
+    bool mDoNotCache;
+    // Null until the same markup has been parsed a second time.
+    RefPtr<DocumentFragment> mFragment;
+  };
+  // Cache of parsed innerHTML fragments, most recently used first. See
+  // GetCachedInnerHTMLFragment/NoteParsedInnerHTMLFragment.
+  nsTArray<InnerHTMLFragmentCacheEntry> mInnerHTMLFragmentCache;
+
  protected:
   friend class nsDocumentOnStack;
 
@@ -1950,12 +1950,38 @@ void FragmentOrElement::SetInnerHTMLInternal(const nsAString& aInnerHTML,
   if (doc->IsHTMLDocument()) {
     nsAtom* contextLocalName = parseContext->NodeInfo()->NameAtom();
     int32_t contextNameSpaceID = parseContext->GetNameSpaceID();
+    bool quirks = doc->GetCompatibilityMode() == eCompatibility_NavQuirks;
+
+    if (!target->HasWeirdParserInsertionMode()) {
+      // Markup that has been assigned repeatedly with the same context is in
+      // the document's fragment cache; cloning the cached fragment gives the
+      // same tree as another parser run.
+      if (RefPtr<DocumentFragment> cached = doc->GetCachedInnerHTMLFragment(
+              aInnerHTML, contextLocalName, contextNameSpaceID, quirks)) {
+        ErrorResult rv;
+        nsCOMPtr<nsINode> clone = cached->CloneNode(true, rv);
+        if (!rv.Failed()) {
+          // Suppress assertion about node removal mutation events that can't
+          // have listeners anyway, because no one has had the chance to
+          // register mutation listeners on the cloned fragment.
+          nsAutoScriptBlockerSuppressNodeRemoved scriptBlocker;
+          target->AppendChild(*clone, aError);
+          mb.NodesAdded();
+          return;
+        }
+        rv.SuppressException();
+      }
+    }
 
     int32_t oldChildCount = target->GetChildCount();
-    aError = nsContentUtils::ParseFragmentHTML(
-        aInnerHTML, target, contextLocalName, contextNameSpaceID,
-        doc->GetCompatibilityMode() == eCompatibility_NavQuirks, true);
+    aError = nsContentUtils::ParseFragmentHTML(aInnerHTML, target,
+                                               contextLocalName,
+                                               contextNameSpaceID, quirks, true);
     mb.NodesAdded();
+    if (!aError.Failed() && !target->HasWeirdParserInsertionMode()) {
+      doc->NoteParsedInnerHTMLFragment(aInnerHTML, contextLocalName,
+                                       contextNameSpaceID, quirks, target);
+    }
     // HTML5 parser has notified, but not fired mutation events.
     nsContentUtils::FireMutationEventsForDirectParsing(doc, target,
                                                        oldChildCount);
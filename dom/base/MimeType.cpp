@@ -291,11 +291,18 @@ bool TMimeType<char_type>::GetParameterValue(
     const char_type* vcur = value.BeginReading();
     const char_type* vend = value.EndReading();
     while (vcur < vend) {
-      if (*vcur == '"' || *vcur == '\\') {
+      // Append the run up to the next character that needs escaping in one
+      // go; most values contain none at all.
+      const char_type* runStart = vcur;
+      while (vcur < vend && *vcur != '"' && *vcur != '\\') {
+        vcur++;
+      }
+      aOutput.Append(runStart, vcur - runStart);
+      if (vcur < vend) {
         aOutput.AppendLiteral("\\");
+        aOutput.Append(*vcur);
+        vcur++;
       }
-      aOutput.Append(*vcur);
-      vcur++;
     }
     aOutput.AppendLiteral("\"");
   } else {
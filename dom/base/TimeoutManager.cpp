@@ -246,10 +246,11 @@ TimeDuration TimeoutManager::MinSchedulingDelay() const {
                          StaticPrefs::dom_min_background_timeout_value())
                    : TimeDuration();
   bool budgetThrottlingEnabled = BudgetThrottlingEnabled(isBackground);
-  if (budgetThrottlingEnabled && mExecutionBudget < TimeDuration()) {
+  const TimeDuration executionBudget = BudgetOwner().mExecutionBudget;
+  if (budgetThrottlingEnabled && executionBudget < TimeDuration()) {
     // Only throttle if execution budget is less than 0
     double factor = 1.0 / GetRegenerationFactor(mWindow.IsBackgroundInternal());
-    return TimeDuration::Max(unthrottled, -mExecutionBudget.MultDouble(factor));
+    return TimeDuration::Max(unthrottled, -executionBudget.MultDouble(factor));
   }
   if (!budgetThrottlingEnabled && isBackground) {
     return TimeDuration::FromMilliseconds(
@@ -366,12 +367,38 @@ void TimeoutManager::RecordExecution(Timeout* aRunningTimeout,
   }
 }
 
+TimeoutManager& TimeoutManager::BudgetOwner() {
+  // Execution budgets are accounted against the in-process frame tree as a
+  // whole rather than against individual windows, so that a page sharding
+  // its timer load across many iframes (ad stacks, typically) draws from a
+  // single throttle budget instead of multiplying it per frame.
+  nsGlobalWindowOuter* outer = mWindow.GetOuterWindowInternal();
+  nsGlobalWindowOuter* top = mWindow.GetInProcessTopInternal();
+  if (!top || top == outer) {
+    return *this;
+  }
+
+  nsGlobalWindowInner* topInner = top->GetCurrentInnerWindowInternal();
+  if (!topInner) {
+    return *this;
+  }
+
+  return topInner->TimeoutManager();
+}
+
 void TimeoutManager::UpdateBudget(const TimeStamp& aNow,
                                   const TimeDuration& aDuration) {
   if (mWindow.IsChromeWindow()) {
     return;
   }
 
+  TimeoutManager& budgetOwner = BudgetOwner();
+  if (&budgetOwner != this) {
+    // Subframes burn and regenerate the shared budget of the top window.
+    budgetOwner.UpdateBudget(aNow, aDuration);
+    return;
+  }
+
   // The budget is adjusted by increasing it with the time since the
   // last budget update factored with the regeneration rate. If a
   // runnable has executed, subtract that duration from the
@@ -635,9 +662,9 @@ void TimeoutManager::RunTimeout(const TimeStamp& aNow,
   // Limit the overall time spent in RunTimeout() to reduce jank.
   uint32_t totalTimeLimitMS =
       std::max(1u, StaticPrefs::dom_timeout_max_consecutive_callbacks_ms());
-  const TimeDuration totalTimeLimit =
-      TimeDuration::Min(TimeDuration::FromMilliseconds(totalTimeLimitMS),
-                        TimeDuration::Max(TimeDuration(), mExecutionBudget));
+  const TimeDuration totalTimeLimit = TimeDuration::Min(
+      TimeDuration::FromMilliseconds(totalTimeLimitMS),
+      TimeDuration::Max(TimeDuration(), BudgetOwner().mExecutionBudget));
 
   // Allow up to 25% of our total time budget to be used figuring out which
   // timers need to run.  This is the initial loop in this method.
@@ -678,6 +705,12 @@ void TimeoutManager::RunTimeout(const TimeStamp& aNow,
     deadline = now;
   }
 
+  // Coalesce timeouts that come due within a millisecond of the deadline
+  // into this batch, rather than scheduling another executor wakeup that
+  // would fire almost immediately. Each callback still runs as its own task
+  // with its own microtask checkpoint, as the spec requires.
+  deadline += TimeDuration::FromMilliseconds(1);
+
   TimeStamp nextDeadline;
   uint32_t numTimersToRun = 0;
 
@@ -983,7 +1016,7 @@ void TimeoutManager::RunTimeout(const TimeStamp& aNow,
               // reschedule. By cancelling the executor we will not run
               // immediately, but instead reschedule to the minimum
               // scheduling delay.
-              if (mExecutionBudget < TimeDuration()) {
+              if (BudgetOwner().mExecutionBudget < TimeDuration()) {
                 mExecutor->Cancel();
               }
 
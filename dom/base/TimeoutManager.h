@@ -135,6 +135,15 @@ class TimeoutManager final {
   void UpdateBudget(const TimeStamp& aNow,
                     const TimeDuration& aDuration = TimeDuration());
 
+  // Returns the TimeoutManager whose execution budget this window draws
+  // from. Budgets are shared across the in-process frame tree, so for
+  // subframes this is the top window's manager; for top-level windows (and
+  // windows without a reachable top) it is *this.
+  TimeoutManager& BudgetOwner();
+  const TimeoutManager& BudgetOwner() const {
+    return const_cast<TimeoutManager*>(this)->BudgetOwner();
+  }
+
   mozilla::PerformanceCounter* GetPerformanceCounter();
 
  private:
@@ -1918,6 +1918,11 @@ already_AddRefed<nsStringBuffer> nsAttrValue::GetStringBuffer(
 
   RefPtr<nsStringBuffer> buf = nsStringBuffer::FromString(aValue);
   if (buf && (buf->StorageSize() / sizeof(char16_t) - 1) == len) {
+    // We can only reuse the buffer if it's exactly sized, since we rely on
+    // StorageSize() to recover the length in ToString(). The HTML5 parser
+    // deliberately allocates its attribute value buffers exactly sized (see
+    // nsHtml5String::FromBuffer) so that large values, e.g. data-* payloads,
+    // are shared all the way from the parser without being copied here.
     return buf.forget();
   }
 
@@ -683,28 +683,83 @@ void nsContentList::ContentInserted(nsIContent* aChild) {
   // Note that aChild->GetParentNode() can be null here if we are inserting into
   // the document itself; any attempted optimizations to this method should deal
   // with that.
-  if (mState != LIST_DIRTY &&
-      MayContainRelevantNodes(aChild->GetParentNode()) &&
-      nsContentUtils::IsInSameAnonymousTree(mRootNode, aChild) &&
-      MatchSelf(aChild)) {
+  if (mState == LIST_DIRTY ||
+      !MayContainRelevantNodes(aChild->GetParentNode()) ||
+      !nsContentUtils::IsInSameAnonymousTree(mRootNode, aChild) ||
+      !MatchSelf(aChild)) {
+    return;
+  }
+
+  if (mDeep && aChild->HasChildren()) {
+    // The inserted subtree could contain any number of matching elements;
+    // figuring out where they all go isn't worth the effort.
     SetDirty();
+    ASSERT_IN_SYNC;
+    return;
   }
 
+  // A single matching element was inserted.  Splice it into our list rather
+  // than throwing away everything we know.
+  InsertElementInOrder(aChild);
+
   ASSERT_IN_SYNC;
 }
 
 void nsContentList::ContentRemoved(nsIContent* aChild,
                                    nsIContent* aPreviousSibling) {
-  if (mState != LIST_DIRTY &&
-      MayContainRelevantNodes(aChild->GetParentNode()) &&
-      nsContentUtils::IsInSameAnonymousTree(mRootNode, aChild) &&
-      MatchSelf(aChild)) {
+  if (mState == LIST_DIRTY ||
+      !MayContainRelevantNodes(aChild->GetParentNode()) ||
+      !nsContentUtils::IsInSameAnonymousTree(mRootNode, aChild) ||
+      !MatchSelf(aChild)) {
+    return;
+  }
+
+  if (mDeep && aChild->HasChildren()) {
+    // Matching elements anywhere in the removed subtree may be in our list.
     SetDirty();
+    ASSERT_IN_SYNC;
+    return;
   }
 
+  // A single matching element was removed.  If it's in our list, just drop
+  // it; if we're lazy and never picked it up, there is nothing to do.  Either
+  // way the elements we have remain the first matches in tree order, so no
+  // change of mState is required here.
+  mElements.RemoveElement(aChild);
+
   ASSERT_IN_SYNC;
 }
 
+void nsContentList::InsertElementInOrder(nsIContent* aContent) {
+  uint32_t count = mElements.Length();
+  if (count == 0 ||
+      nsContentUtils::PositionIsBefore(mElements[count - 1], aContent)) {
+    // aContent comes after everything we've picked up so far.  If we're not
+    // up to date, appending it could skip over content that we never picked
+    // up due to being lazy; PopulateSelf will find it if anyone asks.
+    if (mState == LIST_LAZY) {
+      return;
+    }
+    mElements.AppendElement(aContent);
+    return;
+  }
+
+  // aContent belongs somewhere within the part of the subtree we have
+  // already examined, so it goes into our list no matter what state we're
+  // in.  Binary search for the first element it precedes.
+  uint32_t start = 0;
+  uint32_t end = count;
+  while (start != end) {
+    uint32_t mid = (start + end) / 2;
+    if (nsContentUtils::PositionIsBefore(mElements[mid], aContent)) {
+      start = mid + 1;
+    } else {
+      end = mid;
+    }
+  }
+  mElements.InsertElementAt(start, aContent);
+}
+
 bool nsContentList::Match(Element* aElement) {
   if (mFunc) {
     return (*mFunc)(aElement, mMatchNameSpaceId, mXMLMatchAtom, mData);
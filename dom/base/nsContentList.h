@@ -373,6 +373,17 @@ class nsContentList : public nsBaseContentList,
    */
   bool MatchSelf(nsIContent* aContent);
 
+  /**
+   * Insert aContent into mElements at the position corresponding to its
+   * position in tree order, so that the elements we have remain the first
+   * matches in the subtree.  If we are lazy and aContent comes after the
+   * last element we have picked up so far, it is left for PopulateSelf to
+   * find instead.
+   *
+   * @param  aContent the element to insert; must match our criterion
+   */
+  void InsertElementInOrder(nsIContent* aContent);
+
   /**
    * Populate our list.  Stop once we have at least aNeededLength
    * elements.  At the end of PopulateSelf running, either the last
@@ -1069,10 +1069,15 @@ nsresult nsContentUtils::Atob(const nsAString& aAsciiBase64String,
     trimmedString.Append(start, cur - start);
 
     while (cur < end) {
-      if (!nsContentUtils::IsHTMLWhitespace(*cur)) {
-        trimmedString.Append(*cur);
+      if (nsContentUtils::IsHTMLWhitespace(*cur)) {
+        cur++;
+        continue;
       }
-      cur++;
+      const char16_t* runStart = cur;
+      while (cur < end && !nsContentUtils::IsHTMLWhitespace(*cur)) {
+        cur++;
+      }
+      trimmedString.Append(runStart, cur - runStart);
     }
     rv = Base64Decode(trimmedString, aBinaryData);
   } else {
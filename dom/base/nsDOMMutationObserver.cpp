@@ -208,7 +208,8 @@ void nsMutationReceiver::CharacterDataWillChange(
     return;
   }
 
-  nsDOMMutationRecord* m = Observer()->CurrentRecord(nsGkAtoms::characterData);
+  nsDOMMutationRecord* m =
+      Observer()->CurrentRecord(nsGkAtoms::characterData, aContent);
 
   NS_ASSERTION(!m->mTarget || m->mTarget == aContent, "Wrong target!");
 
@@ -906,7 +907,8 @@ void nsDOMMutationObserver::HandleMutationsInternal(AutoSlowOperation& aAso) {
   }
 }
 
-nsDOMMutationRecord* nsDOMMutationObserver::CurrentRecord(nsAtom* aType) {
+nsDOMMutationRecord* nsDOMMutationObserver::CurrentRecord(
+    nsAtom* aType, nsINode* aKnownTarget) {
   NS_ASSERTION(sMutationLevel > 0, "Unexpected mutation level!");
 
   while (mCurrentMutations.Length() < sMutationLevel) {
@@ -915,11 +917,25 @@ nsDOMMutationRecord* nsDOMMutationObserver::CurrentRecord(nsAtom* aType) {
 
   uint32_t last = sMutationLevel - 1;
   if (!mCurrentMutations[last]) {
-    RefPtr<nsDOMMutationRecord> r =
-        new nsDOMMutationRecord(aType, GetParentObject());
-    mCurrentMutations[last] = r;
-    AppendMutationRecord(r.forget());
-    ScheduleForRun();
+    // If merging was requested and the most recently queued record is for the
+    // same kind of mutation on the same node, make it the current record
+    // again instead of queueing another one. This keeps only the first
+    // record's oldValue, like the merging in TakeRecords/HandleMutation, but
+    // also skips the allocation. Merging is opt-in since the number of
+    // delivered records is observable.
+    if (aKnownTarget && mMergeCharacterDataRecords &&
+        aType == nsGkAtoms::characterData && mLastPendingMutation &&
+        mLastPendingMutation->mType == aType &&
+        mLastPendingMutation->mTarget == aKnownTarget) {
+      mCurrentMutations[last] = mLastPendingMutation;
+      ScheduleForRun();
+    } else {
+      RefPtr<nsDOMMutationRecord> r =
+          new nsDOMMutationRecord(aType, GetParentObject());
+      mCurrentMutations[last] = r;
+      AppendMutationRecord(r.forget());
+      ScheduleForRun();
+    }
   }
 
 #ifdef DEBUG
@@ -420,6 +420,7 @@ class nsDOMMutationObserver final : public nsISupports, public nsWrapperCache {
         mWaitingForRun(false),
         mIsChrome(aChrome),
         mMergeAttributeRecords(false),
+        mMergeCharacterDataRecords(false),
         mId(++sCount) {}
   NS_DECL_CYCLE_COLLECTING_ISUPPORTS
   NS_DECL_CYCLE_COLLECTION_SCRIPT_HOLDER_CLASS(nsDOMMutationObserver)
@@ -458,6 +459,12 @@ class nsDOMMutationObserver final : public nsISupports, public nsWrapperCache {
 
   void SetMergeAttributeRecords(bool aVal) { mMergeAttributeRecords = aVal; }
 
+  bool MergeCharacterDataRecords() { return mMergeCharacterDataRecords; }
+
+  void SetMergeCharacterDataRecords(bool aVal) {
+    mMergeCharacterDataRecords = aVal;
+  }
+
   // If both records are for 'attributes' type and for the same target and
   // attribute name and namespace are the same, we can skip the newer record.
   // aOldRecord->mPrevValue holds the original value, if observed.
@@ -534,7 +541,12 @@ class nsDOMMutationObserver final : public nsISupports, public nsWrapperCache {
   void ScheduleForRun();
   void RescheduleForRun();
 
-  nsDOMMutationRecord* CurrentRecord(nsAtom* aType);
+  // aKnownTarget is the node the caller is going to make the record be
+  // for, when it is already known; it allows reusing the most recently
+  // queued record instead of allocating a new one when record merging has
+  // been requested.
+  nsDOMMutationRecord* CurrentRecord(nsAtom* aType,
+                                     nsINode* aKnownTarget = nullptr);
   bool HasCurrentRecord(const nsAString& aType);
 
   bool Suppressed() {
@@ -565,6 +577,7 @@ class nsDOMMutationObserver final : public nsISupports, public nsWrapperCache {
   bool mWaitingForRun;
   bool mIsChrome;
   bool mMergeAttributeRecords;
+  bool mMergeCharacterDataRecords;
 
   uint64_t mId;
 
@@ -4080,7 +4080,12 @@ void nsGlobalWindowInner::NotifyDOMWindowDestroyed(
 void nsGlobalWindowInner::NotifyWindowIDDestroyed(const char* aTopic) {
   nsCOMPtr<nsIRunnable> runnable =
       new WindowDestroyedEvent(this, mWindowID, aTopic);
-  Dispatch(TaskCategory::Other, runnable.forget());
+  // Notifying observers about a destroyed window is deferrable work, so run
+  // it idle-until-urgent: wait for an idle slice but promote to the normal
+  // queue after a second, keeping the listeners (and whatever cleanup they
+  // trigger) off the critical path of navigation and tab close.
+  NS_DispatchToCurrentThreadQueue(runnable.forget(), 1000,
+                                  EventQueuePriority::Idle);
 }
 
 // static
@@ -28,6 +28,7 @@
 #include "mozilla/Telemetry.h"
 #include "mozilla/TextControlElement.h"
 #include "mozilla/TextEditor.h"
+#include "mozilla/TextUtils.h"
 #include "mozilla/TimeStamp.h"
 #include "mozilla/dom/BindContext.h"
 #include "mozilla/dom/CharacterData.h"
@@ -2913,11 +2914,56 @@ inline static Element* FindMatchingElementWithId(
   return nullptr;
 }
 
+// Checks whether aSelector is a lone ID selector ("#id") whose identifier
+// needs no unescaping, so the query can be answered from the ID table instead
+// of matching the selector against the whole subtree.
+static bool IsSimpleIdSelector(const nsACString& aSelector) {
+  if (aSelector.Length() < 2 || aSelector.First() != '#') {
+    return false;
+  }
+  const char* c = aSelector.BeginReading() + 1;
+  const char* end = aSelector.EndReading();
+  if (!IsAsciiAlpha(*c) && *c != '_') {
+    return false;
+  }
+  for (++c; c < end; ++c) {
+    if (!IsAsciiAlphanumeric(*c) && *c != '_' && *c != '-') {
+      return false;
+    }
+  }
+  return true;
+}
+
 Element* nsINode::QuerySelector(const nsACString& aSelector,
                                 ErrorResult& aResult) {
   AUTO_PROFILER_LABEL_DYNAMIC_NSCSTRING("nsINode::QuerySelector",
                                         LAYOUT_SelectorQuery, aSelector);
 
+  // Fast path for a lone ID selector, which our SPA-style consumers hit a lot:
+  // answer it from the ID table rather than parsing the selector and matching
+  // it against the subtree. Quirks mode is excluded because it matches IDs
+  // ASCII case-insensitively, which the table lookup does not.
+  if (IsSimpleIdSelector(aSelector) &&
+      OwnerDoc()->GetCompatibilityMode() != eCompatibility_NavQuirks) {
+    NS_ConvertUTF8toUTF16 id(Substring(aSelector, 1));
+    if (IsDocument()) {
+      return AsDocument()->GetElementById(id);
+    }
+    if (ShadowRoot* root = ShadowRoot::FromNode(this)) {
+      return root->GetElementById(id);
+    }
+    if (IsElement()) {
+      if (IsInUncomposedDoc()) {
+        return FindMatchingElementWithId(id, *AsElement(), *OwnerDoc());
+      }
+      if (ShadowRoot* containingShadow = AsContent()->GetContainingShadow()) {
+        return FindMatchingElementWithId(id, *AsElement(), *containingShadow);
+      }
+    }
+    // Disconnected subtrees have no ID table; fall through to the regular
+    // selector matching below.
+  }
+
   const RawServoSelectorList* list = ParseSelectorList(aSelector, aResult);
   if (!list) {
     return nullptr;
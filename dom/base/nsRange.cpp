@@ -811,6 +811,7 @@ bool nsRange::IntersectsNode(nsINode& aNode, ErrorResult& aRv) {
 }
 
 void nsRange::NotifySelectionListenersAfterRangeSet() {
+  mNotifySelectionListenersPending = false;
   if (mSelection) {
     // Our internal code should not move focus with using this instance while
     // it's calling Selection::NotifySelectionListeners() which may move focus
@@ -917,8 +918,12 @@ void nsRange::DoSetRange(const RangeBoundaryBase<SPT, SRT>& aStartBoundary,
   // Notify any selection listeners. This has to occur last because otherwise
   // the world could be observed by a selection listener while the range was in
   // an invalid state. So we run it off of a script runner to ensure it runs
-  // after the mutation observers have finished running.
-  if (mSelection) {
+  // after the mutation observers have finished running.  If a runner is
+  // already pending for this range it will see the latest boundaries when it
+  // fires, so don't queue another one; this keeps bulk edits which move the
+  // same ranges over and over from piling up a notification per mutation.
+  if (mSelection && !mNotifySelectionListenersPending) {
+    mNotifySelectionListenersPending = true;
     nsContentUtils::AddScriptRunner(
         NewRunnableMethod("NotifySelectionListenersAfterRangeSet", this,
                           &nsRange::NotifySelectionListenersAfterRangeSet));
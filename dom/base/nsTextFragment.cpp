@@ -17,6 +17,7 @@
 #include "nsBidiUtils.h"
 #include "nsUnicharUtils.h"
 #include "mozilla/CheckedInt.h"
+#include "mozilla/MathAlgorithms.h"
 #include "mozilla/MemoryReporting.h"
 #include "mozilla/SSE.h"
 #include "mozilla/ppc.h"
@@ -346,6 +347,19 @@ void nsTextFragment::CopyTo(char16_t* aDest, int32_t aOffset, int32_t aCount) {
   }
 }
 
+// Round a growing buffer's allocation request up so that a streaming series
+// of appends (a large <pre> log view, chunked text/plain data) grows the
+// storage geometrically instead of reallocating -- and potentially copying
+// a megabyte-scale buffer -- on every append. Small fragments keep their
+// exact size; jemalloc's size classes round those up anyway.
+static inline size_t TextFragmentGrowSize(size_t aSize) {
+  static const size_t kGrowThreshold = 4096;
+  if (aSize <= kGrowThreshold || aSize > (SIZE_MAX >> 1)) {
+    return aSize;
+  }
+  return mozilla::RoundUpPow2(aSize);
+}
+
 bool nsTextFragment::Append(const char16_t* aBuffer, uint32_t aLength,
                             bool aUpdateBidi, bool aForce2b) {
   if (!aLength) {
@@ -377,15 +391,18 @@ bool nsTextFragment::Append(const char16_t* aBuffer, uint32_t aLength,
     nsStringBuffer* buff = nullptr;
     nsStringBuffer* bufferToRelease = nullptr;
     if (m2b->IsReadonly()) {
-      buff = nsStringBuffer::Alloc(size).take();
+      buff = nsStringBuffer::Alloc(TextFragmentGrowSize(size)).take();
       if (!buff) {
         return false;
       }
       bufferToRelease = m2b;
       memcpy(static_cast<char16_t*>(buff->Data()), m2b->Data(),
              mState.mLength * sizeof(char16_t));
+    } else if (m2b->StorageSize() >= size) {
+      // The earlier geometric growth left enough room; append in place.
+      buff = m2b;
     } else {
-      buff = nsStringBuffer::Realloc(m2b, size);
+      buff = nsStringBuffer::Realloc(m2b, TextFragmentGrowSize(size));
       if (!buff) {
         return false;
       }
@@ -419,7 +436,8 @@ bool nsTextFragment::Append(const char16_t* aBuffer, uint32_t aLength,
 
     // The old data was 1-byte, but the new is not so we have to expand it
     // all to 2-byte
-    nsStringBuffer* buff = nsStringBuffer::Alloc(size).take();
+    nsStringBuffer* buff =
+        nsStringBuffer::Alloc(TextFragmentGrowSize(size)).take();
     if (!buff) {
       return false;
     }
@@ -452,12 +470,15 @@ bool nsTextFragment::Append(const char16_t* aBuffer, uint32_t aLength,
   MOZ_ASSERT(sizeof(char) == 1);
   char* buff;
   if (mState.mInHeap) {
-    buff = static_cast<char*>(realloc(const_cast<char*>(m1b), size));
+    // The rounded request is the same across a run of appends, which lets
+    // the allocator grow in place instead of copying the whole buffer.
+    buff = static_cast<char*>(
+        realloc(const_cast<char*>(m1b), TextFragmentGrowSize(size)));
     if (!buff) {
       return false;
     }
   } else {
-    buff = static_cast<char*>(malloc(size));
+    buff = static_cast<char*>(malloc(TextFragmentGrowSize(size)));
     if (!buff) {
       return false;
     }
@@ -1383,6 +1383,7 @@ class CGHeaders(CGWrapper):
                 elif unrolled.isSequence():
                     bindingHeaders.add("js/Array.h")
                     bindingHeaders.add("js/ForOfIterator.h")
+                    bindingHeaders.add("js/Proxy.h")
                 else:
                     break
                 unrolled = unrolled.inner
@@ -5926,6 +5927,31 @@ def getJSToNativeConversionInfo(
               $*{notSequence}
             }
             ${sequenceType} &arr${nestingLevel} = ${arrayRef};
+            {
+              // In the common case of a plain array with the default array
+              // iterator, the for-of iterator reads the dense elements
+              // directly and we will append one element per dense slot, so
+              // reserve room for them up front instead of growing the
+              // sequence as we go.  Skip proxies, for which getting the
+              // length is observable.  This is only a hint, so a misbehaving
+              // custom iterator doesn't matter here.
+              JS::Rooted<JSObject*> iterable${nestingLevel}(cx, &$${val}.toObject());
+              bool isArray${nestingLevel} = false;
+              if (!js::IsProxy(iterable${nestingLevel}) &&
+                  !JS::IsArrayObject(cx, iterable${nestingLevel}, &isArray${nestingLevel})) {
+                $*{exceptionCode}
+              }
+              if (isArray${nestingLevel}) {
+                uint32_t length${nestingLevel} = 0;
+                if (!JS::GetArrayLength(cx, iterable${nestingLevel}, &length${nestingLevel})) {
+                  $*{exceptionCode}
+                }
+                if (!arr${nestingLevel}.SetCapacity(length${nestingLevel}, mozilla::fallible)) {
+                  JS_ReportOutOfMemory(cx);
+                  $*{exceptionCode}
+                }
+              }
+            }
             JS::Rooted<JS::Value> temp${nestingLevel}(cx);
             while (true) {
               bool done${nestingLevel};
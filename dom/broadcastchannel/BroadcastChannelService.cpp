@@ -10,6 +10,7 @@
 #include "mozilla/dom/File.h"
 #include "mozilla/dom/IPCBlobUtils.h"
 #include "mozilla/ipc/BackgroundParent.h"
+#include "mozilla/Maybe.h"
 
 #ifdef XP_WIN
 #  undef PostMessage
@@ -135,6 +136,17 @@ void BroadcastChannelService::PostMessage(BroadcastChannelParent* aParent,
 
   uint32_t selectedActorsOnSamePid = 0;
 
+  // Sending a MessageData does not consume it: serializing it into each
+  // channel copies out of the clone buffer (or spills it into a fresh
+  // shared-memory segment) without mutating it, so the one serialized body
+  // can fan out to every sibling actor by reference. Only blob-bearing
+  // messages need a single mutable copy, whose IPCBlob entries are
+  // re-serialized for each destination actor's manager.
+  Maybe<MessageData> blobData;
+  if (!blobImpls.IsEmpty()) {
+    blobData.emplace(CloneMessageData(aData));
+  }
+
   // For each parent actor, we notify the message.
   for (uint32_t i = 0; i < parents->Length(); ++i) {
     BroadcastChannelParent* parent = parents->ElementAt(i);
@@ -148,26 +160,25 @@ void BroadcastChannelService::PostMessage(BroadcastChannelParent* aParent,
       ++selectedActorsOnSamePid;
     }
 
-    // We need to have a copy of the data for this parent.
-    MessageData newData = CloneMessageData(aData);
-    MOZ_ASSERT(newData.data().type() == aData.data().type());
-
-    if (!blobImpls.IsEmpty()) {
-      nsTArray<IPCBlob>& newBlobImpls =
-          newData.data().get_ClonedMessageData().blobs();
-      MOZ_ASSERT(blobImpls.Length() == newBlobImpls.Length());
-
-      // Serialize Blob objects for this message.
-      for (uint32_t i = 0, len = blobImpls.Length(); i < len; ++i) {
-        nsresult rv = IPCBlobUtils::Serialize(blobImpls[i], parent->Manager(),
-                                              newBlobImpls[i]);
-        if (NS_WARN_IF(NS_FAILED(rv))) {
-          return;
-        }
+    if (blobImpls.IsEmpty()) {
+      Unused << parent->SendNotify(aData);
+      continue;
+    }
+
+    nsTArray<IPCBlob>& newBlobImpls =
+        blobData->data().get_ClonedMessageData().blobs();
+    MOZ_ASSERT(blobImpls.Length() == newBlobImpls.Length());
+
+    // Serialize Blob objects for this message.
+    for (uint32_t j = 0, len = blobImpls.Length(); j < len; ++j) {
+      nsresult rv = IPCBlobUtils::Serialize(blobImpls[j], parent->Manager(),
+                                            newBlobImpls[j]);
+      if (NS_WARN_IF(NS_FAILED(rv))) {
+        return;
       }
     }
 
-    Unused << parent->SendNotify(newData);
+    Unused << parent->SendNotify(*blobData);
   }
 
   // If this is a refMessageData, we need to know when it can be released.
@@ -97,7 +97,10 @@ void CanvasRenderingContextHelper::ToBlob(
 
   UniquePtr<uint8_t[]> imageBuffer;
   int32_t format = 0;
-  if (mCurrentContext) {
+  // When a placeholder is used the encoder never looks at the pixels, so
+  // don't pay for the snapshot readback; it stalls the main thread while
+  // the canvas backbuffer is flushed and copied.
+  if (mCurrentContext && !aUsePlaceholder) {
     imageBuffer = mCurrentContext->GetImageBuffer(&format);
   }
 
@@ -19,25 +19,39 @@ WebGLChild::~WebGLChild() { (void)Send__delete__(this); }
 
 void WebGLChild::ActorDestroy(ActorDestroyReason why) {
   mPendingCmdsShmem = {};
+  mReturnedCmdsShmems.Clear();
 }
 
 // -
 
 Maybe<Range<uint8_t>> WebGLChild::AllocPendingCmdBytes(const size_t size) {
   if (!mPendingCmdsShmem) {
-    size_t capacity = mDefaultCmdsShmemSize;
-    if (capacity < size) {
-      capacity = size;
+    // Prefer a shmem the host has already dispatched and returned, so that
+    // steady-state rendering cycles the same few mappings instead of
+    // allocating a fresh segment per flush.
+    for (size_t i = 0; i < mReturnedCmdsShmems.Length(); ++i) {
+      if (mReturnedCmdsShmems[i].ByteRange().length() >= size) {
+        mPendingCmdsShmem = std::move(mReturnedCmdsShmems[i]);
+        mReturnedCmdsShmems.RemoveElementAt(i);
+        break;
+      }
     }
 
-    auto shmem = webgl::RaiiShmem::Alloc(
-        this, capacity,
-        mozilla::ipc::SharedMemory::SharedMemoryType::TYPE_BASIC);
-    if (!shmem) {
-      NS_WARNING("Failed to alloc shmem for AllocPendingCmdBytes.");
-      return {};
+    if (!mPendingCmdsShmem) {
+      size_t capacity = mDefaultCmdsShmemSize;
+      if (capacity < size) {
+        capacity = size;
+      }
+
+      auto shmem = webgl::RaiiShmem::Alloc(
+          this, capacity,
+          mozilla::ipc::SharedMemory::SharedMemoryType::TYPE_BASIC);
+      if (!shmem) {
+        NS_WARNING("Failed to alloc shmem for AllocPendingCmdBytes.");
+        return {};
+      }
+      mPendingCmdsShmem = std::move(shmem);
     }
-    mPendingCmdsShmem = std::move(shmem);
     mPendingCmdsPos = 0;
   }
   const auto range = mPendingCmdsShmem.ByteRange();
@@ -81,6 +95,15 @@ mozilla::ipc::IPCResult WebGLChild::RecvJsWarning(
   return IPC_OK();
 }
 
+mozilla::ipc::IPCResult WebGLChild::RecvReturnDispatchedCommandsShmem(
+    mozilla::ipc::Shmem&& shmem) {
+  auto returned = webgl::RaiiShmem(this, std::move(shmem));
+  if (returned && mReturnedCmdsShmems.Length() < kMaxReturnedCmdsShmems) {
+    mReturnedCmdsShmems.AppendElement(std::move(returned));
+  }
+  return IPC_OK();
+}
+
 mozilla::ipc::IPCResult WebGLChild::RecvOnContextLoss(
     const webgl::ContextLossReason reason) const {
   if (!mContext) return IPC_OK();
@@ -33,12 +33,23 @@ struct FlushedCmdInfo final {
 };
 
 class WebGLChild final : public PWebGLChild, public SupportsWeakPtr {
+  // Upper bound on command shmems kept for reuse. Flush and return are
+  // asynchronous, so a few can be in flight between the processes at once;
+  // anything beyond this is simply unmapped when it comes back.
+  static const size_t kMaxReturnedCmdsShmems = 4;
+
   const WeakPtr<ClientWebGLContext> mContext;
   const size_t mDefaultCmdsShmemSize;
   webgl::RaiiShmem mPendingCmdsShmem;
   size_t mPendingCmdsPos = 0;
   FlushedCmdInfo mFlushedCmdInfo;
 
+  // Command shmems the host has dispatched and sent back for reuse. Entries
+  // can be larger than mDefaultCmdsShmemSize when a big buffer/texture
+  // upload forced an oversized batch, in which case later uploads get to
+  // reuse that mapping too.
+  AutoTArray<webgl::RaiiShmem, kMaxReturnedCmdsShmems> mReturnedCmdsShmems;
+
  public:
   NS_INLINE_DECL_THREADSAFE_REFCOUNTING(WebGLChild, override);
   using OtherSideActor = WebGLParent;
@@ -56,6 +67,8 @@ class WebGLChild final : public PWebGLChild, public SupportsWeakPtr {
  public:
   mozilla::ipc::IPCResult RecvJsWarning(const std::string&) const;
   mozilla::ipc::IPCResult RecvOnContextLoss(webgl::ContextLossReason) const;
+  mozilla::ipc::IPCResult RecvReturnDispatchedCommandsShmem(
+      mozilla::ipc::Shmem&& shmem);
 };
 
 }  // namespace dom
@@ -9,6 +9,7 @@
 #include "mozilla/dom/WebGLCrossProcessCommandQueue.h"
 #include "mozilla/layers/LayerTransactionParent.h"
 #include "mozilla/layers/TextureClientSharedSurface.h"
+#include "mozilla/Unused.h"
 #include "ImageContainer.h"
 #include "HostWebGLContext.h"
 #include "WebGLMethodDispatcher.h"
@@ -68,6 +69,13 @@ IPCResult WebGLParent::RecvDispatchCommands(Shmem&& rawShmem,
     WebGLMethodDispatcher<0>::DispatchCommand(*mHost, id, view);
   }
 
+  // Hand the shmem back to the client for reuse rather than unmapping it.
+  // The client keeps a small pool of these, so steady-state dispatch cycles
+  // the same few segments instead of allocating one per flush.
+  if (CanSend()) {
+    Unused << SendReturnDispatchedCommandsShmem(shmem.Extract());
+  }
+
   return IPC_OK();
 }
 
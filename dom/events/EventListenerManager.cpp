@@ -147,6 +147,7 @@ void EventListenerManager::RemoveAllListenersSilently() {
   }
   mClearingListeners = true;
   mListeners.Clear();
+  mListenerTypeBits = 0;
   mClearingListeners = false;
 }
 
@@ -240,6 +241,8 @@ void EventListenerManager::AddEventListenerInternal(
 
   mNoListenerForEvent = eVoidEvent;
   mNoListenerForEventAtom = nullptr;
+  mListenerTypeBits |= aAllEvents ? ~uint64_t(0)
+                                  : ListenerTypeBits(aEventMessage, aTypeAtom);
 
   listener =
       aAllEvents ? mListeners.InsertElementAt(0) : mListeners.AppendElement();
@@ -575,6 +578,16 @@ void EventListenerManager::NotifyEventListenerRemoved(nsAtom* aUserType) {
   // and NotifyAboutMainThreadListenerChange should be changed too.
   mNoListenerForEvent = eVoidEvent;
   mNoListenerForEventAtom = nullptr;
+  // Rebuild the event type filter from the listeners we still have; the bit
+  // of the removed listener may be shared with another one.
+  mListenerTypeBits = 0;
+  for (uint32_t i = 0; i < mListeners.Length(); ++i) {
+    const Listener& listener = mListeners.ElementAt(i);
+    mListenerTypeBits |=
+        listener.mAllEvents
+            ? ~uint64_t(0)
+            : ListenerTypeBits(listener.mEventMessage, listener.mTypeAtom);
+  }
   if (mTarget) {
     mTarget->EventListenerRemoved(aUserType);
   }
@@ -387,6 +387,23 @@ class EventListenerManager final : public EventListenerManagerBase {
          mNoListenerForEventAtom == aEvent->mSpecifiedEventType)) {
       return;
     }
+
+    // Check the filter of the event types our listeners are registered for,
+    // in the style of the selector-matching bloom filter. Unlike the above
+    // check this covers all event types at once, so targets which have
+    // listeners, just not for this event, don't pay for a scan of the
+    // listener array. The legacy message bits are included so that listeners
+    // for the prefixed version of an event are still found; a false positive
+    // just means we fall through to HandleEventInternal.
+    uint64_t typeBits =
+        ListenerTypeBits(aEvent->mMessage, aEvent->mSpecifiedEventType);
+    if (aEvent->mMessage != eUnidentifiedEvent) {
+      typeBits |=
+          ListenerTypeBits(GetLegacyEventMessage(aEvent->mMessage), nullptr);
+    }
+    if (!(mListenerTypeBits & typeBits)) {
+      return;
+    }
     HandleEventInternal(aPresContext, aEvent, aDOMEvent, aCurrentTarget,
                         aEventStatus, aItemInShadowTree);
   }
@@ -651,6 +668,20 @@ class EventListenerManager final : public EventListenerManagerBase {
   bool ListenerCanHandle(const Listener* aListener, const WidgetEvent* aEvent,
                          EventMessage aEventMessage) const;
 
+  /**
+   * The bits an event type occupies in mListenerTypeBits. Both the message
+   * and the type atom contribute a bit, since an event whose message is
+   * eUnidentifiedEvent is matched against listeners by atom alone.
+   */
+  static uint64_t ListenerTypeBits(EventMessage aEventMessage,
+                                   nsAtom* aTypeAtom) {
+    uint64_t bits = uint64_t(1) << (uint32_t(aEventMessage) & 63);
+    if (aTypeAtom) {
+      bits |= uint64_t(1) << (aTypeAtom->hash() & 63);
+    }
+    return bits;
+  }
+
   // BE AWARE, a lot of instances of EventListenerManager will be created.
   // Therefor, we need to keep this class compact.  When you add integer
   // members, please add them to EventListemerManagerBase and check the size
@@ -664,6 +695,9 @@ class EventListenerManager final : public EventListenerManagerBase {
   nsAutoTObserverArray<Listener, 2> mListeners;
   dom::EventTarget* MOZ_NON_OWNING_REF mTarget;
   RefPtr<nsAtom> mNoListenerForEventAtom;
+  // Aggregate ListenerTypeBits() of every listener in mListeners, with all
+  // bits set if any of them listens for all events.
+  uint64_t mListenerTypeBits = 0;
 
   friend class ELMCreationDetector;
   static uint32_t sMainThreadCreatedCount;
@@ -21,6 +21,8 @@
 #include "nsIUploadChannel2.h"
 #include "nsIInterfaceRequestorUtils.h"
 #include "nsIPipe.h"
+#include "nsITimer.h"
+#include "nsThreadUtils.h"
 
 #include "nsContentPolicyUtils.h"
 #include "nsDataHandler.h"
@@ -81,6 +83,15 @@ bool ShouldCheckSRI(const InternalRequest& aRequest,
          aResponse.Type() != ResponseType::Error;
 }
 
+// The response body pipe has infinite capacity, so a consumer that reads
+// slower than the network delivers would otherwise buffer an entire download
+// in memory. Once the pipe holds more than the high watermark we suspend the
+// channel, then poll until the consumer has drained it below the low
+// watermark before resuming.
+const uint64_t kBackpressureHighWatermark = 4 * 1024 * 1024;
+const uint64_t kBackpressureLowWatermark = 1024 * 1024;
+const uint32_t kBackpressurePollIntervalMs = 50;
+
 }  // anonymous namespace
 
 //-----------------------------------------------------------------------------
@@ -355,6 +366,12 @@ FetchDriver::~FetchDriver() {
   // We assert this since even on failures, we should call
   // FailWithNetworkError().
   MOZ_ASSERT(mResponseAvailableCalled);
+
+  // The backpressure timer holds a raw pointer to us, so it must not
+  // outlive us.
+  if (mBackpressureTimer) {
+    mBackpressureTimer->Cancel();
+  }
 }
 
 already_AddRefed<PreloaderBase> FetchDriver::FindPreload(nsIURI* aURI) {
@@ -1091,9 +1108,10 @@ FetchDriver::OnStartRequest(nsIRequest* aRequest) {
   // We open a pipe so that we can immediately set the pipe's read end as the
   // response's body. Setting the segment size to UINT32_MAX means that the
   // pipe has infinite space. The nsIChannel will continue to buffer data in
-  // xpcom events even if we block on a fixed size pipe.  It might be possible
-  // to suspend the channel and then resume when there is space available, but
-  // for now use an infinite pipe to avoid blocking.
+  // xpcom events even if we block on a fixed size pipe. Writes therefore
+  // never fail, and flow control happens out of band: OnDataAvailable()
+  // suspends the channel when the amount buffered in the pipe passes the
+  // backpressure high watermark, and we resume once the consumer drains it.
   nsCOMPtr<nsIInputStream> pipeInputStream;
   rv = NS_NewPipe(getter_AddRefs(pipeInputStream),
                   getter_AddRefs(mPipeOutputStream),
@@ -1106,6 +1124,7 @@ FetchDriver::OnStartRequest(nsIRequest* aRequest) {
     // Cancel request.
     return rv;
   }
+  mPipeInputStream = pipeInputStream;
   response->SetBody(pipeInputStream, contentLength);
 
   // If the request is a file channel, then remember the local path to
@@ -1314,9 +1333,101 @@ FetchDriver::OnDataAvailable(nsIRequest* aRequest, nsIInputStream* aInputStream,
   if (aRead == 0 && aCount != 0) {
     return NS_BASE_STREAM_CLOSED;
   }
+
+  // If the consumer has fallen far enough behind, ask the main thread to
+  // suspend the channel until the pipe drains. The pending flag keeps us
+  // from piling up dispatches while one is already in flight.
+  if (!mBackpressureCheckPending) {
+    uint64_t buffered = 0;
+    if (NS_SUCCEEDED(mPipeInputStream->Available(&buffered)) &&
+        buffered > kBackpressureHighWatermark) {
+      mBackpressureCheckPending = true;
+      if (NS_IsMainThread()) {
+        MaybeEnforceBackpressure();
+      } else {
+        mMainThreadEventTarget->Dispatch(
+            NewRunnableMethod("FetchDriver::MaybeEnforceBackpressure", this,
+                              &FetchDriver::MaybeEnforceBackpressure),
+            NS_DISPATCH_NORMAL);
+      }
+    }
+  }
+
   return rv;
 }
 
+void FetchDriver::MaybeEnforceBackpressure() {
+  AssertIsOnMainThread();
+
+  mBackpressureCheckPending = false;
+
+  if (mChannelSuspendedByBackpressure || mOnStopRequestCalled || !mChannel ||
+      !mPipeInputStream) {
+    return;
+  }
+
+  // Re-check under main-thread control; the consumer may have caught up
+  // while the dispatch was in flight.
+  uint64_t buffered = 0;
+  if (NS_FAILED(mPipeInputStream->Available(&buffered)) ||
+      buffered <= kBackpressureHighWatermark) {
+    return;
+  }
+
+  if (NS_WARN_IF(NS_FAILED(mChannel->Suspend()))) {
+    return;
+  }
+  mChannelSuspendedByBackpressure = true;
+
+  // The pipe has no notification for "drained below a threshold", so poll.
+  // While we are suspended the channel's listener chain keeps us alive, and
+  // ReleaseBackpressure() cancels the timer before that goes away.
+  nsresult rv = NS_NewTimerWithFuncCallback(
+      getter_AddRefs(mBackpressureTimer),
+      &FetchDriver::BackpressureTimerCallback, this, kBackpressurePollIntervalMs,
+      nsITimer::TYPE_REPEATING_SLACK, "FetchDriver::BackpressureTimer",
+      mMainThreadEventTarget);
+  if (NS_WARN_IF(NS_FAILED(rv))) {
+    ReleaseBackpressure();
+  }
+}
+
+/* static */
+void FetchDriver::BackpressureTimerCallback(nsITimer* aTimer, void* aClosure) {
+  static_cast<FetchDriver*>(aClosure)->OnBackpressureTimer();
+}
+
+void FetchDriver::OnBackpressureTimer() {
+  AssertIsOnMainThread();
+
+  uint64_t buffered = 0;
+  nsresult rv = mPipeInputStream ? mPipeInputStream->Available(&buffered)
+                                 : NS_ERROR_FAILURE;
+
+  // Resume on drain, and also when the read end reports an error: that
+  // means the consumer is gone and the channel needs to run to completion
+  // (or cancellation) normally.
+  if (NS_FAILED(rv) || buffered <= kBackpressureLowWatermark) {
+    ReleaseBackpressure();
+  }
+}
+
+void FetchDriver::ReleaseBackpressure() {
+  AssertIsOnMainThread();
+
+  if (mBackpressureTimer) {
+    mBackpressureTimer->Cancel();
+    mBackpressureTimer = nullptr;
+  }
+
+  if (mChannelSuspendedByBackpressure) {
+    mChannelSuspendedByBackpressure = false;
+    if (mChannel) {
+      mChannel->Resume();
+    }
+  }
+}
+
 NS_IMETHODIMP
 FetchDriver::OnStopRequest(nsIRequest* aRequest, nsresult aStatusCode) {
   AssertIsOnMainThread();
@@ -1324,6 +1435,8 @@ FetchDriver::OnStopRequest(nsIRequest* aRequest, nsresult aStatusCode) {
   MOZ_DIAGNOSTIC_ASSERT(!mOnStopRequestCalled);
   mOnStopRequestCalled = true;
 
+  ReleaseBackpressure();
+
   // main data loading is going to finish, breaking the reference cycle.
   RefPtr<AlternativeDataStreamListener> altDataListener =
       std::move(mAltDataListener);
@@ -1579,6 +1692,9 @@ void FetchDriver::RunAbortAlgorithm() {
   }
 
   if (mChannel) {
+    // A suspended channel would sit on its cancellation status without
+    // delivering OnStopRequest, so lift any backpressure suspension first.
+    ReleaseBackpressure();
     mChannel->Cancel(NS_BINDING_ABORTED);
     mChannel = nullptr;
   }
@@ -11,6 +11,7 @@
 #include "nsIInterfaceRequestor.h"
 #include "nsIStreamListener.h"
 #include "nsIThreadRetargetableStreamListener.h"
+#include "mozilla/Atomics.h"
 #include "mozilla/ConsoleReportCollector.h"
 #include "mozilla/dom/AbortSignal.h"
 #include "mozilla/dom/SafeRefPtr.h"
@@ -25,9 +26,11 @@ class nsIConsoleReportCollector;
 class nsICookieJarSettings;
 class nsICSPEventListener;
 class nsIEventTarget;
+class nsIInputStream;
 class nsIOutputStream;
 class nsILoadGroup;
 class nsIPrincipal;
+class nsITimer;
 
 namespace mozilla {
 class PreloaderBase;
@@ -136,6 +139,9 @@ class FetchDriver final : public nsIStreamListener,
   SafeRefPtr<InternalRequest> mRequest;
   RefPtr<InternalResponse> mResponse;
   nsCOMPtr<nsIOutputStream> mPipeOutputStream;
+  // Read end of the response body pipe, kept so OnDataAvailable() can
+  // observe how much data the consumer has left unread.
+  nsCOMPtr<nsIInputStream> mPipeInputStream;
   RefPtr<FetchDriverObserver> mObserver;
   RefPtr<Document> mDocument;
   nsCOMPtr<nsICSPEventListener> mCSPEventListener;
@@ -164,6 +170,15 @@ class FetchDriver final : public nsIStreamListener,
   RefPtr<AlternativeDataStreamListener> mAltDataListener;
   bool mOnStopRequestCalled;
 
+  // Backpressure state: the response body pipe is infinite, so when the
+  // consumer falls behind we suspend mChannel instead of buffering without
+  // bound, and poll with this timer until the pipe drains. The timer and
+  // the flag are main thread only; the pending flag dedupes main-thread
+  // dispatches from OnDataAvailable() on other threads.
+  nsCOMPtr<nsITimer> mBackpressureTimer;
+  bool mChannelSuspendedByBackpressure = false;
+  Atomic<bool> mBackpressureCheckPending{false};
+
   // This flag is true when this fetch has found a matching preload and is being
   // satisfied by a its response.
   bool mFromPreload = false;
@@ -202,6 +217,14 @@ class FetchDriver final : public nsIStreamListener,
                          bool aStripRequestBodyHeader) const;
 
   void FinishOnStopRequest(AlternativeDataStreamListener* aAltDataListener);
+
+  // Suspends mChannel if the response body pipe is still above the
+  // backpressure high watermark, and starts the drain-polling timer.
+  void MaybeEnforceBackpressure();
+  // Resumes a backpressure-suspended channel and stops the polling timer.
+  void ReleaseBackpressure();
+  void OnBackpressureTimer();
+  static void BackpressureTimerCallback(nsITimer* aTimer, void* aClosure);
 };
 
 }  // namespace dom
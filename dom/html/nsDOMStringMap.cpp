@@ -211,21 +211,31 @@ bool nsDOMStringMap::AttrToDataProp(const nsAString& aAttr,
   // Don't try to mess with aResult's capacity: the probably-no-op SetCapacity()
   // call is not that fast.
 
-  // Iterate through attrName by character to form property name.
+  // Iterate through attrName to form the property name.
   // If there is a sequence of "-" followed by a character in the range "a" to
   // "z" then replace with upper case letter.
   // Otherwise append character to property name.
-  for (; cur < end; ++cur) {
+  while (cur < end) {
+    // Append the run of characters up to the next "-" in one go.
+    const char16_t* runStart = cur;
+    while (cur < end && char16_t('-') != *cur) {
+      ++cur;
+    }
+    aResult.Append(runStart, cur - runStart);
+    if (cur == end) {
+      break;
+    }
+
     const char16_t* next = cur + 1;
-    if (char16_t('-') == *cur && next < end && char16_t('a') <= *next &&
-        *next <= char16_t('z')) {
-      // Upper case the lower case letters that follow a "-".
+    if (next < end && char16_t('a') <= *next && *next <= char16_t('z')) {
+      // Upper case the lower case letter that follows the "-" and consume
+      // both characters.
       aResult.Append(*next - 'a' + 'A');
-      // Consume character to account for "-" character.
-      ++cur;
+      cur = next + 1;
     } else {
-      // Simply append character if camel case is not necessary.
-      aResult.Append(*cur);
+      // No camel casing necessary; keep the "-".
+      aResult.Append(char16_t('-'));
+      ++cur;
     }
   }
 
@@ -21,6 +21,7 @@
 #include "IDBTransaction.h"
 #include "IndexedDatabase.h"
 #include "IndexedDatabaseInlines.h"
+#include "IndexedDatabaseManager.h"
 #include "IndexedDBCommon.h"
 #include "js/Array.h"  // JS::NewArrayObject, JS::SetArrayLength
 #include "js/Date.h"   // JS::NewDateObject, JS::TimeClip
@@ -58,10 +59,6 @@
 #include "ReportInternalError.h"
 #include "ThreadLocal.h"
 
-#ifdef DEBUG
-#  include "IndexedDatabaseManager.h"
-#endif
-
 #define GC_ON_IPC_MESSAGES 0
 
 #if defined(DEBUG) || GC_ON_IPC_MESSAGES
@@ -2915,7 +2912,9 @@ BackgroundCursorChild<CursorType>::BackgroundCursorChild(
     : BackgroundCursorChildBase(aRequest, aDirection),
       mSource(WrapNotNull(aSource)),
       mCursor(nullptr),
-      mInFlightResponseInvalidationNeeded(false) {
+      mInFlightResponseInvalidationNeeded(false),
+      mBackgroundFillInFlight(false),
+      mBackgroundFillExhausted(false) {
   aSource->AssertIsOnOwningThread();
 
   MOZ_COUNT_CTOR(indexedDB::BackgroundCursorChild<CursorType>);
@@ -2960,9 +2959,22 @@ void BackgroundCursorChild<CursorType>::SendContinueInternal(
     currentObjectStoreKey = aCurrentData.mObjectStoreKey;
   }
 
-  switch (params.type()) {
+  DiscardCachedResponsesAndContinue(std::move(params), std::move(currentKey),
+                                    std::move(currentObjectStoreKey));
+}
+
+template <IDBCursorType CursorType>
+void BackgroundCursorChild<CursorType>::DiscardCachedResponsesAndContinue(
+    CursorRequestParams&& aParams, Key&& aCurrentKey,
+    Key&& aCurrentObjectStoreKey) {
+  AssertIsOnOwningThread();
+  MOZ_ASSERT(mRequest);
+  MOZ_ASSERT(mTransaction);
+  MOZ_ASSERT(mCursor);
+
+  switch (aParams.type()) {
     case CursorRequestParams::TContinueParams: {
-      const auto& key = params.get_ContinueParams().key();
+      const auto& key = aParams.get_ContinueParams().key();
       if (key.IsUnset()) {
         break;
       }
@@ -3006,9 +3018,9 @@ void BackgroundCursorChild<CursorType>::SendContinueInternal(
 
     case CursorRequestParams::TContinuePrimaryKeyParams: {
       if constexpr (!CursorTypeTraits<CursorType>::IsObjectStoreCursor) {
-        const auto& key = params.get_ContinuePrimaryKeyParams().key();
+        const auto& key = aParams.get_ContinuePrimaryKeyParams().key();
         const auto& primaryKey =
-            params.get_ContinuePrimaryKeyParams().primaryKey();
+            aParams.get_ContinuePrimaryKeyParams().primaryKey();
         if (key.IsUnset() || primaryKey.IsUnset()) {
           break;
         }
@@ -3064,27 +3076,27 @@ void BackgroundCursorChild<CursorType>::SendContinueInternal(
     }
 
     case CursorRequestParams::TAdvanceParams: {
-      uint32_t& advanceCount = params.get_AdvanceParams().count();
+      uint32_t& advanceCount = aParams.get_AdvanceParams().count();
       IDB_LOG_MARK_CHILD_TRANSACTION_REQUEST(
           "PRELOAD: Advancing %" PRIu32 " records", "Advancing %" PRIu32,
           mTransaction->LoggingSerialNumber(),
           GetRequest()->LoggingSerialNumber(), advanceCount);
 
       // Discard cache entries.
-      DiscardCachedResponses([&advanceCount, &currentKey,
-                              &currentObjectStoreKey](
+      DiscardCachedResponses([&advanceCount, &aCurrentKey,
+                              &aCurrentObjectStoreKey](
                                  const auto& currentCachedResponse) {
         const bool res = advanceCount > 1;
         if (res) {
           --advanceCount;
 
-          // TODO: We only need to update currentKey on the last entry, the
+          // TODO: We only need to update aCurrentKey on the last entry, the
           // others are overwritten in the next iteration anyway.
-          currentKey = currentCachedResponse.mKey;
+          aCurrentKey = currentCachedResponse.mKey;
           if constexpr (!CursorTypeTraits<CursorType>::IsObjectStoreCursor) {
-            currentObjectStoreKey = currentCachedResponse.mObjectStoreKey;
+            aCurrentObjectStoreKey = currentCachedResponse.mObjectStoreKey;
           } else {
-            Unused << currentObjectStoreKey;
+            Unused << aCurrentObjectStoreKey;
           }
         }
         return res;
@@ -3113,13 +3125,169 @@ void BackgroundCursorChild<CursorType>::SendContinueInternal(
             SafeRefPtrFromThis(),
             &BackgroundCursorChild::CompleteContinueRequestFromCache)));
 
-    // TODO: Could we preload further entries in the background when the size of
-    // mCachedResponses falls under some threshold? Or does the response
-    // handling model disallow this?
+    // Top the cache up again in the background before it drains completely,
+    // so that steady iteration is served locally without blocking round
+    // trips.
+    MaybeSendBackgroundFill();
+  } else if (mBackgroundFillInFlight) {
+    // More records are already on their way, and the parent only allows a
+    // single running cursor operation at a time, so we must not send a
+    // request of our own now. Deliver the front of the cache when the
+    // prefetched records arrive.
+    mDeferredContinue.emplace(
+        DeferredContinue{std::move(aParams), std::move(aCurrentKey),
+                         std::move(aCurrentObjectStoreKey)});
   } else {
     MOZ_ALWAYS_TRUE(PBackgroundIDBCursorChild::SendContinue(
-        params, currentKey, currentObjectStoreKey));
+        aParams, aCurrentKey, aCurrentObjectStoreKey));
+  }
+}
+
+template <IDBCursorType CursorType>
+void BackgroundCursorChild<CursorType>::MaybeSendBackgroundFill() {
+  AssertIsOnOwningThread();
+  MOZ_ASSERT(mTransaction);
+  MOZ_ASSERT(mCursor);
+
+  if (mBackgroundFillInFlight || mBackgroundFillExhausted) {
+    return;
+  }
+
+  const int32_t maxExtraCount =
+      IndexedDatabaseManager::MaxPreloadExtraRecords();
+  if (maxExtraCount <= 0) {
+    // Preloading is disabled.
+    return;
   }
+
+  // Only refill when the cache has drained below half of a full preload
+  // batch; earlier requests would prefetch records we might never consume.
+  if (mCachedResponses.size() > static_cast<size_t>(maxExtraCount) / 2) {
+    return;
+  }
+
+  // Continue from the last record we received; everything up to it is
+  // already available locally. Responses moved to mDelayedResponses are
+  // about to be consumed, so they count as received as well.
+  MOZ_ASSERT(!mCachedResponses.empty() || !mDelayedResponses.empty());
+  const auto& lastLocalRecord =
+      mCachedResponses.empty() ? mDelayedResponses.back()
+                               : mCachedResponses.back();
+
+  Key currentObjectStoreKey;
+  if constexpr (!CursorTypeTraits<CursorType>::IsObjectStoreCursor) {
+    currentObjectStoreKey = lastLocalRecord.mObjectStoreKey;
+  }
+
+  IDB_LOG_MARK_CHILD_TRANSACTION_REQUEST(
+      "PRELOAD: Background fill from key %s, %zu cached responses remaining",
+      "Background fill%.0s; remaining %zu",
+      mTransaction->LoggingSerialNumber(), GetRequest()->LoggingSerialNumber(),
+      lastLocalRecord.mKey.GetBuffer().get(), mCachedResponses.size());
+
+  // Keep the transaction from auto-committing until the response arrives.
+  mTransaction->OnNewRequest();
+  mBackgroundFillInFlight = true;
+
+  MOZ_ALWAYS_TRUE(PBackgroundIDBCursorChild::SendContinue(
+      ContinueParams(Key()), lastLocalRecord.mKey, currentObjectStoreKey));
+}
+
+template <IDBCursorType CursorType>
+void BackgroundCursorChild<CursorType>::HandleBackgroundFillResponse(
+    CursorResponse&& aResponse) {
+  AssertIsOnOwningThread();
+  MOZ_ASSERT(mBackgroundFillInFlight);
+  MOZ_ASSERT(mTransaction);
+  MOZ_ASSERT_IF(!mDeferredContinue, !mStrongCursor);
+
+  mBackgroundFillInFlight = false;
+
+  const auto transaction =
+      SafeRefPtr{&mTransaction.ref(), AcquireStrongRefFromRawPtr{}};
+
+  if (mInFlightResponseInvalidationNeeded) {
+    // The records were read before a write that may have changed them;
+    // discard them wholesale. There is no current result to deliver from a
+    // speculative request, so unlike the regular invalidation handling we do
+    // not keep the first record either.
+    IDB_LOG_MARK_CHILD_TRANSACTION_REQUEST(
+        "PRELOAD: Discarding background fill response since "
+        "mInFlightResponseInvalidationNeeded is set",
+        "Discarding background fill", mTransaction->LoggingSerialNumber(),
+        GetRequest()->LoggingSerialNumber());
+
+    mInFlightResponseInvalidationNeeded = false;
+  } else {
+    switch (aResponse.type()) {
+      case CursorResponse::Tnsresult:
+        // A speculative read failed. Do not dispatch an error event for a
+        // request the application never made; if the failure persists, the
+        // next explicit continue will surface it.
+        mBackgroundFillExhausted = true;
+        break;
+
+      case CursorResponse::Tvoid_t:
+        // The cursor range is exhausted; remember that so we stop asking.
+        mBackgroundFillExhausted = true;
+        break;
+
+      case CursorResponse::TArrayOfObjectStoreCursorResponse:
+        if constexpr (CursorType == IDBCursorType::ObjectStore) {
+          HandleResponse(
+              std::move(aResponse.get_ArrayOfObjectStoreCursorResponse()),
+              /* aForBackgroundFill */ true);
+        } else {
+          MOZ_CRASH("Response type mismatch");
+        }
+        break;
+
+      case CursorResponse::TArrayOfObjectStoreKeyCursorResponse:
+        if constexpr (CursorType == IDBCursorType::ObjectStoreKey) {
+          HandleResponse(
+              std::move(aResponse.get_ArrayOfObjectStoreKeyCursorResponse()),
+              /* aForBackgroundFill */ true);
+        } else {
+          MOZ_CRASH("Response type mismatch");
+        }
+        break;
+
+      case CursorResponse::TArrayOfIndexCursorResponse:
+        if constexpr (CursorType == IDBCursorType::Index) {
+          HandleResponse(std::move(aResponse.get_ArrayOfIndexCursorResponse()),
+                         /* aForBackgroundFill */ true);
+        } else {
+          MOZ_CRASH("Response type mismatch");
+        }
+        break;
+
+      case CursorResponse::TArrayOfIndexKeyCursorResponse:
+        if constexpr (CursorType == IDBCursorType::IndexKey) {
+          HandleResponse(
+              std::move(aResponse.get_ArrayOfIndexKeyCursorResponse()),
+              /* aForBackgroundFill */ true);
+        } else {
+          MOZ_CRASH("Response type mismatch");
+        }
+        break;
+
+      default:
+        MOZ_CRASH("Should never get here!");
+    }
+  }
+
+  if (mDeferredContinue) {
+    // The application's continue() raced with the background fill; complete
+    // it now that the prefetched records (if any) are in the cache.
+    auto deferred = std::move(*mDeferredContinue);
+    mDeferredContinue.reset();
+
+    DiscardCachedResponsesAndContinue(
+        std::move(deferred.mParams), std::move(deferred.mCurrentKey),
+        std::move(deferred.mCurrentObjectStoreKey));
+  }
+
+  transaction->OnRequestFinished(/* aRequestCompletedSuccessfully */ true);
 }
 
 template <IDBCursorType CursorType>
@@ -3195,8 +3363,9 @@ void BackgroundCursorChild<CursorType>::InvalidateCachedResponses() {
   // We only hold a strong cursor reference in mStrongCursor when
   // continue()/similar has been called. In those cases we expect a response
   // that will be received in the future, and it may include prefetched data
-  // that needs to be discarded.
-  if (mStrongCursor) {
+  // that needs to be discarded. The same holds for a speculative background
+  // fill that is still in flight.
+  if (mStrongCursor || mBackgroundFillInFlight) {
     IDB_LOG_MARK_CHILD_TRANSACTION_REQUEST(
         "PRELOAD: Setting flag to invalidate in-flight responses",
         "Set flag to invalidate in-flight responses",
@@ -3205,6 +3374,10 @@ void BackgroundCursorChild<CursorType>::InvalidateCachedResponses() {
 
     mInFlightResponseInvalidationNeeded = true;
   }
+
+  // The write that invalidated the cache may also have added records beyond
+  // the point where a previous background fill ran out of them.
+  mBackgroundFillExhausted = false;
 }
 
 template <IDBCursorType CursorType>
@@ -3294,25 +3467,31 @@ BackgroundCursorChild<CursorType>::HandleIndividualCursorResponse(
 template <IDBCursorType CursorType>
 template <typename Func>
 void BackgroundCursorChild<CursorType>::HandleMultipleCursorResponses(
-    nsTArray<ResponseType>&& aResponses, const Func& aHandleRecord) {
+    const bool aForBackgroundFill, nsTArray<ResponseType>&& aResponses,
+    const Func& aHandleRecord) {
   AssertIsOnOwningThread();
   MOZ_ASSERT(mRequest);
   MOZ_ASSERT(mTransaction);
   MOZ_ASSERT(!mStrongRequest);
-  MOZ_ASSERT(!mStrongCursor);
+  // A deferred continue may be holding the cursor alive while a background
+  // fill response is processed.
+  MOZ_ASSERT_IF(!aForBackgroundFill, !mStrongCursor);
   MOZ_ASSERT(aResponses.Length() > 0);
 
   IDB_LOG_MARK_CHILD_TRANSACTION_REQUEST(
       "PRELOAD: Received %zu cursor responses", "Received %zu",
       mTransaction->LoggingSerialNumber(), GetRequest()->LoggingSerialNumber(),
       aResponses.Length());
-  MOZ_ASSERT_IF(aResponses.Length() > 1, mCachedResponses.empty());
+  MOZ_ASSERT_IF(aResponses.Length() > 1 && !aForBackgroundFill,
+                mCachedResponses.empty());
 
   // If a new cursor is created, we need to keep a reference to it until the
   // SetResultAndDispatchSuccessEvent creates a DOM Binding.
   RefPtr<IDBCursor> strongNewCursor;
 
-  bool isFirst = true;
+  // Records from a background fill are all appended to the cache; there is no
+  // request waiting for a current result.
+  bool isFirst = !aForBackgroundFill;
   for (auto& response : aResponses) {
     IDB_LOG_MARK_CHILD_TRANSACTION_REQUEST(
         "PRELOAD: Processing response for key %s", "Processing%.0s",
@@ -3344,6 +3523,10 @@ void BackgroundCursorChild<CursorType>::HandleMultipleCursorResponses(
     }
   }
 
+  if (aForBackgroundFill) {
+    return;
+  }
+
   SetResultAndDispatchSuccessEvent(
       GetRequest(),
       mTransaction
@@ -3354,7 +3537,7 @@ void BackgroundCursorChild<CursorType>::HandleMultipleCursorResponses(
 
 template <IDBCursorType CursorType>
 void BackgroundCursorChild<CursorType>::HandleResponse(
-    nsTArray<ResponseType>&& aResponses) {
+    nsTArray<ResponseType>&& aResponses, const bool aForBackgroundFill) {
   AssertIsOnOwningThread();
 
   if constexpr (CursorType == IDBCursorType::ObjectStore ||
@@ -3370,8 +3553,9 @@ void BackgroundCursorChild<CursorType>::HandleResponse(
 
   if constexpr (CursorType == IDBCursorType::ObjectStore) {
     HandleMultipleCursorResponses(
-        std::move(aResponses), [this](const bool useAsCurrentResult,
-                                      ObjectStoreCursorResponse&& response) {
+        aForBackgroundFill, std::move(aResponses),
+        [this](const bool useAsCurrentResult,
+               ObjectStoreCursorResponse&& response) {
           // TODO: Maybe move the deserialization of the clone-read-info into
           // the cursor, so that it is only done for records actually accessed,
           // which might not be the case for all cached records.
@@ -3384,15 +3568,16 @@ void BackgroundCursorChild<CursorType>::HandleResponse(
   }
   if constexpr (CursorType == IDBCursorType::ObjectStoreKey) {
     HandleMultipleCursorResponses(
-        std::move(aResponses), [this](const bool useAsCurrentResult,
-                                      ObjectStoreKeyCursorResponse&& response) {
+        aForBackgroundFill, std::move(aResponses),
+        [this](const bool useAsCurrentResult,
+               ObjectStoreKeyCursorResponse&& response) {
           return HandleIndividualCursorResponse(useAsCurrentResult,
                                                 std::move(response.key()));
         });
   }
   if constexpr (CursorType == IDBCursorType::Index) {
     HandleMultipleCursorResponses(
-        std::move(aResponses),
+        aForBackgroundFill, std::move(aResponses),
         [this](const bool useAsCurrentResult, IndexCursorResponse&& response) {
           return HandleIndividualCursorResponse(
               useAsCurrentResult, std::move(response.key()),
@@ -3404,8 +3589,9 @@ void BackgroundCursorChild<CursorType>::HandleResponse(
   }
   if constexpr (CursorType == IDBCursorType::IndexKey) {
     HandleMultipleCursorResponses(
-        std::move(aResponses), [this](const bool useAsCurrentResult,
-                                      IndexKeyCursorResponse&& response) {
+        aForBackgroundFill, std::move(aResponses),
+        [this](const bool useAsCurrentResult,
+               IndexKeyCursorResponse&& response) {
           return HandleIndividualCursorResponse(
               useAsCurrentResult, std::move(response.key()),
               std::move(response.sortKey()), std::move(response.objectKey()));
@@ -3426,6 +3612,14 @@ void BackgroundCursorChild<CursorType>::ActorDestroy(ActorDestroyReason aWhy) {
                                     aWhy == Deletion);
   }
 
+  if (mBackgroundFillInFlight && mTransaction) {
+    // Balance the OnNewRequest from MaybeSendBackgroundFill; the response is
+    // not going to arrive anymore.
+    mBackgroundFillInFlight = false;
+    mTransaction->OnRequestFinished(/* aRequestCompletedSuccessfully */
+                                    aWhy == Deletion);
+  }
+
   if (mCursor) {
     mCursor->ClearBackgroundActor();
 #ifdef DEBUG
@@ -3447,11 +3641,20 @@ mozilla::ipc::IPCResult BackgroundCursorChild<CursorType>::RecvResponse(
   MOZ_ASSERT(aResponse.type() != CursorResponse::T__None);
   MOZ_ASSERT(mRequest);
   MOZ_ASSERT(mTransaction);
-  MOZ_ASSERT_IF(mCursor, mStrongCursor);
-  MOZ_ASSERT_IF(!mCursor, mStrongRequest);
 
   MaybeCollectGarbageOnIPCMessage();
 
+  if (mBackgroundFillInFlight) {
+    // Requests are answered in order, and a foreground request is never sent
+    // while a background fill is outstanding, so this response must belong to
+    // the background fill.
+    HandleBackgroundFillResponse(std::move(aResponse));
+    return IPC_OK();
+  }
+
+  MOZ_ASSERT_IF(mCursor, mStrongCursor);
+  MOZ_ASSERT_IF(!mCursor, mStrongRequest);
+
   const RefPtr<IDBRequest> request = std::move(mStrongRequest);
   Unused << request;  // XXX see Bug 1605075
   const RefPtr<IDBCursor> cursor = std::move(mStrongCursor);
@@ -637,6 +637,21 @@ class BackgroundCursorChild final : public BackgroundCursorChildBase {
   std::deque<CursorData<CursorType>> mCachedResponses, mDelayedResponses;
   bool mInFlightResponseInvalidationNeeded;
 
+  // State of the speculative refill of mCachedResponses (see
+  // MaybeSendBackgroundFill). The parent allows only one running cursor
+  // operation at a time, so while a background fill is in flight a
+  // user-initiated continue that finds the cache empty must not send its own
+  // request; it is recorded in mDeferredContinue instead and replayed when
+  // the prefetched records arrive.
+  struct DeferredContinue {
+    CursorRequestParams mParams;
+    Key mCurrentKey;
+    Key mCurrentObjectStoreKey;
+  };
+  bool mBackgroundFillInFlight;
+  bool mBackgroundFillExhausted;
+  Maybe<DeferredContinue> mDeferredContinue;
+
  public:
   BackgroundCursorChild(NotNull<IDBRequest*> aRequest, SourceType* aSource,
                         Direction aDirection);
@@ -664,14 +679,24 @@ class BackgroundCursorChild final : public BackgroundCursorChildBase {
 
   void CompleteContinueRequestFromCache();
 
+  void DiscardCachedResponsesAndContinue(CursorRequestParams&& aParams,
+                                         Key&& aCurrentKey,
+                                         Key&& aCurrentObjectStoreKey);
+
+  void MaybeSendBackgroundFill();
+
+  void HandleBackgroundFillResponse(CursorResponse&& aResponse);
+
   using BackgroundCursorChildBase::HandleResponse;
 
   void HandleResponse(const void_t& aResponse);
 
-  void HandleResponse(nsTArray<ResponseType>&& aResponses);
+  void HandleResponse(nsTArray<ResponseType>&& aResponses,
+                      bool aForBackgroundFill = false);
 
   template <typename Func>
-  void HandleMultipleCursorResponses(nsTArray<ResponseType>&& aResponses,
+  void HandleMultipleCursorResponses(bool aForBackgroundFill,
+                                     nsTArray<ResponseType>&& aResponses,
                                      const Func& aHandleRecord);
 
   template <typename... Args>
@@ -19945,18 +19945,24 @@ nsresult ObjectStoreAddOrPutRequestOp::DoDatabaseWork(
 
       IDB_TRY(stmt->BindInt64ByName(kStmtParamNameData, data));
     } else {
+      // Compress the bytes before adding into the database. Snappy needs a
+      // contiguous source buffer, but the clone data extracted from the IPC
+      // message usually occupies a single segment already, in which case we
+      // compress straight from it instead of copying the whole record into a
+      // temporary buffer first.
       nsCString flatCloneData;
-      if (!flatCloneData.SetLength(cloneDataSize, fallible)) {
-        return NS_ERROR_OUT_OF_MEMORY;
-      }
-      {
-        auto iter = cloneData.Start();
+      const char* uncompressed;
+      auto iter = cloneData.Start();
+      if (!iter.Done() && iter.RemainingInSegment() >= cloneDataSize) {
+        uncompressed = iter.Data();
+      } else {
+        if (!flatCloneData.SetLength(cloneDataSize, fallible)) {
+          return NS_ERROR_OUT_OF_MEMORY;
+        }
         MOZ_ALWAYS_TRUE(cloneData.ReadBytes(iter, flatCloneData.BeginWriting(),
                                             cloneDataSize));
+        uncompressed = flatCloneData.BeginReading();
       }
-
-      // Compress the bytes before adding into the database.
-      const char* const uncompressed = flatCloneData.BeginReading();
       const size_t uncompressedLength = cloneDataSize;
 
       size_t compressedLength = snappy::MaxCompressedLength(uncompressedLength);
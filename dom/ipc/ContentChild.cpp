@@ -2018,8 +2018,8 @@ bool ContentChild::DeallocPWebrtcGlobalChild(PWebrtcGlobalChild* aActor) {
 }
 
 mozilla::ipc::IPCResult ContentChild::RecvRegisterChrome(
-    nsTArray<ChromePackage>&& packages,
-    nsTArray<SubstitutionMapping>&& resources,
+    const mozilla::ipc::FileDescriptor& packageMapFile,
+    const uint32_t& packageMapSize, nsTArray<SubstitutionMapping>&& resources,
     nsTArray<OverrideMapping>&& overrides, const nsCString& locale,
     const bool& reset) {
   nsCOMPtr<nsIChromeRegistry> registrySvc = nsChromeRegistry::GetService();
@@ -2028,8 +2028,8 @@ mozilla::ipc::IPCResult ContentChild::RecvRegisterChrome(
   if (!chromeRegistry) {
     return IPC_FAIL(this, "ChromeRegistryContent is null!");
   }
-  chromeRegistry->RegisterRemoteChrome(packages, resources, overrides, locale,
-                                       reset);
+  chromeRegistry->RegisterRemoteChrome(packageMapFile, packageMapSize,
+                                       resources, overrides, locale, reset);
   return IPC_OK();
 }
 
@@ -2640,11 +2640,36 @@ mozilla::ipc::IPCResult ContentChild::RecvRemoteType(
   // RemoteWorkerManager in the parent process.
   if (mRemoteType != PREALLOC_REMOTE_TYPE) {
     RemoteWorkerService::Initialize();
+  } else if (StaticPrefs::dom_ipc_processPrelaunch_warmup()) {
+    // We'll sit idle until we're adopted.  Use that time to run the init
+    // that the first document would otherwise trigger lazily.
+    NS_DispatchToMainThreadQueue(
+        NewRunnableMethod("ContentChild::WarmUpPreallocatedProcess", this,
+                          &ContentChild::WarmUpPreallocatedProcess),
+        EventQueuePriority::Idle);
   }
 
   return IPC_OK();
 }
 
+void ContentChild::WarmUpPreallocatedProcess() {
+  // We may have been adopted, or shutdown may have begun, since this was
+  // scheduled.
+  if (mRemoteType != PREALLOC_REMOTE_TYPE || mShuttingDown) {
+    return;
+  }
+
+  // Map the user agent style sheets shared by the parent; every document's
+  // style set needs them.
+  Unused << GlobalStyleSheetCache::Singleton();
+
+  // Initialize gfx and the platform font list, attaching the shared font
+  // list blocks we received with the process attributes.  This is normally
+  // deferred until the first reflow.
+  gfxPlatform::GetPlatform();
+  gfxPlatformFontList::PlatformFontList();
+}
+
 // Call RemoteTypePrefix() on the result to remove URIs if you want to use this
 // for telemetry.
 const nsACString& ContentChild::GetRemoteType() const { return mRemoteType; }
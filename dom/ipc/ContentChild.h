@@ -283,7 +283,8 @@ class ContentChild final : public PContentChild,
 #endif
 
   mozilla::ipc::IPCResult RecvRegisterChrome(
-      nsTArray<ChromePackage>&& packages,
+      const mozilla::ipc::FileDescriptor& packageMapFile,
+      const uint32_t& packageMapSize,
       nsTArray<SubstitutionMapping>&& resources,
       nsTArray<OverrideMapping>&& overrides, const nsCString& locale,
       const bool& reset);
@@ -396,6 +397,11 @@ class ContentChild final : public PContentChild,
 
   mozilla::ipc::IPCResult RecvRemoteType(const nsCString& aRemoteType);
 
+  // Runs, at idle priority while this process waits to be adopted, the init
+  // that is otherwise deferred until the first document so that a new tab
+  // taking a preallocated process doesn't have to pay for it.
+  void WarmUpPreallocatedProcess();
+
   // Call RemoteTypePrefix() on the result to remove URIs if you want to use
   // this for telemetry.
   const nsACString& GetRemoteType() const override;
@@ -593,6 +593,10 @@ UniquePtr<nsDataHashtable<nsUint32HashKey, ContentParent*>>
 UniquePtr<nsTArray<ContentParent*>> ContentParent::sPrivateContent;
 UniquePtr<LinkedList<ContentParent>> ContentParent::sContentParents;
 StaticRefPtr<ContentParent> ContentParent::sRecycledE10SProcess;
+
+// The number of processes currently kept around as cached idle site
+// processes (see ContentParent::TryToCacheSiteProcess).
+static uint32_t sSiteProcessCacheCount = 0;
 #if defined(XP_LINUX) && defined(MOZ_SANDBOX)
 UniquePtr<SandboxBrokerPolicyFactory>
     ContentParent::sSandboxBrokerPolicyFactory;
@@ -1565,7 +1569,7 @@ void ContentParent::MaybeBeginShutDown(uint32_t aExpectedBrowserCount,
   MOZ_ASSERT(NS_IsMainThread());
 
   if (ManagedPBrowserParent().Count() != aExpectedBrowserCount ||
-      ShouldKeepProcessAlive() || TryToRecycle()) {
+      ShouldKeepProcessAlive() || TryToRecycle() || TryToCacheSiteProcess()) {
     return;
   }
 
@@ -1841,6 +1845,16 @@ void ContentParent::ActorDestroy(ActorDestroyReason why) {
     mForceKillTimer = nullptr;
   }
 
+  StopSiteProcessCaching(/* aForeground */ false);
+
+  if (mSharedHistogramCounters.IsReadable()) {
+    // Merge any remaining counts before the region is unmapped with the
+    // channel.
+    TelemetryIPC::UnregisterSharedHistogramCounters(
+        mSharedHistogramCounters.get<uint8_t>());
+    mSharedHistogramCounters = Shmem();
+  }
+
   // Signal shutdown completion regardless of error state, so we can
   // finish waiting in the xpcom-shutdown/profile-before-change observer.
   RemoveShutdownBlockers();
@@ -2058,6 +2072,8 @@ bool ContentParent::TryToRecycle() {
 }
 
 void ContentParent::StopRecycling(bool aForeground) {
+  StopSiteProcessCaching(aForeground);
+
   if (sRecycledE10SProcess != this) {
     return;
   }
@@ -2069,6 +2085,87 @@ void ContentParent::StopRecycling(bool aForeground) {
   }
 }
 
+bool ContentParent::TryToCacheSiteProcess() {
+  // With Fission, the remote type of a "webIsolated=" process names the site
+  // it hosts, so the per-type process pool already acts as a site-to-process
+  // index. Keep a just-idled process in its pool for a grace period instead
+  // of shutting it down: navigating back to the site then reuses it, along
+  // with its warmed JIT code and caches, instead of paying a process launch
+  // and a cold start.
+  if (!StaticPrefs::dom_ipc_processReuse_siteAffinity_enabled() ||
+      !mozilla::FissionAutostart() ||
+      RemoteTypePrefix(mRemoteType) != FISSION_WEB_REMOTE_TYPE) {
+    return false;
+  }
+
+  if (mCalledKillHard || !IsAlive() || IsDead()) {
+    StopSiteProcessCaching(/* aForeground */ false);
+    return false;
+  }
+
+  if (mCachedAsSiteProcess) {
+    if (mSiteProcessCacheTimer) {
+      // Still within the grace period.
+      return true;
+    }
+    // The grace period expired; let shutdown proceed.
+    StopSiteProcessCaching(/* aForeground */ false);
+    return false;
+  }
+
+  if (sSiteProcessCacheCount >=
+      StaticPrefs::dom_ipc_processReuse_siteAffinity_maxProcesses()) {
+    MOZ_LOG(ContentParent::GetLog(), LogLevel::Debug,
+            ("TryToCacheSiteProcess did not cache %p (cache is full)", this));
+    return false;
+  }
+
+  MOZ_LOG(ContentParent::GetLog(), LogLevel::Debug,
+          ("TryToCacheSiteProcess caching %p for %s", this, mRemoteType.get()));
+
+  mCachedAsSiteProcess = true;
+  sSiteProcessCacheCount++;
+
+  ProcessPriorityManager::SetProcessPriority(this, PROCESS_PRIORITY_BACKGROUND);
+
+  NS_NewTimerWithFuncCallback(
+      getter_AddRefs(mSiteProcessCacheTimer), SiteProcessCacheTimerCallback,
+      this, StaticPrefs::dom_ipc_processReuse_siteAffinity_gracePeriodMS(),
+      nsITimer::TYPE_ONE_SHOT, "dom::ContentParent::TryToCacheSiteProcess");
+  MOZ_ASSERT(mSiteProcessCacheTimer);
+  return true;
+}
+
+void ContentParent::StopSiteProcessCaching(bool aForeground) {
+  if (!mCachedAsSiteProcess) {
+    return;
+  }
+
+  mCachedAsSiteProcess = false;
+  MOZ_ASSERT(sSiteProcessCacheCount > 0);
+  sSiteProcessCacheCount--;
+
+  if (mSiteProcessCacheTimer) {
+    mSiteProcessCacheTimer->Cancel();
+    mSiteProcessCacheTimer = nullptr;
+  }
+
+  if (aForeground) {
+    ProcessPriorityManager::SetProcessPriority(this,
+                                               PROCESS_PRIORITY_FOREGROUND);
+  }
+}
+
+// static
+void ContentParent::SiteProcessCacheTimerCallback(nsITimer* aTimer,
+                                                  void* aObject) {
+  // The timer holds no reference; StopSiteProcessCaching cancels it before
+  // the ContentParent can go away.
+  auto* self = static_cast<ContentParent*>(aObject);
+  self->mSiteProcessCacheTimer = nullptr;
+  self->MaybeBeginShutDown();
+}
+
 bool ContentParent::HasActiveWorkerOrJSPlugin() {
   if (IsForJSPlugin()) {
     return true;
@@ -3181,6 +3278,19 @@ mozilla::ipc::IPCResult ContentParent::RecvGetClipboard(
   return IPC_OK();
 }
 
+mozilla::ipc::IPCResult ContentParent::RecvGetClipboardAsync(
+    nsTArray<nsCString>&& aTypes, const int32_t& aWhichClipboard,
+    GetClipboardAsyncResolver&& aResolver) {
+  // The clipboard read itself is the same as for the sync message; only the
+  // reply differs, so the child isn't blocked while we talk to the native
+  // clipboard.
+  IPCDataTransfer dataTransfer;
+  mozilla::ipc::IPCResult rv =
+      RecvGetClipboard(std::move(aTypes), aWhichClipboard, &dataTransfer);
+  aResolver(std::move(dataTransfer));
+  return rv;
+}
+
 mozilla::ipc::IPCResult ContentParent::RecvEmptyClipboard(
     const int32_t& aWhichClipboard) {
   nsresult rv;
@@ -6006,6 +6116,20 @@ mozilla::ipc::IPCResult ContentParent::RecvRecordDiscardedData(
   return IPC_OK();
 }
 
+mozilla::ipc::IPCResult ContentParent::RecvRegisterSharedHistogramCounters(
+    Shmem&& aShmem) {
+  if (mSharedHistogramCounters.IsReadable()) {
+    return IPC_FAIL(this, "Shared histogram counters already registered");
+  }
+  TelemetryIPC::RegisterSharedHistogramCounters(
+      GetTelemetryProcessID(mRemoteType), aShmem.get<uint8_t>(),
+      aShmem.Size<uint8_t>());
+  // Keep the Shmem alive so the region stays mapped until ActorDestroy
+  // unregisters it.
+  mSharedHistogramCounters = std::move(aShmem);
+  return IPC_OK();
+}
+
 //////////////////////////////////////////////////////////////////
 // PURLClassifierParent
 
@@ -828,6 +828,22 @@ class ContentParent final
    */
   void StopRecycling(bool aForeground = true);
 
+  /**
+   * With Fission, keep a just-idled site-specific ("webIsolated") process in
+   * its pool for a grace period instead of shutting it down, so that
+   * navigating back to the site reuses the process along with its warmed JIT
+   * code and caches. Returns true if the process is being kept around.
+   */
+  bool TryToCacheSiteProcess();
+
+  /**
+   * Unmark this process as a cached idle site process, cancelling the grace
+   * period. If `aForeground` is true, also restores its foreground priority.
+   */
+  void StopSiteProcessCaching(bool aForeground);
+
+  static void SiteProcessCacheTimerCallback(nsITimer* aTimer, void* aObject);
+
   /**
    * Removing it from the static array so it won't be returned for new tabs in
    * GetNewOrUsedBrowserProcess.
@@ -1029,6 +1045,10 @@ class ContentParent final
                                            const int32_t& aWhichClipboard,
                                            IPCDataTransfer* aDataTransfer);
 
+  mozilla::ipc::IPCResult RecvGetClipboardAsync(
+      nsTArray<nsCString>&& aTypes, const int32_t& aWhichClipboard,
+      GetClipboardAsyncResolver&& aResolver);
+
   mozilla::ipc::IPCResult RecvEmptyClipboard(const int32_t& aWhichClipboard);
 
   mozilla::ipc::IPCResult RecvClipboardHasType(nsTArray<nsCString>&& aTypes,
@@ -1246,6 +1266,7 @@ class ContentParent final
       nsTArray<ChildEventData>&& events);
   mozilla::ipc::IPCResult RecvRecordDiscardedData(
       const DiscardedData& aDiscardedData);
+  mozilla::ipc::IPCResult RecvRegisterSharedHistogramCounters(Shmem&& aShmem);
   mozilla::ipc::IPCResult RecvRecordOrigin(const uint32_t& aMetricId,
                                            const nsCString& aOrigin);
   mozilla::ipc::IPCResult RecvReportContentBlockingLog(
@@ -1472,6 +1493,18 @@ class ContentParent final
   // timer.
   nsCOMPtr<nsITimer> mForceKillTimer;
 
+  // Bounds the grace period while this process is kept around as a cached
+  // idle site process (see TryToCacheSiteProcess).
+  nsCOMPtr<nsITimer> mSiteProcessCacheTimer;
+
+  // True while this process is a cached idle site process.
+  bool mCachedAsSiteProcess = false;
+
+  // The child's shared count histogram region; see
+  // RecvRegisterSharedHistogramCounters. Invalid until the child registers
+  // one.
+  mozilla::ipc::Shmem mSharedHistogramCounters;
+
   // `mCount` is increased when a RemoteWorkerParent actor is created for this
   // ContentProcess and it is decreased when the actor is destroyed.
   //
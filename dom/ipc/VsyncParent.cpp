@@ -18,7 +18,7 @@ namespace mozilla::dom {
 VsyncParent::VsyncParent()
     : mObservingVsync(false),
       mDestroyed(false),
-      mInitialThread(NS_GetCurrentThread()) {}
+      mInitialEventTarget(GetCurrentSerialEventTarget()) {}
 
 void VsyncParent::UpdateVsyncSource(
     const RefPtr<gfx::VsyncSource>& aVsyncSource) {
@@ -37,7 +37,7 @@ void VsyncParent::UpdateVsyncSource(
 }
 
 bool VsyncParent::NotifyVsync(const VsyncEvent& aVsync) {
-  if (IsOnInitialThread()) {
+  if (IsOnInitialEventTarget()) {
     DispatchVsyncEvent(aVsync);
     return true;
   }
@@ -46,12 +46,13 @@ bool VsyncParent::NotifyVsync(const VsyncEvent& aVsync) {
   nsCOMPtr<nsIRunnable> vsyncEvent = NewRunnableMethod<VsyncEvent>(
       "dom::VsyncParent::DispatchVsyncEvent", this,
       &VsyncParent::DispatchVsyncEvent, aVsync);
-  MOZ_ALWAYS_SUCCEEDS(mInitialThread->Dispatch(vsyncEvent, NS_DISPATCH_NORMAL));
+  MOZ_ALWAYS_SUCCEEDS(
+      mInitialEventTarget->Dispatch(vsyncEvent, NS_DISPATCH_NORMAL));
   return true;
 }
 
 void VsyncParent::DispatchVsyncEvent(const VsyncEvent& aVsync) {
-  AssertIsOnInitialThread();
+  AssertIsOnInitialEventTarget();
 
   // If we call NotifyVsync() when we handle ActorDestroy() message, we might
   // still call DispatchVsyncEvent().
@@ -65,7 +66,7 @@ void VsyncParent::DispatchVsyncEvent(const VsyncEvent& aVsync) {
 }
 
 mozilla::ipc::IPCResult VsyncParent::RecvObserve() {
-  AssertIsOnInitialThread();
+  AssertIsOnInitialEventTarget();
   if (!mObservingVsync) {
     mVsyncDispatcher->AddChildRefreshTimer(this);
     mObservingVsync = true;
@@ -75,7 +76,7 @@ mozilla::ipc::IPCResult VsyncParent::RecvObserve() {
 }
 
 mozilla::ipc::IPCResult VsyncParent::RecvUnobserve() {
-  AssertIsOnInitialThread();
+  AssertIsOnInitialEventTarget();
   if (mObservingVsync) {
     mVsyncDispatcher->RemoveChildRefreshTimer(this);
     mObservingVsync = false;
@@ -86,7 +87,9 @@ mozilla::ipc::IPCResult VsyncParent::RecvUnobserve() {
 
 void VsyncParent::ActorDestroy(ActorDestroyReason aActorDestroyReason) {
   MOZ_ASSERT(!mDestroyed);
-  AssertIsOnInitialThread();
+  // Normal teardown runs on our event target, but if the channel errors out
+  // the whole actor tree is torn down on the PBackground thread instead. The
+  // dispatcher is thread-safe and the flags are atomic, so both are fine.
   if (mObservingVsync) {
     mVsyncDispatcher->RemoveChildRefreshTimer(this);
   }
@@ -94,10 +97,12 @@ void VsyncParent::ActorDestroy(ActorDestroyReason aActorDestroyReason) {
   mDestroyed = true;
 }
 
-bool VsyncParent::IsOnInitialThread() {
-  return NS_GetCurrentThread() == mInitialThread;
+bool VsyncParent::IsOnInitialEventTarget() {
+  return mInitialEventTarget->IsOnCurrentThread();
 }
 
-void VsyncParent::AssertIsOnInitialThread() { MOZ_ASSERT(IsOnInitialThread()); }
+void VsyncParent::AssertIsOnInitialEventTarget() {
+  MOZ_ASSERT(IsOnInitialEventTarget());
+}
 
 }  // namespace mozilla::dom
@@ -8,18 +8,19 @@
 #define mozilla_dom_ipc_VsyncParent_h
 
 #include "mozilla/dom/PVsyncParent.h"
+#include "mozilla/Atomics.h"
 #include "mozilla/VsyncDispatcher.h"
 #include "nsCOMPtr.h"
 #include "mozilla/RefPtr.h"
+#include "nsISerialEventTarget.h"
 #include "VsyncSource.h"
 
-class nsIThread;
-
 namespace mozilla::dom {
 
-// Use PBackground thread in the main process to send vsync notifications to
-// content process. This actor will be released when its parent protocol calls
-// DeallocPVsyncParent().
+// Sends vsync notifications to content processes. This actor runs on a
+// dedicated event target in the main process (see
+// ParentImpl::GetConstructedEventTarget in BackgroundImpl.cpp) and will be
+// released when its parent protocol calls DeallocPVsyncParent().
 class VsyncParent final : public PVsyncParent, public VsyncObserver {
   friend class PVsyncParent;
 
@@ -39,12 +40,14 @@ class VsyncParent final : public PVsyncParent, public VsyncObserver {
   void DispatchVsyncEvent(const VsyncEvent& aVsync);
   void UpdateVsyncRate();
 
-  bool IsOnInitialThread();
-  void AssertIsOnInitialThread();
+  bool IsOnInitialEventTarget();
+  void AssertIsOnInitialEventTarget();
 
-  bool mObservingVsync;
-  bool mDestroyed;
-  nsCOMPtr<nsIThread> mInitialThread;
+  // These are written on the initial event target, except that if the channel
+  // errors out, ActorDestroy runs on the PBackground thread instead.
+  Atomic<bool> mObservingVsync;
+  Atomic<bool> mDestroyed;
+  nsCOMPtr<nsISerialEventTarget> mInitialEventTarget;
   RefPtr<gfx::VsyncSource> mVsyncSource;
   RefPtr<RefreshTimerVsyncDispatcher> mVsyncDispatcher;
 };
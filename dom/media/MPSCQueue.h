@@ -5,6 +5,9 @@
 #ifndef mozilla_dom_MPSCQueue_h
 #define mozilla_dom_MPSCQueue_h
 
+#include <atomic>
+#include <utility>
+
 namespace mozilla {
 
 // This class implements a lock-free multiple producer single consumer queue of
@@ -76,7 +79,7 @@ class MPSCQueue {
     prev->mNext.store(aMessage, std::memory_order_release);
   }
 
-  // Copy the content of the first message of the queue to aOutput, and
+  // Move the content of the first message of the queue to aOutput, and
   // frees the message. Returns true if there was a message, in which case
   // `aOutput` contains a valid value. If the queue was empty, returns false,
   // in which case `aOutput` is left untouched.
@@ -100,7 +103,7 @@ class MPSCQueue {
       return false;
     }
 
-    *aOutput = next->data;
+    *aOutput = std::move(next->data);
 
     // Simply shift the queue one node further, so that the sentinel node is
     // now pointing to the correct most ancient node. It contains stale data,
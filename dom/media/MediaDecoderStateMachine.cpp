@@ -5,6 +5,7 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include <algorithm>
+#include <cmath>
 #include <stdint.h>
 #include <utility>
 
@@ -35,6 +36,7 @@
 #include "MediaTimer.h"
 #include "ReaderProxy.h"
 #include "TimeUnits.h"
+#include "VideoFrameContainer.h"
 #include "VideoSegment.h"
 #include "VideoUtils.h"
 
@@ -408,6 +410,10 @@ class MediaDecoderStateMachine::DormantState
     mMaster->mAudioWaitRequest.DisconnectIfExists();
     mMaster->mVideoWaitRequest.DisconnectIfExists();
 
+    // Dormant releases as much memory as possible; drop the frame retained
+    // for the suspended-video resume repaint as well.
+    mMaster->mVideoFrameBeforeSuspend = nullptr;
+
     MaybeReleaseResources();
   }
 
@@ -598,7 +604,7 @@ class MediaDecoderStateMachine::DecodingState
   void HandleAudioCanceled() override { mMaster->RequestAudioData(); }
 
   void HandleVideoCanceled() override {
-    mMaster->RequestVideoData(mMaster->GetMediaTime());
+    mMaster->RequestVideoData(mMaster->GetVideoDecodeThreshold());
   }
 
   void HandleEndOfAudio() override;
@@ -619,7 +625,7 @@ class MediaDecoderStateMachine::DecodingState
   }
 
   void HandleVideoWaited(MediaData::Type aType) override {
-    mMaster->RequestVideoData(mMaster->GetMediaTime());
+    mMaster->RequestVideoData(mMaster->GetVideoDecodeThreshold());
   }
 
   void HandleAudioCaptured() override {
@@ -635,6 +641,9 @@ class MediaDecoderStateMachine::DecodingState
     }
 
     mMaster->mVideoDecodeSuspended = true;
+    // Keep the most recent real frame around so resuming can repaint it
+    // before the recovery seek delivers new frames.
+    mMaster->mVideoFrameBeforeSuspend = mMaster->VideoQueue().PeekBack();
     mMaster->mOnPlaybackEvent.Notify(MediaPlaybackEvent::EnterVideoSuspend);
     Reader()->SetVideoBlankDecode(true);
   }
@@ -1939,6 +1948,7 @@ class MediaDecoderStateMachine::BufferingState
     }
 
     mMaster->mVideoDecodeSuspended = true;
+    mMaster->mVideoFrameBeforeSuspend = mMaster->VideoQueue().PeekBack();
     mMaster->mOnPlaybackEvent.Notify(MediaPlaybackEvent::EnterVideoSuspend);
     Reader()->SetVideoBlankDecode(true);
   }
@@ -2169,6 +2179,16 @@ void MediaDecoderStateMachine::StateObject::HandleResumeVideoDecoding(
   mMaster->mOnPlaybackEvent.Notify(MediaPlaybackEvent::ExitVideoSuspend);
   Reader()->SetVideoBlankDecode(false);
 
+  // Repaint the last real frame decoded before the suspension so that
+  // foregrounding the tab shows content immediately. The seek below will
+  // refresh it with the frame at the actual playback position.
+  if (mMaster->mVideoFrameBeforeSuspend && mMaster->mVideoFrameContainer) {
+    RefPtr<VideoData> frame = std::move(mMaster->mVideoFrameBeforeSuspend);
+    mMaster->mVideoFrameContainer->SetCurrentFrame(frame->mDisplay,
+                                                   frame->mImage,
+                                                   TimeStamp::Now());
+  }
+
   // Start counting recovery time from right now.
   TimeStamp start = TimeStamp::Now();
 
@@ -2446,7 +2466,7 @@ void MediaDecoderStateMachine::DecodingState::EnsureVideoDecodeTaskQueued() {
       mMaster->IsWaitingVideoData()) {
     return;
   }
-  mMaster->RequestVideoData(mMaster->GetMediaTime());
+  mMaster->RequestVideoData(mMaster->GetVideoDecodeThreshold());
 }
 
 void MediaDecoderStateMachine::DecodingState::MaybeStartBuffering() {
@@ -2695,6 +2715,9 @@ MediaDecoderStateMachine::MediaDecoderStateMachine(MediaDecoder* aDecoder,
       mCurrentFrameID(0),
       mReader(new ReaderProxy(mTaskQueue, aReader)),
       mPlaybackRate(1.0),
+      mVideoDecodeDurationAvgMs(0.0),
+      mVideoDecodeDurationJitterMs(0.0),
+      mVideoFrameDurationMs(0.0),
       mAmpleAudioThreshold(detail::AMPLE_AUDIO_THRESHOLD),
       mMinimizePreroll(aDecoder->GetMinimizePreroll()),
       mSentFirstFrameLoadedEvent(false),
@@ -3271,6 +3294,7 @@ void MediaDecoderStateMachine::RequestVideoData(
             // Handle abnormal or negative timestamps.
             mDecodedVideoEndTime =
                 std::max(mDecodedVideoEndTime, aVideo->GetEndTime());
+            NotifyVideoDecodeTime(aVideo, videoDecodeStartTime);
             LOGV("OnVideoDecoded [%" PRId64 ",%" PRId64 "]",
                  aVideo->mTime.ToMicroseconds(),
                  aVideo->GetEndTime().ToMicroseconds());
@@ -3299,6 +3323,49 @@ void MediaDecoderStateMachine::RequestVideoData(
       ->Track(mVideoDataRequest);
 }
 
+void MediaDecoderStateMachine::NotifyVideoDecodeTime(const VideoData* aVideo,
+                                                     TimeStamp aDecodeStart) {
+  MOZ_ASSERT(OnTaskQueue());
+  double decodeMs = (TimeStamp::Now() - aDecodeStart).ToMilliseconds();
+  double frameMs = aVideo->mDuration.ToMicroseconds() / 1000.0;
+  if (mVideoDecodeDurationAvgMs == 0.0) {
+    mVideoDecodeDurationAvgMs = decodeMs;
+    mVideoFrameDurationMs = frameMs;
+    return;
+  }
+  // Exponential moving averages with a weight of 1/8, in the style of a TCP
+  // RTT estimator: cheap, smooth, and quick enough to follow a decoder that
+  // starts struggling.
+  double deviation = std::abs(decodeMs - mVideoDecodeDurationAvgMs);
+  mVideoDecodeDurationJitterMs +=
+      (deviation - mVideoDecodeDurationJitterMs) / 8;
+  mVideoDecodeDurationAvgMs += (decodeMs - mVideoDecodeDurationAvgMs) / 8;
+  if (frameMs > 0.0) {
+    mVideoFrameDurationMs += (frameMs - mVideoFrameDurationMs) / 8;
+  }
+}
+
+media::TimeUnit MediaDecoderStateMachine::GetVideoDecodeThreshold() {
+  MOZ_ASSERT(OnTaskQueue());
+  const auto clock = mMediaSink->IsStarted() ? GetClock() : GetMediaTime();
+  if (!mMediaSink->IsStarted() || mVideoDecodeDurationAvgMs == 0.0) {
+    return clock;
+  }
+  // Project where playback will be by the time the decode we are about to
+  // request resolves, allowing two deviations of headroom for jitter.
+  double aheadMs =
+      (mVideoDecodeDurationAvgMs + 2 * mVideoDecodeDurationJitterMs) *
+      mPlaybackRate;
+  auto projected =
+      clock + media::TimeUnit::FromMicroseconds(int64_t(aheadMs * 1000.0));
+  // If the frames already decoded carry playback past the projection, decode
+  // is keeping up; don't skip frames that are merely close to the clock.
+  if (mDecodedVideoEndTime > projected) {
+    return clock;
+  }
+  return projected;
+}
+
 void MediaDecoderStateMachine::WaitForData(MediaData::Type aType) {
   MOZ_ASSERT(OnTaskQueue());
   MOZ_ASSERT(aType == MediaData::Type::AUDIO_DATA ||
@@ -3905,9 +3972,20 @@ void MediaDecoderStateMachine::OnMediaSinkAudioError(nsresult aResult) {
 
 uint32_t MediaDecoderStateMachine::GetAmpleVideoFrames() const {
   MOZ_ASSERT(OnTaskQueue());
-  return mReader->VideoIsHardwareAccelerated()
-             ? std::max<uint32_t>(sVideoQueueHWAccelSize, MIN_VIDEO_QUEUE_SIZE)
-             : std::max<uint32_t>(sVideoQueueDefaultSize, MIN_VIDEO_QUEUE_SIZE);
+  uint32_t frames =
+      mReader->VideoIsHardwareAccelerated()
+          ? std::max<uint32_t>(sVideoQueueHWAccelSize, MIN_VIDEO_QUEUE_SIZE)
+          : std::max<uint32_t>(sVideoQueueDefaultSize, MIN_VIDEO_QUEUE_SIZE);
+  // Grow the decode-ahead queue when decode times are jittery: each queued
+  // frame buys one frame duration of slack, so keep enough extra frames to
+  // ride out a decode running two deviations over the average. Cap at twice
+  // the configured size so a pathological decoder can't balloon the queue.
+  if (mVideoFrameDurationMs > 0.0 && mVideoDecodeDurationJitterMs > 0.0) {
+    uint32_t jitterFrames = uint32_t(
+        std::ceil(2 * mVideoDecodeDurationJitterMs / mVideoFrameDurationMs));
+    frames = std::min(frames + jitterFrames, 2 * frames);
+  }
+  return frames;
 }
 
 void MediaDecoderStateMachine::GetDebugInfo(
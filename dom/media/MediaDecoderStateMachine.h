@@ -480,6 +480,18 @@ class MediaDecoderStateMachine
   // Start a task to decode video.
   void RequestVideoData(const media::TimeUnit& aCurrentTime);
 
+  // Compute the time threshold to pass to the next video decode request.
+  // Normally this is the current playback position. When recent decode times
+  // project that a frame requested now would resolve after its presentation
+  // deadline, the threshold is moved ahead of the clock so the reader can
+  // skip the demuxer to the next keyframe preemptively instead of decoding
+  // frames that would only be dropped.
+  media::TimeUnit GetVideoDecodeThreshold();
+
+  // Fold a resolved video request into the rolling decode time estimates
+  // used by GetVideoDecodeThreshold() and GetAmpleVideoFrames().
+  void NotifyVideoDecodeTime(const VideoData* aVideo, TimeStamp aDecodeStart);
+
   void WaitForData(MediaData::Type aType);
 
   bool IsRequestingAudioData() const { return mAudioDataRequest.Exists(); }
@@ -591,6 +603,14 @@ class MediaDecoderStateMachine
   // Playback rate. 1.0 : normal speed, 0.5 : two times slower.
   double mPlaybackRate;
 
+  // Rolling estimates of how long a video frame takes to be delivered by the
+  // reader, how much that time varies, and the typical duration of a decoded
+  // frame, all in milliseconds. Updated on the task queue each time a video
+  // request resolves; zero until the first frame has been measured.
+  double mVideoDecodeDurationAvgMs;
+  double mVideoDecodeDurationJitterMs;
+  double mVideoFrameDurationMs;
+
   // If we've got more than this number of decoded video frames waiting in
   // the video queue, we will not decode any more video frames until some have
   // been consumed by the play state machine thread.
@@ -655,6 +675,13 @@ class MediaDecoderStateMachine
   // True if video decoding is suspended.
   bool mVideoDecodeSuspended;
 
+  // The last real decoded video frame, captured when video decoding is
+  // suspended for a background tab. It is repainted when decoding resumes so
+  // that foregrounding the tab shows content immediately instead of the
+  // blank decoder's output while the recovery seek runs. Costs one decoded
+  // frame of memory for the duration of the suspension.
+  RefPtr<VideoData> mVideoFrameBeforeSuspend;
+
   // True if the media is seekable (i.e. supports random access).
   bool mMediaSeekable = true;
 
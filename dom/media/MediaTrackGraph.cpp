@@ -1158,6 +1158,20 @@ void MediaTrackGraphImpl::RunMessagesInQueue() {
     }
   }
   mFrontMessageQueue.Clear();
+
+  // Drain the message blocks the main thread has published since we last ran
+  // messages. The queue is lock-free, so a real-time audio callback never
+  // blocks on the main thread to receive control messages. Each block holds
+  // the messages of one event loop task and is applied as an atomic unit.
+  MessageBlock block;
+  while (mMessageQueue.Pop(&block)) {
+    --mMessageBlocksQueued;
+    for (uint32_t j = 0; j < block.mMessages.Length(); ++j) {
+      TRACE();
+      block.mMessages[j]->Run();
+    }
+    block.mMessages.Clear();
+  }
 }
 
 void MediaTrackGraphImpl::UpdateGraph(GraphTime aEndBlockingDecisions) {
@@ -1344,20 +1358,25 @@ bool MediaTrackGraphImpl::UpdateMainThreadState() {
     for (MediaTrack* track : AllTracks()) {
       track->OnGraphThreadDone();
     }
+    // Shutting down; blocking on the monitor is acceptable now.
+    mMonitor.Lock();
+  } else if (!mMonitor.TryLock()) {
+    // The main thread is holding the monitor in stable state. Control
+    // messages no longer flow through the monitor, so rather than block a
+    // real-time audio callback here, skip publishing updates to the main
+    // thread this iteration and try again on the next one.
+    return true;
   }
-  {
-    MonitorAutoLock lock(mMonitor);
-    bool finalUpdate =
-        mForceShutDownReceived || (IsEmpty() && mBackMessageQueue.IsEmpty());
-    PrepareUpdatesToMainThreadState(finalUpdate);
-    if (!finalUpdate) {
-      SwapMessageQueues();
-      return true;
-    }
-    // The JSContext will not be used again.
-    // Clear main thread access while under monitor.
-    mJSContext = nullptr;
+  bool finalUpdate = mForceShutDownReceived || (IsEmpty() && !MessagesQueued());
+  PrepareUpdatesToMainThreadState(finalUpdate);
+  if (!finalUpdate) {
+    mMonitor.Unlock();
+    return true;
   }
+  // The JSContext will not be used again.
+  // Clear main thread access while under monitor.
+  mJSContext = nullptr;
+  mMonitor.Unlock();
   dom::WorkletThread::DeleteCycleCollectedJSContext();
   // Enter shutdown mode when this iteration is completed.
   // No need to Destroy tracks here. The main-thread owner of each
@@ -1734,8 +1753,13 @@ void MediaTrackGraphImpl::RunInStableState(bool aSourceIsMTG) {
       }
     } else {
       if (LifecycleStateRef() <= LIFECYCLE_WAITING_FOR_MAIN_THREAD_CLEANUP) {
-        MessageBlock* block = mBackMessageQueue.AppendElement();
-        block->mMessages = std::move(mCurrentTaskMessageQueue);
+        // Publish this task's messages as a single block so the graph thread
+        // applies them as an atomic unit. Increment the count first so that
+        // the graph thread never observes a block without it.
+        auto* block = new MPSCQueue<MessageBlock>::Message();
+        block->data.mMessages = std::move(mCurrentTaskMessageQueue);
+        ++mMessageBlocksQueued;
+        mMessageQueue.Push(block);
         EnsureNextIteration();
       }
 
@@ -1751,9 +1775,9 @@ void MediaTrackGraphImpl::RunInStableState(bool aSourceIsMTG) {
       // Start the driver now. We couldn't start it earlier because the graph
       // might exit immediately on finding it has no tracks. The first message
       // for a new graph must create a track. Ensure that his message runs on
-      // the first iteration.
+      // the first iteration; it was published to the message queue above and
+      // the graph thread drains the queue at the start of each iteration.
       MOZ_ASSERT(MessagesQueued());
-      SwapMessageQueues();
 
       LOG(LogLevel::Debug,
           ("%p: Starting a graph with a %s", this,
@@ -1774,12 +1798,15 @@ void MediaTrackGraphImpl::RunInStableState(bool aSourceIsMTG) {
     if (LifecycleStateRef() == LIFECYCLE_WAITING_FOR_MAIN_THREAD_CLEANUP &&
         mForceShutDownReceived) {
       // Defer calls to RunDuringShutdown() to happen while mMonitor is not
-      // held.
-      for (uint32_t i = 0; i < mBackMessageQueue.Length(); ++i) {
-        MessageBlock& mb = mBackMessageQueue[i];
+      // held. The graph thread has stopped iterating (it signaled main thread
+      // cleanup under the monitor), so it is safe for the main thread to
+      // consume what remains in the message queue.
+      MessageBlock mb;
+      while (mMessageQueue.Pop(&mb)) {
+        --mMessageBlocksQueued;
         controlMessagesToRunDuringShutdown.AppendElements(move(mb.mMessages));
+        mb.mMessages.Clear();
       }
-      mBackMessageQueue.Clear();
       MOZ_ASSERT(mCurrentTaskMessageQueue.IsEmpty());
       // Stop MediaTrackGraph threads.
       LifecycleStateRef() = LIFECYCLE_WAITING_FOR_THREAD_SHUTDOWN;
@@ -3042,6 +3069,7 @@ MediaTrackGraphImpl::MediaTrackGraphImpl(
       mInputDeviceID(nullptr),
       mOutputDeviceID(aOutputDeviceID),
       mMonitor("MediaTrackGraphImpl"),
+      mMessageBlocksQueued(0),
       mLifecycleState(LIFECYCLE_THREAD_NOT_STARTED),
       mPostedRunInStableStateEvent(false),
       mGraphDriverRunning(false),
@@ -22,6 +22,7 @@
 #include "nsIThreadInternal.h"
 #include "nsITimer.h"
 #include "AsyncLogger.h"
+#include "MPSCQueue.h"
 
 namespace mozilla {
 
@@ -278,7 +279,8 @@ class MediaTrackGraphImpl : public MediaTrackGraph,
   void ProcessChunkMetadataForInterval(MediaTrack* aTrack, C& aSegment,
                                        TrackTime aStart, TrackTime aEnd);
   /**
-   * Process graph messages in mFrontMessageQueue.
+   * Process graph messages in mFrontMessageQueue and any message blocks the
+   * main thread has published to mMessageQueue.
    */
   void RunMessagesInQueue();
   /**
@@ -287,15 +289,6 @@ class MediaTrackGraphImpl : public MediaTrackGraph,
    */
   void UpdateGraph(GraphTime aEndBlockingDecisions);
 
-  void SwapMessageQueues() {
-    MOZ_ASSERT(OnGraphThreadOrNotRunning());
-    mMonitor.AssertCurrentThreadOwns();
-    MOZ_ASSERT(mFrontMessageQueue.IsEmpty());
-    mFrontMessageQueue.SwapElements(mBackMessageQueue);
-    if (!mFrontMessageQueue.IsEmpty()) {
-      EnsureNextIteration();
-    }
-  }
   /**
    * Do all the processing and play the audio and video, from
    * mProcessedTime to mStateComputedTime.
@@ -818,21 +811,32 @@ class MediaTrackGraphImpl : public MediaTrackGraph,
    * as an atomic unit.
    */
   /*
-   * Message queue processed by the MTG thread during an iteration.
-   * Accessed on graph thread only.
+   * Message queue for messages appended on the graph thread itself during
+   * an iteration, via RunMessageAfterProcessing(). Accessed on graph thread
+   * only.
    */
   nsTArray<MessageBlock> mFrontMessageQueue;
   /*
-   * Message queue in which the main thread appends messages.
-   * Access guarded by mMonitor.
+   * Lock-free queue of message blocks published by the main thread in stable
+   * state and drained by the graph thread when it runs messages. Each block
+   * is a single node so that the messages of one event loop task are still
+   * applied as an atomic unit. Using a lock-free queue means a real-time
+   * audio callback never blocks on mMonitor to receive control messages,
+   * even while the main thread holds it in RunInStableState(). The main
+   * thread may only consume from this queue once the graph thread has
+   * stopped iterating.
+   */
+  MPSCQueue<MessageBlock> mMessageQueue;
+  /*
+   * The number of message blocks in mMessageQueue. Incremented before a push
+   * and decremented after a pop, so it never underestimates the queue's
+   * contents.
    */
-  nsTArray<MessageBlock> mBackMessageQueue;
+  Atomic<size_t> mMessageBlocksQueued;
 
-  /* True if there will messages to process if we swap the message queues. */
-  bool MessagesQueued() const {
-    mMonitor.AssertCurrentThreadOwns();
-    return !mBackMessageQueue.IsEmpty();
-  }
+  /* True if there are message blocks queued for the graph thread. May be
+   * checked on any thread. */
+  bool MessagesQueued() const { return mMessageBlocksQueued > 0; }
   /**
    * This enum specifies where this graph is in its lifecycle. This is used
    * to control shutdown.
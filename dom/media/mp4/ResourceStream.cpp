@@ -6,10 +6,12 @@
 
 #include "ResourceStream.h"
 
+#include <algorithm>
+
 namespace mozilla {
 
 ResourceStream::ResourceStream(mozilla::MediaResource* aResource)
-    : mResource(aResource), mPinCount(0) {
+    : mResource(aResource), mPinCount(0), mReadAheadOffset(-1) {
   MOZ_ASSERT(aResource);
   DDLINKCHILD("resource", &mResource);
 }
@@ -37,6 +39,25 @@ bool ResourceStream::ReadAt(int64_t aOffset, void* aBuffer, size_t aCount,
 
 bool ResourceStream::CachedReadAt(int64_t aOffset, void* aBuffer, size_t aCount,
                                   size_t* aBytesRead) {
+  // Serve small reads from the read-ahead buffer when possible, so that
+  // parsing a run of boxes costs one cache lookup per kReadAheadSize bytes
+  // rather than one per box header.
+  if (aCount <= kReadAheadSize) {
+    if (mReadAheadOffset < 0 || aOffset < mReadAheadOffset ||
+        aOffset + int64_t(aCount) >
+            mReadAheadOffset + int64_t(mReadAhead.Length())) {
+      ReadAheadAt(aOffset, aCount);
+    }
+    if (mReadAheadOffset >= 0 && aOffset >= mReadAheadOffset &&
+        aOffset + int64_t(aCount) <=
+            mReadAheadOffset + int64_t(mReadAhead.Length())) {
+      memcpy(aBuffer, mReadAhead.Elements() + (aOffset - mReadAheadOffset),
+             aCount);
+      *aBytesRead = aCount;
+      return true;
+    }
+  }
+
   nsresult rv = mResource.GetResource()->ReadFromCache(
       reinterpret_cast<char*>(aBuffer), aOffset, aCount);
   if (NS_FAILED(rv)) {
@@ -47,6 +68,29 @@ bool ResourceStream::CachedReadAt(int64_t aOffset, void* aBuffer, size_t aCount,
   return true;
 }
 
+bool ResourceStream::ReadAheadAt(int64_t aOffset, size_t aCount) {
+  int64_t cachedEnd = mResource.GetResource()->GetCachedDataEnd(aOffset);
+  if (cachedEnd - aOffset < int64_t(aCount)) {
+    // Not enough contiguous cached data; let the caller fall back to the
+    // direct cache read, which will fail in the same way a read-ahead would.
+    return false;
+  }
+  size_t toRead = size_t(
+      std::min<int64_t>(int64_t(kReadAheadSize), cachedEnd - aOffset));
+  if (!mReadAhead.SetLength(toRead, fallible)) {
+    return false;
+  }
+  nsresult rv = mResource.GetResource()->ReadFromCache(
+      reinterpret_cast<char*>(mReadAhead.Elements()), aOffset, toRead);
+  if (NS_FAILED(rv)) {
+    mReadAhead.Clear();
+    mReadAheadOffset = -1;
+    return false;
+  }
+  mReadAheadOffset = aOffset;
+  return true;
+}
+
 bool ResourceStream::Length(int64_t* aSize) {
   if (mResource.GetLength() < 0) return false;
   *aSize = mResource.GetLength();
@@ -8,6 +8,7 @@
 #include "MediaResource.h"
 #include "ByteStream.h"
 #include "mozilla/RefPtr.h"
+#include "nsTArray.h"
 
 namespace mozilla {
 
@@ -39,8 +40,26 @@ class ResourceStream : public ByteStream,
   virtual ~ResourceStream();
 
  private:
+  /**
+   * Fill the read-ahead buffer with up to kReadAheadSize bytes of already
+   * cached data starting at aOffset. Returns false if fewer than aCount bytes
+   * are cached at aOffset.
+   */
+  bool ReadAheadAt(int64_t aOffset, size_t aCount);
+
   mozilla::MediaResourceIndex mResource;
   uint32_t mPinCount;
+
+  // Box parsing issues a storm of tiny cached reads (8-16 byte box headers
+  // and small full boxes), each of which takes the media cache lock and
+  // walks its block list. Batch them by reading ahead from the cache in
+  // larger chunks and serving subsequent small reads from this buffer. The
+  // byte at a given offset of a stream never changes, so the copy cannot go
+  // stale. Streams are used from a single demuxer thread, so no locking is
+  // needed.
+  static const size_t kReadAheadSize = 64 * 1024;
+  int64_t mReadAheadOffset;
+  nsTArray<uint8_t> mReadAhead;
 };
 
 }  // namespace mozilla
@@ -318,6 +318,14 @@ void AudioBlockPanStereoToStereo(const float aInputL[WEBAUDIO_BLOCK_SIZE],
   }
 #endif
 
+#ifdef USE_SSE2
+  if (mozilla::supports_sse2()) {
+    AudioBlockPanStereoToStereo_SSE(aInputL, aInputR, aGainL, aGainR,
+                                    aIsOnTheLeft, aOutputL, aOutputR);
+    return;
+  }
+#endif
+
   uint32_t i;
   for (i = 0; i < WEBAUDIO_BLOCK_SIZE; i++) {
     if (aIsOnTheLeft[i]) {
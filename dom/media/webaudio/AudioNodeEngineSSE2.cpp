@@ -218,6 +218,55 @@ void AudioBlockPanStereoToStereo_SSE(const float aInputL[WEBAUDIO_BLOCK_SIZE],
   }
 }
 
+void AudioBlockPanStereoToStereo_SSE(
+    const float aInputL[WEBAUDIO_BLOCK_SIZE],
+    const float aInputR[WEBAUDIO_BLOCK_SIZE],
+    const float aGainL[WEBAUDIO_BLOCK_SIZE],
+    const float aGainR[WEBAUDIO_BLOCK_SIZE],
+    const bool aIsOnTheLeft[WEBAUDIO_BLOCK_SIZE],
+    float aOutputL[WEBAUDIO_BLOCK_SIZE], float aOutputR[WEBAUDIO_BLOCK_SIZE]) {
+  __m128 vinl, vinr, vgainl, vgainr, vonleft, vmask, voutl0, voutr0, voutl1,
+      voutr1;
+
+  ASSERT_ALIGNED16(aInputL);
+  ASSERT_ALIGNED16(aInputR);
+  ASSERT_ALIGNED16(aGainL);
+  ASSERT_ALIGNED16(aGainR);
+  ASSERT_ALIGNED16(aOutputL);
+  ASSERT_ALIGNED16(aOutputR);
+
+  __m128 zero = _mm_setzero_ps();
+
+  for (unsigned i = 0; i < WEBAUDIO_BLOCK_SIZE; i += 4) {
+    vinl = _mm_load_ps(&aInputL[i]);
+    vinr = _mm_load_ps(&aInputR[i]);
+    vgainl = _mm_load_ps(&aGainL[i]);
+    vgainr = _mm_load_ps(&aGainR[i]);
+
+    /* Build a lane mask from the boolean "on the left" values, the same way
+       the NEON version does: widen the bytes to float lanes and compare
+       against zero. */
+    vonleft = _mm_set_ps(aIsOnTheLeft[i + 3], aIsOnTheLeft[i + 2],
+                         aIsOnTheLeft[i + 1], aIsOnTheLeft[i]);
+    vmask = _mm_cmpgt_ps(vonleft, zero);
+
+    /* "on the left" lanes:
+       aOutputL = aInputL + aInputR * gainL, aOutputR = aInputR * gainR */
+    voutl0 = _mm_add_ps(vinl, _mm_mul_ps(vinr, vgainl));
+    voutr0 = _mm_mul_ps(vinr, vgainr);
+
+    /* other lanes:
+       aOutputL = aInputL * gainL, aOutputR = aInputR + aInputL * gainR */
+    voutl1 = _mm_mul_ps(vinl, vgainl);
+    voutr1 = _mm_add_ps(vinr, _mm_mul_ps(vinl, vgainr));
+
+    _mm_store_ps(&aOutputL[i], _mm_or_ps(_mm_and_ps(vmask, voutl0),
+                                         _mm_andnot_ps(vmask, voutl1)));
+    _mm_store_ps(&aOutputR[i], _mm_or_ps(_mm_and_ps(vmask, voutr0),
+                                         _mm_andnot_ps(vmask, voutr1)));
+  }
+}
+
 void BufferComplexMultiply_SSE(const float* aInput, const float* aScale,
                                float* aOutput, uint32_t aSize) {
   unsigned i;
@@ -26,6 +26,14 @@ void AudioBlockPanStereoToStereo_SSE(const float aInputL[WEBAUDIO_BLOCK_SIZE],
                                      float aOutputL[WEBAUDIO_BLOCK_SIZE],
                                      float aOutputR[WEBAUDIO_BLOCK_SIZE]);
 
+void AudioBlockPanStereoToStereo_SSE(const float aInputL[WEBAUDIO_BLOCK_SIZE],
+                                     const float aInputR[WEBAUDIO_BLOCK_SIZE],
+                                     const float aGainL[WEBAUDIO_BLOCK_SIZE],
+                                     const float aGainR[WEBAUDIO_BLOCK_SIZE],
+                                     const bool aIsOnTheLeft[WEBAUDIO_BLOCK_SIZE],
+                                     float aOutputL[WEBAUDIO_BLOCK_SIZE],
+                                     float aOutputR[WEBAUDIO_BLOCK_SIZE]);
+
 float AudioBufferSumOfSquares_SSE(const float* aInput, uint32_t aLength);
 
 void BufferComplexMultiply_SSE(const float* aInput, const float* aScale,
@@ -74,9 +74,8 @@ class GainNodeEngine final : public AudioNodeEngine {
       ASSERT_ALIGNED16(alignedComputedGain);
       mGain.GetValuesAtTime(tick, alignedComputedGain, WEBAUDIO_BLOCK_SIZE);
 
-      for (size_t counter = 0; counter < WEBAUDIO_BLOCK_SIZE; ++counter) {
-        alignedComputedGain[counter] *= aInput.mVolume;
-      }
+      AudioBufferInPlaceScale(alignedComputedGain, aInput.mVolume,
+                              WEBAUDIO_BLOCK_SIZE);
 
       // Apply the gain to the output buffer
       for (size_t channel = 0; channel < aOutput->ChannelCount(); ++channel) {
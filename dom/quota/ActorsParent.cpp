@@ -4533,7 +4533,12 @@ nsresult QuotaManager::LoadQuota() {
             QM_TRY_INSPECT(const bool& exists,
                            MOZ_TO_RESULT_INVOKE(directory, Exists));
 
-            QM_TRY(OkIf(exists), Err(NS_ERROR_FAILURE));
+            // The origin directory may have been deleted after the origin was
+            // marked as accessed in the cache (for example by an eviction or
+            // a clear operation which didn't get to rewrite the cache).
+            if (!exists) {
+              return Ok{};
+            }
 
             QM_TRY_INSPECT(const bool& isDirectory,
                            MOZ_TO_RESULT_INVOKE(directory, IsDirectory));
@@ -4552,19 +4557,16 @@ nsresult QuotaManager::LoadQuota() {
                 &metadataPersisted, metadataQuotaInfo,
                 /* aTelemetry */ false));
 
-            QM_TRY(OkIf(lastAccessTime == metadataLastAccessTime),
-                   Err(NS_ERROR_FAILURE));
-
-            QM_TRY(OkIf(persisted == metadataPersisted), Err(NS_ERROR_FAILURE));
-
-            QM_TRY(OkIf(groupAndOrigin.mGroup == metadataQuotaInfo.mGroup),
-                   Err(NS_ERROR_FAILURE));
-
             QM_TRY(OkIf(groupAndOrigin.mOrigin == metadataQuotaInfo.mOrigin),
                    Err(NS_ERROR_FAILURE));
 
-            QM_TRY(InitializeOrigin(persistenceType, groupAndOrigin,
-                                    lastAccessTime, persisted, directory));
+            // Usage data for accessed origins could have changed after the
+            // accessed flag was written to the cache, so the cached values
+            // can't be trusted. Initialize the origin from the metadata file
+            // and a directory traversal instead.
+            QM_TRY(InitializeOrigin(persistenceType, metadataQuotaInfo,
+                                    metadataLastAccessTime, metadataPersisted,
+                                    directory));
           } else {
             InitQuotaForOrigin(persistenceType, groupAndOrigin, clientUsages,
                                usage, lastAccessTime, persisted);
@@ -4648,9 +4650,19 @@ nsresult QuotaManager::LoadQuota() {
   }
 
   if (mCacheUsable) {
-    rv = InvalidateCache(mStorageConnection);
+    // Write the loaded state to the cache right away (instead of only during
+    // clean shutdown) and keep the cache valid for the rest of the session.
+    // Origins accessed from now on get flagged in the cache by
+    // MarkOriginAccessedInCache, so if this session crashes, the next session
+    // only has to re-traverse the directories of the flagged origins.
+    rv = WriteCache();
     if (NS_WARN_IF(NS_FAILED(rv))) {
-      return rv;
+      // Fall back to invalidating the cache, the next session will then
+      // initialize quota information from the repositories.
+      rv = InvalidateCache(mStorageConnection);
+      if (NS_WARN_IF(NS_FAILED(rv))) {
+        return rv;
+      }
     }
   }
 
@@ -4661,20 +4673,17 @@ nsresult QuotaManager::LoadQuota() {
   return NS_OK;
 }
 
-void QuotaManager::UnloadQuota() {
+nsresult QuotaManager::WriteCache() {
   AssertIsOnIOThread();
   MOZ_ASSERT(mStorageConnection);
-  MOZ_ASSERT(mTemporaryStorageInitialized);
   MOZ_ASSERT(mCacheUsable);
 
-  auto autoRemoveQuota = MakeScopeExit([&] { RemoveQuota(); });
-
   mozStorageTransaction transaction(
       mStorageConnection, false, mozIStorageConnection::TRANSACTION_IMMEDIATE);
 
   nsresult rv = mStorageConnection->ExecuteSimpleSQL("DELETE FROM origin;"_ns);
   if (NS_WARN_IF(NS_FAILED(rv))) {
-    return;
+    return rv;
   }
 
   nsCOMPtr<mozIStorageStatement> insertStmt;
@@ -4694,9 +4703,7 @@ void QuotaManager::UnloadQuota() {
           continue;
         }
 
-        for (RefPtr<OriginInfo>& originInfo : groupInfo->mOriginInfos) {
-          MOZ_ASSERT(!originInfo->mQuotaObjects.Count());
-
+        for (const RefPtr<OriginInfo>& originInfo : groupInfo->mOriginInfos) {
           if (!originInfo->mDirectoryExists) {
             continue;
           }
@@ -4714,25 +4721,21 @@ void QuotaManager::UnloadQuota() {
                     ":usage, :last_access_time, :accessed, :persisted)"),
                 getter_AddRefs(insertStmt));
             if (NS_WARN_IF(NS_FAILED(rv))) {
-              return;
+              return rv;
             }
           }
 
           rv = originInfo->LockedBindToStatement(insertStmt);
           if (NS_WARN_IF(NS_FAILED(rv))) {
-            return;
+            return rv;
           }
 
           rv = insertStmt->Execute();
           if (NS_WARN_IF(NS_FAILED(rv))) {
-            return;
+            return rv;
           }
         }
-
-        groupInfo->LockedRemoveOriginInfos();
       }
-
-      iter.Remove();
     }
   }
 
@@ -4741,28 +4744,109 @@ void QuotaManager::UnloadQuota() {
       "UPDATE cache SET valid = :valid, build_id = :buildId;"_ns,
       getter_AddRefs(stmt));
   if (NS_WARN_IF(NS_FAILED(rv))) {
-    return;
+    return rv;
   }
 
   rv = stmt->BindInt32ByName("valid"_ns, 1);
   if (NS_WARN_IF(NS_FAILED(rv))) {
-    return;
+    return rv;
   }
 
   rv = stmt->BindUTF8StringByName("buildId"_ns, *gBuildId);
   if (NS_WARN_IF(NS_FAILED(rv))) {
-    return;
+    return rv;
   }
 
   rv = stmt->Execute();
   if (NS_WARN_IF(NS_FAILED(rv))) {
-    return;
+    return rv;
   }
 
   rv = transaction.Commit();
   if (NS_WARN_IF(NS_FAILED(rv))) {
-    return;
+    return rv;
   }
+
+  mCacheAccessedOrigins.Clear();
+
+  return NS_OK;
+}
+
+void QuotaManager::UnloadQuota() {
+  AssertIsOnIOThread();
+  MOZ_ASSERT(mStorageConnection);
+  MOZ_ASSERT(mTemporaryStorageInitialized);
+  MOZ_ASSERT(mCacheUsable);
+
+  // Write the final state to the cache and then remove all quota information
+  // from memory. If the cache write fails, the cache is simply left in its
+  // previous state (usually with origins flagged as accessed, which the next
+  // session then re-traverses).
+  Unused << NS_WARN_IF(NS_FAILED(WriteCache()));
+
+  RemoveQuota();
+}
+
+nsresult QuotaManager::MarkOriginAccessedInCache(
+    PersistenceType aPersistenceType, const nsACString& aOrigin) {
+  AssertIsOnIOThread();
+  MOZ_ASSERT(aPersistenceType != PERSISTENCE_TYPE_PERSISTENT);
+  MOZ_ASSERT(mStorageConnection);
+
+  if (!mCacheUsable) {
+    return NS_OK;
+  }
+
+  nsAutoCString key;
+  key.AppendInt(aPersistenceType);
+  key.Append(':');
+  key.Append(aOrigin);
+
+  if (mCacheAccessedOrigins.Contains(key)) {
+    return NS_OK;
+  }
+
+  // Replace any cached row for the origin with a stub row which only has the
+  // accessed flag set. LoadQuota doesn't use cached usage data for accessed
+  // origins (it re-traverses their directories instead), so the other columns
+  // don't have to be kept up to date here.
+  nsCOMPtr<mozIStorageStatement> stmt;
+  nsresult rv = mStorageConnection->CreateStatement(
+      nsLiteralCString(
+          "INSERT OR REPLACE INTO origin (repository_id, origin, group_, "
+          "client_usages, usage, last_access_time, accessed, persisted) "
+          "VALUES (:repository_id, :origin, '', '', 0, 0, 1, 0)"),
+      getter_AddRefs(stmt));
+  if (NS_WARN_IF(NS_FAILED(rv))) {
+    return rv;
+  }
+
+  rv = stmt->BindInt32ByName("repository_id"_ns, aPersistenceType);
+  if (NS_WARN_IF(NS_FAILED(rv))) {
+    return rv;
+  }
+
+  rv = stmt->BindUTF8StringByName("origin"_ns, aOrigin);
+  if (NS_WARN_IF(NS_FAILED(rv))) {
+    return rv;
+  }
+
+  rv = stmt->Execute();
+  if (NS_WARN_IF(NS_FAILED(rv))) {
+    // Without the accessed flag recorded on disk the cached row could go
+    // stale without the next session noticing, so fall back to invalidating
+    // the whole cache.
+    rv = InvalidateCache(mStorageConnection);
+    if (NS_WARN_IF(NS_FAILED(rv))) {
+      return rv;
+    }
+
+    return NS_OK;
+  }
+
+  mCacheAccessedOrigins.PutEntry(key);
+
+  return NS_OK;
 }
 
 already_AddRefed<QuotaObject> QuotaManager::GetQuotaObject(
@@ -6852,6 +6936,12 @@ QuotaManager::EnsureTemporaryOriginIsInitialized(
 
   auto res = [&aPersistenceType, &aQuotaInfo, this]()
       -> mozilla::Result<std::pair<nsCOMPtr<nsIFile>, bool>, nsresult> {
+    // Mark the origin as accessed in the cache before any of its files can
+    // change on disk, so that if this session crashes, the next session
+    // re-traverses the origin directory instead of trusting cached usage
+    // data.
+    QM_TRY(MarkOriginAccessedInCache(aPersistenceType, aQuotaInfo.mOrigin));
+
     // Get directory for this origin and persistence type.
     QM_TRY_UNWRAP(auto directory,
                   GetDirectoryForOrigin(aPersistenceType, aQuotaInfo.mOrigin));
@@ -7622,6 +7712,13 @@ void QuotaManager::CheckTemporaryStorageLimits() {
     }
 #endif
 
+    // Flag the origin as accessed in the cache before deleting any of its
+    // files, so that an interrupted eviction gets noticed by the next
+    // session.
+    Unused << NS_WARN_IF(NS_FAILED(MarkOriginAccessedInCache(
+        doomedOriginInfo->mGroupInfo->mPersistenceType,
+        doomedOriginInfo->mOrigin)));
+
     DeleteFilesForOrigin(doomedOriginInfo->mGroupInfo->mPersistenceType,
                          doomedOriginInfo->mOrigin);
   }
@@ -8351,6 +8448,11 @@ nsresult SaveOriginAccessTimeOp::DoDirectoryWork(QuotaManager& aQuotaManager) {
 
   AUTO_PROFILER_LABEL("SaveOriginAccessTimeOp::DoDirectoryWork", OTHER);
 
+  // The origin is being accessed, so flag it in the cache. This also covers
+  // accesses which don't go through EnsureTemporaryOriginIsInitialized.
+  QM_TRY(aQuotaManager.MarkOriginAccessedInCache(mPersistenceType.Value(),
+                                                 mOriginScope.GetOrigin()));
+
   QM_TRY_UNWRAP(auto file,
                 aQuotaManager.GetDirectoryForOrigin(mPersistenceType.Value(),
                                                     mOriginScope.GetOrigin()));
@@ -9807,6 +9909,14 @@ void ClearRequestBase::DeleteFiles(QuotaManager& aQuotaManager,
       return;
     }
 
+    if (!persistent) {
+      // Flag the origin as accessed in the cache before deleting any of its
+      // files, so that an interrupted deletion gets noticed by the next
+      // session.
+      Unused << NS_WARN_IF(NS_FAILED(aQuotaManager.MarkOriginAccessedInCache(
+          aPersistenceType, quotaInfo.mOrigin)));
+    }
+
     if (!mClientType.IsNull()) {
       nsAutoString clientDirectoryName;
       bool ok = Client::TypeToText(mClientType.Value(), clientDirectoryName,
@@ -10096,6 +10206,12 @@ nsresult PersistOp::DoDirectoryWork(QuotaManager& aQuotaManager) {
 
   AUTO_PROFILER_LABEL("PersistOp::DoDirectoryWork", OTHER);
 
+  // The persisted flag in the directory metadata is about to change, so make
+  // sure the next session re-reads the metadata for this origin in case this
+  // session crashes before the cache is rewritten.
+  QM_TRY(aQuotaManager.MarkOriginAccessedInCache(mPersistenceType.Value(),
+                                                 quotaInfo.mOrigin));
+
   // Update directory metadata on disk first. Then, create/update the originInfo
   // if needed.
   QM_TRY_UNWRAP(auto directory,
@@ -31,6 +31,7 @@
 #include "nsISupports.h"
 #include "nsStringFwd.h"
 #include "nsTArray.h"
+#include "nsTHashtable.h"
 #include "nsTStringRepr.h"
 #include "nscore.h"
 #include "prenv.h"
@@ -241,6 +242,11 @@ class QuotaManager final : public BackgroundThreadObject {
 
   void UnloadQuota();
 
+  nsresult WriteCache();
+
+  nsresult MarkOriginAccessedInCache(PersistenceType aPersistenceType,
+                                     const nsACString& aOrigin);
+
   already_AddRefed<QuotaObject> GetQuotaObject(
       PersistenceType aPersistenceType, const GroupAndOrigin& aGroupAndOrigin,
       Client::Type aClientType, nsIFile* aFile, int64_t aFileSize = -1,
@@ -614,6 +620,11 @@ class QuotaManager final : public BackgroundThreadObject {
   // it is only ever touched on the IO thread.
   nsDataHashtable<nsCStringHashKey, bool> mValidOrigins;
 
+  // A set of origins (prefixed with the repository id) which have already been
+  // marked as accessed in the cache since the cache was last written. This set
+  // isn't protected by any mutex but it is only ever touched on the IO thread.
+  nsTHashtable<nsCStringHashKey> mCacheAccessedOrigins;
+
   struct OriginInitializationInfo {
     bool mPersistentOriginAttempted : 1;
     bool mTemporaryOriginAttempted : 1;
@@ -3254,6 +3254,35 @@ void ScriptLoader::MaybeTriggerBytecodeEncoding() {
     return;
   }
 
+  // Wait a bit longer before serializing. Load event listeners and early
+  // user interaction frequently execute inner functions of the recorded
+  // scripts for the first time, and the incremental encoder records these
+  // delazifications, such that the next visit can skip re-parsing them.
+  uint32_t delay =
+      StaticPrefs::dom_script_loader_bytecode_cache_encoding_delay_ms();
+  if (delay > 0) {
+    nsCOMPtr<nsIRunnable> trigger =
+        NewRunnableMethod("ScriptLoader::ScheduleBytecodeEncoding", this,
+                          &ScriptLoader::ScheduleBytecodeEncoding);
+    if (NS_FAILED(NS_DelayedDispatchToCurrentThread(trigger.forget(), delay))) {
+      GiveUpBytecodeEncoding();
+      return;
+    }
+
+    LOG(("ScriptLoader (%p): Delay bytecode encoding by %u ms.", this, delay));
+    return;
+  }
+
+  ScheduleBytecodeEncoding();
+}
+
+void ScriptLoader::ScheduleBytecodeEncoding() {
+  // The document may have gone away while we were waiting for the encoding
+  // delay to elapse.
+  if (mGiveUpEncoding) {
+    return;
+  }
+
   // Create a new runnable dedicated to encoding the content of the bytecode of
   // all enqueued scripts when the document is idle. In case of failure, we
   // give-up on encoding the bytecode.
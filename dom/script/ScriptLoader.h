@@ -615,6 +615,16 @@ class ScriptLoader final : public nsISupports {
    */
   void MaybeTriggerBytecodeEncoding();
 
+  /**
+   * Queue an idle event to encode the bytecode of all the enqueued scripts.
+   * This is either called directly by MaybeTriggerBytecodeEncoding, or after
+   * the delay configured with the
+   * dom.script_loader.bytecode_cache.encoding_delay_ms preference, in order to
+   * also record the delazifications caused by load event listeners and early
+   * user interaction.
+   */
+  void ScheduleBytecodeEncoding();
+
   /**
    * Iterate over all script load request and save the bytecode of executed
    * functions on the cache provided by the channel.
@@ -1047,6 +1047,77 @@ nsCSPDirective::~nsCSPDirective() {
   }
 }
 
+const nsCSPDirective::CompiledHostIndex& nsCSPDirective::compiledHostIndex()
+    const {
+  if (mCompiledHostIndex) {
+    return *mCompiledHostIndex;
+  }
+
+  mCompiledHostIndex = mozilla::MakeUnique<CompiledHostIndex>();
+  CompiledHostIndex* index = mCompiledHostIndex.get();
+
+  // Bucketing only pays off once the source list is long enough that the
+  // linear scan dominates; short lists just stay in mGenericSrcs.
+  static const uint32_t kMinHostSrcsForIndex = 8;
+
+  class Classifier final : public nsCSPSrcVisitor {
+   public:
+    explicit Classifier(CompiledHostIndex* aIndex) : mIndex(aIndex) {}
+
+    bool visitSchemeSrc(const nsCSPSchemeSrc& src) override { return false; }
+
+    bool visitHostSrc(const nsCSPHostSrc& src) override {
+      nsString host;
+      src.getHost(host);
+      if (host.IsEmpty() || host.EqualsLiteral("*")) {
+        return false;
+      }
+      if (host.First() == '*') {
+        // "*.example.com" is keyed by ".example.com"; the lookup side checks
+        // every dot-suffix of the host being loaded.
+        mIndex->mWildcardHosts.LookupForAdd(Substring(host, 1))
+            .OrInsert([]() { return new nsTArray<const nsCSPBaseSrc*>(); })
+            ->AppendElement(&src);
+      } else {
+        mIndex->mExactHosts.LookupForAdd(host)
+            .OrInsert([]() { return new nsTArray<const nsCSPBaseSrc*>(); })
+            ->AppendElement(&src);
+      }
+      return true;
+    }
+
+    bool visitKeywordSrc(const nsCSPKeywordSrc& src) override { return false; }
+    bool visitNonceSrc(const nsCSPNonceSrc& src) override { return false; }
+    bool visitHashSrc(const nsCSPHashSrc& src) override { return false; }
+
+   private:
+    CompiledHostIndex* mIndex;
+  };
+
+  Classifier classifier(index);
+  uint32_t bucketedSrcs = 0;
+  for (uint32_t i = 0; i < mSrcs.Length(); i++) {
+    // visit() returns true only for host sources the classifier bucketed;
+    // everything else has to be consulted for every load.
+    if (mSrcs[i]->visit(&classifier)) {
+      bucketedSrcs++;
+    } else {
+      index->mGenericSrcs.AppendElement(mSrcs[i]);
+    }
+  }
+
+  if (bucketedSrcs < kMinHostSrcsForIndex) {
+    index->mExactHosts.Clear();
+    index->mWildcardHosts.Clear();
+    index->mGenericSrcs.ClearAndRetainStorage();
+    for (uint32_t i = 0; i < mSrcs.Length(); i++) {
+      index->mGenericSrcs.AppendElement(mSrcs[i]);
+    }
+  }
+
+  return *mCompiledHostIndex;
+}
+
 bool nsCSPDirective::permits(nsIURI* aUri, const nsAString& aNonce,
                              bool aWasRedirected, bool aReportOnly,
                              bool aUpgradeInsecure, bool aParserCreated) const {
@@ -1055,12 +1126,54 @@ bool nsCSPDirective::permits(nsIURI* aUri, const nsAString& aNonce,
         ("nsCSPDirective::permits, aUri: %s", aUri->GetSpecOrDefault().get()));
   }
 
-  for (uint32_t i = 0; i < mSrcs.Length(); i++) {
-    if (mSrcs[i]->permits(aUri, aNonce, aWasRedirected, aReportOnly,
-                          aUpgradeInsecure, aParserCreated)) {
+  const CompiledHostIndex& index = compiledHostIndex();
+
+  for (const nsCSPBaseSrc* src : index.mGenericSrcs) {
+    if (src->permits(aUri, aNonce, aWasRedirected, aReportOnly,
+                     aUpgradeInsecure, aParserCreated)) {
       return true;
     }
   }
+
+  if (index.mExactHosts.Count() == 0 && index.mWildcardHosts.Count() == 0) {
+    return false;
+  }
+
+  // Derive the host key the same way nsCSPHostSrc::permits does, so bucket
+  // lookups agree with the per-src host matching.
+  nsAutoCString asciiHost;
+  if (NS_FAILED(aUri->GetAsciiHost(asciiHost))) {
+    return false;
+  }
+  nsString uriHost;
+  CSP_PercentDecodeStr(NS_ConvertUTF8toUTF16(asciiHost), uriHost);
+
+  if (nsTArray<const nsCSPBaseSrc*>* srcs = index.mExactHosts.Get(uriHost)) {
+    for (const nsCSPBaseSrc* src : *srcs) {
+      if (src->permits(aUri, aNonce, aWasRedirected, aReportOnly,
+                       aUpgradeInsecure, aParserCreated)) {
+        return true;
+      }
+    }
+  }
+
+  // A wildcard source "*.b.c" matches any host ending in ".b.c", so consult
+  // the table for every dot-suffix of the host.
+  for (int32_t dot = uriHost.FindChar('.'); dot != kNotFound;
+       dot = uriHost.FindChar('.', dot + 1)) {
+    nsTArray<const nsCSPBaseSrc*>* srcs =
+        index.mWildcardHosts.Get(Substring(uriHost, dot));
+    if (!srcs) {
+      continue;
+    }
+    for (const nsCSPBaseSrc* src : *srcs) {
+      if (src->permits(aUri, aNonce, aWasRedirected, aReportOnly,
+                       aUpgradeInsecure, aParserCreated)) {
+        return true;
+      }
+    }
+  }
+
   return false;
 }
 
@@ -7,7 +7,9 @@
 #ifndef nsCSPUtils_h___
 #define nsCSPUtils_h___
 
+#include "nsClassHashtable.h"
 #include "nsCOMPtr.h"
+#include "nsHashKeys.h"
 #include "nsIContentSecurityPolicy.h"
 #include "nsIURI.h"
 #include "nsLiteralString.h"
@@ -15,6 +17,7 @@
 #include "nsTArray.h"
 #include "nsUnicharUtils.h"
 #include "mozilla/Logging.h"
+#include "mozilla/UniquePtr.h"
 
 class nsIChannel;
 
@@ -452,6 +455,7 @@ class nsCSPDirective {
 
   virtual void addSrcs(const nsTArray<nsCSPBaseSrc*>& aSrcs) {
     mSrcs = aSrcs.Clone();
+    mCompiledHostIndex = nullptr;
   }
 
   virtual bool restrictsContentType(nsContentPolicyType aContentType) const;
@@ -473,6 +477,33 @@ class nsCSPDirective {
  protected:
   CSPDirective mDirective;
   nsTArray<nsCSPBaseSrc*> mSrcs;
+
+ private:
+  // Buckets the host sources of this directive by host name so that a load
+  // only gets checked against the few sources that could possibly match its
+  // host instead of the whole source list. The bucketed sources are aliases
+  // into mSrcs and re-run their full checks (scheme, port, path,
+  // invalidation) on a bucket hit, so results are identical to the linear
+  // scan. Only directives with enough host sources are bucketed; smaller
+  // source lists stay in mGenericSrcs and are scanned as before.
+  struct CompiledHostIndex {
+    // Sources whose host has no leading wildcard, keyed by host name.
+    nsClassHashtable<nsStringHashKey, nsTArray<const nsCSPBaseSrc*>>
+        mExactHosts;
+    // "*.example.com" style sources, keyed by ".example.com".
+    nsClassHashtable<nsStringHashKey, nsTArray<const nsCSPBaseSrc*>>
+        mWildcardHosts;
+    // Everything that has to be consulted for every load: keywords, nonces,
+    // hashes, scheme sources and "*" hosts.
+    nsTArray<const nsCSPBaseSrc*> mGenericSrcs;
+  };
+
+  // Lazily builds mCompiledHostIndex the first time a directive is
+  // evaluated; all srcs are in place by then and only addSrcs (which resets
+  // the index) mutates them afterwards.
+  const CompiledHostIndex& compiledHostIndex() const;
+
+  mutable mozilla::UniquePtr<CompiledHostIndex> mCompiledHostIndex;
 };
 
 /* =============== nsCSPChildSrcDirective ============= */
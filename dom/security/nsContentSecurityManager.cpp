@@ -10,6 +10,7 @@
 #include "nsContentPolicyUtils.h"
 #include "nsEscape.h"
 #include "nsDataHandler.h"
+#include "nsDataHashtable.h"
 #include "nsIChannel.h"
 #include "nsIHttpChannelInternal.h"
 #include "nsINode.h"
@@ -38,6 +39,7 @@
 #include "mozilla/Logging.h"
 #include "mozilla/Preferences.h"
 #include "mozilla/StaticPrefs_dom.h"
+#include "mozilla/StaticPtr.h"
 #include "mozilla/StaticPrefs_security.h"
 #include "mozilla/Telemetry.h"
 #include "mozilla/TelemetryComms.h"
@@ -979,6 +981,22 @@ nsresult nsContentSecurityManager::CheckAllowLoadInSystemPrivilegedContext(
  * Every protocol handler must set one of the five security flags
  * defined in nsIProtocolHandler - if not - deny the load.
  */
+// The scheme -> verdict cache for CheckChannelHasProtocolSecurityFlag.
+// Whether a protocol handler sets exactly one of the five security flags is
+// a static property of the handler for all built-in schemes, so the answer
+// can be remembered per scheme instead of doing the IO-service handler
+// lookup on every AsyncOpen. The handlers for "about", "moz-safe-about" and
+// "moz-extension" compute their flags per URI; those schemes are never
+// cached.
+static StaticAutoPtr<nsDataHashtable<nsCStringHashKey, bool>>
+    sSchemeSecurityFlagVerdicts;
+
+static bool IsSchemeVerdictCacheable(const nsACString& aScheme) {
+  return !aScheme.EqualsLiteral("about") &&
+         !aScheme.EqualsLiteral("moz-safe-about") &&
+         !aScheme.EqualsLiteral("moz-extension");
+}
+
 nsresult nsContentSecurityManager::CheckChannelHasProtocolSecurityFlag(
     nsIChannel* aChannel) {
   nsCOMPtr<nsIURI> uri;
@@ -989,6 +1007,18 @@ nsresult nsContentSecurityManager::CheckChannelHasProtocolSecurityFlag(
   rv = uri->GetScheme(scheme);
   NS_ENSURE_SUCCESS(rv, rv);
 
+  const bool cacheable = NS_IsMainThread() && IsSchemeVerdictCacheable(scheme);
+  if (cacheable && sSchemeSecurityFlagVerdicts) {
+    bool verdict = false;
+    if (sSchemeSecurityFlagVerdicts->Get(scheme, &verdict)) {
+      if (verdict) {
+        return NS_OK;
+      }
+      MOZ_ASSERT(false, "protocol must use one valid security flag");
+      return NS_ERROR_CONTENT_BLOCKED;
+    }
+  }
+
   nsCOMPtr<nsIIOService> ios = do_GetIOService(&rv);
   NS_ENSURE_SUCCESS(rv, rv);
 
@@ -1017,6 +1047,15 @@ nsresult nsContentSecurityManager::CheckChannelHasProtocolSecurityFlag(
     securityFlagsSet += 1;
   }
 
+  if (cacheable) {
+    if (!sSchemeSecurityFlagVerdicts) {
+      sSchemeSecurityFlagVerdicts =
+          new nsDataHashtable<nsCStringHashKey, bool>();
+      ClearOnShutdown(&sSchemeSecurityFlagVerdicts);
+    }
+    sSchemeSecurityFlagVerdicts->Put(scheme, securityFlagsSet == 1);
+  }
+
   // Ensure that only "1" valid security flags is set.
   if (securityFlagsSet == 1) {
     return NS_OK;
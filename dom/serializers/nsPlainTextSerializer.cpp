@@ -1550,26 +1550,35 @@ void nsPlainTextSerializer::ConvertToLinesAndOutput(const nsAString& aString) {
  * line wrapping, indentation, whitespace compression and other things.
  */
 void nsPlainTextSerializer::Write(const nsAString& aStr) {
-  // XXX Copy necessary to use nsString methods and gain
-  // access to underlying buffer
-  nsAutoString str(aStr);
+  // We need a flat string to use nsString methods and gain access to the
+  // underlying buffer.  Callers nearly always hand us one already, so this
+  // rarely copies; we only make a mutable copy when the flowed-output nbsp
+  // replacement below actually has something to replace.
+  const nsPromiseFlatString flatStr(aStr);
+  nsAutoString nbspReplacedStr;
+  const nsString* strPtr = &flatStr;
 
 #ifdef DEBUG_wrapping
-  printf("Write(%s): wrap col = %d\n", NS_ConvertUTF16toUTF8(str).get(),
+  printf("Write(%s): wrap col = %d\n", NS_ConvertUTF16toUTF8(flatStr).get(),
          mSettings.GetWrapColumn());
 #endif
 
-  const int32_t totLen = str.Length();
+  const int32_t totLen = flatStr.Length();
 
   // If the string is empty, do nothing:
   if (totLen <= 0) return;
 
   // For Flowed text change nbsp-ses to spaces at end of lines to allow them
   // to be cut off along with usual spaces if required. (bug #125928)
-  if (mSettings.HasFlag(nsIDocumentEncoder::OutputFormatFlowed)) {
-    ReplaceVisiblyTrailingNbsps(str);
+  if (mSettings.HasFlag(nsIDocumentEncoder::OutputFormatFlowed) &&
+      flatStr.FindChar(kNBSP) != kNotFound) {
+    nbspReplacedStr = flatStr;
+    ReplaceVisiblyTrailingNbsps(nbspReplacedStr);
+    strPtr = &nbspReplacedStr;
   }
 
+  const nsString& str = *strPtr;
+
   // We have two major codepaths here. One that does preformatted text and one
   // that does normal formatted text. The one for preformatted text calls
   // Output directly while the other code path goes through AddToLine.
@@ -29,6 +29,7 @@
 #include "mozilla/ClearOnShutdown.h"
 #include "mozilla/ErrorNames.h"
 #include "mozilla/LoadContext.h"
+#include "mozilla/MruCache.h"
 #include "mozilla/Result.h"
 #include "mozilla/ResultExtensions.h"
 #include "mozilla/Telemetry.h"
@@ -327,15 +328,26 @@ struct ServiceWorkerManager::RegistrationDataPerPrincipal final {
       }
 
       AppendElement(aScope);
+      mMatchCache.Clear();
     }
 
     void RemoveScope(const nsACString& aScope) {
       MOZ_ALWAYS_TRUE(RemoveElement(aScope));
+      mMatchCache.Clear();
     }
 
     // Implements most of "Match Service Worker Registration":
     // https://w3c.github.io/ServiceWorker/#scope-match-algorithm
     Maybe<nsCString> MatchScope(const nsACString& aClientUrl) const {
+      // Interception decisions hit this for every navigation and client
+      // lookup, usually for a handful of distinct URLs, so route them
+      // through an MRU cache (which also remembers non-matches) instead of
+      // prefix-scanning every registered scope each time.
+      auto cached = mMatchCache.Lookup(aClientUrl);
+      if (cached) {
+        return cached.Data().mMatch;
+      }
+
       Maybe<nsCString> match;
 
       for (const nsCString& scope : *this) {
@@ -351,10 +363,31 @@ struct ServiceWorkerManager::RegistrationDataPerPrincipal final {
       // origin."
       MOZ_DIAGNOSTIC_ASSERT_IF(match, IsSameOrigin(*match, aClientUrl));
 
+      cached.Set(CachedMatch{nsCString(aClientUrl), match});
+
       return match;
     }
 
    private:
+    struct CachedMatch {
+      nsCString mClientUrl;
+      Maybe<nsCString> mMatch;
+    };
+
+    class MatchCache final
+        : public MruCache<nsACString, CachedMatch, MatchCache> {
+     public:
+      static HashNumber Hash(const nsACString& aKey) {
+        return HashString(aKey);
+      }
+
+      static bool Match(const nsACString& aKey, const CachedMatch& aVal) {
+        return aVal.mClientUrl == aKey;
+      }
+    };
+
+    mutable MatchCache mMatchCache;
+
     bool IsSameOrigin(const nsACString& aMatchingScope,
                       const nsACString& aClientUrl) const {
       auto parseResult = ScopeToPrincipal(aMatchingScope, OriginAttributes());
@@ -631,6 +631,16 @@ nsresult StorageDBThread::InitDatabase() {
     mOriginsHavingData.PutEntry(foundOrigin);
   }
 
+  // The first operation the worker thread typically executes is an origin
+  // preload.  Compile its statement now, while we are already here on the
+  // worker thread, so the first preload doesn't pay the compilation cost.
+  // Note: this string must exactly match the one used by opPreload below.
+  mWorkerStatements.WarmUpStatement(
+      "SELECT key, value FROM webappsstore2 "
+      "WHERE originAttributes = :originAttributes AND originKey = "
+      ":originKey "
+      "ORDER BY key LIMIT -1 OFFSET :offset");
+
   return NS_OK;
 }
 
@@ -55,8 +55,7 @@ void Queue::WriteBuffer(const Buffer& aBuffer, uint64_t aBufferOffset,
   }
 
   ipc::Shmem shmem;
-  if (!mBridge->AllocShmem(size, ipc::Shmem::SharedMemory::TYPE_BASIC,
-                           &shmem)) {
+  if (!mBridge->AllocStagingShmem(size, &shmem)) {
     aRv.ThrowAbortError(
         nsPrintfCString("Unable to allocate shmem of size %" PRIuPTR, size));
     return;
@@ -64,7 +63,7 @@ void Queue::WriteBuffer(const Buffer& aBuffer, uint64_t aBufferOffset,
 
   memcpy(shmem.get<uint8_t>(), aData.Data() + aDataOffset, size);
   mBridge->SendQueueWriteBuffer(mId, aBuffer.mId, aBufferOffset,
-                                std::move(shmem));
+                                std::move(shmem), size);
 }
 
 void Queue::WriteTexture(const dom::GPUTextureCopyView& aDestination,
@@ -110,16 +109,15 @@ void Queue::WriteTexture(const dom::GPUTextureCopyView& aDestination,
   }
 
   ipc::Shmem shmem;
-  if (!mBridge->AllocShmem(size, ipc::Shmem::SharedMemory::TYPE_BASIC,
-                           &shmem)) {
+  if (!mBridge->AllocStagingShmem(size, &shmem)) {
     aRv.ThrowAbortError(
         nsPrintfCString("Unable to allocate shmem of size %" PRIuPTR, size));
     return;
   }
 
   memcpy(shmem.get<uint8_t>(), aData.Data() + aDataLayout.mOffset, size);
-  mBridge->SendQueueWriteTexture(mId, copyView, std::move(shmem), dataLayout,
-                                 extent);
+  mBridge->SendQueueWriteTexture(mId, copyView, std::move(shmem), size,
+                                 dataLayout, extent);
 }
 
 }  // namespace webgpu
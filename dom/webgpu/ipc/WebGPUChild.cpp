@@ -604,6 +604,27 @@ ipc::IPCResult WebGPUChild::RecvError(RawId aDeviceId,
   return IPC_OK();
 }
 
+bool WebGPUChild::AllocStagingShmem(size_t aSize, ipc::Shmem* aShmem) {
+  for (size_t i = 0; i < mStagingShmems.Length(); ++i) {
+    if (mStagingShmems[i].Size<uint8_t>() >= aSize) {
+      *aShmem = std::move(mStagingShmems[i]);
+      mStagingShmems.RemoveElementAt(i);
+      return true;
+    }
+  }
+  return AllocShmem(aSize, ipc::Shmem::SharedMemory::TYPE_BASIC, aShmem);
+}
+
+ipc::IPCResult WebGPUChild::RecvReturnStagingShmem(ipc::Shmem&& aShmem) {
+  if (mStagingShmems.Length() < kMaxStagingShmems &&
+      aShmem.Size<uint8_t>() <= kMaxStagingShmemSize) {
+    mStagingShmems.AppendElement(std::move(aShmem));
+  } else {
+    DeallocShmem(aShmem);
+  }
+  return IPC_OK();
+}
+
 ipc::IPCResult WebGPUChild::RecvDropAction(const ipc::ByteBuf& aByteBuf) {
   const auto* byteBuf = ToFFI(&aByteBuf);
   ffi::wgpu_client_drop_action(mClient, byteBuf);
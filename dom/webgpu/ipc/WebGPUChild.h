@@ -78,6 +78,10 @@ class WebGPUChild final : public PWebGPUChild, public SupportsWeakPtr {
   void RegisterDevice(RawId aId, Device* aDevice);
   void UnregisterDevice(RawId aId);
 
+  /// Allocates a shmem for a queue write, preferring a staging segment the
+  /// GPU process has already consumed and returned over mapping a new one.
+  bool AllocStagingShmem(size_t aSize, ipc::Shmem* aShmem);
+
  private:
   virtual ~WebGPUChild();
 
@@ -97,12 +101,20 @@ class WebGPUChild final : public PWebGPUChild, public SupportsWeakPtr {
     Release();
   }
 
+  // Bounds on the staging shmem pool: entry count, and the largest segment
+  // worth keeping around. One-off giant uploads are unmapped when they come
+  // back rather than hoarded.
+  static const size_t kMaxStagingShmems = 8;
+  static const size_t kMaxStagingShmemSize = 16 << 20;
+
   ffi::WGPUClient* const mClient;
   bool mIPCOpen;
   std::unordered_map<RawId, Device*> mDeviceMap;
+  nsTArray<ipc::Shmem> mStagingShmems;
 
  public:
   ipc::IPCResult RecvError(RawId aDeviceId, const nsACString& aMessage);
+  ipc::IPCResult RecvReturnStagingShmem(ipc::Shmem&& aShmem);
   ipc::IPCResult RecvDropAction(const ipc::ByteBuf& aByteBuf);
   ipc::IPCResult RecvFreeAdapter(RawId id);
   ipc::IPCResult RecvFreeDevice(RawId id);
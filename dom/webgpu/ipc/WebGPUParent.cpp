@@ -378,25 +378,36 @@ ipc::IPCResult WebGPUParent::RecvQueueSubmit(
   return IPC_OK();
 }
 
+void WebGPUParent::RecycleStagingShmem(Shmem&& aShmem) {
+  if (!CanSend()) {
+    DeallocShmem(aShmem);
+    return;
+  }
+  Unused << SendReturnStagingShmem(std::move(aShmem));
+}
+
 ipc::IPCResult WebGPUParent::RecvQueueWriteBuffer(RawId aSelfId,
                                                   RawId aBufferId,
                                                   uint64_t aBufferOffset,
-                                                  Shmem&& aShmem) {
+                                                  Shmem&& aShmem,
+                                                  uint64_t aDataSize) {
+  const auto size = std::min<uint64_t>(aDataSize, aShmem.Size<uint8_t>());
   ffi::wgpu_server_queue_write_buffer(mContext, aSelfId, aBufferId,
                                       aBufferOffset, aShmem.get<uint8_t>(),
-                                      aShmem.Size<uint8_t>());
-  DeallocShmem(aShmem);
+                                      size);
+  RecycleStagingShmem(std::move(aShmem));
   return IPC_OK();
 }
 
 ipc::IPCResult WebGPUParent::RecvQueueWriteTexture(
     RawId aSelfId, const ffi::WGPUTextureCopyView& aDestination, Shmem&& aShmem,
-    const ffi::WGPUTextureDataLayout& aDataLayout,
+    uint64_t aDataSize, const ffi::WGPUTextureDataLayout& aDataLayout,
     const ffi::WGPUExtent3d& aExtent) {
-  ffi::wgpu_server_queue_write_texture(
-      mContext, aSelfId, &aDestination, aShmem.get<uint8_t>(),
-      aShmem.Size<uint8_t>(), &aDataLayout, &aExtent);
-  DeallocShmem(aShmem);
+  const auto size = std::min<uint64_t>(aDataSize, aShmem.Size<uint8_t>());
+  ffi::wgpu_server_queue_write_texture(mContext, aSelfId, &aDestination,
+                                       aShmem.get<uint8_t>(), size,
+                                       &aDataLayout, &aExtent);
+  RecycleStagingShmem(std::move(aShmem));
   return IPC_OK();
 }
 
@@ -47,10 +47,12 @@ class WebGPUParent final : public PWebGPUParent {
   ipc::IPCResult RecvQueueSubmit(RawId aSelfId,
                                  const nsTArray<RawId>& aCommandBuffers);
   ipc::IPCResult RecvQueueWriteBuffer(RawId aSelfId, RawId aBufferId,
-                                      uint64_t aBufferOffset, Shmem&& aShmem);
+                                      uint64_t aBufferOffset, Shmem&& aShmem,
+                                      uint64_t aDataSize);
   ipc::IPCResult RecvQueueWriteTexture(
       RawId aSelfId, const ffi::WGPUTextureCopyView& aDestination,
-      Shmem&& aShmem, const ffi::WGPUTextureDataLayout& aDataLayout,
+      Shmem&& aShmem, uint64_t aDataSize,
+      const ffi::WGPUTextureDataLayout& aDataLayout,
       const ffi::WGPUExtent3d& aExtent);
   ipc::IPCResult RecvBindGroupLayoutDestroy(RawId aSelfId);
   ipc::IPCResult RecvPipelineLayoutDestroy(RawId aSelfId);
@@ -82,6 +84,9 @@ class WebGPUParent final : public PWebGPUParent {
  private:
   virtual ~WebGPUParent();
   void MaintainDevices();
+  /// Hands a consumed QueueWrite* staging shmem back to the client for reuse,
+  /// or unmaps it if the channel is closing.
+  void RecycleStagingShmem(Shmem&& aShmem);
 
   const ffi::WGPUGlobal* const mContext;
   base::RepeatingTimer<WebGPUParent> mTimer;
@@ -2271,12 +2271,15 @@ WorkerThreadPrimaryRunnable::Run() {
 
   threadHelper.Nullify();
 
-  mWorkerPrivate->ScheduleDeletion(WorkerPrivate::WorkerRan);
-
-  // It is no longer safe to touch mWorkerPrivate.
-  mWorkerPrivate = nullptr;
-
-  // Now recycle this thread.
+  // Recycle this thread before scheduling our deletion: the deletion
+  // runnable is what eventually unregisters the worker and schedules any
+  // worker queued behind the per-domain limit, and dispatching in this
+  // order guarantees the queued worker finds this thread in the idle pool
+  // rather than paying for a brand new OS thread. Sites that funnel a
+  // stream of short-lived same-origin workers through the queue thereby
+  // multiplex over a single pooled thread. This is safe because the thread
+  // no longer knows about our worker after Nullify(), and a new primary
+  // runnable can only run once we have unwound from this one.
   nsCOMPtr<nsIEventTarget> mainTarget = GetMainThreadEventTarget();
   MOZ_ASSERT(mainTarget);
 
@@ -2285,6 +2288,11 @@ WorkerThreadPrimaryRunnable::Run() {
   MOZ_ALWAYS_SUCCEEDS(
       mainTarget->Dispatch(finishedRunnable, NS_DISPATCH_NORMAL));
 
+  mWorkerPrivate->ScheduleDeletion(WorkerPrivate::WorkerRan);
+
+  // It is no longer safe to touch mWorkerPrivate.
+  mWorkerPrivate = nullptr;
+
   return NS_OK;
 }
 
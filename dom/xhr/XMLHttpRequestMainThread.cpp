@@ -1940,6 +1940,21 @@ XMLHttpRequestMainThread::OnStartRequest(nsIRequest* request) {
     }
   }
 
+  // Pre-size responseText the same way for text-ish response types.  The
+  // decoded length can only be smaller than the byte count for multi-byte
+  // input, so Content-Length is a safe upper bound in UTF-16 code units.
+  if ((mResponseType == XMLHttpRequestResponseType::_empty ||
+       mResponseType == XMLHttpRequestResponseType::Text ||
+       mResponseType == XMLHttpRequestResponseType::Json) &&
+      NS_SUCCEEDED(status)) {
+    int64_t contentLength;
+    rv = channel->GetContentLength(&contentLength);
+    if (NS_SUCCEEDED(rv) && contentLength > 0 &&
+        contentLength < XML_HTTP_REQUEST_MAX_CONTENT_LENGTH_PREALLOCATE) {
+      mResponseText.SetCapacity(static_cast<uint32_t>(contentLength));
+    }
+  }
+
   // Set up responseXML
   // Note: Main Fetch step 18 requires to ignore body for head/connect methods.
   bool parseBody = (mResponseType == XMLHttpRequestResponseType::_empty ||
@@ -6,6 +6,7 @@
 
 #include "XMLHttpRequestString.h"
 #include "nsISupportsImpl.h"
+#include "mozilla/Unused.h"
 #include "mozilla/dom/DOMString.h"
 
 namespace mozilla {
@@ -40,6 +41,14 @@ class XMLHttpRequestStringBuffer final {
     mData.Append(aString);
   }
 
+  void SetCapacity(uint32_t aCapacity) {
+    NS_ASSERT_OWNINGTHREAD(XMLHttpRequestStringBuffer);
+
+    MutexAutoLock lock(mMutex);
+    // This is just a hint; if it fails we'll grow incrementally as usual.
+    Unused << mData.SetCapacity(aCapacity, mozilla::fallible);
+  }
+
   MOZ_MUST_USE bool GetAsString(nsAString& aString) {
     MutexAutoLock lock(mMutex);
     return aString.Assign(mData, mozilla::fallible);
@@ -105,6 +114,10 @@ void XMLHttpRequestString::Append(const nsAString& aString) {
   mBuffer->Append(aString);
 }
 
+void XMLHttpRequestString::SetCapacity(uint32_t aCapacity) {
+  mBuffer->SetCapacity(aCapacity);
+}
+
 bool XMLHttpRequestString::GetAsString(nsAString& aString) const {
   return mBuffer->GetAsString(aString);
 }
@@ -38,6 +38,10 @@ class XMLHttpRequestString final {
 
   void Append(const nsAString& aString);
 
+  // Best-effort capacity hint, used to pre-size the buffer from the channel's
+  // Content-Length before the body starts arriving.
+  void SetCapacity(uint32_t aCapacity);
+
   // This method should be called only when the string is really needed because
   // it can cause the duplication of the strings in case the loading of the XHR
   // is not completed yet.
@@ -5511,6 +5511,12 @@ EditorDOMPoint HTMLEditor::GetCurrentHardLineStartPoint(
   // <br> element.  Look up the tree for as long as we are the first node in
   // the container (typically, start of nearest block ancestor), and as long
   // as we haven't hit the body node.
+  // The editing host cannot change while we climb up the tree here, so
+  // resolve it once rather than from the Selection on every iteration.
+  Element* const editingHost = GetActiveEditingHost();
+  auto isDescendantOfEditingHost = [editingHost](const nsINode* aNode) {
+    return editingHost && aNode && aNode->IsInclusiveDescendantOf(editingHost);
+  };
   for (nsIContent* nearContent = GetPreviousEditableHTMLNodeInBlock(point);
        !nearContent && !point.IsContainerHTMLElement(nsGkAtoms::body) &&
        point.GetContainer()->GetParentNode();
@@ -5531,15 +5537,14 @@ EditorDOMPoint HTMLEditor::GetCurrentHardLineStartPoint(
     // before walking up to a parent because we need to return the parent
     // object, so the parent itself might not be in the editable area, but
     // it's OK if we're not performing a block-level action.
-    // XXX Here is too slow.  Let's cache active editing host first, then,
-    //     compair with container of the point when we climb up the tree.
     bool blockLevelAction =
         aEditSubAction == EditSubAction::eIndent ||
         aEditSubAction == EditSubAction::eOutdent ||
         aEditSubAction == EditSubAction::eSetOrClearAlignment ||
         aEditSubAction == EditSubAction::eCreateOrRemoveBlock;
-    if (!IsDescendantOfEditorRoot(point.GetContainer()->GetParentNode()) &&
-        (blockLevelAction || !IsDescendantOfEditorRoot(point.GetContainer()))) {
+    if (!isDescendantOfEditingHost(point.GetContainer()->GetParentNode()) &&
+        (blockLevelAction ||
+         !isDescendantOfEditingHost(point.GetContainer()))) {
       break;
     }
 
@@ -5616,6 +5621,12 @@ EditorDOMPoint HTMLEditor::GetCurrentHardLineEndPoint(
   // element.  Look up the tree for as long as we are the last node in the
   // container (typically, block node), and as long as we haven't hit the body
   // node.
+  // The editing host cannot change while we climb up the tree here, so
+  // resolve it once rather than from the Selection on every iteration.
+  Element* const editingHost = GetActiveEditingHost();
+  auto isDescendantOfEditingHost = [editingHost](const nsINode* aNode) {
+    return editingHost && aNode && aNode->IsInclusiveDescendantOf(editingHost);
+  };
   for (nsIContent* nearContent = GetNextEditableHTMLNodeInBlock(point);
        !nearContent && !point.IsContainerHTMLElement(nsGkAtoms::body) &&
        point.GetContainer()->GetParentNode();
@@ -5626,10 +5637,8 @@ EditorDOMPoint HTMLEditor::GetCurrentHardLineEndPoint(
     // XXX Maybe returning parent of editing host is really error prone since
     //     everybody need to check whether the end point is in editing host
     //     when they touch there.
-    // XXX Here is too slow.  Let's cache active editing host first, then,
-    //     compair with container of the point when we climb up the tree.
-    if (!IsDescendantOfEditorRoot(point.GetContainer()) &&
-        !IsDescendantOfEditorRoot(point.GetContainer()->GetParentNode())) {
+    if (!isDescendantOfEditingHost(point.GetContainer()) &&
+        !isDescendantOfEditingHost(point.GetContainer()->GetParentNode())) {
       break;
     }
 
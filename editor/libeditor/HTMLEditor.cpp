@@ -3999,10 +3999,12 @@ nsresult HTMLEditor::CollapseAdjacentTextNodes(nsRange& aInRange) {
 
   // now that I have a list of text nodes, collapse adjacent text nodes
   // NOTE: assumption that JoinNodes keeps the righthand node
-  while (textNodes.Length() > 1) {
+  // Walk the pairs by index; removing the leftmost element each round just
+  // shifted the entire tail of the array for no benefit.
+  for (size_t index = 0; index + 1 < textNodes.Length(); index++) {
     // we assume a textNodes entry can't be nullptr
-    Text* leftTextNode = textNodes[0];
-    Text* rightTextNode = textNodes[1];
+    Text* leftTextNode = textNodes[index];
+    Text* rightTextNode = textNodes[index + 1];
     NS_ASSERTION(leftTextNode && rightTextNode,
                  "left or rightTextNode null in CollapseAdjacentTextNodes");
 
@@ -4018,9 +4020,6 @@ nsresult HTMLEditor::CollapseAdjacentTextNodes(nsRange& aInRange) {
         return rv;
       }
     }
-
-    // remove the leftmost text node from the list
-    textNodes.RemoveElementAt(0);
   }
 
   return NS_OK;
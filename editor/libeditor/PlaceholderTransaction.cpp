@@ -153,12 +153,26 @@ NS_IMETHODIMP PlaceholderTransaction::Merge(nsITransaction* aOtherTransaction,
       PlaceholderTransaction* otherPlaceholderTransaction =
           otherTransactionBase->GetAsPlaceholderTransaction();
       if (!otherPlaceholderTransaction) {
-        // See bug 171243: just drop incoming placeholders on the floor.
-        // Their children will be swallowed by this preexisting one.
-        DebugOnly<nsresult> rvIgnored = AppendChild(otherTransactionBase);
-        NS_WARNING_ASSERTION(
-            NS_SUCCEEDED(rvIgnored),
-            "EditAggregateTransaction::AppendChild() failed, but ignored");
+        // During typing, every keystroke arrives here as its own insert-text
+        // transaction.  Give the last child a chance to absorb it (sequential
+        // insert-text transactions coalesce), so that the batch undoes and
+        // redoes as one text mutation rather than one per character, and the
+        // child list doesn't grow per keystroke.
+        bool mergedIntoChild = false;
+        if (!mChildren.IsEmpty()) {
+          DebugOnly<nsresult> rvIgnored = mChildren.LastElement()->Merge(
+              otherTransactionBase, &mergedIntoChild);
+          NS_WARNING_ASSERTION(NS_SUCCEEDED(rvIgnored),
+                               "nsITransaction::Merge() failed, but ignored");
+        }
+        if (!mergedIntoChild) {
+          // See bug 171243: just drop incoming placeholders on the floor.
+          // Their children will be swallowed by this preexisting one.
+          DebugOnly<nsresult> rvIgnored = AppendChild(otherTransactionBase);
+          NS_WARNING_ASSERTION(
+              NS_SUCCEEDED(rvIgnored),
+              "EditAggregateTransaction::AppendChild() failed, but ignored");
+        }
       }
     }
     *aDidMerge = true;
@@ -1094,18 +1094,17 @@ nsresult TextEditor::RedoAsAction(uint32_t aCount, nsIPrincipal* aPrincipal) {
       rv = NS_ERROR_FAILURE;
     } else {
       // We may take empty <br> element for empty editor back with this redo.
-      // We need to store it again.
-      // XXX Looks like that this is too slow if there are a lot of nodes.
-      //     Shouldn't we just scan children in the root?
-      nsCOMPtr<nsIHTMLCollection> nodeList =
-          mRootElement->GetElementsByTagName(u"br"_ns);
-      MOZ_ASSERT(nodeList);
-      Element* brElement =
-          nodeList->Length() == 1 ? nodeList->Item(0) : nullptr;
-      if (brElement &&
-          EditorUtils::IsPaddingBRElementForEmptyEditor(*brElement)) {
+      // We need to store it again.  The padding <br> element can only appear
+      // as the sole leaf content of the root, so checking the first leaf
+      // child is enough; walking the whole subtree with
+      // GetElementsByTagName() is needlessly expensive in a large document.
+      // This matches what UndoAsAction() does.
+      nsIContent* firstLeafChild = HTMLEditUtils::GetFirstLeafChild(
+          *mRootElement, ChildBlockBoundary::Ignore);
+      if (firstLeafChild &&
+          EditorUtils::IsPaddingBRElementForEmptyEditor(*firstLeafChild)) {
         mPaddingBRElementForEmptyEditor =
-            static_cast<HTMLBRElement*>(brElement);
+            static_cast<HTMLBRElement*>(firstLeafChild);
       } else {
         mPaddingBRElementForEmptyEditor = nullptr;
       }
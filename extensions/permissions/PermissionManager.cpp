@@ -1717,6 +1717,12 @@ nsresult PermissionManager::AddInternal(
           PermissionEntry(id, typeIndex, aPermission, aExpireType, aExpireTime,
                           aModificationTime));
 
+      while (mPermissionCountByType.Length() <=
+             static_cast<size_t>(typeIndex)) {
+        mPermissionCountByType.AppendElement(0);
+      }
+      mPermissionCountByType[typeIndex]++;
+
       if (aDBOperation == eWriteToDB &&
           IsPersistentExpire(aExpireType, aType)) {
         UpdateDB(op, id, origin, aType, aPermission, aExpireType, aExpireTime,
@@ -1745,6 +1751,11 @@ nsresult PermissionManager::AddInternal(
 
       entry->GetPermissions().RemoveElementAt(index);
 
+      MOZ_ASSERT(static_cast<size_t>(typeIndex) <
+                     mPermissionCountByType.Length() &&
+                 mPermissionCountByType[typeIndex] > 0);
+      mPermissionCountByType[typeIndex]--;
+
       if (aDBOperation == eWriteToDB)
         // We care only about the id here so we pass dummy values for all other
         // parameters.
@@ -2227,6 +2238,14 @@ nsresult PermissionManager::CommonTestPermissionInternal(
   }
 #endif
 
+  // If no permission of this type is stored for any origin, the lookup below
+  // cannot match. Bail out early to avoid constructing a PermissionKey and
+  // walking the subdomain chain of the principal.
+  if (static_cast<size_t>(aTypeIndex) >= mPermissionCountByType.Length() ||
+      mPermissionCountByType[aTypeIndex] == 0) {
+    return NS_OK;
+  }
+
   PermissionHashKey* entry =
       aPrincipal ? GetPermissionHashKey(aPrincipal, aTypeIndex, aExactHostMatch)
                  : GetPermissionHashKey(aURI, aOriginAttributes, aTypeIndex,
@@ -2677,6 +2696,7 @@ nsresult PermissionManager::RemoveAllFromMemory() {
   mLargestID = 0;
   mTypeArray.clear();
   mPermissionTable.Clear();
+  mPermissionCountByType.Clear();
 
   return NS_OK;
 }
@@ -617,6 +617,12 @@ class PermissionManager final : public nsIPermissionManager,
   // a unique, monotonically increasing id used to identify each database entry
   int64_t mLargestID;
 
+  // The number of permission entries stored for each type index. Kept in sync
+  // with mPermissionTable so that lookups for types with no stored permissions
+  // can bail out before building a PermissionKey and walking the subdomain
+  // chain of the principal.
+  nsTArray<uint32_t> mPermissionCountByType;
+
   nsCOMPtr<nsIPrefBranch> mDefaultPrefBranch;
 
   // NOTE: Ensure this is the last member since it has a large inline buffer.
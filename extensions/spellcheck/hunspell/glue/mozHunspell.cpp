@@ -155,6 +155,7 @@ mozHunspell::SetDictionary(const nsACString& aDictionary) {
     mAffixFileName.Truncate();
     mDecoder = nullptr;
     mEncoder = nullptr;
+    mCheckCache.Clear();
 
     return NS_OK;
   }
@@ -184,6 +185,7 @@ mozHunspell::SetDictionary(const nsACString& aDictionary) {
   // SetDictionary can be called multiple times, so we might have a
   // valid mHunspell instance which needs cleaned up.
   delete mHunspell;
+  mCheckCache.Clear();
 
   mDictionary = dict;
   mAffixFileName = affFileName;
@@ -408,12 +410,27 @@ mozHunspell::Check(const nsAString& aWord, bool* aResult) {
   }
   NS_ENSURE_TRUE(mHunspell, NS_ERROR_FAILURE);
 
-  std::string charsetWord;
-  nsresult rv = ConvertCharset(aWord, charsetWord);
-  NS_ENSURE_SUCCESS(rv, rv);
+  nsresult rv = NS_OK;
+  bool correct;
+  if (auto cached = mCheckCache.Lookup(aWord)) {
+    correct = cached.Data();
+  } else {
+    std::string charsetWord;
+    rv = ConvertCharset(aWord, charsetWord);
+    NS_ENSURE_SUCCESS(rv, rv);
+
+    correct = mHunspell->spell(charsetWord);
+
+    if (mCheckCache.Count() >= kCheckCacheSize) {
+      mCheckCache.Clear();
+    }
+    mCheckCache.Put(aWord, correct);
+  }
 
-  *aResult = mHunspell->spell(charsetWord);
+  *aResult = correct;
 
+  // Only the hunspell verdict is cached, so words added to the personal
+  // dictionary take effect without invalidating the cache.
   if (!*aResult && mPersonalDictionary)
     rv = mPersonalDictionary->Check(aWord, aResult);
 
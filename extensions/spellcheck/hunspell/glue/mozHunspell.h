@@ -63,6 +63,7 @@
 #include <hunspell.hxx>
 #include "mozISpellCheckingEngine.h"
 #include "mozIPersonalDictionary.h"
+#include "nsDataHashtable.h"
 #include "nsString.h"
 #include "nsCOMPtr.h"
 #include "nsCOMArray.h"
@@ -123,6 +124,14 @@ class mozHunspell final : public mozISpellCheckingEngine,
   nsCOMArray<nsIFile> mDynamicDirectories;
   nsInterfaceHashtable<nsStringHashKey, nsIURI> mDynamicDictionaries;
 
+  // Cache of recent hunspell verdicts. The inline spellchecker re-checks
+  // the words around every edit, so consecutive keystrokes mostly check the
+  // same words over and over; the cache skips the affix analysis for them.
+  // Cleared when the dictionary changes and capped at kCheckCacheSize
+  // entries. The personal dictionary is not part of the cached verdict.
+  static const uint32_t kCheckCacheSize = 1024;
+  nsDataHashtable<nsStringHashKey, bool> mCheckCache;
+
   Hunspell* mHunspell;
 };
 
@@ -5,6 +5,7 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "PathSkia.h"
+#include <algorithm>
 #include <math.h>
 #include "DrawTargetSkia.h"
 #include "Logging.h"
@@ -133,6 +134,26 @@ bool PathSkia::StrokeContainsPoint(const StrokeOptions& aStrokeOptions,
     return false;
   }
 
+  Matrix inverse = aTransform;
+  if (!inverse.Invert()) {
+    return false;
+  }
+  SkPoint point = PointToSkPoint(inverse.TransformPoint(aPoint));
+
+  // Building the stroked path below is expensive for complex paths, and
+  // hit-testing runs this against every candidate path. All the stroked
+  // geometry lies within the path bounds inflated by half the line width,
+  // scaled up to account for miter joins and square caps, so reject points
+  // outside those bounds without stroking.
+  SkScalar pad = SkFloatToScalar(
+      aStrokeOptions.mLineWidth * 0.5f *
+      std::max(aStrokeOptions.mMiterLimit, float(M_SQRT2)));
+  SkRect quickBounds = mPath.getBounds();
+  quickBounds.outset(pad, pad);
+  if (!quickBounds.contains(point.fX, point.fY)) {
+    return false;
+  }
+
   SkPaint paint;
   if (!StrokeOptionsToPaint(paint, aStrokeOptions)) {
     return false;
@@ -141,7 +162,7 @@ bool PathSkia::StrokeContainsPoint(const StrokeOptions& aStrokeOptions,
   SkPath strokePath;
   paint.getFillPath(mPath, &strokePath);
 
-  return SkPathContainsPoint(strokePath, aPoint, aTransform);
+  return strokePath.contains(point.fX, point.fY);
 }
 
 Rect PathSkia::GetBounds(const Matrix& aTransform) const {
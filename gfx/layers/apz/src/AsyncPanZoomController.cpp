@@ -703,6 +703,7 @@ AsyncPanZoomController::AsyncPanZoomController(
       mTreeManager(aTreeManager),
       mRecursiveMutex("AsyncPanZoomController"),
       mLastContentPaintMetrics(mLastContentPaintMetadata.GetMetrics()),
+      mEstimatedPaintDurationMs(kDefaultEstimatedPaintDurationMs),
       mX(this),
       mY(this),
       mPanDirRestricted(false),
@@ -3929,7 +3930,7 @@ static void RedistributeDisplayPortExcess(CSSSize& aDisplayPortSize,
 /* static */
 const ScreenMargin AsyncPanZoomController::CalculatePendingDisplayPort(
     const FrameMetrics& aFrameMetrics, const ParentLayerPoint& aVelocity,
-    ZoomInProgress aZoomInProgress) {
+    ZoomInProgress aZoomInProgress, float aEstimatedPaintDurationMs) {
   if (aFrameMetrics.IsScrollInfoLayer()) {
     // Don't compute margins. Since we can't asynchronously scroll this frame,
     // we don't want to paint anything more than the composition bounds.
@@ -3971,7 +3972,9 @@ const ScreenMargin AsyncPanZoomController::CalculatePendingDisplayPort(
 
   // Offset the displayport, depending on how fast we're moving and the
   // estimated time it takes to paint, to try to minimise checkerboarding.
-  float paintFactor = kDefaultEstimatedPaintDurationMs;
+  float paintFactor = aEstimatedPaintDurationMs > 0.0f
+                          ? aEstimatedPaintDurationMs
+                          : kDefaultEstimatedPaintDurationMs;
   displayPort.MoveBy(velocity * paintFactor * StaticPrefs::apz_velocity_bias());
 
   APZC_LOGV_FM(aFrameMetrics,
@@ -4097,7 +4100,8 @@ void AsyncPanZoomController::RequestContentRepaint(
   ParentLayerPoint velocity = GetVelocityVector();
   ScreenMargin displayportMargins = CalculatePendingDisplayPort(
       Metrics(), velocity,
-      mState == PINCHING ? ZoomInProgress::Yes : ZoomInProgress::No);
+      mState == PINCHING ? ZoomInProgress::Yes : ZoomInProgress::No,
+      mEstimatedPaintDurationMs);
   Metrics().SetPaintRequestTime(TimeStamp::Now());
   RequestContentRepaint(Metrics(), velocity, displayportMargins, aUpdateType);
 }
@@ -4697,6 +4701,19 @@ void AsyncPanZoomController::NotifyLayersUpdated(
     }
   }
 
+  if (aThisLayerTreeUpdated && !aLayerMetrics.GetPaintRequestTime().IsNull()) {
+    // Fold the observed repaint latency into our running estimate, so that
+    // CalculatePendingDisplayPort projects the displayport as far ahead of a
+    // moving scroll position as content actually needs. Smooth and clamp the
+    // samples so a single janky paint doesn't balloon the displayport.
+    float sampleMs = std::min(
+        float((TimeStamp::Now() - aLayerMetrics.GetPaintRequestTime())
+                  .ToMilliseconds()),
+        2000.0f);
+    mEstimatedPaintDurationMs =
+        0.75f * mEstimatedPaintDurationMs + 0.25f * sampleMs;
+  }
+
   // The main thread may send us a visual scroll offset update. This is
   // different from a layout viewport offset update in that the layout viewport
   // offset is limited to the layout scroll range, while the visual viewport
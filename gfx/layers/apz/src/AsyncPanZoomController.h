@@ -350,10 +350,14 @@ class AsyncPanZoomController {
    * checkerboard immediately. This includes a bunch of logic, including
    * algorithms to bias painting in the direction of the velocity and other
    * such things.
+   * |aEstimatedPaintDurationMs|, if positive, is how long we expect the
+   * content repaint to take; together with the velocity it determines how
+   * far ahead of the scroll position the displayport is pushed. If it is
+   * zero or negative, a default estimate is used.
    */
   static const ScreenMargin CalculatePendingDisplayPort(
       const FrameMetrics& aFrameMetrics, const ParentLayerPoint& aVelocity,
-      ZoomInProgress aZoomInProgress);
+      ZoomInProgress aZoomInProgress, float aEstimatedPaintDurationMs = 0.0f);
 
   nsEventStatus HandleDragEvent(const MouseInput& aEvent,
                                 const AsyncDragMetrics& aDragMetrics,
@@ -984,6 +988,11 @@ class AsyncPanZoomController {
                                            // mLastContentPaintMetadata.mMetrics
   // The last content repaint request.
   RepaintRequest mLastPaintRequestMetrics;
+  // A smoothed estimate, in milliseconds, of how long a content repaint
+  // takes, measured from the repaint request to the layer tree update that
+  // reflects it. Used to decide how far the displayport is pushed in the
+  // direction of travel. Protected by |mRecursiveMutex|.
+  float mEstimatedPaintDurationMs;
   // The metrics that we expect content to have. This is updated when we
   // request a content repaint, and when we receive a shadow layers update.
   // This allows us to transform events into Gecko's coordinate space.
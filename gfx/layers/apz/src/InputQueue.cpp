@@ -83,6 +83,21 @@ nsEventStatus InputQueue::ReceiveInputEvent(
   }
 }
 
+// Returns true if the two events carry the same set of touch points, in the
+// same order, so that folding one into the other is well-defined.
+static bool HaveMatchingPointers(const MultiTouchInput& aFirst,
+                                 const MultiTouchInput& aSecond) {
+  if (aFirst.mTouches.Length() != aSecond.mTouches.Length()) {
+    return false;
+  }
+  for (size_t i = 0; i < aFirst.mTouches.Length(); ++i) {
+    if (aFirst.mTouches[i].mIdentifier != aSecond.mTouches[i].mIdentifier) {
+      return false;
+    }
+  }
+  return true;
+}
+
 nsEventStatus InputQueue::ReceiveTouchInput(
     const RefPtr<AsyncPanZoomController>& aTarget,
     TargetConfirmationFlags aFlags, const MultiTouchInput& aEvent,
@@ -206,7 +221,40 @@ nsEventStatus InputQueue::ReceiveTouchInput(
     INPQ_LOG("dropping event due to block %p being in mini-slop\n", block);
     result = nsEventStatus_eConsumeNoDefault;
   }
-  mQueuedInputs.AppendElement(MakeUnique<QueuedInput>(aEvent, *block));
+
+  // While the block is waiting for a content response or target confirmation,
+  // touch-move events can pile up here faster than the queue drains, and once
+  // the block is ready each queued move gets a full APZC sample even though
+  // all but the last position is stale. Fold consecutive moves from the same
+  // block into a single event instead; the folded-away samples are preserved
+  // as historical data so velocity tracking still sees them.
+  bool coalesced = false;
+  if (aEvent.mType == MultiTouchInput::MULTITOUCH_MOVE &&
+      !mQueuedInputs.IsEmpty() &&
+      mQueuedInputs.LastElement()->Block() == block &&
+      mQueuedInputs.LastElement()->Input()->mInputType == MULTITOUCH_INPUT) {
+    const MultiTouchInput& prev =
+        mQueuedInputs.LastElement()->Input()->AsMultiTouchInput();
+    if (prev.mType == MultiTouchInput::MULTITOUCH_MOVE &&
+        HaveMatchingPointers(prev, aEvent)) {
+      MultiTouchInput fused = aEvent;
+      for (size_t i = 0; i < fused.mTouches.Length(); ++i) {
+        SingleTouchData& touch = fused.mTouches[i];
+        const SingleTouchData& prevTouch = prev.mTouches[i];
+        touch.mHistoricalData.InsertElementAt(
+            0, SingleTouchData::HistoricalTouchData{
+                   prev.mTimeStamp, prevTouch.mScreenPoint,
+                   prevTouch.mLocalScreenPoint, prevTouch.mRadius,
+                   prevTouch.mRotationAngle, prevTouch.mForce});
+        touch.mHistoricalData.InsertElementsAt(0, prevTouch.mHistoricalData);
+      }
+      mQueuedInputs.LastElement() = MakeUnique<QueuedInput>(fused, *block);
+      coalesced = true;
+    }
+  }
+  if (!coalesced) {
+    mQueuedInputs.AppendElement(MakeUnique<QueuedInput>(aEvent, *block));
+  }
   ProcessQueue();
 
   // If this block just started and is waiting for a content response, but
@@ -42,6 +42,7 @@
 #include "nsISerialEventTarget.h"
 #include "nsISupportsImpl.h"  // for MOZ_COUNT_CTOR, etc
 #include "nsPrintfCString.h"  // for nsPrintfCString
+#include "prthread.h"         // for PR_Sleep
 
 #ifdef XP_WIN
 #  include "gfx2DGlue.h"
@@ -1628,6 +1629,61 @@ class CrossProcessSemaphoreReadLock : public TextureReadLock {
   bool mShared;
 };
 
+// A blocking read lock with a syscall-free uncontended path.
+//
+// The content side stamps the shared "submitted" epoch when the texture is
+// forwarded to the compositor, and the compositor publishes the "retired"
+// epoch once it is done reading. The texture is writable again when the two
+// epochs match, so in the common case where the compositor has already moved
+// on, TryReadLock is a pair of loads from shared memory rather than a
+// semaphore wait, and the compositor retires with a plain atomic increment
+// rather than a signal. Only a contended TryReadLock has to sleep while it
+// polls for the compositor to catch up.
+//
+// The refCount field keeps the shmem section alive until both sides have
+// dropped their lock object, since the compositor may publish the retired
+// epoch after the content side has already abandoned the texture.
+class EpochTextureReadLock : public TextureReadLock {
+ public:
+  struct EpochReadLockInfo {
+    int32_t submitted;
+    int32_t retired;
+    int32_t refCount;
+  };
+
+  explicit EpochTextureReadLock(LayersIPCChannel* aAllocator);
+
+  // Used on the compositor side.
+  explicit EpochTextureReadLock(
+      const mozilla::layers::ShmemSection& aShmemSection)
+      : mShmemSection(aShmemSection), mAllocSuccess(true) {
+    MOZ_COUNT_CTOR(EpochTextureReadLock);
+  }
+
+  virtual ~EpochTextureReadLock();
+
+  bool ReadLock() override;
+
+  bool TryReadLock(TimeDuration aTimeout) override;
+
+  int32_t ReadUnlock() override;
+
+  bool IsValid() const override { return mAllocSuccess; };
+
+  LockType GetType() override { return TYPE_CROSS_PROCESS_EPOCH; }
+
+  bool Serialize(ReadLockDescriptor& aOutput, base::ProcessId aOther) override;
+
+  EpochReadLockInfo* GetEpochReadLockInfoPtr() {
+    return reinterpret_cast<EpochReadLockInfo*>(
+        mShmemSection.shmem().get<char>() + mShmemSection.offset());
+  }
+
+  RefPtr<LayersIPCChannel> mClientAllocator;
+  mozilla::layers::ShmemSection mShmemSection;
+  bool mAllocSuccess;
+};
+
 // static
 already_AddRefed<TextureReadLock> TextureReadLock::Deserialize(
     const ReadLockDescriptor& aDescriptor, ISurfaceAllocator* aAllocator) {
@@ -1661,6 +1717,12 @@ already_AddRefed<TextureReadLock> TextureReadLock::Deserialize(
       return MakeAndAddRef<CrossProcessSemaphoreReadLock>(
           aDescriptor.get_CrossProcessSemaphoreDescriptor().sem());
     }
+    case ReadLockDescriptor::TEpochReadLockDescriptor: {
+      const ShmemSection& section =
+          aDescriptor.get_EpochReadLockDescriptor().section();
+      MOZ_RELEASE_ASSERT(section.shmem().IsReadable());
+      return MakeAndAddRef<EpochTextureReadLock>(section);
+    }
     case ReadLockDescriptor::Tnull_t: {
       return nullptr;
     }
@@ -1789,6 +1851,95 @@ int32_t ShmemTextureReadLock::GetReadCount() {
   return info->readCount;
 }
 
+EpochTextureReadLock::EpochTextureReadLock(LayersIPCChannel* aAllocator)
+    : mClientAllocator(aAllocator), mAllocSuccess(false) {
+  MOZ_COUNT_CTOR(EpochTextureReadLock);
+  MOZ_ASSERT(mClientAllocator);
+  MOZ_ASSERT(mClientAllocator->GetTileLockAllocator());
+  if (mClientAllocator->GetTileLockAllocator()->AllocShmemSection(
+          MOZ_ALIGN_WORD(sizeof(EpochReadLockInfo)), &mShmemSection)) {
+    EpochReadLockInfo* info = GetEpochReadLockInfoPtr();
+    info->submitted = 0;
+    info->retired = 0;
+    info->refCount = 1;
+    mAllocSuccess = true;
+  }
+}
+
+EpochTextureReadLock::~EpochTextureReadLock() {
+  if (mAllocSuccess) {
+    EpochReadLockInfo* info = GetEpochReadLockInfoPtr();
+    if (PR_ATOMIC_DECREMENT(&info->refCount) == 0) {
+      if (mClientAllocator && mClientAllocator->GetTileLockAllocator()) {
+        mClientAllocator->GetTileLockAllocator()->DeallocShmemSection(
+            mShmemSection);
+      } else {
+        // we are on the compositor process, or IPC is down.
+        FixedSizeSmallShmemSectionAllocator::FreeShmemSection(mShmemSection);
+      }
+    }
+  }
+  MOZ_COUNT_DTOR(EpochTextureReadLock);
+}
+
+bool EpochTextureReadLock::Serialize(ReadLockDescriptor& aOutput,
+                                     base::ProcessId aOther) {
+  if (!mAllocSuccess) {
+    return false;
+  }
+  // The reference is dropped by the compositor-side lock's destructor.
+  EpochReadLockInfo* info = GetEpochReadLockInfoPtr();
+  PR_ATOMIC_INCREMENT(&info->refCount);
+  aOutput = ReadLockDescriptor(EpochReadLockDescriptor(mShmemSection));
+  return true;
+}
+
+bool EpochTextureReadLock::ReadLock() {
+  // Called on the content side when the texture is forwarded to the
+  // compositor: stamp the new submitted epoch. The texture stays locked until
+  // the compositor publishes a matching retired epoch in ReadUnlock().
+  if (!mAllocSuccess) {
+    return false;
+  }
+  EpochReadLockInfo* info = GetEpochReadLockInfoPtr();
+  PR_ATOMIC_INCREMENT(&info->submitted);
+  return true;
+}
+
+bool EpochTextureReadLock::TryReadLock(TimeDuration aTimeout) {
+  if (!mAllocSuccess) {
+    return false;
+  }
+  EpochReadLockInfo* info = GetEpochReadLockInfoPtr();
+  if (info->retired == info->submitted) {
+    return true;
+  }
+  // The compositor is still reading our last submission; poll for it to
+  // publish the retired epoch. This is the only path that sleeps.
+  const TimeStamp deadline = TimeStamp::Now() + aTimeout;
+  do {
+    PR_Sleep(PR_MillisecondsToInterval(1));
+    if (info->retired == info->submitted) {
+      return true;
+    }
+  } while (TimeStamp::Now() < deadline);
+  return false;
+}
+
+int32_t EpochTextureReadLock::ReadUnlock() {
+  if (!mAllocSuccess) {
+    return 1;
+  }
+  if (mClientAllocator) {
+    // On the content side TryReadLock doesn't take a token, so there is
+    // nothing to give back; retirement is published by the compositor.
+    return 1;
+  }
+  EpochReadLockInfo* info = GetEpochReadLockInfoPtr();
+  PR_ATOMIC_INCREMENT(&info->retired);
+  return 1;
+}
+
 bool CrossProcessSemaphoreReadLock::Serialize(ReadLockDescriptor& aOutput,
                                               base::ProcessId aOther) {
   if (!mShared && IsValid()) {
@@ -1804,6 +1955,17 @@ bool CrossProcessSemaphoreReadLock::Serialize(ReadLockDescriptor& aOutput,
 
 void TextureClient::EnableBlockingReadLock() {
   if (!mReadLock) {
+    if (!mAllocator->IsSameProcess() && mAllocator->GetTileLockAllocator()) {
+      // Prefer the epoch lock cross-process: checking it is a pair of loads
+      // from shared memory, so the steady-state paint and composite loops
+      // don't pay a semaphore syscall per texture per frame.
+      RefPtr<EpochTextureReadLock> lock =
+          new EpochTextureReadLock(mAllocator);
+      if (lock->IsValid()) {
+        mReadLock = lock;
+        return;
+      }
+    }
     mReadLock = new CrossProcessSemaphoreReadLock();
   }
 }
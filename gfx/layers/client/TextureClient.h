@@ -203,7 +203,8 @@ class TextureReadLock {
   enum LockType {
     TYPE_NONBLOCKING_MEMORY,
     TYPE_NONBLOCKING_SHMEM,
-    TYPE_CROSS_PROCESS_SEMAPHORE
+    TYPE_CROSS_PROCESS_SEMAPHORE,
+    TYPE_CROSS_PROCESS_EPOCH
   };
   virtual LockType GetType() = 0;
 
@@ -2081,7 +2081,20 @@ void WebRenderBridgeParent::MaybeGenerateFrame(VsyncId aId,
   wr::TransactionBuilder sceneBuilderTxn;
   wr::AutoTransactionSender sender(mApi, &sceneBuilderTxn);
 
-  mAsyncImageManager->SetCompositionInfo(start, mCompositionOpportunityId);
+  // Pick video frames against the estimated display time of this composite
+  // rather than the time we started generating it. The two differ by at
+  // least a vsync interval, which is enough to select the previous frame of
+  // a video whose frame rate matches the display refresh rate.
+  TimeStamp presentTime = start;
+  if (mCompositorScheduler) {
+    const TimeStamp& outputTime =
+        mCompositorScheduler->GetLastVsyncOutputTime();
+    if (outputTime > presentTime) {
+      presentTime = outputTime;
+    }
+  }
+
+  mAsyncImageManager->SetCompositionInfo(presentTime, mCompositionOpportunityId);
   mAsyncImageManager->ApplyAsyncImagesOfImageBridge(sceneBuilderTxn, fastTxn);
   mAsyncImageManager->SetCompositionInfo(TimeStamp(),
                                          CompositionOpportunityId{});
@@ -715,3 +715,7 @@ void nsDeviceContext::UnregisterPageDoneCallback() {
     mPrintTarget->UnregisterPageDoneCallback();
   }
 }
+
+bool nsDeviceContext::IsOffMainThreadPrintingSafe() const {
+  return mPrintTarget && mPrintTarget->IsOffMainThreadReplaySafe();
+}
@@ -267,6 +267,12 @@ class nsDeviceContext final {
   void RegisterPageDoneCallback(PrintTarget::PageDoneCallback&& aCallback);
   void UnregisterPageDoneCallback();
 
+  /**
+   * True if this device's pages can be rendered and serialized away from the
+   * main thread (see PrintTarget::IsOffMainThreadReplaySafe).
+   */
+  bool IsOffMainThreadPrintingSafe() const;
+
  private:
   // Private destructor, to discourage deletion outside of Release():
   ~nsDeviceContext();
@@ -141,6 +141,14 @@ class PrintTarget {
   void RegisterPageDoneCallback(PageDoneCallback&& aCallback);
   void UnregisterPageDoneCallback();
 
+  /**
+   * Returns true if it is safe to drive this target's page rendering and
+   * serialization from a thread other than the main thread (one thread at a
+   * time).  Targets that only write to a stream or file qualify; targets
+   * that wrap thread-affine OS printing handles do not.
+   */
+  virtual bool IsOffMainThreadReplaySafe() const { return false; }
+
   static void AdjustPrintJobNameForIPP(const nsAString& aJobName,
                                        nsCString& aAdjustedJobName);
   static void AdjustPrintJobNameForIPP(const nsAString& aJobName,
@@ -24,6 +24,10 @@ class PrintTargetPDF final : public PrintTarget {
   nsresult EndPage() override;
   void Finish() override;
 
+  // The cairo PDF surface only writes to mStream (a file stream in
+  // practice), so pages can be serialized off the main thread.
+  bool IsOffMainThreadReplaySafe() const final { return true; }
+
  private:
   PrintTargetPDF(cairo_surface_t* aCairoSurface, const IntSize& aSize,
                  nsIOutputStream* aStream);
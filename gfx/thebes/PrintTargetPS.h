@@ -30,6 +30,10 @@ class PrintTargetPS final : public PrintTarget {
   nsresult EndPage() override;
   void Finish() override;
 
+  // The cairo PS surface only writes to mStream (the spool file stream), so
+  // pages can be serialized off the main thread.
+  bool IsOffMainThreadReplaySafe() const final { return true; }
+
   bool GetRotateForLandscape() { return (mOrientation == LANDSCAPE); }
 
  private:
@@ -41,6 +41,10 @@ class PrintTargetSkPDF final : public PrintTarget {
 
   already_AddRefed<DrawTarget> GetReferenceDrawTarget() final;
 
+  // We only write to an SkWStream, so pages can be serialized off the main
+  // thread.
+  bool IsOffMainThreadReplaySafe() const final { return true; }
+
  private:
   PrintTargetSkPDF(const IntSize& aSize, UniquePtr<SkWStream> aStream);
   virtual ~PrintTargetSkPDF();
@@ -11,9 +11,11 @@
 #include "gfxDWriteFontList.h"
 #include "gfxDWriteFonts.h"
 #include "nsUnicharUtils.h"
+#include "nsReadableUtils.h"
 #include "nsServiceManagerUtils.h"
 #include "nsCharSeparatedTokenizer.h"
 #include "mozilla/Preferences.h"
+#include "mozilla/scache/StartupCache.h"
 #include "mozilla/Sprintf.h"
 #include "mozilla/Telemetry.h"
 #include "nsDirectoryServiceUtils.h"
@@ -43,6 +45,17 @@ using mozilla::intl::OSPreferences;
 #define LOG_CMAPDATA_ENABLED() \
   MOZ_LOG_TEST(gfxPlatform::GetLog(eGfxLog_cmapdata), LogLevel::Debug)
 
+// StartupCache entry holding the most recent system font-family list, so
+// that a warm startup can skip enumerating the localized names of every
+// family in the DirectWrite system collection.
+#define FAMILY_LIST_CACHE_KEY "font.dwrite-family-list"
+
+// Delimiters used in the cached family-list records; the same control
+// characters the FT2 font-list cache uses, as they cannot occur in family
+// names.
+static const char kFamilyListRecordSep = 0x1e;
+static const char kFamilyListFieldSep = 0x1f;
+
 static __inline void BuildKeyNameFromFontName(nsACString& aName) {
   ToLowerCase(aName);
 }
@@ -1459,6 +1472,110 @@ enum DWriteInitError {
   errNoFonts = 3
 };
 
+bool gfxDWriteFontList::LoadFamilyListFromCache(
+    nsTArray<fontlist::Family::InitData>& aFamilies,
+    const nsACString& aValidationKey) {
+  auto* cache = mozilla::scache::StartupCache::GetSingleton();
+  if (!cache) {
+    return false;
+  }
+
+  uint32_t size;
+  const char* cur;
+  if (NS_FAILED(cache->GetBuffer(FAMILY_LIST_CACHE_KEY, &cur, &size)) ||
+      !size) {
+    return false;
+  }
+
+  // The first record is the validation key the list was saved under; if it
+  // doesn't match, the collection (or a pref it depends on) has changed, and
+  // the list must be rebuilt by enumeration.
+  const char* recEnd = strchr(cur, kFamilyListRecordSep);
+  if (!recEnd || !aValidationKey.Equals(nsDependentCSubstring(cur, recEnd))) {
+    return false;
+  }
+  cur = recEnd + 1;
+
+  while ((recEnd = strchr(cur, kFamilyListRecordSep))) {
+    // Returns the end of the field starting at aStart, terminated by the
+    // field separator or the end of the record.
+    auto endOfField = [=](const char* aStart) -> const char* {
+      const char* end = static_cast<const char*>(
+          memchr(aStart, kFamilyListFieldSep, recEnd - aStart));
+      return end ? end : recEnd;
+    };
+
+    const char* end = endOfField(cur);
+    nsDependentCSubstring key(cur, end);
+    if (end == recEnd) {
+      return false;
+    }
+    cur = end + 1;
+    end = endOfField(cur);
+    nsDependentCSubstring name(cur, end);
+    if (end == recEnd) {
+      return false;
+    }
+    cur = end + 1;
+    uint32_t index = strtoul(cur, nullptr, 10);
+    end = endOfField(cur);
+    if (end == recEnd) {
+      return false;
+    }
+    cur = end + 1;
+    uint32_t visibility = strtoul(cur, nullptr, 10);
+    end = endOfField(cur);
+    if (end == recEnd) {
+      return false;
+    }
+    cur = end + 1;
+    uint32_t flags = strtoul(cur, nullptr, 10);
+
+    if (key.IsEmpty() || name.IsEmpty()) {
+      return false;
+    }
+
+    aFamilies.AppendElement(fontlist::Family::InitData(
+        key, name, index, FontVisibility(visibility), /* aBundled */ false,
+        !!(flags & 1), !!(flags & 2), !!(flags & 4)));
+
+    cur = recEnd + 1;
+  }
+
+  return !aFamilies.IsEmpty();
+}
+
+void gfxDWriteFontList::SaveFamilyListToCache(
+    const nsTArray<fontlist::Family::InitData>& aFamilies,
+    const nsACString& aValidationKey) {
+  auto* cache = mozilla::scache::StartupCache::GetSingleton();
+  if (!cache) {
+    return;
+  }
+
+  nsAutoCString buf;
+  buf.Append(aValidationKey);
+  buf.Append(kFamilyListRecordSep);
+
+  for (const auto& family : aFamilies) {
+    buf.Append(family.mKey);
+    buf.Append(kFamilyListFieldSep);
+    buf.Append(family.mName);
+    buf.Append(kFamilyListFieldSep);
+    buf.AppendInt(family.mIndex);
+    buf.Append(kFamilyListFieldSep);
+    buf.AppendInt(uint32_t(family.mVisibility));
+    buf.Append(kFamilyListFieldSep);
+    buf.AppendInt(uint32_t(family.mBadUnderline ? 1 : 0) |
+                  (family.mForceClassic ? 2 : 0) |
+                  (family.mAltLocale ? 4 : 0));
+    buf.Append(kFamilyListRecordSep);
+  }
+
+  cache->PutBuffer(FAMILY_LIST_CACHE_KEY, UniquePtr<char[]>(ToNewCString(buf)),
+                   buf.Length() + 1);
+}
+
 void gfxDWriteFontList::InitSharedFontListForPlatform() {
   mGDIFontTableAccess = Preferences::GetBool(
       "gfx.font_rendering.directwrite.use_gdi_table_loading", false);
@@ -1505,7 +1622,26 @@ void gfxDWriteFontList::InitSharedFontListForPlatform() {
       forceClassicFams.Sort();
     }
     nsTArray<fontlist::Family::InitData> families;
-    AppendFamiliesFromCollection(mSystemFonts, families, &forceClassicFams);
+
+    // Validation key for the cached family list: if the system collection's
+    // family count, the system locale, or the GDI-classic families pref has
+    // changed, the cached list is considered stale and the collection is
+    // enumerated again. Stale family indices surviving this check are
+    // tolerated by the name-based fallbacks in CreateFontEntry.
+    nsAutoCString locale;
+    OSPreferences::GetInstance()->GetSystemLocale(locale);
+    nsAutoCString validationKey;
+    validationKey.AppendInt(mSystemFonts->GetFontFamilyCount());
+    validationKey.Append(':');
+    validationKey.Append(locale);
+    validationKey.Append(':');
+    validationKey.Append(classicFamilies);
+
+    if (!LoadFamilyListFromCache(families, validationKey)) {
+      families.Clear();
+      AppendFamiliesFromCollection(mSystemFonts, families, &forceClassicFams);
+      SaveFamilyListToCache(families, validationKey);
+    }
 #ifdef MOZ_BUNDLED_FONTS
     if (mBundledFonts) {
       AppendFamiliesFromCollection(mBundledFonts, families);
@@ -452,6 +452,18 @@ class gfxDWriteFontList final : public gfxPlatformFontList {
       nsTArray<mozilla::fontlist::Family::InitData>& aFamilies,
       const nsTArray<nsCString>* aForceClassicFams = nullptr);
 
+  // Loads the system font-family list from the startup cache, if the cached
+  // copy is still valid per aValidationKey. Returns false (leaving aFamilies
+  // in an unspecified state) if the families must be re-enumerated from the
+  // system collection.
+  bool LoadFamilyListFromCache(
+      nsTArray<mozilla::fontlist::Family::InitData>& aFamilies,
+      const nsACString& aValidationKey);
+
+  void SaveFamilyListToCache(
+      const nsTArray<mozilla::fontlist::Family::InitData>& aFamilies,
+      const nsACString& aValidationKey);
+
 #ifdef MOZ_BUNDLED_FONTS
   already_AddRefed<IDWriteFontCollection> CreateBundledFontsCollection(
       IDWriteFactory* aFactory);
@@ -95,7 +95,7 @@ uint32_t gGlyphExtentsSetupFallBackToTight = 0;
  * gfxFontCache - global cache of gfxFont instances.
  * Expires unused fonts after a short interval;
  * notifies fonts to age their cached shaped-word records;
- * observes memory-pressure notification and tells fonts to clear their
+ * observes memory-pressure notification and tells fonts to trim their
  * shaped-word caches to free up memory.
  */
 
@@ -137,7 +137,10 @@ gfxFontCache::Observer::Observe(nsISupports* aSubject, const char* aTopic,
   if (!nsCRT::strcmp(aTopic, "memory-pressure")) {
     gfxFontCache* fontCache = gfxFontCache::GetCache();
     if (fontCache) {
-      fontCache->FlushShapedWordCaches();
+      // Discard aged shaped words but keep the actively-used hot set;
+      // dropping everything just forces each process to immediately
+      // re-shape the UI and body text it is still displaying.
+      fontCache->TrimShapedWordCaches();
     }
   } else {
     MOZ_ASSERT_UNREACHABLE("unexpected notification topic");
@@ -303,6 +306,12 @@ void gfxFontCache::FlushShapedWordCaches() {
   }
 }
 
+void gfxFontCache::TrimShapedWordCaches() {
+  for (auto it = mFonts.Iter(); !it.Done(); it.Next()) {
+    it.Get()->mFont->TrimCachedWords();
+  }
+}
+
 void gfxFontCache::NotifyGlyphsChanged() {
   for (auto it = mFonts.Iter(); !it.Done(); it.Next()) {
     it.Get()->mFont->NotifyGlyphsChanged();
@@ -2701,6 +2710,17 @@ void gfxFont::AgeCachedWords() {
   }
 }
 
+void gfxFont::TrimCachedWords() {
+  if (mWordCache) {
+    for (auto it = mWordCache->Iter(); !it.Done(); it.Next()) {
+      CacheHashEntry* entry = it.Get();
+      if (!entry->mShapedWord || entry->mShapedWord->GetAge() > 0) {
+        it.Remove();
+      }
+    }
+  }
+}
+
 void gfxFont::NotifyGlyphsChanged() {
   uint32_t i, count = mGlyphExtentsArray.Length();
   for (i = 0; i < count; ++i) {
@@ -2736,12 +2756,19 @@ gfxShapedWord* gfxFont::GetShapedWord(
     Script aRunScript, nsAtom* aLanguage, bool aVertical,
     int32_t aAppUnitsPerDevUnit, gfx::ShapedTextFlags aFlags,
     RoundingFlags aRounding, gfxTextPerfMetrics* aTextPerf GFX_MAYBE_UNUSED) {
-  // if the cache is getting too big, flush it and start over
+  // If the cache is getting too big, first evict words that haven't been
+  // looked up since the last aging pass; words the page is actively using
+  // have age zero and survive, so a busy page doesn't lose its whole working
+  // set and re-shape it. Only flush wholesale if that doesn't get us back
+  // under the limit.
   uint32_t wordCacheMaxEntries =
       gfxPlatform::GetPlatform()->WordCacheMaxEntries();
   if (mWordCache->Count() > wordCacheMaxEntries) {
-    NS_WARNING("flushing shaped-word cache");
-    ClearCachedWords();
+    TrimCachedWords();
+    if (mWordCache->Count() > wordCacheMaxEntries) {
+      NS_WARNING("flushing shaped-word cache");
+      ClearCachedWords();
+    }
   }
 
   // if there's a cached entry for this word, just return it
@@ -338,6 +338,7 @@ class gfxFontCache final : private gfxFontCacheExpirationTracker {
   }
 
   void FlushShapedWordCaches();
+  void TrimShapedWordCaches();
   void NotifyGlyphsChanged();
 
   void AddSizeOfExcludingThis(mozilla::MallocSizeOf aMallocSizeOf,
@@ -1319,6 +1320,7 @@ class gfxShapedWord final : public gfxShapedText {
 
   void ResetAge() { mAgeCounter = 0; }
   uint32_t IncrementAge() { return ++mAgeCounter; }
+  uint32_t GetAge() const { return mAgeCounter; }
 
   // Helper used when hashing a word for the shaped-word caches
   static uint32_t HashMix(uint32_t aHash, char16_t aCh) {
@@ -1808,13 +1810,19 @@ class gfxFont {
   // so that they'll expire after a sufficient period of non-use
   void AgeCachedWords();
 
-  // Discard all cached word records; called on memory-pressure notification.
+  // Discard all cached word records; called when the font list is rebuilt
+  // or the font is about to be destroyed.
   void ClearCachedWords() {
     if (mWordCache) {
       mWordCache->Clear();
     }
   }
 
+  // Discard cached word records not used since the last aging pass, keeping
+  // the actively-used hot set; called on memory-pressure notification so
+  // that text currently on screen does not have to be re-shaped.
+  void TrimCachedWords();
+
   // Glyph rendering/geometry has changed, so invalidate data as necessary.
   void NotifyGlyphsChanged();
 
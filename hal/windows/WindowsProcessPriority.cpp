@@ -4,9 +4,26 @@
 
 #include "Hal.h"
 #include "HalLog.h"
+#include "mozilla/StaticPrefs_dom.h"
 
 #include <windows.h>
 
+// These definitions are only available in newer SDKs. The process information
+// class is an enumerator, so define our own constant unconditionally.
+#ifndef PROCESS_POWER_THROTTLING_CURRENT_VERSION
+#  define PROCESS_POWER_THROTTLING_CURRENT_VERSION 1
+#  define PROCESS_POWER_THROTTLING_EXECUTION_SPEED 0x1
+
+typedef struct _PROCESS_POWER_THROTTLING_STATE {
+  ULONG Version;
+  ULONG ControlMask;
+  ULONG StateMask;
+} PROCESS_POWER_THROTTLING_STATE, *PPROCESS_POWER_THROTTLING_STATE;
+#endif
+
+static const PROCESS_INFORMATION_CLASS kProcessPowerThrottling =
+    static_cast<PROCESS_INFORMATION_CLASS>(4);
+
 using namespace mozilla::hal;
 
 namespace mozilla {
@@ -35,6 +52,32 @@ void SetProcessPriority(int aPid, ProcessPriority aPriority) {
       priority = BELOW_NORMAL_PRIORITY_CLASS;
     }
     ::SetPriorityClass(processHandle, priority);
+
+    if (StaticPrefs::dom_ipc_processPriorityManager_backgroundUsesEcoQoS()) {
+      // In addition to the priority class, ask the scheduler to run fully
+      // backgrounded processes in efficiency mode ("EcoQoS"), which prefers
+      // efficiency cores on heterogeneous CPUs and lower clocks elsewhere.
+      // This fails harmlessly on versions of Windows without EcoQoS support.
+      // SetProcessInformation is a Windows 8 export, so look it up at runtime
+      // rather than taking a load-time dependency on it.
+      typedef BOOL(WINAPI * SetProcessInformationType)(
+          HANDLE, PROCESS_INFORMATION_CLASS, LPVOID, DWORD);
+      static const auto setProcessInformation =
+          reinterpret_cast<SetProcessInformationType>(::GetProcAddress(
+              ::GetModuleHandleW(L"kernel32.dll"), "SetProcessInformation"));
+      if (setProcessInformation) {
+        PROCESS_POWER_THROTTLING_STATE throttlingState;
+        ZeroMemory(&throttlingState, sizeof(throttlingState));
+        throttlingState.Version = PROCESS_POWER_THROTTLING_CURRENT_VERSION;
+        throttlingState.ControlMask = PROCESS_POWER_THROTTLING_EXECUTION_SPEED;
+        throttlingState.StateMask =
+            aPriority == PROCESS_PRIORITY_BACKGROUND
+                ? PROCESS_POWER_THROTTLING_EXECUTION_SPEED
+                : 0;
+        setProcessInformation(processHandle, kProcessPowerThrottling,
+                              &throttlingState, sizeof(throttlingState));
+      }
+    }
   }
 
   HAL_LOG("WindowsProcessPriority - priority set to %d for pid %d\n", aPriority,
@@ -7,13 +7,141 @@
 
 #include <utility>  // for Move
 
+#include "mozilla/Compression.h"
+
 namespace mozilla {
 namespace image {
 
+/**
+ * An LZ4-compressed copy of the pixels of a finished frame, along with enough
+ * metadata to recreate an equivalent imgFrame. Decoded frame buffers are
+ * tightly packed, so the compressed data can be inflated directly into a new
+ * frame's buffer.
+ */
+class AnimationFrameRetainedBuffer::CompressedFrame final {
+ public:
+  /**
+   * Compress the pixels of the given finished frame. Returns null if the
+   * frame's data is inaccessible or incompressible; in that case the caller
+   * should just keep the original frame.
+   */
+  static UniquePtr<CompressedFrame> Create(imgFrame* aFrame,
+                                           uint32_t aFrameNum) {
+    MOZ_ASSERT(aFrame);
+
+    RawAccessFrameRef ref = aFrame->RawAccessRef(/* aOnlyFinished */ true);
+    if (!ref) {
+      return nullptr;
+    }
+
+    uint8_t* data = nullptr;
+    uint32_t length = 0;
+    ref->GetImageData(&data, &length);
+    if (!data || length == 0) {
+      return nullptr;
+    }
+
+    nsTArray<uint8_t> buffer;
+    if (!buffer.SetLength(Compression::LZ4::maxCompressedSize(length),
+                          fallible)) {
+      return nullptr;
+    }
+
+    size_t written =
+        Compression::LZ4::compress(reinterpret_cast<const char*>(data), length,
+                                   reinterpret_cast<char*>(buffer.Elements()));
+    if (written == 0 || written >= length) {
+      // The frame is incompressible. Paying the cost of decompression on every
+      // loop would gain us nothing, so keep the original.
+      return nullptr;
+    }
+
+    buffer.TruncateLength(written);
+    buffer.Compact();
+
+    AnimationParams animParams{ref->GetBlendRect(), ref->GetTimeout(),
+                               aFrameNum, ref->GetBlendMethod(),
+                               ref->GetDisposalMethod()};
+    gfx::SurfaceFormat format = ref->FormatHasAlpha()
+                                    ? gfx::SurfaceFormat::OS_RGBA
+                                    : gfx::SurfaceFormat::OS_RGBX;
+    return UniquePtr<CompressedFrame>(
+        new CompressedFrame(ref->GetRect().Size(), format, animParams,
+                            ref->GetDirtyRect(), length, std::move(buffer)));
+  }
+
+  /// Recreate the frame by decompressing into a new imgFrame.
+  already_AddRefed<imgFrame> Inflate() const {
+    RefPtr<imgFrame> frame = new imgFrame();
+    nsresult rv = frame->InitForDecoder(mSize, mFormat, /* aNonPremult */ false,
+                                        Some(mAnimParams),
+                                        /* aShouldRecycle */ false);
+    if (NS_FAILED(rv)) {
+      return nullptr;
+    }
+
+    RawAccessFrameRef ref = frame->RawAccessRef();
+    if (!ref) {
+      frame->Abort();
+      return nullptr;
+    }
+
+    uint8_t* data = nullptr;
+    uint32_t length = 0;
+    ref->GetImageData(&data, &length);
+
+    size_t outputSize = 0;
+    if (!data || length != mUncompressedLength ||
+        !Compression::LZ4::decompress(
+            reinterpret_cast<const char*>(mData.Elements()), mData.Length(),
+            reinterpret_cast<char*>(data), length, &outputSize) ||
+        outputSize != length) {
+      frame->Abort();
+      return nullptr;
+    }
+
+    // Match what Decoder does for animated frames: the frame must remain
+    // accessible so that it may be compressed again after it is displayed.
+    frame->SetRawAccessOnly();
+    frame->ImageUpdated(frame->GetRect());
+    frame->SetDirtyRect(mDirtyRect);
+    frame->Finish(mFormat == gfx::SurfaceFormat::OS_RGBA
+                      ? Opacity::SOME_TRANSPARENCY
+                      : Opacity::FULLY_OPAQUE);
+    return frame.forget();
+  }
+
+  size_t SizeOfExcludingThis(MallocSizeOf aMallocSizeOf) const {
+    return mData.ShallowSizeOfExcludingThis(aMallocSizeOf);
+  }
+
+ private:
+  CompressedFrame(const gfx::IntSize& aSize, gfx::SurfaceFormat aFormat,
+                  const AnimationParams& aAnimParams,
+                  const gfx::IntRect& aDirtyRect, uint32_t aUncompressedLength,
+                  nsTArray<uint8_t>&& aData)
+      : mSize(aSize),
+        mFormat(aFormat),
+        mAnimParams(aAnimParams),
+        mDirtyRect(aDirtyRect),
+        mUncompressedLength(aUncompressedLength),
+        mData(std::move(aData)) {}
+
+  const gfx::IntSize mSize;
+  const gfx::SurfaceFormat mFormat;
+  const AnimationParams mAnimParams;
+  const gfx::IntRect mDirtyRect;
+  const uint32_t mUncompressedLength;
+  nsTArray<uint8_t> mData;
+};
+
 AnimationFrameRetainedBuffer::AnimationFrameRetainedBuffer(size_t aThreshold,
                                                            size_t aBatch,
-                                                           size_t aStartFrame)
-    : AnimationFrameBuffer(aBatch, aStartFrame), mThreshold(aThreshold) {
+                                                           size_t aStartFrame,
+                                                           bool aCompressInactive)
+    : AnimationFrameBuffer(aBatch, aStartFrame),
+      mThreshold(aThreshold),
+      mCompressInactive(aCompressInactive) {
   // To simplify the code, we have the assumption that the threshold for
   // entering discard-after-display mode is at least twice the batch size (since
   // that is the most frames-pending-decode we will request) + 1 for the current
@@ -31,6 +159,10 @@ AnimationFrameRetainedBuffer::AnimationFrameRetainedBuffer(size_t aThreshold,
   mPending = mBatch * 2;
 }
 
+// Defined here so that CompressedFrame is a complete type for mCompressed's
+// destructor.
+AnimationFrameRetainedBuffer::~AnimationFrameRetainedBuffer() = default;
+
 bool AnimationFrameRetainedBuffer::InsertInternal(RefPtr<imgFrame>&& aFrame) {
   // We should only insert new frames if we actually asked for them.
   MOZ_ASSERT(!mSizeKnown);
@@ -63,6 +195,14 @@ bool AnimationFrameRetainedBuffer::MarkComplete(
   mSizeKnown = true;
   mPending = 0;
   mFrames.Compact();
+
+  // Now that no more frames will be inserted, and we can no longer switch to a
+  // discarding queue, we may begin replacing inactive frames with compressed
+  // copies.
+  if (mCompressInactive) {
+    mCompressed.SetLength(mFrames.Length());
+    MaybeCompressFrames();
+  }
   return false;
 }
 
@@ -90,9 +230,58 @@ void AnimationFrameRetainedBuffer::AdvanceInternal() {
       // do not have any pending, then we know that there is no active decoding.
       mPending += mBatch;
     }
+  } else if (mCompressInactive) {
+    MaybeCompressFrames();
   }
 }
 
+void AnimationFrameRetainedBuffer::MaybeCompressFrames() {
+  MOZ_ASSERT(mCompressInactive);
+  MOZ_ASSERT(mSizeKnown);
+  MOZ_ASSERT(mCompressed.Length() == mFrames.Length());
+
+  // Keep the current frame and its immediate neighbours uncompressed, as well
+  // as the first frame. The next frame is about to be displayed, the previous
+  // frame may still be held by the compositor, and the first frame is used
+  // whenever the animation is not playing. If the animation is so short that
+  // the window covers every frame, there is nothing to do.
+  if (mSize < 5) {
+    return;
+  }
+
+  size_t prev = (mGetIndex + mSize - 1) % mSize;
+  size_t next = (mGetIndex + 1) % mSize;
+  for (size_t i = 1; i < mSize; ++i) {
+    if (i == mGetIndex || i == prev || i == next || !mFrames[i]) {
+      continue;
+    }
+
+    // If we already compressed this frame on an earlier pass of the animation,
+    // we can just drop the reinflated copy; frames are immutable once
+    // finished.
+    if (!mCompressed[i]) {
+      mCompressed[i] = CompressedFrame::Create(mFrames[i], uint32_t(i));
+      if (!mCompressed[i]) {
+        continue;
+      }
+    }
+    mFrames[i] = nullptr;
+  }
+}
+
+bool AnimationFrameRetainedBuffer::InflateFrame(size_t aFrame) {
+  MOZ_ASSERT(aFrame < mCompressed.Length());
+  MOZ_ASSERT(mCompressed[aFrame]);
+
+  RefPtr<imgFrame> frame = mCompressed[aFrame]->Inflate();
+  if (!frame) {
+    return false;
+  }
+
+  mFrames[aFrame] = std::move(frame);
+  return true;
+}
+
 imgFrame* AnimationFrameRetainedBuffer::Get(size_t aFrame, bool aForDisplay) {
   // We should not have asked for a frame if we never inserted.
   if (mFrames.IsEmpty()) {
@@ -105,10 +294,18 @@ imgFrame* AnimationFrameRetainedBuffer::Get(size_t aFrame, bool aForDisplay) {
     return nullptr;
   }
 
-  // If we have space for the frame, it should always be available.
+  // If we have space for the frame, it should always be available, unless it
+  // was replaced with a compressed copy after it was displayed.
   if (!mFrames[aFrame]) {
-    MOZ_ASSERT_UNREACHABLE("Calling Get() when frame is unavailable");
-    return nullptr;
+    if (aFrame < mCompressed.Length() && mCompressed[aFrame]) {
+      if (!InflateFrame(aFrame)) {
+        // Reinflation failed (e.g. OOM); treat the frame as unavailable.
+        return nullptr;
+      }
+    } else {
+      MOZ_ASSERT_UNREACHABLE("Calling Get() when frame is unavailable");
+      return nullptr;
+    }
   }
 
   // If we are advancing on behalf of the animation, we don't expect it to be
@@ -130,12 +327,29 @@ void AnimationFrameRetainedBuffer::AddSizeOfExcludingThis(
   size_t i = 0;
   for (const RefPtr<imgFrame>& frame : mFrames) {
     ++i;
+    if (!frame) {
+      // Replaced by a compressed copy; accounted for below.
+      continue;
+    }
     frame->AddSizeOfExcludingThis(aMallocSizeOf,
                                   [&](AddSizeOfCbData& aMetadata) {
                                     aMetadata.mIndex = i;
                                     aCallback(aMetadata);
                                   });
   }
+
+  i = 0;
+  for (const UniquePtr<CompressedFrame>& compressed : mCompressed) {
+    ++i;
+    if (!compressed) {
+      continue;
+    }
+    AddSizeOfCbData metadata;
+    metadata.mIndex = i;
+    metadata.mFinished = true;
+    metadata.mHeapBytes = compressed->SizeOfExcludingThis(aMallocSizeOf);
+    aCallback(metadata);
+  }
 }
 
 AnimationFrameDiscardingQueue::AnimationFrameDiscardingQueue(
@@ -7,6 +7,7 @@
 #define mozilla_image_AnimationFrameBuffer_h
 
 #include "ISurfaceProvider.h"
+#include "mozilla/UniquePtr.h"
 #include <deque>
 
 namespace mozilla {
@@ -334,9 +335,18 @@ class AnimationFrameRetainedBuffer final : public AnimationFrameBuffer {
    * @param aBatch      See AnimationFrameBuffer::AnimationFrameBuffer.
    *
    * @param aStartFrame See AnimationFrameBuffer::AnimationFrameBuffer.
+   *
+   * @param aCompressInactive If true, then once the buffer is complete, frames
+   *                    which have already been displayed and are not adjacent
+   *                    to the current frame are replaced by LZ4-compressed
+   *                    copies of their pixels, and reinflated on demand as the
+   *                    animation loops back around to them.
    */
   AnimationFrameRetainedBuffer(size_t aThreshold, size_t aBatch,
-                               size_t aCurrentFrame);
+                               size_t aCurrentFrame,
+                               bool aCompressInactive = false);
+
+  ~AnimationFrameRetainedBuffer() override;
 
   /**
    * @returns Maximum number of frames before we start discarding previous
@@ -346,7 +356,9 @@ class AnimationFrameRetainedBuffer final : public AnimationFrameBuffer {
 
   /**
    * @returns The frames of this animation, in order. Each element will always
-   *          contain a valid frame.
+   *          contain a valid frame until the buffer is marked as complete;
+   *          after that, elements for already displayed frames may be null if
+   *          they were replaced by compressed copies.
    */
   const nsTArray<RefPtr<imgFrame>>& Frames() const { return mFrames; }
 
@@ -361,15 +373,34 @@ class AnimationFrameRetainedBuffer final : public AnimationFrameBuffer {
   friend class AnimationFrameDiscardingQueue;
   friend class AnimationFrameRecyclingQueue;
 
+  // A compact LZ4-compressed copy of a frame's pixels, together with the
+  // metadata required to recreate an equivalent imgFrame on demand.
+  class CompressedFrame;
+
   bool InsertInternal(RefPtr<imgFrame>&& aFrame) override;
   void AdvanceInternal() override;
   bool ResetInternal() override;
 
-  // The frames of this animation, in order.
+  void MaybeCompressFrames();
+  bool InflateFrame(size_t aFrame);
+
+  // The frames of this animation, in order. After the buffer is complete,
+  // entries for already displayed frames may be null if they were replaced by
+  // compressed copies in mCompressed.
   nsTArray<RefPtr<imgFrame>> mFrames;
 
+  // Compressed copies of frames, parallel to mFrames. Only populated once the
+  // buffer is complete, and only if compression was requested. A frame may
+  // have both a compressed copy and a reinflated imgFrame; the former is kept
+  // so that dropping the frame again after it has been displayed is free.
+  nsTArray<UniquePtr<CompressedFrame>> mCompressed;
+
   // The maximum number of frames we can have before discarding.
   size_t mThreshold;
+
+  // True if already displayed frames should be replaced with compressed
+  // copies once the buffer is complete.
+  bool mCompressInactive;
 };
 
 /**
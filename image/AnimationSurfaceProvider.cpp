@@ -25,7 +25,10 @@ AnimationSurfaceProvider::AnimationSurfaceProvider(
       mImage(aImage.get()),
       mDecodingMutex("AnimationSurfaceProvider::mDecoder"),
       mDecoder(aDecoder.get()),
-      mFramesMutex("AnimationSurfaceProvider::mFrames") {
+      mFramesMutex("AnimationSurfaceProvider::mFrames"),
+      mPriority(aDecoder->GetDecoderFlags() & DecoderFlags::HIGH_PRIORITY
+                    ? TaskPriority::eHigh
+                    : TaskPriority::eLow) {
   MOZ_ASSERT(!mDecoder->IsMetadataDecode(),
              "Use MetadataDecodingTask for metadata decodes");
   MOZ_ASSERT(!mDecoder->IsFirstFrameDecode(),
@@ -39,9 +42,12 @@ AnimationSurfaceProvider::AnimationSurfaceProvider(
        1024) /
       (sizeof(uint32_t) * frameSize.width * frameSize.height);
   size_t batch = StaticPrefs::image_animated_decode_on_demand_batch_size();
+  bool compressInactive =
+      StaticPrefs::image_animated_compress_inactive_frames();
 
-  mFrames.reset(
-      new AnimationFrameRetainedBuffer(threshold, batch, aCurrentFrame));
+  mFrames.reset(new AnimationFrameRetainedBuffer(threshold, batch,
+                                                 aCurrentFrame,
+                                                 compressInactive));
 }
 
 AnimationSurfaceProvider::~AnimationSurfaceProvider() {
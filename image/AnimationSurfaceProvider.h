@@ -76,8 +76,9 @@ class AnimationSurfaceProvider final : public ISurfaceProvider,
   bool ShouldPreferSyncRun() const override;
 
   // Full decodes are low priority compared to metadata decodes because they
-  // don't block layout or page load.
-  TaskPriority Priority() const override { return TaskPriority::eLow; }
+  // don't block layout or page load. Paint-driven decodes
+  // (DecoderFlags::HIGH_PRIORITY) jump ahead of speculative ones.
+  TaskPriority Priority() const override { return mPriority; }
 
   //////////////////////////////////////////////////////////////////////////////
   // IDecoderFrameRecycler implementation.
@@ -114,6 +115,10 @@ class AnimationSurfaceProvider final : public ISurfaceProvider,
 
   /// The frames of this animation, in order.
   UniquePtr<AnimationFrameBuffer> mFrames;
+
+  /// The priority our decoding task runs at, captured from the decoder flags
+  /// at creation time.
+  TaskPriority mPriority;
 };
 
 }  // namespace image
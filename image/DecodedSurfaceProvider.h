@@ -52,8 +52,9 @@ class DecodedSurfaceProvider final : public ISurfaceProvider,
   bool ShouldPreferSyncRun() const override;
 
   // Full decodes are low priority compared to metadata decodes because they
-  // don't block layout or page load.
-  TaskPriority Priority() const override { return TaskPriority::eLow; }
+  // don't block layout or page load, except when the decode was requested
+  // for an imminent paint (DecoderFlags::HIGH_PRIORITY).
+  TaskPriority Priority() const override { return mPriority; }
 
  private:
   virtual ~DecodedSurfaceProvider();
@@ -76,6 +77,10 @@ class DecodedSurfaceProvider final : public ISurfaceProvider,
 
   /// A drawable reference to our service; used for locking.
   DrawableFrameRef mLockRef;
+
+  /// The priority our decoding task runs at, captured from the decoder flags
+  /// at creation time.
+  TaskPriority mPriority;
 };
 
 }  // namespace image
@@ -31,6 +31,14 @@ enum class DecoderFlags : uint8_t {
    * set.
    */
   CANNOT_SUBSTITUTE = 1 << 4,
+
+  /**
+   * Set when the decode was requested because the image is needed for an
+   * imminent paint. The decoding task then runs at high priority, so that
+   * speculative decodes (e.g. those triggered by approximate frame
+   * visibility) don't delay images the user is actually looking at.
+   */
+  HIGH_PRIORITY = 1 << 5,
 };
 MOZ_MAKE_ENUM_CLASS_BITWISE_OPERATORS(DecoderFlags)
 
@@ -1224,6 +1224,11 @@ void RasterImage::Decode(const UnorientedIntSize& aSize, uint32_t aFlags,
     // at any point.
     decoderFlags |= DecoderFlags::CANNOT_SUBSTITUTE;
   }
+  if (aFlags & (FLAG_SYNC_DECODE | FLAG_SYNC_DECODE_IF_FAST)) {
+    // The caller needs the pixels for an imminent paint, so don't let this
+    // decode queue up behind speculative ones.
+    decoderFlags |= DecoderFlags::HIGH_PRIORITY;
+  }
 
   SurfaceFlags surfaceFlags = ToSurfaceFlags(aFlags);
   if (IsOpaque()) {
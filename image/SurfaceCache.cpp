@@ -22,6 +22,7 @@
 #include "mozilla/Assertions.h"
 #include "mozilla/Attributes.h"
 #include "mozilla/CheckedInt.h"
+#include "mozilla/Compression.h"
 #include "mozilla/DebugOnly.h"
 #include "mozilla/Likely.h"
 #include "mozilla/RefPtr.h"
@@ -29,6 +30,8 @@
 #include "mozilla/StaticPrefs_image.h"
 #include "mozilla/StaticPtr.h"
 #include "mozilla/Tuple.h"
+#include "mozilla/UniquePtr.h"
+#include "mozilla/UniquePtrExtensions.h"
 #include "nsExpirationTracker.h"
 #include "nsHashKeys.h"
 #include "nsIMemoryReporter.h"
@@ -224,6 +227,153 @@ static int64_t AreaOfIntSize(const IntSize& aSize) {
   return static_cast<int64_t>(aSize.width) * static_cast<int64_t>(aSize.height);
 }
 
+/**
+ * A CompressedSurface is an LZ4-compressed copy of the pixels of a surface
+ * that was evicted from the cache. SurfaceCacheImpl keeps a bounded pool of
+ * these so that revisiting an evicted surface can be serviced by a cheap
+ * decompression instead of a full re-decode from the source data. Only
+ * finished, static surfaces are eligible, since they're the only surfaces we
+ * can reproduce from their pixels alone.
+ *
+ * Note that mImageKey is a weak pointer which we never dereference; the pool
+ * must be purged of an image's entries when that image is removed from the
+ * cache.
+ */
+class CompressedSurface {
+ public:
+  static UniquePtr<CompressedSurface> FromSurface(
+      NotNull<CachedSurface*> aSurface) {
+    DrawableSurface drawableSurface = aSurface->GetDrawableSurface();
+    if (!drawableSurface) {
+      return nullptr;  // The operating system released the surface's data.
+    }
+
+    RefPtr<SourceSurface> sourceSurface = drawableSurface->GetSourceSurface();
+    if (!sourceSurface) {
+      return nullptr;
+    }
+
+    RefPtr<DataSourceSurface> data = sourceSurface->GetDataSurface();
+    if (!data) {
+      return nullptr;
+    }
+
+    const IntSize size = data->GetSize();
+    const SurfaceFormat format = data->GetFormat();
+    if (size != aSurface->GetSurfaceKey().Size()) {
+      return nullptr;  // Not reproducible from the pixels alone.
+    }
+
+    CheckedInt<size_t> rowLength =
+        CheckedInt<size_t>(size.width) * BytesPerPixel(format);
+    CheckedInt<size_t> uncompressedLength = rowLength * size.height;
+    if (!uncompressedLength.isValid()) {
+      return nullptr;
+    }
+
+    DataSourceSurface::ScopedMap map(data, DataSourceSurface::READ);
+    if (!map.IsMapped()) {
+      return nullptr;
+    }
+
+    // imgFrame buffers are tightly packed, but the surface we read from may
+    // not be; repack into a contiguous buffer before compressing so that
+    // Reinflate() can decompress directly into a new frame.
+    const uint8_t* source = map.GetData();
+    UniquePtr<uint8_t[]> packed;
+    if (size_t(map.GetStride()) != rowLength.value()) {
+      packed = MakeUniqueFallible<uint8_t[]>(uncompressedLength.value());
+      if (!packed) {
+        return nullptr;
+      }
+      for (int32_t row = 0; row < size.height; ++row) {
+        memcpy(packed.get() + row * rowLength.value(),
+               map.GetData() + row * map.GetStride(), rowLength.value());
+      }
+      source = packed.get();
+    }
+
+    UniquePtr<CompressedSurface> compressed(
+        new CompressedSurface(aSurface->GetImageKey(),
+                              aSurface->GetSurfaceKey(), format,
+                              uint32_t(uncompressedLength.value())));
+    if (!compressed->mData.SetLength(
+            Compression::LZ4::maxCompressedSize(uncompressedLength.value()),
+            fallible)) {
+      return nullptr;
+    }
+
+    size_t compressedLength = Compression::LZ4::compress(
+        reinterpret_cast<const char*>(source), uncompressedLength.value(),
+        reinterpret_cast<char*>(compressed->mData.Elements()));
+    compressed->mData.TruncateLength(compressedLength);
+    compressed->mData.Compact();
+    return compressed;
+  }
+
+  /**
+   * Decompress into a new finished imgFrame. Returns null on failure, in
+   * which case the caller should fall back to a full decode.
+   */
+  already_AddRefed<imgFrame> Reinflate() const {
+    RefPtr<imgFrame> frame = new imgFrame();
+    bool nonPremult =
+        bool(mSurfaceKey.Flags() & SurfaceFlags::NO_PREMULTIPLY_ALPHA);
+    nsresult rv = frame->InitForDecoder(mSurfaceKey.Size(), mFormat, nonPremult,
+                                        Nothing(), /* aShouldRecycle */ false);
+    if (NS_FAILED(rv)) {
+      return nullptr;
+    }
+
+    RawAccessFrameRef rawRef = frame->RawAccessRef();
+    if (!rawRef) {
+      frame->Abort();
+      return nullptr;
+    }
+
+    uint8_t* frameData = nullptr;
+    uint32_t frameLength = 0;
+    frame->GetImageData(&frameData, &frameLength);
+    if (!frameData || frameLength != mUncompressedLength) {
+      frame->Abort();
+      return nullptr;
+    }
+
+    size_t decompressedLength = 0;
+    if (!Compression::LZ4::decompress(
+            reinterpret_cast<const char*>(mData.Elements()), mData.Length(),
+            reinterpret_cast<char*>(frameData), frameLength,
+            &decompressedLength) ||
+        decompressedLength != mUncompressedLength) {
+      frame->Abort();
+      return nullptr;
+    }
+
+    frame->ImageUpdated(frame->GetRect());
+    frame->Finish(frame->FormatHasAlpha() ? Opacity::SOME_TRANSPARENCY
+                                          : Opacity::FULLY_OPAQUE);
+    return frame.forget();
+  }
+
+  ImageKey GetImageKey() const { return mImageKey; }
+  const SurfaceKey& GetSurfaceKey() const { return mSurfaceKey; }
+  size_t CompressedSizeInBytes() const { return mData.Length(); }
+
+ private:
+  CompressedSurface(ImageKey aImageKey, const SurfaceKey& aSurfaceKey,
+                    SurfaceFormat aFormat, uint32_t aUncompressedLength)
+      : mImageKey(aImageKey),
+        mSurfaceKey(aSurfaceKey),
+        mFormat(aFormat),
+        mUncompressedLength(aUncompressedLength) {}
+
+  const ImageKey mImageKey;
+  const SurfaceKey mSurfaceKey;
+  const SurfaceFormat mFormat;
+  const uint32_t mUncompressedLength;
+  nsTArray<uint8_t> mData;
+};
+
 /**
  * An ImageSurfaceCache is a per-image surface cache. For correctness we must be
  * able to remove all surfaces associated with an image when the image is
@@ -734,13 +884,16 @@ class SurfaceCacheImpl final : public nsIMemoryReporter {
 
   SurfaceCacheImpl(uint32_t aSurfaceCacheExpirationTimeMS,
                    uint32_t aSurfaceCacheDiscardFactor,
-                   uint32_t aSurfaceCacheSize)
+                   uint32_t aSurfaceCacheSize,
+                   uint32_t aSurfaceCacheCompressedPoolSize)
       : mExpirationTracker(aSurfaceCacheExpirationTimeMS),
         mMemoryPressureObserver(new MemoryPressureObserver),
         mDiscardFactor(aSurfaceCacheDiscardFactor),
         mMaxCost(aSurfaceCacheSize),
         mAvailableCost(aSurfaceCacheSize),
         mLockedCost(0),
+        mMaxCompressedBytes(aSurfaceCacheCompressedPoolSize),
+        mCompressedBytes(0),
         mOverflowCount(0),
         mAlreadyPresentCount(0),
         mTableFailureCount(0),
@@ -800,7 +953,7 @@ class SurfaceCacheImpl final : public nsIMemoryReporter {
       MOZ_ASSERT(!mCosts.IsEmpty(),
                  "Removed everything and it still won't fit");
       Remove(mCosts.LastElement().Surface(), /* aStopTracking */ true,
-             aAutoLock);
+             /* aMayCompress */ true, aAutoLock);
     }
 
     // Locate the appropriate per-image cache. If there's not an existing cache
@@ -846,15 +999,20 @@ class SurfaceCacheImpl final : public nsIMemoryReporter {
 
     if (MOZ_UNLIKELY(!StartTracking(surface, aAutoLock))) {
       MOZ_ASSERT(!mustLock);
-      Remove(surface, /* aStopTracking */ false, aAutoLock);
+      Remove(surface, /* aStopTracking */ false, /* aMayCompress */ false,
+             aAutoLock);
       return InsertOutcome::FAILURE;
     }
 
+    // A freshly inserted surface supersedes any compressed copy we kept from a
+    // previous eviction.
+    RemoveCompressedEntry(imageKey, aProvider->GetSurfaceKey());
+
     return InsertOutcome::SUCCESS;
   }
 
   void Remove(NotNull<CachedSurface*> aSurface, bool aStopTracking,
-              const StaticMutexAutoLock& aAutoLock) {
+              bool aMayCompress, const StaticMutexAutoLock& aAutoLock) {
     ImageKey imageKey = aSurface->GetImageKey();
 
     RefPtr<ImageSurfaceCache> cache = GetImageCache(imageKey);
@@ -863,6 +1021,11 @@ class SurfaceCacheImpl final : public nsIMemoryReporter {
     // If the surface was not a placeholder, tell its image that we discarded
     // it.
     if (!aSurface->IsPlaceholder()) {
+      // Before the pixels go away, consider keeping a compressed copy of them
+      // so that a revisit can skip the full re-decode.
+      if (aMayCompress) {
+        MaybeCompress(aSurface, aAutoLock);
+      }
       static_cast<Image*>(imageKey)->OnSurfaceDiscarded(
           aSurface->GetSurfaceKey());
     }
@@ -941,13 +1104,24 @@ class SurfaceCacheImpl final : public nsIMemoryReporter {
                       const StaticMutexAutoLock& aAutoLock, bool aMarkUsed) {
     RefPtr<ImageSurfaceCache> cache = GetImageCache(aImageKey);
     if (!cache) {
-      // No cached surfaces for this image.
+      // No cached surfaces for this image. We may still have a compressed
+      // copy of the surface we can reinflate. (We only do this for lookups
+      // which want the pixels; in particular, Insert() probes with
+      // aMarkUsed = false to detect duplicates.)
+      if (aMarkUsed && MaybeReinflate(aImageKey, aSurfaceKey, aAutoLock)) {
+        return Lookup(aImageKey, aSurfaceKey, aAutoLock, aMarkUsed);
+      }
       return LookupResult(MatchType::NOT_FOUND);
     }
 
     RefPtr<CachedSurface> surface = cache->Lookup(aSurfaceKey, aMarkUsed);
     if (!surface) {
-      // Lookup in the per-image cache missed.
+      // Lookup in the per-image cache missed; try the compressed pool. Note
+      // that MaybeReinflate() consumes the pool entry, so the recursion below
+      // cannot loop.
+      if (aMarkUsed && MaybeReinflate(aImageKey, aSurfaceKey, aAutoLock)) {
+        return Lookup(aImageKey, aSurfaceKey, aAutoLock, aMarkUsed);
+      }
       return LookupResult(MatchType::NOT_FOUND);
     }
 
@@ -959,13 +1133,15 @@ class SurfaceCacheImpl final : public nsIMemoryReporter {
     if (!drawableSurface) {
       // The surface was released by the operating system. Remove the cache
       // entry as well.
-      Remove(WrapNotNull(surface), /* aStopTracking */ true, aAutoLock);
+      Remove(WrapNotNull(surface), /* aStopTracking */ true,
+             /* aMayCompress */ false, aAutoLock);
       return LookupResult(MatchType::NOT_FOUND);
     }
 
     if (aMarkUsed &&
         !MarkUsed(WrapNotNull(surface), WrapNotNull(cache), aAutoLock)) {
-      Remove(WrapNotNull(surface), /* aStopTracking */ false, aAutoLock);
+      Remove(WrapNotNull(surface), /* aStopTracking */ false,
+             /* aMayCompress */ false, aAutoLock);
       return LookupResult(MatchType::NOT_FOUND);
     }
 
@@ -980,7 +1156,11 @@ class SurfaceCacheImpl final : public nsIMemoryReporter {
                                bool aMarkUsed) {
     RefPtr<ImageSurfaceCache> cache = GetImageCache(aImageKey);
     if (!cache) {
-      // No cached surfaces for this image.
+      // No cached surfaces for this image; try the compressed pool for an
+      // exact match before giving up.
+      if (aMarkUsed && MaybeReinflate(aImageKey, aSurfaceKey, aAutoLock)) {
+        return LookupBestMatch(aImageKey, aSurfaceKey, aAutoLock, aMarkUsed);
+      }
       return LookupResult(
           MatchType::NOT_FOUND,
           SurfaceCache::ClampSize(aImageKey, aSurfaceKey.Size()));
@@ -1001,8 +1181,12 @@ class SurfaceCacheImpl final : public nsIMemoryReporter {
           cache->LookupBestMatch(aSurfaceKey);
 
       if (!surface) {
-        return LookupResult(
-            matchType, suggestedSize);  // Lookup in the per-image cache missed.
+        // Lookup in the per-image cache missed entirely. An exact match may
+        // still be available from the compressed pool.
+        if (aMarkUsed && MaybeReinflate(aImageKey, aSurfaceKey, aAutoLock)) {
+          return LookupBestMatch(aImageKey, aSurfaceKey, aAutoLock, aMarkUsed);
+        }
+        return LookupResult(matchType, suggestedSize);
       }
 
       drawableSurface = surface->GetDrawableSurface();
@@ -1012,7 +1196,8 @@ class SurfaceCacheImpl final : public nsIMemoryReporter {
 
       // The surface was released by the operating system. Remove the cache
       // entry as well.
-      Remove(WrapNotNull(surface), /* aStopTracking */ true, aAutoLock);
+      Remove(WrapNotNull(surface), /* aStopTracking */ true,
+             /* aMayCompress */ false, aAutoLock);
     }
 
     MOZ_ASSERT_IF(matchType == MatchType::EXACT,
@@ -1028,7 +1213,8 @@ class SurfaceCacheImpl final : public nsIMemoryReporter {
         matchType == MatchType::SUBSTITUTE_BECAUSE_BEST) {
       if (aMarkUsed &&
           !MarkUsed(WrapNotNull(surface), WrapNotNull(cache), aAutoLock)) {
-        Remove(WrapNotNull(surface), /* aStopTracking */ false, aAutoLock);
+        Remove(WrapNotNull(surface), /* aStopTracking */ false,
+               /* aMayCompress */ false, aAutoLock);
       }
     }
 
@@ -1115,6 +1301,11 @@ class SurfaceCacheImpl final : public nsIMemoryReporter {
     // This implicitly unlocks the image if it was locked.
     mImageCaches.Remove(aImageKey);
 
+    // Drop any compressed copies we kept of this image's surfaces; the image
+    // is going away (or has been invalidated), so they can never be reused
+    // and their ImageKey is about to dangle.
+    PurgeCompressedSurfaces(aImageKey);
+
     // Since we did not actually remove any of the surfaces from the cache
     // itself, only stopped tracking them, we should free it outside the lock.
     return cache.forget();
@@ -1137,16 +1328,25 @@ class SurfaceCacheImpl final : public nsIMemoryReporter {
   }
 
   void DiscardAll(const StaticMutexAutoLock& aAutoLock) {
+    // The compressed pool exists to avoid re-decodes, not to survive explicit
+    // discards, so drop it as well.
+    PurgeAllCompressedSurfaces();
+
     // Remove in order of cost because mCosts is an array and the other data
     // structures are all hash tables. Note that locked surfaces are not
     // removed, since they aren't present in mCosts.
     while (!mCosts.IsEmpty()) {
       Remove(mCosts.LastElement().Surface(), /* aStopTracking */ true,
-             aAutoLock);
+             /* aMayCompress */ false, aAutoLock);
     }
   }
 
   void DiscardForMemoryPressure(const StaticMutexAutoLock& aAutoLock) {
+    // The compressed pool is the cheapest memory to give back, and keeping
+    // compressed copies of the surfaces we're about to discard would defeat
+    // the purpose of discarding them, so drop the whole pool first.
+    PurgeAllCompressedSurfaces();
+
     // Compute our discardable cost. Since locked surfaces aren't discardable,
     // we exclude them.
     const Cost discardableCost = (mMaxCost - mAvailableCost) - mLockedCost;
@@ -1168,7 +1368,7 @@ class SurfaceCacheImpl final : public nsIMemoryReporter {
     while (mAvailableCost < targetCost) {
       MOZ_ASSERT(!mCosts.IsEmpty(), "Removed everything and still not done");
       Remove(mCosts.LastElement().Surface(), /* aStopTracking */ true,
-             aAutoLock);
+             /* aMayCompress */ false, aAutoLock);
     }
   }
 
@@ -1198,7 +1398,8 @@ class SurfaceCacheImpl final : public nsIMemoryReporter {
         aMallocSizeOf(this) + mCosts.ShallowSizeOfExcludingThis(aMallocSizeOf) +
         mImageCaches.ShallowSizeOfExcludingThis(aMallocSizeOf) +
         mCachedSurfacesDiscard.ShallowSizeOfExcludingThis(aMallocSizeOf) +
-        mExpirationTracker.ShallowSizeOfExcludingThis(aMallocSizeOf);
+        mExpirationTracker.ShallowSizeOfExcludingThis(aMallocSizeOf) +
+        mCompressedSurfaces.ShallowSizeOfExcludingThis(aMallocSizeOf);
     for (auto iter = mImageCaches.ConstIter(); !iter.Done(); iter.Next()) {
       bytes += iter.UserData()->ShallowSizeOfIncludingThis(aMallocSizeOf);
     }
@@ -1245,6 +1446,18 @@ class SurfaceCacheImpl final : public nsIMemoryReporter {
       KIND_OTHER, UNITS_BYTES, mLockedCost,
 "Estimated memory used by locked surfaces in the imagelib surface cache.");
 
+    MOZ_COLLECT_REPORT(
+      "imagelib-surface-cache-compressed-pool",
+      KIND_OTHER, UNITS_BYTES, mCompressedBytes,
+"Memory used by compressed copies of surfaces evicted from the imagelib "
+"surface cache.");
+
+    MOZ_COLLECT_REPORT(
+      "imagelib-surface-cache-compressed-pool-count",
+      KIND_OTHER, UNITS_COUNT, mCompressedSurfaces.Length(),
+"Total number of compressed copies of surfaces evicted from the imagelib "
+"surface cache.");
+
     MOZ_COLLECT_REPORT(
       "imagelib-surface-cache-tracked-cost-count",
       KIND_OTHER, UNITS_COUNT, mCosts.Length(),
@@ -1419,7 +1632,8 @@ class SurfaceCacheImpl final : public nsIMemoryReporter {
 
     // Discard any that we failed to track.
     for (auto iter = discard.begin(); iter != discard.end(); ++iter) {
-      Remove(*iter, /* aStopTracking */ false, aAutoLock);
+      Remove(*iter, /* aStopTracking */ false, /* aMayCompress */ false,
+             aAutoLock);
     }
   }
 
@@ -1436,7 +1650,112 @@ class SurfaceCacheImpl final : public nsIMemoryReporter {
       return;  // Lookup in the per-image cache missed.
     }
 
-    Remove(WrapNotNull(surface), /* aStopTracking */ true, aAutoLock);
+    Remove(WrapNotNull(surface), /* aStopTracking */ true,
+           /* aMayCompress */ false, aAutoLock);
+  }
+
+  void MaybeCompress(NotNull<CachedSurface*> aSurface,
+                     const StaticMutexAutoLock& aAutoLock) {
+    if (mMaxCompressedBytes == 0) {
+      return;  // The compressed pool is disabled.
+    }
+
+    // Only finished, static surfaces can be reproduced from their pixels
+    // alone; animated surfaces are regenerated dynamically by their provider.
+    if (!aSurface->IsDecoded() ||
+        aSurface->GetSurfaceKey().Playback() != PlaybackType::eStatic) {
+      return;
+    }
+
+    UniquePtr<CompressedSurface> compressed =
+        CompressedSurface::FromSurface(aSurface);
+    if (!compressed ||
+        compressed->CompressedSizeInBytes() > mMaxCompressedBytes) {
+      return;
+    }
+
+    // There shouldn't be an existing entry for this key, since Insert()
+    // removes it, but make sure our accounting can't be corrupted by one.
+    RemoveCompressedEntry(aSurface->GetImageKey(), aSurface->GetSurfaceKey());
+
+    // Make room, dropping the oldest entries first.
+    while (mCompressedBytes + compressed->CompressedSizeInBytes() >
+           mMaxCompressedBytes) {
+      MOZ_ASSERT(!mCompressedSurfaces.IsEmpty(),
+                 "Removed everything and it still won't fit");
+      mCompressedBytes -= mCompressedSurfaces[0]->CompressedSizeInBytes();
+      mCompressedSurfaces.RemoveElementAt(0);
+    }
+
+    mCompressedBytes += compressed->CompressedSizeInBytes();
+    mCompressedSurfaces.AppendElement(std::move(compressed));
+  }
+
+  /**
+   * If the compressed pool holds a copy of the surface identified by the
+   * given keys, decompress it and reinsert it into the cache. Returns true on
+   * success, in which case a subsequent lookup for the same keys will hit.
+   * The pool entry is consumed either way.
+   */
+  bool MaybeReinflate(const ImageKey aImageKey, const SurfaceKey& aSurfaceKey,
+                      const StaticMutexAutoLock& aAutoLock) {
+    UniquePtr<CompressedSurface> compressed =
+        TakeCompressedEntry(aImageKey, aSurfaceKey);
+    if (!compressed) {
+      return false;
+    }
+
+    RefPtr<imgFrame> frame = compressed->Reinflate();
+    if (!frame) {
+      return false;
+    }
+
+    // Reinsert the surface via a SimpleSurfaceProvider, just as VectorImage
+    // does for rasterized SVG surfaces. Since we've already consumed the pool
+    // entry, the Insert() below can't find it and recurse.
+    NotNull<RefPtr<ISurfaceProvider>> provider =
+        MakeNotNull<SimpleSurfaceProvider*>(aImageKey, aSurfaceKey,
+                                            WrapNotNull(frame.get()));
+    return Insert(provider, /* aSetAvailable = */ false, aAutoLock) ==
+           InsertOutcome::SUCCESS;
+  }
+
+  UniquePtr<CompressedSurface> TakeCompressedEntry(
+      const ImageKey aImageKey, const SurfaceKey& aSurfaceKey) {
+    for (uint32_t i = 0; i < mCompressedSurfaces.Length(); ++i) {
+      if (mCompressedSurfaces[i]->GetImageKey() == aImageKey &&
+          mCompressedSurfaces[i]->GetSurfaceKey() == aSurfaceKey) {
+        UniquePtr<CompressedSurface> entry =
+            std::move(mCompressedSurfaces[i]);
+        mCompressedSurfaces.RemoveElementAt(i);
+        mCompressedBytes -= entry->CompressedSizeInBytes();
+        return entry;
+      }
+    }
+    return nullptr;
+  }
+
+  void RemoveCompressedEntry(const ImageKey aImageKey,
+                             const SurfaceKey& aSurfaceKey) {
+    UniquePtr<CompressedSurface> entry =
+        TakeCompressedEntry(aImageKey, aSurfaceKey);
+    // Just let |entry| go out of scope to free it.
+  }
+
+  void PurgeCompressedSurfaces(const ImageKey aImageKey) {
+    mCompressedSurfaces.RemoveElementsBy(
+        [&](const UniquePtr<CompressedSurface>& aEntry) {
+          if (aEntry->GetImageKey() != aImageKey) {
+            return false;
+          }
+          mCompressedBytes -= aEntry->CompressedSizeInBytes();
+          return true;
+        });
+  }
+
+  void PurgeAllCompressedSurfaces() {
+    mCompressedSurfaces.Clear();
+    mCompressedBytes = 0;
   }
 
   class SurfaceTracker final
@@ -1452,7 +1771,7 @@ class SurfaceCacheImpl final : public nsIMemoryReporter {
     void NotifyExpiredLocked(CachedSurface* aSurface,
                              const StaticMutexAutoLock& aAutoLock) override {
       sInstance->Remove(WrapNotNull(aSurface), /* aStopTracking */ true,
-                        aAutoLock);
+                        /* aMayCompress */ true, aAutoLock);
     }
 
     void NotifyHandlerEndLocked(const StaticMutexAutoLock& aAutoLock) override {
@@ -1495,10 +1814,16 @@ class SurfaceCacheImpl final : public nsIMemoryReporter {
   SurfaceTracker mExpirationTracker;
   RefPtr<MemoryPressureObserver> mMemoryPressureObserver;
   nsTArray<RefPtr<image::Image>> mReleasingImagesOnMainThread;
+  // Compressed copies of evicted surfaces, in order from oldest to newest.
+  // The pool is expected to stay small, so we use a flat array and linear
+  // searches, as we do for mCosts.
+  nsTArray<UniquePtr<CompressedSurface>> mCompressedSurfaces;
   const uint32_t mDiscardFactor;
   const Cost mMaxCost;
   Cost mAvailableCost;
   Cost mLockedCost;
+  const size_t mMaxCompressedBytes;
+  size_t mCompressedBytes;
   size_t mOverflowCount;
   size_t mAlreadyPresentCount;
   size_t mTableFailureCount;
@@ -1564,12 +1889,21 @@ void SurfaceCache::Initialize() {
   uint32_t finalSurfaceCacheSizeBytes =
       min(surfaceCacheSizeBytes, uint64_t(UINT32_MAX));
 
+  // Maximum size of the pool of compressed copies of evicted surfaces, in
+  // bytes. The pool never needs to be bigger than the cache itself.
+  uint32_t surfaceCacheCompressedPoolSizeBytes = min(
+      uint64_t(
+          StaticPrefs::image_mem_surfacecache_compressed_pool_size_kb_AtStartup()) *
+          1024,
+      uint64_t(finalSurfaceCacheSizeBytes));
+
   // Create the surface cache singleton with the requested settings.  Note that
   // the size is a limit that the cache may not grow beyond, but we do not
   // actually allocate any storage for surfaces at this time.
   sInstance = new SurfaceCacheImpl(surfaceCacheExpirationTimeMS,
                                    surfaceCacheDiscardFactor,
-                                   finalSurfaceCacheSizeBytes);
+                                   finalSurfaceCacheSizeBytes,
+                                   surfaceCacheCompressedPoolSizeBytes);
   sInstance->InitMemoryReporter();
 }
 
@@ -349,6 +349,29 @@ LexerTransition<nsJPEGDecoder::State> nsJPEGDecoder::ReadJPEGData(
       mInfo.buffered_image =
           mDecodeStyle == PROGRESSIVE && jpeg_has_multiple_scans(&mInfo);
 
+      // If we're downscaling while decoding, we can have libjpeg do much of
+      // the work for us by performing the IDCT at a reduced M/8 scale. Decode
+      // at the smallest such scale that still covers the target size; the
+      // surface pipe's downscaler handles the remainder. For large photos
+      // that are displayed much smaller than their intrinsic size, this
+      // skips most of the IDCT and color conversion work entirely.
+      if (OutputSize() != Size()) {
+        unsigned int scale = 8;
+        while (scale > 1) {
+          // libjpeg rounds scaled dimensions up, and so must we.
+          unsigned int scaledWidth = (mInfo.image_width * (scale - 1) + 7) / 8;
+          unsigned int scaledHeight =
+              (mInfo.image_height * (scale - 1) + 7) / 8;
+          if (scaledWidth < unsigned(OutputSize().width) ||
+              scaledHeight < unsigned(OutputSize().height)) {
+            break;
+          }
+          --scale;
+        }
+        mInfo.scale_num = scale;
+        mInfo.scale_denom = 8;
+      }
+
       /* Used to set up image size so arrays can be allocated */
       jpeg_calc_output_dimensions(&mInfo);
 
@@ -359,8 +382,12 @@ LexerTransition<nsJPEGDecoder::State> nsJPEGDecoder::ReadJPEGData(
       qcms_transform* pipeTransform =
           mInfo.out_color_space != JCS_GRAYSCALE ? mTransform : nullptr;
 
+      // If libjpeg is performing the IDCT at a reduced scale, the pipe's
+      // input is the scaled size rather than the intrinsic size.
+      gfx::IntSize decodeSize(mInfo.output_width, mInfo.output_height);
       Maybe<SurfacePipe> pipe = SurfacePipeFactory::CreateSurfacePipe(
-          this, Size(), OutputSize(), FullFrame(), SurfaceFormat::OS_RGBX,
+          this, decodeSize, OutputSize(),
+          gfx::IntRect(gfx::IntPoint(), decodeSize), SurfaceFormat::OS_RGBX,
           SurfaceFormat::OS_RGBX, Nothing(), pipeTransform, SurfacePipeFlags());
       if (!pipe) {
         mState = JPEG_ERROR;
@@ -661,8 +688,17 @@ WriteState nsJPEGDecoder::OutputScanlines() {
 
   Maybe<SurfaceInvalidRect> invalidRect = mPipe.TakeInvalidRect();
   if (invalidRect) {
-    PostInvalidation(invalidRect->mInputSpaceRect,
-                     Some(invalidRect->mOutputSpaceRect));
+    gfx::IntRect inputSpaceRect = invalidRect->mInputSpaceRect;
+    if (mInfo.output_width != mInfo.image_width ||
+        mInfo.output_height != mInfo.image_height) {
+      // We're decoding at a reduced scale, so the pipe's input space is the
+      // scaled size; map the invalid rect back into the image's intrinsic
+      // coordinate space.
+      inputSpaceRect.ScaleRoundOut(
+          double(mInfo.image_width) / mInfo.output_width,
+          double(mInfo.image_height) / mInfo.output_height);
+    }
+    PostInvalidation(inputSpaceRect, Some(invalidRect->mOutputSpaceRect));
   }
 
   return result;
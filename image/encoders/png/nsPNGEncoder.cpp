@@ -3,6 +3,8 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this
  * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <algorithm>
+
 #include "ImageLogging.h"
 #include "nsCRT.h"
 #include "nsPNGEncoder.h"
@@ -87,6 +89,7 @@ nsPNGEncoder::StartImageEncode(uint32_t aWidth, uint32_t aHeight,
   bool useTransparency = true, skipFirstFrame = false;
   uint32_t numFrames = 1;
   uint32_t numPlays = 0;  // For animations, 0 == forever
+  int32_t zlibLevel = -1;
 
   // can't initialize more than once
   if (mImageBuffer != nullptr) {
@@ -101,7 +104,7 @@ nsPNGEncoder::StartImageEncode(uint32_t aWidth, uint32_t aHeight,
   // parse and check any provided output options
   nsresult rv = ParseOptions(aOutputOptions, &useTransparency, &skipFirstFrame,
                              &numFrames, &numPlays, nullptr, nullptr, nullptr,
-                             nullptr, nullptr);
+                             nullptr, nullptr, &zlibLevel);
   if (rv != NS_OK) {
     return rv;
   }
@@ -134,10 +137,16 @@ nsPNGEncoder::StartImageEncode(uint32_t aWidth, uint32_t aHeight,
     return NS_ERROR_FAILURE;
   }
 
-  // Set up to read the data into our image buffer, start out with an 8K
-  // estimated size. Note: we don't have to worry about freeing this data
-  // in this function. It will be freed on object destruction.
-  mImageBufferSize = 8192;
+  // Set up to read the data into our image buffer. Start out with a quarter
+  // of the raw image size (PNG output is rarely smaller than that for
+  // photographic or screenshot content), so that large encodes don't have to
+  // double through a series of reallocs from a tiny buffer while readers may
+  // be waiting on the monitor. Note: we don't have to worry about freeing
+  // this data in this function. It will be freed on object destruction.
+  CheckedUint32 estimatedSize = CheckedUint32(aWidth) * aHeight;
+  mImageBufferSize = estimatedSize.isValid()
+                         ? std::max<uint32_t>(8192, estimatedSize.value())
+                         : 8192;
   mImageBuffer = (uint8_t*)malloc(mImageBufferSize);
   if (!mImageBuffer) {
     png_destroy_write_struct(&mPNG, &mPNGinfo);
@@ -148,6 +157,13 @@ nsPNGEncoder::StartImageEncode(uint32_t aWidth, uint32_t aHeight,
   // set our callback for libpng to give us the data
   png_set_write_fn(mPNG, this, WriteCallback, nullptr);
 
+  // zlib-level=N lets callers that favor encode speed over output size
+  // (screenshots, canvas.toBlob) dial the deflate effort down from zlib's
+  // default.
+  if (zlibLevel >= 0) {
+    png_set_compression_level(mPNG, zlibLevel);
+  }
+
   // include alpha?
   int colorType;
   if ((aInputFormat == INPUT_FORMAT_HOSTARGB ||
@@ -232,7 +248,8 @@ nsPNGEncoder::AddImageFrame(const uint8_t* aData,
   // parse and check any provided output options
   nsresult rv =
       ParseOptions(aFrameOptions, &useTransparency, nullptr, nullptr, nullptr,
-                   &dispose_op, &blend_op, &delay_ms, &x_offset, &y_offset);
+                   &dispose_op, &blend_op, &delay_ms, &x_offset, &y_offset,
+                   nullptr);
   if (rv != NS_OK) {
     return rv;
   }
@@ -337,7 +354,8 @@ nsresult nsPNGEncoder::ParseOptions(const nsAString& aOptions,
                                     uint32_t* numFrames, uint32_t* numPlays,
                                     uint32_t* frameDispose,
                                     uint32_t* frameBlend, uint32_t* frameDelay,
-                                    uint32_t* offsetX, uint32_t* offsetY) {
+                                    uint32_t* offsetX, uint32_t* offsetY,
+                                    int32_t* zlibLevel) {
 #ifdef PNG_APNG_SUPPORTED
   // Make a copy of aOptions, because strtok() will modify it.
   nsAutoCString optionsCopy;
@@ -475,6 +493,17 @@ nsresult nsPNGEncoder::ParseOptions(const nsAString& aOptions,
         return NS_ERROR_INVALID_ARG;
       }
 
+      // zlib-level=#
+    } else if (nsCRT::strcmp(token, "zlib-level") == 0 && zlibLevel) {
+      if (!value) {
+        return NS_ERROR_INVALID_ARG;
+      }
+
+      if (PR_sscanf(value, "%d", zlibLevel) != 1 || *zlibLevel < 0 ||
+          *zlibLevel > 9) {
+        return NS_ERROR_INVALID_ARG;
+      }
+
       // unknown token name
     } else
       return NS_ERROR_INVALID_ARG;
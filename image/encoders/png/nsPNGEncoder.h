@@ -41,7 +41,8 @@ class nsPNGEncoder final : public imgIEncoder {
                         bool* skipFirstFrame, uint32_t* numAnimatedFrames,
                         uint32_t* numIterations, uint32_t* frameDispose,
                         uint32_t* frameBlend, uint32_t* frameDelay,
-                        uint32_t* offsetX, uint32_t* offsetY);
+                        uint32_t* offsetX, uint32_t* offsetY,
+                        int32_t* zlibLevel);
   void ConvertHostARGBRow(const uint8_t* aSrc, uint8_t* aDest,
                           uint32_t aPixelWidth, bool aUseTransparency);
   void StripAlpha(const uint8_t* aSrc, uint8_t* aDest, uint32_t aPixelWidth);
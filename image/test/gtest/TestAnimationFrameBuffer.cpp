@@ -372,6 +372,99 @@ TEST_F(ImageAnimationFrameBuffer, FinishMultipleBatchesUnderThreshold) {
   EXPECT_EQ(size_t(0), buffer.Displayed());
 }
 
+static size_t MissingFrameCount(const nsTArray<RefPtr<imgFrame>>& aFrames) {
+  size_t missing = 0;
+  for (const RefPtr<imgFrame>& frame : aFrames) {
+    if (!frame) {
+      ++missing;
+    }
+  }
+  return missing;
+}
+
+TEST_F(ImageAnimationFrameBuffer, RetainedCompressInactive) {
+  const size_t kThreshold = 30;
+  const size_t kBatch = 2;
+  const size_t kFrames = 10;
+  const IntSize kSize(64, 64);
+  const IntRect kRect(IntPoint(0, 0), kSize);
+  AnimationFrameRetainedBuffer buffer(kThreshold, kBatch, 0,
+                                      /* aCompressInactive */ true);
+  const auto& frames = buffer.Frames();
+
+  // Add frames until it tells us to stop.
+  AnimationFrameBuffer::InsertStatus status;
+  size_t inserted = 0;
+  do {
+    status = buffer.Insert(CreateEmptyFrame(kSize, kRect));
+    ++inserted;
+  } while (status == AnimationFrameBuffer::InsertStatus::CONTINUE);
+  EXPECT_EQ(AnimationFrameBuffer::InsertStatus::YIELD, status);
+
+  // Alternate between advancing through the animation and giving it the
+  // frames it requests, until we have inserted them all.
+  size_t i = 0;
+  while (inserted < kFrames) {
+    bool restartDecoder = false;
+    do {
+      EXPECT_TRUE(buffer.Get(i, false) != nullptr);
+      if (i > 0) {
+        restartDecoder = buffer.AdvanceTo(i);
+      }
+      ++i;
+    } while (!restartDecoder);
+
+    while (buffer.PendingDecode() > 0 && inserted < kFrames) {
+      status = buffer.Insert(CreateEmptyFrame(kSize, kRect));
+      ++inserted;
+    }
+  }
+
+  bool keepDecoding = buffer.MarkComplete(kRect);
+  EXPECT_FALSE(keepDecoding);
+  EXPECT_TRUE(buffer.SizeKnown());
+  EXPECT_FALSE(buffer.MayDiscard());
+  EXPECT_EQ(kFrames, frames.Length());
+
+  // Once complete, already displayed frames outside the window around the
+  // current frame should have been replaced with compressed copies, but the
+  // first frame must always remain available.
+  EXPECT_LT(size_t(0), MissingFrameCount(frames));
+  EXPECT_TRUE(frames[0]);
+  EXPECT_TRUE(buffer.IsFirstFrameFinished());
+
+  // Finish progressing through the animation.
+  for (; i < kFrames; ++i) {
+    EXPECT_TRUE(buffer.Get(i, false) != nullptr);
+    bool restartDecoder = buffer.AdvanceTo(i);
+    EXPECT_FALSE(restartDecoder);
+  }
+
+  // Loop over the animation again. Each frame should be reinflated on demand
+  // just before we advance to it.
+  for (i = 0; i < kFrames; ++i) {
+    imgFrame* frame = buffer.Get(i, false);
+    ASSERT_TRUE(frame != nullptr);
+    EXPECT_TRUE(frame->IsFinished());
+    EXPECT_EQ(kSize, frame->GetRect().Size());
+
+    RawAccessFrameRef ref = frame->RawAccessRef(/* aOnlyFinished */ true);
+    ASSERT_TRUE(ref);
+    uint8_t* data = nullptr;
+    uint32_t length = 0;
+    ref->GetImageData(&data, &length);
+    EXPECT_TRUE(data != nullptr);
+    EXPECT_EQ(uint32_t(kSize.width * kSize.height * sizeof(uint32_t)), length);
+
+    bool restartDecoder = buffer.AdvanceTo(i);
+    EXPECT_FALSE(restartDecoder);
+  }
+
+  // The frames we reinflated along the way should have been dropped again in
+  // favour of the compressed copies we already had.
+  EXPECT_LT(size_t(0), MissingFrameCount(frames));
+}
+
 TEST_F(ImageAnimationFrameBuffer, StartAfterBeginning) {
   const size_t kThreshold = 30;
   const size_t kBatch = 2;
@@ -6,10 +6,16 @@
 #include "mozilla/intl/LineBreaker.h"
 
 #include "jisx4051class.h"
+#include "nsClassHashtable.h"
 #include "nsComplexBreaker.h"
+#include "nsHashKeys.h"
 #include "nsTArray.h"
+#include "nsThreadUtils.h"
 #include "nsUnicodeProperties.h"
 #include "mozilla/ArrayUtils.h"
+#include "mozilla/ClearOnShutdown.h"
+#include "mozilla/StaticMutex.h"
+#include "mozilla/StaticPtr.h"
 
 using namespace mozilla::unicode;
 using namespace mozilla::intl;
@@ -1001,6 +1007,59 @@ static bool SuppressBreakForKeepAll(uint32_t aPrev, uint32_t aCh) {
          affectedByKeepAll(GetLineBreakClass(aCh));
 }
 
+// Complex-script break opportunities are computed by the platform line
+// breakers (Uniscribe, Pango, CoreFoundation or the rule-based Thai
+// breaker), which is by far the most expensive part of GetJISx4051Breaks.
+// Re-wrapping a resized container recomputes breaks for the same text over
+// and over, so keep a bounded cache of recently computed complex-script
+// break arrays keyed on the text of the run.
+static const uint32_t kMaxCachedComplexBreakLength = 1024;
+static const uint32_t kMaxCachedComplexBreakEntries = 100;
+
+using ComplexBreakCache = nsClassHashtable<nsStringHashKey, nsTArray<uint8_t>>;
+
+static mozilla::StaticMutex sComplexBreakCacheMutex;
+static mozilla::StaticAutoPtr<ComplexBreakCache> sComplexBreakCache;
+
+static void GetCachedComplexLineBreaks(const char16_t* aText, uint32_t aLength,
+                                       uint8_t* aBreakBefore) {
+  if (aLength > kMaxCachedComplexBreakLength) {
+    NS_GetComplexLineBreaks(aText, aLength, aBreakBefore);
+    return;
+  }
+
+  nsDependentSubstring key(aText, aLength);
+  {
+    mozilla::StaticMutexAutoLock lock(sComplexBreakCacheMutex);
+    if (sComplexBreakCache) {
+      if (nsTArray<uint8_t>* breaks = sComplexBreakCache->Get(key)) {
+        MOZ_ASSERT(breaks->Length() == aLength);
+        memcpy(aBreakBefore, breaks->Elements(), aLength);
+        return;
+      }
+    }
+  }
+
+  NS_GetComplexLineBreaks(aText, aLength, aBreakBefore);
+
+  mozilla::StaticMutexAutoLock lock(sComplexBreakCacheMutex);
+  if (!sComplexBreakCache) {
+    if (!NS_IsMainThread()) {
+      // ClearOnShutdown must be called on the main thread; don't bother
+      // setting up the cache anywhere else.
+      return;
+    }
+    sComplexBreakCache = new ComplexBreakCache();
+    mozilla::ClearOnShutdown(&sComplexBreakCache);
+  }
+  if (sComplexBreakCache->Count() >= kMaxCachedComplexBreakEntries) {
+    sComplexBreakCache->Clear();
+  }
+  auto breaks = mozilla::MakeUnique<nsTArray<uint8_t>>();
+  breaks->AppendElements(aBreakBefore, aLength);
+  sComplexBreakCache->Put(key, std::move(breaks));
+}
+
 void LineBreaker::GetJISx4051Breaks(const char16_t* aChars, uint32_t aLength,
                                     WordBreak aWordBreak, Strictness aLevel,
                                     bool aIsChineseOrJapanese,
@@ -1103,7 +1162,8 @@ void LineBreaker::GetJISx4051Breaks(const char16_t* aChars, uint32_t aLength,
           aBreakBefore[ci - aChars] = true;
         }
       } else {
-        NS_GetComplexLineBreaks(aChars + cur, end - cur, aBreakBefore + cur);
+        GetCachedComplexLineBreaks(aChars + cur, end - cur,
+                                   aBreakBefore + cur);
         // restore breakability at chunk begin, which was always set to false
         // by the complex line breaker
         aBreakBefore[cur] = allowBreak;
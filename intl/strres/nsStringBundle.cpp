@@ -63,8 +63,9 @@ using mozilla::ipc::FileDescriptor;
  * and updated with any other property files which need to be loaded in all
  * content processes.
  */
-static const char kContentBundles[][52] = {
+static const char kContentBundles[][56] = {
     "chrome://branding/locale/brand.properties",
+    "chrome://global-platform/locale/platformKeys.properties",
     "chrome://global/locale/commonDialogs.properties",
     "chrome://global/locale/css.properties",
     "chrome://global/locale/dom/dom.properties",
@@ -78,6 +79,8 @@ static const char kContentBundles[][52] = {
     "chrome://global/locale/svg/svg.properties",
     "chrome://global/locale/xul.properties",
     "chrome://necko/locale/necko.properties",
+    "resource://gre/res/locale/dom/dom.properties",
+    "resource://gre/res/locale/layout/HtmlForm.properties",
 };
 
 static bool IsContentBundle(const nsCString& aUrl) {
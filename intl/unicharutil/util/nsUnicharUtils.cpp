@@ -151,6 +151,11 @@ void ToFoldedCase(nsAString& aString) {
 void ToFoldedCase(const char16_t* aIn, char16_t* aOut, uint32_t aLen) {
   for (uint32_t i = 0; i < aLen; i++) {
     uint32_t ch = aIn[i];
+    // See the equivalent fast path in ToLowerCase in this file.
+    if (MOZ_LIKELY(IS_ASCII(ch))) {
+      aOut[i] = gASCIIToLower[ch];
+      continue;
+    }
     if (i < aLen - 1 && NS_IS_SURROGATE_PAIR(ch, aIn[i + 1])) {
       ch = mozilla::unicode::GetFoldedcase(SURROGATE_TO_UCS4(ch, aIn[i + 1]));
       NS_ASSERTION(!IS_IN_BMP(ch), "case mapping crossed BMP/SMP boundary!");
@@ -243,6 +248,13 @@ uint32_t ToLowerCase(uint32_t aChar) { return ToLowerCase_inline(aChar); }
 void ToLowerCase(const char16_t* aIn, char16_t* aOut, uint32_t aLen) {
   for (uint32_t i = 0; i < aLen; i++) {
     uint32_t ch = aIn[i];
+    // ASCII can be neither a surrogate nor outside the mapping table, so
+    // handle it without the per-character pair check; most strings that come
+    // through here (tag/attribute names, header values) are pure ASCII.
+    if (MOZ_LIKELY(IS_ASCII(ch))) {
+      aOut[i] = gASCIIToLower[ch];
+      continue;
+    }
     if (i < aLen - 1 && NS_IS_SURROGATE_PAIR(ch, aIn[i + 1])) {
       ch = mozilla::unicode::GetLowercase(SURROGATE_TO_UCS4(ch, aIn[i + 1]));
       NS_ASSERTION(!IS_IN_BMP(ch), "case mapping crossed BMP/SMP boundary!");
@@ -275,6 +287,11 @@ uint32_t ToUpperCase(uint32_t aChar) {
 void ToUpperCase(const char16_t* aIn, char16_t* aOut, uint32_t aLen) {
   for (uint32_t i = 0; i < aLen; i++) {
     uint32_t ch = aIn[i];
+    // See the equivalent fast path in ToLowerCase above.
+    if (MOZ_LIKELY(IS_ASCII(ch))) {
+      aOut[i] = IS_ASCII_LOWER(ch) ? ch - 0x20 : ch;
+      continue;
+    }
     if (i < aLen - 1 && NS_IS_SURROGATE_PAIR(ch, aIn[i + 1])) {
       ch = mozilla::unicode::GetUppercase(SURROGATE_TO_UCS4(ch, aIn[i + 1]));
       NS_ASSERTION(!IS_IN_BMP(ch), "case mapping crossed BMP/SMP boundary!");
@@ -116,6 +116,16 @@ void Histogram::Add(int value) {
   Accumulate(value, 1, index);
 }
 
+void Histogram::AddCount(int value, int count) {
+  if (value > kSampleType_MAX - 1) value = kSampleType_MAX - 1;
+  if (value < 0) value = 0;
+  if (count <= 0) return;
+  size_t index = BucketIndex(value);
+  DCHECK_GE(value, ranges(index));
+  DCHECK_LT(value, ranges(index + 1));
+  Accumulate(value, count, index);
+}
+
 void Histogram::Subtract(int value) {
   if (value > kSampleType_MAX - 1) value = kSampleType_MAX - 1;
   if (value < 0) value = 0;
@@ -401,7 +411,7 @@ void Histogram::SampleSet::Resize(const Histogram& histogram) {
 }
 
 void Histogram::SampleSet::Accumulate(Sample value, Count count, size_t index) {
-  DCHECK(count == 1 || count == -1);
+  DCHECK(count >= 1 || count == -1);
   counts_[index] += count;
   redundant_count_ += count;
   sum_ += static_cast<int64_t>(count) * value;
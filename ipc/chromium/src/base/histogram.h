@@ -189,6 +189,9 @@ class Histogram {
   void Add(int value);
   void Subtract(int value);
 
+  // Accept `count` identical samples of `value` in a single call.
+  void AddCount(int value, int count);
+
   // This method is an interface, used only by BooleanHistogram.
   virtual void AddBoolean(bool value);
 
@@ -635,6 +635,7 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
     iov_count++;
 
     // Store remaining segments to write into iovec.
+    bool iov_full = false;
     while (!iter.Done()) {
       char* data = iter.Data();
       size_t size = iter.RemainingInSegment();
@@ -645,11 +646,60 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
         iov[iov_count].iov_base = data;
         iov[iov_count].iov_len = size;
         iov_count++;
+      } else {
+        iov_full = true;
       }
       amt_to_write += size;
       iter.Advance(msg->Buffers(), size);
     }
 
+    // The number of bytes each queued message contributes to this
+    // sendmsg(), used to work out which messages completed afterwards.
+    size_t msg_amounts[kMaxIOVecSize];
+    size_t num_batched = 1;
+    msg_amounts[0] = amt_to_write;
+
+    // Batch the following messages into the same sendmsg() while there is
+    // room in the iovec. A message carrying file descriptors has to start
+    // its own sendmsg() so that its control data travels with its first
+    // bytes. For floods of small messages (input events, vsync) this turns
+    // one system call per message into one per socket buffer.
+    if (!iov_full) {
+      auto it = output_queue_.begin();
+      ++it;  // Skip the message we queued above.
+      for (; it != output_queue_.end() && num_batched < kMaxIOVecSize; ++it) {
+        const Message* next = (*it).get();
+        if (!next->file_descriptor_set()->empty()) {
+          break;
+        }
+
+        size_t iov_count_before = iov_count;
+        size_t next_size = 0;
+        Pickle::BufferList::IterImpl next_iter(next->Buffers());
+        while (!next_iter.Done()) {
+          if (iov_count == kMaxIOVecSize) {
+            iov_full = true;
+            break;
+          }
+          char* data = next_iter.Data();
+          size_t size = next_iter.RemainingInSegment();
+          iov[iov_count].iov_base = data;
+          iov[iov_count].iov_len = size;
+          iov_count++;
+          next_size += size;
+          next_iter.Advance(next->Buffers(), size);
+        }
+        if (iov_full) {
+          // Don't send this message partially; it will start the next
+          // sendmsg().
+          iov_count = iov_count_before;
+          break;
+        }
+        amt_to_write += next_size;
+        msg_amounts[num_batched++] = next_size;
+      }
+    }
+
     msgh.msg_iov = iov;
     msgh.msg_iovlen = iov_count;
 
@@ -700,17 +750,59 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
       }
     }
 
-    if (static_cast<size_t>(bytes_written) != amt_to_write) {
-      // If write() fails with EAGAIN then bytes_written will be -1.
-      if (bytes_written > 0) {
-        MOZ_DIAGNOSTIC_ASSERT(static_cast<size_t>(bytes_written) <
-                              amt_to_write);
-        partial_write_iter_.ref().AdvanceAcrossSegments(msg->Buffers(),
-                                                        bytes_written);
+    // Hand the written bytes out to the batched messages in order. Fully
+    // written messages are popped off the queue; the first incompletely
+    // written one, if any, records its progress in partial_write_iter_.
+    // If write() fails with EAGAIN then bytes_written will be -1.
+    size_t remaining = bytes_written > 0 ? size_t(bytes_written) : 0;
+    bool wrote_all = true;
+    for (size_t i = 0; i < num_batched; i++) {
+      Message* m = output_queue_.FirstElement().get();
+      if (remaining >= msg_amounts[i]) {
+        remaining -= msg_amounts[i];
+
+#if defined(OS_MACOSX)
+        if (!m->file_descriptor_set()->empty())
+          pending_fds_.push_back(
+              PendingDescriptors(m->fd_cookie(), m->file_descriptor_set()));
+#endif
+
+        // Message sent OK!
+
+        if (i > 0) {
+          // Batched messages haven't emitted their start marker yet.
+          AddIPCProfilerMarker(*m, other_pid_, MessageDirection::eSending,
+                               MessagePhase::TransferStart);
+        }
+        AddIPCProfilerMarker(*m, other_pid_, MessageDirection::eSending,
+                             MessagePhase::TransferEnd);
+
+#ifdef IPC_MESSAGE_DEBUG_EXTRA
+        DLOG(INFO) << "sent message @" << m << " on channel @" << this
+                   << " with type " << m->type();
+#endif
+        // This also resets partial_write_iter_.
+        OutputQueuePop();
+        continue;
+      }
+
+      if (remaining > 0) {
+        if (i > 0) {
+          AddIPCProfilerMarker(*m, other_pid_, MessageDirection::eSending,
+                               MessagePhase::TransferStart);
+          Pickle::BufferList::IterImpl it(m->Buffers());
+          partial_write_iter_.emplace(it);
+        }
+        partial_write_iter_.ref().AdvanceAcrossSegments(m->Buffers(),
+                                                        remaining);
         // We should not hit the end of the buffer.
         MOZ_DIAGNOSTIC_ASSERT(!partial_write_iter_.ref().Done());
       }
+      wrote_all = false;
+      break;
+    }
 
+    if (!wrote_all) {
       // Tell libevent to call us back once things are unblocked.
       is_blocked_on_write_ = true;
       MessageLoopForIO::current()->WatchFileDescriptor(
@@ -718,28 +810,9 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
           false,  // One shot
           MessageLoopForIO::WATCH_WRITE, &write_watcher_, this);
       return true;
-    } else {
-      partial_write_iter_.reset();
-
-#if defined(OS_MACOSX)
-      if (!msg->file_descriptor_set()->empty())
-        pending_fds_.push_back(
-            PendingDescriptors(msg->fd_cookie(), msg->file_descriptor_set()));
-#endif
-
-      // Message sent OK!
-
-      AddIPCProfilerMarker(*msg, other_pid_, MessageDirection::eSending,
-                           MessagePhase::TransferEnd);
-
-#ifdef IPC_MESSAGE_DEBUG_EXTRA
-      DLOG(INFO) << "sent message @" << msg << " on channel @" << this
-                 << " with type " << msg->type();
-#endif
-      OutputQueuePop();
-      // msg has been destroyed, so clear the dangling reference.
-      msg = nullptr;
     }
+    // msg has been destroyed, so clear the dangling reference.
+    msg = nullptr;
   }
   return true;
 }
@@ -21,6 +21,7 @@
 #include "mozilla/MozPromise.h"
 #include "mozilla/Services.h"
 #include "mozilla/SpinEventLoopUntil.h"
+#include "mozilla/StaticMutex.h"
 #include "mozilla/StaticPtr.h"
 #include "mozilla/Unused.h"
 #include "mozilla/dom/ContentChild.h"
@@ -143,6 +144,15 @@ class ParentImpl final : public BackgroundParentImpl {
   // create the background thread after application shutdown has started.
   static bool sShutdownHasStarted;
 
+  // Protects sVsyncEventTarget, which can be created from the IO thread when
+  // the first PVsync constructor message arrives.
+  static StaticMutex sVsyncEventTargetMutex;
+
+  // A serial event target that vsync notifications are dispatched to instead
+  // of the background thread, so that ticks never queue behind bulk work such
+  // as IndexedDB traffic. Created lazily and cleared on shutdown.
+  static StaticRefPtr<nsISerialEventTarget> sVsyncEventTarget;
+
   // Only touched on the main thread, null if this is a same-process actor.
   RefPtr<ContentParent> mContent;
 
@@ -249,6 +259,9 @@ class ParentImpl final : public BackgroundParentImpl {
   }
 
   // These methods are only called by IPDL.
+  already_AddRefed<nsISerialEventTarget> GetConstructedEventTarget(
+      const Message& aMsg) override;
+
   virtual void ActorDestroy(ActorDestroyReason aWhy) override;
 };
 
@@ -751,6 +764,10 @@ bool ParentImpl::sShutdownObserverRegistered = false;
 
 bool ParentImpl::sShutdownHasStarted = false;
 
+StaticMutex ParentImpl::sVsyncEventTargetMutex;
+
+StaticRefPtr<nsISerialEventTarget> ParentImpl::sVsyncEventTarget;
+
 // -----------------------------------------------------------------------------
 // ChildImpl Static Members
 // -----------------------------------------------------------------------------
@@ -1270,6 +1287,12 @@ void ParentImpl::ShutdownBackgroundThread() {
   nsCOMPtr<nsITimer> shutdownTimer = sShutdownTimer.get();
   sShutdownTimer = nullptr;
 
+  {
+    // The task queue's pool outlives us and will drain anything still queued.
+    StaticMutexAutoLock lock(sVsyncEventTargetMutex);
+    sVsyncEventTarget = nullptr;
+  }
+
   if (sBackgroundThread) {
     nsCOMPtr<nsIThread> thread = sBackgroundThread.get();
     sBackgroundThread = nullptr;
@@ -1367,6 +1390,31 @@ void ParentImpl::MainThreadActorDestroy() {
   Release();
 }
 
+already_AddRefed<nsISerialEventTarget> ParentImpl::GetConstructedEventTarget(
+    const Message& aMsg) {
+  if (aMsg.type() != PBackground::MessageType::Msg_PVsyncConstructor__ID) {
+    return nullptr;
+  }
+
+  // Vsync notifications are latency-sensitive: a tick that sits in the
+  // background thread's event queue behind bulk IndexedDB or Cache traffic is
+  // stale by the time it is delivered. Dispatch PVsync actors to their own
+  // serial event target instead.
+  StaticMutexAutoLock lock(sVsyncEventTargetMutex);
+
+  if (!sVsyncEventTarget) {
+    nsCOMPtr<nsISerialEventTarget> target;
+    if (NS_WARN_IF(NS_FAILED(NS_CreateBackgroundTaskQueue(
+            "BackgroundVsync", getter_AddRefs(target))))) {
+      return nullptr;
+    }
+
+    sVsyncEventTarget = target.forget();
+  }
+
+  return do_AddRef(sVsyncEventTarget.get());
+}
+
 void ParentImpl::ActorDestroy(ActorDestroyReason aWhy) {
   AssertIsInMainOrSocketProcess();
   AssertIsOnBackgroundThread();
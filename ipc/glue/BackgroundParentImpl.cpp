@@ -715,7 +715,9 @@ bool BackgroundParentImpl::DeallocPParentToChildStreamParent(
 
 BackgroundParentImpl::PVsyncParent* BackgroundParentImpl::AllocPVsyncParent() {
   AssertIsInMainOrSocketProcess();
-  AssertIsOnBackgroundThread();
+  // PVsync messages are routed to a dedicated event target (see
+  // ParentImpl::GetConstructedEventTarget), so unlike the other allocators we
+  // don't run on the background thread here.
 
   RefPtr<mozilla::dom::VsyncParent> actor = new mozilla::dom::VsyncParent();
   actor->UpdateVsyncSource(nullptr);
@@ -726,7 +728,6 @@ BackgroundParentImpl::PVsyncParent* BackgroundParentImpl::AllocPVsyncParent() {
 
 bool BackgroundParentImpl::DeallocPVsyncParent(PVsyncParent* aActor) {
   AssertIsInMainOrSocketProcess();
-  AssertIsOnBackgroundThread();
   MOZ_ASSERT(aActor);
 
   // This actor already has one ref-count. Please check AllocPVsyncParent().
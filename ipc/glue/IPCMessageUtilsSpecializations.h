@@ -280,7 +280,13 @@ struct ParamTraits<nsTArray<E>> {
   static const bool sUseWriteBytes =
       (std::is_integral_v<E> || std::is_floating_point_v<E>);
 
-  static void Write(Message* aMsg, const paramType& aParam) {
+  // Some serializers need to take a mutable reference to their backing
+  // object, such as Shmem segments and Byte Buffers. These serializers take
+  // the backing data and move it into the IPC layer for efficiency. `Write`
+  // uses a forwarding reference so that rvalue arrays pass their elements on
+  // as rvalues, matching IPDLParamTraits<nsTArray<T>>.
+  template <typename U>
+  static void Write(Message* aMsg, U&& aParam) {
     uint32_t length = aParam.Length();
     WriteParam(aMsg, length);
 
@@ -289,10 +295,7 @@ struct ParamTraits<nsTArray<E>> {
       MOZ_RELEASE_ASSERT(ByteLengthIsValid(length, sizeof(E), &pickledLength));
       aMsg->WriteBytes(aParam.Elements(), pickledLength);
     } else {
-      const E* elems = aParam.Elements();
-      for (uint32_t index = 0; index < length; index++) {
-        WriteParam(aMsg, elems[index]);
-      }
+      WriteValues(aMsg, std::forward<U>(aParam));
     }
   }
 
@@ -341,6 +344,26 @@ struct ParamTraits<nsTArray<E>> {
       LogParam(aParam[index], aLog);
     }
   }
+
+ private:
+  // Length has already been written. Const overload.
+  static void WriteValues(Message* aMsg, const nsTArray<E>& aParam) {
+    for (auto& elt : aParam) {
+      WriteParam(aMsg, elt);
+    }
+  }
+
+  // Length has already been written. Rvalue overload.
+  static void WriteValues(Message* aMsg, nsTArray<E>&& aParam) {
+    for (auto& elt : aParam) {
+      WriteParam(aMsg, std::move(elt));
+    }
+
+    // As we just moved all of our values out, let's clean up after ourselves
+    // & clear the input array. This means our move write method will act more
+    // like a traditional move constructor.
+    aParam.Clear();
+  }
 };
 
 template <typename E>
@@ -733,6 +756,18 @@ struct ParamTraits<mozilla::Maybe<T>> {
     }
   }
 
+  // Rvalue overload so that a moved-in Maybe passes its payload on as an
+  // rvalue, for payload types whose serializer can take the backing data.
+  static void Write(Message* msg, paramType&& param) {
+    if (param.isSome()) {
+      WriteParam(msg, true);
+      WriteParam(msg, std::move(param.ref()));
+      param.reset();
+    } else {
+      WriteParam(msg, false);
+    }
+  }
+
   static bool Read(const Message* msg, PickleIterator* iter,
                    paramType* result) {
     bool isSome;
@@ -549,7 +549,9 @@ void IProtocol::DoomSubtree() {
   MOZ_ASSERT(CanSend(), "dooming non-connected actor");
   MOZ_ASSERT(mLifecycleProxy, "dooming zombie actor");
 
-  nsTArray<RefPtr<ActorLifecycleProxy>> managed;
+  // Use inline storage to avoid a heap allocation per actor when walking a
+  // large subtree; most actors manage only a handful of children.
+  AutoTArray<RefPtr<ActorLifecycleProxy>, 16> managed;
   AllManagedActors(managed);
   for (ActorLifecycleProxy* proxy : managed) {
     // Guard against actor being disconnected or destroyed during previous Doom
@@ -581,7 +583,9 @@ void IProtocol::DestroySubtree(ActorDestroyReason aWhy) {
     subtreeWhy = AncestorDeletion;
   }
 
-  nsTArray<RefPtr<ActorLifecycleProxy>> managed;
+  // As in DoomSubtree, use inline storage so that tearing down a tab's worth
+  // of actors doesn't perform an allocation at every level of the walk.
+  AutoTArray<RefPtr<ActorLifecycleProxy>, 16> managed;
   AllManagedActors(managed);
   for (ActorLifecycleProxy* proxy : managed) {
     // Guard against actor being disconnected or destroyed during previous
@@ -839,6 +843,16 @@ already_AddRefed<nsISerialEventTarget> IToplevelProtocol::GetMessageEventTarget(
       return nullptr;
     }
 
+    if (!target) {
+      // Unless the new actor inherits an event target from its manager, give
+      // the listener a chance to assign one. Don't hold the lock while calling
+      // out; GetConstructedEventTarget is required to be stable for a given
+      // message, so dropping it here is safe.
+      lock.reset();
+      target = GetConstructedEventTarget(aMsg);
+      lock.emplace(mEventTargetMutex);
+    }
+
 #ifdef DEBUG
     // If this function is called more than once for the same message, the actor
     // handle ID will already be in the map, but it should have the same target.
@@ -515,6 +515,17 @@ class IToplevelProtocol : public IProtocol {
 
   virtual void OnChannelReceivedMessage(const Message& aMsg) {}
 
+  // Override this to pick an event target for actors that the other side
+  // constructs. The constructor message and every subsequent message for the
+  // new actor are dispatched to the returned event target instead of the
+  // worker thread. Returning null keeps the default dispatch behavior. Must
+  // return the same target every time it is asked about a given message, and
+  // may be called on any thread.
+  virtual already_AddRefed<nsISerialEventTarget> GetConstructedEventTarget(
+      const Message& aMsg) {
+    return nullptr;
+  }
+
   void OnIPCChannelOpened() { ActorConnected(); }
 
   already_AddRefed<nsISerialEventTarget> GetMessageEventTarget(
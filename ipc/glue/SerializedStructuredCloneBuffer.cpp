@@ -0,0 +1,93 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "mozilla/ipc/SerializedStructuredCloneBuffer.h"
+
+#include <string.h>
+
+#include "mozilla/RefPtr.h"
+#include "mozilla/ipc/ProtocolUtils.h"
+#include "mozilla/ipc/SharedMemoryBasic.h"
+
+namespace mozilla {
+namespace ipc {
+
+// Clones at least this big are placed in a fresh shared-memory segment and
+// only the segment handle travels through the channel.  Spilling small
+// clones would cost more (a segment allocation and a handle transfer) than
+// copying them inline with the rest of the message.
+static const size_t kShmemSpillThreshold = 1024 * 1024;
+
+void IPDLParamTraits<mozilla::SerializedStructuredCloneBuffer>::Write(
+    IPC::Message* aMsg, IProtocol* aActor, const paramType& aParam) {
+  size_t size = aParam.data.Size();
+  MOZ_ASSERT(!(size % sizeof(uint64_t)));
+
+  if (aActor && size >= kShmemSpillThreshold) {
+    RefPtr<SharedMemoryBasic> shmem = new SharedMemoryBasic();
+    SharedMemoryBasic::Handle handle;
+    if (shmem->Create(size) && shmem->Map(size) &&
+        shmem->ShareToProcess(aActor->OtherPid(), &handle)) {
+      char* buffer = static_cast<char*>(shmem->memory());
+      aParam.data.ForEachDataChunk([&](const char* aData, size_t aSize) {
+        memcpy(buffer, aData, aSize);
+        buffer += aSize;
+        return true;
+      });
+      WriteIPDLParam(aMsg, aActor, true);
+      WriteIPDLParam(aMsg, aActor, size);
+      WriteIPDLParam(aMsg, aActor, handle);
+      return;
+    }
+    // Creating or sharing the segment failed (e.g. address space or file
+    // descriptor exhaustion); fall back to sending the bytes inline.
+  }
+
+  WriteIPDLParam(aMsg, aActor, false);
+  IPC::WriteParam(aMsg, aParam.data);
+}
+
+bool IPDLParamTraits<mozilla::SerializedStructuredCloneBuffer>::Read(
+    const IPC::Message* aMsg, PickleIterator* aIter, IProtocol* aActor,
+    paramType* aResult) {
+  bool isShmem = false;
+  if (!ReadIPDLParam(aMsg, aIter, aActor, &isShmem)) {
+    return false;
+  }
+
+  if (!isShmem) {
+    return IPC::ReadParam(aMsg, aIter, &aResult->data);
+  }
+
+  size_t size = 0;
+  SharedMemoryBasic::Handle handle;
+  if (!ReadIPDLParam(aMsg, aIter, aActor, &size) ||
+      !ReadIPDLParam(aMsg, aIter, aActor, &handle)) {
+    return false;
+  }
+
+  RefPtr<SharedMemoryBasic> shmem = new SharedMemoryBasic();
+  if (!shmem->IsHandleValid(handle) ||
+      !shmem->SetHandle(handle, SharedMemory::RightsReadOnly) ||
+      !shmem->Map(size)) {
+    return false;
+  }
+
+  // JSStructuredCloneData's BufferList owns its segments outright, so the
+  // mapping can't be adopted wholesale; copy out of it.  The payload still
+  // never traversed the channel, and the segment is released as soon as we
+  // return.
+  JSStructuredCloneData data(JS::StructuredCloneScope::DifferentProcess);
+  if (!data.AppendBytes(static_cast<const char*>(shmem->memory()), size)) {
+    return false;
+  }
+
+  aResult->data = std::move(data);
+  return true;
+}
+
+}  // namespace ipc
+}  // namespace mozilla
@@ -19,6 +19,7 @@
 #include "mozilla/Assertions.h"
 #include "mozilla/BufferList.h"
 #include "mozilla/Vector.h"
+#include "mozilla/ipc/IPDLParamTraits.h"
 #include "mozilla/mozalloc.h"
 class PickleIterator;
 
@@ -127,4 +128,29 @@ struct ParamTraits<mozilla::SerializedStructuredCloneBuffer> {
 
 }  // namespace IPC
 
+namespace mozilla {
+namespace ipc {
+
+// Serialization used when the buffer travels inside an IPDL struct
+// (ClonedMessageData).  Unlike the plain ParamTraits above, this has access
+// to the actor, which lets large clones spill into a freshly created
+// shared-memory segment whose handle is sent in place of the payload, so
+// that big postMessage()-style flows never traverse the channel itself.
+template <>
+struct IPDLParamTraits<mozilla::SerializedStructuredCloneBuffer> {
+  typedef mozilla::SerializedStructuredCloneBuffer paramType;
+
+  static void Write(IPC::Message* aMsg, IProtocol* aActor,
+                    const paramType& aParam);
+  static bool Read(const IPC::Message* aMsg, PickleIterator* aIter,
+                   IProtocol* aActor, paramType* aResult);
+
+  static void Log(const paramType& aParam, std::wstring* aLog) {
+    IPC::LogParam(aParam.data.Size(), aLog);
+  }
+};
+
+}  // namespace ipc
+}  // namespace mozilla
+
 #endif /* __IPC_GLUE_SERIALIZEDSTRUCTUREDCLONEBUFFER_H__ */
@@ -47,6 +47,11 @@ class RefCounted {
     }
   }
 
+  bool hasOneRef() const {
+    MOZ_ASSERT(mRefCnt > 0);
+    return mRefCnt == 1;
+  }
+
  private:
   mutable MozRefCountType mRefCnt;
 };
@@ -82,6 +87,13 @@ class AtomicRefCounted {
     }
   }
 
+  // Thread-safe only when the caller holds one of the references: no other
+  // thread can mint a new reference from a count of one in that case.
+  bool hasOneRef() const {
+    MOZ_ASSERT(mRefCnt > 0);
+    return mRefCnt == 1;
+  }
+
  private:
   mutable mozilla::Atomic<MozRefCountType> mRefCnt{0};
 };
@@ -381,6 +381,110 @@ static UCollator* NewUCollator(JSContext* cx,
   return coll;
 }
 
+// Primary collation weights for the ASCII characters handled by
+// FastCompareChars below, or 0 for characters it must not handle. The
+// relative order matches the root collation: space sorts before digits,
+// digits before letters, and upper and lower case of the same letter
+// share a primary weight.
+static const uint8_t kFastCollationPrimary[128] = {
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 0,  0,  0,  0,  0,  0,
+    0,  12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26,
+    27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 0,  0,  0,  0,  0,
+    0,  12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26,
+    27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 0,  0,  0,  0,  0,
+};
+
+/**
+ * Returns true if |coll| is an untailored collator with the default
+ * attribute settings, i.e. one whose results on the character subset
+ * covered by kFastCollationPrimary match the table.
+ */
+static bool CanFastCompare(UCollator* coll) {
+  // Tailored collations may reorder or contract ASCII characters (for
+  // example Danish treats "aa" as a single letter).
+  int32_t rulesLength = 0;
+  ucol_getRules(coll, &rulesLength);
+  if (rulesLength != 0) {
+    return false;
+  }
+
+  static const struct {
+    UColAttribute attribute;
+    UColAttributeValue value;
+  } kRequiredAttributes[] = {
+      {UCOL_STRENGTH, UCOL_TERTIARY},
+      {UCOL_CASE_FIRST, UCOL_OFF},
+      {UCOL_CASE_LEVEL, UCOL_OFF},
+      {UCOL_ALTERNATE_HANDLING, UCOL_NON_IGNORABLE},
+      {UCOL_NUMERIC_COLLATION, UCOL_OFF},
+  };
+  for (const auto& required : kRequiredAttributes) {
+    UErrorCode status = U_ZERO_ERROR;
+    if (ucol_getAttribute(coll, required.attribute, &status) !=
+            required.value ||
+        U_FAILURE(status)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Compares two Latin-1 strings the way an untailored collator with
+ * default attributes would, writing -1, 0 or 1 to |*result| and
+ * returning true. Returns false without touching |*result| if either
+ * string contains a character outside the subset covered by
+ * kFastCollationPrimary.
+ */
+static bool FastCompareChars(const JS::Latin1Char* chars1, size_t length1,
+                             const JS::Latin1Char* chars2, size_t length2,
+                             int32_t* result) {
+  size_t minLength = length1 < length2 ? length1 : length2;
+  for (size_t i = 0; i < minLength; i++) {
+    JS::Latin1Char c1 = chars1[i];
+    JS::Latin1Char c2 = chars2[i];
+    uint8_t weight1 = c1 < 128 ? kFastCollationPrimary[c1] : 0;
+    uint8_t weight2 = c2 < 128 ? kFastCollationPrimary[c2] : 0;
+    if (!weight1 || !weight2) {
+      return false;
+    }
+    if (weight1 != weight2) {
+      *result = weight1 < weight2 ? -1 : 1;
+      return true;
+    }
+  }
+
+  if (length1 != length2) {
+    // The longer string wins on primary weight, but only if its tail
+    // stays within the supported subset: an unsupported character could
+    // be ignorable and make the strings compare equal.
+    const JS::Latin1Char* rest = length1 < length2 ? chars2 : chars1;
+    size_t restLength = length1 < length2 ? length2 : length1;
+    for (size_t i = minLength; i < restLength; i++) {
+      if (rest[i] >= 128 || !kFastCollationPrimary[rest[i]]) {
+        return false;
+      }
+    }
+    *result = length1 < length2 ? -1 : 1;
+    return true;
+  }
+
+  // Equal primary weights throughout, so the strings can only differ in
+  // letter case. The first case difference breaks the tie, lower case
+  // first.
+  for (size_t i = 0; i < length1; i++) {
+    if (chars1[i] != chars2[i]) {
+      *result = chars1[i] >= 'a' ? -1 : 1;
+      return true;
+    }
+  }
+  *result = 0;
+  return true;
+}
+
 static bool intl_CompareStrings(JSContext* cx, UCollator* coll,
                                 HandleString str1, HandleString str2,
                                 MutableHandleValue result) {
@@ -392,6 +496,33 @@ static bool intl_CompareStrings(JSContext* cx, UCollator* coll,
     return true;
   }
 
+  // Sorting arrays of plain ASCII strings (file names, identifiers) is
+  // common enough to be worth answering from a table when the collator
+  // is indistinguishable from the root collation on such input.
+  if (str1->hasLatin1Chars() && str2->hasLatin1Chars() &&
+      CanFastCompare(coll)) {
+    JSLinearString* linear1 = str1->ensureLinear(cx);
+    if (!linear1) {
+      return false;
+    }
+    JSLinearString* linear2 = str2->ensureLinear(cx);
+    if (!linear2) {
+      return false;
+    }
+    int32_t res;
+    bool compared;
+    {
+      JS::AutoCheckCannotGC nogc;
+      compared =
+          FastCompareChars(linear1->latin1Chars(nogc), linear1->length(),
+                           linear2->latin1Chars(nogc), linear2->length(), &res);
+    }
+    if (compared) {
+      result.setInt32(res);
+      return true;
+    }
+  }
+
   AutoStableStringChars stableChars1(cx);
   if (!stableChars1.initTwoByte(cx, str1)) {
     return false;
@@ -199,6 +199,7 @@ struct MOZ_STACK_CLASS DebuggerObject::CallData {
   bool setPropertyMethod();
   bool getOwnPropertyNamesMethod();
   bool getOwnPropertySymbolsMethod();
+  bool getOwnPropertyCursorMethod();
   bool getOwnPropertyDescriptorMethod();
   bool preventExtensionsMethod();
   bool sealMethod();
@@ -799,6 +800,10 @@ bool DebuggerObject::CallData::getOwnPropertySymbolsMethod() {
   return true;
 }
 
+bool DebuggerObject::CallData::getOwnPropertyCursorMethod() {
+  return DebuggerObject::getOwnPropertyCursor(cx, object, args.rval());
+}
+
 bool DebuggerObject::CallData::getOwnPropertyDescriptorMethod() {
   RootedId id(cx);
   if (!ToPropertyKey(cx, args.get(0), &id)) {
@@ -1562,6 +1567,7 @@ const JSFunctionSpec DebuggerObject::methods_[] = {
     JS_DEBUG_FN("setProperty", setPropertyMethod, 0),
     JS_DEBUG_FN("getOwnPropertyNames", getOwnPropertyNamesMethod, 0),
     JS_DEBUG_FN("getOwnPropertySymbols", getOwnPropertySymbolsMethod, 0),
+    JS_DEBUG_FN("getOwnPropertyCursor", getOwnPropertyCursorMethod, 0),
     JS_DEBUG_FN("getOwnPropertyDescriptor", getOwnPropertyDescriptorMethod, 1),
     JS_DEBUG_FN("preventExtensions", preventExtensionsMethod, 0),
     JS_DEBUG_FN("seal", sealMethod, 0),
@@ -2060,6 +2066,197 @@ bool DebuggerObject::getOwnPropertySymbols(JSContext* cx,
   return result.append(ids.begin(), ids.end());
 }
 
+// A cursor over a snapshot of a debuggee object's own property keys, handed
+// out by Debugger.Object.prototype.getOwnPropertyCursor. The keys are
+// enumerated once, when the cursor is created; property descriptors are only
+// materialized in batches as take() is called, so a consumer paging through
+// an object with a huge number of properties never blocks on one monolithic
+// walk.
+
+enum {
+  PROPERTY_CURSOR_OWNER_SLOT,
+  PROPERTY_CURSOR_KEYS_SLOT,
+  PROPERTY_CURSOR_INDEX_SLOT,
+  PROPERTY_CURSOR_RESERVED_SLOTS
+};
+
+static const JSClass PropertyCursorClass = {
+    "PropertyCursor",
+    JSCLASS_HAS_RESERVED_SLOTS(PROPERTY_CURSOR_RESERVED_SLOTS)};
+
+static NativeObject* PropertyCursor_checkThis(JSContext* cx,
+                                              const CallArgs& args) {
+  JSObject* thisobj = RequireObject(cx, args.thisv());
+  if (!thisobj) {
+    return nullptr;
+  }
+  if (thisobj->getClass() != &PropertyCursorClass) {
+    JS_ReportErrorNumberASCII(cx, GetErrorMessage, nullptr,
+                              JSMSG_INCOMPATIBLE_PROTO, "PropertyCursor",
+                              "method", thisobj->getClass()->name);
+    return nullptr;
+  }
+  return &thisobj->as<NativeObject>();
+}
+
+// take([count]): materialize descriptors for the next count (default 100)
+// keys in the snapshot. Returns an array of { key, descriptor } entries, or
+// null once the cursor is exhausted. Keys whose property has been deleted
+// since the snapshot was taken get a null descriptor, like
+// getOwnPropertyDescriptor.
+static bool PropertyCursor_take(JSContext* cx, unsigned argc, Value* vp) {
+  CallArgs args = CallArgsFromVp(argc, vp);
+  RootedNativeObject cursor(cx, PropertyCursor_checkThis(cx, args));
+  if (!cursor) {
+    return false;
+  }
+
+  uint32_t batchSize = 100;
+  if (args.hasDefined(0)) {
+    if (!JS::ToUint32(cx, args[0], &batchSize)) {
+      return false;
+    }
+    if (batchSize == 0) {
+      JS_ReportErrorASCII(cx, "PropertyCursor.take expects a nonzero count");
+      return false;
+    }
+  }
+
+  Rooted<DebuggerObject*> owner(
+      cx, &cursor->getReservedSlot(PROPERTY_CURSOR_OWNER_SLOT)
+               .toObject()
+               .as<DebuggerObject>());
+  RootedArrayObject keys(cx, &cursor->getReservedSlot(PROPERTY_CURSOR_KEYS_SLOT)
+                                  .toObject()
+                                  .as<ArrayObject>());
+
+  uint32_t index =
+      uint32_t(cursor->getReservedSlot(PROPERTY_CURSOR_INDEX_SLOT).toInt32());
+  uint32_t length = keys->length();
+  if (index >= length) {
+    args.rval().setNull();
+    return true;
+  }
+
+  uint32_t end = index + std::min(batchSize, length - index);
+
+  RootedArrayObject result(cx, NewDenseEmptyArray(cx));
+  if (!result) {
+    return false;
+  }
+
+  RootedAtom keyAtom(cx, Atomize(cx, "key", 3));
+  if (!keyAtom) {
+    return false;
+  }
+  RootedId keyId(cx, AtomToId(keyAtom));
+  RootedAtom descriptorAtom(cx, Atomize(cx, "descriptor", 10));
+  if (!descriptorAtom) {
+    return false;
+  }
+  RootedId descriptorId(cx, AtomToId(descriptorAtom));
+
+  RootedValue keyValue(cx);
+  RootedId id(cx);
+  RootedValue descValue(cx);
+  for (uint32_t i = index; i < end; i++) {
+    keyValue = keys->getDenseElement(i);
+    if (!ToPropertyKey(cx, keyValue, &id)) {
+      return false;
+    }
+
+    Rooted<PropertyDescriptor> desc(cx);
+    if (!DebuggerObject::getOwnPropertyDescriptor(cx, owner, id, &desc)) {
+      return false;
+    }
+    if (!JS::FromPropertyDescriptor(cx, desc, &descValue)) {
+      return false;
+    }
+
+    RootedPlainObject entry(cx, NewBuiltinClassInstance<PlainObject>(cx));
+    if (!entry) {
+      return false;
+    }
+    if (!DefineDataProperty(cx, entry, keyId, keyValue) ||
+        !DefineDataProperty(cx, entry, descriptorId, descValue)) {
+      return false;
+    }
+
+    RootedValue entryValue(cx, ObjectValue(*entry));
+    if (!NewbornArrayPush(cx, result, entryValue)) {
+      return false;
+    }
+  }
+
+  cursor->setReservedSlot(PROPERTY_CURSOR_INDEX_SLOT, Int32Value(int32_t(end)));
+
+  args.rval().setObject(*result);
+  return true;
+}
+
+static const JSFunctionSpec PropertyCursor_methods[] = {
+    JS_FN("take", PropertyCursor_take, 1, 0), JS_FS_END};
+
+/* static */
+bool DebuggerObject::getOwnPropertyCursor(JSContext* cx,
+                                          HandleDebuggerObject object,
+                                          MutableHandleValue result) {
+  RootedObject referent(cx, object->referent());
+
+  RootedIdVector ids(cx);
+  {
+    Maybe<AutoRealm> ar;
+    EnterDebuggeeObjectRealm(cx, ar, referent);
+
+    ErrorCopier ec(ar);
+    if (!GetPropertyKeys(cx, referent,
+                         JSITER_OWNONLY | JSITER_HIDDEN | JSITER_SYMBOLS,
+                         &ids)) {
+      return false;
+    }
+  }
+
+  for (size_t i = 0; i < ids.length(); i++) {
+    cx->markId(ids[i]);
+  }
+
+  Rooted<IdVector> idVector(cx, IdVector(cx));
+  if (!idVector.append(ids.begin(), ids.end())) {
+    return false;
+  }
+
+  RootedObject keys(cx, IdVectorToArray(cx, idVector));
+  if (!keys) {
+    return false;
+  }
+
+  RootedObject cursorObj(cx,
+                         NewObjectWithGivenProto(cx, &PropertyCursorClass,
+                                                 nullptr));
+  if (!cursorObj) {
+    return false;
+  }
+  RootedNativeObject cursor(cx, &cursorObj->as<NativeObject>());
+
+  cursor->setReservedSlot(PROPERTY_CURSOR_OWNER_SLOT, ObjectValue(*object));
+  cursor->setReservedSlot(PROPERTY_CURSOR_KEYS_SLOT, ObjectValue(*keys));
+  cursor->setReservedSlot(PROPERTY_CURSOR_INDEX_SLOT, Int32Value(0));
+
+  if (!JS_DefineFunctions(cx, cursor, PropertyCursor_methods)) {
+    return false;
+  }
+
+  RootedValue countValue(cx, NumberValue(double(idVector.length())));
+  if (!JS_DefineProperty(cx, cursor, "count", countValue,
+                         JSPROP_READONLY | JSPROP_ENUMERATE |
+                             JSPROP_PERMANENT)) {
+    return false;
+  }
+
+  result.setObject(*cursor);
+  return true;
+}
+
 /* static */
 bool DebuggerObject::getOwnPropertyDescriptor(
     JSContext* cx, HandleDebuggerObject object, HandleId id,
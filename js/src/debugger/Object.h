@@ -109,6 +109,9 @@ class DebuggerObject : public NativeObject {
   static MOZ_MUST_USE bool getOwnPropertySymbols(
       JSContext* cx, HandleDebuggerObject object,
       MutableHandle<IdVector> result);
+  static MOZ_MUST_USE bool getOwnPropertyCursor(JSContext* cx,
+                                                HandleDebuggerObject object,
+                                                MutableHandleValue result);
   static MOZ_MUST_USE bool getOwnPropertyDescriptor(
       JSContext* cx, HandleDebuggerObject object, HandleId id,
       MutableHandle<PropertyDescriptor> desc);
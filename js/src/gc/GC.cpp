@@ -514,6 +514,9 @@ inline size_t Arena::finalize(JSFreeOp* fop, AllocKind thingKind,
       thingKind == AllocKind::FAT_INLINE_STRING) {
     zone->markedStrings += nmarked;
     zone->finalizedStrings += nfinalized;
+  } else if (thingKind == AllocKind::BIGINT) {
+    zone->markedBigInts += nmarked;
+    zone->finalizedBigInts += nfinalized;
   }
 
   if (nmarked == 0) {
@@ -4175,6 +4178,8 @@ void GCRuntime::endPreparePhase(JS::GCReason reason) {
 
     zone->markedStrings = 0;
     zone->finalizedStrings = 0;
+    zone->markedBigInts = 0;
+    zone->finalizedBigInts = 0;
 
     zone->setPreservingCode(false);
 
@@ -6432,7 +6437,7 @@ void GCRuntime::finishCollection() {
 
   clearBufferedGrayRoots();
 
-  maybeStopStringPretenuring();
+  maybeStopPretenuring();
 
   {
     AutoLockGC lock(this);
@@ -6477,32 +6482,54 @@ void GCRuntime::checkGCStateNotInUse() {
 #endif
 }
 
-void GCRuntime::maybeStopStringPretenuring() {
+void GCRuntime::maybeStopPretenuring() {
   for (GCZonesIter zone(this); !zone.done(); zone.next()) {
-    if (zone->allocNurseryStrings) {
+    bool resumeNurseryStrings = false;
+    if (!zone->allocNurseryStrings) {
+      // Count the number of strings before the major GC.
+      size_t numStrings = zone->markedStrings + zone->finalizedStrings;
+      double rate = double(zone->finalizedStrings) / double(numStrings);
+      resumeNurseryStrings = rate > tunables.stopPretenureStringThreshold();
+    }
+
+    bool resumeNurseryBigInts = false;
+    if (!zone->allocNurseryBigInts) {
+      // As for strings: if most tenured BigInts died during this major GC
+      // then the zone has stopped producing long-lived BigInts and
+      // pretenuring them just creates more tenured garbage.
+      size_t numBigInts = zone->markedBigInts + zone->finalizedBigInts;
+      double rate = double(zone->finalizedBigInts) / double(numBigInts);
+      resumeNurseryBigInts = rate > tunables.stopPretenureStringThreshold();
+    }
+
+    if (!resumeNurseryStrings && !resumeNurseryBigInts) {
       continue;
     }
 
-    // Count the number of strings before the major GC.
-    size_t numStrings = zone->markedStrings + zone->finalizedStrings;
-    double rate = double(zone->finalizedStrings) / double(numStrings);
-    if (rate > tunables.stopPretenureStringThreshold()) {
-      CancelOffThreadIonCompile(zone);
-      bool preserving = zone->isPreservingCode();
-      zone->setPreservingCode(false);
-      zone->discardJitCode(rt->defaultFreeOp());
-      zone->setPreservingCode(preserving);
-      for (RealmsInZoneIter r(zone); !r.done(); r.next()) {
-        if (jit::JitRealm* jitRealm = r->jitRealm()) {
-          jitRealm->discardStubs();
+    CancelOffThreadIonCompile(zone);
+    bool preserving = zone->isPreservingCode();
+    zone->setPreservingCode(false);
+    zone->discardJitCode(rt->defaultFreeOp());
+    zone->setPreservingCode(preserving);
+    for (RealmsInZoneIter r(zone); !r.done(); r.next()) {
+      if (jit::JitRealm* jitRealm = r->jitRealm()) {
+        jitRealm->discardStubs();
+        if (resumeNurseryStrings) {
           jitRealm->setStringsCanBeInNursery(true);
         }
       }
+    }
 
+    if (resumeNurseryStrings) {
       zone->markedStrings = 0;
       zone->finalizedStrings = 0;
       zone->allocNurseryStrings = true;
     }
+    if (resumeNurseryBigInts) {
+      zone->markedBigInts = 0;
+      zone->finalizedBigInts = 0;
+      zone->allocNurseryBigInts = true;
+    }
   }
 }
 
@@ -105,6 +105,9 @@ class MarkStack {
 
     Cell* ptr() const;
 
+    // For prefetchNextEntry().
+    friend class MarkStack;
+
    public:
     TaggedPtr() = default;
     TaggedPtr(Tag tag, Cell* ptr);
@@ -168,6 +171,12 @@ class MarkStack {
   TaggedPtr popPtr();
   SlotsOrElementsRange popSlotsOrElementsRange();
 
+  // Hint the prefetcher at the cell referenced by the entry below the top,
+  // so that by the time the next processMarkStackTop() call pops it the
+  // header and mark bits are on their way in.  Marking is dominated by these
+  // cold reads.
+  void prefetchNextEntry() const;
+
   void clear() {
     // Fall back to the smaller initial capacity so we don't hold on to excess
     // memory between GCs.
@@ -1889,6 +1889,7 @@ inline void GCMarker::processMarkStackTop(SliceBudget& budget) {
   size_t end;                // End of slot range to mark.
 
   gc::MarkStack& stack = currentStack();
+  stack.prefetchNextEntry();
 
   switch (stack.peekTag()) {
     case MarkStack::SlotsOrElementsRangeTag: {
@@ -2267,6 +2268,18 @@ inline const MarkStack::TaggedPtr& MarkStack::peekPtr() const {
   return stack()[topIndex_ - 1];
 }
 
+inline void MarkStack::prefetchNextEntry() const {
+  // If the top entry is a value range this word is in the middle of the
+  // range entry rather than a cell pointer; prefetching an arbitrary
+  // address is harmless and ranges scan memory we're touching anyway, so
+  // it isn't worth distinguishing here.
+  if (topIndex_ >= 2) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(stack()[topIndex_ - 2].ptr());
+#endif
+  }
+}
+
 inline MarkStack::Tag MarkStack::peekTag() const { return peekPtr().tag(); }
 
 inline MarkStack::TaggedPtr MarkStack::popPtr() {
@@ -986,7 +986,17 @@ void js::Nursery::collect(JSGCInvocationKind kind, JS::GCReason reason) {
   stats().beginNurseryCollection(reason);
   gcprobes::MinorGCStart();
 
-  stringDeDupSet.emplace();
+  // There is no need for a deduplication set if strings are tenure-allocated;
+  // no nursery string will ever reach moveToTenured. Pre-size the set so the
+  // first few thousand tenured strings don't pay for incremental rehashing.
+  // An OOM here simply disables deduplication for this collection.
+  if (canAllocateStrings_) {
+    static const uint32_t InitialStringDeDupSetCapacity = 1024;
+    stringDeDupSet.emplace();
+    if (!stringDeDupSet->reserve(InitialStringDeDupSetCapacity)) {
+      stringDeDupSet.reset();
+    }
+  }
   auto guardStringDedupSet =
       mozilla::MakeScopeExit([&] { stringDeDupSet.reset(); });
 
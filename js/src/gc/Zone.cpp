@@ -152,6 +152,8 @@ JS::Zone::Zone(JSRuntime* rt, Kind kind)
       nurseryAllocatedStrings(this, 0),
       markedStrings(this, 0),
       finalizedStrings(this, 0),
+      markedBigInts(this, 0),
+      finalizedBigInts(this, 0),
       allocNurseryStrings(this, true),
       allocNurseryBigInts(this, true),
       suppressAllocationMetadataBuilder(this, false),
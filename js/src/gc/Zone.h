@@ -201,6 +201,10 @@ class Zone : public js::ZoneAllocator, public js::gc::GraphNodeBase<JS::Zone> {
   js::ZoneOrGCTaskData<size_t> markedStrings;
   js::ZoneOrGCTaskData<size_t> finalizedStrings;
 
+  // Number of marked/finalized BigInts during major GC.
+  js::ZoneOrGCTaskData<size_t> markedBigInts;
+  js::ZoneOrGCTaskData<size_t> finalizedBigInts;
+
   js::ZoneData<bool> allocNurseryStrings;
   js::ZoneData<bool> allocNurseryBigInts;
 
@@ -565,6 +565,14 @@ bool CompilePattern(JSContext* cx, MutableHandleRegExpShared re,
                     HandleLinearString input, RegExpShared::CodeKind codeKind) {
   RootedAtom pattern(cx, re->getSource());
   JS::RegExpFlags flags = re->getFlags();
+
+  // Another zone may already have compiled this pattern to bytecode; copying
+  // it is much cheaper than running the parser and compiler below.
+  if (codeKind == RegExpShared::CodeKind::Bytecode &&
+      RegExpShared::tryCompileFromCache(cx, re, input->hasLatin1Chars())) {
+    return true;
+  }
+
   LifoAllocScope allocScope(&cx->tempLifoAlloc());
   HandleScope handleScope(cx->isolate);
   Zone zone(allocScope.alloc());
@@ -655,6 +663,10 @@ bool CompilePattern(JSContext* cx, MutableHandleRegExpShared re,
     case AssembleResult::Success:
       break;
   }
+
+  if (!useNativeCode) {
+    RegExpShared::shareByteCode(cx, re, isLatin1);
+  }
   return true;
 }
 
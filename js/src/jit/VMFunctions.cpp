@@ -25,6 +25,7 @@
 #include "js/friend/WindowProxy.h"    // js::IsWindow
 #include "js/Printf.h"
 #include "vm/ArrayObject.h"
+#include "vm/Caches.h"              // js::MegamorphicCache
 #include "vm/EqualityOperations.h"  // js::StrictlyEqual
 #include "vm/Interpreter.h"
 #include "vm/PlainObject.h"  // js::PlainObject
@@ -37,6 +38,7 @@
 #include "jit/BaselineFrame-inl.h"
 #include "jit/VMFunctionList-inl.h"
 #include "vm/Interpreter-inl.h"
+#include "vm/JSContext-inl.h"
 #include "vm/JSScript-inl.h"
 #include "vm/NativeObject-inl.h"
 #include "vm/PlainObject-inl.h"  // js::CreateThis
@@ -1951,12 +1953,42 @@ static MOZ_ALWAYS_INLINE bool GetNativeDataPropertyPure(JSContext* cx,
 
   MOZ_ASSERT(JSID_IS_ATOM(id) || JSID_IS_SYMBOL(id));
 
+  MegamorphicCache& cache = cx->caches().megamorphicCache;
+  Shape* receiverShape = obj->lastProperty();
+
+  MegamorphicCache::Entry* entry;
+  if (cache.lookup(receiverShape, id, &entry)) {
+    if (entry->isMissingProperty()) {
+      vp->setUndefined();
+      return true;
+    }
+    NativeObject* holder = obj;
+    for (uint8_t i = 0, numHops = entry->numHops(); i < numHops; i++) {
+      JSObject* proto = holder->staticPrototype();
+      if (MOZ_UNLIKELY(!proto || !proto->isNative())) {
+        holder = nullptr;
+        break;
+      }
+      holder = &proto->as<NativeObject>();
+    }
+    // The proto chain may have changed since the entry was added. In that
+    // case the holder's shape no longer matches and we fall through to the
+    // full lookup below, which refreshes the entry.
+    if (holder && holder->lastProperty() == entry->holderShape()) {
+      *vp = holder->getSlot(entry->slot());
+      return true;
+    }
+  }
+
+  size_t numHops = 0;
   while (true) {
     if (Shape* shape = obj->lastProperty()->search(cx, id)) {
       if (!shape->isDataProperty()) {
         return false;
       }
 
+      cache.initEntryForDataProperty(entry, receiverShape, id, numHops,
+                                     obj->lastProperty(), shape->slot());
       *vp = obj->getSlot(shape->slot());
       return true;
     }
@@ -1977,6 +2009,7 @@ static MOZ_ALWAYS_INLINE bool GetNativeDataPropertyPure(JSContext* cx,
 
     JSObject* proto = obj->staticPrototype();
     if (!proto) {
+      cache.initEntryForMissingProperty(entry, receiverShape, id);
       vp->setUndefined();
       return true;
     }
@@ -1985,6 +2018,7 @@ static MOZ_ALWAYS_INLINE bool GetNativeDataPropertyPure(JSContext* cx,
       return false;
     }
     obj = &proto->as<NativeObject>();
+    numHops++;
   }
 }
 
@@ -1287,6 +1287,20 @@ ArrayBufferObject* ArrayBufferObject::createZeroed(
   return buffer;
 }
 
+ArrayBufferObject* ArrayBufferObject::createUninitialized(
+    JSContext* cx, BufferSize nbytes, HandleObject proto /* = nullptr */) {
+  // 24.1.1.1, step 3 (Inlined 6.2.6.1 CreateByteDataBlock, step 2).
+  if (!CheckArrayBufferTooLarge(cx, nbytes.get())) {
+    return nullptr;
+  }
+
+  AutoSetNewObjectMetadata metadata(cx);
+  auto [buffer, toFill] = createBufferAndData<FillContents::Uninitialized>(
+      cx, nbytes, metadata, proto);
+  Unused << toFill;
+  return buffer;
+}
+
 ArrayBufferObject* ArrayBufferObject::createForTypedObject(JSContext* cx,
                                                            BufferSize nbytes) {
   ArrayBufferObject* buffer = createZeroed(cx, nbytes);
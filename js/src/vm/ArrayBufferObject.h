@@ -361,6 +361,12 @@ class ArrayBufferObject : public ArrayBufferObjectMaybeShared {
   static ArrayBufferObject* createZeroed(JSContext* cx, BufferSize nbytes,
                                          HandleObject proto = nullptr);
 
+  // Like createZeroed, but the contents are left uninitialized.  The caller
+  // must fill the entire buffer before it can become visible to content.
+  static ArrayBufferObject* createUninitialized(JSContext* cx,
+                                                BufferSize nbytes,
+                                                HandleObject proto = nullptr);
+
   static ArrayBufferObject* createForTypedObject(JSContext* cx,
                                                  BufferSize nbytes);
 
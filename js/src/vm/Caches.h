@@ -7,10 +7,14 @@
 #ifndef vm_Caches_h
 #define vm_Caches_h
 
+#include "mozilla/HashFunctions.h"  // mozilla::HashGeneric
+
 #include <new>
 
 #include "frontend/SourceNotes.h"  // SrcNote
 #include "gc/Tracer.h"
+#include "irregexp/RegExpTypes.h"  // irregexp::ByteArray
+#include "js/RegExpFlags.h"        // JS::RegExpFlags
 #include "js/RootingAPI.h"
 #include "js/TypeDecls.h"
 #include "js/UniquePtr.h"
@@ -262,6 +266,180 @@ class StringToAtomCache {
   void purge() { map_.clearAndCompact(); }
 };
 
+// Cache for the megamorphic property lookups performed by jitcode (see
+// GetNativeDataPropertyPure in jit/VMFunctions.cpp), keyed on the receiver's
+// shape and the property key. An entry records where a previous lookup ended
+// up: either the proto chain hop count, shape and slot of the holder of a
+// data property, or the fact that the property was missing.
+//
+// A data property hit re-walks the hops on the receiver's current proto chain
+// and then checks the holder's shape, so it relies on the same invariant as
+// the shape teleporting optimization (see the comment in jit/CacheIR.cpp):
+// any mutation that changes the result of such a lookup also changes the
+// shape of the holder. Missing property entries have no holder shape to
+// check, so the whole cache is invalidated, by bumping |generation_|,
+// whenever a property is added to an object used as a prototype (see
+// ReshapeForShadowedProp) and whenever a prototype is mutated (see SetProto).
+// The cache holds unbarriered shape and key pointers, so it is also
+// invalidated on major GC.
+class MegamorphicCache {
+ public:
+  class Entry {
+    // Receiver object's shape.
+    Shape* shape_ = nullptr;
+
+    // Atom or symbol property being accessed.
+    jsid key_ = JSID_VOID;
+
+    // Shape of the holder object, or nullptr for a missing property.
+    Shape* holderShape_ = nullptr;
+
+    // Slot of the data property on the holder.
+    uint32_t slot_ = 0;
+
+    // Number of hops on the proto chain from the receiver to the holder, or
+    // NumHopsForMissingProperty.
+    uint8_t numHops_ = 0;
+
+    // The entry is only valid if this matches the cache's generation.
+    uint16_t generation_ = 0;
+
+    friend class MegamorphicCache;
+
+    void init(Shape* shape, jsid key, uint16_t generation, Shape* holderShape,
+              uint8_t numHops, uint32_t slot) {
+      shape_ = shape;
+      key_ = key;
+      holderShape_ = holderShape;
+      slot_ = slot;
+      numHops_ = numHops;
+      generation_ = generation;
+    }
+
+   public:
+    static constexpr uint8_t NumHopsForMissingProperty = UINT8_MAX;
+    static constexpr uint8_t MaxNumHops = UINT8_MAX - 1;
+
+    bool isMissingProperty() const {
+      return numHops_ == NumHopsForMissingProperty;
+    }
+    uint8_t numHops() const {
+      MOZ_ASSERT(!isMissingProperty());
+      return numHops_;
+    }
+    Shape* holderShape() const {
+      MOZ_ASSERT(!isMissingProperty());
+      return holderShape_;
+    }
+    uint32_t slot() const {
+      MOZ_ASSERT(!isMissingProperty());
+      return slot_;
+    }
+  };
+
+ private:
+  static constexpr size_t NumEntries = 1024;
+  Entry entries_[NumEntries];
+  uint16_t generation_ = 0;
+
+  Entry& getEntry(Shape* shape, jsid key) {
+    uintptr_t hash = mozilla::HashGeneric(shape, JSID_BITS(key));
+    return entries_[hash % NumEntries];
+  }
+
+ public:
+  void bumpGeneration() {
+    generation_++;
+    if (MOZ_UNLIKELY(generation_ == 0)) {
+      // The generation wrapped around, so there may be stale entries with a
+      // matching generation. Throw away all entries.
+      for (Entry& entry : entries_) {
+        entry = Entry();
+      }
+    }
+  }
+
+  bool lookup(Shape* shape, jsid key, Entry** entryp) {
+    Entry& entry = getEntry(shape, key);
+    *entryp = &entry;
+    return (entry.shape_ == shape && entry.key_ == key &&
+            entry.generation_ == generation_);
+  }
+
+  void initEntryForMissingProperty(Entry* entry, Shape* shape, jsid key) {
+    entry->init(shape, key, generation_, nullptr,
+                Entry::NumHopsForMissingProperty, 0);
+  }
+
+  void initEntryForDataProperty(Entry* entry, Shape* shape, jsid key,
+                                size_t numHops, Shape* holderShape,
+                                uint32_t slot) {
+    if (numHops > Entry::MaxNumHops) {
+      return;
+    }
+    entry->init(shape, key, generation_, holderShape, uint8_t(numHops), slot);
+  }
+};
+
+class RegExpShared;
+
+// A runtime-wide cache of regexp interpreter bytecode, keyed by pattern
+// characters, flags, and the character width the bytecode was specialized
+// for. RegExpShareds and their jitcode are zone-local, so a page that runs
+// the same third-party script in many iframes recompiles identical patterns
+// once per zone. Interpreter bytecode is position-independent and holds no
+// GC pointers, so on a hit a fresh RegExpShared simply copies it and skips
+// the irregexp parser and compiler. Tier-up to jitcode is unaffected.
+//
+// Patterns that turn into simple atom matches never reach the compiler, and
+// patterns with named captures reference a zone-local groups template; both
+// kinds are left uncached, as are patterns exceeding the size limits below.
+class RegExpBytecodeCache {
+  struct Key {
+    UniquePtr<char16_t[], JS::FreePolicy> chars;
+    uint32_t length = 0;
+    JS::RegExpFlags flags = JS::RegExpFlag::NoFlags;
+    bool latin1 = false;
+  };
+
+  struct Value {
+    irregexp::ByteArray byteCode;
+    uint32_t maxRegisters = 0;
+    uint32_t pairCount = 0;
+  };
+
+  struct Lookup {
+    JSAtom* pattern;
+    JS::RegExpFlags flags;
+    bool latin1;
+  };
+
+  struct KeyHasher {
+    using Lookup = RegExpBytecodeCache::Lookup;
+    static HashNumber hash(const Lookup& l);
+    static bool match(const Key& key, const Lookup& l);
+  };
+
+  using Map = HashMap<Key, Value, KeyHasher, SystemAllocPolicy>;
+  Map map_;
+
+  static const size_t MaxEntries = 256;
+  static const size_t MaxPatternLength = 1024;
+  static const size_t MaxByteCodeLength = 16 * 1024;
+
+ public:
+  // On a hit, equip |re| with a copy of the cached bytecode and metadata and
+  // return true. A miss, or a failure to copy, returns false and the caller
+  // compiles as usual.
+  bool tryCompile(RegExpShared* re, bool latin1);
+
+  // Offer |re|'s freshly compiled bytecode to other zones. Failure to cache
+  // is not an error.
+  void maybeAdd(RegExpShared* re, bool latin1);
+
+  void purge() { map_.clearAndCompact(); }
+};
+
 class RuntimeCaches {
  public:
   js::GSNCache gsnCache;
@@ -269,6 +447,8 @@ class RuntimeCaches {
   js::UncompressedSourceCache uncompressedSourceCache;
   js::EvalCache evalCache;
   js::StringToAtomCache stringToAtomCache;
+  js::MegamorphicCache megamorphicCache;
+  js::RegExpBytecodeCache regExpBytecodeCache;
 
   void purgeForMinorGC(JSRuntime* rt) {
     newObjectCache.clearNurseryObjects(rt);
@@ -279,12 +459,14 @@ class RuntimeCaches {
     newObjectCache.purge();
     evalCache.clear();
     stringToAtomCache.purge();
+    megamorphicCache.bumpGeneration();
   }
 
   void purge() {
     purgeForCompaction();
     gsnCache.purge();
     uncompressedSourceCache.purge();
+    regExpBytecodeCache.purge();
   }
 };
 
@@ -19,6 +19,7 @@
 #include "vm/Realm.h"
 
 #include "vm/NativeObject-inl.h"
+#include "vm/PlainObject-inl.h"  // js::CopyInitializerObject
 
 using namespace js;
 
@@ -46,6 +47,8 @@ JSONParserBase::~JSONParserBase() {
 }
 
 void JSONParserBase::trace(JSTracer* trc) {
+  TraceNullableRoot(trc, &lastFinishedObject_,
+                    "JSONParserBase::lastFinishedObject_");
   for (auto& elem : stack) {
     if (elem.state == FinishArrayElement) {
       elem.elements().trace(trc);
@@ -576,12 +579,54 @@ JSONParserBase::Token JSONParser<CharT>::advanceAfterProperty() {
   return token(Error);
 }
 
+inline PlainObject* JSONParserBase::createFinishedObject(
+    PropertyVector& properties) {
+  // Large payloads are typically arrays of objects with identical layouts -
+  // rows of a table. If the last object finished has exactly the properties
+  // about to be defined, in the same order, reuse its shape and write the
+  // values straight into their slots instead of defining every property from
+  // scratch.
+  if (lastFinishedObject_ && !lastFinishedObject_->inDictionaryMode() &&
+      lastFinishedObject_->getDenseInitializedLength() == 0 &&
+      lastFinishedObject_->slotSpan() == properties.length()) {
+    Shape* shape = lastFinishedObject_->lastProperty();
+    bool sameLayout = true;
+    for (size_t i = properties.length(); i > 0;
+         i--, shape = shape->previous()) {
+      if (shape->isEmptyShape() || !shape->isDataProperty() ||
+          shape->slot() != i - 1 || shape->propid() != properties[i - 1].id) {
+        sameLayout = false;
+        break;
+      }
+    }
+    if (sameLayout && shape->isEmptyShape()) {
+      Rooted<PlainObject*> last(cx, lastFinishedObject_);
+      PlainObject* obj = CopyInitializerObject(cx, last);
+      if (!obj) {
+        return nullptr;
+      }
+      for (size_t i = 0; i < properties.length(); i++) {
+        obj->initSlot(i, properties[i].value);
+      }
+      lastFinishedObject_ = obj;
+      return obj;
+    }
+  }
+
+  JSObject* obj = NewPlainObjectWithProperties(
+      cx, properties.begin(), properties.length(), GenericObject);
+  if (!obj) {
+    return nullptr;
+  }
+  lastFinishedObject_ = &obj->as<PlainObject>();
+  return lastFinishedObject_;
+}
+
 inline bool JSONParserBase::finishObject(MutableHandleValue vp,
                                          PropertyVector& properties) {
   MOZ_ASSERT(&properties == &stack.back().properties());
 
-  JSObject* obj = NewPlainObjectWithProperties(
-      cx, properties.begin(), properties.length(), GenericObject);
+  PlainObject* obj = createFinishedObject(properties);
   if (!obj) {
     return false;
   }
@@ -17,6 +17,8 @@
 
 namespace js {
 
+class PlainObject;
+
 // JSONParser base class. JSONParser is templatized to work on either Latin1
 // or TwoByte input strings, JSONParserBase holds all state and methods that
 // can be shared between the two encodings.
@@ -117,6 +119,12 @@ class MOZ_STACK_CLASS JSONParserBase {
   Vector<ElementVector*, 5> freeElements;
   Vector<PropertyVector*, 5> freeProperties;
 
+  // The object created by the most recent call to finishObject. Large
+  // payloads are typically arrays of objects with identical layouts, so the
+  // next object finished very often can reuse this object's shape; see
+  // createFinishedObject.
+  PlainObject* lastFinishedObject_;
+
 #ifdef DEBUG
   Token lastToken;
 #endif
@@ -126,7 +134,8 @@ class MOZ_STACK_CLASS JSONParserBase {
         parseType(parseType),
         stack(cx),
         freeElements(cx),
-        freeProperties(cx)
+        freeProperties(cx),
+        lastFinishedObject_(nullptr)
 #ifdef DEBUG
         ,
         lastToken(Error)
@@ -142,7 +151,8 @@ class MOZ_STACK_CLASS JSONParserBase {
         parseType(other.parseType),
         stack(std::move(other.stack)),
         freeElements(std::move(other.freeElements)),
-        freeProperties(std::move(other.freeProperties))
+        freeProperties(std::move(other.freeProperties)),
+        lastFinishedObject_(other.lastFinishedObject_)
 #ifdef DEBUG
         ,
         lastToken(std::move(other.lastToken))
@@ -196,6 +206,7 @@ class MOZ_STACK_CLASS JSONParserBase {
 
   bool errorReturn();
 
+  PlainObject* createFinishedObject(PropertyVector& properties);
   bool finishObject(MutableHandleValue vp, PropertyVector& properties);
   bool finishArray(MutableHandleValue vp, ElementVector& elements);
 
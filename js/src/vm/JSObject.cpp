@@ -1879,6 +1879,10 @@ static bool SetProto(JSContext* cx, HandleObject obj,
     return false;
   }
 
+  // A proto mutation can change the result of lookups recorded in the
+  // megamorphic cache without changing the shape of the receiver.
+  cx->caches().megamorphicCache.bumpGeneration();
+
   if (proto.isObject()) {
     RootedObject protoObj(cx, proto.toObject());
     if (!JSObject::setDelegate(cx, protoObj)) {
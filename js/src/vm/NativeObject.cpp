@@ -24,6 +24,7 @@
 #include "js/Result.h"
 #include "js/Value.h"
 #include "util/Memory.h"
+#include "vm/Caches.h"              // js::MegamorphicCache
 #include "vm/EqualityOperations.h"  // js::SameValue
 #include "vm/PlainObject.h"         // js::PlainObject
 #include "vm/TypedArrayObject.h"
@@ -32,6 +33,7 @@
 #include "vm/ArrayObject-inl.h"
 #include "vm/BytecodeLocation-inl.h"
 #include "vm/EnvironmentObject-inl.h"
+#include "vm/JSContext-inl.h"
 #include "vm/JSObject-inl.h"
 #include "vm/JSScript-inl.h"
 #include "vm/Shape-inl.h"
@@ -1263,6 +1265,11 @@ static MOZ_ALWAYS_INLINE bool ReshapeForShadowedProp(JSContext* cx,
     return true;
   }
 
+  // A property added to a prototype object can make a property which the
+  // megamorphic cache recorded as missing appear on the proto chain of other
+  // objects, without changing the shape of those objects.
+  cx->caches().megamorphicCache.bumpGeneration();
+
   return ReshapeForShadowedPropSlow(cx, obj.as<NativeObject>(), id);
 }
 
@@ -33,15 +33,22 @@ enum class OffThread { Compile, Decode };
 static bool CanDoOffThread(JSContext* cx, const ReadOnlyCompileOptions& options,
                            size_t length, OffThread what) {
   static const size_t TINY_LENGTH = 5 * 1000;
+  static const size_t TINY_STENCIL_LENGTH = 1 * 1000;
   static const size_t HUGE_SRC_LENGTH = 100 * 1000;
   static const size_t HUGE_BC_LENGTH = 367 * 1000;
 
   // These are heuristics which the caller may choose to ignore (e.g., for
   // testing purposes).
   if (!options.forceAsync) {
-    // Compiling off the main thread inolves creating a new Zone and other
-    // significant overheads.  Don't bother if the script is tiny.
-    if (length < TINY_LENGTH) {
+    // Compiling off the main thread with a parse global involves creating a
+    // new Zone and other significant overheads.  Don't bother if the script
+    // is tiny.  Stencil-based parse tasks skip the parse global entirely and
+    // are much cheaper to set up, so for them only really tiny scripts are
+    // better off staying on the main thread; pages commonly carry dozens of
+    // 1-2KB scripts whose parses can all overlap this way.
+    size_t tinyLength =
+        options.useOffThreadParseGlobal ? TINY_LENGTH : TINY_STENCIL_LENGTH;
+    if (length < tinyLength) {
       return false;
     }
 
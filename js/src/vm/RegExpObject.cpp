@@ -6,6 +6,7 @@
 
 #include "vm/RegExpObject.h"
 
+#include "mozilla/HashFunctions.h"
 #include "mozilla/MemoryReporting.h"
 #include "mozilla/PodOperations.h"
 
@@ -24,6 +25,8 @@
 #include "js/RegExpFlags.h"  // JS::RegExpFlags
 #include "js/StableStringChars.h"
 #include "util/StringBuffer.h"
+#include "util/Text.h"
+#include "vm/Caches.h"
 #include "vm/MatchPairs.h"
 #include "vm/RegExpStatics.h"
 #include "vm/StringType.h"
@@ -33,6 +36,7 @@
 #endif
 #include "vm/Xdr.h"
 
+#include "vm/JSContext-inl.h"
 #include "vm/JSObject-inl.h"
 #include "vm/NativeObject-inl.h"
 #include "vm/Shape-inl.h"
@@ -613,6 +617,125 @@ void RegExpShared::finalize(JSFreeOp* fop) {
   tables.~JitCodeTables();
 }
 
+HashNumber RegExpBytecodeCache::KeyHasher::hash(const Lookup& l) {
+  JS::AutoCheckCannotGC nogc;
+  HashNumber hash =
+      l.pattern->hasLatin1Chars()
+          ? mozilla::HashString(l.pattern->latin1Chars(nogc),
+                                l.pattern->length())
+          : mozilla::HashString(l.pattern->twoByteChars(nogc),
+                                l.pattern->length());
+  return mozilla::AddToHash(hash, l.flags.value(), l.latin1);
+}
+
+bool RegExpBytecodeCache::KeyHasher::match(const Key& key, const Lookup& l) {
+  if (!(key.flags == l.flags) || key.latin1 != l.latin1 ||
+      key.length != l.pattern->length()) {
+    return false;
+  }
+  JS::AutoCheckCannotGC nogc;
+  return l.pattern->hasLatin1Chars()
+             ? EqualChars(key.chars.get(), l.pattern->latin1Chars(nogc),
+                          key.length)
+             : EqualChars(key.chars.get(), l.pattern->twoByteChars(nogc),
+                          key.length);
+}
+
+bool RegExpBytecodeCache::tryCompile(RegExpShared* re, bool latin1) {
+  JSAtom* pattern = re->getSource();
+  if (pattern->length() > MaxPatternLength) {
+    return false;
+  }
+
+  Map::Ptr p = map_.lookup(Lookup{pattern, re->getFlags(), latin1});
+  if (!p) {
+    return false;
+  }
+
+  const Value& cached = p->value();
+  size_t allocSize = sizeof(uint32_t) + cached.byteCode->length;
+  auto* copy = static_cast<RegExpShared::ByteCode*>(js_malloc(allocSize));
+  if (!copy) {
+    return false;
+  }
+  memcpy(copy, cached.byteCode.get(), allocSize);
+
+  if (re->kind() == RegExpShared::Kind::Unparsed) {
+    re->useRegExpMatch(cached.pairCount);
+  }
+  MOZ_ASSERT(re->pairCount() == cached.pairCount);
+  re->updateMaxRegisters(cached.maxRegisters);
+  re->setByteCode(copy, latin1);
+  AddCellMemory(re, copy->length, MemoryUse::RegExpSharedBytecode);
+  return true;
+}
+
+void RegExpBytecodeCache::maybeAdd(RegExpShared* re, bool latin1) {
+  MOZ_ASSERT(re->kind() == RegExpShared::Kind::RegExp);
+
+  // The groups template for named captures is a zone-local object.
+  if (re->numNamedCaptures() > 0) {
+    return;
+  }
+
+  JSAtom* pattern = re->getSource();
+  RegExpShared::ByteCode* byteCode = re->getByteCode(latin1);
+  MOZ_ASSERT(byteCode);
+  if (pattern->length() > MaxPatternLength ||
+      byteCode->length > MaxByteCodeLength) {
+    return;
+  }
+
+  Lookup l{pattern, re->getFlags(), latin1};
+  Map::AddPtr p = map_.lookupForAdd(l);
+  if (p) {
+    return;
+  }
+
+  // Keep the cache bounded. Dropping everything is crude, but the working
+  // set of a page is rebuilt quickly and stays hot from then on.
+  if (map_.count() >= MaxEntries) {
+    purge();
+    p = map_.lookupForAdd(l);
+  }
+
+  Key key;
+  key.length = pattern->length();
+  key.flags = re->getFlags();
+  key.latin1 = latin1;
+  key.chars.reset(js_pod_malloc<char16_t>(key.length));
+  if (!key.chars) {
+    return;
+  }
+  CopyChars(key.chars.get(), *pattern);
+
+  Value value;
+  size_t allocSize = sizeof(uint32_t) + byteCode->length;
+  value.byteCode.reset(
+      static_cast<irregexp::ByteArrayData*>(js_malloc(allocSize)));
+  if (!value.byteCode) {
+    return;
+  }
+  memcpy(value.byteCode.get(), byteCode, allocSize);
+  value.maxRegisters = re->getMaxRegisters();
+  value.pairCount = re->pairCount();
+
+  (void)map_.add(p, std::move(key), std::move(value));
+}
+
+/* static */
+bool RegExpShared::tryCompileFromCache(JSContext* cx,
+                                       MutableHandleRegExpShared re,
+                                       bool latin1) {
+  return cx->caches().regExpBytecodeCache.tryCompile(re.get(), latin1);
+}
+
+/* static */
+void RegExpShared::shareByteCode(JSContext* cx, HandleRegExpShared re,
+                                 bool latin1) {
+  cx->caches().regExpBytecodeCache.maybeAdd(re.get(), latin1);
+}
+
 /* static */
 bool RegExpShared::compileIfNecessary(JSContext* cx,
                                       MutableHandleRegExpShared re,
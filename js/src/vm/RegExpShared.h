@@ -149,6 +149,11 @@ class RegExpShared
   static bool compileIfNecessary(JSContext* cx, MutableHandleRegExpShared res,
                                  HandleLinearString input, CodeKind code);
 
+  // Runtime-wide bytecode cache hooks; see RegExpBytecodeCache in vm/Caches.h.
+  static bool tryCompileFromCache(JSContext* cx, MutableHandleRegExpShared re,
+                                  bool latin1);
+  static void shareByteCode(JSContext* cx, HandleRegExpShared re, bool latin1);
+
   static RegExpRunStatus executeAtom(MutableHandleRegExpShared re,
                                      HandleLinearString input, size_t start,
                                      VectorMatchPairs* matches);
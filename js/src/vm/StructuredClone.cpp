@@ -2316,8 +2316,11 @@ bool JSStructuredCloneReader::readDataView(uint32_t byteLength,
 
 bool JSStructuredCloneReader::readArrayBuffer(uint32_t nbytes,
                                               MutableHandleValue vp) {
+  // The contents are overwritten in full by readArray below, so don't pay to
+  // zero them first: worker pipelines routinely post hundreds of megabytes of
+  // ArrayBuffer data and the extra pass over the pages is measurable.
   JSObject* obj =
-      ArrayBufferObject::createZeroed(context(), BufferSize(nbytes));
+      ArrayBufferObject::createUninitialized(context(), BufferSize(nbytes));
   if (!obj) {
     return false;
   }
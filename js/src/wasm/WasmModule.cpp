@@ -72,8 +72,17 @@ class Module::Tier2GeneratorTaskImpl : public Tier2GeneratorTask {
   void runHelperThreadTask(AutoLockHelperThreadState& locked) override {
     {
       AutoUnlockHelperThreadState unlock(locked);
-      CompileTier2(*compileArgs_, bytecode_->bytes, *module_, &cancelled_,
-                   telemetrySender_);
+
+      // Tier-2 tasks are low priority and can sit in the queue for a long
+      // time.  If in the interim every other reference to the module was
+      // dropped - common when short-lived iframes instantiate large modules -
+      // then nothing can ever call the optimized code, so don't burn helper
+      // thread time producing it.  Observing a count of one is stable here
+      // because this task holds that one reference.
+      if (!module_->hasOneRef() && !cancelled_) {
+        CompileTier2(*compileArgs_, bytecode_->bytes, *module_, &cancelled_,
+                     telemetrySender_);
+      }
     }
 
     // During shutdown the main thread will wait for any ongoing (cancelled)
@@ -1004,12 +1004,13 @@ void ScriptPreloader::FinishOffThreadDecode(JS::OffThreadToken* token) {
   mMonitor.AssertNotCurrentThreadOwns();
   MOZ_ASSERT(token);
 
-  auto cleanup = MakeScopeExit([&]() {
-    mParsingSources.clear();
-    mParsingScripts.clear();
+  // Move the completed batch aside and issue the next one before
+  // instantiating the finished scripts, so the decode threads keep working
+  // ahead of demand while the main thread is busy below.
+  Vector<CachedScript*> parsedScripts = std::move(mParsingScripts);
+  mParsingSources.clear();
 
-    DecodeNextBatch(OFF_THREAD_CHUNK_SIZE);
-  });
+  DecodeNextBatch(OFF_THREAD_CHUNK_SIZE);
 
   AutoSafeJSAPI jsapi;
   JSContext* cx = jsapi.cx();
@@ -1027,7 +1028,7 @@ void ScriptPreloader::FinishOffThreadDecode(JS::OffThreadToken* token) {
   Unused << JS::FinishMultiOffThreadScriptsDecoder(cx, token, &jsScripts);
 
   unsigned i = 0;
-  for (auto script : mParsingScripts) {
+  for (auto script : parsedScripts) {
     LOG(Debug, "Finished off-thread decode of %s\n", script->mURL.get());
     if (i < jsScripts.length()) {
       script->mScript.Set(jsScripts[i++]);
@@ -112,6 +112,11 @@ URLPreloader::~URLPreloader() {
     UnregisterWeakMemoryReporter(this);
     sInitialized = false;
   }
+  if (mOpenObserverRegistered) {
+    IOInterposer::Unregister(IOInterposeObserver::OpCreateOrOpen,
+                             &mStartupOpenObserver);
+    mOpenObserverRegistered = false;
+  }
 }
 
 Result<Ok, nsresult> URLPreloader::InitInternal() {
@@ -145,6 +150,13 @@ Result<Ok, nsresult> URLPreloader::InitInternal() {
 
   MOZ_TRY(NS_GetSpecialDirectory("ProfLDS", getter_AddRefs(mProfD)));
 
+  // Watch for main-thread file opens for the rest of the startup window, so
+  // that profile files read synchronously outside the preloader can be warmed
+  // by the next session's background read pass.
+  IOInterposer::Register(IOInterposeObserver::OpCreateOrOpen,
+                         &mStartupOpenObserver);
+  mOpenObserverRegistered = true;
+
   return Ok();
 }
 
@@ -538,6 +550,74 @@ Result<nsCString, nsresult> URLPreloader::ReadURIInternal(nsIURI* uri,
   return URLEntry::ReadLocation(location);
 }
 
+/* static */ void URLPreloader::NoteJarRead(nsIFile* jarFile,
+                                            const nsACString& entry) {
+  if (!sInitialized || !NS_IsMainThread()) {
+    return;
+  }
+
+  // Only entries in the Omnijar archives are supported by the cache; reads
+  // from other JAR files are ignored.
+  bool equals;
+  nsCOMPtr<nsIFile> jar = Omnijar::GetPath(Omnijar::GRE);
+  if (jar && NS_SUCCEEDED(jar->Equals(jarFile, &equals)) && equals) {
+    GetSingleton().NoteReadInternal(CacheKey(CacheKey::TypeGREJar, entry));
+    return;
+  }
+
+  jar = Omnijar::GetPath(Omnijar::APP);
+  if (jar && NS_SUCCEEDED(jar->Equals(jarFile, &equals)) && equals) {
+    GetSingleton().NoteReadInternal(CacheKey(CacheKey::TypeAppJar, entry));
+  }
+}
+
+/* static */ void URLPreloader::NoteFileRead(nsIFile* file) {
+  if (!sInitialized || !NS_IsMainThread()) {
+    return;
+  }
+
+  // Only files in the profile directory are recorded. Pre-loading arbitrary
+  // filesystem reads (such as a file: load of a user document) would risk
+  // filling the next session's read pass with large, irrelevant files.
+  auto& preloader = GetSingleton();
+  bool contained;
+  if (!preloader.mProfD ||
+      NS_FAILED(preloader.mProfD->Contains(file, &contained)) || !contained) {
+    return;
+  }
+
+  preloader.NoteReadInternal(CacheKey(file));
+}
+
+void URLPreloader::StartupOpenObserver::Observe(Observation& aObservation) {
+  if (!IsMainThread() || !sInitialized) {
+    return;
+  }
+
+  nsAutoString filename;
+  aObservation.Filename(filename);
+  if (filename.IsEmpty()) {
+    return;
+  }
+
+  nsCOMPtr<nsIFile> file;
+  if (NS_FAILED(NS_NewLocalFile(filename, false, getter_AddRefs(file)))) {
+    return;
+  }
+
+  // NoteFileRead discards anything outside the profile directory.
+  NoteFileRead(file);
+}
+
+void URLPreloader::NoteReadInternal(const CacheKey& key) {
+  if (mStartupFinished) {
+    return;
+  }
+
+  auto entry = mCachedURLs.LookupOrAdd(key, key);
+  entry->UpdateUsedTime();
+}
+
 Result<URLPreloader::CacheKey, nsresult> URLPreloader::ResolveURI(nsIURI* uri) {
   nsCString spec;
   nsCString scheme;
@@ -670,6 +750,12 @@ nsresult URLPreloader::Observe(nsISupports* subject, const char* topic,
   if (!strcmp(topic, DELAYED_STARTUP_TOPIC)) {
     obs->RemoveObserver(this, DELAYED_STARTUP_TOPIC);
     mStartupFinished = true;
+
+    if (mOpenObserverRegistered) {
+      IOInterposer::Unregister(IOInterposeObserver::OpCreateOrOpen,
+                               &mStartupOpenObserver);
+      mOpenObserverRegistered = false;
+    }
   }
 
   return NS_OK;
@@ -9,6 +9,7 @@
 #include "mozilla/DataMutex.h"
 #include "mozilla/FileLocation.h"
 #include "mozilla/HashFunctions.h"
+#include "mozilla/IOInterposer.h"
 #include "mozilla/LinkedList.h"
 #include "mozilla/MemoryReporting.h"
 #include "mozilla/Monitor.h"
@@ -82,14 +83,35 @@ class URLPreloader final : public nsIObserver, public nsIMemoryReporter {
                                              const nsACString& path,
                                              ReadType readType = Forget);
 
+  // Helpers to record a synchronous read which happened outside the
+  // preloader, such as a jar: or file: channel opened during startup, so
+  // that the next session's background read pass can warm the entry before
+  // it is needed. The contents are not read or cached this session, and
+  // reads which happen after startup is complete, or which are not backed
+  // by an Omnijar archive or a file in the profile directory, are ignored.
+  static void NoteJarRead(nsIFile* jarFile, const nsACString& entry);
+
+  static void NoteFileRead(nsIFile* file);
+
  private:
   struct CacheKey;
 
+  // Observes main-thread file opens reported to the IOInterposer during the
+  // startup window and feeds profile files to NoteFileRead, so that direct
+  // nsIFile consumers are recorded for the next session's background read
+  // pass the same way file channel loads are.
+  class StartupOpenObserver final : public IOInterposeObserver {
+   public:
+    void Observe(Observation& aObservation) override;
+  };
+
   Result<nsCString, nsresult> ReadInternal(const CacheKey& key,
                                            ReadType readType);
 
   Result<nsCString, nsresult> ReadURIInternal(nsIURI* uri, ReadType readType);
 
+  void NoteReadInternal(const CacheKey& key);
+
   Result<nsCString, nsresult> ReadFileInternal(nsIFile* file,
                                                ReadType readType);
 
@@ -287,6 +309,12 @@ class URLPreloader final : public nsIObserver, public nsIMemoryReporter {
   bool mStartupFinished = false;
   bool mReaderInitialized = false;
 
+  StartupOpenObserver mStartupOpenObserver;
+
+  // Whether mStartupOpenObserver is currently registered with the
+  // IOInterposer.
+  bool mOpenObserverRegistered = false;
+
   // Only to be accessed from the cache write thread.
   bool mCacheWritten = false;
 
@@ -10,6 +10,7 @@
 #define xpcmaps_h___
 
 #include "mozilla/MemoryReporting.h"
+#include "mozilla/MruCache.h"
 
 #include "js/GCHashTable.h"
 
@@ -115,8 +116,16 @@ class Native2WrappedNativeMap {
 
   inline XPCWrappedNative* Find(nsISupports* Obj) const {
     MOZ_ASSERT(Obj, "bad param");
+    auto cached = mRecentlyUsed.Lookup(Obj);
+    if (cached) {
+      return cached.Data().mWrapper;
+    }
     auto entry = static_cast<Entry*>(mTable.Search(Obj));
-    return entry ? entry->value : nullptr;
+    if (!entry) {
+      return nullptr;
+    }
+    cached.Set(RecentWrapper{Obj, entry->value});
+    return entry->value;
   }
 
   inline XPCWrappedNative* Add(XPCWrappedNative* wrapper) {
@@ -132,18 +141,51 @@ class Native2WrappedNativeMap {
     }
     entry->key = obj;
     entry->value = wrapper;
+    mRecentlyUsed.Put(obj, RecentWrapper{obj, wrapper});
     return wrapper;
   }
 
-  inline void Clear() { mTable.Clear(); }
+  inline void Clear() {
+    mRecentlyUsed.Clear();
+    mTable.Clear();
+  }
 
   inline uint32_t Count() { return mTable.EntryCount(); }
 
-  PLDHashTable::Iterator Iter() { return mTable.Iter(); }
+  // Callers may remove entries through the iterator (e.g. when sweeping
+  // dying wrappers), which the MRU cache cannot observe, so drop the cache
+  // whenever an iterator is handed out.
+  PLDHashTable::Iterator Iter() {
+    mRecentlyUsed.Clear();
+    return mTable.Iter();
+  }
 
   size_t SizeOfIncludingThis(mozilla::MallocSizeOf mallocSizeOf) const;
 
  private:
+  struct RecentWrapper {
+    nsISupports* mKey;
+    XPCWrappedNative* mWrapper;
+  };
+
+  // Chrome JS tends to cross into the same few XPCOM objects (pref branches,
+  // observer service subjects, ...) over and over, so keep a small MRU cache
+  // in front of the hashtable. Entries are non-owning, exactly like the
+  // table's own; every mutation path (Add, Clear, iterator removal) either
+  // updates or drops the cache.
+  class RecentWrapperCache
+      : public mozilla::MruCache<nsISupports*, RecentWrapper,
+                                 RecentWrapperCache> {
+   public:
+    static mozilla::HashNumber Hash(nsISupports* const& aKey) {
+      return mozilla::HashGeneric(aKey);
+    }
+    static bool Match(nsISupports* const& aKey, const RecentWrapper& aVal) {
+      return aVal.mKey == aKey;
+    }
+  };
+  mutable RecentWrapperCache mRecentlyUsed;
+
   PLDHashTable mTable;
 };
 
@@ -711,7 +711,17 @@ bool DisplayPortUtils::SetDisplayPortMargins(nsIContent* aContent,
     return false;
   }
 
-  if (currentData && currentData->mMargins.mVisualOffset != CSSPoint() &&
+  // APZ resends its current margins with most repaint requests, so during a
+  // main-thread scroll handoff the margins are usually unchanged. In that
+  // case the stored property would be identical and the displayport rects
+  // computed before and after it equal (both reflect the already-applied
+  // scroll position), so skip the property churn and the invalidation work
+  // and only keep the expiration and frame visibility bookkeeping running.
+  bool marginsChanged = !currentData || currentData->mPriority != aPriority ||
+                        currentData->mMargins != aMargins;
+
+  if (marginsChanged && currentData &&
+      currentData->mMargins.mVisualOffset != CSSPoint() &&
       aMargins.mVisualOffset == CSSPoint()) {
     // If we hit this, then it's possible that we're setting a displayport
     // that is wrong because the old one had a layout/visual adjustment and
@@ -725,20 +735,22 @@ bool DisplayPortUtils::SetDisplayPortMargins(nsIContent* aContent,
 
   nsRect oldDisplayPort;
   bool hadDisplayPort = false;
-  bool wasPainted = GetWasDisplayPortPainted(aContent);
-  if (scrollFrame) {
-    // We only use the two return values from this function to call
-    // InvalidateForDisplayPortChange. InvalidateForDisplayPortChange does
-    // nothing if aContent does not have a frame. So getting the displayport is
-    // useless if the content has no frame, so we avoid calling this to avoid
-    // triggering a warning about not having a frame.
-    hadDisplayPort = GetHighResolutionDisplayPort(aContent, &oldDisplayPort);
-  }
+  if (marginsChanged) {
+    bool wasPainted = GetWasDisplayPortPainted(aContent);
+    if (scrollFrame) {
+      // We only use the two return values from this function to call
+      // InvalidateForDisplayPortChange. InvalidateForDisplayPortChange does
+      // nothing if aContent does not have a frame. So getting the displayport
+      // is useless if the content has no frame, so we avoid calling this to
+      // avoid triggering a warning about not having a frame.
+      hadDisplayPort = GetHighResolutionDisplayPort(aContent, &oldDisplayPort);
+    }
 
-  aContent->SetProperty(
-      nsGkAtoms::DisplayPortMargins,
-      new DisplayPortMarginsPropertyData(aMargins, aPriority, wasPainted),
-      nsINode::DeleteProperty<DisplayPortMarginsPropertyData>);
+    aContent->SetProperty(
+        nsGkAtoms::DisplayPortMargins,
+        new DisplayPortMarginsPropertyData(aMargins, aPriority, wasPainted),
+        nsINode::DeleteProperty<DisplayPortMarginsPropertyData>);
+  }
 
   nsIScrollableFrame* scrollableFrame =
       scrollFrame ? scrollFrame->GetScrollTargetFrame() : nullptr;
@@ -751,7 +763,7 @@ bool DisplayPortUtils::SetDisplayPortMargins(nsIContent* aContent,
       GetHighResolutionDisplayPort(aContent, &newDisplayPort);
   MOZ_ASSERT(hasDisplayPort);
 
-  if (MOZ_LOG_TEST(sDisplayportLog, LogLevel::Debug)) {
+  if (marginsChanged && MOZ_LOG_TEST(sDisplayportLog, LogLevel::Debug)) {
     mozilla::layers::ScrollableLayerGuid::ViewID viewID =
         mozilla::layers::ScrollableLayerGuid::NULL_SCROLL_ID;
     nsLayoutUtils::FindIDFor(aContent, &viewID);
@@ -770,8 +782,10 @@ bool DisplayPortUtils::SetDisplayPortMargins(nsIContent* aContent,
     }
   }
 
-  InvalidateForDisplayPortChange(aContent, hadDisplayPort, oldDisplayPort,
-                                 newDisplayPort, aRepaintMode);
+  if (marginsChanged) {
+    InvalidateForDisplayPortChange(aContent, hadDisplayPort, oldDisplayPort,
+                                   newDisplayPort, aRepaintMode);
+  }
 
   scrollableFrame->TriggerDisplayPortExpiration();
 
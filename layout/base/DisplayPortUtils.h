@@ -92,6 +92,15 @@ struct DisplayPortMargins {
   // mVisualOffset and mLayoutOffset, and the Screen coordinates of mMargins.
   CSSToScreenScale2D mScale;
 
+  bool operator==(const DisplayPortMargins& aOther) const {
+    return mMargins == aOther.mMargins &&
+           mVisualOffset == aOther.mVisualOffset &&
+           mLayoutOffset == aOther.mLayoutOffset && mScale == aOther.mScale;
+  }
+  bool operator!=(const DisplayPortMargins& aOther) const {
+    return !(*this == aOther);
+  }
+
   // Create displayport margins requested by APZ, relative to an async visual
   // offset provided by APZ.
   static DisplayPortMargins FromAPZ(const ScreenMargin& aMargins,
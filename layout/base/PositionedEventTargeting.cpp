@@ -529,44 +529,47 @@ nsIFrame* FindFrameTargetedByInputEvent(
   // web popup type things. In particular it helps alleviate bug 1666792.
   restrictToDescendants = FindZIndexAncestor(target, restrictToDescendants);
 
-  nsRect targetRect = GetTargetRect(aRootFrame, aPointRelativeToRootFrame,
-                                    restrictToDescendants, prefs, aFlags);
-  PET_LOG("Expanded point to target rect %s\n", ToString(targetRect).c_str());
-  AutoTArray<nsIFrame*, 8> candidates;
-  nsresult rv = nsLayoutUtils::GetFramesForArea(aRootFrame, targetRect,
-                                                candidates, options);
-  if (NS_FAILED(rv)) {
-    return target;
-  }
-
-  if (aEvent->mClass == eTouchEventClass) {
-    nsIFrame* closestTouchable =
-        GetClosest(aRootFrame, aPointRelativeToRootFrame, targetRect, prefs,
-                   restrictToDescendants, nullptr, candidates);
-    if (closestTouchable) {
-      target = closestTouchable;
-    }
+  // If the frame that was directly hit is itself clickable, the candidate
+  // search below can only hand it back again: the search would be restricted
+  // to the target's own subtree, and the target sits first in the
+  // top-to-bottom candidate list with a distance of zero. Skip the second
+  // hit-test entirely in that case; it is the common one for mouse events
+  // over interactive content, and building the candidate list is another
+  // full display-list hit-test per event.
+  const bool targetIsClickable =
+      aEvent->mClass == eMouseEventClass && target &&
+      GetClickableAncestor(target, nsGkAtoms::body);
+
+  if (targetIsClickable) {
+    PET_LOG("Target %p is clickable\n", target);
   } else {
-    MOZ_ASSERT(aEvent->mClass == eMouseEventClass);
+    nsRect targetRect = GetTargetRect(aRootFrame, aPointRelativeToRootFrame,
+                                      restrictToDescendants, prefs, aFlags);
+    PET_LOG("Expanded point to target rect %s\n",
+            ToString(targetRect).c_str());
+    AutoTArray<nsIFrame*, 8> candidates;
+    nsresult rv = nsLayoutUtils::GetFramesForArea(aRootFrame, targetRect,
+                                                  candidates, options);
+    if (NS_FAILED(rv)) {
+      return target;
+    }
 
-    nsIContent* clickableAncestor = nullptr;
-    if (target) {
-      clickableAncestor = GetClickableAncestor(target, nsGkAtoms::body);
-      if (clickableAncestor) {
-        PET_LOG("Target %p is clickable\n", target);
-        // If the target that was directly hit has a clickable ancestor, that
-        // means it too is clickable. And since it is the same as or a
-        // descendant of clickableAncestor, it should become the root for the
-        // GetClosest search.
-        clickableAncestor = target->GetContent();
+    if (aEvent->mClass == eTouchEventClass) {
+      nsIFrame* closestTouchable =
+          GetClosest(aRootFrame, aPointRelativeToRootFrame, targetRect, prefs,
+                     restrictToDescendants, nullptr, candidates);
+      if (closestTouchable) {
+        target = closestTouchable;
       }
-    }
+    } else {
+      MOZ_ASSERT(aEvent->mClass == eMouseEventClass);
 
-    nsIFrame* closestClickable =
-        GetClosest(aRootFrame, aPointRelativeToRootFrame, targetRect, prefs,
-                   restrictToDescendants, clickableAncestor, candidates);
-    if (closestClickable) {
-      target = closestClickable;
+      nsIFrame* closestClickable =
+          GetClosest(aRootFrame, aPointRelativeToRootFrame, targetRect, prefs,
+                     restrictToDescendants, nullptr, candidates);
+      if (closestClickable) {
+        target = closestClickable;
+      }
     }
   }
 
@@ -799,6 +799,7 @@ PresShell::PresShell(Document* aDocument)
       mCurrentEventFrame(nullptr),
       mMouseLocation(NS_UNCONSTRAINEDSIZE, NS_UNCONSTRAINEDSIZE),
       mPaintCount(0),
+      mLayoutGeneration(0),
       mAPZFocusSequenceNumber(0),
       mCanvasBackgroundColor(NS_RGBA(0, 0, 0, 0)),
       mActiveSuppressDisplayport(0),
@@ -2816,6 +2817,12 @@ void PresShell::FrameNeedsReflow(nsIFrame* aFrame,
           for (nsIFrame* kid : childList.mList) {
             if (styleChange) {
               kid->MarkIntrinsicISizesDirty();
+            } else if (kid->HasAnyStateBits(NS_FRAME_IS_DIRTY)) {
+              // We're only setting NS_FRAME_IS_DIRTY here, and a frame that
+              // already has it has a fully dirty subtree (the same pruning
+              // nsIFrame::MarkSubtreeDirty relies on), so there's nothing
+              // left to mark below this kid.
+              continue;
             }
             if (dirty) {
               kid->AddStateBits(NS_FRAME_IS_DIRTY);
@@ -9481,6 +9488,8 @@ void PresShell::WillDoReflow() {
 }
 
 void PresShell::DidDoReflow(bool aInterruptible) {
+  IncrementLayoutGeneration();
+
   HandlePostedReflowCallbacks(aInterruptible);
   if (mIsDestroying) {
     return;
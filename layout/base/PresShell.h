@@ -905,6 +905,15 @@ class PresShell final : public nsStubDocumentObserver,
   uint64_t GetPaintCount() { return mPaintCount; }
   void IncrementPaintCount() { ++mPaintCount; }
 
+  /**
+   * A counter that's bumped whenever something that can change frame geometry
+   * happens: a reflow finishes, restyle change hints are processed, or a
+   * scroll frame in this document scrolls. Used to validate cached layout
+   * query results like getBoundingClientRect.
+   */
+  uint64_t GetLayoutGeneration() const { return mLayoutGeneration; }
+  void IncrementLayoutGeneration() { ++mLayoutGeneration; }
+
   /**
    * Get the root DOM window of this presShell.
    */
@@ -2973,6 +2982,10 @@ class PresShell final : public nsStubDocumentObserver,
   // Count of the number of times this presshell has been painted to a window.
   uint64_t mPaintCount;
 
+  // Bumped whenever frame geometry in this document may have changed; see
+  // GetLayoutGeneration().
+  uint64_t mLayoutGeneration;
+
   // The focus sequence number of the last processed input event
   uint64_t mAPZFocusSequenceNumber;
 
@@ -378,6 +378,10 @@ void RestyleManager::ContentRemoved(nsIContent* aOldChild,
     RestyleManager::ClearServoDataFromSubtree(aOldChild->AsElement());
   }
 
+  // The removed subtree may contain the element whose pending restyle request
+  // we remembered, and its pending hints are gone along with its style data.
+  mLastNotedRestyleElement = nullptr;
+
   // The container might be a document or a ShadowRoot.
   if (!aOldChild->GetParentNode()->IsElement()) {
     return;
@@ -1270,6 +1274,10 @@ void RestyleManager::ProcessRestyledFrames(nsStyleChangeList& aChangeList) {
     return;
   }
 
+  // Some change hints (transforms, position fast paths) move frames without
+  // a reflow, so cached layout query results can't survive them.
+  PresContext()->PresShell()->IncrementLayoutGeneration();
+
   // If mDestroyedFrames is null, we want to create a new hashtable here
   // and destroy it on exit; but if it is already non-null (because we're in
   // a recursive call), we will continue to use the existing table to
@@ -2209,7 +2217,21 @@ void RestyleManager::PostRestyleEvent(Element* aElement,
   }
 
   if (aRestyleHint || aMinChangeHint) {
+    if (aElement == mLastNotedRestyleElement &&
+        aRestyleHint == mLastNotedRestyleHint &&
+        aMinChangeHint == mLastNotedChangeHint) {
+      // This exact request is already pending; the hints accumulate in the
+      // element's style data, so noting them again wouldn't do anything.
+      return;
+    }
     Servo_NoteExplicitHints(aElement, aRestyleHint, aMinChangeHint);
+    if (aElement->HasServoData()) {
+      // Only remember requests that actually stuck; elements without style
+      // data drop them and get styled from scratch instead.
+      mLastNotedRestyleElement = aElement;
+      mLastNotedRestyleHint = aRestyleHint;
+      mLastNotedChangeHint = aMinChangeHint;
+    }
   }
 }
 
@@ -2929,6 +2951,10 @@ void RestyleManager::DoProcessPendingRestyles(ServoTraversalFlags aFlags) {
   nsPresContext* presContext = PresContext();
   PresShell* presShell = presContext->PresShell();
 
+  // The traversal below consumes pending restyle requests, so requests posted
+  // afterwards have to be noted again even if they look identical.
+  mLastNotedRestyleElement = nullptr;
+
   MOZ_ASSERT(presContext->Document(), "No document?  Pshaw!");
   // FIXME(emilio): In the "flush animations" case, ideally, we should only
   // recascade animation styles running on the compositor, so we shouldn't care
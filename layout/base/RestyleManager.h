@@ -574,6 +574,16 @@ class RestyleManager {
   // A hashtable with the elements that have changed state or attributes, in
   // order to calculate restyle hints during the traversal.
   SnapshotTable mSnapshots;
+
+  // The most recent explicit restyle request posted since the last restyle
+  // flush. Scripts often post identical restyles for the same element many
+  // times between flushes (e.g. once per microtask); the hints just
+  // accumulate in the element's style data, so re-noting an already-pending
+  // request is a no-op that we can skip. Cleared when pending restyles are
+  // processed and when content is removed.
+  RefPtr<dom::Element> mLastNotedRestyleElement;
+  RestyleHint mLastNotedRestyleHint{0};
+  nsChangeHint mLastNotedChangeHint = nsChangeHint(0);
 };
 
 }  // namespace mozilla
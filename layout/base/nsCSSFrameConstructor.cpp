@@ -6346,6 +6346,12 @@ void nsCSSFrameConstructor::CheckBitsForLazyFrameConstruction(
 // FIXME(emilio, bug 1410020): This function assumes that the flattened tree
 // parent of all the appended children is the same, which, afaict, is not
 // necessarily true.
+//
+// Deferring construction here is also what batches the style work for
+// parser-inserted content: all the subtrees flagged below get styled by a
+// single Servo traversal (parallel when ShouldTraverseInParallel() allows) at
+// the next flush, rather than one traversal per tree op, and the main-thread
+// construction pass then just consumes the already-resolved ComputedStyles.
 void nsCSSFrameConstructor::ConstructLazily(Operation aOperation,
                                             nsIContent* aChild) {
   MOZ_ASSERT(aChild->GetParent());
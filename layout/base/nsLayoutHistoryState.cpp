@@ -19,19 +19,232 @@
 
 using namespace mozilla;
 
+namespace {
+
+// Tags for the packed representation of PresState::contentData. The packed
+// format is internal to this file and never persisted or sent across
+// processes, so it can change freely.
+enum ContentDataTag : uint8_t {
+  eVoidTag,
+  eTextTag,
+  eSelectTag,
+  eCheckedTag,
+  eFilesTag,
+};
+
+class StateWriter {
+ public:
+  explicit StateWriter(nsTArray<uint8_t>& aBuffer) : mBuffer(aBuffer) {}
+
+  void WriteUint8(uint8_t aValue) { WriteBytes(&aValue, sizeof(aValue)); }
+  void WriteUint32(uint32_t aValue) { WriteBytes(&aValue, sizeof(aValue)); }
+  void WriteInt32(int32_t aValue) { WriteBytes(&aValue, sizeof(aValue)); }
+  void WriteFloat(float aValue) { WriteBytes(&aValue, sizeof(aValue)); }
+  void WriteBool(bool aValue) { WriteUint8(aValue ? 1 : 0); }
+
+  void WriteCString(const nsACString& aValue) {
+    WriteUint32(aValue.Length());
+    WriteBytes(aValue.BeginReading(), aValue.Length());
+  }
+
+  void WriteString(const nsAString& aValue) {
+    WriteUint32(aValue.Length());
+    WriteBytes(aValue.BeginReading(), aValue.Length() * sizeof(char16_t));
+  }
+
+ private:
+  void WriteBytes(const void* aData, size_t aLength) {
+    mBuffer.AppendElements(reinterpret_cast<const uint8_t*>(aData), aLength);
+  }
+
+  nsTArray<uint8_t>& mBuffer;
+};
+
+class StateReader {
+ public:
+  explicit StateReader(const nsTArray<uint8_t>& aBuffer)
+      : mData(aBuffer.Elements()), mLength(aBuffer.Length()), mPos(0) {}
+
+  bool ReadUint8(uint8_t* aValue) { return ReadBytes(aValue, sizeof(*aValue)); }
+  bool ReadUint32(uint32_t* aValue) {
+    return ReadBytes(aValue, sizeof(*aValue));
+  }
+  bool ReadInt32(int32_t* aValue) { return ReadBytes(aValue, sizeof(*aValue)); }
+  bool ReadFloat(float* aValue) { return ReadBytes(aValue, sizeof(*aValue)); }
+
+  bool ReadBool(bool* aValue) {
+    uint8_t value;
+    if (!ReadUint8(&value)) {
+      return false;
+    }
+    *aValue = !!value;
+    return true;
+  }
+
+  bool ReadCString(nsACString& aValue) {
+    uint32_t length;
+    if (!ReadUint32(&length) || length > mLength - mPos) {
+      return false;
+    }
+    aValue.Assign(reinterpret_cast<const char*>(mData + mPos), length);
+    mPos += length;
+    return true;
+  }
+
+  bool ReadString(nsAString& aValue) {
+    uint32_t length;
+    if (!ReadUint32(&length) || length > (mLength - mPos) / sizeof(char16_t)) {
+      return false;
+    }
+    if (!aValue.SetLength(length, fallible)) {
+      return false;
+    }
+    memcpy(aValue.BeginWriting(), mData + mPos, length * sizeof(char16_t));
+    mPos += length * sizeof(char16_t);
+    return true;
+  }
+
+ private:
+  bool ReadBytes(void* aData, size_t aLength) {
+    if (aLength > mLength - mPos) {
+      return false;
+    }
+    memcpy(aData, mData + mPos, aLength);
+    mPos += aLength;
+    return true;
+  }
+
+  const uint8_t* mData;
+  size_t mLength;
+  size_t mPos;
+};
+
+bool ReadPackedState(StateReader& aReader, nsCString& aKey,
+                     UniquePtr<PresState>& aState) {
+  if (!aReader.ReadCString(aKey)) {
+    return false;
+  }
+
+  UniquePtr<PresState> state = NewPresState();
+
+  uint8_t tag;
+  if (!aReader.ReadUint8(&tag)) {
+    return false;
+  }
+  switch (tag) {
+    case eVoidTag:
+      break;
+    case eTextTag: {
+      nsString value;
+      bool interactive;
+      if (!aReader.ReadString(value) || !aReader.ReadBool(&interactive)) {
+        return false;
+      }
+      state->contentData() = TextContentData(value, interactive);
+      break;
+    }
+    case eSelectTag: {
+      SelectContentData select;
+      uint32_t indexCount;
+      if (!aReader.ReadUint32(&indexCount)) {
+        return false;
+      }
+      for (uint32_t i = 0; i < indexCount; i++) {
+        uint32_t index;
+        if (!aReader.ReadUint32(&index)) {
+          return false;
+        }
+        select.indices().AppendElement(index);
+      }
+      uint32_t valueCount;
+      if (!aReader.ReadUint32(&valueCount)) {
+        return false;
+      }
+      for (uint32_t i = 0; i < valueCount; i++) {
+        nsString value;
+        if (!aReader.ReadString(value)) {
+          return false;
+        }
+        select.values().AppendElement(std::move(value));
+      }
+      state->contentData() = std::move(select);
+      break;
+    }
+    case eCheckedTag: {
+      bool checked;
+      if (!aReader.ReadBool(&checked)) {
+        return false;
+      }
+      state->contentData() = CheckedContentData(checked);
+      break;
+    }
+    case eFilesTag: {
+      uint32_t fileCount;
+      if (!aReader.ReadUint32(&fileCount)) {
+        return false;
+      }
+      nsTArray<FileContentData> files;
+      for (uint32_t i = 0; i < fileCount; i++) {
+        nsString path;
+        if (!aReader.ReadString(path)) {
+          return false;
+        }
+        files.AppendElement(FileContentData(path));
+      }
+      state->contentData() = std::move(files);
+      break;
+    }
+    default:
+      return false;
+  }
+
+  int32_t x, y;
+  bool allowScrollOriginDowngrade, disabledSet, disabled, droppedDown;
+  float resolution;
+  if (!aReader.ReadInt32(&x) || !aReader.ReadInt32(&y) ||
+      !aReader.ReadBool(&allowScrollOriginDowngrade) ||
+      !aReader.ReadFloat(&resolution) || !aReader.ReadBool(&disabledSet) ||
+      !aReader.ReadBool(&disabled) || !aReader.ReadBool(&droppedDown)) {
+    return false;
+  }
+  state->scrollState() = nsPoint(x, y);
+  state->allowScrollOriginDowngrade() = allowScrollOriginDowngrade;
+  state->resolution() = resolution;
+  state->disabledSet() = disabledSet;
+  state->disabled() = disabled;
+  state->droppedDown() = droppedDown;
+
+  aState = std::move(state);
+  return true;
+}
+
+}  // namespace
+
 class nsLayoutHistoryState final : public nsILayoutHistoryState,
                                    public nsSupportsWeakReference {
  public:
-  nsLayoutHistoryState() : mScrollPositionOnly(false) {}
+  nsLayoutHistoryState() : mScrollPositionOnly(false), mCompactCount(0) {}
 
   NS_DECL_ISUPPORTS
   NS_DECL_NSILAYOUTHISTORYSTATE
 
  private:
   ~nsLayoutHistoryState() = default;
+
+  void EnsureInflated();
+
   bool mScrollPositionOnly;
 
   nsDataHashtable<nsCStringHashKey, UniquePtr<PresState>> mStates;
+
+  /**
+   * When mCompactCount is non-zero the states have been packed by Compact():
+   * mStates is empty and mCompactState holds the serialized form of
+   * mCompactCount states. EnsureInflated() turns them back into live
+   * PresState objects on first access.
+   */
+  uint32_t mCompactCount;
+  nsTArray<uint8_t> mCompactState;
 };
 
 already_AddRefed<nsILayoutHistoryState> NS_NewLayoutHistoryState() {
@@ -50,6 +263,7 @@ nsLayoutHistoryState::GetHasStates(bool* aHasStates) {
 
 NS_IMETHODIMP
 nsLayoutHistoryState::GetKeys(nsTArray<nsCString>& aKeys) {
+  EnsureInflated();
   if (!HasStates()) {
     return NS_ERROR_FAILURE;
   }
@@ -86,6 +300,8 @@ nsLayoutHistoryState::AddNewPresState(const nsACString& aKey, float aScrollX,
                                       float aScrollY,
                                       bool aAllowScrollOriginDowngrade,
                                       float aRes) {
+  EnsureInflated();
+
   UniquePtr<PresState> newState = NewPresState();
   newState->scrollState() = nsPoint(aScrollX, aScrollY);
   newState->allowScrollOriginDowngrade() = aAllowScrollOriginDowngrade;
@@ -98,10 +314,12 @@ nsLayoutHistoryState::AddNewPresState(const nsACString& aKey, float aScrollX,
 
 void nsLayoutHistoryState::AddState(const nsCString& aStateKey,
                                     UniquePtr<PresState> aState) {
+  EnsureInflated();
   mStates.Put(aStateKey, std::move(aState));
 }
 
 PresState* nsLayoutHistoryState::GetState(const nsCString& aKey) {
+  EnsureInflated();
   UniquePtr<PresState>* statePtr = mStates.GetValue(aKey);
   if (!statePtr) {
     return nullptr;
@@ -118,16 +336,20 @@ PresState* nsLayoutHistoryState::GetState(const nsCString& aKey) {
 }
 
 void nsLayoutHistoryState::RemoveState(const nsCString& aKey) {
+  EnsureInflated();
   mStates.Remove(aKey);
 }
 
-bool nsLayoutHistoryState::HasStates() { return mStates.Count() != 0; }
+bool nsLayoutHistoryState::HasStates() {
+  return mStates.Count() != 0 || mCompactCount != 0;
+}
 
 void nsLayoutHistoryState::SetScrollPositionOnly(const bool aFlag) {
   mScrollPositionOnly = aFlag;
 }
 
 void nsLayoutHistoryState::ResetScrollState() {
+  EnsureInflated();
   for (auto iter = mStates.Iter(); !iter.Done(); iter.Next()) {
     PresState* state = iter.Data().get();
     if (state) {
@@ -139,6 +361,7 @@ void nsLayoutHistoryState::ResetScrollState() {
 void nsLayoutHistoryState::GetContents(bool* aScrollPositionOnly,
                                        nsTArray<nsCString>& aKeys,
                                        nsTArray<mozilla::PresState>& aStates) {
+  EnsureInflated();
   *aScrollPositionOnly = mScrollPositionOnly;
   aKeys.SetCapacity(mStates.Count());
   aStates.SetCapacity(mStates.Count());
@@ -151,6 +374,120 @@ void nsLayoutHistoryState::GetContents(bool* aScrollPositionOnly,
 void nsLayoutHistoryState::Reset() {
   mScrollPositionOnly = false;
   mStates.Clear();
+  mCompactCount = 0;
+  mCompactState.Clear();
+  mCompactState.Compact();
+}
+
+bool nsLayoutHistoryState::Compact() {
+  if (mCompactCount != 0 || mStates.Count() == 0) {
+    return true;
+  }
+
+  // A live blob (from a file input) cannot be flattened into bytes, so keep
+  // states referencing one in their object form.
+  for (auto iter = mStates.ConstIter(); !iter.Done(); iter.Next()) {
+    const PresState* state = iter.Data().get();
+    if (state->contentData().type() ==
+        PresContentData::TArrayOfFileContentData) {
+      for (const FileContentData& file :
+           state->contentData().get_ArrayOfFileContentData()) {
+        if (file.type() == FileContentData::TBlobImpl) {
+          return false;
+        }
+      }
+    }
+  }
+
+  nsTArray<uint8_t> buffer;
+  StateWriter writer(buffer);
+  for (auto iter = mStates.ConstIter(); !iter.Done(); iter.Next()) {
+    writer.WriteCString(iter.Key());
+
+    const PresState* state = iter.Data().get();
+    switch (state->contentData().type()) {
+      case PresContentData::Tvoid_t:
+        writer.WriteUint8(eVoidTag);
+        break;
+      case PresContentData::TTextContentData: {
+        const TextContentData& text =
+            state->contentData().get_TextContentData();
+        writer.WriteUint8(eTextTag);
+        writer.WriteString(text.value());
+        writer.WriteBool(text.lastValueChangeWasInteractive());
+        break;
+      }
+      case PresContentData::TSelectContentData: {
+        const SelectContentData& select =
+            state->contentData().get_SelectContentData();
+        writer.WriteUint8(eSelectTag);
+        writer.WriteUint32(select.indices().Length());
+        for (uint32_t index : select.indices()) {
+          writer.WriteUint32(index);
+        }
+        writer.WriteUint32(select.values().Length());
+        for (const nsString& value : select.values()) {
+          writer.WriteString(value);
+        }
+        break;
+      }
+      case PresContentData::TCheckedContentData:
+        writer.WriteUint8(eCheckedTag);
+        writer.WriteBool(
+            state->contentData().get_CheckedContentData().checked());
+        break;
+      case PresContentData::TArrayOfFileContentData: {
+        const nsTArray<FileContentData>& files =
+            state->contentData().get_ArrayOfFileContentData();
+        writer.WriteUint8(eFilesTag);
+        writer.WriteUint32(files.Length());
+        for (const FileContentData& file : files) {
+          writer.WriteString(file.get_nsString());
+        }
+        break;
+      }
+      default:
+        MOZ_ASSERT_UNREACHABLE("Unknown content data type");
+        return false;
+    }
+
+    writer.WriteInt32(state->scrollState().x);
+    writer.WriteInt32(state->scrollState().y);
+    writer.WriteBool(state->allowScrollOriginDowngrade());
+    writer.WriteFloat(state->resolution());
+    writer.WriteBool(state->disabledSet());
+    writer.WriteBool(state->disabled());
+    writer.WriteBool(state->droppedDown());
+  }
+
+  mCompactCount = mStates.Count();
+  mStates.Clear();
+  mCompactState = std::move(buffer);
+  mCompactState.Compact();
+  return true;
+}
+
+void nsLayoutHistoryState::EnsureInflated() {
+  if (mCompactCount == 0) {
+    return;
+  }
+
+  uint32_t count = mCompactCount;
+  mCompactCount = 0;
+
+  StateReader reader(mCompactState);
+  for (uint32_t i = 0; i < count; i++) {
+    nsCString key;
+    UniquePtr<PresState> state;
+    if (!ReadPackedState(reader, key, state)) {
+      MOZ_ASSERT_UNREACHABLE("Corrupt packed layout history state");
+      break;
+    }
+    mStates.Put(key, std::move(state));
+  }
+
+  mCompactState.Clear();
+  mCompactState.Compact();
 }
 
 namespace mozilla {
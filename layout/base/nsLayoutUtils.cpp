@@ -3795,6 +3795,35 @@ nsRect nsLayoutUtils::GetAllInFlowRectsUnion(nsIFrame* aFrame,
                                            : accumulator.mResultRect;
 }
 
+struct BoundingClientRectCache {
+  uint64_t mLayoutGeneration;
+  nsRect mRect;
+};
+
+NS_DECLARE_FRAME_PROPERTY_DELETABLE(BoundingClientRectProperty,
+                                    BoundingClientRectCache)
+
+nsRect nsLayoutUtils::GetBoundingClientRect(nsIFrame* aFrame) {
+  const uint64_t generation = aFrame->PresShell()->GetLayoutGeneration();
+  BoundingClientRectCache* cache =
+      aFrame->GetProperty(BoundingClientRectProperty());
+  if (cache && cache->mLayoutGeneration == generation) {
+    return cache->mRect;
+  }
+
+  nsRect result =
+      GetAllInFlowRectsUnion(aFrame, GetContainingBlockForClientRect(aFrame),
+                             RECTS_ACCOUNT_FOR_TRANSFORMS);
+  if (cache) {
+    cache->mLayoutGeneration = generation;
+    cache->mRect = result;
+  } else {
+    aFrame->SetProperty(BoundingClientRectProperty(),
+                        new BoundingClientRectCache{generation, result});
+  }
+  return result;
+}
+
 nsRect nsLayoutUtils::GetTextShadowRectsUnion(
     const nsRect& aTextAndDecorationsRect, nsIFrame* aFrame, uint32_t aFlags) {
   const nsStyleText* textStyle = aFrame->StyleText();
@@ -1250,6 +1250,16 @@ class nsLayoutUtils {
                                        const nsIFrame* aRelativeTo,
                                        uint32_t aFlags = 0);
 
+  /**
+   * Compute what Element::GetBoundingClientRect returns for aFrame's element:
+   * the union of the frame's in-flow rects, with transforms accounted for,
+   * relative to GetContainingBlockForClientRect(aFrame). The result is cached
+   * on the frame and validated against the pres shell's layout generation, so
+   * repeated queries between layout changes don't redo the transform and
+   * offset computations.
+   */
+  static nsRect GetBoundingClientRect(nsIFrame* aFrame);
+
   enum { EXCLUDE_BLUR_SHADOWS = 0x01 };
   /**
    * Takes a text-shadow array from the style properties of a given nsIFrame and
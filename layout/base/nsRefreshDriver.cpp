@@ -107,6 +107,7 @@ static mozilla::LazyLogModule sRefreshDriverLog("nsRefreshDriver");
   MOZ_LOG(sRefreshDriverLog, mozilla::LogLevel::Debug, (__VA_ARGS__))
 
 #define DEFAULT_THROTTLED_FRAME_RATE 1
+#define DEFAULT_REDUCED_FRAME_RATE 30
 #define DEFAULT_RECOMPUTE_VISIBILITY_INTERVAL_MS 1000
 #define DEFAULT_NOTIFY_INTERSECTION_OBSERVERS_INTERVAL_MS 100
 // after 10 minutes, stop firing off inactive timers
@@ -1071,6 +1072,15 @@ double nsRefreshDriver::GetThrottledTimerInterval() {
   return 1000.0 / rate;
 }
 
+/* static */
+double nsRefreshDriver::GetReducedTimerInterval() {
+  int32_t rate = Preferences::GetInt("layout.reduced_frame_rate", -1);
+  if (rate <= 0) {
+    rate = DEFAULT_REDUCED_FRAME_RATE;
+  }
+  return 1000.0 / rate;
+}
+
 /* static */ mozilla::TimeDuration
 nsRefreshDriver::GetMinRecomputeVisibilityInterval() {
   int32_t interval =
@@ -1118,6 +1128,8 @@ nsRefreshDriver::nsRefreshDriver(nsPresContext* aPresContext)
       mFreezeCount(0),
       mThrottledFrameRequestInterval(
           TimeDuration::FromMilliseconds(GetThrottledTimerInterval())),
+      mReducedFrameRequestInterval(
+          TimeDuration::FromMilliseconds(GetReducedTimerInterval())),
       mMinRecomputeVisibilityInterval(GetMinRecomputeVisibilityInterval()),
       mThrottled(false),
       mNeedToRecomputeVisibility(false),
@@ -1130,6 +1142,7 @@ nsRefreshDriver::nsRefreshDriver(nsPresContext* aPresContext)
       mResizeSuppressed(false),
       mNotifyDOMContentFlushed(false),
       mNeedToUpdateIntersectionObservations(false),
+      mLastIntersectionObservationGeneration(0),
       mWarningThreshold(REFRESH_WAIT_WARNING) {
   MOZ_ASSERT(NS_IsMainThread());
   MOZ_ASSERT(mPresContext,
@@ -1137,6 +1150,7 @@ nsRefreshDriver::nsRefreshDriver(nsPresContext* aPresContext)
              "and decrement sRefreshDriverCount.");
   mMostRecentRefresh = TimeStamp::Now();
   mNextThrottledFrameRequestTick = mMostRecentRefresh;
+  mNextReducedFrameRequestTick = mMostRecentRefresh;
   mNextRecomputeVisibilityTick = mMostRecentRefresh;
 
   if (!sRegularRateTimerList) {
@@ -1490,6 +1504,7 @@ uint32_t nsRefreshDriver::ObserverCount() const {
   sum += mLayoutFlushObservers.Length();
   sum += mPendingFullscreenEvents.Length();
   sum += mFrameRequestCallbackDocs.Length();
+  sum += mReducedRateFrameRequestCallbackDocs.Length();
   sum += mThrottledFrameRequestCallbackDocs.Length();
   sum += mViewManagerFlushIsPending;
   sum += mEarlyRunners.Length();
@@ -1513,6 +1528,7 @@ bool nsRefreshDriver::HasObservers() const {
          !mResizeEventFlushObservers.IsEmpty() ||
          !mPendingFullscreenEvents.IsEmpty() ||
          !mFrameRequestCallbackDocs.IsEmpty() ||
+         !mReducedRateFrameRequestCallbackDocs.IsEmpty() ||
          !mThrottledFrameRequestCallbackDocs.IsEmpty() ||
          !mEarlyRunners.IsEmpty();
 }
@@ -1552,6 +1568,10 @@ void nsRefreshDriver::AppendObserverDescriptionsToString(
     aStr.AppendPrintf("%zux Frame request callback doc, ",
                       mFrameRequestCallbackDocs.Length());
   }
+  if (!mReducedRateFrameRequestCallbackDocs.IsEmpty()) {
+    aStr.AppendPrintf("%zux Reduced-rate frame request callback doc, ",
+                      mReducedRateFrameRequestCallbackDocs.Length());
+  }
   if (!mThrottledFrameRequestCallbackDocs.IsEmpty()) {
     aStr.AppendPrintf("%zux Throttled frame request callback doc, ",
                       mThrottledFrameRequestCallbackDocs.Length());
@@ -1766,6 +1786,39 @@ void nsRefreshDriver::UpdateIntersectionObservations(TimeStamp aNowTime) {
         return document->HasIntersectionObservers();
       });
 
+  if (documents.IsEmpty()) {
+    mNeedToUpdateIntersectionObservations = false;
+    return;
+  }
+
+  // Observed geometry in this process can only change when some pres shell's
+  // layout generation is bumped (reflow, restyle change hints, or scrolling).
+  // Everything else that can affect observations requests an update
+  // explicitly via EnsureIntersectionObservationsUpdateHappens: new
+  // observations, and ancestor viewport changes arriving from an
+  // out-of-process embedder.  When neither has happened since the last
+  // update, every observation would compute exactly what it did last time,
+  // so skip the per-target geometry work entirely.  The generations only
+  // ever increase, so summing them gives a cheap combined change stamp.
+  uint64_t generation = 0;
+  if (PresShell* presShell = mPresContext->Document()->GetPresShell()) {
+    generation += presShell->GetLayoutGeneration();
+  }
+  AutoTArray<RefPtr<Document>, 32> allDocuments;
+  mPresContext->Document()->CollectDescendantDocuments(
+      allDocuments, [](const Document* document) -> bool {
+        return !!document->GetPresShell();
+      });
+  for (const RefPtr<Document>& doc : allDocuments) {
+    generation += doc->GetPresShell()->GetLayoutGeneration();
+  }
+
+  if (!mNeedToUpdateIntersectionObservations &&
+      generation == mLastIntersectionObservationGeneration) {
+    return;
+  }
+  mLastIntersectionObservationGeneration = generation;
+
   for (uint32_t i = 0; i < documents.Length(); ++i) {
     Document* doc = documents[i];
     doc->UpdateIntersectionObservations(aNowTime);
@@ -1796,6 +1849,7 @@ void nsRefreshDriver::RunFrameRequestCallbacks(TimeStamp aNowTime) {
   // Grab all of our frame request callbacks up front.
   nsTArray<DocumentFrameCallbacks> frameRequestCallbacks(
       mFrameRequestCallbackDocs.Length() +
+      mReducedRateFrameRequestCallbackDocs.Length() +
       mThrottledFrameRequestCallbackDocs.Length());
 
   // First, grab throttled frame request callbacks.
@@ -1844,6 +1898,40 @@ void nsRefreshDriver::RunFrameRequestCallbacks(TimeStamp aNowTime) {
     }
   }
 
+  // Next, grab reduced-rate frame request callbacks. This mirrors the
+  // throttled handling above, just with a faster interval.
+  {
+    nsTArray<Document*> docsToRemove;
+
+    bool tickReducedFrameRequests = mThrottled;
+
+    if (!tickReducedFrameRequests &&
+        aNowTime >= mNextReducedFrameRequestTick) {
+      mNextReducedFrameRequestTick = aNowTime + mReducedFrameRequestInterval;
+      tickReducedFrameRequests = true;
+    }
+
+    for (Document* doc : mReducedRateFrameRequestCallbackDocs) {
+      if (tickReducedFrameRequests) {
+        TakeFrameRequestCallbacksFrom(doc, frameRequestCallbacks);
+      } else if (GetFrameRequestTierForDocument(doc) !=
+                 FrameRequestTier::Reduced) {
+        // This document changed tiers; grab its requests now so that the next
+        // ScheduleFrameRequestCallbacks call files it under the right tier.
+        TakeFrameRequestCallbacksFrom(doc, frameRequestCallbacks);
+        docsToRemove.AppendElement(doc);
+      }
+    }
+
+    if (tickReducedFrameRequests) {
+      mReducedRateFrameRequestCallbackDocs.Clear();
+    } else {
+      for (Document* doc : docsToRemove) {
+        mReducedRateFrameRequestCallbackDocs.RemoveElement(doc);
+      }
+    }
+  }
+
   // Now grab unthrottled frame request callbacks.
   for (Document* doc : mFrameRequestCallbackDocs) {
     TakeFrameRequestCallbacksFrom(doc, frameRequestCallbacks);
@@ -2220,17 +2308,6 @@ void nsRefreshDriver::Tick(VsyncId aId, TimeStamp aNowTime) {
     }
   }
 
-  // Recompute approximate frame visibility if it's necessary and enough time
-  // has passed since the last time we did it.
-  if (mNeedToRecomputeVisibility && !mThrottled &&
-      aNowTime >= mNextRecomputeVisibilityTick &&
-      !presShell->IsPaintingSuppressed()) {
-    mNextRecomputeVisibilityTick = aNowTime + mMinRecomputeVisibilityInterval;
-    mNeedToRecomputeVisibility = false;
-
-    presShell->ScheduleApproximateFrameVisibilityUpdateNow();
-  }
-
 #ifdef MOZ_XUL
   // Update any popups that may need to be moved or hidden due to their
   // anchor changing.
@@ -2239,8 +2316,6 @@ void nsRefreshDriver::Tick(VsyncId aId, TimeStamp aNowTime) {
   }
 #endif
 
-  UpdateIntersectionObservations(aNowTime);
-
   /*
    * Perform notification to imgIRequests subscribed to listen
    * for refresh events.
@@ -2374,6 +2449,25 @@ void nsRefreshDriver::Tick(VsyncId aId, TimeStamp aNowTime) {
     mCompositionPayloads.Clear();
   }
 
+  // The remaining stages only queue follow-up work (visibility updates and
+  // intersection observer notifications are delivered from separate tasks)
+  // and do not feed the paint we just handed off, so they run after it;
+  // that way WebRender can build the scene asynchronously while we finish
+  // the tick.
+
+  // Recompute approximate frame visibility if it's necessary and enough time
+  // has passed since the last time we did it.
+  if (mNeedToRecomputeVisibility && !mThrottled &&
+      aNowTime >= mNextRecomputeVisibilityTick &&
+      !presShell->IsPaintingSuppressed()) {
+    mNextRecomputeVisibilityTick = aNowTime + mMinRecomputeVisibilityInterval;
+    mNeedToRecomputeVisibility = false;
+
+    presShell->ScheduleApproximateFrameVisibilityUpdateNow();
+  }
+
+  UpdateIntersectionObservations(aNowTime);
+
   double totalMs = (TimeStamp::Now() - mTickStart).ToMilliseconds();
 
 #ifndef ANDROID /* bug 1142079 */
@@ -2657,16 +2751,35 @@ void nsRefreshDriver::ScheduleViewManagerFlush() {
   EnsureTimerStarted(eNeverAdjustTimer);
 }
 
+/* static */ nsRefreshDriver::FrameRequestTier
+nsRefreshDriver::GetFrameRequestTierForDocument(Document* aDocument) {
+  if (aDocument->ShouldThrottleFrameRequests()) {
+    return FrameRequestTier::Throttled;
+  }
+  if (aDocument->ShouldReduceFrameRequestRate()) {
+    return FrameRequestTier::Reduced;
+  }
+  return FrameRequestTier::FullRate;
+}
+
 void nsRefreshDriver::ScheduleFrameRequestCallbacks(Document* aDocument) {
   NS_ASSERTION(mFrameRequestCallbackDocs.IndexOf(aDocument) ==
                        mFrameRequestCallbackDocs.NoIndex &&
+                   mReducedRateFrameRequestCallbackDocs.IndexOf(aDocument) ==
+                       mReducedRateFrameRequestCallbackDocs.NoIndex &&
                    mThrottledFrameRequestCallbackDocs.IndexOf(aDocument) ==
                        mThrottledFrameRequestCallbackDocs.NoIndex,
                "Don't schedule the same document multiple times");
-  if (aDocument->ShouldThrottleFrameRequests()) {
-    mThrottledFrameRequestCallbackDocs.AppendElement(aDocument);
-  } else {
-    mFrameRequestCallbackDocs.AppendElement(aDocument);
+  switch (GetFrameRequestTierForDocument(aDocument)) {
+    case FrameRequestTier::Throttled:
+      mThrottledFrameRequestCallbackDocs.AppendElement(aDocument);
+      break;
+    case FrameRequestTier::Reduced:
+      mReducedRateFrameRequestCallbackDocs.AppendElement(aDocument);
+      break;
+    case FrameRequestTier::FullRate:
+      mFrameRequestCallbackDocs.AppendElement(aDocument);
+      break;
   }
 
   // make sure that the timer is running
@@ -2675,6 +2788,7 @@ void nsRefreshDriver::ScheduleFrameRequestCallbacks(Document* aDocument) {
 
 void nsRefreshDriver::RevokeFrameRequestCallbacks(Document* aDocument) {
   mFrameRequestCallbackDocs.RemoveElement(aDocument);
+  mReducedRateFrameRequestCallbackDocs.RemoveElement(aDocument);
   mThrottledFrameRequestCallbackDocs.RemoveElement(aDocument);
   // No need to worry about restarting our timer in slack mode if it's already
   // running; that will happen automatically when it fires.
@@ -216,6 +216,18 @@ class nsRefreshDriver final : public mozilla::layers::TransactionIdAllocator,
   bool HasScheduleFlush() { return mHasScheduleFlush; }
   void ClearHasScheduleFlush() { mHasScheduleFlush = false; }
 
+  /**
+   * The rate tier at which a document's FrameRequestCallbacks are ticked.
+   * FullRate documents tick on every refresh; Reduced documents tick at
+   * layout.reduced_frame_rate (visible subdocuments the user has never
+   * interacted with, e.g. ad iframes); Throttled documents tick at
+   * layout.throttled_frame_rate (hidden or unpainted documents). Documents
+   * are re-classified every time their callbacks are rescheduled.
+   */
+  enum class FrameRequestTier : uint8_t { FullRate, Reduced, Throttled };
+
+  static FrameRequestTier GetFrameRequestTierForDocument(Document* aDocument);
+
   /**
    * Add a document for which we have FrameRequestCallbacks
    */
@@ -481,6 +493,7 @@ class nsRefreshDriver final : public mozilla::layers::TransactionIdAllocator,
 
   double GetRegularTimerInterval() const;
   static double GetThrottledTimerInterval();
+  static double GetReducedTimerInterval();
 
   static mozilla::TimeDuration GetMinRecomputeVisibilityInterval();
 
@@ -518,6 +531,10 @@ class nsRefreshDriver final : public mozilla::layers::TransactionIdAllocator,
   // non-visible) documents registered with a non-throttled refresh driver.
   const mozilla::TimeDuration mThrottledFrameRequestInterval;
 
+  // How long we wait between ticks for reduced-rate (visible but idle)
+  // documents registered with a non-throttled refresh driver.
+  const mozilla::TimeDuration mReducedFrameRequestInterval;
+
   // How long we wait, at a minimum, before recomputing approximate frame
   // visibility information. This is a minimum because, regardless of this
   // interval, we only recompute visibility when we've seen a layout or style
@@ -563,6 +580,12 @@ class nsRefreshDriver final : public mozilla::layers::TransactionIdAllocator,
   // all our documents.
   bool mNeedToUpdateIntersectionObservations : 1;
 
+  // Sum of the layout generations of all our documents' pres shells as of
+  // the last time we updated intersection observations.  While this is
+  // unchanged and no explicit update was requested, no observed geometry can
+  // have changed and UpdateIntersectionObservations has nothing to do.
+  uint64_t mLastIntersectionObservationGeneration;
+
   // Number of seconds that the refresh driver is blocked waiting for a
   // compositor transaction to be completed before we append a note to the gfx
   // critical log. The number is doubled every time the threshold is hit.
@@ -572,6 +595,7 @@ class nsRefreshDriver final : public mozilla::layers::TransactionIdAllocator,
   mozilla::VsyncId mTickVsyncId;
   mozilla::TimeStamp mTickVsyncTime;
   mozilla::TimeStamp mNextThrottledFrameRequestTick;
+  mozilla::TimeStamp mNextReducedFrameRequestTick;
   mozilla::TimeStamp mNextRecomputeVisibilityTick;
   mozilla::TimeStamp mBeforeFirstContentfulPaintTimerRunningLimit;
 
@@ -600,6 +624,7 @@ class nsRefreshDriver final : public mozilla::layers::TransactionIdAllocator,
   AutoTArray<mozilla::PresShell*, 16> mLayoutFlushObservers;
   // nsTArray on purpose, because we want to be able to swap.
   nsTArray<Document*> mFrameRequestCallbackDocs;
+  nsTArray<Document*> mReducedRateFrameRequestCallbackDocs;
   nsTArray<Document*> mThrottledFrameRequestCallbackDocs;
   nsTObserverArray<nsAPostRefreshObserver*> mPostRefreshObservers;
   nsTArray<mozilla::UniquePtr<mozilla::PendingFullscreenEvent>>
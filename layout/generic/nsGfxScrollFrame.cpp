@@ -2223,6 +2223,7 @@ ScrollFrameHelper::ScrollFrameHelper(nsContainerFrame* aOuter, bool aIsRoot)
       mIsUsingMinimumScaleSize(false),
       mMinimumScaleSizeChanged(false),
       mProcessingScrollEvent(false),
+      mApzNotificationCatchUpPending(false),
       mApzAnimationInProgress(false),
       mApzAnimationRequested(false),
       mReclampVVOffsetInReflowFinished(false),
@@ -2972,9 +2973,25 @@ void ScrollFrameHelper::ScrollToImpl(nsPoint aPt, const nsRect& aRange,
     needFrameVisibilityUpdate = true;
   }
 
+  // When APZ hands scrolling back to the main thread it can deliver several
+  // repaint requests within a single refresh tick. The frame position has to
+  // track every one of them, but the notification tail (position listeners,
+  // scrollbar attribute updates and scroll observers) only needs to run once
+  // per tick: the first request this tick notifies as usual, and later ones
+  // are caught up by FireScrollEvent on the next tick, right before the
+  // (already coalesced) scroll event fires with the final position.
+  bool coalesceApzNotifications = false;
+  if (aOrigin == ScrollOrigin::Apz) {
+    TimeStamp refreshTime = presContext->RefreshDriver()->MostRecentRefresh();
+    coalesceApzNotifications = mLastApzNotificationTime == refreshTime;
+    mLastApzNotificationTime = refreshTime;
+  }
+
   // notify the listeners.
-  for (uint32_t i = 0; i < mListeners.Length(); i++) {
-    mListeners[i]->ScrollPositionWillChange(pt.x, pt.y);
+  if (!coalesceApzNotifications) {
+    for (uint32_t i = 0; i < mListeners.Length(); i++) {
+      mListeners[i]->ScrollPositionWillChange(pt.x, pt.y);
+    }
   }
 
   nsRect oldDisplayPort;
@@ -2985,6 +3002,10 @@ void ScrollFrameHelper::ScrollToImpl(nsPoint aPt, const nsRect& aRange,
   // Update frame position for scrolling
   mScrolledFrame->SetPosition(mScrollPort.TopLeft() - pt);
 
+  // Moving the scrolled frame changes the viewport-relative position of every
+  // frame inside it, so cached layout query results are no longer valid.
+  mOuter->PresShell()->IncrementLayoutGeneration();
+
   // If |mLastScrollOrigin| is already set to something that can clobber APZ's
   // scroll offset, then we don't want to change it to something that can't.
   // If we allowed this, then we could end up in a state where APZ ignores
@@ -3138,6 +3159,22 @@ void ScrollFrameHelper::ScrollToImpl(nsPoint aPt, const nsRect& aRange,
 
   PresShell::AutoAssertNoFlush noFlush(*mOuter->PresShell());
 
+  if (coalesceApzNotifications) {
+    // A previous APZ update already notified during this tick. Just make sure
+    // the scroll event stays pending so that FireScrollEvent runs the
+    // catch-up with the final position on the next tick.
+    mApzNotificationCatchUpPending = true;
+    PostScrollEvent();
+    if (mIsRoot) {
+      if (auto* window = nsGlobalWindowInner::Cast(
+              mOuter->PresContext()->Document()->GetInnerWindow())) {
+        window->VisualViewport()->PostScrollEvent(
+            presContext->PresShell()->GetVisualViewportOffset(), curPos);
+      }
+    }
+    return;
+  }
+
   {  // scope the AutoScrollbarRepaintSuppression
     AutoWeakFrame weakFrame(mOuter);
     AutoScrollbarRepaintSuppression repaintSuppression(this, weakFrame,
@@ -5682,6 +5719,26 @@ void ScrollFrameHelper::FireScrollEvent() {
   mScrollEvent->Revoke();
   mScrollEvent = nullptr;
 
+  // Catch up any notification work that ScrollToImpl coalesced for
+  // APZ-originated scrolls during the last tick, so that listeners and
+  // observers see the final scroll position in the usual order (scrollbar
+  // state, position listeners, scroll event, scroll observers).
+  if (mApzNotificationCatchUpPending) {
+    mApzNotificationCatchUpPending = false;
+    AutoWeakFrame weakFrame(mOuter);
+    UpdateScrollbarPosition();
+    if (!weakFrame.IsAlive()) {
+      return;
+    }
+    nsPoint pt = GetScrollPosition();
+    for (uint32_t i = 0; i < mListeners.Length(); i++) {
+      mListeners[i]->ScrollPositionDidChange(pt.x, pt.y);
+    }
+    if (nsCOMPtr<nsIDocShell> shell = prescontext->GetDocShell()) {
+      shell->NotifyScrollObservers();
+    }
+  }
+
   // If event handling is suppressed, keep posting the scroll event to the
   // refresh driver until it is unsuppressed. The event is marked as delayed so
   // that the refresh driver does not continue ticking.
@@ -595,6 +595,12 @@ class ScrollFrameHelper : public nsIReflowCallback {
   // and is used to calculate relative scroll offset updates.
   nsPoint mApzScrollPos;
 
+  // The refresh tick during which we last ran the scroll notification tail
+  // (position listeners, scrollbar updates, scroll observers) for an
+  // APZ-originated scroll. Used by ScrollToImpl to coalesce that work when
+  // several APZ repaint requests arrive within a single tick.
+  mozilla::TimeStamp mLastApzNotificationTime;
+
   nsExpirationState mActivityExpirationState;
 
   nsCOMPtr<nsITimer> mScrollActivityTimer;
@@ -708,6 +714,11 @@ class ScrollFrameHelper : public nsIReflowCallback {
   // True if we're processing an scroll event.
   bool mProcessingScrollEvent : 1;
 
+  // True if ScrollToImpl coalesced the notification tail of an APZ-originated
+  // scroll, and FireScrollEvent still has to catch listeners and observers up
+  // with the final scroll position.
+  bool mApzNotificationCatchUpPending : 1;
+
   // Whether an APZ animation is in progress. Note that this is only set to true
   // when repainted via APZ, which means that there may be a request for an APZ
   // animation in flight for example, while this is still false. In order to
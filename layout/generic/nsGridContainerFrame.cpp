@@ -2798,41 +2798,51 @@ struct MOZ_STACK_CLASS nsGridContainerFrame::GridReflowInput {
     }
 
     // Copy item data from each child's first-in-flow data in mSharedGridData.
-    // XXX NOTE: This is O(n^2) in the number of items. (bug 1252186)
+    // Index the shared items by their first-in-flow frame up front so this
+    // stays linear in the number of items (bug 1252186).
+    nsDataHashtable<nsPtrHashKey<const nsIFrame>, size_t> sharedItemIndex(
+        mSharedGridData->mGridItems.Length());
+    for (size_t i = 0, len = mSharedGridData->mGridItems.Length(); i < len;
+         ++i) {
+      sharedItemIndex.Put(mSharedGridData->mGridItems[i].mFrame, i);
+    }
     mIter.Reset();
     for (; !mIter.AtEnd(); mIter.Next()) {
       nsIFrame* child = *mIter;
       nsIFrame* childFirstInFlow = child->FirstInFlow();
       DebugOnly<size_t> len = mGridItems.Length();
-      for (auto& itemInfo : mSharedGridData->mGridItems) {
-        if (itemInfo.mFrame == childFirstInFlow) {
-          auto item =
-              mGridItems.AppendElement(GridItemInfo(child, itemInfo.mArea));
-          // Copy the item's baseline data so that the item's last fragment can
-          // do 'last baseline' alignment if necessary.
-          item->mState[0] |= itemInfo.mState[0] & ItemState::eAllBaselineBits;
-          item->mState[1] |= itemInfo.mState[1] & ItemState::eAllBaselineBits;
-          item->mBaselineOffset[0] = itemInfo.mBaselineOffset[0];
-          item->mBaselineOffset[1] = itemInfo.mBaselineOffset[1];
-          item->mState[0] |= itemInfo.mState[0] & ItemState::eAutoPlacement;
-          item->mState[1] |= itemInfo.mState[1] & ItemState::eAutoPlacement;
-          break;
-        }
+      size_t index;
+      if (sharedItemIndex.Get(childFirstInFlow, &index)) {
+        auto& itemInfo = mSharedGridData->mGridItems[index];
+        auto item =
+            mGridItems.AppendElement(GridItemInfo(child, itemInfo.mArea));
+        // Copy the item's baseline data so that the item's last fragment can
+        // do 'last baseline' alignment if necessary.
+        item->mState[0] |= itemInfo.mState[0] & ItemState::eAllBaselineBits;
+        item->mState[1] |= itemInfo.mState[1] & ItemState::eAllBaselineBits;
+        item->mBaselineOffset[0] = itemInfo.mBaselineOffset[0];
+        item->mBaselineOffset[1] = itemInfo.mBaselineOffset[1];
+        item->mState[0] |= itemInfo.mState[0] & ItemState::eAutoPlacement;
+        item->mState[1] |= itemInfo.mState[1] & ItemState::eAutoPlacement;
       }
       MOZ_ASSERT(mGridItems.Length() == len + 1, "can't find GridItemInfo");
     }
 
-    // XXX NOTE: This is O(n^2) in the number of abs.pos. items. (bug 1252186)
+    // Same treatment for the abs.pos. items (bug 1252186).
+    sharedItemIndex.Clear();
+    for (size_t i = 0, len = mSharedGridData->mAbsPosItems.Length(); i < len;
+         ++i) {
+      sharedItemIndex.Put(mSharedGridData->mAbsPosItems[i].mFrame, i);
+    }
     nsFrameList absPosChildren(aGridContainerFrame->GetChildList(
         aGridContainerFrame->GetAbsoluteListID()));
     for (auto f : absPosChildren) {
       nsIFrame* childFirstInFlow = f->FirstInFlow();
       DebugOnly<size_t> len = mAbsPosItems.Length();
-      for (auto& itemInfo : mSharedGridData->mAbsPosItems) {
-        if (itemInfo.mFrame == childFirstInFlow) {
-          mAbsPosItems.AppendElement(GridItemInfo(f, itemInfo.mArea));
-          break;
-        }
+      size_t index;
+      if (sharedItemIndex.Get(childFirstInFlow, &index)) {
+        mAbsPosItems.AppendElement(
+            GridItemInfo(f, mSharedGridData->mAbsPosItems[index].mArea));
       }
       MOZ_ASSERT(mAbsPosItems.Length() == len + 1, "can't find GridItemInfo");
     }
@@ -8708,19 +8718,25 @@ void nsGridContainerFrame::Reflow(nsPresContext* aPresContext,
       // An ordered child list can't become unordered by pushing frames.
       // An unordered list can become ordered in a number of cases, but we
       // ignore that here and guess that the child list is still unordered.
-      // XXX this is O(n^2) in the number of items in this fragment: bug 1306705
       using Filter = CSSOrderAwareFrameIterator::ChildFilter;
       using Order = CSSOrderAwareFrameIterator::OrderState;
       bool ordered = gridReflowInput.mIter.ItemsAreAlreadyInOrder();
       auto orderState = ordered ? Order::Ordered : Order::Unordered;
       iter.emplace(this, kPrincipalList, Filter::SkipPlaceholders, orderState);
       gridItems.emplace();
+      // Index the item data by frame so the lookup below is O(1) instead of
+      // a linear search per child (bug 1306705).
+      nsDataHashtable<nsPtrHashKey<const nsIFrame>, size_t> itemIndex(
+          gridReflowInput.mGridItems.Length());
+      for (size_t i = 0, len = gridReflowInput.mGridItems.Length(); i < len;
+           ++i) {
+        itemIndex.Put(gridReflowInput.mGridItems[i].mFrame, i);
+      }
       for (; !iter->AtEnd(); iter->Next()) {
         auto child = **iter;
-        for (const auto& info : gridReflowInput.mGridItems) {
-          if (info.mFrame == child) {
-            gridItems->AppendElement(info);
-          }
+        size_t index;
+        if (itemIndex.Get(child, &index)) {
+          gridItems->AppendElement(gridReflowInput.mGridItems[index]);
         }
       }
     }
@@ -59,6 +59,12 @@ uint32_t DisplayItemClipChain::Hash(const DisplayItemClipChain* aClip) {
     }
   }
 
+  // Mix in the ancestor clips, structurally like ::Equal does, so that chains
+  // sharing a leaf clip but hanging off different ancestors don't all land in
+  // the same bucket of the deduplication table. Chains are only a few links
+  // deep (one per ASR), so the recursion is cheap.
+  hash = AddToHash(hash, Hash(aClip->mParent));
+
   return hash;
 }
 
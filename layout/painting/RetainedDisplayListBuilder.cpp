@@ -180,6 +180,21 @@ bool RetainedDisplayListBuilder::PreProcessDisplayList(
 
   nsDisplayList out;
 
+  // A frame commonly contributes several consecutive items to its list, and
+  // they all share the same invalidation frame, so memoize the result of the
+  // last ancestor walk. Nothing marks frames modified while we iterate, so a
+  // single-entry cache is safe.
+  nsIFrame* lastQueriedFrame = nullptr;
+  bool lastQueryResult = false;
+  auto anyContentAncestorModified = [&](nsIFrame* aInvalidationFrame) {
+    if (aInvalidationFrame != lastQueriedFrame) {
+      lastQueriedFrame = aInvalidationFrame;
+      lastQueryResult =
+          AnyContentAncestorModified(aInvalidationFrame, aOuterFrame);
+    }
+    return lastQueryResult;
+  };
+
   size_t i = 0;
   while (nsDisplayItem* item = aList->RemoveBottom()) {
 #ifdef MOZ_DIAGNOSTIC_ASSERT_ENABLED
@@ -207,7 +222,7 @@ bool RetainedDisplayListBuilder::PreProcessDisplayList(
     }
 
     if (!item->CanBeReused() || item->HasDeletedFrame() ||
-        AnyContentAncestorModified(item->FrameForInvalidation(), aOuterFrame)) {
+        anyContentAncestorModified(item->FrameForInvalidation())) {
       if (initializeOldItems) {
         aList->mOldItems.AppendElement(OldItemInfo(nullptr));
       } else {
@@ -3290,8 +3290,10 @@ bool nsDisplaySolidColor::CreateWebRenderCommands(
   LayoutDeviceRect bounds = LayoutDeviceRect::FromAppUnits(
       mBounds, mFrame->PresContext()->AppUnitsPerDevPixel());
   wr::LayoutRect r = wr::ToLayoutRect(bounds);
+  aBuilder.StartGroup(this);
   aBuilder.PushRect(r, r, !BackfaceIsHidden(),
                     wr::ToColorF(ToDeviceColor(mColor)));
+  aBuilder.FinishGroup();
 
   return true;
 }
@@ -4857,7 +4859,9 @@ bool nsDisplayOutline::CreateWebRenderCommands(
     return true;
   }
 
+  aBuilder.StartGroup(this);
   borderRenderer->CreateWebRenderCommands(this, aBuilder, aResources, aSc);
+  aBuilder.FinishGroup();
   return true;
 }
 
@@ -5262,6 +5266,8 @@ bool nsDisplayBoxShadowOuter::CreateWebRenderCommands(
     return false;
   }
 
+  aBuilder.StartGroup(this);
+
   int32_t appUnitsPerDevPixel = mFrame->PresContext()->AppUnitsPerDevPixel();
   nsPoint offset = ToReferenceFrame();
   nsRect borderRect = mFrame->VisualBorderRectRelativeToSelf() + offset;
@@ -5338,6 +5344,7 @@ bool nsDisplayBoxShadowOuter::CreateWebRenderCommands(
     }
   }
 
+  aBuilder.FinishGroup();
   return true;
 }
 
@@ -5484,12 +5491,14 @@ bool nsDisplayBoxShadowInner::CreateWebRenderCommands(
     return false;
   }
 
+  aBuilder.StartGroup(this);
   bool snap;
   nsRegion visible = GetBounds(aDisplayListBuilder, &snap);
   nsPoint offset = ToReferenceFrame();
   nsRect borderRect = nsRect(offset, mFrame->GetSize());
   nsDisplayBoxShadowInner::CreateInsetBoxShadowWebRenderCommands(
       aBuilder, aSc, visible, mFrame, borderRect);
+  aBuilder.FinishGroup();
 
   return true;
 }
@@ -10,6 +10,8 @@
 
 #include "gfxContext.h"
 #include "mozilla/Attributes.h"
+#include "mozilla/Maybe.h"
+#include "mozilla/StaticPrefs_print.h"
 #include "mozilla/Unused.h"
 #include "nsAppDirectoryServiceDefs.h"
 #include "nsComponentManagerUtils.h"
@@ -18,6 +20,7 @@
 #include "nsIDeviceContextSpec.h"
 #include "nsIPrintSettings.h"
 #include "nsIWebProgressListener.h"
+#include "nsThreadUtils.h"
 #include "PrintTranslator.h"
 #include "private/pprio.h"
 #include "nsAnonymousTemporaryFile.h"
@@ -44,6 +47,21 @@ mozilla::ipc::IPCResult RemotePrintJobParent::RecvInitializePrint(
   }
 
   mPrintTranslator.reset(new PrintTranslator(mPrintDeviceContext));
+
+  if (StaticPrefs::print_page_replay_on_background_thread() &&
+      mPrintDeviceContext->IsOffMainThreadPrintingSafe() &&
+      mPrintDeviceContext->IsSyncPagePrinting()) {
+    // Replay and serialize pages on a background queue rather than janking
+    // the parent main thread for every page. The queue is serial, so pages
+    // are still written out in order; the child renders its next page while
+    // we serialize the previous one.
+    nsCOMPtr<nsISerialEventTarget> queue;
+    if (NS_SUCCEEDED(NS_CreateBackgroundTaskQueue("PrintPageReplay",
+                                                  getter_AddRefs(queue)))) {
+      mReplayTaskQueue = queue;
+    }
+  }
+
   FileDescriptor fd;
   rv = PrepareNextPageFD(&fd);
   if (NS_FAILED(rv)) {
@@ -105,17 +123,18 @@ nsresult RemotePrintJobParent::PrepareNextPageFD(FileDescriptor* aFd) {
   }
   *aFd = FileDescriptor(
       FileDescriptor::PlatformHandleType(PR_FileDesc2NativeHandle(prFd)));
-  mCurrentPageStream.OpenFD(prFd);
+  mCurrentPageStream = MakeUnique<PRFileDescStream>();
+  mCurrentPageStream->OpenFD(prFd);
   return NS_OK;
 }
 
 mozilla::ipc::IPCResult RemotePrintJobParent::RecvProcessPage(
     nsTArray<uint64_t>&& aDeps) {
-  if (!mCurrentPageStream.IsOpen()) {
+  if (!mCurrentPageStream || !mCurrentPageStream->IsOpen()) {
     Unused << SendAbortPrint(NS_ERROR_FAILURE);
     return IPC_OK();
   }
-  mCurrentPageStream.Seek(0, PR_SEEK_SET);
+  mCurrentPageStream->Seek(0, PR_SEEK_SET);
 
   if (aDeps.IsEmpty()) {
     FinishProcessingPage();
@@ -143,15 +162,48 @@ mozilla::ipc::IPCResult RemotePrintJobParent::RecvProcessPage(
 
 void RemotePrintJobParent::FinishProcessingPage(
     gfx::CrossProcessPaint::ResolvedFragmentMap* aFragments) {
-  nsresult rv = PrintPage(mCurrentPageStream, aFragments);
+  UniquePtr<PRFileDescStream> recording = std::move(mCurrentPageStream);
+
+  if (mReplayTaskQueue) {
+    // The queue is only created for synchronously printing targets, so no
+    // device page-done callback is outstanding. Replay and serialize this
+    // page in the background and hand the child the next page's file
+    // descriptor right away, so it can render the next page while this one
+    // is written out.
+    Maybe<gfx::CrossProcessPaint::ResolvedFragmentMap> fragments;
+    if (aFragments) {
+      fragments.emplace(std::move(*aFragments));
+    }
+    mReplayTaskQueue->Dispatch(NS_NewRunnableFunction(
+        "RemotePrintJobParent::FinishProcessingPage",
+        [self = RefPtr{this}, recording = std::move(recording),
+         fragments = std::move(fragments)]() mutable {
+          nsresult rv =
+              self->PrintPage(*recording, fragments ? fragments.ptr() : nullptr);
+          recording->Close();
+          NS_DispatchToMainThread(NS_NewRunnableFunction(
+              "RemotePrintJobParent::ReplayPageDone",
+              [self, rv]() { self->ReplayPageDone(rv); }));
+        }));
+    PageDone(NS_OK);
+    return;
+  }
+
+  nsresult rv = PrintPage(*recording, aFragments);
 
-  mCurrentPageStream.Close();
+  recording->Close();
 
   if (mPrintDeviceContext->IsSyncPagePrinting()) {
     PageDone(rv);
   }
 }
 
+void RemotePrintJobParent::ReplayPageDone(nsresult aResult) {
+  if (NS_FAILED(aResult) && mIsDoingPrinting && CanSend()) {
+    Unused << SendAbortPrint(aResult);
+  }
+}
+
 nsresult RemotePrintJobParent::PrintPage(
     PRFileDescStream& aRecording,
     gfx::CrossProcessPaint::ResolvedFragmentMap* aFragments) {
@@ -196,6 +248,20 @@ mozilla::ipc::IPCResult RemotePrintJobParent::RecvFinalizePrint() {
   // EndDocument is sometimes called in the child even when BeginDocument has
   // not been called. See bug 1223332.
   if (mPrintDeviceContext) {
+    if (mReplayTaskQueue) {
+      // EndDocument has to run on the main thread (the device context spec
+      // may talk to the platform's print system), but not before every page
+      // still being replayed has been serialized, so bounce through the
+      // replay queue as a barrier.
+      mReplayTaskQueue->Dispatch(NS_NewRunnableFunction(
+          "RemotePrintJobParent::RecvFinalizePrint", [self = RefPtr{this}]() {
+            NS_DispatchToMainThread(NS_NewRunnableFunction(
+                "RemotePrintJobParent::FinalizePrintDone",
+                [self]() { self->FinalizePrintDone(false); }));
+          }));
+      return IPC_OK();
+    }
+
     DebugOnly<nsresult> rv = mPrintDeviceContext->EndDocument();
 
     // Too late to abort the child just log.
@@ -216,6 +282,18 @@ mozilla::ipc::IPCResult RemotePrintJobParent::RecvFinalizePrint() {
 mozilla::ipc::IPCResult RemotePrintJobParent::RecvAbortPrint(
     const nsresult& aRv) {
   if (mPrintDeviceContext) {
+    if (mReplayTaskQueue) {
+      // Abort behind any page replays that are still in flight; as with
+      // finalization, the abort itself has to happen on the main thread.
+      mReplayTaskQueue->Dispatch(NS_NewRunnableFunction(
+          "RemotePrintJobParent::RecvAbortPrint", [self = RefPtr{this}]() {
+            NS_DispatchToMainThread(NS_NewRunnableFunction(
+                "RemotePrintJobParent::FinalizePrintDone",
+                [self]() { self->FinalizePrintDone(true); }));
+          }));
+      return IPC_OK();
+    }
+
     Unused << mPrintDeviceContext->AbortDocument();
     mPrintDeviceContext->UnregisterPageDoneCallback();
   }
@@ -226,6 +304,24 @@ mozilla::ipc::IPCResult RemotePrintJobParent::RecvAbortPrint(
   return IPC_OK();
 }
 
+void RemotePrintJobParent::FinalizePrintDone(bool aAbort) {
+  if (aAbort) {
+    Unused << mPrintDeviceContext->AbortDocument();
+  } else {
+    nsresult rv = mPrintDeviceContext->EndDocument();
+    // Too late to abort the child just log.
+    NS_WARNING_ASSERTION(NS_SUCCEEDED(rv), "EndDocument failed");
+    Unused << rv;
+  }
+  mPrintDeviceContext->UnregisterPageDoneCallback();
+
+  mIsDoingPrinting = false;
+
+  if (CanSend()) {
+    Unused << Send__delete__(this);
+  }
+}
+
 mozilla::ipc::IPCResult RemotePrintJobParent::RecvStateChange(
     const long& aStateFlags, const nsresult& aStatus) {
   uint32_t numberOfListeners = mPrintProgressListeners.Length();
@@ -12,6 +12,7 @@
 
 #include "nsCOMArray.h"
 #include "nsCOMPtr.h"
+#include "nsISerialEventTarget.h"
 #include "mozilla/RefPtr.h"
 #include "mozilla/UniquePtr.h"
 #include "mozilla/gfx/RecordedEvent.h"
@@ -88,11 +89,28 @@ class RemotePrintJobParent final : public PRemotePrintJobParent {
    */
   void PageDone(nsresult aResult);
 
+  /**
+   * Called on the main thread once a page replayed on mReplayTaskQueue has
+   * been serialized, to report any failure to the child.
+   */
+  void ReplayPageDone(nsresult aResult);
+
+  /**
+   * Called on the main thread once every page queued on mReplayTaskQueue has
+   * been serialized, to end (or abort) the document and finish tearing down
+   * the print job.
+   */
+  void FinalizePrintDone(bool aAbort);
+
   nsCOMPtr<nsIPrintSettings> mPrintSettings;
   RefPtr<nsDeviceContext> mPrintDeviceContext;
   UniquePtr<PrintTranslator> mPrintTranslator;
   nsCOMArray<nsIWebProgressListener> mPrintProgressListeners;
-  PRFileDescStream mCurrentPageStream;
+  // When set, pages are replayed and serialized on this background queue
+  // instead of the main thread. Only used with print targets that are safe
+  // to drive off the main thread and print pages synchronously.
+  nsCOMPtr<nsISerialEventTarget> mReplayTaskQueue;
+  UniquePtr<PRFileDescStream> mCurrentPageStream;
   bool mIsDoingPrinting;
 };
 
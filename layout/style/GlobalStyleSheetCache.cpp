@@ -13,9 +13,11 @@
 #include "mozilla/StyleSheet.h"
 #include "mozilla/StyleSheetInlines.h"
 #include "mozilla/Telemetry.h"
+#include "mozilla/Unused.h"
 #include "mozilla/css/Loader.h"
 #include "mozilla/dom/SRIMetadata.h"
 #include "mozilla/ipc/SharedMemory.h"
+#include "mozilla/scache/StartupCache.h"
 #include "MainThreadUtils.h"
 #include "nsColor.h"
 #include "nsContentUtils.h"
@@ -108,6 +110,19 @@ using namespace css;
 #define PREF_LEGACY_STYLESHEET_CUSTOMIZATION \
   "toolkit.legacyUserProfileCustomizations.stylesheets"
 
+// Startup cache entry that holds a copy of the shared UA sheet buffer built
+// by a previous session, prefixed with the address the buffer was mapped at.
+// The serialized rule data contains absolute pointers into the buffer, so the
+// copy is only usable if we manage to map the shared memory at that same
+// address again.  It also embeds build-specific data such as static atom
+// indices, but that's fine, since the startup cache is invalidated whenever
+// the build ID changes.
+//
+// If we ever make UA sheet parsing depend on prefs (see the commented-out
+// RegisterCallback call in Singleton), such pref changes will need to
+// invalidate this entry too.
+#define UA_SHEETS_CACHE_KEY "layout.ua-sheets"
+
 NS_IMPL_ISUPPORTS(GlobalStyleSheetCache, nsIObserver, nsIMemoryReporter)
 
 nsresult GlobalStyleSheetCache::Observe(nsISupports* aSubject,
@@ -328,6 +343,48 @@ void GlobalStyleSheetCache::InitSharedSheetsInParent() {
     return;
   }
 
+  // If a previous session persisted a copy of the buffer it built, restoring
+  // that copy lets us skip parsing the UA sheets entirely.
+  void* address = nullptr;
+  size_t usedLength = 0;
+  if (!TryRestoreSharedSheets(shm.get(), &address, &usedLength)) {
+    if (!BuildSharedSheets(shm.get(), &address, &usedLength)) {
+      return;
+    }
+  }
+
+  // Finished writing into the shared memory.  Freeze it, so that a process
+  // can't confuse other processes by changing the UA style sheet contents.
+  if (NS_WARN_IF(!shm->Freeze())) {
+    return;
+  }
+
+  // The Freeze() call unmaps the shared memory.  Re-map it again as read only.
+  // If this fails, due to something else being mapped into the same place
+  // between the Freeze() and Map() call, we can just fall back to keeping our
+  // own copy of the UA style sheets in the parent, and still try sending the
+  // shared memory to the content processes.
+  bool parentRemapped = shm->Map(kSharedMemorySize, address);
+  Telemetry::Accumulate(
+      Telemetry::SHARED_MEMORY_UA_SHEETS_MAPPED_PARENT_AFTER_FREEZE,
+      parentRemapped);
+
+  // Record how must of the shared memory we have used, for memory reporting
+  // later.  We round up to the nearest page since the free space at the end
+  // of the page isn't really usable for anything else.
+  //
+  // TODO(heycam): This won't be true on Windows unless we allow creating the
+  // shared memory with SEC_RESERVE so that the pages are reserved but not
+  // committed.
+  size_t pageSize = ipc::SharedMemory::SystemPageSize();
+  sUsedSharedMemory = (usedLength + pageSize - 1) & ~(pageSize - 1);
+
+  sSharedMemory = shm.release();
+}
+
+bool GlobalStyleSheetCache::BuildSharedSheets(base::SharedMemory* aShm,
+                                              void** aAddress,
+                                              size_t* aUsedLength) {
   // We need to choose an address to map the shared memory in the parent process
   // that we'll also be able to use in content processes.  There's no way to
   // pick an address that is guaranteed to be free in future content processes,
@@ -360,7 +417,7 @@ void GlobalStyleSheetCache::InitSharedSheetsInParent() {
     address = reinterpret_cast<void*>(uintptr_t(p) + kOffset);
   }
 
-  bool parentMapped = shm->Map(kSharedMemorySize, address);
+  bool parentMapped = aShm->Map(kSharedMemorySize, address);
   Telemetry::Accumulate(Telemetry::SHARED_MEMORY_UA_SHEETS_MAPPED_PARENT,
                         parentMapped);
 
@@ -368,11 +425,11 @@ void GlobalStyleSheetCache::InitSharedSheetsInParent() {
     // Failed to map at the address we computed for some reason.  Fall back
     // to just allocating at a location of the OS's choosing, and hope that
     // it works in the content process.
-    if (NS_WARN_IF(!shm->Map(kSharedMemorySize))) {
-      return;
+    if (NS_WARN_IF(!aShm->Map(kSharedMemorySize))) {
+      return false;
     }
   }
-  address = shm->memory();
+  address = aShm->memory();
 
   auto header = static_cast<Header*>(address);
   header->mMagic = Header::kMagic;
@@ -403,7 +460,7 @@ void GlobalStyleSheetCache::InitSharedSheetsInParent() {
       CrashReporter::AppendAppNotesToCrashReport("\n"_ns + message);    \
       Telemetry::Accumulate(                                            \
           Telemetry::SHARED_MEMORY_UA_SHEETS_TOSHMEM_SUCCEEDED, false); \
-      return;                                                           \
+      return false;                                                     \
     }                                                                   \
   }
 #include "mozilla/UserAgentStyleSheetList.h"
@@ -412,35 +469,72 @@ void GlobalStyleSheetCache::InitSharedSheetsInParent() {
   Telemetry::Accumulate(Telemetry::SHARED_MEMORY_UA_SHEETS_TOSHMEM_SUCCEEDED,
                         true);
 
-  // Finished writing into the shared memory.  Freeze it, so that a process
-  // can't confuse other processes by changing the UA style sheet contents.
-  if (NS_WARN_IF(!shm->Freeze())) {
-    return;
+  *aAddress = address;
+  *aUsedLength = offsetof(Header, mBuffer) +
+                 Servo_SharedMemoryBuilder_GetLength(builder.get());
+
+  // Persist the buffer so that the next session can restore it instead of
+  // parsing the sheets again.
+  SaveSharedSheetsToCache(address, *aUsedLength);
+
+  return true;
+}
+
+bool GlobalStyleSheetCache::TryRestoreSharedSheets(base::SharedMemory* aShm,
+                                                   void** aAddress,
+                                                   size_t* aUsedLength) {
+  auto* cache = scache::StartupCache::GetSingleton();
+  if (!cache) {
+    return false;
   }
 
-  // The Freeze() call unmaps the shared memory.  Re-map it again as read only.
-  // If this fails, due to something else being mapped into the same place
-  // between the Freeze() and Map() call, we can just fall back to keeping our
-  // own copy of the UA style sheets in the parent, and still try sending the
-  // shared memory to the content processes.
-  bool parentRemapped = shm->Map(kSharedMemorySize, address);
-  Telemetry::Accumulate(
-      Telemetry::SHARED_MEMORY_UA_SHEETS_MAPPED_PARENT_AFTER_FREEZE,
-      parentRemapped);
+  const char* buf = nullptr;
+  uint32_t len = 0;
+  if (NS_FAILED(cache->GetBuffer(UA_SHEETS_CACHE_KEY, &buf, &len)) ||
+      len <= sizeof(uintptr_t) + offsetof(Header, mBuffer) ||
+      len > sizeof(uintptr_t) + kSharedMemorySize) {
+    return false;
+  }
 
-  // Record how must of the shared memory we have used, for memory reporting
-  // later.  We round up to the nearest page since the free space at the end
-  // of the page isn't really usable for anything else.
-  //
-  // TODO(heycam): This won't be true on Windows unless we allow creating the
-  // shared memory with SEC_RESERVE so that the pages are reserved but not
-  // committed.
-  size_t pageSize = ipc::SharedMemory::SystemPageSize();
-  sUsedSharedMemory =
-      (Servo_SharedMemoryBuilder_GetLength(builder.get()) + pageSize - 1) &
-      ~(pageSize - 1);
+  uintptr_t base;
+  memcpy(&base, buf, sizeof(base));
+  const char* data = buf + sizeof(base);
+  size_t dataLength = len - sizeof(base);
 
-  sSharedMemory = shm.release();
+  // Only use the copy if it still looks like a buffer we wrote.  (Build
+  // changes can't get us here with a stale buffer, since the whole startup
+  // cache is invalidated when the build ID changes.)
+  if (reinterpret_cast<const Header*>(data)->mMagic != Header::kMagic) {
+    return false;
+  }
+
+  // The buffer's internal pointers assume it lives at the address it was
+  // originally mapped at, so we must map there again; if something else
+  // already occupies that space in this session, fall back to parsing.
+  if (!aShm->Map(kSharedMemorySize, reinterpret_cast<void*>(base))) {
+    return false;
+  }
+
+  memcpy(aShm->memory(), data, dataLength);
+
+  *aAddress = aShm->memory();
+  *aUsedLength = dataLength;
+  return true;
+}
+
+void GlobalStyleSheetCache::SaveSharedSheetsToCache(const void* aAddress,
+                                                    size_t aUsedLength) {
+  auto* cache = scache::StartupCache::GetSingleton();
+  if (!cache) {
+    return;
+  }
+
+  uint32_t len = sizeof(uintptr_t) + aUsedLength;
+  auto buf = MakeUnique<char[]>(len);
+  uintptr_t base = uintptr_t(aAddress);
+  memcpy(buf.get(), &base, sizeof(base));
+  memcpy(buf.get() + sizeof(base), aAddress, aUsedLength);
+  Unused << cache->PutBuffer(UA_SHEETS_CACHE_KEY, std::move(buf), len);
 }
 
 GlobalStyleSheetCache::~GlobalStyleSheetCache() {
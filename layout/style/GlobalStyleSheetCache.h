@@ -99,6 +99,26 @@ class GlobalStyleSheetCache final : public nsIObserver,
 
   void InitFromProfile();
   void InitSharedSheetsInParent();
+
+  // Parses the shareable UA sheets and copies them into the shared memory
+  // buffer, mapping aShm at an address that content processes will hopefully
+  // be able to map at too.  On success returns true and sets aAddress and
+  // aUsedLength.
+  bool BuildSharedSheets(base::SharedMemory* aShm, void** aAddress,
+                         size_t* aUsedLength);
+
+  // Attempts to fill the shared memory buffer from a copy of a previous
+  // session's buffer persisted in the startup cache, mapping aShm at the
+  // address the copy was built for.  On success returns true and sets
+  // aAddress and aUsedLength; on failure aShm is left unmapped and the
+  // caller parses the UA sheets as usual.
+  bool TryRestoreSharedSheets(base::SharedMemory* aShm, void** aAddress,
+                              size_t* aUsedLength);
+
+  // Saves a copy of the freshly built shared memory buffer into the startup
+  // cache so that the next session can skip parsing the UA sheets.
+  void SaveSharedSheetsToCache(const void* aAddress, size_t aUsedLength);
+
   void InitMemoryReporter();
   RefPtr<StyleSheet> LoadSheetURL(const char* aURL,
                                   css::SheetParsingMode aParsingMode,
@@ -543,9 +543,91 @@ gfxRect FilterInstance::FilterSpaceToUserSpace(
   return userSpaceRect;
 }
 
+/**
+ * A cache of the primitive graph that BuildPrimitives produces for a filtered
+ * frame. Building the graph walks the filter chain, resolves the referenced
+ * filter frames and converts every primitive's attributes and subregion, which
+ * is too expensive to redo on each of the several FilterInstances that a
+ * single paint creates (dirty area computation, overflow and painting itself).
+ *
+ * The key below captures every input that feeds BuildPrimitives apart from
+ * the filter elements and the filter style itself; changes to those remove
+ * the property via FilterInstance::RemoveFilterDescriptionCache.
+ */
+struct CachedFilterDescription {
+  struct Entry {
+    gfxSize mUserSpaceToFilterSpaceScale;
+    gfxRect mTargetBBox;
+    nsIntRect mTargetBounds;
+    gfxMatrix mFrameSpaceInCSSPxToFilterSpaceTransform;
+    nscolor mShadowFallbackColor;
+    float mEmLength;
+    float mExLength;
+    float mAxisXLength;
+    float mAxisYLength;
+    FilterDescription mDescription;
+    CopyableTArray<RefPtr<gfx::SourceSurface>> mInputImages;
+  };
+
+  // Painting and the pre/post-filter geometry queries build graphs at
+  // different resolutions; keep a few entries so they don't evict each other
+  // every paint.
+  static const size_t kMaxEntries = 3;
+
+  AutoTArray<Entry, kMaxEntries> mEntries;
+};
+
+NS_DECLARE_FRAME_PROPERTY_DELETABLE(FilterDescriptionCacheProperty,
+                                    CachedFilterDescription)
+
+/* static */
+void FilterInstance::RemoveFilterDescriptionCache(nsIFrame* aFrame) {
+  aFrame->RemoveProperty(FilterDescriptionCacheProperty());
+}
+
 nsresult FilterInstance::BuildPrimitives(Span<const StyleFilter> aFilterChain,
                                          nsIFrame* aTargetFrame,
                                          bool aFilterInputIsTainted) {
+  CachedFilterDescription* cache = nullptr;
+  nscolor shadowFallbackColor =
+      mTargetFrame ? mTargetFrame->StyleText()->mColor.ToColor()
+                   : NS_RGB(0, 0, 0);
+  float emLength = 0.0f;
+  float exLength = 0.0f;
+  float axisXLength = 0.0f;
+  float axisYLength = 0.0f;
+
+  // Only cache when we have a frame to hang the property off, and only on the
+  // tainted paths: all the painting and geometry entry points hardcode
+  // InputIsTainted to true, and the taintedness is baked into the cached
+  // primitives.
+  if (aTargetFrame && aFilterInputIsTainted) {
+    emLength = mMetrics.GetEmLength();
+    exLength = mMetrics.GetExLength();
+    axisXLength = mMetrics.GetAxisLength(SVGContentUtils::X);
+    axisYLength = mMetrics.GetAxisLength(SVGContentUtils::Y);
+
+    cache = aTargetFrame->GetProperty(FilterDescriptionCacheProperty());
+    if (cache) {
+      for (const auto& entry : cache->mEntries) {
+        if (entry.mUserSpaceToFilterSpaceScale ==
+                mUserSpaceToFilterSpaceScale &&
+            entry.mTargetBBox.IsEqualEdges(mTargetBBox) &&
+            entry.mTargetBounds.IsEqualEdges(mTargetBounds) &&
+            entry.mFrameSpaceInCSSPxToFilterSpaceTransform ==
+                mFrameSpaceInCSSPxToFilterSpaceTransform &&
+            entry.mShadowFallbackColor == shadowFallbackColor &&
+            entry.mEmLength == emLength && entry.mExLength == exLength &&
+            entry.mAxisXLength == axisXLength &&
+            entry.mAxisYLength == axisYLength) {
+          mFilterDescription = entry.mDescription;
+          mInputImages = entry.mInputImages.Clone();
+          return NS_OK;
+        }
+      }
+    }
+  }
+
   nsTArray<FilterPrimitiveDescription> primitiveDescriptions;
 
   for (uint32_t i = 0; i < aFilterChain.Length(); i++) {
@@ -561,6 +643,29 @@ nsresult FilterInstance::BuildPrimitives(Span<const StyleFilter> aFilterChain,
 
   mFilterDescription = FilterDescription(std::move(primitiveDescriptions));
 
+  if (aTargetFrame && aFilterInputIsTainted) {
+    if (!cache) {
+      cache = new CachedFilterDescription();
+      aTargetFrame->SetProperty(FilterDescriptionCacheProperty(), cache);
+    }
+    if (cache->mEntries.Length() >= CachedFilterDescription::kMaxEntries) {
+      cache->mEntries.RemoveElementAt(0);
+    }
+    CachedFilterDescription::Entry* entry = cache->mEntries.AppendElement();
+    entry->mUserSpaceToFilterSpaceScale = mUserSpaceToFilterSpaceScale;
+    entry->mTargetBBox = mTargetBBox;
+    entry->mTargetBounds = mTargetBounds;
+    entry->mFrameSpaceInCSSPxToFilterSpaceTransform =
+        mFrameSpaceInCSSPxToFilterSpaceTransform;
+    entry->mShadowFallbackColor = shadowFallbackColor;
+    entry->mEmLength = emLength;
+    entry->mExLength = exLength;
+    entry->mAxisXLength = axisXLength;
+    entry->mAxisYLength = axisYLength;
+    entry->mDescription = mFilterDescription;
+    entry->mInputImages = mInputImages;
+  }
+
   return NS_OK;
 }
 
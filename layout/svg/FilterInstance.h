@@ -133,6 +133,14 @@ class FilterInstance {
       mozilla::Span<const mozilla::StyleFilter> aFilters,
       WrFiltersHolder& aWrFilters, mozilla::Maybe<nsRect>& aPostFilterClip);
 
+  /**
+   * Removes the cached filter primitive graph (if any) that BuildPrimitives
+   * stored on aFrame. Must be called whenever the frame's filter chain or a
+   * referenced filter element changes; geometry changes are handled by the
+   * cache key itself.
+   */
+  static void RemoveFilterDescriptionCache(nsIFrame* aFrame);
+
  private:
   /**
    * @param aTargetFrame The frame of the filtered element under consideration,
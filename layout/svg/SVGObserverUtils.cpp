@@ -8,6 +8,7 @@
 #include "SVGObserverUtils.h"
 
 // Keep others in (case-insensitive) order:
+#include "FilterInstance.h"
 #include "mozilla/css/ImageLoader.h"
 #include "mozilla/dom/CanvasRenderingContext2D.h"
 #include "mozilla/dom/SVGGeometryElement.h"
@@ -744,6 +745,10 @@ void SVGFilterObserver::OnRenderingChange() {
     return;
   }
 
+  // The referenced filter element (or something it depends on) changed, so
+  // any primitive graph built from it is out of date.
+  FilterInstance::RemoveFilterDescriptionCache(frame);
+
   // Repaint asynchronously in case the filter frame is being torn down
   nsChangeHint changeHint = nsChangeHint(nsChangeHint_RepaintFrame);
 
@@ -1572,6 +1577,7 @@ void SVGObserverUtils::UpdateEffects(nsIFrame* aFrame) {
                "aFrame's content should be an element");
 
   aFrame->RemoveProperty(FilterProperty());
+  FilterInstance::RemoveFilterDescriptionCache(aFrame);
   aFrame->RemoveProperty(MaskProperty());
   aFrame->RemoveProperty(ClipPathProperty());
   aFrame->RemoveProperty(MarkerStartProperty());
@@ -99,6 +99,15 @@ MALLOC_DECL(jemalloc_purge_freed_pages, void)
 // provides functionality similar to mallctl("arenas.purge") in jemalloc 3.
 MALLOC_DECL(jemalloc_free_dirty_pages, void)
 
+// Retire the public arenas that served allocations so far and replace them
+// with fresh ones. Existing allocations stay valid and freeable, but the
+// retired arenas receive no new allocations and stop poisoning freed
+// regions, so the pages holding boot-time allocations (static component
+// data, prefs, atom tables) are written to as little as possible afterwards.
+// Meant to be called once startup is complete, to maximize the heap pages
+// that stay shared copy-on-write with processes created by fork().
+MALLOC_DECL(jemalloc_seal_boot_arenas, void)
+
 // Opt in or out of a thread local arena (bool argument is whether to opt-in
 // (true) or out (false)).
 MALLOC_DECL(jemalloc_thread_local_arena, void, bool)
@@ -118,6 +127,12 @@ MALLOC_DECL(moz_create_arena_with_params, arena_id_t, arena_params_t*)
 // Passing an invalid id (inexistent or already disposed) to this function
 // will crash. The arena must be empty prior to calling this function.
 MALLOC_DECL(moz_dispose_arena, void, arena_id_t)
+
+// Fill the given stats structure with usage information for the given arena,
+// including the label passed at creation time. Returns false when the
+// allocator doesn't track arenas (system malloc fallback). Passing an
+// invalid id will crash, like the other moz_arena_* functions.
+MALLOC_DECL(moz_arena_stats, bool, arena_id_t, jemalloc_arena_stats_t*)
 #  endif
 
 #  if MALLOC_FUNCS & MALLOC_FUNCS_ARENA_ALLOC
@@ -895,6 +895,16 @@ struct arena_t {
 
   arena_stats_t mStats;
 
+  // Subsystem label from arena_params_t, or null. Points to a string
+  // literal owned by the caller; reported through moz_arena_stats().
+  const char* mLabel;
+
+  // A sealed arena no longer receives new allocations (threads with a
+  // cached pointer to it re-choose an arena) and doesn't poison freed
+  // regions, so its pages are written to as little as possible. See
+  // jemalloc_seal_boot_arenas() in malloc_decls.h.
+  bool mSealed;
+
  private:
   // Tree of dirty-page-containing chunks this arena manages.
   RedBlackTree<arena_chunk_t, ArenaDirtyChunkTrait> mChunksDirty;
@@ -1053,6 +1063,14 @@ struct ArenaTreeTrait {
   }
 };
 
+// Number of shared arenas that threads without a pinned arena are spread
+// across for small allocations. Having every thread allocate out of the
+// default arena makes its lock the most contended in the process once DOM
+// workers and helper threads are busy; spreading threads round-robin over a
+// small arena set removes most of that contention while keeping the arena
+// count (and thus dirty page overhead) bounded.
+static const uint32_t kSpreadArenaCount = 4;
+
 // Bookkeeping for all the arenas used by the allocator.
 // Arenas are separated in two categories:
 // - "private" arenas, used through the moz_arena_* API
@@ -1068,7 +1086,16 @@ class ArenaCollection {
     params.mMaxDirty = opt_dirty_max;
     mDefaultArena =
         mLock.Init() ? CreateArena(/* IsPrivate = */ false, &params) : nullptr;
-    return bool(mDefaultArena);
+    if (!mDefaultArena) {
+      return false;
+    }
+    // Create the remaining spread arenas up front; an arena_t without any
+    // chunks is only a few KiB, and doing it here keeps GetSpreadArena
+    // trivially lock-free.
+    for (uint32_t i = 0; i < kSpreadArenaCount - 1; i++) {
+      mSpreadArenas[i] = CreateArena(/* IsPrivate = */ false, nullptr);
+    }
+    return true;
   }
 
   inline arena_t* GetById(arena_id_t aArenaId, bool aIsPrivate);
@@ -1112,12 +1139,47 @@ class ArenaCollection {
 
   inline arena_t* GetDefault() { return mDefaultArena; }
 
+  // Retire the current default and spread arenas: mark them sealed and
+  // replace them with freshly created ones. Sealed arenas keep serving
+  // frees for their existing allocations but receive no new ones, so the
+  // pages holding boot-time allocations are written to as little as
+  // possible afterwards and can stay shared copy-on-write with processes
+  // created by fork().
+  void SealBootArenas() {
+    arena_params_t params;
+    params.mMaxDirty = opt_dirty_max;
+    arena_t* newDefault = CreateArena(/* IsPrivate = */ false, &params);
+    arena_t* newSpread[kSpreadArenaCount - 1];
+    for (uint32_t i = 0; i < kSpreadArenaCount - 1; i++) {
+      newSpread[i] = CreateArena(/* IsPrivate = */ false, nullptr);
+    }
+    // Threads with a cached pointer to a sealed arena re-choose on their
+    // next small allocation (see choose_arena).
+    mDefaultArena->mSealed = true;
+    for (uint32_t i = 0; i < kSpreadArenaCount - 1; i++) {
+      mSpreadArenas[i]->mSealed = true;
+      mSpreadArenas[i] = newSpread[i];
+    }
+    mDefaultArena = newDefault;
+  }
+
+  // Returns the arena a thread without a pinned arena should allocate from.
+  // Threads are assigned round-robin on their first small allocation; the
+  // default arena takes part in the rotation so the first (main) thread
+  // keeps its traditional arena.
+  inline arena_t* GetSpreadArena() {
+    uint32_t bucket = mNextSpreadBucket++ % kSpreadArenaCount;
+    return bucket == 0 ? mDefaultArena : mSpreadArenas[bucket - 1];
+  }
+
   Mutex mLock;
 
  private:
   inline arena_t* GetByIdInternal(arena_id_t aArenaId, bool aIsPrivate);
 
   arena_t* mDefaultArena;
+  arena_t* mSpreadArenas[kSpreadArenaCount - 1];
+  Atomic<uint32_t, Relaxed> mNextSpreadBucket;
   arena_id_t mLastPublicArenaId;
   Tree mArenas;
   Tree mPrivateArenas;
@@ -2071,9 +2133,12 @@ static inline arena_t* choose_arena(size_t size) {
   } else {
     // Check TLS to see if our thread has requested a pinned arena.
     ret = thread_arena.get();
-    if (!ret) {
-      // Nothing in TLS. Pin this thread to the default arena.
-      ret = thread_local_arena(false);
+    if (!ret || MOZ_UNLIKELY(ret->mSealed)) {
+      // Nothing in TLS, or the cached arena was sealed by
+      // jemalloc_seal_boot_arenas(). Spread this thread across the shared
+      // arenas so threads don't all serialize on the default arena's lock.
+      ret = gArenas.GetSpreadArena();
+      thread_arena.set(ret);
     }
   }
 
@@ -3283,7 +3348,11 @@ void arena_t::DallocSmall(arena_chunk_t* aChunk, void* aPtr,
   MOZ_DIAGNOSTIC_ASSERT(uintptr_t(aPtr) >=
                         uintptr_t(run) + bin->mRunFirstRegionOffset);
 
-  memset(aPtr, kAllocPoison, size);
+  // Sealed arenas skip poisoning: writing the pattern would dirty pages that
+  // jemalloc_seal_boot_arenas() is trying to keep shared copy-on-write.
+  if (!mSealed) {
+    memset(aPtr, kAllocPoison, size);
+  }
 
   arena_run_reg_dalloc(run, bin, aPtr, size);
   run->mNumFree++;
@@ -3344,7 +3413,9 @@ void arena_t::DallocLarge(arena_chunk_t* aChunk, void* aPtr) {
   size_t pageind = (uintptr_t(aPtr) - uintptr_t(aChunk)) >> gPageSize2Pow;
   size_t size = aChunk->map[pageind].bits & ~gPageSizeMask;
 
-  memset(aPtr, kAllocPoison, size);
+  if (!mSealed) {
+    memset(aPtr, kAllocPoison, size);
+  }
   mStats.allocated_large -= size;
 
   DallocRun((arena_run_t*)aPtr, true);
@@ -3535,6 +3606,10 @@ arena_t::arena_t(arena_params_t* aParams, bool aIsPrivate) {
   }
   mPRNG = nullptr;
 
+  mLabel = aParams ? aParams->mLabel : nullptr;
+
+  mSealed = false;
+
   mIsPrivate = aIsPrivate;
 
   mNumDirty = 0;
@@ -4412,6 +4487,13 @@ inline void MozJemalloc::jemalloc_purge_freed_pages() {
 
 #endif  // defined MALLOC_DOUBLE_PURGE
 
+template <>
+inline void MozJemalloc::jemalloc_seal_boot_arenas(void) {
+  if (malloc_init()) {
+    gArenas.SealBootArenas();
+  }
+}
+
 template <>
 inline void MozJemalloc::jemalloc_free_dirty_pages(void) {
   if (malloc_initialized) {
@@ -4460,6 +4542,20 @@ inline void MozJemalloc::moz_dispose_arena(arena_id_t aArenaId) {
   gArenas.DisposeArena(arena);
 }
 
+template <>
+inline bool MozJemalloc::moz_arena_stats(arena_id_t aArenaId,
+                                         jemalloc_arena_stats_t* aStats) {
+  arena_t* arena = gArenas.GetById(aArenaId, /* IsPrivate = */ true);
+  MutexAutoLock lock(arena->mLock);
+  aStats->label = arena->mLabel;
+  aStats->mapped = arena->mStats.mapped;
+  aStats->committed = arena->mStats.committed << gPageSize2Pow;
+  aStats->allocated =
+      arena->mStats.allocated_small + arena->mStats.allocated_large;
+  aStats->dirty = arena->mNumDirty << gPageSize2Pow;
+  return true;
+}
+
 #define MALLOC_DECL(name, return_type, ...)                          \
   template <>                                                        \
   inline return_type MozJemalloc::moz_arena_##name(                  \
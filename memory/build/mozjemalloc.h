@@ -65,6 +65,10 @@ struct DummyArenaAllocator {
 
   static void moz_dispose_arena(arena_id_t) {}
 
+  static bool moz_arena_stats(arena_id_t, jemalloc_arena_stats_t*) {
+    return false;
+  }
+
 #define MALLOC_DECL(name, return_type, ...)                 \
   static return_type moz_arena_##name(                      \
       arena_id_t, ARGS_HELPER(TYPED_ARGS, ##__VA_ARGS__)) { \
@@ -64,9 +64,13 @@ typedef size_t arena_id_t;
 typedef struct arena_params_s {
   size_t mMaxDirty;
   uint32_t mFlags;
+  // Optional subsystem label for the arena, reported back through
+  // moz_arena_stats(). Must point to a string literal (the allocator keeps
+  // the pointer, not a copy).
+  const char* mLabel;
 
 #ifdef __cplusplus
-  arena_params_s() : mMaxDirty(0), mFlags(0) {}
+  arena_params_s() : mMaxDirty(0), mFlags(0), mLabel(NULL) {}
 #endif
 } arena_params_t;
 
@@ -99,6 +103,17 @@ typedef struct {
   size_t bin_unused;   // Bytes committed to a bin but currently unused.
 } jemalloc_stats_t;
 
+// Usage information for a single moz_arena_* arena, filled in by
+// moz_arena_stats(). Unlike jemalloc_stats(), gathering these only takes the
+// one arena's lock, so the numbers are cheap enough to poll continuously.
+typedef struct {
+  const char* label;  // Label given at creation time, or NULL.
+  size_t mapped;      // Bytes mapped by this arena.
+  size_t committed;   // Bytes committed by this arena.
+  size_t allocated;   // Bytes in use by the application.
+  size_t dirty;       // Committed, unused pages kept as cache.
+} jemalloc_arena_stats_t;
+
 typedef struct {
   size_t size;               // The size of objects in this bin, zero if this
                              // bin stats array entry is unused (no more bins).
@@ -563,6 +563,13 @@ inline already_AddRefed<T> do_AddRef(const RefPtr<T>& aObj) {
   return ref.forget();
 }
 
+// An expiring RefPtr already owns a reference we can steal, so no refcount
+// traffic is needed at all.
+template <class T>
+inline already_AddRefed<T> do_AddRef(RefPtr<T>&& aObj) {
+  return aObj.forget();
+}
+
 namespace mozilla {
 
 template <typename T>
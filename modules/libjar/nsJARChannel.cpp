@@ -22,6 +22,7 @@
 #include "mozilla/Preferences.h"
 #include "mozilla/Telemetry.h"
 #include "mozilla/TelemetryComms.h"
+#include "mozilla/URLPreloader.h"
 #include "private/pprio.h"
 #include "nsInputStreamPump.h"
 #include "nsThreadUtils.h"
@@ -843,6 +844,10 @@ nsJARChannel::Open(nsIInputStream** aStream) {
     return NS_ERROR_NOT_IMPLEMENTED;
   }
 
+  // Record synchronous Omnijar reads so the URLPreloader can warm them
+  // before they're needed during the next session's startup.
+  URLPreloader::NoteJarRead(mJarFile, mJarEntry);
+
   RefPtr<nsJARInputThunk> input;
   rv = CreateJarInput(gJarHandler->JarCache(), getter_AddRefs(input));
   if (NS_FAILED(rv)) return rv;
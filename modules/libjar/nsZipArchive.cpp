@@ -479,9 +479,10 @@ nsZipItem* nsZipArchive::GetItem(const char* aEntryName) {
       }
     }
     MMAP_FAULT_HANDLER_BEGIN_HANDLE(mFd)
-    nsZipItem* item = mFiles[HashName(aEntryName, len)];
+    uint32_t hash = HashName(aEntryName, len);
+    nsZipItem* item = mFiles[hash % ZIP_TABSIZE];
     while (item) {
-      if ((len == item->nameLength) &&
+      if ((hash == item->hash) && (len == item->nameLength) &&
           (!memcmp(aEntryName, item->Name(), len))) {
         // Successful GetItem() is a good indicator that the file is about to be
         // read
@@ -723,9 +724,10 @@ nsresult nsZipArchive::BuildFileList(PRFileDesc* aFd) {
     item->isSynthetic = false;
 
     // Add item to file table
-    uint32_t hash = HashName(item->Name(), namelen);
-    item->next = mFiles[hash];
-    mFiles[hash] = item;
+    item->hash = HashName(item->Name(), namelen);
+    uint32_t bucket = item->hash % ZIP_TABSIZE;
+    item->next = mFiles[bucket];
+    mFiles[bucket] = item;
 
     sig = 0;
   } /* while reading central directory records */
@@ -783,9 +785,10 @@ nsresult nsZipArchive::BuildSynthetics() {
 
         // Is the directory already in the file table?
         uint32_t hash = HashName(item->Name(), dirlen);
+        uint32_t bucket = hash % ZIP_TABSIZE;
         bool found = false;
-        for (nsZipItem* zi = mFiles[hash]; zi != nullptr; zi = zi->next) {
-          if ((dirlen == zi->nameLength) &&
+        for (nsZipItem* zi = mFiles[bucket]; zi != nullptr; zi = zi->next) {
+          if ((hash == zi->hash) && (dirlen == zi->nameLength) &&
               (0 == memcmp(item->Name(), zi->Name(), dirlen))) {
             // we've already added this dir and all its parents
             found = true;
@@ -802,12 +805,13 @@ nsresult nsZipArchive::BuildSynthetics() {
 
         // Point to the central record of the original item for the name part.
         diritem->central = item->central;
+        diritem->hash = hash;
         diritem->nameLength = dirlen;
         diritem->isSynthetic = true;
 
         // add diritem to the file table
-        diritem->next = mFiles[hash];
-        mFiles[hash] = diritem;
+        diritem->next = mFiles[bucket];
+        mFiles[bucket] = diritem;
       } /* end processing of dirs in item's name */
     }
   }
@@ -933,7 +937,9 @@ nsZipFind::~nsZipFind() {
 /*
  * HashName
  *
- * returns a hash key for the entry name
+ * returns the full hash of the entry name. Callers reduce it modulo
+ * ZIP_TABSIZE to pick a bucket, and compare the full value to skip most name
+ * comparisons when walking a hash chain.
  */
 MOZ_NO_SANITIZE_UNSIGNED_OVERFLOW
 static uint32_t HashName(const char* aName, uint16_t len) {
@@ -946,7 +952,7 @@ static uint32_t HashName(const char* aName, uint16_t len) {
     val = val * 37 + *p++;
   }
 
-  return (val % ZIP_TABSIZE);
+  return val;
 }
 
 /*
@@ -1002,7 +1008,11 @@ static PRTime GetModTime(uint16_t aDate, uint16_t aTime) {
 }
 
 nsZipItem::nsZipItem()
-    : next(nullptr), central(nullptr), nameLength(0), isSynthetic(false) {}
+    : next(nullptr),
+      central(nullptr),
+      hash(0),
+      nameLength(0),
+      isSynthetic(false) {}
 
 uint32_t nsZipItem::LocalOffset() { return xtolong(central->localhdr_offset); }
 
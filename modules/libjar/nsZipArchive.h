@@ -8,7 +8,9 @@
 
 #include "mozilla/Attributes.h"
 
-#define ZIP_TABSIZE 256
+/* Number of buckets in the file table. omni.ja carries tens of thousands of
+ * entries, so a small table makes every lookup walk a long hash chain. */
+#define ZIP_TABSIZE 2048
 #define ZIP_BUFLEN \
   (4 * 1024) /* Used as output buffer when deflating items to a file */
 
@@ -68,6 +70,9 @@ class nsZipItem final {
 
   nsZipItem* next;
   const ZipCentral* central;
+  // Full (unreduced) hash of the entry name, used to skip most name
+  // comparisons when walking a hash chain.
+  uint32_t hash;
   uint16_t nameLength;
   bool isSynthetic;
 };
@@ -1126,6 +1126,21 @@ class CallbackNode {
     return mDomain.is<nsCString>() && mDomain.as<nsCString>() == aDomain;
   }
 
+  // True if every pref name this node can match shares the first
+  // dot-separated segment of its domain, which lets NotifyCallbacks() reach
+  // the node through a per-segment bucket instead of a full list walk. A
+  // single exact domain always qualifies, and a single prefix domain
+  // qualifies when it extends past its first dot. (The dotless prefix "br"
+  // would have to match both "br.x" and "browser.x".) Multi-domain nodes
+  // are never considered bucketable.
+  bool HasBucketableDomain() const {
+    if (!mDomain.is<nsCString>()) {
+      return false;
+    }
+    return MatchKind() == Preferences::ExactMatch ||
+           mDomain.as<nsCString>().FindChar('.') != kNotFound;
+  }
+
   bool DomainIs(const char** aPrefs) const {
     return mDomain == AsVariant(aPrefs);
   }
@@ -1152,6 +1167,13 @@ class CallbackNode {
     return reinterpret_cast<CallbackNode*>(mNextAndMatchKind & kNextMask);
   }
 
+  // Link for the dispatch index. Non-priority nodes that share a first
+  // pref-name segment are chained together so NotifyCallbacks() can visit
+  // only the nodes that could possibly match a changed pref. See
+  // pref_AddToDispatchIndex().
+  CallbackNode* DispatchNext() const { return mDispatchNext; }
+  void SetDispatchNext(CallbackNode* aNext) { mDispatchNext = aNext; }
+
   void SetNext(CallbackNode* aNext) {
     uintptr_t matchKind = mNextAndMatchKind & kMatchKindMask;
     mNextAndMatchKind = reinterpret_cast<uintptr_t>(aNext);
@@ -1173,6 +1195,8 @@ class CallbackNode {
 
   Variant<nsCString, const char**> mDomain;
 
+  CallbackNode* mDispatchNext = nullptr;
+
   // If someone attempts to remove the node from the callback list while
   // NotifyCallbacks() is running, |func| is set to nullptr. Such nodes will
   // be removed at the end of NotifyCallbacks().
@@ -1216,6 +1240,26 @@ static AntiFootgunMap* gOnceStaticPrefsAntiFootgun;
 static CallbackNode* gFirstCallback = nullptr;
 static CallbackNode* gLastPriorityNode = nullptr;
 
+// The dispatch index. Non-priority callbacks whose matches all fall under a
+// single first pref-name segment (e.g. "browser" or "dom") are chained, via
+// CallbackNode::DispatchNext(), into a bucket keyed by that segment; the
+// remaining non-priority callbacks live on gUnbucketedCallbacks. This lets
+// NotifyCallbacks() skip the (typically large) majority of callbacks that
+// cannot match a changed pref. Priority callbacks are not indexed;
+// NotifyCallbacks() walks the priority part of the list directly, so they
+// keep running before all other callbacks. The list above remains the owner
+// of the nodes and of their registration order.
+static nsDataHashtable<nsCStringHashKey, CallbackNode*>* gCallbackBuckets;
+static CallbackNode* gUnbucketedCallbacks = nullptr;
+
+// Returns the first dot-separated segment of aPrefName, or all of it if it
+// contains no dot.
+static nsDependentCSubstring FirstPrefSegment(const nsACString& aPrefName) {
+  int32_t dot = aPrefName.FindChar('.');
+  return nsDependentCSubstring(
+      aPrefName, 0, dot == kNotFound ? aPrefName.Length() : uint32_t(dot));
+}
+
 #ifdef DEBUG
 #  define ACCESS_COUNTS
 #endif
@@ -1642,6 +1686,53 @@ static nsresult pref_SetPref(const nsCString& aPrefName, PrefType aType,
   return NS_OK;
 }
 
+// Adds a newly registered non-priority |aNode| to the dispatch index.
+static void pref_AddToDispatchIndex(CallbackNode* aNode) {
+  if (!aNode->HasBucketableDomain()) {
+    aNode->SetDispatchNext(gUnbucketedCallbacks);
+    gUnbucketedCallbacks = aNode;
+    return;
+  }
+
+  if (!gCallbackBuckets) {
+    gCallbackBuckets = new nsDataHashtable<nsCStringHashKey, CallbackNode*>();
+  }
+  CallbackNode*& head = gCallbackBuckets->GetOrInsert(
+      FirstPrefSegment(aNode->Domain().as<nsCString>()));
+  aNode->SetDispatchNext(head);
+  head = aNode;
+}
+
+// Removes |aNode| from the dispatch index. Priority nodes were never added,
+// so it is not an error for a node to be absent from its chain.
+static void pref_RemoveFromDispatchIndex(CallbackNode* aNode) {
+  CallbackNode** head = &gUnbucketedCallbacks;
+  if (aNode->HasBucketableDomain()) {
+    if (!gCallbackBuckets) {
+      return;
+    }
+    head = gCallbackBuckets->GetValue(
+        FirstPrefSegment(aNode->Domain().as<nsCString>()));
+    if (!head) {
+      return;
+    }
+  }
+
+  CallbackNode* prev = nullptr;
+  for (CallbackNode* node = *head; node;
+       prev = node, node = node->DispatchNext()) {
+    if (node == aNode) {
+      if (prev) {
+        prev->SetDispatchNext(aNode->DispatchNext());
+      } else {
+        *head = aNode->DispatchNext();
+      }
+      aNode->SetDispatchNext(nullptr);
+      return;
+    }
+  }
+}
+
 // Removes |node| from callback list. Returns the node after the deleted one.
 static CallbackNode* pref_RemoveCallbackNode(CallbackNode* aNode,
                                              CallbackNode* aPrevNode) {
@@ -1649,6 +1740,8 @@ static CallbackNode* pref_RemoveCallbackNode(CallbackNode* aNode,
   MOZ_ASSERT(aPrevNode || gFirstCallback == aNode);
   MOZ_ASSERT(!gCallbacksInProgress);
 
+  pref_RemoveFromDispatchIndex(aNode);
+
   CallbackNode* next_node = aNode->Next();
   if (aPrevNode) {
     aPrevNode->SetNext(next_node);
@@ -1675,9 +1768,38 @@ static void NotifyCallbacks(const nsCString& aPrefName,
   // if we haven't reentered.
   gCallbacksInProgress = true;
 
-  for (CallbackNode* node = gFirstCallback; node; node = node->Next()) {
-    if (node->Func()) {
-      if (node->Matches(aPrefName)) {
+  // Priority callbacks sit at the front of the list; walk that part directly
+  // so they keep running before everything else.
+  if (gLastPriorityNode) {
+    for (CallbackNode* node = gFirstCallback;; node = node->Next()) {
+      if (node->Func() && node->Matches(aPrefName)) {
+        (node->Func())(aPrefName.get(), node->Data());
+      }
+      if (node == gLastPriorityNode) {
+        break;
+      }
+    }
+  }
+
+  // Non-priority callbacks are reached through the dispatch index: the
+  // chain of callbacks that couldn't be bucketed, plus the bucket for the
+  // changed pref's first segment.
+  for (CallbackNode* node = gUnbucketedCallbacks; node;
+       node = node->DispatchNext()) {
+    if (node->Func() && node->Matches(aPrefName)) {
+      (node->Func())(aPrefName.get(), node->Data());
+    }
+  }
+
+  if (gCallbackBuckets) {
+    CallbackNode** head =
+        gCallbackBuckets->GetValue(FirstPrefSegment(aPrefName));
+    // Take a copy of the chain head before invoking anything: a callback may
+    // register a new callback, and adding a new bucket can move the table's
+    // slots.
+    for (CallbackNode* node = head ? *head : nullptr; node;
+         node = node->DispatchNext()) {
+      if (node->Func() && node->Matches(aPrefName)) {
         (node->Func())(aPrefName.get(), node->Data());
       }
     }
@@ -3501,6 +3623,10 @@ Preferences::~Preferences() {
   }
   gLastPriorityNode = gFirstCallback = nullptr;
 
+  delete gCallbackBuckets;
+  gCallbackBuckets = nullptr;
+  gUnbucketedCallbacks = nullptr;
+
   delete HashTable();
   HashTable() = nullptr;
 
@@ -5049,6 +5175,7 @@ nsresult Preferences::RegisterCallbackImpl(PrefChangedFunc aCallback,
       node->SetNext(gFirstCallback);
       gFirstCallback = node;
     }
+    pref_AddToDispatchIndex(node);
   }
 
   return NS_OK;
@@ -219,6 +219,21 @@ bool mozilla::PrintfTarget::appendIntHex(uint64_t num) {
   return cvt_ll(num, -1, -1, 16, TYPE_UINTN, 0, hex);
 }
 
+// Two-digit lookup used by the decimal conversions below; emitting digit
+// pairs halves the number of divides, and the divisor being a constant lets
+// the compiler turn them into multiplies.
+static const char digitPairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
 /* Convert a long into its printable form. */
 bool mozilla::PrintfTarget::cvt_l(long num, int width, int prec, int radix,
                                   int type, int flags, const char* hexp) {
@@ -233,6 +248,27 @@ bool mozilla::PrintfTarget::cvt_l(long num, int width, int prec, int radix,
   // need to stop when we hit 10 digits. In the signed case, we can
   // stop when the number is zero.
   cvt = cvtbuf + sizeof(cvtbuf);
+  if (radix == 10) {
+    // Decimal is by far the common case; convert a digit pair per divide.
+    unsigned long n = (unsigned long)num;
+    while (n >= 100) {
+      unsigned long rem = n % 100;
+      n /= 100;
+      cvt -= 2;
+      cvt[0] = digitPairs[rem * 2];
+      cvt[1] = digitPairs[rem * 2 + 1];
+    }
+    if (n >= 10) {
+      cvt -= 2;
+      cvt[0] = digitPairs[n * 2];
+      cvt[1] = digitPairs[n * 2 + 1];
+    } else {
+      *--cvt = '0' + (char)n;
+    }
+    digits = int(cvtbuf + sizeof(cvtbuf) - cvt);
+    return fill_n(cvt, digits, width, prec, type, flags);
+  }
+
   digits = 0;
   while (num) {
     int digit = (((unsigned long)num) % radix) & 0xF;
@@ -259,10 +295,31 @@ bool mozilla::PrintfTarget::cvt_ll(int64_t num, int width, int prec, int radix,
   // Converting decimal is a little tricky. In the unsigned case we
   // need to stop when we hit 10 digits. In the signed case, we can
   // stop when the number is zero.
-  int64_t rad = int64_t(radix);
   char cvtbuf[100];
   char* cvt = cvtbuf + sizeof(cvtbuf);
   int digits = 0;
+  if (radix == 10) {
+    // Decimal is by far the common case; convert a digit pair per divide.
+    uint64_t n = uint64_t(num);
+    while (n >= 100) {
+      uint64_t rem = n % 100;
+      n /= 100;
+      cvt -= 2;
+      cvt[0] = digitPairs[rem * 2];
+      cvt[1] = digitPairs[rem * 2 + 1];
+    }
+    if (n >= 10) {
+      cvt -= 2;
+      cvt[0] = digitPairs[n * 2];
+      cvt[1] = digitPairs[n * 2 + 1];
+    } else {
+      *--cvt = '0' + (char)n;
+    }
+    digits = int(cvtbuf + sizeof(cvtbuf) - cvt);
+    return fill_n(cvt, digits, width, prec, type, flags);
+  }
+
+  int64_t rad = int64_t(radix);
   while (num != 0) {
     int64_t quot = uint64_t(num) / rad;
     int64_t rem = uint64_t(num) % rad;
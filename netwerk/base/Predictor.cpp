@@ -21,6 +21,7 @@
 #include "nsILoadContext.h"
 #include "nsILoadContextInfo.h"
 #include "nsILoadGroup.h"
+#include "nsILocalStorageManager.h"
 #include "nsINetworkPredictorVerifier.h"
 #include "nsIObserverService.h"
 #include "nsISpeculativeConnect.h"
@@ -48,6 +49,8 @@
 #include "mozilla/net/NeckoChild.h"
 
 #include "mozilla/dom/ContentParent.h"
+#include "mozilla/dom/LocalStorageCommon.h"
+#include "mozilla/dom/Promise.h"
 #include "mozilla/ClearOnShutdown.h"
 
 #include "CacheControlParser.h"
@@ -560,6 +563,13 @@ Predictor::PredictNative(nsIURI* targetURI, nsIURI* sourceURI,
         PREDICTOR_LOG(("    load invalid URI state"));
         return NS_ERROR_INVALID_ARG;
       }
+      {
+        // A top-level load of targetURI is starting; warm its LocalStorage
+        // datastore while the network request is in flight.
+        nsCOMPtr<nsIPrincipal> principal =
+            BasePrincipal::CreateContentPrincipal(targetURI, originAttributes);
+        MaybePreloadLocalStorage(principal);
+      }
       break;
     case nsINetworkPredictor::PREDICT_STARTUP:
       if (targetURI || sourceURI) {
@@ -690,12 +700,46 @@ void Predictor::PredictForLink(nsIURI* targetURI, nsIURI* sourceURI,
       BasePrincipal::CreateContentPrincipal(targetURI, originAttributes);
 
   mSpeculativeService->SpeculativeConnect(targetURI, principal, nullptr);
+  MaybePreloadLocalStorage(principal);
   if (verifier) {
     PREDICTOR_LOG(("    sending verification"));
     verifier->OnPredictPreconnect(targetURI);
   }
 }
 
+void Predictor::MaybePreloadLocalStorage(nsIPrincipal* principal) {
+  MOZ_ASSERT(NS_IsMainThread());
+
+  if (!StaticPrefs::network_predictor_preload_local_storage()) {
+    return;
+  }
+
+  if (!dom::NextGenLocalStorageEnabled()) {
+    return;
+  }
+
+  if (!principal || !principal->GetIsContentPrincipal()) {
+    return;
+  }
+
+  PREDICTOR_LOG(("Predictor::MaybePreloadLocalStorage"));
+
+  // Warming the datastore now means the SQLite reads are done (or at least
+  // underway) before the page's first LocalStorage access, so the initial
+  // snapshot can be filled from memory. Re-requesting an origin that is
+  // already loaded is cheap, so like speculative connects we don't dedupe.
+  nsCOMPtr<nsILocalStorageManager> lsm =
+      do_GetService("@mozilla.org/dom/localStorage-manager;1");
+  if (NS_WARN_IF(!lsm)) {
+    return;
+  }
+
+  RefPtr<dom::Promise> unused;
+  if (NS_FAILED(lsm->Preload(principal, nullptr, getter_AddRefs(unused)))) {
+    PREDICTOR_LOG(("    preload failed to start"));
+  }
+}
+
 // This is the driver for prediction based on a new pageload.
 static const uint8_t MAX_PAGELOAD_DEPTH = 10;
 bool Predictor::PredictForPageload(nsICacheEntry* entry, nsIURI* targetURI,
@@ -729,7 +773,7 @@ bool Predictor::PredictForPageload(nsICacheEntry* entry, nsIURI* targetURI,
   nsCOMPtr<nsIURI> redirectURI;
   if (WouldRedirect(entry, loadCount, lastLoad, globalDegradation,
                     getter_AddRefs(redirectURI))) {
-    mPreconnects.AppendElement(redirectURI);
+    mPreconnects.AppendElement(Prediction{redirectURI, 100});
     Predictor::Reason reason;
     reason.mPredict = nsINetworkPredictor::PREDICT_LOAD;
     RefPtr<Predictor::Action> redirectAction = new Predictor::Action(
@@ -1045,21 +1089,24 @@ void Predictor::SetupPrediction(int32_t confidence, uint32_t flags,
     nsCOMPtr<nsIURI> prefetchURI;
     rv = NS_NewURI(getter_AddRefs(prefetchURI), uri);
     if (NS_SUCCEEDED(rv)) {
-      mPrefetches.AppendElement(prefetchURI);
+      mPrefetches.AppendElement(
+          Prediction{std::move(prefetchURI), confidence});
     }
   } else if (confidence >=
              StaticPrefs::network_predictor_preconnect_min_confidence()) {
     nsCOMPtr<nsIURI> preconnectURI;
     rv = NS_NewURI(getter_AddRefs(preconnectURI), uri);
     if (NS_SUCCEEDED(rv)) {
-      mPreconnects.AppendElement(preconnectURI);
+      mPreconnects.AppendElement(
+          Prediction{std::move(preconnectURI), confidence});
     }
   } else if (confidence >=
              StaticPrefs::network_predictor_preresolve_min_confidence()) {
     nsCOMPtr<nsIURI> preresolveURI;
     rv = NS_NewURI(getter_AddRefs(preresolveURI), uri);
     if (NS_SUCCEEDED(rv)) {
-      mPreresolves.AppendElement(preresolveURI);
+      mPreresolves.AppendElement(
+          Prediction{std::move(preresolveURI), confidence});
     }
   }
 
@@ -1129,6 +1176,36 @@ nsresult Predictor::Prefetch(nsIURI* uri, nsIURI* referrer,
 }
 
 // Runs predictions that have been set up.
+namespace {
+
+// A no-op open callback used to warm up cache entries of predicted
+// subresources. Just opening the entry makes the cache read its metadata and
+// preload the first chunks (see CacheFile::OnMetadataRead), so a channel
+// opened later finds them in memory instead of waiting for the disk.
+class CacheWarmCallback final : public nsICacheEntryOpenCallback {
+  ~CacheWarmCallback() = default;
+
+ public:
+  NS_DECL_THREADSAFE_ISUPPORTS
+
+  NS_IMETHOD OnCacheEntryCheck(nsICacheEntry* entry,
+                               nsIApplicationCache* appCache,
+                               uint32_t* result) override {
+    *result = nsICacheEntryOpenCallback::ENTRY_WANTED;
+    return NS_OK;
+  }
+
+  NS_IMETHOD OnCacheEntryAvailable(nsICacheEntry* entry, bool isNew,
+                                   nsIApplicationCache* appCache,
+                                   nsresult result) override {
+    return NS_OK;
+  }
+};
+
+NS_IMPL_ISUPPORTS(CacheWarmCallback, nsICacheEntryOpenCallback)
+
+}  // namespace
+
 bool Predictor::RunPredictions(nsIURI* referrer,
                                const OriginAttributes& originAttributes,
                                nsINetworkPredictorVerifier* verifier) {
@@ -1139,9 +1216,25 @@ bool Predictor::RunPredictions(nsIURI* referrer,
   bool predicted = false;
   uint32_t len, i;
 
-  nsTArray<nsCOMPtr<nsIURI>> prefetches = std::move(mPrefetches),
-                             preconnects = std::move(mPreconnects),
-                             preresolves = std::move(mPreresolves);
+  nsTArray<Prediction> prefetches = std::move(mPrefetches),
+                       preconnects = std::move(mPreconnects),
+                       preresolves = std::move(mPreresolves);
+
+  // Issue each batch in descending confidence order, so that when the
+  // speculative connection and DNS queues fill up the slots have gone to the
+  // resources most likely to actually be loaded.
+  class ConfidenceComparator {
+   public:
+    bool Equals(const Prediction& a, const Prediction& b) const {
+      return a.confidence == b.confidence;
+    }
+    bool LessThan(const Prediction& a, const Prediction& b) const {
+      return a.confidence > b.confidence;
+    }
+  };
+  prefetches.Sort(ConfidenceComparator());
+  preconnects.Sort(ConfidenceComparator());
+  preresolves.Sort(ConfidenceComparator());
 
   Telemetry::AutoCounter<Telemetry::PREDICTOR_TOTAL_PREDICTIONS>
       totalPredictions;
@@ -1154,7 +1247,7 @@ bool Predictor::RunPredictions(nsIURI* referrer,
   len = prefetches.Length();
   for (i = 0; i < len; ++i) {
     PREDICTOR_LOG(("    doing prefetch"));
-    nsCOMPtr<nsIURI> uri = prefetches[i];
+    nsCOMPtr<nsIURI> uri = prefetches[i].uri;
     if (NS_SUCCEEDED(Prefetch(uri, referrer, originAttributes, verifier))) {
       ++totalPredictions;
       ++totalPrefetches;
@@ -1162,15 +1255,36 @@ bool Predictor::RunPredictions(nsIURI* referrer,
     }
   }
 
+  // Preconnect-confidence subresources are likely to be requested while the
+  // page is still being parsed. Those of them that are cached won't use the
+  // preconnected socket at all but will read from the disk, so warm up their
+  // cache entries as a batch to hide the cache seek latency behind the parse.
+  nsCOMPtr<nsICacheStorage> cacheDiskStorage;
+  if (!preconnects.IsEmpty()) {
+    RefPtr<LoadContextInfo> lci = new LoadContextInfo(false, originAttributes);
+    if (NS_FAILED(mCacheStorageService->DiskCacheStorage(
+            lci, false, getter_AddRefs(cacheDiskStorage)))) {
+      cacheDiskStorage = nullptr;
+    }
+  }
+
   len = preconnects.Length();
   for (i = 0; i < len; ++i) {
     PREDICTOR_LOG(("    doing preconnect"));
-    nsCOMPtr<nsIURI> uri = preconnects[i];
+    nsCOMPtr<nsIURI> uri = preconnects[i].uri;
     ++totalPredictions;
     ++totalPreconnects;
     nsCOMPtr<nsIPrincipal> principal =
         BasePrincipal::CreateContentPrincipal(uri, originAttributes);
     mSpeculativeService->SpeculativeConnect(uri, principal, this);
+    if (cacheDiskStorage) {
+      PREDICTOR_LOG(("    warming cache entry"));
+      uint32_t openFlags = nsICacheStorage::OPEN_READONLY |
+                           nsICacheStorage::OPEN_SECRETLY |
+                           nsICacheStorage::CHECK_MULTITHREADED;
+      RefPtr<CacheWarmCallback> callback = new CacheWarmCallback();
+      cacheDiskStorage->AsyncOpenURI(uri, ""_ns, openFlags, callback);
+    }
     predicted = true;
     if (verifier) {
       PREDICTOR_LOG(("    sending preconnect verification"));
@@ -1180,7 +1294,7 @@ bool Predictor::RunPredictions(nsIURI* referrer,
 
   len = preresolves.Length();
   for (i = 0; i < len; ++i) {
-    nsCOMPtr<nsIURI> uri = preresolves[i];
+    nsCOMPtr<nsIURI> uri = preresolves[i].uri;
     ++totalPredictions;
     ++totalPreresolves;
     nsAutoCString hostname;
@@ -29,6 +29,7 @@ class nsICacheStorage;
 class nsIDNSService;
 class nsIIOService;
 class nsILoadContextInfo;
+class nsIPrincipal;
 class nsITimer;
 
 namespace mozilla {
@@ -252,6 +253,12 @@ class Predictor final : public nsINetworkPredictor,
                       const OriginAttributes& originAttributes,
                       nsINetworkPredictorVerifier* verifier);
 
+  // Used when we anticipate a top-level navigation to an origin (link hover
+  // or a page load that is starting), to warm up the origin's LocalStorage
+  // datastore so the page's first storage access doesn't wait on disk.
+  //   * principal - the content principal of the predicted navigation target
+  void MaybePreloadLocalStorage(nsIPrincipal* principal);
+
   // Used when predicting because a page is being loaded (which may include
   // being the target of a redirect). All arguments are the same as for
   // PredictInternal. Returns true if any predictions were queued up.
@@ -445,9 +452,18 @@ class Predictor final : public nsINetworkPredictor,
 
   RefPtr<DNSListener> mDNSListener;
 
-  nsTArray<nsCOMPtr<nsIURI>> mPrefetches;
-  nsTArray<nsCOMPtr<nsIURI>> mPreconnects;
-  nsTArray<nsCOMPtr<nsIURI>> mPreresolves;
+  // A queued predictive action together with the confidence that produced
+  // it. The queues are issued in descending confidence order by
+  // RunPredictions, so the most likely resources get the speculative
+  // connection and DNS slots first.
+  struct Prediction {
+    nsCOMPtr<nsIURI> uri;
+    int32_t confidence;
+  };
+
+  nsTArray<Prediction> mPrefetches;
+  nsTArray<Prediction> mPreconnects;
+  nsTArray<Prediction> mPreresolves;
 
   static Predictor* sSelf;
 };
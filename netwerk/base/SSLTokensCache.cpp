@@ -8,6 +8,7 @@
 #include "mozilla/Logging.h"
 #include "nsIOService.h"
 #include "nsNSSIOLayer.h"
+#include "prtime.h"
 #include "TransportSecurityInfo.h"
 #include "ssl.h"
 #include "sslexp.h"
@@ -264,6 +265,14 @@ nsresult SSLTokensCache::Get(const nsACString& aKey,
   TokenCacheRecord* rec = nullptr;
 
   if (gInstance->mTokenCacheRecords.Get(aKey, &rec)) {
+    // A ticket that is past its lifetime can only produce a failed resumption
+    // attempt, so drop the record and make room for live tokens.
+    if (rec->mExpirationTime <=
+        static_cast<PRUint32>(PR_Now() / PR_USEC_PER_SEC)) {
+      LOG(("  token expired"));
+      gInstance->RemoveLocked(aKey);
+      return NS_ERROR_NOT_AVAILABLE;
+    }
     if (rec->mToken.Length()) {
       aToken = rec->mToken.Clone();
       return NS_OK;
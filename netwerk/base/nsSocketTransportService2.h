@@ -247,11 +247,14 @@ class nsSocketTransportService final : public nsPISocketTransportService,
 
   PRPollDesc* mPollList; /* mListSize + 1 entries */
 
-  PRIntervalTime PollTimeout(
-      PRIntervalTime now);  // computes ideal poll timeout
   nsresult DoPollIteration(TimeDuration* pollDuration);
   // perfoms a single poll iteration
-  int32_t Poll(TimeDuration* pollDuration, PRIntervalTime now);
+  int32_t Poll(TimeDuration* pollDuration, PRIntervalTime now,
+               PRIntervalTime socketTimeout);
+  // socketTimeout is the minimum time
+  // before any socket timeout expires,
+  // computed by DoPollIteration while
+  // updating the poll list.
   // calls PR_Poll.  the out param
   // interval indicates the poll
   // duration in seconds.
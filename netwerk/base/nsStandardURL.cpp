@@ -14,7 +14,11 @@
 #include "nsIObjectInputStream.h"
 #include "nsIObjectOutputStream.h"
 #include "nsIIDNService.h"
+#include "mozilla/ClearOnShutdown.h"
+#include "mozilla/HashFunctions.h"
 #include "mozilla/Logging.h"
+#include "mozilla/MruCache.h"
+#include "mozilla/StaticPtr.h"
 #include "nsIURLParser.h"
 #include "nsNetCID.h"
 #include "mozilla/MemoryReporting.h"
@@ -59,6 +63,24 @@ StaticRefPtr<nsIIDNService> nsStandardURL::gIDN;
 // case we will just dispatch a noop runnable to the main thread.
 bool nsStandardURL::gInitialized = false;
 
+// Interning pool for normalized specs. A page typically references the same
+// subresource URL from many channels, LoadInfos and principals, and each of
+// those parses produces an identical spec; sharing the string buffer of the
+// last parse keeps one heap copy per distinct URL instead of one per
+// consumer. Main-thread only so no locking is needed (same pattern as the
+// display-IDN cache in nsIDNService).
+struct SpecInternCache
+    : public MruCache<nsCString, nsCString, SpecInternCache, 127> {
+  static HashNumber Hash(const KeyType& aKey) {
+    return HashString(aKey.get(), aKey.Length());
+  }
+  static bool Match(const KeyType& aKey, const ValueType& aVal) {
+    return aKey.Equals(aVal);
+  }
+};
+
+static StaticAutoPtr<SpecInternCache> gSpecInternCache;
+
 const char nsStandardURL::gHostLimitDigits[] = {'/', '\\', '?', '#', 0};
 
 // Invalid host characters
@@ -991,6 +1013,22 @@ nsresult nsStandardURL::BuildNormalizedSpec(const char* spec,
   MOZ_ASSERT(mSpec.Length() <= StaticPrefs::network_standard_url_max_length(),
              "The spec should never be this long, we missed a check.");
 
+  // Share the spec buffer with the last identical parse, if any. Segment
+  // offsets stay valid since the interned copy is byte-for-byte identical,
+  // and later mutation is safe because nsCString unshares on write.
+  if (NS_IsMainThread()) {
+    if (!gSpecInternCache) {
+      gSpecInternCache = new SpecInternCache();
+      ClearOnShutdown(&gSpecInternCache);
+    }
+    auto cached = gSpecInternCache->Lookup(mSpec);
+    if (cached) {
+      mSpec = cached.Data();
+    } else {
+      cached.Set(mSpec);
+    }
+  }
+
   MOZ_ASSERT(mUsername.mLen != 0 && mPassword.mLen != 0);
   return NS_OK;
 }
@@ -25,6 +25,7 @@
 #include "mozilla/Tokenizer.h"
 #include "nsEscape.h"
 #include "nsDOMString.h"
+#include "nsReadableUtils.h"
 #include "mozilla/net/rust_helper.h"
 
 using namespace mozilla;
@@ -368,6 +369,27 @@ nsresult net_ExtractURLScheme(const nsACString& inURI, nsACString& scheme) {
     start++;
   }
 
+  // Fast path: almost every spec we see is "alpha *schemechar ':'" with no
+  // embedded \r\n\t, so scan for the colon directly and skip the Tokenizer
+  // plus the claim-and-strip copy below.
+  if (start != end && IsAsciiAlpha(*start)) {
+    nsACString::const_iterator colon = start;
+    ++colon;
+    while (colon != end && net_IsValidSchemeChar(*colon)) {
+      ++colon;
+    }
+    if (colon != end && *colon == ':') {
+      scheme = Substring(start, colon);
+      ToLowerCase(scheme);
+      return NS_OK;
+    }
+    if (colon == end ||
+        (*colon != '\r' && *colon != '\n' && *colon != '\t')) {
+      return NS_ERROR_MALFORMED_URI;
+    }
+    // Whitespace inside the scheme: take the stripping slow path.
+  }
+
   Tokenizer p(Substring(start, end), "\r\n\t");
   p.Record();
   if (!p.CheckChar(IsAsciiAlpha)) {
@@ -863,23 +885,42 @@ void net_ParseRequestContentType(const nsACString& aHeaderStr,
   *aHadCharset = hadCharset;
 }
 
+// Whitelist of characters we are willing to send to lower-level DNS logic:
+// DNS names (RFC 1035) with extra characters added for pragmatic reasons
+// "$+_"; see https://bugzilla.mozilla.org/show_bug.cgi?id=355181#c2.
+// A table lookup per character beats scanning the whole set per character.
+static const char kValidHostChars[128] = {
+    0, 0, 0, 0, 0, 0, 0, 0,  //   0
+    0, 0, 0, 0, 0, 0, 0, 0,  //   8
+    0, 0, 0, 0, 0, 0, 0, 0,  //  16
+    0, 0, 0, 0, 0, 0, 0, 0,  //  24
+
+    0, 0, 0, 0, 1, 0, 0, 0,  //  32  $
+    0, 0, 0, 1, 0, 1, 1, 0,  //  40  + - .
+    1, 1, 1, 1, 1, 1, 1, 1,  //  48  0 - 7
+    1, 1, 0, 0, 0, 0, 0, 0,  //  56  8 9
+
+    0, 1, 1, 1, 1, 1, 1, 1,  //  64  A - G
+    1, 1, 1, 1, 1, 1, 1, 1,  //  72  H - O
+    1, 1, 1, 1, 1, 1, 1, 1,  //  80  P - W
+    1, 1, 1, 0, 0, 0, 0, 1,  //  88  X Y Z _
+
+    0, 1, 1, 1, 1, 1, 1, 1,  //  96  a - g
+    1, 1, 1, 1, 1, 1, 1, 1,  // 104  h - o
+    1, 1, 1, 1, 1, 1, 1, 1,  // 112  p - w
+    1, 1, 1, 0, 0, 0, 0, 0   // 120  x y z
+};
+
 bool net_IsValidHostName(const nsACString& host) {
+  const char* iter = host.BeginReading();
   const char* end = host.EndReading();
-  // Use explicit whitelists to select which characters we are
-  // willing to send to lower-level DNS logic. This is more
-  // self-documenting, and can also be slightly faster than the
-  // blacklist approach, since DNS names are the common case, and
-  // the commonest characters will tend to be near the start of
-  // the list.
-
-  // Whitelist for DNS names (RFC 1035) with extra characters added
-  // for pragmatic reasons "$+_"
-  // see https://bugzilla.mozilla.org/show_bug.cgi?id=355181#c2
-  if (net_FindCharNotInSet(host.BeginReading(), end,
-                           "abcdefghijklmnopqrstuvwxyz"
-                           ".-0123456789"
-                           "ABCDEFGHIJKLMNOPQRSTUVWXYZ$+_") == end)
-    return true;
+  for (; iter != end; ++iter) {
+    const unsigned char idx = *iter;
+    if (idx > 127 || !kValidHostChars[idx]) {
+      break;
+    }
+  }
+  if (iter == end) return true;
 
   // Might be a valid IPv6 link-local address containing a percent sign
   nsAutoCString strhost(host);
@@ -974,6 +1015,17 @@ void URLParams::DecodeString(const nsACString& aInput, nsAString& aOutput) {
   nsAutoCString unescaped;
 
   for (const char* iter = aInput.BeginReading(); iter != end;) {
+    // Copy the run up to the next character that needs special handling in
+    // one go; most of the input is usually plain.
+    const char* runStart = iter;
+    while (iter != end && *iter != '+' && *iter != '%') {
+      ++iter;
+    }
+    unescaped.Append(runStart, iter - runStart);
+    if (iter == end) {
+      break;
+    }
+
     // replace '+' with U+0020
     if (*iter == '+') {
       unescaped.Append(' ');
@@ -1008,9 +1060,6 @@ void URLParams::DecodeString(const nsACString& aInput, nsAString& aOutput) {
 
       continue;
     }
-
-    unescaped.Append(*iter);
-    ++iter;
   }
 
   // XXX It seems rather wasteful to first decode into a UTF-8 nsCString and
@@ -1089,16 +1138,32 @@ void SerializeString(const nsCString& aInput, nsAString& aValue) {
   const unsigned char* end = p + aInput.Length();
 
   while (p != end) {
+    // Append the run of characters that need no escaping in one go.
+    const unsigned char* runStart = p;
+    while (p != end && (*p == 0x2A || *p == 0x2D || *p == 0x2E ||
+                        (*p >= 0x30 && *p <= 0x39) ||
+                        (*p >= 0x41 && *p <= 0x5A) || *p == 0x5F ||
+                        (*p >= 0x61 && *p <= 0x7A))) {
+      ++p;
+    }
+    if (p != runStart) {
+      AppendASCIItoUTF16(
+          nsDependentCSubstring((const char*)runStart, p - runStart), aValue);
+      if (p == end) {
+        break;
+      }
+    }
+
     // ' ' to '+'
     if (*p == 0x20) {
       aValue.Append(0x2B);
-      // Percent Encode algorithm
-    } else if (*p == 0x2A || *p == 0x2D || *p == 0x2E ||
-               (*p >= 0x30 && *p <= 0x39) || (*p >= 0x41 && *p <= 0x5A) ||
-               *p == 0x5F || (*p >= 0x61 && *p <= 0x7A)) {
-      aValue.Append(*p);
     } else {
-      aValue.AppendPrintf("%%%.2X", *p);
+      // Percent Encode algorithm; formatting the byte by hand is much
+      // cheaper than AppendPrintf.
+      static const char kHexChars[] = "0123456789ABCDEF";
+      aValue.Append(char16_t('%'));
+      aValue.Append(char16_t(kHexChars[*p >> 4]));
+      aValue.Append(char16_t(kHexChars[*p & 0x0F]));
     }
 
     ++p;
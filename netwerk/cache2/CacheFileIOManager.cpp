@@ -1867,12 +1867,19 @@ nsresult CacheFileIOManager::ReadInternal(CacheFileHandle* aHandle,
     return NS_ERROR_NOT_AVAILABLE;
   }
 
+#if defined(XP_UNIX)
+  // Use positional read to spare the seek syscall. Nothing else relies on the
+  // file offset of the descriptor, all I/O on it happens on this thread.
+  int32_t bytesRead = pread(PR_FileDesc2NativeHandle(aHandle->mFD), aBuf,
+                            aCount, static_cast<off_t>(aOffset));
+#else
   int64_t offset = PR_Seek64(aHandle->mFD, aOffset, PR_SEEK_SET);
   if (offset == -1) {
     return NS_ERROR_FAILURE;
   }
 
   int32_t bytesRead = PR_Read(aHandle->mFD, aBuf, aCount);
+#endif
   if (bytesRead != aCount) {
     return NS_ERROR_FAILURE;
   }
@@ -2016,12 +2023,19 @@ nsresult CacheFileIOManager::WriteInternal(CacheFileHandle* aHandle,
   // Write invalidates the entry by default
   aHandle->mInvalid = true;
 
+#if defined(XP_UNIX)
+  // Use positional write to spare the seek syscall. Nothing else relies on
+  // the file offset of the descriptor, all I/O on it happens on this thread.
+  int32_t bytesWritten = pwrite(PR_FileDesc2NativeHandle(aHandle->mFD), aBuf,
+                                aCount, static_cast<off_t>(aOffset));
+#else
   int64_t offset = PR_Seek64(aHandle->mFD, aOffset, PR_SEEK_SET);
   if (offset == -1) {
     return NS_ERROR_FAILURE;
   }
 
   int32_t bytesWritten = PR_Write(aHandle->mFD, aBuf, aCount);
+#endif
 
   if (bytesWritten != -1) {
     uint32_t oldSizeInK = aHandle->FileSizeInK();
@@ -1684,6 +1684,17 @@ void CacheIndex::WriteIndexToDisk() {
 
   mProcessEntries = mIndexStats.ActiveEntriesCount();
 
+  MOZ_ASSERT(mProcessEntriesArray.IsEmpty());
+  mProcessEntriesArray.SetCapacity(mProcessEntries);
+  for (auto iter = mIndex.Iter(); !iter.Done(); iter.Next()) {
+    CacheIndexEntry* entry = iter.Get();
+    if (entry->IsRemoved() || !entry->IsInitialized() || entry->IsFileEmpty()) {
+      continue;
+    }
+    mProcessEntriesArray.AppendElement(entry);
+  }
+  MOZ_ASSERT(mProcessEntriesArray.Length() == mProcessEntries);
+
   mIndexFileOpener = new FileOpenHelper(this);
   rv = CacheFileIOManager::OpenFile(
       nsLiteralCString(TEMP_INDEX_NAME),
@@ -1743,37 +1754,20 @@ void CacheIndex::WriteRecords() {
   uint32_t hashOffset = mRWBufPos;
 
   char* buf = mRWBuf + mRWBufPos;
-  uint32_t skip = mSkipEntries;
   uint32_t processMax = (mRWBufSize - mRWBufPos) / sizeof(CacheIndexRecord);
   MOZ_ASSERT(processMax != 0 ||
              mProcessEntries ==
                  0);  // TODO make sure we can write an empty index
   uint32_t processed = 0;
-#ifdef DEBUG
-  bool hasMore = false;
-#endif
-  for (auto iter = mIndex.Iter(); !iter.Done(); iter.Next()) {
-    CacheIndexEntry* entry = iter.Get();
-    if (entry->IsRemoved() || !entry->IsInitialized() || entry->IsFileEmpty()) {
-      continue;
-    }
-
-    if (skip) {
-      skip--;
-      continue;
-    }
-
-    if (processed == processMax) {
-#ifdef DEBUG
-      hasMore = true;
-#endif
-      break;
-    }
-
-    entry->WriteToBuf(buf);
+  while (mSkipEntries + processed < mProcessEntriesArray.Length() &&
+         processed < processMax) {
+    mProcessEntriesArray[mSkipEntries + processed]->WriteToBuf(buf);
     buf += sizeof(CacheIndexRecord);
     processed++;
   }
+#ifdef DEBUG
+  bool hasMore = mSkipEntries + processed < mProcessEntriesArray.Length();
+#endif
 
   MOZ_ASSERT(mRWBufPos != static_cast<uint32_t>(buf - mRWBuf) ||
              mProcessEntries == 0);
@@ -1863,6 +1857,9 @@ void CacheIndex::FinishWrite(bool aSucceeded) {
     }
   }
 
+  // Entries can be removed from the hashtable from now on.
+  mProcessEntriesArray.Clear();
+
   ProcessPendingOperations();
   mIndexStats.Log();
 
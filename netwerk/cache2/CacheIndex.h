@@ -1097,6 +1097,12 @@ class CacheIndex final : public CacheFileIOListener, public nsIRunnable {
   // in hashtable that are initialized and are not marked as removed when
   // writing begins.
   uint32_t mProcessEntries;
+  // The entries to write, collected from the hashtable when writing begins.
+  // The hashtable cannot change while the index is being written (changes are
+  // deferred to mPendingUpdates), so the pointers stay valid. Writing from
+  // this array avoids re-scanning the hashtable past the already written
+  // entries on every write cycle.
+  nsTArray<CacheIndexEntry*> mProcessEntriesArray;
   char* mRWBuf;
   uint32_t mRWBufSize;
   uint32_t mRWBufPos;
@@ -1370,7 +1370,13 @@ CacheStorageService::Notify(nsITimer* aTimer) {
     nsCOMPtr<nsIRunnable> event =
         NewRunnableMethod("net::CacheStorageService::PurgeOverMemoryLimit",
                           this, &CacheStorageService::PurgeOverMemoryLimit);
-    Dispatch(event);
+    // Purging the memory pools is deferrable work, so let it yield to
+    // request I/O by running at the same low level as disk eviction rather
+    // than at MANAGEMENT, which would preempt all reads and writes.
+    RefPtr<CacheIOThread> cacheIOThread = CacheFileIOManager::IOThread();
+    if (cacheIOThread) {
+      cacheIOThread->Dispatch(event, CacheIOThread::EVICT);
+    }
   }
 
   return NS_OK;
@@ -43,7 +43,9 @@ bool CookieCommons::DomainMatches(Cookie* aCookie, const nsACString& aHost) {
 
 // static
 bool CookieCommons::PathMatches(Cookie* aCookie, const nsACString& aPath) {
-  nsCString cookiePath(aCookie->GetFilePath());
+  // GetFilePath() returns a cached string; don't copy it for every cookie we
+  // consider.
+  const nsCString& cookiePath = aCookie->GetFilePath();
 
   // if our cookie path is empty we can't really perform our prefix check, and
   // also we can't check the last character of the cookie path, so we would
@@ -541,16 +541,14 @@ CookieService::SetCookieStringFromHttp(nsIURI* aHostURI,
   nsAutoCString hostFromURI;
   nsContentUtils::GetHostOrIPv6WithBrackets(aHostURI, hostFromURI);
 
-  nsAutoCString baseDomainFromURI;
-  rv = CookieCommons::GetBaseDomainFromHost(mTLDService, hostFromURI,
-                                            baseDomainFromURI);
-  NS_ENSURE_SUCCESS(rv, NS_OK);
-
   CookieStorage* storage = PickStorage(attrs);
 
   // check default prefs
-  uint32_t priorCookieCount = storage->CountCookiesFromHost(
-      baseDomainFromURI, attrs.mPrivateBrowsingId);
+  // Note: GetBaseDomain above already derived the base domain from the same
+  // (already normalized) URI host, so there's no need to consult the eTLD
+  // service a second time here.
+  uint32_t priorCookieCount =
+      storage->CountCookiesFromHost(baseDomain, attrs.mPrivateBrowsingId);
 
   nsCOMPtr<nsIConsoleReportCollector> crc = do_QueryInterface(aChannel);
 
@@ -878,9 +876,17 @@ void CookieService::GetCookiesForURI(
   NS_ENSURE_SUCCESS_VOID(rv);
 
   nsAutoCString baseDomainFromURI;
-  rv = CookieCommons::GetBaseDomainFromHost(mTLDService, normalizedHostFromURI,
-                                            baseDomainFromURI);
-  NS_ENSURE_SUCCESS_VOID(rv);
+  if (normalizedHostFromURI == hostFromURI) {
+    // Normalization didn't change the host that GetBaseDomain above already
+    // derived the base domain from, so consulting the eTLD service a second
+    // time would return the same result. This runs for every channel, so the
+    // saved lookup matters.
+    baseDomainFromURI = baseDomain;
+  } else {
+    rv = CookieCommons::GetBaseDomainFromHost(
+        mTLDService, normalizedHostFromURI, baseDomainFromURI);
+    NS_ENSURE_SUCCESS_VOID(rv);
+  }
 
   nsICookie::schemeType schemeType = CookieCommons::URIToSchemeType(aHostURI);
 
@@ -291,37 +291,65 @@ nsresult nsEffectiveTLDService::GetBaseDomainInternal(
     return NS_ERROR_INVALID_ARG;
   }
 
-  // Lookup in the cache if this is a normal query. This is restricted to
-  // main thread-only as the cache is not thread-safe.
+  // Lookup in the cache if this is a normal query. The main thread has its
+  // own lock-free table; other threads use the mutex-guarded shard their
+  // host hashes to.
   Maybe<TldCache::Entry> entry;
-  if (aAdditionalParts == 1 && NS_IsMainThread()) {
-    auto p = mMruTable.Lookup(aHostname);
-    if (p) {
-      if (NS_FAILED(p.Data().mResult)) {
-        return p.Data().mResult;
+  TldCacheShard* shard = nullptr;
+  if (aAdditionalParts == 1) {
+    if (NS_IsMainThread()) {
+      auto p = mMruTable.Lookup(aHostname);
+      if (p) {
+        if (NS_FAILED(p.Data().mResult)) {
+          return p.Data().mResult;
+        }
+
+        // There was a match, just return the cached value.
+        aBaseDomain = p.Data().mBaseDomain;
+        if (trailingDot) {
+          aBaseDomain.Append('.');
+        }
+
+        return NS_OK;
       }
 
-      // There was a match, just return the cached value.
-      aBaseDomain = p.Data().mBaseDomain;
-      if (trailingDot) {
-        aBaseDomain.Append('.');
+      entry = Some(p);
+    } else {
+      shard = &mShards[HashString(aHostname) % kTldCacheShards];
+      MutexAutoLock lock(shard->mLock);
+      auto p = shard->mCache.Lookup(aHostname);
+      if (p) {
+        if (NS_FAILED(p.Data().mResult)) {
+          return p.Data().mResult;
+        }
+
+        aBaseDomain = p.Data().mBaseDomain;
+        if (trailingDot) {
+          aBaseDomain.Append('.');
+        }
+
+        return NS_OK;
       }
-
-      return NS_OK;
     }
-
-    entry = Some(p);
   }
 
+  // Records the result for aHostname in whichever table the lookup above
+  // missed in.
+  auto cacheResult = [&](const nsACString& aDomain, nsresult aRv) {
+    if (entry) {
+      entry->Set(TLDCacheEntry{aHostname, nsCString(aDomain), aRv});
+    } else if (shard) {
+      MutexAutoLock lock(shard->mLock);
+      shard->mCache.Put(aHostname,
+                        TLDCacheEntry{aHostname, nsCString(aDomain), aRv});
+    }
+  };
+
   // Check if we're dealing with an IPv4/IPv6 hostname, and return
   PRNetAddr addr;
   PRStatus result = PR_StringToNetAddr(aHostname.get(), &addr);
   if (result == PR_SUCCESS) {
-    // Update the MRU table if in use.
-    if (entry) {
-      entry->Set(TLDCacheEntry{aHostname, ""_ns, NS_ERROR_HOST_IS_IP_ADDRESS});
-    }
-
+    cacheResult(""_ns, NS_ERROR_HOST_IS_IP_ADDRESS);
     return NS_ERROR_HOST_IS_IP_ADDRESS;
   }
 
@@ -340,11 +368,7 @@ nsresult nsEffectiveTLDService::GetBaseDomainInternal(
     // with a '.'; this would mean the hostname began with a '.' or had an
     // embedded '..' sequence.
     if (*currDomain == '.') {
-      // Update the MRU table if in use.
-      if (entry) {
-        entry->Set(TLDCacheEntry{aHostname, ""_ns, NS_ERROR_INVALID_ARG});
-      }
-
+      cacheResult(""_ns, NS_ERROR_INVALID_ARG);
       return NS_ERROR_INVALID_ARG;
     }
 
@@ -423,21 +447,13 @@ nsresult nsEffectiveTLDService::GetBaseDomainInternal(
   }
 
   if (aAdditionalParts != 0) {
-    // Update the MRU table if in use.
-    if (entry) {
-      entry->Set(
-          TLDCacheEntry{aHostname, ""_ns, NS_ERROR_INSUFFICIENT_DOMAIN_LEVELS});
-    }
-
+    cacheResult(""_ns, NS_ERROR_INSUFFICIENT_DOMAIN_LEVELS);
     return NS_ERROR_INSUFFICIENT_DOMAIN_LEVELS;
   }
 
   aBaseDomain = Substring(iter, end);
 
-  // Update the MRU table if in use.
-  if (entry) {
-    entry->Set(TLDCacheEntry{aHostname, nsCString(aBaseDomain), NS_OK});
-  }
+  cacheResult(aBaseDomain, NS_OK);
 
   // add on the trailing dot, if applicable
   if (trailingDot) {
@@ -14,6 +14,7 @@
 #include "mozilla/Maybe.h"
 #include "mozilla/MemoryReporting.h"
 #include "mozilla/MruCache.h"
+#include "mozilla/Mutex.h"
 #include "mozilla/RWLock.h"
 
 #include "nsCOMPtr.h"
@@ -75,9 +76,11 @@ class nsEffectiveTLDService final : public nsIEffectiveTLDService,
   // if a match is found. Otherwise we lookup the domain in the DAFSA and then
   // cache the result. During standard browsing the same domains are repeatedly
   // fed into |GetBaseDomainInternal| so this ends up being an effective
-  // mitigation getting about a 99% hit rate with four tabs open.
+  // mitigation getting about a 99% hit rate with four tabs open. The size is
+  // chosen so the few dozen hosts that account for nearly all lookups fit
+  // without collisions.
   struct TldCache
-      : public mozilla::MruCache<nsACString, TLDCacheEntry, TldCache> {
+      : public mozilla::MruCache<nsACString, TLDCacheEntry, TldCache, 61> {
     static mozilla::HashNumber Hash(const nsACString& aKey) {
       return mozilla::HashString(aKey);
     }
@@ -86,7 +89,21 @@ class nsEffectiveTLDService final : public nsIEffectiveTLDService,
     }
   };
 
+  // Lock-free table for the main thread, where most lookups happen.
   TldCache mMruTable;
+
+  // Off-main-thread callers (cookie, antitracking and permission code on the
+  // request path) use a small set of mutex-guarded shards instead, selected
+  // by host hash so lookups for different hosts rarely contend on the same
+  // lock.
+  struct TldCacheShard {
+    TldCacheShard() : mLock("nsEffectiveTLDService.TldCacheShard") {}
+
+    mozilla::Mutex mLock;
+    TldCache mCache;
+  };
+  static const size_t kTldCacheShards = 8;
+  TldCacheShard mShards[kTldCacheShards];
 };
 
 #endif  // EffectiveTLDService_h
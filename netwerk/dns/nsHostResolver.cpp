@@ -980,6 +980,37 @@ nsresult nsHostResolver::ResolveHost(const nsACString& aHost,
   }
   memset(&tempAddr, 0, sizeof(PRNetAddr));
 
+  // The TRR exclusion check, the key construction and the loopback handling
+  // only use data local to this request, so do them before taking the lock to
+  // keep the critical section that every lookup serializes on as short as
+  // possible.
+  bool excludedFromTRR = false;
+
+  if (gTRRService && gTRRService->IsExcludedFromTRR(host)) {
+    flags |= RES_DISABLE_TRR;
+    excludedFromTRR = true;
+
+    if (!aTrrServer.IsEmpty()) {
+      return NS_ERROR_UNKNOWN_HOST;
+    }
+  }
+
+  nsHostKey key(host, aTrrServer, type, flags, af,
+                (aOriginAttributes.mPrivateBrowsingId > 0), originSuffix);
+
+  // Check if we have a localhost domain, if so hardcode to loopback. The
+  // record never enters the cache, so no shared state is touched.
+  if (IS_ADDR_TYPE(type) && IsLoopbackHostname(host)) {
+    nsresult rv;
+    RefPtr<nsHostRecord> result = InitLoopbackRecord(key, &rv);
+    if (NS_WARN_IF(NS_FAILED(rv))) {
+      return rv;
+    }
+    MOZ_ASSERT(result);
+    aCallback->OnResolveHostComplete(this, result, NS_OK);
+    return NS_OK;
+  }
+
   RefPtr<nsResolveHostCallback> callback(aCallback);
   // if result is set inside the lock, then we need to issue the
   // callback before returning.
@@ -999,32 +1030,6 @@ nsresult nsHostResolver::ResolveHost(const nsACString& aHost,
     // and return.  otherwise, add ourselves as first pending
     // callback, and proceed to do the lookup.
 
-    bool excludedFromTRR = false;
-
-    if (gTRRService && gTRRService->IsExcludedFromTRR(host)) {
-      flags |= RES_DISABLE_TRR;
-      excludedFromTRR = true;
-
-      if (!aTrrServer.IsEmpty()) {
-        return NS_ERROR_UNKNOWN_HOST;
-      }
-    }
-
-    nsHostKey key(host, aTrrServer, type, flags, af,
-                  (aOriginAttributes.mPrivateBrowsingId > 0), originSuffix);
-
-    // Check if we have a localhost domain, if so hardcode to loopback
-    if (IS_ADDR_TYPE(type) && IsLoopbackHostname(host)) {
-      nsresult rv;
-      RefPtr<nsHostRecord> result = InitLoopbackRecord(key, &rv);
-      if (NS_WARN_IF(NS_FAILED(rv))) {
-        return rv;
-      }
-      MOZ_ASSERT(result);
-      aCallback->OnResolveHostComplete(this, result, NS_OK);
-      return NS_OK;
-    }
-
     RefPtr<nsHostRecord>& entry = mRecordDB.GetOrInsert(key);
     if (!entry) {
       entry = InitRecord(key);
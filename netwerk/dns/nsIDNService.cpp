@@ -75,7 +75,8 @@ NS_IMPL_ISUPPORTS(nsIDNService, nsIIDNService, nsISupportsWeakReference)
 static const char* gCallbackPrefs[] = {
     NS_NET_PREF_EXTRAALLOWED,    NS_NET_PREF_EXTRABLOCKED,
     NS_NET_PREF_SHOWPUNYCODE,    NS_NET_PREF_IDNRESTRICTION,
-    NS_NET_PREF_IDNUSEWHITELIST, nullptr,
+    NS_NET_PREF_IDNUSEWHITELIST, NS_NET_PREF_IDNWHITELIST,
+    nullptr,
 };
 
 nsresult nsIDNService::Init() {
@@ -99,6 +100,10 @@ void nsIDNService::prefsChanged(const char* pref) {
   MOZ_ASSERT(NS_IsMainThread());
   mLock.AssertCurrentThreadOwns();
 
+  // Any of these prefs (including whitelist entries) can change what
+  // ConvertToDisplayIDN produces for a given host.
+  mDisplayIDNCache.Clear();
+
   if (pref && nsLiteralCString(NS_NET_PREF_EXTRAALLOWED).Equals(pref)) {
     InitializeBlocklist(mIDNBlocklist);
   }
@@ -410,6 +415,30 @@ class MOZ_STACK_CLASS MutexSettableAutoUnlock final {
 NS_IMETHODIMP nsIDNService::ConvertToDisplayIDN(const nsACString& input,
                                                 bool* _isASCII,
                                                 nsACString& _retval) {
+  // Consult the display cache first; it is main thread only, matching the
+  // MruCache in nsEffectiveTLDService.
+  if (NS_IsMainThread()) {
+    auto p = mDisplayIDNCache.Lookup(input);
+    if (p) {
+      _retval = p.Data().mDisplay;
+      *_isASCII = p.Data().mIsASCII;
+      return NS_OK;
+    }
+
+    nsresult rv = ConvertToDisplayIDNInternal(input, _isASCII, _retval);
+    if (NS_SUCCEEDED(rv)) {
+      p.Set(DisplayIDNCacheEntry{nsCString(input), nsCString(_retval),
+                                 *_isASCII});
+    }
+    return rv;
+  }
+
+  return ConvertToDisplayIDNInternal(input, _isASCII, _retval);
+}
+
+nsresult nsIDNService::ConvertToDisplayIDNInternal(const nsACString& input,
+                                                   bool* _isASCII,
+                                                   nsACString& _retval) {
   MutexSettableAutoUnlock lock;
   if (!NS_IsMainThread()) {
     lock.Acquire(mLock);
@@ -12,6 +12,7 @@
 #include "nsWeakReference.h"
 
 #include "unicode/uidna.h"
+#include "mozilla/MruCache.h"
 #include "mozilla/Mutex.h"
 #include "mozilla/net/IDNBlocklistUtils.h"
 
@@ -200,6 +201,38 @@ class nsIDNService final : public nsIIDNService,
   nsCOMPtr<nsIPrefBranch> mIDNWhitelistPrefBranch;
   // guarded by mLock
   bool mIDNUseWhitelist;
+
+  /**
+   * Performs the actual host to display-form conversion for
+   * ConvertToDisplayIDN, bypassing the display cache.
+   */
+  nsresult ConvertToDisplayIDNInternal(const nsACString& input, bool* _isASCII,
+                                       nsACString& _retval);
+
+  // The same hosts are converted for display over and over again while a
+  // page full of links is laid out, so keep a small most recently used
+  // cache of results.  Entries are only recorded for conversions whose
+  // result depends purely on the input and the prefs; the cache is cleared
+  // whenever a relevant pref changes.  Main thread only, as the cache is
+  // not thread-safe.
+  struct DisplayIDNCacheEntry {
+    nsCString mHost;
+    nsCString mDisplay;
+    bool mIsASCII;
+  };
+  struct DisplayIDNCache
+      : public mozilla::MruCache<nsACString, DisplayIDNCacheEntry,
+                                 DisplayIDNCache> {
+    static mozilla::HashNumber Hash(const nsACString& aKey) {
+      return mozilla::HashString(aKey);
+    }
+    static bool Match(const nsACString& aKey,
+                      const DisplayIDNCacheEntry& aVal) {
+      return aKey == aVal.mHost;
+    }
+  };
+  // main thread only
+  DisplayIDNCache mDisplayIDNCache;
 };
 
 #endif  // nsIDNService_h__
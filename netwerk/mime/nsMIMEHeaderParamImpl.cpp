@@ -179,13 +179,28 @@ nsresult nsMIMEHeaderParamImpl::DoGetParameter(
 // modifies string in place, potentially shortening it
 void RemoveQuotedStringEscapes(char* src) {
   char* dst = src;
+  char* c = src;
 
-  for (char* c = src; *c; ++c) {
-    if (c[0] == '\\' && c[1]) {
+  // Move unescaped runs wholesale instead of copying one character at a
+  // time; most quoted-strings contain few (if any) backslashes.
+  while (*c) {
+    char* next = strchr(c, '\\');
+    size_t runLength = next ? size_t(next - c) : strlen(c);
+    if (dst != c && runLength) {
+      memmove(dst, c, runLength);
+    }
+    dst += runLength;
+    c += runLength;
+    if (!next) {
+      break;
+    }
+    if (c[1]) {
       // skip backslash if not at end
-      ++c;
+      *dst++ = c[1];
+      c += 2;
+    } else {
+      *dst++ = *c++;
     }
-    *dst++ = *c;
   }
   *dst = 0;
 }
@@ -29,6 +29,7 @@
 #include <algorithm>
 
 #include "mozilla/TaskQueue.h"
+#include "mozilla/URLPreloader.h"
 #include "mozilla/Unused.h"
 
 using namespace mozilla;
@@ -383,6 +384,12 @@ nsresult nsFileChannel::OpenContentStream(bool async, nsIInputStream** result,
     rv = MakeFileInputStream(file, stream, contentType, async);
     if (NS_FAILED(rv)) return rv;
 
+    if (!async) {
+      // Record synchronous profile file reads so the URLPreloader can warm
+      // them before they're needed during the next session's startup.
+      URLPreloader::NoteFileRead(file);
+    }
+
     EnableSynthesizedProgressEvents(true);
 
     // fixup content length and type
@@ -4,6 +4,7 @@
 
 #include "mozilla/net/BackgroundDataBridgeChild.h"
 #include "mozilla/net/HttpBackgroundChannelChild.h"
+#include "mozilla/ScopeExit.h"
 
 namespace mozilla {
 namespace net {
@@ -21,8 +22,12 @@ void BackgroundDataBridgeChild::ActorDestroy(ActorDestroyReason aWhy) {
 }
 
 mozilla::ipc::IPCResult BackgroundDataBridgeChild::RecvOnTransportAndData(
-    const uint64_t& offset, const uint32_t& count,
-    const nsDependentCSubstring& data) {
+    const uint64_t& offset, const uint32_t& count, mozilla::ipc::Shmem&& data) {
+  // We own the shmem segment now and have to release it once the data has
+  // been passed on. HttpBackgroundChannelChild copies the data out
+  // synchronously, so the segment can be deallocated before returning.
+  auto releaseShmem = MakeScopeExit([&] { DeallocShmem(data); });
+
   if (!mBgChild) {
     return IPC_OK();
   }
@@ -32,8 +37,9 @@ mozilla::ipc::IPCResult BackgroundDataBridgeChild::RecvOnTransportAndData(
     return IPC_OK();
   }
 
+  nsDependentCSubstring buffered(data.get<char>(), count);
   return mBgChild->RecvOnTransportAndData(NS_OK, NS_NET_STATUS_RECEIVING_FROM,
-                                          offset, count, data, true);
+                                          offset, count, buffered, true);
 }
 
 mozilla::ipc::IPCResult BackgroundDataBridgeChild::RecvOnStopRequest(
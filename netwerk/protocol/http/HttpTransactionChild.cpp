@@ -266,13 +266,6 @@ HttpTransactionChild::OnDataAvailable(nsIRequest* aRequest,
     return mStatus;
   }
 
-  // TODO: send string data in chunks and handle errors. Bug 1600129.
-  nsCString data;
-  nsresult rv = NS_ReadInputStreamToString(aInputStream, data, aCount);
-  if (NS_FAILED(rv)) {
-    return rv;
-  }
-
   mLogicalOffset += aCount;
 
   if (NS_IsMainThread()) {
@@ -280,6 +273,13 @@ HttpTransactionChild::OnDataAvailable(nsIRequest* aRequest,
       return NS_ERROR_FAILURE;
     }
 
+    // TODO: send string data in chunks and handle errors. Bug 1600129.
+    nsCString data;
+    nsresult rv = NS_ReadInputStreamToString(aInputStream, data, aCount);
+    if (NS_FAILED(rv)) {
+      return rv;
+    }
+
     nsHttp::SendFunc<nsCString> sendFunc =
         [self = UnsafePtr<HttpTransactionChild>(this)](
             const nsCString& aData, uint64_t aOffset, uint32_t aCount) {
@@ -300,16 +300,32 @@ HttpTransactionChild::OnDataAvailable(nsIRequest* aRequest,
     return NS_ERROR_FAILURE;
   }
 
-  nsHttp::SendFunc<nsDependentCSubstring> sendFunc =
-      [self = UnsafePtr<HttpTransactionChild>(this)](
-          const nsDependentCSubstring& aData, uint64_t aOffset,
-          uint32_t aCount) {
-        return self->mDataBridgeParent->SendOnTransportAndData(aOffset, aCount,
-                                                               aData);
-      };
+  // Fill a shared memory segment straight from the response pipe and hand it
+  // over to the content process, so the payload is not serialized into the
+  // IPC message. There is no need to chunk the data, the segment is
+  // transferred by handle no matter how large it is.
+  ipc::Shmem mem;
+  if (!mDataBridgeParent->AllocShmem(aCount, ipc::SharedMemory::TYPE_BASIC,
+                                     &mem)) {
+    return NS_ERROR_OUT_OF_MEMORY;
+  }
+
+  void* dest = mem.get<char>();
+  uint64_t written = 0;
+  nsresult rv = NS_ReadInputStreamToBuffer(aInputStream, &dest, aCount,
+                                           &written);
+  if (NS_FAILED(rv) || written != aCount) {
+    mDataBridgeParent->DeallocShmem(mem);
+    return NS_FAILED(rv) ? rv : NS_ERROR_UNEXPECTED;
+  }
+
+  // The parent process needs its own copy of the data for the cache; take it
+  // before the send transfers the segment to the content process.
+  nsCString data(mem.get<char>(), aCount);
 
   LOG(("  ODA to content process"));
-  if (!nsHttp::SendDataInChunks(data, aOffset, aCount, sendFunc)) {
+  if (!mDataBridgeParent->SendOnTransportAndData(aOffset, aCount,
+                                                 std::move(mem))) {
     MOZ_ASSERT(false, "Send ODA to content process failed");
     return NS_ERROR_FAILURE;
   }
@@ -643,11 +643,24 @@ void ParsedHeaderPair::RemoveQuotedStringEscapes(const char* val,
                                                  int32_t valLen) {
   mUnquotedValue.Truncate();
   const char* c = val;
-  for (int32_t i = 0; i < valLen; ++i) {
-    if (c[i] == '\\' && c[i + 1]) {
-      ++i;
+  const char* end = val + valLen;
+  // Append unescaped runs in one go; per-character Append is costly and
+  // escapes are rare in typical header values.
+  while (c < end) {
+    const char* next =
+        static_cast<const char*>(memchr(c, '\\', size_t(end - c)));
+    if (!next) {
+      mUnquotedValue.Append(c, end - c);
+      break;
+    }
+    mUnquotedValue.Append(c, next - c);
+    c = next;
+    if (c[1]) {
+      mUnquotedValue.Append(c[1]);
+      c += 2;
+    } else {
+      mUnquotedValue.Append(*c++);
     }
-    mUnquotedValue.Append(c[i]);
   }
 }
 
@@ -48,32 +48,47 @@ nsresult nsHttpChunkedDecoder::HandleChunkedContent(
   // chunk.  the chunked encoding is ended by any chunk whose size is zero,
   // followed by the trailer, which is terminated by an empty line.
 
+  // Compact the chunk-data toward the front of |buf| as we go, using
+  // separate read and write cursors.  This moves each content byte at most
+  // once; shifting the entire remaining buffer after every chunk header is
+  // O(count) per chunk and hurts badly when a single socket read contains
+  // many small chunks.
+  char* src = buf;
+  char* dst = buf;
+
   while (count) {
     if (mChunkRemaining) {
       uint32_t amt = std::min(mChunkRemaining, count);
 
+      if (dst != src) {
+        memmove(dst, src, amt);
+      }
+
       count -= amt;
       mChunkRemaining -= amt;
 
       *contentRead += amt;
-      buf += amt;
+      dst += amt;
+      src += amt;
     } else if (mReachedEOF)
       break;  // done
     else {
       uint32_t bytesConsumed = 0;
 
-      nsresult rv = ParseChunkRemaining(buf, count, &bytesConsumed);
+      nsresult rv = ParseChunkRemaining(src, count, &bytesConsumed);
       if (NS_FAILED(rv)) return rv;
 
       count -= bytesConsumed;
-
-      if (count) {
-        // shift buf by bytesConsumed
-        memmove(buf, buf + bytesConsumed, count);
-      }
+      src += bytesConsumed;
     }
   }
 
+  // Any leftover bytes belong to the next transaction on this connection and
+  // must directly follow the content we just decoded.
+  if (count && dst != src) {
+    memmove(dst, src, count);
+  }
+
   *contentRemaining = count;
   return NS_OK;
 }
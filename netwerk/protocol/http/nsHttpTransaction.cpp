@@ -2045,7 +2045,17 @@ nsresult nsHttpTransaction::ParseHead(char* buf, uint32_t count,
     if ((eol > buf) && (*(eol - 1) == '\r')) len--;
 
     buf[len - 1] = '\n';
-    rv = ParseLineSegment(buf, len);
+    if (mLineBuf.IsEmpty() && len > 1 && *countRead < count &&
+        *(eol + 1) != ' ' && *(eol + 1) != '\t') {
+      // Fast path: nothing is buffered, the line is complete and the first
+      // byte of the next line is already here and does not start a folded
+      // continuation, so the line can be parsed in place instead of being
+      // copied through mLineBuf.
+      nsDependentCSubstring line(buf, len - 1);
+      rv = ParseLine(line);
+    } else {
+      rv = ParseLineSegment(buf, len);
+    }
     if (NS_FAILED(rv)) return rv;
 
     if (mHaveAllHeaders) return NS_OK;
@@ -560,6 +560,32 @@ class CallOnMessageAvailable final : public Runnable {
   int32_t mLen;
 };
 
+//-----------------------------------------------------------------------------
+// CallBatchedMessageEvents
+//-----------------------------------------------------------------------------
+
+// Delivers all of the CallOnMessageAvailable events decoded from one socket
+// read in a single cross-thread dispatch. A burst of small frames arriving
+// in one TCP segment otherwise costs a target-thread wakeup per message.
+class CallBatchedMessageEvents final : public Runnable {
+ public:
+  explicit CallBatchedMessageEvents(nsTArray<RefPtr<Runnable>>&& aEvents)
+      : Runnable("net::CallBatchedMessageEvents"),
+        mEvents(std::move(aEvents)) {}
+
+  NS_IMETHOD Run() override {
+    for (const auto& event : mEvents) {
+      event->Run();
+    }
+    return NS_OK;
+  }
+
+ private:
+  ~CallBatchedMessageEvents() = default;
+
+  nsTArray<RefPtr<Runnable>> mEvents;
+};
+
 //-----------------------------------------------------------------------------
 // CallOnStop
 //-----------------------------------------------------------------------------
@@ -1411,6 +1437,11 @@ nsresult WebSocketChannel::ProcessInput(uint8_t* buffer, uint32_t count) {
 
   nsresult rv;
 
+  // Deliver any queued message events on every exit path, including errors:
+  // messages decoded before a framing error must still reach the listener
+  // ahead of the OnStop our caller will dispatch.
+  auto flushMessageEvents = MakeScopeExit([&] { FlushMessageEvents(); });
+
   // The purpose of ping/pong is to actively probe the peer so that an
   // unreachable peer is not mistaken for a period of idleness. This
   // implementation accepts any application level read activity as a sign of
@@ -1651,8 +1682,8 @@ nsresult WebSocketChannel::ProcessInput(uint8_t* buffer, uint32_t count) {
           mService->FrameReceived(mSerial, mInnerWindowID, frame.forget());
         }
 
-        mTargetThread->Dispatch(new CallOnMessageAvailable(this, utf8Data, -1),
-                                NS_DISPATCH_NORMAL);
+        mPendingMessageEvents.AppendElement(
+            MakeRefPtr<CallOnMessageAvailable>(this, utf8Data, -1));
         if (mConnectionLogService && !mPrivateBrowsing) {
           mConnectionLogService->NewMsgReceived(mHost, mSerial, count);
           LOG(("Added new msg received for %s", mHost.get()));
@@ -1711,6 +1742,9 @@ nsresult WebSocketChannel::ProcessInput(uint8_t* buffer, uint32_t count) {
         }
 
         if (mListenerMT) {
+          // Messages queued from this read must not be overtaken by the
+          // close notification.
+          FlushMessageEvents();
           mTargetThread->Dispatch(
               new CallOnServerClose(this, mServerCloseCode, mServerCloseReason),
               NS_DISPATCH_NORMAL);
@@ -1777,9 +1811,8 @@ nsresult WebSocketChannel::ProcessInput(uint8_t* buffer, uint32_t count) {
           mService->FrameReceived(mSerial, mInnerWindowID, frame.forget());
         }
 
-        mTargetThread->Dispatch(
-            new CallOnMessageAvailable(this, binaryData, binaryData.Length()),
-            NS_DISPATCH_NORMAL);
+        mPendingMessageEvents.AppendElement(MakeRefPtr<CallOnMessageAvailable>(
+            this, binaryData, binaryData.Length()));
         // To add the header to 'Networking Dashboard' log
         if (mConnectionLogService && !mPrivateBrowsing) {
           mConnectionLogService->NewMsgReceived(mHost, mSerial, count);
@@ -1837,30 +1870,64 @@ nsresult WebSocketChannel::ProcessInput(uint8_t* buffer, uint32_t count) {
   return NS_OK;
 }
 
+void WebSocketChannel::FlushMessageEvents() {
+  MOZ_ASSERT(OnSocketThread(), "not on socket thread");
+
+  if (mPendingMessageEvents.IsEmpty()) {
+    return;
+  }
+
+  // A single message takes the usual direct path; several messages decoded
+  // from one read share one trip to the target thread.
+  if (mPendingMessageEvents.Length() == 1) {
+    mTargetThread->Dispatch(mPendingMessageEvents[0].forget(),
+                            NS_DISPATCH_NORMAL);
+  } else {
+    mTargetThread->Dispatch(
+        new CallBatchedMessageEvents(std::move(mPendingMessageEvents)),
+        NS_DISPATCH_NORMAL);
+  }
+  mPendingMessageEvents.Clear();
+}
+
 /* static */
 void WebSocketChannel::ApplyMask(uint32_t mask, uint8_t* data, uint64_t len) {
   if (!data || len == 0) return;
 
-  // Optimally we want to apply the mask 32 bits at a time,
+  // Optimally we want to apply the mask a machine word at a time,
   // but the buffer might not be alligned. So we first deal with
-  // 0 to 3 bytes of preamble individually
+  // 0 to 7 bytes of preamble individually
 
-  while (len && (reinterpret_cast<uintptr_t>(data) & 3)) {
+  while (len && (reinterpret_cast<uintptr_t>(data) & 7)) {
     *data ^= mask >> 24;
     mask = RotateLeft(mask, 8);
     data++;
     len--;
   }
 
-  // perform mask on full words of data
+  // The mask repeats every 4 bytes, so the same pattern doubled covers a
+  // 64-bit lane and the rotating byte mask is unchanged by consuming any
+  // multiple of 4 bytes.
+
+  uint32_t wireMask;
+  NetworkEndian::writeUint32(&wireMask, mask);
 
-  uint32_t* iData = (uint32_t*)data;
-  uint32_t* end = iData + (len / 4);
-  NetworkEndian::writeUint32(&mask, mask);
-  for (; iData < end; iData++) *iData ^= mask;
-  mask = NetworkEndian::readUint32(&mask);
-  data = (uint8_t*)iData;
-  len = len % 4;
+  uint64_t* lData = (uint64_t*)data;
+  uint64_t* lEnd = lData + (len / 8);
+  uint64_t wideMask;
+  memcpy(&wideMask, &wireMask, 4);
+  memcpy(reinterpret_cast<uint8_t*>(&wideMask) + 4, &wireMask, 4);
+  for (; lData < lEnd; lData++) *lData ^= wideMask;
+  data = (uint8_t*)lData;
+  len = len % 8;
+
+  // perform mask on a remaining full 32-bit word of data
+
+  if (len >= 4) {
+    *(uint32_t*)data ^= wireMask;
+    data += 4;
+    len -= 4;
+  }
 
   // There maybe up to 3 trailing bytes that need to be dealt with
   // individually
@@ -24,6 +24,8 @@
 #include "nsCOMPtr.h"
 #include "nsString.h"
 #include "nsDeque.h"
+#include "nsTArray.h"
+#include "nsThreadUtils.h"
 #include "mozilla/Atomics.h"
 
 class nsIAsyncVerifyRedirectCallback;
@@ -176,6 +178,7 @@ class WebSocketChannel : public BaseWebSocketChannel,
 
   bool IsPersistentFramePtr();
   [[nodiscard]] nsresult ProcessInput(uint8_t* buffer, uint32_t count);
+  void FlushMessageEvents();
   [[nodiscard]] bool UpdateReadBuffer(uint8_t* buffer, uint32_t count,
                                       uint32_t accumulatedFragments,
                                       uint32_t* available);
@@ -280,6 +283,10 @@ class WebSocketChannel : public BaseWebSocketChannel,
   uint32_t mBuffered;
   uint32_t mBufferSize;
 
+  // Message events decoded from the current socket read, waiting to be
+  // dispatched to the target thread as one batch. Socket thread only.
+  nsTArray<RefPtr<mozilla::Runnable>> mPendingMessageEvents;
+
   // These are for the send buffers
   const static int32_t kCopyBreak = 1000;
 
@@ -13,6 +13,7 @@
 #  include "nsCOMPtr.h"
 #  include "mozilla/Atomics.h"
 #  include "mozilla/Mutex.h"
+#  include "mozilla/UniquePtr.h"
 
 #  include "zlib.h"
 
@@ -72,6 +73,10 @@ class BrotliWrapper {
   nsIRequest* mRequest;
   nsISupports* mContext;
   uint64_t mSourceOffset;
+
+  // Output buffer reused across BrotliHandler calls, so each segment of a
+  // large response does not pay for a fresh allocation.
+  UniquePtr<uint8_t[]> mOutBuffer;
 };
 
 class nsHTTPCompressConv : public nsIStreamConverter,
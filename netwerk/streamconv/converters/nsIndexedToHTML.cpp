@@ -20,6 +20,7 @@
 #include "nsDirIndexParser.h"
 #include "nsNativeCharsetUtils.h"
 #include "nsString.h"
+#include "nsReadableUtils.h"
 #include "nsContentUtils.h"
 #include <algorithm>
 #include "nsIChannel.h"
@@ -37,9 +38,13 @@ static void AppendNonAsciiToNCR(const nsAString& in, nsCString& out) {
   in.EndReading(end);
 
   while (start != end) {
-    if (*start < 128) {
-      out.Append(*start++);
-    } else {
+    // Append the ASCII run in one go instead of character by character.
+    nsAString::const_iterator runStart(start);
+    while (start != end && *start < 128) {
+      ++start;
+    }
+    LossyAppendUTF16toASCII(Substring(runStart, start), out);
+    if (start != end) {
       out.AppendLiteral("&#x");
       out.AppendInt(*start++, 16);
       out.Append(';');
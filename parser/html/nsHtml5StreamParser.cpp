@@ -203,6 +203,7 @@ nsHtml5StreamParser::nsHtml5StreamParser(nsHtml5TreeOpExecutor* aExecutor,
       mGuessEncoding(true),
       mReparseForbidden(false),
       mLastBuffer(nullptr),  // Will be filled when starting
+      mLastBufferCapacity(0),
       mExecutor(aExecutor),
       mTreeBuilder(new nsHtml5TreeBuilder(
           (aMode == VIEW_SOURCE_HTML || aMode == VIEW_SOURCE_XML)
@@ -910,7 +911,7 @@ nsresult nsHtml5StreamParser::WriteStreamBytes(
     Span<const uint8_t> aFromSegment) {
   NS_ASSERTION(IsParserThread(), "Wrong thread!");
   // mLastBuffer should always point to a buffer of the size
-  // READ_BUFFER_SIZE.
+  // mLastBufferCapacity.
   if (!mLastBuffer) {
     NS_WARNING("mLastBuffer should not be null!");
     MarkAsBroken(NS_ERROR_NULL_POINTER);
@@ -919,7 +920,7 @@ nsresult nsHtml5StreamParser::WriteStreamBytes(
   size_t totalRead = 0;
   auto src = aFromSegment;
   for (;;) {
-    auto dst = mLastBuffer->TailAsSpan(READ_BUFFER_SIZE);
+    auto dst = mLastBuffer->TailAsSpan(mLastBufferCapacity);
     uint32_t result;
     size_t read;
     size_t written;
@@ -939,13 +940,23 @@ nsresult nsHtml5StreamParser::WriteStreamBytes(
     totalRead += read;
     mLastBuffer->AdvanceEnd(written);
     if (result == kOutputFull) {
+      // Size the next buffer to fit the rest of this segment (within
+      // reason), so that a large network segment doesn't get chopped into
+      // READ_BUFFER_SIZE pieces, each with its own allocation, list link
+      // and tokenizer call. The byte count is an upper bound on the number
+      // of UTF-16 code units the rest of the segment can decode to.
+      uint32_t nextCapacity =
+          std::max(READ_BUFFER_SIZE,
+                   std::min(static_cast<uint32_t>(src.Length()),
+                            MAX_READ_BUFFER_SIZE));
       RefPtr<nsHtml5OwningUTF16Buffer> newBuf =
-          nsHtml5OwningUTF16Buffer::FalliblyCreate(READ_BUFFER_SIZE);
+          nsHtml5OwningUTF16Buffer::FalliblyCreate(nextCapacity);
       if (!newBuf) {
         MarkAsBroken(NS_ERROR_OUT_OF_MEMORY);
         return NS_ERROR_OUT_OF_MEMORY;
       }
       mLastBuffer = (mLastBuffer->next = std::move(newBuf));
+      mLastBufferCapacity = nextCapacity;
     } else {
       MOZ_ASSERT(totalRead == aFromSegment.Length(),
                  "The Unicode decoder consumed the wrong number of bytes.");
@@ -977,6 +988,8 @@ void nsHtml5StreamParser::ReDecodeLocalFile() {
   mLastBuffer->next = nullptr;
   mLastBuffer->setStart(0);
   mLastBuffer->setEnd(0);
+  // The first buffer is always allocated at READ_BUFFER_SIZE.
+  mLastBufferCapacity = READ_BUFFER_SIZE;
 
   // Decode again
   for (auto&& buffer : mBufferedLocalFileData) {
@@ -1116,6 +1129,7 @@ nsresult nsHtml5StreamParser::OnStartRequest(nsIRequest* aRequest) {
   MOZ_ASSERT(!mFirstBuffer, "How come we have the first buffer set?");
   MOZ_ASSERT(!mLastBuffer, "How come we have the last buffer set?");
   mFirstBuffer = mLastBuffer = newBuf;
+  mLastBufferCapacity = READ_BUFFER_SIZE;
 
   rv = NS_OK;
 
@@ -1262,7 +1276,7 @@ void nsHtml5StreamParser::DoStopRequest() {
              "Should have a decoder after finalizing sniffing.");
 
   // mLastBuffer should always point to a buffer of the size
-  // READ_BUFFER_SIZE.
+  // mLastBufferCapacity.
   if (!mLastBuffer) {
     NS_WARNING("mLastBuffer should not be null!");
     MarkAsBroken(NS_ERROR_NULL_POINTER);
@@ -1271,7 +1285,7 @@ void nsHtml5StreamParser::DoStopRequest() {
 
   Span<uint8_t> src;  // empty span
   for (;;) {
-    auto dst = mLastBuffer->TailAsSpan(READ_BUFFER_SIZE);
+    auto dst = mLastBuffer->TailAsSpan(mLastBufferCapacity);
     uint32_t result;
     size_t read;
     size_t written;
@@ -1297,6 +1311,7 @@ void nsHtml5StreamParser::DoStopRequest() {
         return;
       }
       mLastBuffer = (mLastBuffer->next = std::move(newBuf));
+      mLastBufferCapacity = READ_BUFFER_SIZE;
     } else {
       if (mDecodingLocalFileWithoutTokenizing) {
         MOZ_ASSERT(mLocalFileBytesBuffered < LOCAL_FILE_UTF_8_BUFFER_SIZE);
@@ -1749,6 +1764,20 @@ void nsHtml5StreamParser::ParseAvailableData() {
         MarkAsBroken(rv);
         return;
       }
+      // If the tokenizer has discovered a batch of speculative loads, stage
+      // them and wake up the main thread right away rather than waiting for
+      // the available data to run out, so that on large documents resource
+      // fetches start while tokenization is still catching up. A single
+      // dispatch covers the whole accumulated batch, so the main thread
+      // opens the channels in one burst.
+      if (mTreeBuilder->PendingSpeculativeLoadCount() >=
+          kSpeculativeLoadFlushBatch) {
+        mTreeBuilder->FlushLoads();
+        nsCOMPtr<nsIRunnable> runnable(mLoadFlusher);
+        if (NS_FAILED(DispatchToMain(runnable.forget()))) {
+          NS_WARNING("failed to dispatch load flush event");
+        }
+      }
       // At this point, internalEncodingDeclaration() may have called
       // Terminate, but that never happens together with script.
       // Can't assert that here, though, because it's possible that the main
@@ -134,8 +134,16 @@ class nsHtml5StreamParser final : public nsISupports {
 
   const uint32_t SNIFFING_BUFFER_SIZE = 1024;
   const uint32_t READ_BUFFER_SIZE = 1024;
+  // Largest UTF-16 buffer WriteStreamBytes() allocates when sizing a buffer
+  // to the remainder of an incoming network segment.
+  const uint32_t MAX_READ_BUFFER_SIZE = 16384;
   const uint32_t LOCAL_FILE_UTF_8_BUFFER_SIZE = 1024 * 1024 * 4;  // 4 MB
 
+  // How many speculative loads are allowed to accumulate during tokenization
+  // before they are staged and the main thread is woken up to open the
+  // channels, without waiting for the available data to run out first.
+  const size_t kSpeculativeLoadFlushBatch = 16;
+
   friend class nsHtml5RequestStopper;
   friend class nsHtml5DataAvailable;
   friend class nsHtml5StreamParserContinuation;
@@ -496,7 +504,14 @@ class nsHtml5StreamParser final : public nsISupports {
   nsHtml5OwningUTF16Buffer*
       mLastBuffer;  // weak ref; always points to
                     // a buffer of the size
-                    // NS_HTML5_STREAM_PARSER_READ_BUFFER_SIZE
+                    // mLastBufferCapacity
+
+  /**
+   * The allocated size of mLastBuffer in UTF-16 code units. Buffers are at
+   * least READ_BUFFER_SIZE but may be sized up to MAX_READ_BUFFER_SIZE to
+   * fit the rest of an incoming network segment.
+   */
+  uint32_t mLastBufferCapacity;
 
   /**
    * The tree operation executor
@@ -732,6 +732,22 @@ void nsHtml5TreeBuilder::appendCharacters(nsIContentHandle* aParent,
     return;
   }
 
+  if (mImportScanner.ShouldScan()) {
+    nsTArray<nsString> imports = mImportScanner.Scan(Span(aBuffer, aLength));
+    for (nsString& url : imports) {
+      mSpeculativeLoadQueue.AppendElement()->InitImportStyle(std::move(url));
+    }
+  }
+
+  // The tokenizer delivers a long run of text as a sequence of buffers, so
+  // try to merge this text into an already-queued append to the same node
+  // instead of queuing (and later applying) another tree op.
+  if (!mOpQueue.IsEmpty() &&
+      mOpQueue.LastElement().TryCoalesceAppendText(aParent, aBuffer,
+                                                   aLength)) {
+    return;
+  }
+
   auto bufferCopy = mozilla::MakeUniqueFallible<char16_t[]>(aLength);
   if (!bufferCopy) {
     // Just assigning mBroken instead of generating tree op. The caller
@@ -743,13 +759,6 @@ void nsHtml5TreeBuilder::appendCharacters(nsIContentHandle* aParent,
 
   memcpy(bufferCopy.get(), aBuffer, aLength * sizeof(char16_t));
 
-  if (mImportScanner.ShouldScan()) {
-    nsTArray<nsString> imports = mImportScanner.Scan(Span(aBuffer, aLength));
-    for (nsString& url : imports) {
-      mSpeculativeLoadQueue.AppendElement()->InitImportStyle(std::move(url));
-    }
-  }
-
   nsHtml5TreeOperation* treeOp = mOpQueue.AppendElement(mozilla::fallible);
   if (MOZ_UNLIKELY(!treeOp)) {
     MarkAsBrokenAndRequestSuspensionWithoutBuilder(NS_ERROR_OUT_OF_MEMORY);
@@ -104,6 +104,12 @@ bool Flush(bool aDiscretionary = false);
 
 void FlushLoads();
 
+/**
+ * Returns the number of speculative loads that have been discovered but not
+ * yet moved to the speculative load stage by FlushLoads().
+ */
+size_t PendingSpeculativeLoadCount() { return mSpeculativeLoadQueue.Length(); }
+
 void SetDocumentCharset(NotNull<const Encoding*> aEncoding,
                         int32_t aCharsetSource);
 
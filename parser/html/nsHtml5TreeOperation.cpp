@@ -6,8 +6,10 @@
 
 #include "nsHtml5TreeOperation.h"
 #include "mozAutoDocUpdate.h"
+#include "mozilla/CheckedInt.h"
 #include "mozilla/CycleCollectedJSContext.h"
 #include "mozilla/Likely.h"
+#include "mozilla/UniquePtrExtensions.h"
 #include "mozilla/dom/Comment.h"
 #include "mozilla/dom/CustomElementRegistry.h"
 #include "mozilla/dom/DocumentType.h"
@@ -205,6 +207,33 @@ nsHtml5TreeOperation::~nsHtml5TreeOperation() {
   mOperation.match(TreeOperationMatcher());
 }
 
+bool nsHtml5TreeOperation::TryCoalesceAppendText(nsIContentHandle* aParent,
+                                                 const char16_t* aBuffer,
+                                                 int32_t aLength) {
+  if (!mOperation.is<opAppendText>()) {
+    return false;
+  }
+  opAppendText& data = mOperation.as<opAppendText>();
+  if (data.mParent != static_cast<nsIContent**>(aParent)) {
+    return false;
+  }
+  mozilla::CheckedInt<int32_t> newLength(data.mLength);
+  newLength += aLength;
+  if (!newLength.isValid()) {
+    return false;
+  }
+  auto combined = mozilla::MakeUniqueFallible<char16_t[]>(newLength.value());
+  if (!combined) {
+    return false;
+  }
+  memcpy(combined.get(), data.mBuffer, data.mLength * sizeof(char16_t));
+  memcpy(combined.get() + data.mLength, aBuffer, aLength * sizeof(char16_t));
+  delete[] data.mBuffer;
+  data.mBuffer = combined.release();
+  data.mLength = newLength.value();
+  return true;
+}
+
 nsresult nsHtml5TreeOperation::AppendTextToTextNode(
     const char16_t* aBuffer, uint32_t aLength, dom::Text* aTextNode,
     nsHtml5DocumentBuilder* aBuilder) {
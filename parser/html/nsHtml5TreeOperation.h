@@ -616,6 +616,18 @@ class nsHtml5TreeOperation final {
     mOperation = mozilla::AsVariant(data);
   }
 
+  /**
+   * If this operation is an opAppendText targeting aParent, replaces its
+   * buffer with one holding the old text followed by the aLength code units
+   * at aBuffer and returns true, so that a run of character tokens becomes a
+   * single text append on the main thread instead of a chain of small ones.
+   * Otherwise returns false and leaves this operation unchanged. (Also
+   * returns false if allocating the combined buffer fails, in which case the
+   * caller should queue a separate operation as usual.)
+   */
+  bool TryCoalesceAppendText(nsIContentHandle* aParent, const char16_t* aBuffer,
+                             int32_t aLength);
+
   nsresult Perform(nsHtml5TreeOpExecutor* aBuilder, nsIContent** aScriptElement,
                    bool* aInterrupted, bool* aStreamEnded);
 
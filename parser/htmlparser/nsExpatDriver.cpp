@@ -50,6 +50,13 @@ static mozilla::LazyLogModule gExpatDriverLog("expatdriver");
 // https://chromium.googlesource.com/chromium/src/+/f464165c1dedff1c955d3c051c5a9a1c6a0e8f6b/third_party/WebKit/Source/core/xml/parser/XMLDocumentParser.cpp#85).
 static const uint16_t sMaxXMLTreeDepth = 5000;
 
+// Cap on the number of UTF-16 code units of the current line that we keep
+// around for error reporting. Machine-generated XML is often a single line
+// of megabytes of markup, and without a cap the "last line" snapshot is
+// appended to on every chunk and grows to the size of the whole document,
+// even though parsing succeeds and the snapshot is thrown away.
+static const uint32_t sMaxLastLineLength = 4096;
+
 /***************************** EXPAT CALL BACKS ******************************/
 // The callback handlers that get called from the expat parser.
 
@@ -728,11 +735,13 @@ static nsresult AppendErrorPointer(const int32_t aColNumber,
                                    nsString& aSourceString) {
   aSourceString.Append(char16_t('\n'));
 
-  // Last character will be '^'.
+  // Last character will be '^'. The source line may have been truncated to
+  // sMaxLastLineLength, in which case the error column can point past its
+  // end; stop at the end of what we kept.
   int32_t last = aColNumber - 1;
   int32_t i;
   uint32_t minuses = 0;
-  for (i = 0; i < last; ++i) {
+  for (i = 0; i < last && aSourceLine[i]; ++i) {
     if (aSourceLine[i] == '\t') {
       // Since this uses |white-space: pre;| a tab stop equals 8 spaces.
       uint32_t add = 8 - (minuses % 8);
@@ -1010,17 +1019,23 @@ nsExpatDriver::ConsumeToken(nsScanner& aScanner, bool& aFlushTokens) {
       if (lastLineLength <= consumed) {
         // The length of the last line was less than what expat consumed, so
         // there was at least one line break in the consumed data. Store the
-        // last line until the point where we stopped parsing.
+        // last line until the point where we stopped parsing, truncated to
+        // sMaxLastLineLength.
         nsScannerIterator startLastLine = currentExpatPosition;
         startLastLine.advance(-((ptrdiff_t)lastLineLength));
-        if (!CopyUnicodeTo(startLastLine, currentExpatPosition, mLastLine)) {
+        nsScannerIterator endLastLine = startLastLine;
+        endLastLine.advance((ptrdiff_t)std::min(
+            (uint32_t)lastLineLength, sMaxLastLineLength));
+        if (!CopyUnicodeTo(startLastLine, endLastLine, mLastLine)) {
           return (mInternalState = NS_ERROR_OUT_OF_MEMORY);
         }
-      } else {
+      } else if (mLastLine.Length() < sMaxLastLineLength) {
         // There was no line break in the consumed data, append the consumed
-        // data.
-        if (!AppendUnicodeTo(oldExpatPosition, currentExpatPosition,
-                             mLastLine)) {
+        // data until the stored line reaches sMaxLastLineLength.
+        nsScannerIterator endAppend = oldExpatPosition;
+        endAppend.advance((ptrdiff_t)std::min(
+            consumed, sMaxLastLineLength - mLastLine.Length()));
+        if (!AppendUnicodeTo(oldExpatPosition, endAppend, mLastLine)) {
           return (mInternalState = NS_ERROR_OUT_OF_MEMORY);
         }
       }
@@ -1048,19 +1063,21 @@ nsExpatDriver::ConsumeToken(nsScanner& aScanner, bool& aFlushTokens) {
         NS_ASSERTION(mInternalState == NS_ERROR_HTMLPARSER_STOPPARSING,
                      "Unexpected error");
 
-        // Look for the next newline after the last one we consumed
+        // Look for the next newline after the last one we consumed, but
+        // don't grow the stored line past sMaxLastLineLength.
         nsScannerIterator lastLine = currentExpatPosition;
-        while (lastLine != end) {
+        while (lastLine != end && mLastLine.Length() < sMaxLastLineLength) {
           length = uint32_t(lastLine.size_forward());
+          uint32_t cap = sMaxLastLineLength - mLastLine.Length();
           uint32_t endOffset = 0;
           const char16_t* buffer = lastLine.get();
-          while (endOffset < length && buffer[endOffset] != '\n' &&
-                 buffer[endOffset] != '\r') {
+          while (endOffset < length && endOffset < cap &&
+                 buffer[endOffset] != '\n' && buffer[endOffset] != '\r') {
             ++endOffset;
           }
           mLastLine.Append(Substring(buffer, buffer + endOffset));
           if (endOffset < length) {
-            // We found a newline.
+            // We found a newline or hit the cap.
             break;
           }
 
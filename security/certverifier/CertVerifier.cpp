@@ -25,6 +25,7 @@
 #include "nsPromiseFlatString.h"
 #include "nsServiceManagerUtils.h"
 #include "pk11pub.h"
+#include "prtime.h"
 #include "mozpkix/pkix.h"
 #include "mozpkix/pkixnss.h"
 #include "mozpkix/pkixutil.h"
@@ -897,6 +898,231 @@ static bool CertIsSelfSigned(const UniqueCERTCertificate& cert, void* pinarg) {
   return rv == Success;
 }
 
+CertVerifier::VerifiedChainCache::VerifiedChainCache()
+    : mMutex("CertVerifier::VerifiedChainCache") {}
+
+bool CertVerifier::VerifiedChainCache::Get(
+    const SHA384Buffer& aKeyHash,
+    /*out*/ nsTArray<nsTArray<uint8_t>>& aChainDERs,
+    /*out*/ SECOidTag& aEvOidPolicy) {
+  MutexAutoLock lock(mMutex);
+  for (size_t i = 0; i < mEntries.length(); i++) {
+    if (memcmp(mEntries[i]->mKeyHash, aKeyHash, SHA384_LENGTH) != 0) {
+      continue;
+    }
+    UniquePtr<Entry> entry = std::move(mEntries[i]);
+    mEntries.erase(mEntries.begin() + i);
+    aChainDERs.Clear();
+    for (const auto& certDER : entry->mChainDERs) {
+      aChainDERs.AppendElement()->AppendElements(certDER.Elements(),
+                                                 certDER.Length());
+    }
+    aEvOidPolicy = entry->mEvOidPolicy;
+    // Move the entry to the end, since the most recently used entries are at
+    // the end.
+    Unused << mEntries.append(std::move(entry));
+    return true;
+  }
+  return false;
+}
+
+void CertVerifier::VerifiedChainCache::Put(
+    const SHA384Buffer& aKeyHash, nsTArray<nsTArray<uint8_t>>&& aChainDERs,
+    SECOidTag aEvOidPolicy) {
+  MutexAutoLock lock(mMutex);
+  for (size_t i = 0; i < mEntries.length(); i++) {
+    if (memcmp(mEntries[i]->mKeyHash, aKeyHash, SHA384_LENGTH) == 0) {
+      // Another thread verified the same inputs concurrently; the results
+      // are equivalent, so just refresh the entry's position.
+      UniquePtr<Entry> entry = std::move(mEntries[i]);
+      mEntries.erase(mEntries.begin() + i);
+      Unused << mEntries.append(std::move(entry));
+      return;
+    }
+  }
+  if (mEntries.length() == MaxEntries) {
+    // The least recently used entry is at the front.
+    mEntries.erase(mEntries.begin());
+  }
+  UniquePtr<Entry> entry = MakeUnique<Entry>();
+  memcpy(entry->mKeyHash, aKeyHash, SHA384_LENGTH);
+  entry->mChainDERs = std::move(aChainDERs);
+  entry->mEvOidPolicy = aEvOidPolicy;
+  Unused << mEntries.append(std::move(entry));
+}
+
+void CertVerifier::VerifiedChainCache::Clear() {
+  MutexAutoLock lock(mMutex);
+  mEntries.clear();
+}
+
+static SECStatus DigestLength(UniquePK11Context& context, uint32_t length) {
+  // Restrict length to 2 bytes because it should be big enough for all
+  // inputs this code will actually see and that it is well-defined and
+  // type-size-independent.
+  if (length >= 65536) {
+    return SECFailure;
+  }
+  unsigned char array[2];
+  array[0] = length & 255;
+  array[1] = (length >> 8) & 255;
+
+  return PK11_DigestOp(context.get(), array, MOZ_ARRAY_LENGTH(array));
+}
+
+// Hashes every input that can influence the result of VerifyCert into a key
+// for the verified chain cache. Each variable-length input is preceded by
+// its length so that two inputs cannot collide by shifting bytes between
+// them. Returning SECFailure just means the cache cannot be used for this
+// verification.
+static SECStatus HashVerificationKey(
+    const UniqueCERTCertificate& peerCert, const nsACString& hostname,
+    CertVerifier::Flags flags,
+    const Maybe<nsTArray<nsTArray<uint8_t>>>& extraCertificates,
+    const Maybe<nsTArray<uint8_t>>& stapledOCSPResponse,
+    const Maybe<nsTArray<uint8_t>>& sctsFromTLS,
+    const OriginAttributes& originAttributes,
+    /*out*/ SHA384Buffer& keyHash) {
+  UniquePK11Context context(PK11_CreateDigestContext(SEC_OID_SHA384));
+  if (!context) {
+    return SECFailure;
+  }
+  SECStatus srv = PK11_DigestBegin(context.get());
+  if (srv != SECSuccess) {
+    return srv;
+  }
+  srv = DigestLength(context, peerCert->derCert.len);
+  if (srv != SECSuccess) {
+    return srv;
+  }
+  srv = PK11_DigestOp(context.get(), peerCert->derCert.data,
+                      peerCert->derCert.len);
+  if (srv != SECSuccess) {
+    return srv;
+  }
+  srv = DigestLength(context, hostname.Length());
+  if (srv != SECSuccess) {
+    return srv;
+  }
+  srv = PK11_DigestOp(
+      context.get(),
+      BitwiseCast<const uint8_t*, const char*>(hostname.BeginReading()),
+      hostname.Length());
+  if (srv != SECSuccess) {
+    return srv;
+  }
+  // The defined flags all fit comfortably in 16 bits.
+  srv = DigestLength(context, flags);
+  if (srv != SECSuccess) {
+    return srv;
+  }
+  srv = DigestLength(context,
+                     extraCertificates ? extraCertificates->Length() : 0);
+  if (srv != SECSuccess) {
+    return srv;
+  }
+  if (extraCertificates) {
+    for (const auto& certDER : *extraCertificates) {
+      srv = DigestLength(context, certDER.Length());
+      if (srv != SECSuccess) {
+        return srv;
+      }
+      srv = PK11_DigestOp(context.get(), certDER.Elements(), certDER.Length());
+      if (srv != SECSuccess) {
+        return srv;
+      }
+    }
+  }
+  // Changed revocation evidence (a new stapled response or different SCTs)
+  // must change the key so that it gets evaluated by a full verification.
+  srv = DigestLength(context,
+                     stapledOCSPResponse ? stapledOCSPResponse->Length() : 0);
+  if (srv != SECSuccess) {
+    return srv;
+  }
+  if (stapledOCSPResponse) {
+    srv = PK11_DigestOp(context.get(), stapledOCSPResponse->Elements(),
+                        stapledOCSPResponse->Length());
+    if (srv != SECSuccess) {
+      return srv;
+    }
+  }
+  srv = DigestLength(context, sctsFromTLS ? sctsFromTLS->Length() : 0);
+  if (srv != SECSuccess) {
+    return srv;
+  }
+  if (sctsFromTLS) {
+    srv = PK11_DigestOp(context.get(), sctsFromTLS->Elements(),
+                        sctsFromTLS->Length());
+    if (srv != SECSuccess) {
+      return srv;
+    }
+  }
+  nsAutoCString suffix;
+  originAttributes.CreateSuffix(suffix);
+  srv = DigestLength(context, suffix.Length());
+  if (srv != SECSuccess) {
+    return srv;
+  }
+  srv = PK11_DigestOp(
+      context.get(),
+      BitwiseCast<const uint8_t*, const char*>(suffix.BeginReading()),
+      suffix.Length());
+  if (srv != SECSuccess) {
+    return srv;
+  }
+  // A coarse time bucket bounds how long a memoized verification can outlive
+  // newer revocation information: entries implicitly expire when the bucket
+  // rolls over.
+  static const uint64_t timeBucketSizeInSeconds = 600;
+  uint64_t timeBucket =
+      uint64_t(PR_Now() / PR_USEC_PER_SEC) / timeBucketSizeInSeconds;
+  unsigned char timeBucketBytes[8];
+  for (size_t i = 0; i < MOZ_ARRAY_LENGTH(timeBucketBytes); i++) {
+    timeBucketBytes[i] = (timeBucket >> (i * 8)) & 255;
+  }
+  srv = PK11_DigestOp(context.get(), timeBucketBytes,
+                      MOZ_ARRAY_LENGTH(timeBucketBytes));
+  if (srv != SECSuccess) {
+    return srv;
+  }
+  uint32_t outLen = 0;
+  srv = PK11_DigestFinal(context.get(), keyHash, &outLen, SHA384_LENGTH);
+  if (srv != SECSuccess) {
+    return srv;
+  }
+  if (outLen != SHA384_LENGTH) {
+    return SECFailure;
+  }
+  return SECSuccess;
+}
+
+// Rebuilds a CERTCertList from the cached DER encodings of a previously
+// verified chain.
+static Result BuildCertListFromDERs(
+    const nsTArray<nsTArray<uint8_t>>& chainDERs,
+    /*out*/ UniqueCERTCertList& builtChain) {
+  UniqueCERTCertList certList(CERT_NewCertList());
+  if (!certList) {
+    return Result::FATAL_ERROR_NO_MEMORY;
+  }
+  for (const auto& certDER : chainDERs) {
+    SECItem derItem = {siBuffer, const_cast<uint8_t*>(certDER.Elements()),
+                       static_cast<unsigned int>(certDER.Length())};
+    UniqueCERTCertificate cert(CERT_NewTempCertificate(
+        CERT_GetDefaultCertDB(), &derItem, nullptr, false, true));
+    if (!cert) {
+      return Result::ERROR_BAD_DER;
+    }
+    if (CERT_AddCertToListTail(certList.get(), cert.get()) != SECSuccess) {
+      return Result::FATAL_ERROR_NO_MEMORY;
+    }
+    Unused << cert.release();  // cert is now owned by certList.
+  }
+  builtChain = std::move(certList);
+  return Success;
+}
+
 Result CertVerifier::VerifySSLServerCert(
     const UniqueCERTCertificate& peerCert, Time time,
     /*optional*/ void* pinarg, const nsACString& hostname,
@@ -934,14 +1160,38 @@ Result CertVerifier::VerifySSLServerCert(
     return Result::ERROR_BAD_CERT_DOMAIN;
   }
 
+  // A memoized verification can replace the path building step (VerifyCert)
+  // entirely. Everything below that depends on the peer certificate and the
+  // hostname still runs on a cache hit. The telemetry out parameters are
+  // only filled in by a full verification; callers treat them as optional.
+  SHA384Buffer keyHash;
+  bool canUseCache =
+      HashVerificationKey(peerCert, hostname, flags, extraCertificates,
+                          stapledOCSPResponse, sctsFromTLS, originAttributes,
+                          keyHash) == SECSuccess;
+  bool cacheHit = false;
+  if (canUseCache) {
+    nsTArray<nsTArray<uint8_t>> cachedChainDERs;
+    if (mVerifiedChainCache.Get(keyHash, cachedChainDERs, evPolicyOidTag) &&
+        BuildCertListFromDERs(cachedChainDERs, builtChain) == Success) {
+      MOZ_LOG(gCertVerifierLog, LogLevel::Debug,
+              ("VerifySSLServerCert: using memoized chain for '%s'\n",
+               PromiseFlatCString(hostname).get()));
+      cacheHit = true;
+    }
+  }
+
   // CreateCertErrorRunnable assumes that CheckCertHostname is only called
   // if VerifyCert succeeded.
-  Result rv = VerifyCert(peerCert.get(), certificateUsageSSLServer, time,
-                         pinarg, PromiseFlatCString(hostname).get(), builtChain,
-                         flags, extraCertificates, stapledOCSPResponse,
-                         sctsFromTLS, originAttributes, &evPolicyOidTag,
-                         ocspStaplingStatus, keySizeStatus, sha1ModeResult,
-                         pinningTelemetryInfo, ctInfo, crliteLookupResult);
+  Result rv = Success;
+  if (!cacheHit) {
+    rv = VerifyCert(peerCert.get(), certificateUsageSSLServer, time, pinarg,
+                    PromiseFlatCString(hostname).get(), builtChain, flags,
+                    extraCertificates, stapledOCSPResponse, sctsFromTLS,
+                    originAttributes, &evPolicyOidTag, ocspStaplingStatus,
+                    keySizeStatus, sha1ModeResult, pinningTelemetryInfo, ctInfo,
+                    crliteLookupResult);
+  }
   if (rv != Success) {
     if (rv == Result::ERROR_UNKNOWN_ISSUER &&
         CertIsSelfSigned(peerCert, pinarg)) {
@@ -970,6 +1220,19 @@ Result CertVerifier::VerifySSLServerCert(
     return rv;
   }
 
+  if (!cacheHit && canUseCache) {
+    // Only successful verifications are memoized; failures must always be
+    // re-evaluated so that transient errors and overridable errors keep
+    // their existing behavior.
+    nsTArray<nsTArray<uint8_t>> chainDERs;
+    for (CERTCertListNode* node = CERT_LIST_HEAD(builtChain);
+         !CERT_LIST_END(node, builtChain); node = CERT_LIST_NEXT(node)) {
+      chainDERs.AppendElement()->AppendElements(node->cert->derCert.data,
+                                                node->cert->derCert.len);
+    }
+    mVerifiedChainCache.Put(keyHash, std::move(chainDERs), evPolicyOidTag);
+  }
+
   if (dcInfo) {
     rv = IsDelegatedCredentialAcceptable(*dcInfo, evPolicyOidTag);
     if (rv != Success) {
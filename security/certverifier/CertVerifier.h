@@ -230,6 +230,50 @@ class CertVerifier {
     TelemetryOnly = 1,
   };
 
+  // VerifiedChainCache memoizes recent successful SSL server certificate
+  // verifications so that repeated handshakes presenting the same inputs
+  // (typically CDN connections re-offering an identical chain) skip path
+  // building entirely. Entries are keyed on a SHA-384 hash over every input
+  // that can influence the verification result: the end-entity certificate,
+  // the hostname, the flags, any extra intermediates, the stapled OCSP
+  // response, the SCTs from the TLS extension, the origin attributes suffix
+  // and a coarse time bucket. Policy inputs (OCSP configuration, pinning
+  // mode, name matching mode, ...) need not be part of the key because a new
+  // CertVerifier - and thus a fresh cache - is created whenever they change.
+  // Only successful verifications are cached, and the time bucket bounds how
+  // long a memoized chain can outlive newer revocation information.
+  // VerifiedChainCache is thread-safe.
+  class VerifiedChainCache {
+   public:
+    VerifiedChainCache();
+
+    // Returns true and fills the chain's DER encodings and the EV policy OID
+    // if the given key hash is in the cache.
+    bool Get(const SHA384Buffer& aKeyHash,
+             /*out*/ nsTArray<nsTArray<uint8_t>>& aChainDERs,
+             /*out*/ SECOidTag& aEvOidPolicy);
+
+    // Caches a successful verification under the given key hash, evicting
+    // the least recently used entry when the cache is full.
+    void Put(const SHA384Buffer& aKeyHash,
+             nsTArray<nsTArray<uint8_t>>&& aChainDERs, SECOidTag aEvOidPolicy);
+
+    // Removes everything from the cache.
+    void Clear();
+
+   private:
+    struct Entry {
+      SHA384Buffer mKeyHash;
+      nsTArray<nsTArray<uint8_t>> mChainDERs;
+      SECOidTag mEvOidPolicy;
+    };
+
+    Mutex mMutex;
+    static const size_t MaxEntries = 128;
+    // Sorted with the most-recently-used entry at the end.
+    Vector<UniquePtr<Entry>> mEntries;
+  };
+
   CertVerifier(OcspDownloadConfig odc, OcspStrictConfig osc,
                mozilla::TimeDuration ocspTimeoutSoft,
                mozilla::TimeDuration ocspTimeoutHard,
@@ -241,7 +285,12 @@ class CertVerifier {
                const Vector<EnterpriseCert>& thirdPartyCerts);
   ~CertVerifier();
 
-  void ClearOCSPCache() { mOCSPCache.Clear(); }
+  void ClearOCSPCache() {
+    mOCSPCache.Clear();
+    // Memoized chains embed the revocation state that was current when they
+    // were verified, so they have to go too.
+    mVerifiedChainCache.Clear();
+  }
 
   const OcspDownloadConfig mOCSPDownloadConfig;
   const bool mOCSPStrict;
@@ -258,6 +307,7 @@ class CertVerifier {
 
  private:
   OCSPCache mOCSPCache;
+  VerifiedChainCache mVerifiedChainCache;
   // We keep a copy of the bytes of each third party root to own.
   Vector<EnterpriseCert> mThirdPartyCerts;
   // This is a reusable, precomputed list of Inputs corresponding to each root
@@ -253,9 +253,6 @@ Result<Ok, nsresult> StartupCache::LoadArchive() {
 
   MOZ_TRY(mCacheData.init(mFile));
   auto size = mCacheData.size();
-  if (CanPrefetchMemory()) {
-    StartPrefetchMemoryThread();
-  }
 
   uint32_t headerSize;
   if (size < sizeof(MAGIC) + sizeof(headerSize)) {
@@ -342,6 +339,10 @@ Result<Ok, nsresult> StartupCache::LoadArchive() {
 
   MMAP_FAULT_HANDLER_CATCH(Err(NS_ERROR_UNEXPECTED))
 
+  // Now that the table is populated, start decompressing its entries in the
+  // background, so they're hopefully ready by the time they're requested.
+  StartPrefetchMemoryThread();
+
   return Ok();
 }
 
@@ -353,6 +354,39 @@ bool StartupCache::HasEntry(const char* id) {
   return mTable.has(nsDependentCString(id));
 }
 
+Result<Ok, nsresult> StartupCache::DecompressEntry(
+    StartupCacheEntry& aEntry, LZ4FrameDecompressionContext* aContext) {
+  MOZ_ASSERT(mCacheData.initialized());
+  MOZ_ASSERT(!aEntry.mData);
+
+  size_t totalRead = 0;
+  size_t totalWritten = 0;
+  Span<const char> compressed = Span(
+      mCacheData.get<char>().get() + mCacheEntriesBaseOffset + aEntry.mOffset,
+      aEntry.mCompressedSize);
+  aEntry.mData = MakeUnique<char[]>(aEntry.mUncompressedSize);
+  Span<char> uncompressed = Span(aEntry.mData.get(), aEntry.mUncompressedSize);
+  MMAP_FAULT_HANDLER_BEGIN_BUFFER(uncompressed.Elements(),
+                                  uncompressed.Length())
+  bool finished = false;
+  while (!finished) {
+    auto result = aContext->Decompress(uncompressed.From(totalWritten),
+                                       compressed.From(totalRead));
+    if (NS_WARN_IF(result.isErr())) {
+      aEntry.mData = nullptr;
+      return Err(NS_ERROR_FAILURE);
+    }
+    auto decompressionResult = result.unwrap();
+    totalRead += decompressionResult.mSizeRead;
+    totalWritten += decompressionResult.mSizeWritten;
+    finished = decompressionResult.mFinished;
+  }
+
+  MMAP_FAULT_HANDLER_CATCH(Err(NS_ERROR_FAILURE))
+
+  return Ok();
+}
+
 nsresult StartupCache::GetBuffer(const char* id, const char** outbuf,
                                  uint32_t* length) {
   AUTO_PROFILER_LABEL("StartupCache::GetBuffer", OTHER);
@@ -371,56 +405,31 @@ nsresult StartupCache::GetBuffer(const char* id, const char** outbuf,
   }
 
   auto& value = p->value();
-  if (value.mData) {
-    label = Telemetry::LABELS_STARTUP_CACHE_REQUESTS::HitMemory;
-  } else {
-    if (!mCacheData.initialized()) {
-      return NS_ERROR_NOT_AVAILABLE;
-    }
-#ifdef DEBUG
-    // It should be impossible for a write to be pending here. This is because
-    // we just checked mCacheData.initialized(), and this is reset before
-    // writing to the cache. It's not re-initialized unless we call
-    // LoadArchive(), either from Init() (which must have already happened) or
-    // InvalidateCache(). InvalidateCache() locks the mutex, so a write can't be
-    // happening. Really, we want to MOZ_ASSERT(!mTableLock.IsLocked()) here,
-    // but there is no such method. So we hack around by attempting to gain the
-    // lock. This should always succeed; if it fails, someone's broken the
-    // assumptions.
-    if (!mTableLock.TryLock()) {
-      MOZ_ASSERT(false, "Could not gain mTableLock - should never happen!");
-      return NS_ERROR_NOT_AVAILABLE;
-    }
-    mTableLock.Unlock();
-#endif
+  bool decompressionFailed = false;
+  {
+    // The decompression thread may still be filling in entry data, so check
+    // and decompress under the table lock. Once that thread has finished and
+    // been joined, this lock is uncontended.
+    MutexAutoLock lock(mTableLock);
+    if (value.mData) {
+      label = Telemetry::LABELS_STARTUP_CACHE_REQUESTS::HitMemory;
+    } else {
+      if (!mCacheData.initialized()) {
+        return NS_ERROR_NOT_AVAILABLE;
+      }
 
-    size_t totalRead = 0;
-    size_t totalWritten = 0;
-    Span<const char> compressed = Span(
-        mCacheData.get<char>().get() + mCacheEntriesBaseOffset + value.mOffset,
-        value.mCompressedSize);
-    value.mData = MakeUnique<char[]>(value.mUncompressedSize);
-    Span<char> uncompressed = Span(value.mData.get(), value.mUncompressedSize);
-    MMAP_FAULT_HANDLER_BEGIN_BUFFER(uncompressed.Elements(),
-                                    uncompressed.Length())
-    bool finished = false;
-    while (!finished) {
-      auto result = mDecompressionContext->Decompress(
-          uncompressed.From(totalWritten), compressed.From(totalRead));
-      if (NS_WARN_IF(result.isErr())) {
-        value.mData = nullptr;
-        InvalidateCache();
-        return NS_ERROR_FAILURE;
+      decompressionFailed =
+          DecompressEntry(value, mDecompressionContext.get()).isErr();
+      if (!decompressionFailed) {
+        label = Telemetry::LABELS_STARTUP_CACHE_REQUESTS::HitDisk;
       }
-      auto decompressionResult = result.unwrap();
-      totalRead += decompressionResult.mSizeRead;
-      totalWritten += decompressionResult.mSizeWritten;
-      finished = decompressionResult.mFinished;
     }
-
-    MMAP_FAULT_HANDLER_CATCH(NS_ERROR_FAILURE)
-
-    label = Telemetry::LABELS_STARTUP_CACHE_REQUESTS::HitDisk;
+  }
+  if (decompressionFailed) {
+    // InvalidateCache() takes mTableLock itself, so this must happen outside
+    // the scope above.
+    InvalidateCache();
+    return NS_ERROR_FAILURE;
   }
 
   if (!value.mRequested) {
@@ -456,7 +465,8 @@ nsresult StartupCache::PutBuffer(const char* id, UniquePtr<char[]>&& inbuf,
     return NS_OK;
   }
   // Try to gain the table write lock. If the background task to write the
-  // cache is running, this will fail.
+  // cache is running, or the startup decompression thread is still going,
+  // this will fail.
   if (!mTableLock.TryLock()) {
     return NS_ERROR_NOT_AVAILABLE;
   }
@@ -659,6 +669,9 @@ void StartupCache::EnsureShutdownWriteComplete() {
   }
   // Otherwise, ensure the write happens. The timer should have been cancelled
   // already in MaybeInitShutdownWrite.
+  // Join the decompression thread first, so a failed TryLock below can only
+  // mean the write is happening away from the main thread.
+  WaitOnPrefetchThread();
   if (!mTableLock.TryLock()) {
     // Uh oh, we're writing away from the main thread. Wait to gain the lock,
     // to ensure the write completes.
@@ -700,9 +713,35 @@ void StartupCache::ThreadedPrefetch(void* aClosure) {
   StartupCache* startupCacheObj = static_cast<StartupCache*>(aClosure);
   uint8_t* buf = startupCacheObj->mCacheData.get<uint8_t>().get();
   size_t size = startupCacheObj->mCacheData.size();
-  MMAP_FAULT_HANDLER_BEGIN_BUFFER(buf, size)
-  PrefetchMemory(buf, size);
-  MMAP_FAULT_HANDLER_CATCH()
+  if (CanPrefetchMemory()) {
+    // Fault the whole mapping in sequentially first, which is much cheaper
+    // than having the decompression loop below fault pages in table order.
+    MMAP_FAULT_HANDLER_BEGIN_BUFFER(buf, size)
+    PrefetchMemory(buf, size);
+    MMAP_FAULT_HANDLER_CATCH()
+  }
+
+  // Decompress all entries while the main thread is busy with other startup
+  // work, so GetBuffer() calls find their data already inflated. The table
+  // lock is held for the whole loop: entry pointers aren't stable against
+  // insertions, and the main thread checks entry data under the same lock
+  // before decompressing an entry itself. Every path that resets mCacheData
+  // joins this thread first, so the mapping stays valid throughout.
+  LZ4FrameDecompressionContext context(true);
+  {
+    MutexAutoLock lock(startupCacheObj->mTableLock);
+    for (auto iter = startupCacheObj->mTable.iter(); !iter.done();
+         iter.next()) {
+      auto& value = iter.get().value();
+      if (!value.mData && value.mUncompressedSize) {
+        if (startupCacheObj->DecompressEntry(value, &context).isErr()) {
+          // Leave the remaining entries to the lazy path in GetBuffer(),
+          // which invalidates the cache on failure.
+          break;
+        }
+      }
+    }
+  }
   mozilla::IOInterposer::UnregisterCurrentThread();
 }
 
@@ -191,6 +191,13 @@ class StartupCache : public nsIMemoryReporter {
   Result<Ok, nsresult> LoadArchive();
   nsresult Init();
 
+  // Decompresses the entry's data from the cache file mapping into a freshly
+  // allocated mData buffer. The caller must hold mTableLock whenever the
+  // decompression thread may still be running.
+  Result<Ok, nsresult> DecompressEntry(
+      StartupCacheEntry& aEntry,
+      Compression::LZ4FrameDecompressionContext* aContext);
+
   // Returns a file pointer for the cache file with the given name in the
   // current profile.
   Result<nsCOMPtr<nsIFile>, nsresult> GetCacheFile(const nsAString& suffix);
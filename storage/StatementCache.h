@@ -65,6 +65,27 @@ class StatementCache {
     return GetCachedStatement(query);
   }
 
+  /**
+   * Compiles and caches a statement ahead of its first use, so the first
+   * GetCachedStatement call for it doesn't pay the compilation cost.  Useful
+   * to move the cost of known hot statements to a thread or time where the
+   * added latency matters less, for example right after the connection has
+   * been opened.
+   *
+   * @param aQuery
+   *        The SQL string (either a const char [] or nsACString) to
+   *        precompile and cache.
+   */
+  inline void WarmUpStatement(const nsACString& aQuery) {
+    nsCOMPtr<StatementType> stmt = GetCachedStatement(aQuery);
+  }
+
+  template <int N>
+  MOZ_ALWAYS_INLINE void WarmUpStatement(const char (&aQuery)[N]) {
+    nsDependentCString query(aQuery, N - 1);
+    WarmUpStatement(query);
+  }
+
   /**
    * Finalizes all cached statements so the database can be safely closed.  The
    * behavior of this cache is unspecified after this method is called.
@@ -12,6 +12,7 @@
 #include "mozilla/dom/quota/QuotaManager.h"
 #include "mozilla/dom/quota/QuotaObject.h"
 #include "mozilla/net/IOActivityMonitor.h"
+#include "mozilla/FileUtils.h"
 #include "mozilla/IOInterposer.h"
 #include "nsEscape.h"
 #include "mozilla/StaticPrefs_storage.h"
@@ -482,6 +483,23 @@ int xOpen(sqlite3_vfs* vfs, const char* zName, sqlite3_file* pFile, int flags,
   rc = orig_vfs->xOpen(orig_vfs, zName, p->pReal, flags, pOutFlags);
   if (rc != SQLITE_OK) return rc;
 
+  if (zName && (flags & SQLITE_OPEN_MAIN_DB)) {
+    // Ask the OS to pull the head of the database into its page cache in one
+    // sequential pass, so the first queries find the database header and the
+    // upper levels of the B-trees there instead of issuing many random
+    // page-sized reads, which is particularly expensive on rotational disks.
+    // SQLite still reads every page through xRead as usual.
+    uint32_t readAheadBytes =
+        StaticPrefs::storage_sqlite_readAheadOnOpen_maxBytes();
+    if (readAheadBytes > 0) {
+#if defined(XP_WIN)
+      ReadAheadFile(NS_ConvertUTF8toUTF16(zName).get(), 0, readAheadBytes);
+#else
+      ReadAheadFile(zName, 0, readAheadBytes);
+#endif
+    }
+  }
+
   if (zName) {
     p->location = new char[7 + strlen(zName) + 1];
     strcpy(p->location, "file://");
@@ -403,6 +403,39 @@ class AsyncInitializeClone final : public Runnable {
   nsCOMPtr<mozIStorageCompletionCallback> mCallback;
 };
 
+/**
+ * A completion callback wrapping AsyncPooledReadConnection requests. It drops
+ * the pooled clone from the pool again if its initialization failed, then
+ * forwards the result to the consumer's callback.
+ */
+class ReadPoolInitCallback final : public mozIStorageCompletionCallback {
+ public:
+  NS_DECL_ISUPPORTS
+
+  ReadPoolInitCallback(Connection* aOwner, Connection* aClone,
+                       mozIStorageCompletionCallback* aCallback)
+      : mOwner(aOwner), mClone(aClone), mCallback(aCallback) {
+    MOZ_ASSERT(NS_IsMainThread());
+  }
+
+  NS_IMETHOD Complete(nsresult aStatus, nsISupports* aValue) override {
+    MOZ_ASSERT(NS_IsMainThread());
+    if (NS_FAILED(aStatus)) {
+      mOwner->readPoolCloneFailed(mClone);
+    }
+    return mCallback->Complete(aStatus, aValue);
+  }
+
+ private:
+  ~ReadPoolInitCallback() = default;
+
+  RefPtr<Connection> mOwner;
+  RefPtr<Connection> mClone;
+  nsCOMPtr<mozIStorageCompletionCallback> mCallback;
+};
+
+NS_IMPL_ISUPPORTS(ReadPoolInitCallback, mozIStorageCompletionCallback)
+
 /**
  * A listener for async connection closing.
  */
@@ -436,6 +469,7 @@ Connection::Connection(Service* aService, int aFlags,
       sharedDBMutex("Connection::sharedDBMutex"),
       threadOpenedOn(do_GetCurrentThread()),
       mDBConn(nullptr),
+      mNextReadPoolIndex(0),
       mAsyncExecutionThreadShuttingDown(false),
       mConnectionClosed(false),
       mDefaultTransactionType(mozIStorageConnection::TRANSACTION_DEFERRED),
@@ -1356,6 +1390,14 @@ Connection::Close() {
   if (NS_FAILED(rv)) {
     return rv;
   }
+
+  // Close any pooled read-only clones we handed out; consumers were told not
+  // to close them themselves.
+  for (const RefPtr<Connection>& pooled : mReadPool) {
+    Unused << pooled->AsyncClose(nullptr);
+  }
+  mReadPool.Clear();
+
   return synchronousClose();
 }
 
@@ -1440,6 +1482,13 @@ Connection::AsyncClose(mozIStorageCompletionCallback* aCallback) {
     return rv;
   }
 
+  // Close any pooled read-only clones we handed out; consumers were told not
+  // to close them themselves.
+  for (const RefPtr<Connection>& pooled : mReadPool) {
+    Unused << pooled->AsyncClose(nullptr);
+  }
+  mReadPool.Clear();
+
   // The two relevant factors at this point are whether we have a database
   // connection and whether we have an async execution thread.  Here's what the
   // states mean and how we handle them:
@@ -1571,6 +1620,85 @@ Connection::AsyncClone(bool aReadOnly,
   return target->Dispatch(initEvent, NS_DISPATCH_NORMAL);
 }
 
+// The maximum number of read-only clones handed out by
+// AsyncPooledReadConnection. Each clone costs a helper thread and a page
+// cache, so the pool is deliberately small; queries beyond this level of
+// parallelism queue up behind each other as they do today.
+static const uint32_t kReadPoolMaxSize = 4;
+
+NS_IMETHODIMP
+Connection::AsyncPooledReadConnection(mozIStorageCompletionCallback* aCallback) {
+  AUTO_PROFILER_LABEL("Connection::AsyncPooledReadConnection", OTHER);
+
+  NS_ENSURE_TRUE(NS_IsMainThread(), NS_ERROR_NOT_SAME_THREAD);
+  NS_ENSURE_ARG(aCallback);
+  if (!connectionReady()) {
+    return NS_ERROR_NOT_INITIALIZED;
+  }
+  nsresult rv = ensureOperationSupported(ASYNCHRONOUS);
+  if (NS_FAILED(rv)) {
+    return rv;
+  }
+  if (!mDatabaseFile) {
+    return NS_ERROR_UNEXPECTED;
+  }
+  if (mFlags & SQLITE_OPEN_READONLY) {
+    // A read-only connection gains nothing from a read pool; its helper
+    // thread only ever services reads already.
+    return NS_ERROR_UNEXPECTED;
+  }
+
+  // Grow the pool until it is full; afterwards cycle through it.
+  if (mReadPool.Length() < kReadPoolMaxSize) {
+    // Turn off SQLITE_OPEN_READWRITE and SQLITE_OPEN_CREATE, and set
+    // SQLITE_OPEN_READONLY, as AsyncClone does for read-only clones.
+    int flags = (~SQLITE_OPEN_READWRITE & mFlags) | SQLITE_OPEN_READONLY;
+    flags = (~SQLITE_OPEN_CREATE & flags);
+
+    RefPtr<Connection> clone =
+        new Connection(mStorageService, flags, ASYNCHRONOUS);
+
+    RefPtr<ReadPoolInitCallback> callback =
+        new ReadPoolInitCallback(this, clone, aCallback);
+    RefPtr<AsyncInitializeClone> initEvent =
+        new AsyncInitializeClone(this, clone, /* aReadOnly */ true, callback);
+    // As in AsyncClone, initialize on our async thread so the originating
+    // connection stays open for the whole cloning process and we serialize
+    // properly with a `close` operation.
+    nsCOMPtr<nsIEventTarget> target = getAsyncExecutionTarget();
+    if (!target) {
+      return NS_ERROR_UNEXPECTED;
+    }
+    rv = target->Dispatch(initEvent, NS_DISPATCH_NORMAL);
+    NS_ENSURE_SUCCESS(rv, rv);
+
+    mReadPool.AppendElement(clone);
+    return NS_OK;
+  }
+
+  if (mNextReadPoolIndex >= mReadPool.Length()) {
+    mNextReadPoolIndex = 0;
+  }
+  RefPtr<Connection> pooled = mReadPool[mNextReadPoolIndex];
+  mNextReadPoolIndex = (mNextReadPoolIndex + 1) % mReadPool.Length();
+
+  // Notify asynchronously, so the callback is invoked the same way whether
+  // the pooled connection had to be created or not.
+  nsCOMPtr<mozIStorageCompletionCallback> callback = aCallback;
+  return NS_DispatchToMainThread(NS_NewRunnableFunction(
+      "Connection::AsyncPooledReadConnection callback",
+      [pooled, callback]() {
+        Unused << callback->Complete(
+            NS_OK,
+            NS_ISUPPORTS_CAST(mozIStorageAsyncConnection*, pooled.get()));
+      }));
+}
+
+void Connection::readPoolCloneFailed(Connection* aClone) {
+  MOZ_ASSERT(NS_IsMainThread());
+  mReadPool.RemoveElement(aClone);
+}
+
 nsresult Connection::initializeClone(Connection* aClone, bool aReadOnly) {
   nsresult rv;
   if (!mStorageKey.IsEmpty()) {
@@ -306,6 +306,14 @@ class Connection final : public mozIStorageConnection,
 
   nsresult initializeClone(Connection* aClone, bool aReadOnly);
 
+  /**
+   * Drops a clone handed out by AsyncPooledReadConnection from the pool
+   * again because its initialization failed.
+   *
+   * This must be called from the opener thread.
+   */
+  void readPoolCloneFailed(Connection* aClone);
+
   /**
    * Records a status from a sqlite statement.
    *
@@ -400,6 +408,22 @@ class Connection final : public mozIStorageConnection,
    */
   nsCOMPtr<nsIThread> mAsyncExecutionThread;
 
+  /**
+   * Read-only clones handed out by AsyncPooledReadConnection, in round-robin
+   * order. We own these and close them when this connection is closed.
+   *
+   * This must be accessed only on the opener thread.
+   */
+  nsTArray<RefPtr<Connection>> mReadPool;
+
+  /**
+   * The pool slot AsyncPooledReadConnection hands out next once the pool is
+   * full.
+   *
+   * This must be accessed only on the opener thread.
+   */
+  uint32_t mNextReadPoolIndex;
+
   /**
    * Set to true by Close() or AsyncClose() prior to shutdown.
    *
@@ -67,6 +67,28 @@ TYPED_TEST(storage_StatementCache, GetCachedStatement) {
   do_check_eq(stmt.get(), stmt2.get());
 }
 
+TYPED_TEST_CASE(storage_StatementCache, TwoStringTypes);
+TYPED_TEST(storage_StatementCache, WarmUpStatement) {
+  nsCOMPtr<mozIStorageConnection> db(getMemoryDatabase());
+  SyncCache cache(db);
+
+  TypeParam sql = "SELECT * FROM sqlite_master";
+
+  // Warming up should compile and cache the statement...
+  cache.WarmUpStatement(sql);
+
+  // ... so asking for it afterwards hands out the cached copy.
+  nsCOMPtr<mozIStorageStatement> stmt = cache.GetCachedStatement(sql);
+  do_check_true(stmt);
+  int32_t state;
+  do_check_success(stmt->GetState(&state));
+  do_check_eq(mozIStorageBaseStatement::MOZ_STORAGE_STATEMENT_READY, state);
+
+  nsCOMPtr<mozIStorageStatement> stmt2 = cache.GetCachedStatement(sql);
+  do_check_true(stmt2);
+  do_check_eq(stmt.get(), stmt2.get());
+}
+
 TYPED_TEST_CASE(storage_StatementCache, TwoStringTypes);
 TYPED_TEST(storage_StatementCache, FinalizeStatements) {
   nsCOMPtr<mozIStorageConnection> db(getMemoryDatabase());
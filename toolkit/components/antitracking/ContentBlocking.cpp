@@ -7,9 +7,14 @@
 #include "AntiTrackingLog.h"
 #include "ContentBlocking.h"
 #include "AntiTrackingUtils.h"
+#include "SettingsChangeObserver.h"
 #include "TemporaryAccessGrantObserver.h"
 
+#include "mozilla/ClearOnShutdown.h"
 #include "mozilla/ContentBlockingAllowList.h"
+#include "mozilla/HashFunctions.h"
+#include "mozilla/MruCache.h"
+#include "mozilla/StaticPtr.h"
 #include "mozilla/ContentBlockingUserInteraction.h"
 #include "mozilla/dom/BrowsingContext.h"
 #include "mozilla/dom/BrowsingContextGroup.h"
@@ -50,6 +55,62 @@ using mozilla::net::CookieJarSettings;
 
 namespace {
 
+// Memoizes the most recent ShouldAllowAccessFor(window) decisions. The same
+// document asks the same question for every storage consumer and subresource
+// in its request waterfall, and the answer only changes when a permission or
+// one of the anti-tracking prefs changes, which SettingsChangeObserver
+// watches for us; storage access grants propagated to this process clear the
+// cache explicitly. Entries are keyed on the inner window ID rather than a
+// pointer, so entries for dead windows are merely unreachable, not dangling.
+struct StorageDecision {
+  uint64_t mWindowID = 0;
+  nsCString mThirdPartyOrigin;
+  bool mAllowed = false;
+  uint32_t mRejectedReason = 0;
+};
+
+struct StorageDecisionKey {
+  uint64_t mWindowID;
+  const nsACString& mThirdPartyOrigin;
+};
+
+class StorageDecisionCache
+    : public MruCache<StorageDecisionKey, StorageDecision,
+                      StorageDecisionCache> {
+ public:
+  static HashNumber Hash(const StorageDecisionKey& aKey) {
+    return AddToHash(HashGeneric(aKey.mWindowID),
+                     HashString(aKey.mThirdPartyOrigin));
+  }
+  static bool Match(const StorageDecisionKey& aKey,
+                    const StorageDecision& aVal) {
+    return aVal.mWindowID == aKey.mWindowID &&
+           aVal.mThirdPartyOrigin.Equals(aKey.mThirdPartyOrigin);
+  }
+};
+
+StaticAutoPtr<StorageDecisionCache> gStorageDecisionCache;
+
+StorageDecisionCache* GetStorageDecisionCache() {
+  MOZ_ASSERT(NS_IsMainThread());
+  if (!gStorageDecisionCache) {
+    gStorageDecisionCache = new StorageDecisionCache();
+    ClearOnShutdown(&gStorageDecisionCache);
+    SettingsChangeObserver::OnAntiTrackingSettingsChanged([]() {
+      if (gStorageDecisionCache) {
+        gStorageDecisionCache->Clear();
+      }
+    });
+  }
+  return gStorageDecisionCache;
+}
+
+void ClearStorageDecisionCache() {
+  if (gStorageDecisionCache) {
+    gStorageDecisionCache->Clear();
+  }
+}
+
 bool GetTopLevelWindowId(BrowsingContext* aParentContext, uint32_t aBehavior,
                          uint64_t& aTopLevelInnerWindowId) {
   MOZ_ASSERT(aParentContext);
@@ -583,6 +644,10 @@ ContentBlocking::CompleteAllowAccessFor(
     ContentBlockingNotifier::StorageAccessPermissionGrantedReason aReason) {
   MOZ_ASSERT(aParentContext->IsInProcess());
 
+  // The new grant changes the answer ShouldAllowAccessFor gives for the
+  // affected windows; drop the memoized decisions in this process.
+  ClearStorageDecisionCache();
+
   // Let's inform the parent window and the other windows having the
   // same tracking origin about the stroage permission is granted.
   ContentBlocking::UpdateAllowAccessOnCurrentProcess(aParentContext,
@@ -858,18 +923,11 @@ void ContentBlocking::UpdateAllowAccessOnParentProcess(
   }
 }
 
-bool ContentBlocking::ShouldAllowAccessFor(nsPIDOMWindowInner* aWindow,
-                                           nsIURI* aURI,
-                                           uint32_t* aRejectedReason) {
-  MOZ_ASSERT(aWindow);
-  MOZ_ASSERT(aURI);
-
-  // Let's avoid a null check on aRejectedReason everywhere else.
-  uint32_t rejectedReason = 0;
-  if (!aRejectedReason) {
-    aRejectedReason = &rejectedReason;
-  }
-
+// The uncached part of ShouldAllowAccessFor(window); aRejectedReason must be
+// non-null here.
+static bool ShouldAllowAccessForWindowInternal(nsPIDOMWindowInner* aWindow,
+                                               nsIURI* aURI,
+                                               uint32_t* aRejectedReason) {
   LOG_SPEC(("Computing whether window %p has access to URI %s", aWindow, _spec),
            aURI);
 
@@ -1027,6 +1085,50 @@ bool ContentBlocking::ShouldAllowAccessFor(nsPIDOMWindowInner* aWindow,
   return allowed;
 }
 
+bool ContentBlocking::ShouldAllowAccessFor(nsPIDOMWindowInner* aWindow,
+                                           nsIURI* aURI,
+                                           uint32_t* aRejectedReason) {
+  MOZ_ASSERT(aWindow);
+  MOZ_ASSERT(aURI);
+
+  // Let's avoid a null check on aRejectedReason everywhere else.
+  uint32_t rejectedReason = 0;
+  if (!aRejectedReason) {
+    aRejectedReason = &rejectedReason;
+  }
+
+  nsAutoCString origin;
+  StorageDecisionCache* cache = nullptr;
+  if (NS_SUCCEEDED(nsContentUtils::GetASCIIOrigin(aURI, origin))) {
+    cache = GetStorageDecisionCache();
+  }
+
+  if (cache) {
+    auto entry = cache->Lookup(StorageDecisionKey{aWindow->WindowID(), origin});
+    if (entry) {
+      *aRejectedReason = entry.Data().mRejectedReason;
+      LOG(("Found memoized %s decision for origin %s",
+           entry.Data().mAllowed ? "allow" : "block", origin.get()));
+      return entry.Data().mAllowed;
+    }
+  }
+
+  bool allowed =
+      ShouldAllowAccessForWindowInternal(aWindow, aURI, aRejectedReason);
+
+  if (cache) {
+    StorageDecision decision;
+    decision.mWindowID = aWindow->WindowID();
+    decision.mThirdPartyOrigin = origin;
+    decision.mAllowed = allowed;
+    decision.mRejectedReason = *aRejectedReason;
+    cache->Put(StorageDecisionKey{aWindow->WindowID(), origin},
+               std::move(decision));
+  }
+
+  return allowed;
+}
+
 bool ContentBlocking::ShouldAllowAccessFor(nsIChannel* aChannel, nsIURI* aURI,
                                            uint32_t* aRejectedReason) {
   MOZ_ASSERT(aURI);
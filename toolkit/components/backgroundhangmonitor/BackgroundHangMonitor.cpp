@@ -550,6 +550,19 @@ void BackgroundHangThread::ReportHang(TimeDuration aHangTime,
                         {MarkerThreadId(mStackHelper.GetThreadId()),
                          MarkerTiming::Interval(startTime, endTime)},
                         HangMarker{});
+
+    // When the profiler runs in the lightweight marker-only mode, a detected
+    // hang is the signal to dump the flight recorder: if
+    // MOZ_PROFILER_LIGHTWEIGHT names a file, save the marker buffer there so
+    // the events leading up to the hang can be diagnosed. Single-character
+    // values only toggle the mode.
+    const char* lightweightEnv = getenv("MOZ_PROFILER_LIGHTWEIGHT");
+    if (lightweightEnv && strlen(lightweightEnv) > 1) {
+      nsCString filename(lightweightEnv);
+      NS_DispatchToMainThread(NS_NewRunnableFunction(
+          "BackgroundHangThread::ReportHang profile dump",
+          [filename] { profiler_save_profile_to_file(filename.get()); }));
+    }
   }
 #endif
 }
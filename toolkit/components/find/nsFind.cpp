@@ -647,6 +647,30 @@ nsFind::Find(const nsAString& aPatText, nsRange* aSearchRange,
   State state(mFindBackward, *root, *aStartPoint);
   Text* current = nullptr;
 
+  // When searching forwards, precompute which Latin-1 code points can match
+  // the first character of the pattern, so that the main loop can skip
+  // through 8-bit text fragments without folding and comparing one character
+  // per iteration. A space in the pattern matches any whitespace.
+  bool firstCharLatin1[256];
+  if (!mFindBackward) {
+    int32_t pi = 0;
+    const char32_t patFirst = DecodeChar(patStr, &pi);
+    for (uint32_t i = 0; i < 256; ++i) {
+      char32_t ch = CHAR_TO_UNICHAR(char(i));
+      if (IsSpace(patFirst)) {
+        firstCharLatin1[i] = IsSpace(ch);
+        continue;
+      }
+      if (!mCaseSensitive) {
+        ch = ToFoldedCase(ch);
+      }
+      if (!mMatchDiacritics) {
+        ch = ToNaked(ch);
+      }
+      firstCharLatin1[i] = ch == patFirst;
+    }
+  }
+
   auto EndPartialMatch = [&]() -> bool {
     bool hadAnchorNode = !!matchAnchorNode;
     // If we didn't match, go back to the beginning of patStr, and set findex
@@ -774,6 +798,35 @@ nsFind::Find(const nsAString& aPatText, nsRange* aSearchRange,
       return NS_OK;
     }
 
+    // With no partial match under way, skip ahead through 8-bit text to the
+    // next character that can start a match. (pindex can be nonzero without
+    // an anchor node when a match was rejected by the word breaker, so check
+    // both.)
+    if (t1b && !mFindBackward && !matchAnchorNode && pindex == 0 &&
+        !inWhitespace && !firstCharLatin1[uint8_t(t1b[findex])]) {
+      int32_t skipEnd = fragLen;
+      if (state.GetCurrentNode() == endNode &&
+          static_cast<int32_t>(endOffset) + 1 < skipEnd) {
+        skipEnd = static_cast<int32_t>(endOffset) + 1;
+      }
+      int32_t next = findex + 1;
+      while (next < skipEnd && !firstCharLatin1[uint8_t(t1b[next])]) {
+        ++next;
+      }
+      // Leave findex on the last skipped character; the top of the loop
+      // advances it again. Keep c in sync so that word boundary detection
+      // sees the right previous character.
+      findex = next - 1;
+      c = CHAR_TO_UNICHAR(t1b[findex]);
+      if (!mCaseSensitive) {
+        c = ToFoldedCase(c);
+      }
+      if (!mMatchDiacritics) {
+        c = ToNaked(c);
+      }
+      continue;
+    }
+
     // Save the previous character for word boundary detection
     char32_t prevChar = c;
     // The two characters we'll be comparing are c and patc. If not matching
@@ -162,12 +162,15 @@ enum FindInStringBehavior { eFindOnBoundary, eFindAnywhere };
  *        eFindOnBoundary if we should only consider matchines which occur on
  *        word boundaries, or eFindAnywhere if we should consider matches
  *        which appear anywhere.
+ * @param aMatchDiacritics
+ *        Whether or not the match is diacritic-sensitive.
  *
  * @return true if aToken was found in aSourceString, false otherwise.
  */
 static bool findInString(const nsDependentCSubstring& aToken,
                          const nsACString& aSourceString,
-                         FindInStringBehavior aBehavior) {
+                         FindInStringBehavior aBehavior,
+                         bool aMatchDiacritics) {
   // GetLowerUTF8Codepoint assumes that there's at least one byte in
   // the string, so don't pass an empty token here.
   MOZ_ASSERT(!aToken.IsEmpty(), "Don't search for an empty token!");
@@ -177,9 +180,6 @@ static bool findInString(const nsDependentCSubstring& aToken,
     return false;
   }
 
-  const nsNavHistory* history = nsNavHistory::GetConstHistoryService();
-  bool matchDiacritics = history && history->MatchDiacritics();
-
   const_char_iterator tokenStart(aToken.BeginReading()),
       tokenEnd(aToken.EndReading()), tokenNext,
       sourceStart(aSourceString.BeginReading()),
@@ -190,12 +190,12 @@ static bool findInString(const nsDependentCSubstring& aToken,
   if (tokenFirstChar == uint32_t(-1)) {
     return false;
   }
-  if (!matchDiacritics) {
+  if (!aMatchDiacritics) {
     tokenFirstChar = ToNaked(tokenFirstChar);
   }
 
   for (;;) {
-    if (matchDiacritics) {
+    if (aMatchDiacritics) {
       // Scan forward to the next viable candidate (if any).
       goToNextSearchCandidate(sourceCur, sourceEnd, tokenFirstChar);
     }
@@ -211,7 +211,7 @@ static bool findInString(const nsDependentCSubstring& aToken,
     if (sourceFirstChar == uint32_t(-1)) {
       return false;
     }
-    if (!matchDiacritics) {
+    if (!aMatchDiacritics) {
       sourceFirstChar = ToNaked(sourceFirstChar);
     }
 
@@ -219,7 +219,7 @@ static bool findInString(const nsDependentCSubstring& aToken,
         (aBehavior != eFindOnBoundary || sourceCur == sourceStart ||
          isOnBoundary(sourceCur)) &&
         stringMatch(tokenNext, tokenEnd, sourceNext, sourceEnd,
-                    matchDiacritics)) {
+                    aMatchDiacritics)) {
       return true;
     }
 
@@ -389,16 +389,19 @@ nsDependentCSubstring MatchAutoCompleteFunction::fixupURISpec(
 
 /* static */
 bool MatchAutoCompleteFunction::findAnywhere(
-    const nsDependentCSubstring& aToken, const nsACString& aSourceString) {
+    const nsDependentCSubstring& aToken, const nsACString& aSourceString,
+    bool aMatchDiacritics) {
   // We can't use FindInReadable here; it works only for ASCII.
 
-  return findInString(aToken, aSourceString, eFindAnywhere);
+  return findInString(aToken, aSourceString, eFindAnywhere, aMatchDiacritics);
 }
 
 /* static */
 bool MatchAutoCompleteFunction::findOnBoundary(
-    const nsDependentCSubstring& aToken, const nsACString& aSourceString) {
-  return findInString(aToken, aSourceString, eFindOnBoundary);
+    const nsDependentCSubstring& aToken, const nsACString& aSourceString,
+    bool aMatchDiacritics) {
+  return findInString(aToken, aSourceString, eFindOnBoundary,
+                      aMatchDiacritics);
 }
 
 /* static */
@@ -494,25 +497,41 @@ MatchAutoCompleteFunction::OnFunctionCall(mozIStorageValueArray* aArguments,
   const nsDependentCSubstring& trimmedTitle =
       Substring(title, 0, MAX_CHARS_TO_SEARCH_THROUGH);
 
+  // The match is diacritic-insensitive unless the preference says otherwise.
+  // Look the preference up once per row rather than once per searched string.
+  const nsNavHistory* history = nsNavHistory::GetConstHistoryService();
+  bool matchDiacritics = history && history->MatchDiacritics();
+
+  // The search string is the same for every row the function is invoked on
+  // during a query, so only re-tokenize it when it changes.
+  if (!mCachedSearchString.Equals(searchString)) {
+    mCachedSearchString = searchString;
+    mCachedSearchTokens.ClearAndRetainStorage();
+    nsCWhitespaceTokenizer tokenizer(mCachedSearchString);
+    while (tokenizer.hasMoreTokens()) {
+      mCachedSearchTokens.AppendElement(tokenizer.nextToken());
+    }
+  }
+
   // Determine if every token matches either the bookmark title, tags, page
   // title, or page URL.
-  nsCWhitespaceTokenizer tokenizer(searchString);
-  while (matches && tokenizer.hasMoreTokens()) {
-    const nsDependentCSubstring& token = tokenizer.nextToken();
+  for (uint32_t i = 0; matches && i < mCachedSearchTokens.Length(); ++i) {
+    const nsDependentCSubstring token =
+        Substring(mCachedSearchTokens[i], 0);
 
     if (HAS_BEHAVIOR(TITLE) && HAS_BEHAVIOR(URL)) {
-      matches = (searchFunction(token, trimmedTitle) ||
-                 searchFunction(token, tags)) &&
-                searchFunction(token, trimmedUrl);
+      matches = (searchFunction(token, trimmedTitle, matchDiacritics) ||
+                 searchFunction(token, tags, matchDiacritics)) &&
+                searchFunction(token, trimmedUrl, matchDiacritics);
     } else if (HAS_BEHAVIOR(TITLE)) {
-      matches =
-          searchFunction(token, trimmedTitle) || searchFunction(token, tags);
+      matches = searchFunction(token, trimmedTitle, matchDiacritics) ||
+                searchFunction(token, tags, matchDiacritics);
     } else if (HAS_BEHAVIOR(URL)) {
-      matches = searchFunction(token, trimmedUrl);
+      matches = searchFunction(token, trimmedUrl, matchDiacritics);
     } else {
-      matches = searchFunction(token, trimmedTitle) ||
-                searchFunction(token, tags) ||
-                searchFunction(token, trimmedUrl);
+      matches = searchFunction(token, trimmedTitle, matchDiacritics) ||
+                searchFunction(token, tags, matchDiacritics) ||
+                searchFunction(token, trimmedUrl, matchDiacritics);
     }
   }
 
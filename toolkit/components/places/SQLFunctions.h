@@ -16,6 +16,8 @@
 
 #include "mozIStorageFunction.h"
 #include "mozilla/Attributes.h"
+#include "nsString.h"
+#include "nsTArray.h"
 
 class mozIStorageConnection;
 
@@ -96,11 +98,22 @@ class MatchAutoCompleteFunction final : public mozIStorageFunction {
   static const uint32_t kArgIndexSearchBehavior = 9;
   static const uint32_t kArgIndexLength = 10;
 
+  /**
+   * The search string is the same for every row a query invokes the function
+   * on, so its tokenized form is cached here and only rebuilt when the search
+   * string changes.  Each function instance is registered with a single
+   * connection and statements for a connection execute serialized on its
+   * helper thread, so no locking is needed.
+   */
+  nsCString mCachedSearchString;
+  nsTArray<nsCString> mCachedSearchTokens;
+
   /**
    * Typedefs
    */
   typedef bool (*searchFunctionPtr)(const nsDependentCSubstring& aToken,
-                                    const nsACString& aSourceString);
+                                    const nsACString& aSourceString,
+                                    bool aMatchDiacritics);
 
   typedef nsACString::const_char_iterator const_char_iterator;
 
@@ -114,30 +127,6 @@ class MatchAutoCompleteFunction final : public mozIStorageFunction {
    */
   static searchFunctionPtr getSearchFunction(int32_t aBehavior);
 
-  /**
-   * Tests if aSourceString starts with aToken.
-   *
-   * @param aToken
-   *        The string to search for.
-   * @param aSourceString
-   *        The string to search.
-   * @return true if found, false otherwise.
-   */
-  static bool findBeginning(const nsDependentCSubstring& aToken,
-                            const nsACString& aSourceString);
-
-  /**
-   * Tests if aSourceString starts with aToken in a case sensitive way.
-   *
-   * @param aToken
-   *        The string to search for.
-   * @param aSourceString
-   *        The string to search.
-   * @return true if found, false otherwise.
-   */
-  static bool findBeginningCaseSensitive(const nsDependentCSubstring& aToken,
-                                         const nsACString& aSourceString);
-
   /**
    * Searches aSourceString for aToken anywhere in the string in a case-
    * insensitive way.
@@ -146,10 +135,13 @@ class MatchAutoCompleteFunction final : public mozIStorageFunction {
    *        The string to search for.
    * @param aSourceString
    *        The string to search.
+   * @param aMatchDiacritics
+   *        Whether or not the match is diacritic-sensitive.
    * @return true if found, false otherwise.
    */
   static bool findAnywhere(const nsDependentCSubstring& aToken,
-                           const nsACString& aSourceString);
+                           const nsACString& aSourceString,
+                           bool aMatchDiacritics);
 
   /**
    * Tests if aToken is found on a word boundary in aSourceString.
@@ -158,10 +150,13 @@ class MatchAutoCompleteFunction final : public mozIStorageFunction {
    *        The string to search for.
    * @param aSourceString
    *        The string to search.
+   * @param aMatchDiacritics
+   *        Whether or not the match is diacritic-sensitive.
    * @return true if found, false otherwise.
    */
   static bool findOnBoundary(const nsDependentCSubstring& aToken,
-                             const nsACString& aSourceString);
+                             const nsACString& aSourceString,
+                             bool aMatchDiacritics);
 
   /**
    * Fixes a URI's spec such that it is ready to be searched.  This includes
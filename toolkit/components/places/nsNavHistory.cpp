@@ -220,7 +220,9 @@ class FixAndDecayFrecencyRunnable final : public Runnable {
       : Runnable("places::FixAndDecayFrecencyRunnable"),
         mDB(aDB),
         mDecayRate(aDecayRate),
-        mDecayReason(mozIStorageStatementCallback::REASON_FINISHED) {}
+        mDecayReason(mozIStorageStatementCallback::REASON_FINISHED),
+        mFixedInvalidFrecencies(false),
+        mLastDecayedPlaceId(0) {}
 
   NS_IMETHOD
   Run() override {
@@ -235,36 +237,54 @@ class FixAndDecayFrecencyRunnable final : public Runnable {
     MOZ_ASSERT(!NS_IsMainThread(),
                "Frecencies should be recalculated on async thread");
 
-    nsCOMPtr<mozIStorageStatement> updateStmt = mDB->GetStatement(
-        "UPDATE moz_places "
-        "SET frecency = CALCULATE_FRECENCY(id) "
-        "WHERE id IN ("
-        "SELECT id FROM moz_places "
-        "WHERE frecency < 0 "
-        "ORDER BY frecency ASC "
-        "LIMIT 400"
-        ")");
-    NS_ENSURE_STATE(updateStmt);
-    nsresult rv = updateStmt->Execute();
-    NS_ENSURE_SUCCESS(rv, rv);
+    nsresult rv;
 
-    nsCOMPtr<mozIStorageStatement> selectStmt = mDB->GetStatement(
-        "SELECT id FROM moz_places WHERE frecency < 0 "
-        "LIMIT 1");
-    NS_ENSURE_STATE(selectStmt);
-    bool hasResult = false;
-    rv = selectStmt->ExecuteStep(&hasResult);
-    NS_ENSURE_SUCCESS(rv, rv);
-    if (hasResult) {
-      // There are more invalid frecencies to fix. Re-dispatch to the async
-      // storage thread for the next chunk.
+    if (!mFixedInvalidFrecencies) {
+      nsCOMPtr<mozIStorageStatement> updateStmt = mDB->GetStatement(
+          "UPDATE moz_places "
+          "SET frecency = CALCULATE_FRECENCY(id) "
+          "WHERE id IN ("
+          "SELECT id FROM moz_places "
+          "WHERE frecency < 0 "
+          "ORDER BY frecency ASC "
+          "LIMIT 400"
+          ")");
+      NS_ENSURE_STATE(updateStmt);
+      rv = updateStmt->Execute();
+      NS_ENSURE_SUCCESS(rv, rv);
+
+      nsCOMPtr<mozIStorageStatement> selectStmt = mDB->GetStatement(
+          "SELECT id FROM moz_places WHERE frecency < 0 "
+          "LIMIT 1");
+      NS_ENSURE_STATE(selectStmt);
+      bool hasResult = false;
+      rv = selectStmt->ExecuteStep(&hasResult);
+      NS_ENSURE_SUCCESS(rv, rv);
+      if (hasResult) {
+        // There are more invalid frecencies to fix. Re-dispatch to the async
+        // storage thread for the next chunk.
+        return NS_DispatchToCurrentThread(this);
+      }
+
+      mFixedInvalidFrecencies = true;
+    }
+
+    bool moreToDecay = false;
+    if (NS_WARN_IF(NS_FAILED(DecayFrecenciesChunk(&moreToDecay)))) {
+      mDecayReason = mozIStorageStatementCallback::REASON_ERROR;
+    } else if (moreToDecay) {
+      // There are more frecencies to decay. Re-dispatch to the async storage
+      // thread for the next chunk, so that statements executed on behalf of
+      // the UI (e.g. awesomebar searches) don't have to wait for the whole
+      // decay to finish.
       return NS_DispatchToCurrentThread(this);
     }
 
     mozStorageTransaction transaction(
         mDB->MainConn(), false, mozIStorageConnection::TRANSACTION_IMMEDIATE);
 
-    if (NS_WARN_IF(NS_FAILED(DecayFrecencies()))) {
+    if (mDecayReason == mozIStorageStatementCallback::REASON_FINISHED &&
+        NS_WARN_IF(NS_FAILED(DecayAdaptiveEntries()))) {
       mDecayReason = mozIStorageStatementCallback::REASON_ERROR;
     }
 
@@ -279,14 +299,51 @@ class FixAndDecayFrecencyRunnable final : public Runnable {
     rv = transaction.Commit();
     NS_ENSURE_SUCCESS(rv, rv);
 
+    if (mDecayReason == mozIStorageStatementCallback::REASON_FINISHED) {
+      Telemetry::Accumulate(
+          Telemetry::PLACES_IDLE_FRECENCY_DECAY_TIME_MS,
+          static_cast<uint32_t>(mDecayDuration.ToMilliseconds()));
+    }
+
     // Re-dispatch to the main thread to notify observers.
     return NS_DispatchToMainThread(this);
   }
 
  private:
-  nsresult DecayFrecencies() {
+  /**
+   * Decays the frecencies of the next chunk of pages, in increasing page id
+   * order. Each chunk runs in its own implicit transaction, so that the
+   * database is not write-locked for the whole decay.
+   */
+  nsresult DecayFrecenciesChunk(bool* aMoreToDecay) {
+    MOZ_ASSERT(aMoreToDecay);
+
     TimeStamp start = TimeStamp::Now();
 
+    nsCOMPtr<mozIStorageStatement> selectStmt = mDB->GetStatement(
+        "SELECT MAX(id) FROM ("
+        "SELECT id FROM moz_places "
+        "WHERE id > :last_id "
+        "ORDER BY id "
+        "LIMIT 400"
+        ")");
+    NS_ENSURE_STATE(selectStmt);
+    nsresult rv = selectStmt->BindInt64ByName("last_id"_ns,
+                                              mLastDecayedPlaceId);
+    NS_ENSURE_SUCCESS(rv, rv);
+    bool hasResult = false;
+    rv = selectStmt->ExecuteStep(&hasResult);
+    NS_ENSURE_SUCCESS(rv, rv);
+    bool isNull;
+    rv = selectStmt->GetIsNull(0, &isNull);
+    NS_ENSURE_SUCCESS(rv, rv);
+    if (!hasResult || isNull) {
+      // No pages left to decay.
+      *aMoreToDecay = false;
+      return NS_OK;
+    }
+    int64_t endId = selectStmt->AsInt64(0);
+
     // Globally decay places frecency rankings to estimate reduced frecency
     // values of pages that haven't been visited for a while, i.e., they do
     // not get an updated frecency.  A scaling factor of .975 results in .5 the
@@ -295,21 +352,33 @@ class FixAndDecayFrecencyRunnable final : public Runnable {
     // moz_places_afterupdate_frecency_trigger still ignores these changes.
     nsCOMPtr<mozIStorageStatement> decayFrecency = mDB->GetStatement(
         "UPDATE moz_places SET frecency = ROUND(frecency * :decay_rate) "
-        "WHERE frecency > 0");
+        "WHERE id > :last_id AND id <= :end_id AND frecency > 0");
     NS_ENSURE_STATE(decayFrecency);
-    nsresult rv = decayFrecency->BindDoubleByName(
-        "decay_rate"_ns, static_cast<double>(mDecayRate));
+    rv = decayFrecency->BindDoubleByName("decay_rate"_ns,
+                                         static_cast<double>(mDecayRate));
+    NS_ENSURE_SUCCESS(rv, rv);
+    rv = decayFrecency->BindInt64ByName("last_id"_ns, mLastDecayedPlaceId);
+    NS_ENSURE_SUCCESS(rv, rv);
+    rv = decayFrecency->BindInt64ByName("end_id"_ns, endId);
     NS_ENSURE_SUCCESS(rv, rv);
     rv = decayFrecency->Execute();
     NS_ENSURE_SUCCESS(rv, rv);
 
+    mLastDecayedPlaceId = endId;
+    mDecayDuration += TimeStamp::Now() - start;
+
+    *aMoreToDecay = true;
+    return NS_OK;
+  }
+
+  nsresult DecayAdaptiveEntries() {
     // Decay potentially unused adaptive entries (e.g. those that are at 1)
     // to allow better chances for new entries that will start at 1.
     nsCOMPtr<mozIStorageStatement> decayAdaptive = mDB->GetStatement(
         "UPDATE moz_inputhistory SET use_count = use_count * :decay_rate");
     NS_ENSURE_STATE(decayAdaptive);
-    rv = decayAdaptive->BindDoubleByName("decay_rate"_ns,
-                                         static_cast<double>(mDecayRate));
+    nsresult rv = decayAdaptive->BindDoubleByName(
+        "decay_rate"_ns, static_cast<double>(mDecayRate));
     NS_ENSURE_SUCCESS(rv, rv);
     rv = decayAdaptive->Execute();
     NS_ENSURE_SUCCESS(rv, rv);
@@ -325,15 +394,18 @@ class FixAndDecayFrecencyRunnable final : public Runnable {
     rv = deleteAdaptive->Execute();
     NS_ENSURE_SUCCESS(rv, rv);
 
-    Telemetry::AccumulateTimeDelta(
-        Telemetry::PLACES_IDLE_FRECENCY_DECAY_TIME_MS, start);
-
     return NS_OK;
   }
 
   RefPtr<Database> mDB;
   float mDecayRate;
   uint16_t mDecayReason;
+  bool mFixedInvalidFrecencies;
+  // The id of the last page whose frecency was decayed, used to resume the
+  // decay at the next chunk.
+  int64_t mLastDecayedPlaceId;
+  // The total time spent decaying frecencies, across all chunks.
+  TimeDuration mDecayDuration;
 };
 
 }  // namespace
@@ -21,6 +21,7 @@
 #include "mozilla/JSONWriter.h"
 #include "mozilla/StartupTimeline.h"
 #include "mozilla/StaticMutex.h"
+#include "mozilla/UniquePtr.h"
 #include "mozilla/Unused.h"
 #include "nsClassHashtable.h"
 #include "nsString.h"
@@ -204,6 +205,12 @@ class Histogram {
    */
   void Add(uint32_t sample);
 
+  /**
+   * Add `count` accumulations of `sample` to this histogram in all registered
+   * stores. Only used when merging the shared count histogram regions.
+   */
+  void AddCount(uint32_t sample, uint32_t count);
+
   /**
    * Clear the named store for this histogram.
    */
@@ -310,6 +317,26 @@ KeyedHistogram* gExpiredKeyedHistogram = nullptr;
 // To utilize C++ initialization rules, we invert the meaning to "disabled".
 bool gHistogramRecordingDisabled[HistogramCount] = {};
 
+// The type of the per-histogram counters in a shared count histogram region.
+// The child process bumps these with relaxed atomic increments; see
+// TelemetryIPCAccumulator::AccumulateSharedCount.
+typedef mozilla::Atomic<uint32_t, mozilla::Relaxed> SharedCounter;
+
+// Parent-process bookkeeping for one child process' shared count histogram
+// region. The counters only ever grow; mLastMerged remembers how much of each
+// counter has already been merged into the child storage, so merging at an
+// arbitrary time is safe. Deltas are computed with unsigned arithmetic, which
+// tolerates the counters wrapping around.
+struct SharedHistogramCounters {
+  ProcessID mProcessType;
+  const SharedCounter* mCounters;
+  mozilla::UniquePtr<uint32_t[]> mLastMerged;
+};
+
+// The registered shared regions, guarded by gTelemetryHistogramMutex like the
+// rest of the storage in this file. Only used in the parent process.
+nsTArray<SharedHistogramCounters>* gSharedHistogramCounters = nullptr;
+
 // This is for gHistogramInfos, gHistogramStringTable
 #include "TelemetryHistogramData.inc"
 
@@ -722,6 +749,64 @@ nsresult internal_HistogramAdd(const StaticMutexAutoLock& aLock,
   return NS_OK;
 }
 
+// Merge `count` accumulations of the sample `1` into `histogram` at once.
+// This mirrors the checks in internal_HistogramAdd for non-parent process
+// data; it is only used when draining the shared count histogram regions,
+// whose samples are always 1. Recording-enabled was already checked in the
+// owning process, and the regions are disabled entirely for the GeckoView
+// streaming product.
+nsresult internal_HistogramAddCount(const StaticMutexAutoLock& aLock,
+                                    Histogram& histogram, const HistogramID id,
+                                    uint32_t count, ProcessID aProcessType) {
+  MOZ_ASSERT(aProcessType != ProcessID::Parent);
+
+  bool canRecordDataset =
+      CanRecordDataset(gHistogramInfos[id].dataset, internal_CanRecordBase(),
+                       internal_CanRecordExtended());
+  if (!canRecordDataset) {
+    return NS_OK;
+  }
+
+  // Don't record if the current platform is not enabled
+  if (!CanRecordProduct(gHistogramInfos[id].products)) {
+    return NS_OK;
+  }
+
+  histogram.AddCount(1, count);
+
+  return NS_OK;
+}
+
+// Accumulate whatever a child process added to its shared count histogram
+// region since the last merge into that process' histogram storage.
+void internal_MergeSharedCounters(const StaticMutexAutoLock& aLock,
+                                  SharedHistogramCounters& aRegion) {
+  for (uint32_t i = 0; i < HistogramCount; ++i) {
+    uint32_t current = aRegion.mCounters[i];
+    uint32_t delta = current - aRegion.mLastMerged[i];
+    if (delta == 0) {
+      continue;
+    }
+    aRegion.mLastMerged[i] = current;
+
+    HistogramID id = HistogramID(i);
+    Histogram* w = internal_GetHistogramById(aLock, id, aRegion.mProcessType);
+    if (NS_WARN_IF(!w)) {
+      continue;
+    }
+    internal_HistogramAddCount(aLock, *w, id, delta, aRegion.mProcessType);
+  }
+}
+
+void internal_MergeAllSharedCounters(const StaticMutexAutoLock& aLock) {
+  if (!gSharedHistogramCounters) {
+    return;
+  }
+  for (auto& region : *gSharedHistogramCounters) {
+    internal_MergeSharedCounters(aLock, region);
+  }
+}
+
 }  // namespace
 
 ////////////////////////////////////////////////////////////////////////
@@ -895,6 +980,10 @@ nsresult internal_GetHistogramsSnapshot(
     const StaticMutexAutoLock& aLock, const nsACString& aStore,
     unsigned int aDataset, bool aClearSubsession, bool aIncludeGPU,
     bool aFilterTest, HistogramProcessSnapshotsArray& aOutSnapshot) {
+  // Pick up whatever child processes accumulated into their shared count
+  // histogram regions, so the snapshot is as current as a message-based one.
+  internal_MergeAllSharedCounters(aLock);
+
   if (!aOutSnapshot.resize(static_cast<uint32_t>(ProcessID::Count))) {
     return NS_ERROR_OUT_OF_MEMORY;
   }
@@ -1017,6 +1106,33 @@ void Histogram::Add(uint32_t sample) {
   }
 }
 
+void Histogram::AddCount(uint32_t sample, uint32_t count) {
+  MOZ_ASSERT(XRE_IsParentProcess(),
+             "Only add to histograms in the parent process");
+  if (!XRE_IsParentProcess()) {
+    return;
+  }
+
+  if (IsExpired()) {
+    return;
+  }
+
+  // The internal representation of a base::Histogram's counts uses `int`;
+  // clamp so huge counter deltas remain large instead of becoming negative.
+  if (count > INT_MAX) {
+    count = INT_MAX;
+  }
+
+  if (mSingleStore != nullptr) {
+    mSingleStore->AddCount(sample, count);
+  } else {
+    for (auto iter = mStorage.Iter(); !iter.Done(); iter.Next()) {
+      auto& h = iter.Data();
+      h->AddCount(sample, count);
+    }
+  }
+}
+
 void Histogram::Clear(const nsACString& store) {
   MOZ_ASSERT(XRE_IsParentProcess(),
              "Only clear histograms in the parent process");
@@ -1512,6 +1628,18 @@ bool internal_RemoteAccumulate(const StaticMutexAutoLock& aLock,
     return true;
   }
 
+  // Plain count histograms being bumped by one are the hottest path through
+  // here and have a fixed-size representation the parent can sample directly:
+  // record those with an atomic add into the shared count histogram region
+  // instead of batching an IPC message, when the region is available.
+  const HistogramInfo& info = gHistogramInfos[aId];
+  if (aSample == 1 && !info.keyed &&
+      info.histogramType == nsITelemetry::HISTOGRAM_COUNT &&
+      GetCurrentProduct() != SupportedProduct::GeckoviewStreaming &&
+      TelemetryIPCAccumulator::AccumulateSharedCount(aId)) {
+    return true;
+  }
+
   TelemetryIPCAccumulator::AccumulateChildHistogram(aId, aSample);
   return true;
 }
@@ -1590,6 +1718,10 @@ void internal_ClearHistogram(const StaticMutexAutoLock& aLock, HistogramID id,
     return;
   }
 
+  // Merge pending shared-region counts first, so they are cleared along with
+  // everything else instead of surfacing in the next snapshot.
+  internal_MergeAllSharedCounters(aLock);
+
   // Handle keyed histograms.
   if (gHistogramInfos[id].keyed) {
     for (uint32_t process = 0;
@@ -2456,6 +2588,8 @@ void TelemetryHistogram::DeInitializeGlobalState() {
   gExpiredHistogram = nullptr;
   delete gExpiredKeyedHistogram;
   gExpiredKeyedHistogram = nullptr;
+  delete gSharedHistogramCounters;
+  gSharedHistogramCounters = nullptr;
 }
 
 #ifdef DEBUG
@@ -2755,6 +2889,47 @@ void TelemetryHistogram::AccumulateChildKeyed(
   }
 }
 
+void TelemetryHistogram::RegisterSharedHistogramCounters(
+    ProcessID aProcessType, const void* aMemory, size_t aSize) {
+  MOZ_ASSERT(XRE_IsParentProcess());
+  if (!XRE_IsParentProcess() || !aMemory ||
+      aSize < HistogramCount * sizeof(SharedCounter)) {
+    return;
+  }
+
+  StaticMutexAutoLock locker(gTelemetryHistogramMutex);
+  if (!gSharedHistogramCounters) {
+    gSharedHistogramCounters = new nsTArray<SharedHistogramCounters>();
+  }
+  SharedHistogramCounters* region = gSharedHistogramCounters->AppendElement();
+  region->mProcessType = aProcessType;
+  region->mCounters = static_cast<const SharedCounter*>(aMemory);
+  region->mLastMerged = mozilla::MakeUnique<uint32_t[]>(HistogramCount);
+}
+
+void TelemetryHistogram::UnregisterSharedHistogramCounters(
+    const void* aMemory) {
+  MOZ_ASSERT(XRE_IsParentProcess());
+  if (!XRE_IsParentProcess()) {
+    return;
+  }
+
+  StaticMutexAutoLock locker(gTelemetryHistogramMutex);
+  if (!gSharedHistogramCounters) {
+    return;
+  }
+  for (size_t i = 0; i < gSharedHistogramCounters->Length(); ++i) {
+    SharedHistogramCounters& region = (*gSharedHistogramCounters)[i];
+    if (region.mCounters == aMemory) {
+      // Merge what the child accumulated since the last snapshot before the
+      // region goes away with the child process.
+      internal_MergeSharedCounters(locker, region);
+      gSharedHistogramCounters->RemoveElementAt(i);
+      return;
+    }
+  }
+}
+
 nsresult TelemetryHistogram::GetAllStores(StringHashSet& set) {
   for (uint32_t storeIdx : gHistogramStoresTable) {
     const char* name = &gHistogramStringTable[storeIdx];
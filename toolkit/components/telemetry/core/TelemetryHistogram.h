@@ -79,6 +79,13 @@ void AccumulateChildKeyed(
     const nsTArray<mozilla::Telemetry::KeyedHistogramAccumulation>&
         aAccumulations);
 
+// Register/unregister a child process' shared count histogram region, which
+// holds one counter per histogram and is sampled directly when snapshotting.
+// The memory must stay valid until the region is unregistered.
+void RegisterSharedHistogramCounters(mozilla::Telemetry::ProcessID aProcessType,
+                                     const void* aMemory, size_t aSize);
+void UnregisterSharedHistogramCounters(const void* aMemory);
+
 /**
  * Append the list of registered stores to the given set.
  */
@@ -51,6 +51,16 @@ void TelemetryIPC::RecordChildEvents(
   TelemetryEvent::RecordChildEvents(aProcessType, aEvents);
 }
 
+void TelemetryIPC::RegisterSharedHistogramCounters(
+    Telemetry::ProcessID aProcessType, const void* aMemory, size_t aSize) {
+  TelemetryHistogram::RegisterSharedHistogramCounters(aProcessType, aMemory,
+                                                      aSize);
+}
+
+void TelemetryIPC::UnregisterSharedHistogramCounters(const void* aMemory) {
+  TelemetryHistogram::UnregisterSharedHistogramCounters(aMemory);
+}
+
 void TelemetryIPC::RecordDiscardedData(
     Telemetry::ProcessID aProcessType,
     const Telemetry::DiscardedData& aDiscardedData) {
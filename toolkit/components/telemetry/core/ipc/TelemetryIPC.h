@@ -86,6 +86,26 @@ void UpdateChildKeyedScalars(
 void RecordChildEvents(Telemetry::ProcessID aProcessType,
                        const nsTArray<Telemetry::ChildEventData>& aEvents);
 
+/**
+ * Register a child process' shared count histogram region. Count histogram
+ * accumulations in the child are plain atomic adds into this region, and the
+ * parent samples it directly when snapshotting histograms.
+ *
+ * @param aProcessType - the process type the region accumulates for
+ * @param aMemory - the start of the shared region
+ * @param aSize - the size of the shared region in bytes
+ */
+void RegisterSharedHistogramCounters(Telemetry::ProcessID aProcessType,
+                                     const void* aMemory, size_t aSize);
+
+/**
+ * Unregister a shared count histogram region, merging anything it still
+ * holds. Must be called before the underlying memory is unmapped.
+ *
+ * @param aMemory - the start of the shared region
+ */
+void UnregisterSharedHistogramCounters(const void* aMemory);
+
 /**
  * Record the counts of data the child process had to discard
  *
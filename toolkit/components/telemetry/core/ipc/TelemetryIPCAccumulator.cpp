@@ -12,10 +12,13 @@
 #include "mozilla/gfx/GPUParent.h"
 #include "mozilla/gfx/GPUProcessManager.h"
 #include "mozilla/net/SocketProcessChild.h"
+#include "mozilla/ipc/Shmem.h"
+#include "mozilla/Likely.h"
 #include "mozilla/SchedulerGroup.h"
 #include "mozilla/StaticMutex.h"
 #include "mozilla/StaticPrefs_toolkit.h"
 #include "mozilla/StaticPtr.h"
+#include "mozilla/TelemetryHistogramEnums.h"
 #include "mozilla/Unused.h"
 #include "nsComponentManagerUtils.h"
 #include "nsITimer.h"
@@ -58,6 +61,16 @@ nsITimer* gIPCTimer = nullptr;
 mozilla::Atomic<bool, mozilla::Relaxed> gIPCTimerArmed(false);
 mozilla::Atomic<bool, mozilla::Relaxed> gIPCTimerArming(false);
 
+// A per-process shared-memory region holding one counter per histogram.
+// Unkeyed count histogram accumulations are plain atomic adds into this
+// region, which the parent samples directly when it snapshots histograms;
+// they never go through the message batching below. Only content processes
+// register a region; other child process types keep batching over IPC.
+typedef mozilla::Atomic<uint32_t, mozilla::Relaxed> SharedCounter;
+mozilla::Atomic<SharedCounter*, mozilla::ReleaseAcquire> gSharedCounters(
+    nullptr);
+mozilla::Atomic<bool, mozilla::Relaxed> gSharedCountersRequested(false);
+
 // This batches child process accumulations that should be sent to the parent.
 StaticAutoPtr<nsTArray<HistogramAccumulation>> gHistogramAccumulations;
 StaticAutoPtr<nsTArray<KeyedHistogramAccumulation>>
@@ -111,6 +124,38 @@ void ArmIPCTimer(const StaticMutexAutoLock& lock) {
   }
 }
 
+// Allocate the shared count histogram region, hand it to the parent and
+// publish it for AccumulateSharedCount. Shared memory can only be allocated
+// and sent on the main thread.
+void SetUpSharedCountersMainThread() {
+  MOZ_ASSERT(NS_IsMainThread());
+  if (gSharedCounters) {
+    return;
+  }
+
+  mozilla::dom::ContentChild* contentChild =
+      mozilla::dom::ContentChild::GetSingleton();
+  if (!contentChild || !contentChild->CanSend()) {
+    return;
+  }
+
+  size_t size = mozilla::Telemetry::HistogramCount * sizeof(SharedCounter);
+  mozilla::ipc::Shmem shmem;
+  if (!contentChild->AllocUnsafeShmem(
+          size, mozilla::ipc::SharedMemory::TYPE_BASIC, &shmem)) {
+    return;
+  }
+  memset(shmem.get<char>(), 0, size);
+
+  SharedCounter* counters = reinterpret_cast<SharedCounter*>(shmem.get<char>());
+  if (!contentChild->SendRegisterSharedHistogramCounters(std::move(shmem))) {
+    return;
+  }
+  // The underlying mapping stays valid for the lifetime of the channel, even
+  // though we handed the Shmem itself to the parent.
+  gSharedCounters = counters;
+}
+
 void DispatchIPCTimerFired() {
   TelemetryIPCAccumulator::DispatchToMainThread(NS_NewRunnableFunction(
       "TelemetryIPCAccumulator::IPCTimerFired", []() -> void {
@@ -144,6 +189,26 @@ void TelemetryIPCAccumulator::AccumulateChildHistogram(
   ArmIPCTimer(locker);
 }
 
+bool TelemetryIPCAccumulator::AccumulateSharedCount(
+    mozilla::Telemetry::HistogramID aId) {
+  SharedCounter* counters = gSharedCounters;
+  if (MOZ_LIKELY(counters)) {
+    counters[aId]++;
+    return true;
+  }
+
+  // Set the region up the first time we could have used it. Until it is
+  // ready (or if setting it up failed), callers keep batching over IPC.
+  if (XRE_GetProcessType() != GeckoProcessType_Content ||
+      gSharedCountersRequested.exchange(true)) {
+    return false;
+  }
+  DispatchToMainThread(NS_NewRunnableFunction(
+      "TelemetryIPCAccumulator::SetUpSharedCounters",
+      []() -> void { SetUpSharedCountersMainThread(); }));
+  return false;
+}
+
 void TelemetryIPCAccumulator::AccumulateChildKeyedHistogram(
     mozilla::Telemetry::HistogramID aId, const nsCString& aKey,
     uint32_t aSample) {
@@ -332,6 +397,10 @@ void TelemetryIPCAccumulator::DeInitializeGlobalState() {
     NS_RELEASE(gIPCTimer);
   }
 
+  // The shared count histogram region is unmapped together with the IPC
+  // channel; stop touching it from here on.
+  gSharedCounters = nullptr;
+
   gHistogramAccumulations = nullptr;
   gKeyedHistogramAccumulations = nullptr;
   gChildScalarsActions = nullptr;
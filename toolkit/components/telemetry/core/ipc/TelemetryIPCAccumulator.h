@@ -23,6 +23,12 @@ namespace TelemetryIPCAccumulator {
 // Histogram accumulation functions.
 void AccumulateChildHistogram(mozilla::Telemetry::HistogramID aId,
                               uint32_t aSample);
+
+// Record a single count histogram accumulation into the process' shared
+// count histogram region as a plain atomic add. Returns false if the region
+// is not (yet) available; the caller should then fall back to the
+// message-based accumulation above.
+bool AccumulateSharedCount(mozilla::Telemetry::HistogramID aId);
 void AccumulateChildKeyedHistogram(mozilla::Telemetry::HistogramID aId,
                                    const nsCString& aKey, uint32_t aSample);
 
@@ -490,10 +490,19 @@ nsresult Classifier::CheckURIFragments(
     return NS_ERROR_FAILURE;
   }
 
+  // Hash all fragments in one batch first so the SHA-256 code stays hot,
+  // then run the lookup pass back-to-back against the prefix set.
+  AutoTArray<Completion, MAX_HOST_COMPONENTS * (MAX_PATH_COMPONENTS + 2)>
+      lookupHashes;
+  lookupHashes.SetCapacity(aSpecFragments.Length());
+  for (uint32_t i = 0; i < aSpecFragments.Length(); i++) {
+    Completion* lookupHash = lookupHashes.AppendElement();
+    lookupHash->FromPlaintext(aSpecFragments[i]);
+  }
+
   // Now check each lookup fragment against the entries in the DB.
   for (uint32_t i = 0; i < aSpecFragments.Length(); i++) {
-    Completion lookupHash;
-    lookupHash.FromPlaintext(aSpecFragments[i]);
+    const Completion& lookupHash = lookupHashes[i];
 
     bool has, confirmed;
     uint32_t matchLength;
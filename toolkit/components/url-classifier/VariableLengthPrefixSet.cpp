@@ -9,6 +9,7 @@
 #include "nsUrlClassifierPrefixSet.h"
 #include "nsPrintfCString.h"
 #include "nsThreadUtils.h"
+#include "mozilla/MathAlgorithms.h"
 #include "mozilla/ScopeExit.h"
 #include "mozilla/EndianUtils.h"
 #include "mozilla/Logging.h"
@@ -43,6 +44,95 @@ void EnsureSorted(T* aArray) {
 
 NS_IMPL_ISUPPORTS(VariableLengthPrefixSet, nsIMemoryReporter)
 
+void VariableLengthPrefixSet::PrefixBloomFilter::Init(uint32_t aCount) {
+  mMask = 0;
+  mBits.Clear();
+
+  uint64_t wanted = uint64_t(aCount) * BITS_PER_PREFIX;
+  uint32_t bits;
+  if (wanted >= MAX_BITS) {
+    bits = MAX_BITS;
+  } else if (wanted <= MIN_BITS) {
+    bits = MIN_BITS;
+  } else {
+    bits = RoundUpPow2(uint32_t(wanted));
+  }
+
+  if (!mBits.SetLength(bits / 32, fallible)) {
+    // Leave the filter disabled; every lookup falls through to the exact
+    // search, which is correct, just slower.
+    mBits.Clear();
+    return;
+  }
+
+  memset(mBits.Elements(), 0, mBits.Length() * sizeof(uint32_t));
+  mMask = bits - 1;
+}
+
+void VariableLengthPrefixSet::PrefixBloomFilter::Add(uint32_t aPrefix) {
+  if (!mMask) {
+    return;
+  }
+
+  // Prefixes are fragments of SHA-256 digests, so the value itself is
+  // already uniformly distributed; a multiplicative mix supplies the
+  // second, in-block probe.
+  uint32_t mixed = aPrefix * 0x9e3779b9;
+  uint32_t block = (aPrefix & mMask) & ~(BLOCK_BITS - 1);
+  uint32_t bit1 = block + (mixed & (BLOCK_BITS - 1));
+  uint32_t bit2 = block + ((mixed >> 9) & (BLOCK_BITS - 1));
+
+  mBits[bit1 >> 5] |= 1u << (bit1 & 31);
+  mBits[bit2 >> 5] |= 1u << (bit2 & 31);
+}
+
+bool VariableLengthPrefixSet::PrefixBloomFilter::MightContain(
+    uint32_t aPrefix) const {
+  if (!mMask) {
+    return true;
+  }
+
+  uint32_t mixed = aPrefix * 0x9e3779b9;
+  uint32_t block = (aPrefix & mMask) & ~(BLOCK_BITS - 1);
+  uint32_t bit1 = block + (mixed & (BLOCK_BITS - 1));
+  uint32_t bit2 = block + ((mixed >> 9) & (BLOCK_BITS - 1));
+
+  return (mBits[bit1 >> 5] & (1u << (bit1 & 31))) &&
+         (mBits[bit2 >> 5] & (1u << (bit2 & 31)));
+}
+
+size_t VariableLengthPrefixSet::PrefixBloomFilter::SizeOfExcludingThis(
+    mozilla::MallocSizeOf aMallocSizeOf) const {
+  return mBits.ShallowSizeOfExcludingThis(aMallocSizeOf);
+}
+
+void VariableLengthPrefixSet::RebuildFilter() {
+  FallibleTArray<uint32_t> fixedPrefixes;
+  if (NS_FAILED(mFixedPrefixSet->GetPrefixesNative(fixedPrefixes))) {
+    // Disable the filter rather than risk a false negative.
+    mFilter = PrefixBloomFilter();
+    return;
+  }
+
+  uint32_t count = fixedPrefixes.Length();
+  for (auto iter = mVLPrefixSet.ConstIter(); !iter.Done(); iter.Next()) {
+    count += iter.Data()->Length() / iter.Key();
+  }
+
+  mFilter.Init(count);
+
+  for (uint32_t prefix : fixedPrefixes) {
+    mFilter.Add(prefix);
+  }
+  for (auto iter = mVLPrefixSet.ConstIter(); !iter.Done(); iter.Next()) {
+    const nsCString& prefixes = *iter.Data();
+    uint32_t size = iter.Key();
+    for (uint32_t pos = 0; pos + size <= prefixes.Length(); pos += size) {
+      mFilter.Add(BigEndian::readUint32(prefixes.BeginReading() + pos));
+    }
+  }
+}
+
 // This class will process prefix size between 4~32. But for 4 bytes prefixes,
 // they will be passed to nsUrlClassifierPrefixSet because of better
 // optimization.
@@ -118,6 +208,8 @@ nsresult VariableLengthPrefixSet::SetPrefixes(AddPrefixArray& aAddPrefixes,
   }
   mVLPrefixSet.Put(COMPLETE_SIZE, completionStr.release());
 
+  RebuildFilter();
+
   return NS_OK;
 }
 
@@ -179,6 +271,8 @@ nsresult VariableLengthPrefixSet::SetPrefixes(PrefixStringMap& aPrefixMap) {
     mVLPrefixSet.Put(iter.Key(), new nsCString(*iter.Data()));
   }
 
+  RebuildFilter();
+
   return NS_OK;
 }
 
@@ -262,6 +356,14 @@ nsresult VariableLengthPrefixSet::Matches(uint32_t aPrefix,
 
   *aLength = 0;
 
+  // The overwhelmingly common case is that nothing matches; the filter
+  // settles it with a single cache-line probe. A negative answer covers
+  // prefixes of every length because the filter holds the first four bytes
+  // of each one.
+  if (!mFilter.MightContain(aPrefix)) {
+    return NS_OK;
+  }
+
   // Check if it matches 4-bytes prefixSet first
   bool found = false;
   nsresult rv = mFixedPrefixSet->Contains(aPrefix, &found);
@@ -360,6 +462,10 @@ nsresult VariableLengthPrefixSet::LoadPrefixes(nsCOMPtr<nsIInputStream>& in) {
   LOG(("[%s] Loading VLPrefixSet successful (%u total prefixes)", mName.get(),
        totalPrefixes));
 
+  // The filter is not part of the file format; derive it from what was just
+  // loaded.
+  RebuildFilter();
+
   return NS_OK;
 }
 
@@ -480,6 +586,8 @@ size_t VariableLengthPrefixSet::SizeOfIncludingThis(
     n += iter.Data()->SizeOfExcludingThisIfUnshared(aMallocSizeOf);
   }
 
+  n += mFilter.SizeOfExcludingThis(aMallocSizeOf);
+
   return n;
 }
 
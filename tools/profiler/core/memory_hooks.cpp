@@ -13,6 +13,7 @@
 #include "mozilla/FastBernoulliTrial.h"
 #include "mozilla/IntegerPrintfMacros.h"
 #include "mozilla/JSONWriter.h"
+#include "mozilla/MathAlgorithms.h"
 #include "mozilla/MemoryReporting.h"
 #include "mozilla/PlatformMutex.h"
 #include "mozilla/ProfilerCounts.h"
@@ -54,6 +55,16 @@
 // a crash.
 static ProfilerCounterTotal* sCounter;
 
+// A census of allocation size classes, sampled at a fixed 1/64k rate whether
+// or not the profiler is active, and drained by
+// profiler_get_sampled_allocation_counts() (see MemoryTelemetry). Bucket n
+// counts sampled allocations with a usable size in (2^(n-1), 2^n].
+static const uint32_t kSizeClassSamplingPeriod = 64 * 1024;
+
+static mozilla::Atomic<uint32_t, mozilla::Relaxed> gSizeClassSampleCounter;
+static mozilla::Atomic<uint64_t, mozilla::Relaxed>
+    gSizeClassCounts[PROFILER_ALLOC_SIZE_CLASSES];
+
 // The gBernoulli value starts out as a nullptr, and only gets initialized once.
 // It then lives for the entire lifetime of the process. It cannot be deleted
 // without additional multi-threaded protections, since if we deleted it during
@@ -354,6 +365,16 @@ static void AllocCallback(void* aPtr, size_t aReqSize) {
   size_t actualSize = gMallocTable.malloc_usable_size(aPtr);
   if (actualSize > 0) {
     sCounter->Add(actualSize);
+
+    // Size-class census, sampled so that the common path stays a single
+    // relaxed atomic increment.
+    if ((++gSizeClassSampleCounter & (kSizeClassSamplingPeriod - 1)) == 0) {
+      size_t sizeClass = mozilla::CeilingLog2(actualSize);
+      if (sizeClass >= PROFILER_ALLOC_SIZE_CLASSES) {
+        sizeClass = PROFILER_ALLOC_SIZE_CLASSES - 1;
+      }
+      gSizeClassCounts[sizeClass]++;
+    }
   }
 
   auto threadIntercept = ThreadIntercept::MaybeGet();
@@ -596,3 +617,14 @@ void disable_native_allocations() {
 }
 
 }  // namespace mozilla::profiler
+
+bool profiler_get_sampled_allocation_counts(uint64_t* aCounts) {
+  if (!sCounter) {
+    // The memory hooks were never installed.
+    return false;
+  }
+  for (size_t i = 0; i < PROFILER_ALLOC_SIZE_CLASSES; i++) {
+    aCounts[i] = gSizeClassCounts[i].exchange(0);
+  }
+  return true;
+}
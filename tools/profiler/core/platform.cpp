@@ -3027,6 +3027,14 @@ static void PrintUsageThenExit(int aExitCode) {
       "  any of the filters is a case-insensitive substring of the thread\n"
       "  name. If unset, a default is used.\n"
       "\n"
+      "  MOZ_PROFILER_LIGHTWEIGHT\n"
+      "  If set to any value other than '' or '0'/'N'/'n', and\n"
+      "  MOZ_PROFILER_STARTUP is not set, starts the profiler in a\n"
+      "  lightweight marker-only mode: no stack sampling, and a small ring\n"
+      "  buffer, cheap enough to leave running for a whole session.\n"
+      "  If the value names a file, the buffer is additionally saved to that\n"
+      "  file when the BackgroundHangMonitor detects a hang.\n"
+      "\n"
       "  MOZ_PROFILER_SHUTDOWN\n"
       "  If set, the profiler saves a profile to the named file on shutdown.\n"
       "\n"
@@ -4003,100 +4011,123 @@ void profiler_init(void* aStackTop) {
         ((startupEnv[0] == '0' || startupEnv[0] == 'N' ||
           startupEnv[0] == 'n') &&
          startupEnv[1] == '\0')) {
-      return;
-    }
+      // Without full startup profiling, MOZ_PROFILER_LIGHTWEIGHT can still
+      // start the profiler in the marker-only flight recorder mode.
+      const char* lightweightEnv = getenv("MOZ_PROFILER_LIGHTWEIGHT");
+      if (!lightweightEnv || lightweightEnv[0] == '\0' ||
+          ((lightweightEnv[0] == '0' || lightweightEnv[0] == 'N' ||
+            lightweightEnv[0] == 'n') &&
+           lightweightEnv[1] == '\0')) {
+        return;
+      }
 
-    LOG("- MOZ_PROFILER_STARTUP is set");
-
-    // Startup default capacity may be different.
-    capacity = PROFILER_DEFAULT_STARTUP_ENTRIES;
-
-    const char* startupCapacity = getenv("MOZ_PROFILER_STARTUP_ENTRIES");
-    if (startupCapacity && startupCapacity[0] != '\0') {
-      errno = 0;
-      long capacityLong = strtol(startupCapacity, nullptr, 10);
-      // `long` could be 32 or 64 bits, so we force a 64-bit comparison with
-      // the maximum 32-bit signed number (as more than that is clamped down to
-      // 2^31 anyway).
-      if (errno == 0 && capacityLong > 0 &&
-          static_cast<uint64_t>(capacityLong) <=
-              static_cast<uint64_t>(INT32_MAX)) {
-        capacity = PowerOfTwo32(ActivePS::ClampToAllowedEntries(
-            static_cast<uint32_t>(capacityLong)));
-        LOG("- MOZ_PROFILER_STARTUP_ENTRIES = %u", unsigned(capacity.Value()));
-      } else {
-        LOG("- MOZ_PROFILER_STARTUP_ENTRIES not a valid integer: %s",
-            startupCapacity);
-        PrintUsageThenExit(1);
+      LOG("- MOZ_PROFILER_LIGHTWEIGHT is set");
+
+      // Record markers only, into a small ring buffer, with no stack
+      // sampling: cheap enough to leave running for a whole session on user
+      // machines. The buffer is dumped after the fact, e.g. when the
+      // BackgroundHangMonitor reports a hang.
+      capacity = PROFILER_LIGHTWEIGHT_ENTRIES;
+      interval = PROFILER_LIGHTWEIGHT_INTERVAL;
+      features = ProfilerFeature::NoStackSampling;
+
+      locked_profiler_start(lock, capacity, interval, features,
+                            filters.begin(), filters.length(), 0, duration);
+    } else {
+      LOG("- MOZ_PROFILER_STARTUP is set");
+
+      // Startup default capacity may be different.
+      capacity = PROFILER_DEFAULT_STARTUP_ENTRIES;
+
+      const char* startupCapacity = getenv("MOZ_PROFILER_STARTUP_ENTRIES");
+      if (startupCapacity && startupCapacity[0] != '\0') {
+        errno = 0;
+        long capacityLong = strtol(startupCapacity, nullptr, 10);
+        // `long` could be 32 or 64 bits, so we force a 64-bit comparison with
+        // the maximum 32-bit signed number (as more than that is clamped down
+        // to 2^31 anyway).
+        if (errno == 0 && capacityLong > 0 &&
+            static_cast<uint64_t>(capacityLong) <=
+                static_cast<uint64_t>(INT32_MAX)) {
+          capacity = PowerOfTwo32(ActivePS::ClampToAllowedEntries(
+              static_cast<uint32_t>(capacityLong)));
+          LOG("- MOZ_PROFILER_STARTUP_ENTRIES = %u",
+              unsigned(capacity.Value()));
+        } else {
+          LOG("- MOZ_PROFILER_STARTUP_ENTRIES not a valid integer: %s",
+              startupCapacity);
+          PrintUsageThenExit(1);
+        }
       }
-    }
 
-    const char* startupDuration = getenv("MOZ_PROFILER_STARTUP_DURATION");
-    if (startupDuration && startupDuration[0] != '\0') {
-      errno = 0;
-      double durationVal = PR_strtod(startupDuration, nullptr);
-      if (errno == 0 && durationVal >= 0.0) {
-        if (durationVal > 0.0) {
-          duration = Some(durationVal);
+      const char* startupDuration = getenv("MOZ_PROFILER_STARTUP_DURATION");
+      if (startupDuration && startupDuration[0] != '\0') {
+        errno = 0;
+        double durationVal = PR_strtod(startupDuration, nullptr);
+        if (errno == 0 && durationVal >= 0.0) {
+          if (durationVal > 0.0) {
+            duration = Some(durationVal);
+          }
+          LOG("- MOZ_PROFILER_STARTUP_DURATION = %f", durationVal);
+        } else {
+          LOG("- MOZ_PROFILER_STARTUP_DURATION not a valid float: %s",
+              startupDuration);
+          PrintUsageThenExit(1);
         }
-        LOG("- MOZ_PROFILER_STARTUP_DURATION = %f", durationVal);
-      } else {
-        LOG("- MOZ_PROFILER_STARTUP_DURATION not a valid float: %s",
-            startupDuration);
-        PrintUsageThenExit(1);
       }
-    }
 
-    const char* startupInterval = getenv("MOZ_PROFILER_STARTUP_INTERVAL");
-    if (startupInterval && startupInterval[0] != '\0') {
-      errno = 0;
-      interval = PR_strtod(startupInterval, nullptr);
-      if (errno == 0 && interval > 0.0 && interval <= PROFILER_MAX_INTERVAL) {
-        LOG("- MOZ_PROFILER_STARTUP_INTERVAL = %f", interval);
-      } else {
-        LOG("- MOZ_PROFILER_STARTUP_INTERVAL not a valid float: %s",
-            startupInterval);
-        PrintUsageThenExit(1);
+      const char* startupInterval = getenv("MOZ_PROFILER_STARTUP_INTERVAL");
+      if (startupInterval && startupInterval[0] != '\0') {
+        errno = 0;
+        interval = PR_strtod(startupInterval, nullptr);
+        if (errno == 0 && interval > 0.0 && interval <= PROFILER_MAX_INTERVAL) {
+          LOG("- MOZ_PROFILER_STARTUP_INTERVAL = %f", interval);
+        } else {
+          LOG("- MOZ_PROFILER_STARTUP_INTERVAL not a valid float: %s",
+              startupInterval);
+          PrintUsageThenExit(1);
+        }
       }
-    }
 
-    features |= StartupExtraDefaultFeatures() & AvailableFeatures();
+      features |= StartupExtraDefaultFeatures() & AvailableFeatures();
 
-    const char* startupFeaturesBitfield =
-        getenv("MOZ_PROFILER_STARTUP_FEATURES_BITFIELD");
-    if (startupFeaturesBitfield && startupFeaturesBitfield[0] != '\0') {
-      errno = 0;
-      features = strtol(startupFeaturesBitfield, nullptr, 10);
-      if (errno == 0 && features != 0) {
-        LOG("- MOZ_PROFILER_STARTUP_FEATURES_BITFIELD = %d", features);
+      const char* startupFeaturesBitfield =
+          getenv("MOZ_PROFILER_STARTUP_FEATURES_BITFIELD");
+      if (startupFeaturesBitfield && startupFeaturesBitfield[0] != '\0') {
+        errno = 0;
+        features = strtol(startupFeaturesBitfield, nullptr, 10);
+        if (errno == 0 && features != 0) {
+          LOG("- MOZ_PROFILER_STARTUP_FEATURES_BITFIELD = %d", features);
+        } else {
+          LOG("- MOZ_PROFILER_STARTUP_FEATURES_BITFIELD not a valid integer: "
+              "%s",
+              startupFeaturesBitfield);
+          PrintUsageThenExit(1);
+        }
       } else {
-        LOG("- MOZ_PROFILER_STARTUP_FEATURES_BITFIELD not a valid integer: %s",
-            startupFeaturesBitfield);
-        PrintUsageThenExit(1);
+        const char* startupFeatures = getenv("MOZ_PROFILER_STARTUP_FEATURES");
+        if (startupFeatures && startupFeatures[0] != '\0') {
+          // Interpret startupFeatures as a list of feature strings, separated
+          // by commas.
+          UniquePtr<char[]> featureStringStorage;
+          Vector<const char*> featureStringArray =
+              SplitAtCommas(startupFeatures, featureStringStorage);
+          features = ParseFeaturesFromStringArray(featureStringArray.begin(),
+                                                  featureStringArray.length(),
+                                                  /* aIsStartup */ true);
+          LOG("- MOZ_PROFILER_STARTUP_FEATURES = %d", features);
+        }
       }
-    } else {
-      const char* startupFeatures = getenv("MOZ_PROFILER_STARTUP_FEATURES");
-      if (startupFeatures && startupFeatures[0] != '\0') {
-        // Interpret startupFeatures as a list of feature strings, separated by
-        // commas.
-        UniquePtr<char[]> featureStringStorage;
-        Vector<const char*> featureStringArray =
-            SplitAtCommas(startupFeatures, featureStringStorage);
-        features = ParseFeaturesFromStringArray(featureStringArray.begin(),
-                                                featureStringArray.length(),
-                                                /* aIsStartup */ true);
-        LOG("- MOZ_PROFILER_STARTUP_FEATURES = %d", features);
+
+      const char* startupFilters = getenv("MOZ_PROFILER_STARTUP_FILTERS");
+      if (startupFilters && startupFilters[0] != '\0') {
+        filters = SplitAtCommas(startupFilters, filterStorage);
+        LOG("- MOZ_PROFILER_STARTUP_FILTERS = %s", startupFilters);
       }
-    }
 
-    const char* startupFilters = getenv("MOZ_PROFILER_STARTUP_FILTERS");
-    if (startupFilters && startupFilters[0] != '\0') {
-      filters = SplitAtCommas(startupFilters, filterStorage);
-      LOG("- MOZ_PROFILER_STARTUP_FILTERS = %s", startupFilters);
+      locked_profiler_start(lock, capacity, interval, features,
+                            filters.begin(), filters.length(), 0, duration);
     }
-
-    locked_profiler_start(lock, capacity, interval, features, filters.begin(),
-                          filters.length(), 0, duration);
   }
 
 #if defined(MOZ_REPLACE_MALLOC) && defined(MOZ_PROFILER_MEMORY)
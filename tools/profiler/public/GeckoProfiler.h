@@ -24,6 +24,11 @@
 // ProfilerMarkers.h is #included in the middle of this header!
 // #include "mozilla/ProfilerMarkers.h"
 
+// Number of power-of-two size classes in the sampled allocation census
+// recorded by the profiler's memory hooks; see
+// profiler_get_sampled_allocation_counts().
+static constexpr size_t PROFILER_ALLOC_SIZE_CLASSES = 32;
+
 #ifndef MOZ_GECKO_PROFILER
 
 #  include "mozilla/ProfilerMarkers.h"
@@ -76,6 +81,10 @@ static inline UniqueProfilerBacktrace profiler_get_backtrace() {
   return nullptr;
 }
 
+static inline bool profiler_get_sampled_allocation_counts(uint64_t* aCounts) {
+  return false;
+}
+
 static inline bool profiler_capture_backtrace_into(
     mozilla::ProfileChunkedBuffer& aChunkedBuffer) {
   return false;
@@ -338,6 +347,14 @@ static constexpr mozilla::PowerOfTwo32 PROFILER_DEFAULT_STARTUP_ENTRIES =
     mozilla::MakePowerOfTwo32<8 * 1024 * 1024>();  // 8M entries = 64MB
 #  endif
 
+// The marker-only lightweight mode (MOZ_PROFILER_LIGHTWEIGHT) doesn't record
+// any stack samples, so it can afford a much smaller ring buffer and a long
+// sampler interval (the sampler thread only wakes up to maintain the buffer).
+static constexpr mozilla::PowerOfTwo32 PROFILER_LIGHTWEIGHT_ENTRIES =
+    mozilla::MakePowerOfTwo32<128 * 1024>();  // 128k entries = 1MB
+
+#  define PROFILER_LIGHTWEIGHT_INTERVAL 1000 /* milliseconds */
+
 #  define PROFILER_DEFAULT_DURATION 20 /* seconds, for tests only */
 // Note: Keep in sync with GeckoThread.maybeStartGeckoProfiler:
 // https://searchfox.org/mozilla-central/source/mobile/android/geckoview/src/main/java/org/mozilla/gecko/GeckoThread.java
@@ -966,6 +983,22 @@ extern "C" {
 void profiler_save_profile_to_file(const char* aFilename);
 }
 
+// Fill aCounts[0..PROFILER_ALLOC_SIZE_CLASSES) with the number of sampled
+// allocations in each power-of-two size class (aCounts[n] counts allocations
+// with a usable size in (2^(n-1), 2^n]) since the previous call, resetting
+// the census. The census is gathered by the memory hooks at a fixed sampling
+// rate whether or not the profiler is active; MemoryTelemetry drains it into
+// the MEMORY_SAMPLED_ALLOCATIONS keyed histogram. Returns false (leaving
+// aCounts untouched) when the memory hooks aren't compiled in or were never
+// installed.
+#  if defined(MOZ_REPLACE_MALLOC) && defined(MOZ_PROFILER_MEMORY)
+bool profiler_get_sampled_allocation_counts(uint64_t* aCounts);
+#  else
+static inline bool profiler_get_sampled_allocation_counts(uint64_t* aCounts) {
+  return false;
+}
+#  endif
+
 //---------------------------------------------------------------------------
 // RAII classes
 //---------------------------------------------------------------------------
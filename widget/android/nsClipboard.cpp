@@ -114,6 +114,18 @@ nsClipboard::GetData(nsITransferable* aTransferable, int32_t aWhichClipboard) {
   return NS_ERROR_FAILURE;
 }
 
+NS_IMETHODIMP
+nsClipboard::AsyncGetData(nsITransferable* aTransferable,
+                          int32_t aWhichClipboard,
+                          nsIClipboardDataCallback* aCallback) {
+  NS_ENSURE_ARG(aCallback);
+
+  // Reading the Android clipboard has to happen on this thread anyway, so
+  // complete synchronously.
+  aCallback->OnComplete(GetData(aTransferable, aWhichClipboard));
+  return NS_OK;
+}
+
 NS_IMETHODIMP
 nsClipboard::EmptyClipboard(int32_t aWhichClipboard) {
   if (aWhichClipboard != kGlobalClipboard) return NS_ERROR_NOT_IMPLEMENTED;
@@ -713,6 +713,17 @@ nsClipboard::GetData(nsITransferable* aTransferable, int32_t aWhichClipboard) {
   return NS_ERROR_FAILURE;
 }
 
+NS_IMETHODIMP
+nsClipboard::AsyncGetData(nsITransferable* aTransferable, int32_t aWhichClipboard,
+                          nsIClipboardDataCallback* aCallback) {
+  NS_ENSURE_ARG(aCallback);
+
+  // NSPasteboard must be used from the main thread, so the request completes
+  // synchronously in this process.
+  aCallback->OnComplete(GetData(aTransferable, aWhichClipboard));
+  return NS_OK;
+}
+
 NS_IMETHODIMP
 nsClipboard::EmptyClipboard(int32_t aWhichClipboard) {
   if (aWhichClipboard == kSelectionCache) {
@@ -365,6 +365,19 @@ nsClipboard::GetData(nsITransferable* aTransferable, int32_t aWhichClipboard) {
   return NS_OK;
 }
 
+NS_IMETHODIMP
+nsClipboard::AsyncGetData(nsITransferable* aTransferable,
+                          int32_t aWhichClipboard,
+                          nsIClipboardDataCallback* aCallback) {
+  NS_ENSURE_ARG(aCallback);
+
+  // GTK clipboard access is bound to the main thread; the request completes
+  // synchronously here and asynchronously only via nsClipboardProxy in the
+  // content process.
+  aCallback->OnComplete(GetData(aTransferable, aWhichClipboard));
+  return NS_OK;
+}
+
 NS_IMETHODIMP
 nsClipboard::EmptyClipboard(int32_t aWhichClipboard) {
   LOGCLIP(("nsClipboard::EmptyClipboard (%s)\n",
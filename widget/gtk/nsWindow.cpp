@@ -15,6 +15,7 @@
 #include "mozilla/RefPtr.h"
 #include "mozilla/ScopeExit.h"
 #include "mozilla/StaticPrefs_apz.h"
+#include "mozilla/StaticPrefs_dom.h"
 #include "mozilla/StaticPrefs_ui.h"
 #include "mozilla/TextEvents.h"
 #include "mozilla/TimeStamp.h"
@@ -3310,28 +3311,28 @@ void nsWindow::OnMotionNotifyEvent(GdkEventMotion* aEvent) {
     }
   }
 
-  // see if we can compress this event
-  // XXXldb Why skip every other motion event when we have multiple,
-  // but not more than that?
-  bool synthEvent = false;
-#ifdef MOZ_X11
-  XEvent xevent;
-
-  if (mIsX11Display) {
-    while (XPending(GDK_WINDOW_XDISPLAY(aEvent->window))) {
-      XEvent peeked;
-      XPeekEvent(GDK_WINDOW_XDISPLAY(aEvent->window), &peeked);
-      if (peeked.xany.window != gdk_x11_window_get_xid(aEvent->window) ||
-          peeked.type != MotionNotify)
-        break;
+  WidgetMouseEvent event(true, eMouseMove, this, WidgetMouseEvent::eReal);
 
-      synthEvent = true;
-      XNextEvent(GDK_WINDOW_XDISPLAY(aEvent->window), &xevent);
+  // Records the current state of |event| as a coalesced sample, the same way
+  // CoalescedMouseData does for events forwarded to content processes, so
+  // that samples folded away below stay available to
+  // PointerEvent.getCoalescedEvents.  The holder is only created when we
+  // actually fold events, so the common single-event case allocates nothing.
+  auto recordSample = [&event]() {
+    if (!StaticPrefs::dom_w3c_pointer_events_enabled()) {
+      return;
     }
-  }
-#endif /* MOZ_X11 */
-
-  WidgetMouseEvent event(true, eMouseMove, this, WidgetMouseEvent::eReal);
+    if (!event.mCoalescedWidgetEvents) {
+      event.mCoalescedWidgetEvents = new WidgetPointerEventHolder();
+    }
+    WidgetPointerEvent* sample =
+        event.mCoalescedWidgetEvents->mEvents.AppendElement(event);
+    // The sample is a snapshot; it must not keep the holder (and therefore
+    // itself) alive.
+    sample->mCoalescedWidgetEvents = nullptr;
+    sample->mFlags.mBubbles = false;
+    sample->mFlags.mCancelable = false;
+  };
 
   gdouble pressure = 0;
   gdk_event_get_axis((GdkEvent*)aEvent, GDK_AXIS_PRESSURE, &pressure);
@@ -3339,33 +3340,69 @@ void nsWindow::OnMotionNotifyEvent(GdkEventMotion* aEvent) {
   // We have to ignore that and use last valid value
   if (pressure) mLastMotionPressure = pressure;
   event.mPressure = mLastMotionPressure;
+  event.mRefPoint = GetRefPoint(this, aEvent);
+  event.AssignEventTime(GetWidgetEventTime(aEvent->time));
+  KeymapWrapper::InitInputEvent(event, aEvent->state);
 
-  guint modifierState;
-  if (synthEvent) {
-#ifdef MOZ_X11
-    event.mRefPoint.x = nscoord(xevent.xmotion.x);
-    event.mRefPoint.y = nscoord(xevent.xmotion.y);
-
-    modifierState = xevent.xmotion.state;
-
-    event.AssignEventTime(GetWidgetEventTime(xevent.xmotion.time));
-#else
-    event.mRefPoint = GdkEventCoordsToDevicePixels(aEvent->x, aEvent->y);
+  // High-resolution mice report motion much faster than we can run layout
+  // and painting, so fold every consecutive motion event that is already
+  // waiting for this window into the event we dispatch.  First drain the
+  // GDK queue (the only queue Wayland events go through), then, on X11, the
+  // raw X event queue which holds events GDK has not translated yet.
+  while (GdkEvent* peeked = gdk_event_peek()) {
+    bool fold = peeked->type == GDK_MOTION_NOTIFY &&
+                peeked->motion.window == aEvent->window;
+    gdk_event_free(peeked);
+    if (!fold) {
+      break;
+    }
+    GdkEvent* next = gdk_event_get();
+    if (!next) {
+      break;
+    }
+    if (next->type != GDK_MOTION_NOTIFY ||
+        next->motion.window != aEvent->window) {
+      // Shouldn't happen as we have just peeked this event, but don't
+      // swallow an event we didn't mean to fold.
+      gdk_event_put(next);
+      gdk_event_free(next);
+      break;
+    }
+    recordSample();
+    gdk_event_get_axis(next, GDK_AXIS_PRESSURE, &pressure);
+    if (pressure) mLastMotionPressure = pressure;
+    event.mPressure = mLastMotionPressure;
+    event.mRefPoint = GetRefPoint(this, &next->motion);
+    event.AssignEventTime(GetWidgetEventTime(next->motion.time));
+    KeymapWrapper::InitInputEvent(event, next->motion.state);
+    gdk_event_free(next);
+  }
 
-    modifierState = aEvent->state;
+#ifdef MOZ_X11
+  if (mIsX11Display) {
+    while (XPending(GDK_WINDOW_XDISPLAY(aEvent->window))) {
+      XEvent peeked;
+      XPeekEvent(GDK_WINDOW_XDISPLAY(aEvent->window), &peeked);
+      if (peeked.xany.window != gdk_x11_window_get_xid(aEvent->window) ||
+          peeked.type != MotionNotify)
+        break;
 
-    event.AssignEventTime(GetWidgetEventTime(aEvent->time));
+      XEvent xevent;
+      XNextEvent(GDK_WINDOW_XDISPLAY(aEvent->window), &xevent);
+      recordSample();
+      event.mRefPoint.x = nscoord(xevent.xmotion.x);
+      event.mRefPoint.y = nscoord(xevent.xmotion.y);
+      event.AssignEventTime(GetWidgetEventTime(xevent.xmotion.time));
+      KeymapWrapper::InitInputEvent(event, xevent.xmotion.state);
+    }
+  }
 #endif /* MOZ_X11 */
-  } else {
-    event.mRefPoint = GetRefPoint(this, aEvent);
 
-    modifierState = aEvent->state;
-
-    event.AssignEventTime(GetWidgetEventTime(aEvent->time));
+  if (event.mCoalescedWidgetEvents) {
+    // Record the newest sample too so the list covers the whole batch.
+    recordSample();
   }
 
-  KeymapWrapper::InitInputEvent(event, modifierState);
-
   DispatchInputEvent(&event);
 }
 
@@ -3794,6 +3831,9 @@ void nsWindow::OnScrollEvent(GdkEventScroll* aEvent) {
   }
   WidgetWheelEvent wheelEvent(true, eWheel, this);
   wheelEvent.mDeltaMode = dom::WheelEvent_Binding::DOM_DELTA_LINE;
+  // Folding smooth scroll events below may advance the time past
+  // aEvent->time; the dispatched event carries the newest one.
+  guint32 eventTime = aEvent->time;
   switch (aEvent->direction) {
     case GDK_SCROLL_SMOOTH: {
       // As of GTK 3.4, all directional scroll events are provided by
@@ -3841,10 +3881,52 @@ void nsWindow::OnScrollEvent(GdkEventScroll* aEvent) {
         wheelEvent.mScrollType = WidgetWheelEvent::SCROLL_ASYNCHRONOUSELY;
       }
 
+      gdouble deltaX = aEvent->delta_x;
+      gdouble deltaY = aEvent->delta_y;
+
+      // High-resolution wheels and scroll-capable mice deliver smooth scroll
+      // events faster than we can process them, so accumulate the deltas of
+      // every consecutive smooth scroll event from the same device that is
+      // already waiting in the queue and dispatch a single wheel event.
+      // Legacy duplicates of events we have folded (see GNOME bug 726878
+      // above) are consumed as well so they neither stop the folding nor
+      // scroll twice.
+      while (GdkEvent* peeked = gdk_event_peek()) {
+        bool isScroll = peeked->type == GDK_SCROLL &&
+                        peeked->scroll.window == aEvent->window;
+        bool fold = isScroll && peeked->scroll.direction == GDK_SCROLL_SMOOTH &&
+                    gdk_event_get_source_device(peeked) == device;
+        bool dropLegacyDup = isScroll &&
+                             peeked->scroll.direction != GDK_SCROLL_SMOOTH &&
+                             peeked->scroll.time == mLastScrollEventTime;
+        gdk_event_free(peeked);
+        if (!fold && !dropLegacyDup) {
+          break;
+        }
+        GdkEvent* next = gdk_event_get();
+        if (!next) {
+          break;
+        }
+        if (next->type != GDK_SCROLL || next->scroll.window != aEvent->window) {
+          // Shouldn't happen as we have just peeked this event, but don't
+          // swallow an event we didn't mean to fold.
+          gdk_event_put(next);
+          gdk_event_free(next);
+          break;
+        }
+        if (next->scroll.direction == GDK_SCROLL_SMOOTH) {
+          mLastScrollEventTime = next->scroll.time;
+          deltaX += next->scroll.delta_x;
+          deltaY += next->scroll.delta_y;
+          eventTime = next->scroll.time;
+        }
+        gdk_event_free(next);
+      }
+
       // TODO - use a more appropriate scrolling unit than lines.
       // Multiply event deltas by 3 to emulate legacy behaviour.
-      wheelEvent.mDeltaX = aEvent->delta_x * 3;
-      wheelEvent.mDeltaY = aEvent->delta_y * 3;
+      wheelEvent.mDeltaX = deltaX * 3;
+      wheelEvent.mDeltaY = deltaY * 3;
       wheelEvent.mIsNoLineOrPageDelta = true;
 
       break;
@@ -3867,7 +3949,7 @@ void nsWindow::OnScrollEvent(GdkEventScroll* aEvent) {
 
   KeymapWrapper::InitInputEvent(wheelEvent, aEvent->state);
 
-  wheelEvent.AssignEventTime(GetWidgetEventTime(aEvent->time));
+  wheelEvent.AssignEventTime(GetWidgetEventTime(eventTime));
 
   DispatchInputEvent(&wheelEvent);
 }
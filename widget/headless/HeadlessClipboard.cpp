@@ -67,6 +67,17 @@ HeadlessClipboard::GetData(nsITransferable* aTransferable,
   return NS_OK;
 }
 
+NS_IMETHODIMP
+HeadlessClipboard::AsyncGetData(nsITransferable* aTransferable,
+                                int32_t aWhichClipboard,
+                                nsIClipboardDataCallback* aCallback) {
+  NS_ENSURE_ARG(aCallback);
+
+  // The headless clipboard is in-memory, so there is nothing to wait for.
+  aCallback->OnComplete(GetData(aTransferable, aWhichClipboard));
+  return NS_OK;
+}
+
 NS_IMETHODIMP
 HeadlessClipboard::EmptyClipboard(int32_t aWhichClipboard) {
   if (aWhichClipboard != kGlobalClipboard) {
@@ -76,6 +76,18 @@ NS_IMETHODIMP nsBaseClipboard::GetData(nsITransferable* aTransferable,
   return NS_ERROR_FAILURE;
 }
 
+NS_IMETHODIMP nsBaseClipboard::AsyncGetData(
+    nsITransferable* aTransferable, int32_t aWhichClipboard,
+    nsIClipboardDataCallback* aCallback) {
+  NS_ENSURE_ARG(aCallback);
+
+  // The native clipboard can only be read from the main thread, so complete
+  // the request right away. The asynchronous path only pays off in the
+  // content process, where nsClipboardProxy avoids a sync IPC round trip.
+  aCallback->OnComplete(GetData(aTransferable, aWhichClipboard));
+  return NS_OK;
+}
+
 NS_IMETHODIMP nsBaseClipboard::EmptyClipboard(int32_t aWhichClipboard) {
   bool selectClipPresent;
   SupportsSelectionClipboard(&selectClipPresent);
@@ -16,9 +16,21 @@
 using namespace mozilla;
 using namespace mozilla::dom;
 
+namespace {
+
+// How long a cached clipboard snapshot stays usable. Another application can
+// change the OS clipboard behind our back without us being notified, so
+// repeated requests are only answered from the cache for a short window --
+// long enough to cover a burst of paste-preview requests, short enough that
+// an actual paste after a clipboard change sees fresh data.
+const double kClipboardCacheTimeoutMs = 500.0;
+
+}  // namespace
+
 NS_IMPL_ISUPPORTS(nsClipboardProxy, nsIClipboard, nsIClipboardProxy)
 
-nsClipboardProxy::nsClipboardProxy() : mClipboardCaps(false, false) {}
+nsClipboardProxy::nsClipboardProxy()
+    : mClipboardCaps(false, false), mCachedClipboard(-1) {}
 
 NS_IMETHODIMP
 nsClipboardProxy::SetData(nsITransferable* aTransferable,
@@ -37,6 +49,7 @@ nsClipboardProxy::SetData(nsITransferable* aTransferable,
                           IPC::Principal(requestingPrincipal),
                           contentPolicyType, aWhichClipboard);
 
+  InvalidateCache();
   return NS_OK;
 }
 
@@ -46,67 +59,158 @@ nsClipboardProxy::GetData(nsITransferable* aTransferable,
   nsTArray<nsCString> types;
   aTransferable->FlavorsTransferableCanImport(types);
 
-  nsresult rv;
-  IPCDataTransfer dataTransfer;
-  ContentChild::GetSingleton()->SendGetClipboard(types, aWhichClipboard,
-                                                 &dataTransfer);
+  if (!HasValidCache(types, aWhichClipboard)) {
+    IPCDataTransfer dataTransfer;
+    ContentChild::GetSingleton()->SendGetClipboard(types, aWhichClipboard,
+                                                   &dataTransfer);
+
+    nsresult rv = CacheDataTransfer(types, aWhichClipboard, dataTransfer);
+    NS_ENSURE_SUCCESS(rv, rv);
+  }
+
+  return FillTransferableFromCache(aTransferable);
+}
+
+NS_IMETHODIMP
+nsClipboardProxy::AsyncGetData(nsITransferable* aTransferable,
+                               int32_t aWhichClipboard,
+                               nsIClipboardDataCallback* aCallback) {
+  NS_ENSURE_ARG(aTransferable);
+  NS_ENSURE_ARG(aCallback);
+
+  nsTArray<nsCString> types;
+  aTransferable->FlavorsTransferableCanImport(types);
 
-  auto& items = dataTransfer.items();
+  if (HasValidCache(types, aWhichClipboard)) {
+    aCallback->OnComplete(FillTransferableFromCache(aTransferable));
+    return NS_OK;
+  }
+
+  RefPtr<nsClipboardProxy> self = this;
+  nsCOMPtr<nsITransferable> transferable = aTransferable;
+  nsCOMPtr<nsIClipboardDataCallback> callback = aCallback;
+  ContentChild::GetSingleton()->SendGetClipboardAsync(
+      types, aWhichClipboard,
+      [self, transferable, callback, types = types.Clone(), aWhichClipboard](
+          const IPCDataTransfer& aDataTransfer) {
+        nsresult rv =
+            self->CacheDataTransfer(types, aWhichClipboard, aDataTransfer);
+        if (NS_SUCCEEDED(rv)) {
+          rv = self->FillTransferableFromCache(transferable);
+        }
+        callback->OnComplete(rv);
+      },
+      [callback](mozilla::ipc::ResponseRejectReason) {
+        callback->OnComplete(NS_ERROR_FAILURE);
+      });
+
+  return NS_OK;
+}
+
+nsresult nsClipboardProxy::CacheDataTransfer(
+    const nsTArray<nsCString>& aTypes, int32_t aWhichClipboard,
+    const IPCDataTransfer& aDataTransfer) {
+  InvalidateCache();
+
+  auto& items = aDataTransfer.items();
   for (uint32_t j = 0; j < items.Length(); ++j) {
     const IPCDataTransferItem& item = items[j];
 
     if (item.data().type() == IPCDataTransferData::TnsString) {
+      CachedClipboardItem* cached = mCachedItems.AppendElement();
+      cached->mFlavor = item.flavor();
+      cached->mIsString = true;
+      cached->mIsStream = false;
+      cached->mString = item.data().get_nsString();
+    } else if (item.data().type() == IPCDataTransferData::TShmem) {
+      const nsCString& flavor = item.flavor();
+      mozilla::ipc::Shmem data = item.data().get_Shmem();
+      // Images are handed to transferables as an nsIInputStream, some other
+      // flavors as an nsISupportsCString; either way the raw bytes are what
+      // gets cached.
+      bool isStream = flavor.EqualsLiteral(kJPEGImageMime) ||
+                      flavor.EqualsLiteral(kJPGImageMime) ||
+                      flavor.EqualsLiteral(kPNGImageMime) ||
+                      flavor.EqualsLiteral(kGIFImageMime);
+      if (isStream || flavor.EqualsLiteral(kNativeHTMLMime) ||
+          flavor.EqualsLiteral(kRTFMime) ||
+          flavor.EqualsLiteral(kCustomTypesMime)) {
+        CachedClipboardItem* cached = mCachedItems.AppendElement();
+        cached->mFlavor = flavor;
+        cached->mIsString = false;
+        cached->mIsStream = isStream;
+        cached->mBytes.Assign(data.get<char>(), data.Size<char>());
+      }
+
+      mozilla::Unused << ContentChild::GetSingleton()->DeallocShmem(data);
+    }
+  }
+
+  mCachedTypes = aTypes.Clone();
+  mCachedClipboard = aWhichClipboard;
+  mCacheTimestamp = TimeStamp::Now();
+  return NS_OK;
+}
+
+nsresult nsClipboardProxy::FillTransferableFromCache(
+    nsITransferable* aTransferable) {
+  nsresult rv;
+  for (uint32_t j = 0; j < mCachedItems.Length(); ++j) {
+    const CachedClipboardItem& item = mCachedItems[j];
+
+    if (item.mIsString) {
       nsCOMPtr<nsISupportsString> dataWrapper =
           do_CreateInstance(NS_SUPPORTS_STRING_CONTRACTID, &rv);
       NS_ENSURE_SUCCESS(rv, rv);
 
-      const nsString& data = item.data().get_nsString();
-      rv = dataWrapper->SetData(data);
+      rv = dataWrapper->SetData(item.mString);
       NS_ENSURE_SUCCESS(rv, rv);
 
-      rv = aTransferable->SetTransferData(item.flavor().get(), dataWrapper);
+      rv = aTransferable->SetTransferData(item.mFlavor.get(), dataWrapper);
       NS_ENSURE_SUCCESS(rv, rv);
-    } else if (item.data().type() == IPCDataTransferData::TShmem) {
-      // If this is an image, convert it into an nsIInputStream.
-      const nsCString& flavor = item.flavor();
-      mozilla::ipc::Shmem data = item.data().get_Shmem();
-      if (flavor.EqualsLiteral(kJPEGImageMime) ||
-          flavor.EqualsLiteral(kJPGImageMime) ||
-          flavor.EqualsLiteral(kPNGImageMime) ||
-          flavor.EqualsLiteral(kGIFImageMime)) {
-        nsCOMPtr<nsIInputStream> stream;
-
-        NS_NewCStringInputStream(
-            getter_AddRefs(stream),
-            nsDependentCSubstring(data.get<char>(), data.Size<char>()));
-
-        rv = aTransferable->SetTransferData(flavor.get(), stream);
-        NS_ENSURE_SUCCESS(rv, rv);
-      } else if (flavor.EqualsLiteral(kNativeHTMLMime) ||
-                 flavor.EqualsLiteral(kRTFMime) ||
-                 flavor.EqualsLiteral(kCustomTypesMime)) {
-        nsCOMPtr<nsISupportsCString> dataWrapper =
-            do_CreateInstance(NS_SUPPORTS_CSTRING_CONTRACTID, &rv);
-        NS_ENSURE_SUCCESS(rv, rv);
-
-        rv = dataWrapper->SetData(
-            nsDependentCSubstring(data.get<char>(), data.Size<char>()));
-        NS_ENSURE_SUCCESS(rv, rv);
-
-        rv = aTransferable->SetTransferData(item.flavor().get(), dataWrapper);
-        NS_ENSURE_SUCCESS(rv, rv);
-      }
+    } else if (item.mIsStream) {
+      // Streams are single-use, so every transferable gets a fresh one over
+      // the cached bytes.
+      nsCOMPtr<nsIInputStream> stream;
+      NS_NewCStringInputStream(getter_AddRefs(stream), item.mBytes);
 
-      mozilla::Unused << ContentChild::GetSingleton()->DeallocShmem(data);
+      rv = aTransferable->SetTransferData(item.mFlavor.get(), stream);
+      NS_ENSURE_SUCCESS(rv, rv);
+    } else {
+      nsCOMPtr<nsISupportsCString> dataWrapper =
+          do_CreateInstance(NS_SUPPORTS_CSTRING_CONTRACTID, &rv);
+      NS_ENSURE_SUCCESS(rv, rv);
+
+      rv = dataWrapper->SetData(item.mBytes);
+      NS_ENSURE_SUCCESS(rv, rv);
+
+      rv = aTransferable->SetTransferData(item.mFlavor.get(), dataWrapper);
+      NS_ENSURE_SUCCESS(rv, rv);
     }
   }
 
   return NS_OK;
 }
 
+bool nsClipboardProxy::HasValidCache(const nsTArray<nsCString>& aTypes,
+                                     int32_t aWhichClipboard) const {
+  return !mCacheTimestamp.IsNull() && mCachedClipboard == aWhichClipboard &&
+         mCachedTypes == aTypes &&
+         (TimeStamp::Now() - mCacheTimestamp).ToMilliseconds() <=
+             kClipboardCacheTimeoutMs;
+}
+
+void nsClipboardProxy::InvalidateCache() {
+  mCachedTypes.Clear();
+  mCachedItems.Clear();
+  mCachedClipboard = -1;
+  mCacheTimestamp = TimeStamp();
+}
+
 NS_IMETHODIMP
 nsClipboardProxy::EmptyClipboard(int32_t aWhichClipboard) {
   ContentChild::GetSingleton()->SendEmptyClipboard(aWhichClipboard);
+  InvalidateCache();
   return NS_OK;
 }
 
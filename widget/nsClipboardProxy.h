@@ -8,6 +8,8 @@
 
 #include "nsIClipboard.h"
 #include "mozilla/dom/PContent.h"
+#include "mozilla/TimeStamp.h"
+#include "nsTArray.h"
 
 #define NS_CLIPBOARDPROXY_IID                        \
   {                                                  \
@@ -42,7 +44,47 @@ class nsClipboardProxy final : public nsIClipboardProxy {
  private:
   ~nsClipboardProxy() = default;
 
+  // One decoded flavor from the most recent clipboard fetch. Stream flavors
+  // (image data) keep their raw bytes here; input streams are single-use, so
+  // a fresh stream is minted for every transferable they are copied into.
+  struct CachedClipboardItem {
+    nsCString mFlavor;
+    // True if the parent sent this flavor as a 16-bit string (mString);
+    // otherwise the payload is the raw bytes in mBytes.
+    bool mIsString;
+    // True if the flavor is handed to transferables as an nsIInputStream
+    // rather than an nsISupportsCString.
+    bool mIsStream;
+    nsString mString;
+    nsCString mBytes;
+  };
+
+  // Replace the cache with the decoded contents of aDataTransfer, which was
+  // the parent's answer to a fetch of aTypes from aWhichClipboard. Takes
+  // ownership of (and deallocates) any shmem in aDataTransfer.
+  nsresult CacheDataTransfer(
+      const nsTArray<nsCString>& aTypes, int32_t aWhichClipboard,
+      const mozilla::dom::IPCDataTransfer& aDataTransfer);
+
+  // Copy the cached flavors into aTransferable.
+  nsresult FillTransferableFromCache(nsITransferable* aTransferable);
+
+  // Whether the cache can answer a fetch of aTypes from aWhichClipboard
+  // without another round trip to the parent.
+  bool HasValidCache(const nsTArray<nsCString>& aTypes,
+                     int32_t aWhichClipboard) const;
+
+  void InvalidateCache();
+
   ClipboardCapabilities mClipboardCaps;
+
+  // Short-lived decoded-flavor cache. Paste previews request the same
+  // flavors several times in quick succession; answering repeats from here
+  // avoids refetching and redecoding the data each time.
+  nsTArray<nsCString> mCachedTypes;
+  nsTArray<CachedClipboardItem> mCachedItems;
+  int32_t mCachedClipboard;
+  mozilla::TimeStamp mCacheTimestamp;
 };
 
 #endif
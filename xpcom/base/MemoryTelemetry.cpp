@@ -13,10 +13,14 @@
 #include "mozilla/Services.h"
 #include "mozilla/ScopeExit.h"
 #include "mozilla/SimpleEnumerator.h"
+#include "mozilla/StaticPrefs_memory.h"
 #include "mozilla/Telemetry.h"
 #include "mozilla/TimeStamp.h"
+#include "mozilla/Unused.h"
+#include "mozilla/dom/BrowserParent.h"
 #include "mozilla/dom/ContentParent.h"
 #include "mozilla/dom/ScriptSettings.h"
+#include "GeckoProfiler.h"
 #include "nsContentUtils.h"
 #include "nsIBrowserDOMWindow.h"
 #include "nsIDOMChromeWindow.h"
@@ -31,6 +35,7 @@
 #include "nsXULAppAPI.h"
 #include "xpcpublic.h"
 
+#include <algorithm>
 #include <cstdlib>
 
 using namespace mozilla;
@@ -269,6 +274,21 @@ nsresult MemoryTelemetry::GatherReports(
   RECORD(PAGE_FAULTS_HARD, PageFaultsHard, UNITS_COUNT_CUMULATIVE);
 #endif
 
+  // Drain the sampled allocation census gathered by the profiler's memory
+  // hooks, keyed by the upper bound of each power-of-two size class.
+  uint64_t sampledAllocs[PROFILER_ALLOC_SIZE_CLASSES];
+  if (profiler_get_sampled_allocation_counts(sampledAllocs)) {
+    for (size_t i = 0; i < PROFILER_ALLOC_SIZE_CLASSES; i++) {
+      if (sampledAllocs[i]) {
+        nsAutoCString key;
+        key.AppendInt(uint64_t(1) << i);
+        Telemetry::Accumulate(
+            Telemetry::MEMORY_SAMPLED_ALLOCATIONS, key,
+            uint32_t(std::min<uint64_t>(sampledAllocs[i], UINT32_MAX)));
+      }
+    }
+  }
+
   RefPtr<Runnable> completionRunnable;
   if (aCompletionCallback) {
     completionRunnable = NS_NewRunnableFunction(__func__, aCompletionCallback);
@@ -315,19 +335,25 @@ NS_IMPL_ISUPPORTS(MemoryTelemetry::TotalMemoryGatherer, nsITimerCallback)
 void MemoryTelemetry::TotalMemoryGatherer::Begin(nsIEventTarget* aThreadPool) {
   nsCOMPtr<nsISerialEventTarget> target = GetMainThreadSerialEventTarget();
 
+  RefPtr<TotalMemoryGatherer> self{this};
+
   nsTArray<ContentParent*> parents;
   ContentParent::GetAll(parents);
   for (auto& parent : parents) {
     mRemainingChildCount++;
+    RefPtr<ContentParent> child = parent;
     parent->SendGetMemoryUniqueSetSize()->Then(
-        target, "TotalMemoryGather::Begin", this,
-        &TotalMemoryGatherer::CollectResult, &TotalMemoryGatherer::OnFailure);
+        target, "TotalMemoryGather::Begin",
+        [self, child](int64_t aChildUSS) {
+          self->CollectResult(child, aChildUSS);
+        },
+        [self](mozilla::ipc::ResponseRejectReason aReason) {
+          self->OnFailure(aReason);
+        });
   }
 
   mChildSizes.SetCapacity(mRemainingChildCount);
 
-  RefPtr<TotalMemoryGatherer> self{this};
-
   aThreadPool->Dispatch(
       NS_NewRunnableFunction(
           "TotalMemoryGather::Begin",
@@ -399,6 +425,20 @@ nsresult MemoryTelemetry::TotalMemoryGatherer::MaybeFinish() {
     }
   }
 
+  // Rather than broadcasting memory-pressure to every process, direct a
+  // single minimization request at the one background process that is
+  // actually bloated, if any. The foreground process and well-behaved
+  // processes keep their caches warm.
+  const int64_t threshold =
+      int64_t(StaticPrefs::memory_targeted_minimization_uss_threshold_kb()) *
+      1024;
+  if (StaticPrefs::memory_targeted_minimization_enabled() &&
+      mLargestBackgroundChild && mLargestBackgroundChild->IsAlive() &&
+      mLargestBackgroundChildUSS > threshold) {
+    Unused << mLargestBackgroundChild->SendFlushMemory(u"heap-minimize"_ns);
+  }
+  mLargestBackgroundChild = nullptr;
+
   // This notification is for testing only.
   if (nsCOMPtr<nsIObserverService> obs = services::GetObserverService()) {
     obs->NotifyObservers(nullptr, "gather-memory-telemetry-finished", nullptr);
@@ -415,12 +455,33 @@ void MemoryTelemetry::TotalMemoryGatherer::CollectParentSize(
   MaybeFinish();
 }
 
-void MemoryTelemetry::TotalMemoryGatherer::CollectResult(int64_t aChildUSS) {
+/**
+ * Returns true if any tab hosted by the given process is currently in the
+ * foreground. Purging the caches of such a process would only make work the
+ * user is waiting on slower.
+ */
+static bool HasForegroundTab(ContentParent* aProcess) {
+  for (const auto& browserWrapper : aProcess->ManagedPBrowserParent()) {
+    auto* browser = static_cast<dom::BrowserParent*>(browserWrapper.GetKey());
+    if (browser->GetDocShellIsActive()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void MemoryTelemetry::TotalMemoryGatherer::CollectResult(ContentParent* aChild,
+                                                         int64_t aChildUSS) {
   mChildSizes.AppendElement(aChildUSS);
 
   mTotalMemory += aChildUSS;
   mRemainingChildCount--;
 
+  if (aChildUSS > mLargestBackgroundChildUSS && !HasForegroundTab(aChild)) {
+    mLargestBackgroundChild = aChild;
+    mLargestBackgroundChildUSS = aChildUSS;
+  }
+
   MaybeFinish();
 }
 
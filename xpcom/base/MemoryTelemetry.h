@@ -7,6 +7,7 @@
 #ifndef mozilla_MemoryTelemetry_h
 #define mozilla_MemoryTelemetry_h
 
+#include "mozilla/RefPtr.h"
 #include "mozilla/TimeStamp.h"
 #include "mozilla/Result.h"
 #include "nsIObserver.h"
@@ -20,6 +21,10 @@ class nsIEventTarget;
 
 namespace mozilla {
 
+namespace dom {
+class ContentParent;
+}
+
 namespace ipc {
 enum class ResponseRejectReason;
 }
@@ -66,7 +71,7 @@ class MemoryTelemetry final : public nsIObserver,
     TotalMemoryGatherer() = default;
 
     void CollectParentSize(int64_t aResident);
-    void CollectResult(int64_t aChildUSS);
+    void CollectResult(dom::ContentParent* aChild, int64_t aChildUSS);
     void OnFailure(ipc::ResponseRejectReason aReason);
 
     void Begin(nsIEventTarget* aThreadPool);
@@ -80,6 +85,14 @@ class MemoryTelemetry final : public nsIObserver,
 
     nsTArray<int64_t> mChildSizes;
 
+    /**
+     * The content process with the largest unique set size that has no
+     * foreground tab, and its USS. MaybeFinish() may single this process
+     * out for a targeted memory minimization.
+     */
+    RefPtr<dom::ContentParent> mLargestBackgroundChild;
+    int64_t mLargestBackgroundChildUSS = 0;
+
     int64_t mTotalMemory = 0;
     uint32_t mRemainingChildCount = 0;
 
@@ -1504,6 +1504,13 @@ inline already_AddRefed<T> do_AddRef(const nsCOMPtr<T>& aObj) {
   return ref.forget();
 }
 
+// An expiring nsCOMPtr already owns a reference we can steal, so no refcount
+// traffic is needed at all.
+template <class T>
+inline already_AddRefed<T> do_AddRef(nsCOMPtr<T>&& aObj) {
+  return aObj.forget();
+}
+
 // MOZ_DBG support
 
 template <class T>
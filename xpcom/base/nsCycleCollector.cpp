@@ -1308,7 +1308,15 @@ MOZ_NEVER_INLINE void GraphWalker<Visitor>::DoWalk(nsDeque<PtrInfo>& aQueue) {
       for (EdgePool::Iterator child = pi->FirstChild(),
                               child_end = pi->LastChild();
            child != child_end; ++child) {
-        CheckedPush(aQueue, *child);
+        // Only queue children the visitor would still visit.  A child can
+        // only move towards rejection (color changes are monotone), so a
+        // node skipped here would be skipped at pop time too, and on dense
+        // graphs most edges point at already-black nodes.  The check is
+        // repeated after popping since the node may change color while it
+        // sits in the queue.
+        if (mVisitor.ShouldVisitNode(*child)) {
+          CheckedPush(aQueue, *child);
+        }
       }
     }
   }
@@ -6,7 +6,7 @@
 
 #include "nsID.h"
 #include "nsMemory.h"
-#include "mozilla/Sprintf.h"
+#include "mozilla/Assertions.h"
 
 void nsID::Clear() {
   m0 = 0;
@@ -96,8 +96,20 @@ bool nsID::Parse(const char* aIDStr) {
 
 #ifndef XPCOM_GLUE_AVOID_NSPR
 
-static const char gIDFormat[] =
-    "{%08x-%04x-%04x-%02x%02x-%02x%02x%02x%02x%02x%02x}";
+/*
+ * Writes the aDigits least significant hexadecimal digits of aValue into
+ * aDest, most significant digit first, and returns the position just past
+ * the last digit written.
+ */
+
+static char* WriteHexDigits(char* aDest, uint32_t aValue, uint32_t aDigits) {
+  static const char kHexChars[] = "0123456789abcdef";
+  for (uint32_t i = aDigits; i > 0; --i) {
+    aDest[i - 1] = kHexChars[aValue & 0xF];
+    aValue >>= 4;
+  }
+  return aDest + aDigits;
+}
 
 /*
  * Returns an allocated string in {xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx}
@@ -107,17 +119,30 @@ static const char gIDFormat[] =
 
 char* nsID::ToString() const {
   char* res = (char*)moz_xmalloc(NSID_LENGTH);
-  snprintf(res, NSID_LENGTH, gIDFormat, m0, (uint32_t)m1, (uint32_t)m2,
-           (uint32_t)m3[0], (uint32_t)m3[1], (uint32_t)m3[2], (uint32_t)m3[3],
-           (uint32_t)m3[4], (uint32_t)m3[5], (uint32_t)m3[6], (uint32_t)m3[7]);
+  ToProvidedString(*reinterpret_cast<char(*)[NSID_LENGTH]>(res));
   return res;
 }
 
 void nsID::ToProvidedString(char (&aDest)[NSID_LENGTH]) const {
-  SprintfLiteral(aDest, gIDFormat, m0, (uint32_t)m1, (uint32_t)m2,
-                 (uint32_t)m3[0], (uint32_t)m3[1], (uint32_t)m3[2],
-                 (uint32_t)m3[3], (uint32_t)m3[4], (uint32_t)m3[5],
-                 (uint32_t)m3[6], (uint32_t)m3[7]);
+  // Hand-rolled formatting; this is hot enough in component manager and
+  // logging paths that going through snprintf shows up in profiles.
+  char* p = aDest;
+  *p++ = '{';
+  p = WriteHexDigits(p, m0, 8);
+  *p++ = '-';
+  p = WriteHexDigits(p, m1, 4);
+  *p++ = '-';
+  p = WriteHexDigits(p, m2, 4);
+  *p++ = '-';
+  p = WriteHexDigits(p, m3[0], 2);
+  p = WriteHexDigits(p, m3[1], 2);
+  *p++ = '-';
+  for (int i = 2; i < 8; ++i) {
+    p = WriteHexDigits(p, m3[i], 2);
+  }
+  *p++ = '}';
+  *p = '\0';
+  MOZ_ASSERT(p + 1 == aDest + NSID_LENGTH);
 }
 
 #endif  // XPCOM_GLUE_AVOID_NSPR
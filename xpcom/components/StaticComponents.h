@@ -8,6 +8,7 @@
 #define StaticComponents_h
 
 #include "mozilla/AlreadyAddRefed.h"
+#include "mozilla/Atomics.h"
 #include "mozilla/Module.h"
 #include "mozilla/Span.h"
 #include "nsID.h"
@@ -35,14 +36,17 @@ struct StaticCategory;
 extern const StaticModule gStaticModules[kStaticModuleCount];
 
 extern const ContractEntry gContractEntries[kContractCount];
-extern uint8_t gInvalidContracts[kContractCount / 8 + 1];
+// The invalidation bits are atomic so the otherwise-immutable contract table
+// can be consulted without holding the component manager's lock.
+extern Atomic<uint8_t, Relaxed> gInvalidContracts[kContractCount / 8 + 1];
 
 extern const StaticCategory gStaticCategories[kStaticCategoryCount];
 extern const StaticCategoryEntry gStaticCategoryEntries[];
 
 template <size_t N>
-static inline bool GetBit(const uint8_t (&aBits)[N], size_t aBit) {
-  static constexpr size_t width = sizeof(aBits[0]) * 8;
+static inline bool GetBit(const Atomic<uint8_t, Relaxed> (&aBits)[N],
+                          size_t aBit) {
+  static constexpr size_t width = sizeof(uint8_t) * 8;
 
   size_t idx = aBit / width;
   MOZ_ASSERT(idx < N);
@@ -50,9 +54,9 @@ static inline bool GetBit(const uint8_t (&aBits)[N], size_t aBit) {
 }
 
 template <size_t N>
-static inline void SetBit(uint8_t (&aBits)[N], size_t aBit,
+static inline void SetBit(Atomic<uint8_t, Relaxed> (&aBits)[N], size_t aBit,
                           bool aValue = true) {
-  static constexpr size_t width = sizeof(aBits[0]) * 8;
+  static constexpr size_t width = sizeof(uint8_t) * 8;
 
   size_t idx = aBit / width;
   MOZ_ASSERT(idx < N);
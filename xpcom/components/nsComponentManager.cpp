@@ -1326,9 +1326,19 @@ nsComponentManagerImpl::GetService(const nsCID& aClass, const nsIID& aIID,
     return NS_ERROR_UNEXPECTED;
   }
 
+  // The static component tables are immutable, so they can be consulted
+  // before taking the lock. This keeps the common lookup for startup
+  // services out of the monitor's critical section.
+  Maybe<EntryWrapper> entry;
+  if (const StaticModule* module = StaticComponents::LookupByCID(aClass)) {
+    entry.emplace(module);
+  }
+
   Maybe<MonitorAutoLock> lock(std::in_place, mLock);
 
-  Maybe<EntryWrapper> entry = LookupByCID(*lock, aClass);
+  if (!entry) {
+    entry = LookupByCID(*lock, aClass);
+  }
   if (!entry) {
     return NS_ERROR_FACTORY_NOT_REGISTERED;
   }
@@ -1460,10 +1470,24 @@ nsComponentManagerImpl::GetServiceByContractID(const char* aContractID,
 
   AUTO_PROFILER_LABEL_DYNAMIC_CSTR_NONSENSITIVE("GetServiceByContractID", OTHER,
                                                 aContractID);
+
+  nsDependentCString contractID(aContractID);
+
+  // The static contract table is immutable aside from its atomic
+  // invalidation bits, so it can be consulted before taking the lock. This
+  // keeps the common lookup for startup services out of the monitor's
+  // critical section.
+  Maybe<EntryWrapper> entry;
+  if (const StaticModule* module =
+          StaticComponents::LookupByContractID(contractID)) {
+    entry.emplace(module);
+  }
+
   Maybe<MonitorAutoLock> lock(std::in_place, mLock);
 
-  Maybe<EntryWrapper> entry =
-      LookupByContractID(*lock, nsDependentCString(aContractID));
+  if (!entry) {
+    entry = LookupByContractID(*lock, contractID);
+  }
   if (!entry) {
     return NS_ERROR_FACTORY_NOT_REGISTERED;
   }
@@ -41,7 +41,13 @@ namespace mozilla {
 template <size_t ArenaSize, size_t Alignment = 1>
 class ArenaAllocator {
  public:
-  constexpr ArenaAllocator() : mHead(), mCurrent(nullptr) {
+  constexpr ArenaAllocator()
+      : mHead(),
+        mCurrent(nullptr),
+        mRecycled(nullptr),
+        mNumRecycled(0),
+        mFootprint(0),
+        mHighWater(0) {
     static_assert(mozilla::tl::FloorLog2<Alignment>::value ==
                       mozilla::tl::CeilingLog2<Alignment>::value,
                   "ArenaAllocator alignment must be a power of two");
@@ -54,7 +60,17 @@ class ArenaAllocator {
    * Frees all internal arenas but does not call destructors for objects
    * allocated out of the arena.
    */
-  ~ArenaAllocator() { Clear(); }
+  ~ArenaAllocator() {
+    Clear();
+
+    // Free the chunks kept around for recycling.
+    auto a = mRecycled;
+    while (a) {
+      auto tmp = a;
+      a = a->next;
+      free(tmp);
+    }
+  }
 
   /**
    * Fallibly allocates a chunk of memory with the given size from the internal
@@ -82,12 +98,26 @@ class ArenaAllocator {
    * the arena.
    */
   void Clear() {
-    // Free all chunks.
+    // Keep up to kMaxRecycledChunks standard-sized chunks around instead of
+    // freeing them: hot users (the display list builder, pres arenas) clear
+    // on every cycle and would otherwise re-fault the same pages right back
+    // in. Oversized chunks and anything over the cap still go back to
+    // malloc.
     auto a = mHead.next;
     while (a) {
       auto tmp = a;
       a = a->next;
-      free(tmp);
+      if (mNumRecycled < kMaxRecycledChunks &&
+          tmp->header.tail - uintptr_t(tmp) == ArenaSize) {
+        MOZ_MAKE_MEM_NOACCESS(tmp + 1,
+                              tmp->header.tail - uintptr_t(tmp + 1));
+        tmp->next = mRecycled;
+        mRecycled = tmp;
+        mNumRecycled++;
+      } else {
+        mFootprint -= tmp->header.tail - uintptr_t(tmp);
+        free(tmp);
+      }
     }
 
     // Reset the list head.
@@ -107,10 +137,20 @@ class ArenaAllocator {
     for (auto arena = mHead.next; arena; arena = arena->next) {
       s += aMallocSizeOf(arena);
     }
+    for (auto arena = mRecycled; arena; arena = arena->next) {
+      s += aMallocSizeOf(arena);
+    }
 
     return s;
   }
 
+  /**
+   * The largest total size, in bytes, of chunks this allocator has had
+   * allocated from malloc at any one time, including recycled chunks.
+   * Useful for sizing kMaxRecycledChunks from field measurements.
+   */
+  size_t HighWaterMark() const { return mHighWater; }
+
   void Check() {
     if (mCurrent) {
       mCurrent->canary.Check();
@@ -167,9 +207,18 @@ class ArenaAllocator {
     MOZ_ASSERT(kOffset < aSize);
 
     const size_t chunkSize = aSize + kOffset;
-    void* p = malloc(chunkSize);
-    if (!p) {
-      return nullptr;
+    void* p;
+    if (mRecycled && chunkSize == ArenaSize) {
+      p = mRecycled;
+      mRecycled = mRecycled->next;
+      mNumRecycled--;
+    } else {
+      p = malloc(chunkSize);
+      if (!p) {
+        return nullptr;
+      }
+      mFootprint += chunkSize;
+      mHighWater = std::max(mHighWater, mFootprint);
     }
 
     ArenaChunk* arena = new (KnownNotNull, p) ArenaChunk(chunkSize);
@@ -205,8 +254,27 @@ class ArenaAllocator {
     return arena ? arena->Allocate(aSize) : nullptr;
   }
 
+  /**
+   * Maximum number of standard-sized chunks Clear() keeps for reuse.
+   */
+  static const size_t kMaxRecycledChunks = 8;
+
   ArenaChunk mHead;
   ArenaChunk* mCurrent;
+
+  /**
+   * Singly-linked (via |next|) list of retained standard-sized chunks, and
+   * its length.
+   */
+  ArenaChunk* mRecycled;
+  size_t mNumRecycled;
+
+  /**
+   * Current and peak total size of chunks allocated from malloc, including
+   * retained ones.
+   */
+  size_t mFootprint;
+  size_t mHighWater;
 };
 
 }  // namespace mozilla
@@ -307,6 +307,51 @@ void PLDHashTable::ClearAndPrepareForLength(uint32_t aLength) {
 
 void PLDHashTable::Clear() { ClearAndPrepareForLength(kDefaultInitialLength); }
 
+// The probe sequence visits the table one group of kGroupSize slots at a
+// time.  Slots within a group are scanned in-order (wrapping within the
+// group), and successive groups are chosen by double hashing on the group
+// index, so the sequence still visits every slot exactly once.  Because the
+// cached hashes live in a dense prefix array (see the comment in
+// PLDHashTable.h), one group's worth of hashes shares a cache line, so a
+// collision chain that stays within a group costs no additional misses, and
+// the search path can scan a whole group's hashes with SIMD before touching
+// any entry.
+static constexpr uint32_t kGroupSize = 16;
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define PLDHASH_SSE2_GROUP_SCAN 1
+#  include <emmintrin.h>
+#endif
+
+#ifdef PLDHASH_SSE2_GROUP_SCAN
+// Returns a pair of bitmasks over a full group's hashes: bit i of the first
+// is set if hash i matches aKeyHash (ignoring the collision flag), bit i of
+// the second if slot i is free.
+static MOZ_ALWAYS_INLINE void ScanGroupHashes(const PLDHashNumber* aHashes,
+                                              PLDHashNumber aKeyHash,
+                                              uint32_t& aMatchMask,
+                                              uint32_t& aFreeMask) {
+  const __m128i needle = _mm_set1_epi32(static_cast<int32_t>(aKeyHash));
+  const __m128i collision = _mm_set1_epi32(1);  // kCollisionFlag
+  const __m128i zero = _mm_setzero_si128();
+  aMatchMask = 0;
+  aFreeMask = 0;
+  for (uint32_t i = 0; i < kGroupSize; i += 4) {
+    const __m128i h =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(aHashes + i));
+    const __m128i stripped = _mm_andnot_si128(collision, h);
+    aMatchMask |=
+        uint32_t(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(
+            stripped, needle))))
+        << i;
+    aFreeMask |=
+        uint32_t(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(h, zero))))
+        << i;
+  }
+}
+#endif
+
 // If |Reason| is |ForAdd|, the return value is always non-null and it may be
 // a previously-removed entry. If |Reason| is |ForSearchOrRemove|, the return
 // value is null on a miss, and will never be a previously-removed entry on a
@@ -321,59 +366,86 @@ MOZ_ALWAYS_INLINE auto PLDHashTable::SearchTable(const void* aKey,
   MOZ_ASSERT(mEntryStore.IsAllocated());
   NS_ASSERTION(!(aKeyHash & kCollisionFlag), "!(aKeyHash & kCollisionFlag)");
 
-  // Compute the primary hash address.
-  PLDHashNumber hash1 = Hash1(aKeyHash);
-  Slot slot = SlotForIndex(hash1);
-
-  // Miss: return space for a new entry.
-  if (slot.IsFree()) {
-    return (Reason == ForAdd) ? aSuccess(slot) : aFailure();
-  }
+  const uint32_t capacity = CapacityFromHashShift();
+  const uint32_t groupSize = capacity < kGroupSize ? capacity : kGroupSize;
+  const uint32_t inGroupMask = groupSize - 1;
 
-  // Hit: return entry.
-  PLDHashMatchEntry matchEntry = mOps->matchEntry;
-  if (MatchSlotKeyhash(slot, aKeyHash)) {
-    PLDHashEntryHdr* e = slot.ToEntry();
-    if (matchEntry(e, aKey)) {
-      return aSuccess(slot);
-    }
-  }
-
-  // Collision: double hash.
+  const PLDHashNumber hash1 = Hash1(aKeyHash);
   PLDHashNumber hash2;
   uint32_t sizeMask;
   Hash2(aKeyHash, hash2, sizeMask);
 
+  // Double hash over group indices; hash2 is odd, so masking it down keeps
+  // the step relatively prime to the (power-of-two) number of groups.
+  const uint32_t groupMask = sizeMask / groupSize;
+  const uint32_t groupStep = hash2 & groupMask;
+  uint32_t group = hash1 / groupSize;
+  const uint32_t startOffset = hash1 & inGroupMask;
+
+  PLDHashMatchEntry matchEntry = mOps->matchEntry;
+
   // Save the first removed entry slot so Add() can recycle it. (Only used
   // if Reason==ForAdd.)
   Maybe<Slot> firstRemoved;
 
   for (;;) {
-    if (Reason == ForAdd && !firstRemoved) {
-      if (MOZ_UNLIKELY(slot.IsRemoved())) {
-        firstRemoved.emplace(slot);
-      } else {
-        slot.MarkColliding();
+    const uint32_t base = group * groupSize;
+
+#ifdef PLDHASH_SSE2_GROUP_SCAN
+    if (Reason != ForAdd && groupSize == kGroupSize) {
+      const auto* hashes =
+          reinterpret_cast<const PLDHashNumber*>(mEntryStore.Get());
+      uint32_t matchMask, freeMask;
+      ScanGroupHashes(hashes + base, aKeyHash, matchMask, freeMask);
+      if (matchMask | freeMask) {
+        for (uint32_t i = 0; i < groupSize; ++i) {
+          const uint32_t pos = (startOffset + i) & inGroupMask;
+          if (freeMask & (uint32_t(1) << pos)) {
+            return aFailure();
+          }
+          if (matchMask & (uint32_t(1) << pos)) {
+            Slot slot = SlotForIndex(base + pos);
+            PLDHashEntryHdr* e = slot.ToEntry();
+            if (matchEntry(e, aKey)) {
+              return aSuccess(slot);
+            }
+          }
+        }
       }
+      group = (group - groupStep) & groupMask;
+      continue;
     }
+#endif
 
-    hash1 -= hash2;
-    hash1 &= sizeMask;
+    for (uint32_t i = 0; i < groupSize; ++i) {
+      Slot slot = SlotForIndex(base + ((startOffset + i) & inGroupMask));
 
-    slot = SlotForIndex(hash1);
-    if (slot.IsFree()) {
-      if (Reason != ForAdd) {
-        return aFailure();
+      // Miss: return space for a new entry.
+      if (slot.IsFree()) {
+        if (Reason != ForAdd) {
+          return aFailure();
+        }
+        return aSuccess(firstRemoved.refOr(slot));
       }
-      return aSuccess(firstRemoved.refOr(slot));
-    }
 
-    if (MatchSlotKeyhash(slot, aKeyHash)) {
-      PLDHashEntryHdr* e = slot.ToEntry();
-      if (matchEntry(e, aKey)) {
-        return aSuccess(slot);
+      // Hit: return entry.
+      if (MatchSlotKeyhash(slot, aKeyHash)) {
+        PLDHashEntryHdr* e = slot.ToEntry();
+        if (matchEntry(e, aKey)) {
+          return aSuccess(slot);
+        }
+      }
+
+      if (Reason == ForAdd && !firstRemoved) {
+        if (MOZ_UNLIKELY(slot.IsRemoved())) {
+          firstRemoved.emplace(slot);
+        } else {
+          slot.MarkColliding();
+        }
       }
     }
+
+    group = (group - groupStep) & groupMask;
   }
 
   // NOTREACHED
@@ -392,31 +464,32 @@ MOZ_ALWAYS_INLINE auto PLDHashTable::FindFreeSlot(PLDHashNumber aKeyHash) const
   MOZ_ASSERT(mEntryStore.IsAllocated());
   NS_ASSERTION(!(aKeyHash & kCollisionFlag), "!(aKeyHash & kCollisionFlag)");
 
-  // Compute the primary hash address.
-  PLDHashNumber hash1 = Hash1(aKeyHash);
-  Slot slot = SlotForIndex(hash1);
-
-  // Miss: return space for a new entry.
-  if (slot.IsFree()) {
-    return slot;
-  }
+  // This must mirror the probe sequence in SearchTable().
+  const uint32_t capacity = CapacityFromHashShift();
+  const uint32_t groupSize = capacity < kGroupSize ? capacity : kGroupSize;
+  const uint32_t inGroupMask = groupSize - 1;
 
-  // Collision: double hash.
+  const PLDHashNumber hash1 = Hash1(aKeyHash);
   PLDHashNumber hash2;
   uint32_t sizeMask;
   Hash2(aKeyHash, hash2, sizeMask);
 
-  for (;;) {
-    MOZ_ASSERT(!slot.IsRemoved());
-    slot.MarkColliding();
+  const uint32_t groupMask = sizeMask / groupSize;
+  const uint32_t groupStep = hash2 & groupMask;
+  uint32_t group = hash1 / groupSize;
+  const uint32_t startOffset = hash1 & inGroupMask;
 
-    hash1 -= hash2;
-    hash1 &= sizeMask;
-
-    slot = SlotForIndex(hash1);
-    if (slot.IsFree()) {
-      return slot;
+  for (;;) {
+    const uint32_t base = group * groupSize;
+    for (uint32_t i = 0; i < groupSize; ++i) {
+      Slot slot = SlotForIndex(base + ((startOffset + i) & inGroupMask));
+      if (slot.IsFree()) {
+        return slot;
+      }
+      MOZ_ASSERT(!slot.IsRemoved());
+      slot.MarkColliding();
     }
+    group = (group - groupStep) & groupMask;
   }
 
   // NOTREACHED
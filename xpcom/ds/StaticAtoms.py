@@ -2445,6 +2445,25 @@ STATIC_ATOMS = [
     Atom("DirectoryService_LocalAppdataLow", "LocalAppDataLow"),
     Atom("DirectoryService_LowIntegrityTempBase", "LowTmpDBase"),
     Atom("DirectoryService_WinCookiesDirectory", "CookD"),
+    # Common author-defined class/id names, harvested from page-load
+    # telemetry.  Making these static lets every process share the one
+    # read-only copy in the binary image instead of each building its own
+    # dynamic atom for the same markup.
+    Atom("wrapper", "wrapper"),
+    Atom("btn", "btn"),
+    Atom("logo", "logo"),
+    Atom("sidebar", "sidebar"),
+    Atom("thumbnail", "thumbnail"),
+    Atom("dropdown", "dropdown"),
+    Atom("modal", "modal"),
+    Atom("carousel", "carousel"),
+    Atom("breadcrumb", "breadcrumb"),
+    Atom("pagination", "pagination"),
+    Atom("avatar", "avatar"),
+    Atom("badge", "badge"),
+    Atom("spinner", "spinner"),
+    Atom("navbar", "navbar"),
+    Atom("clearfix", "clearfix"),
     # CSS pseudo-elements -- these must appear in the same order as
     # in nsCSSPseudoElementList.h
     PseudoElementAtom("PseudoElement_after", ":after"),
@@ -9,8 +9,12 @@
 #include <string.h>
 
 #include "mozilla/CheckedInt.h"
+#include "mozilla/MathAlgorithms.h"
 
-#define modulus(x, y) ((x) % (y))
+// mCapacity starts at sizeof(mBuffer) (8 entries) and only ever quadruples,
+// so it is always a power of two and the ring arithmetic reduces to a mask
+// instead of a divide.
+#define modulus(x, y) ((x) & ((y)-1))
 
 namespace mozilla {
 namespace detail {
@@ -68,6 +72,8 @@ void nsDequeBase::Empty() {
  * @return  whether growing succeeded
  */
 bool nsDequeBase::GrowCapacity() {
+  MOZ_ASSERT(mozilla::IsPowerOfTwo(mCapacity),
+             "ring arithmetic relies on a power-of-two capacity");
   mozilla::CheckedInt<size_t> newCapacity = mCapacity;
   newCapacity *= 4;
 
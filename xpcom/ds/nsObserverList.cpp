@@ -14,6 +14,7 @@ nsresult nsObserverList::AddObserver(nsIObserver* anObserver, bool ownsWeak) {
   NS_ASSERTION(anObserver, "Null input");
 
   MOZ_TRY(mObservers.AppendWeakElement(anObserver, ownsWeak));
+  mCachedSnapshot = nullptr;
   return NS_OK;
 }
 
@@ -21,6 +22,7 @@ nsresult nsObserverList::RemoveObserver(nsIObserver* anObserver) {
   NS_ASSERTION(anObserver, "Null input");
 
   MOZ_TRY(mObservers.RemoveWeakElement(anObserver));
+  mCachedSnapshot = nullptr;
   return NS_OK;
 }
 
@@ -51,6 +53,29 @@ nsCOMArray<nsIObserver> nsObserverList::ReverseCloneObserverArray() {
   return array;
 }
 
+already_AddRefed<nsObserverList::Snapshot> nsObserverList::GetSnapshot() {
+  RefPtr<Snapshot> snapshot = mCachedSnapshot;
+  if (snapshot) {
+    return snapshot.forget();
+  }
+
+  for (const auto& entry : mObservers) {
+    if (entry.IsWeak()) {
+      // Weak references must be re-resolved on every notification.
+      return nullptr;
+    }
+  }
+
+  snapshot = new Snapshot();
+  snapshot->mArray.SetCapacity(mObservers.Length());
+  for (int32_t i = mObservers.Length() - 1; i >= 0; --i) {
+    nsCOMPtr<nsIObserver> observer = mObservers[i].GetValue();
+    snapshot->mArray.AppendElement(observer.forget());
+  }
+  mCachedSnapshot = snapshot;
+  return snapshot.forget();
+}
+
 void nsObserverList::AppendStrongObservers(nsCOMArray<nsIObserver>& aArray) {
   aArray.SetCapacity(aArray.Length() + mObservers.Length());
 
@@ -64,6 +89,13 @@ void nsObserverList::AppendStrongObservers(nsCOMArray<nsIObserver>& aArray) {
 
 void nsObserverList::NotifyObservers(nsISupports* aSubject, const char* aTopic,
                                      const char16_t* someData) {
+  if (RefPtr<Snapshot> snapshot = GetSnapshot()) {
+    for (int32_t i = 0; i < snapshot->mArray.Count(); ++i) {
+      snapshot->mArray[i]->Observe(aSubject, aTopic, someData);
+    }
+    return;
+  }
+
   const nsCOMArray<nsIObserver> observers = ReverseCloneObserverArray();
 
   for (int32_t i = 0; i < observers.Count(); ++i) {
@@ -46,7 +46,29 @@ class nsObserverList : public nsCharPtrHashKey {
   void AppendStrongObservers(nsCOMArray<nsIObserver>& aArray);
 
  private:
+  // An immutable, reference-counted snapshot of the observers, shared
+  // between NotifyObservers() calls until the list changes.  Only built when
+  // every observer is strongly held: caching resolved weak references would
+  // keep weakly-held observers alive past their death.  Notification holds
+  // its own reference, so observers added or removed from inside Observe()
+  // invalidate the cache without disturbing the notification in flight --
+  // the same semantics the per-call clone gave us.
+  class Snapshot {
+   public:
+    NS_INLINE_DECL_REFCOUNTING(Snapshot)
+
+    nsCOMArray<nsIObserver> mArray;
+
+   private:
+    ~Snapshot() = default;
+  };
+
+  // Returns the cached snapshot, building it if needed; returns null when
+  // the list contains weak references and the caller must clone instead.
+  already_AddRefed<Snapshot> GetSnapshot();
+
   nsMaybeWeakPtrArray<nsIObserver> mObservers;
+  RefPtr<Snapshot> mCachedSnapshot;
 };
 
 class nsObserverEnumerator final : public nsSimpleEnumerator {
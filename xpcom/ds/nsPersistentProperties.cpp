@@ -339,10 +339,17 @@ nsresult nsPropertiesParser::ParseBuffer(const char16_t* aBuffer,
         break;
 
       case eParserState_Key:
-        if (c == '=' || c == ':') {
-          mKey += Substring(tokenStart, cur);
-          WaitForValue();
+        // Keys are terminated only by '=' or ':', so skip to the terminator
+        // in one tight scan instead of re-entering the switch per character.
+        while (cur != end && *cur != '=' && *cur != ':') {
+          ++cur;
         }
+        if (cur == end) {
+          // Ran off the buffer; the partial-key append below picks this up.
+          continue;
+        }
+        mKey += Substring(tokenStart, cur);
+        WaitForValue();
         break;
 
       case eParserState_AwaitingValue:
@@ -370,6 +377,20 @@ nsresult nsPropertiesParser::ParseBuffer(const char16_t* aBuffer,
         break;
 
       case eParserState_Value:
+        // Ordinary value characters need no per-character work — they are
+        // picked up by the Substring appends at escape/EOL/buffer
+        // boundaries — so fast-forward over them while no escape or
+        // multiline continuation is pending.
+        if (mSpecialState == eParserSpecial_None && !mHaveMultiLine) {
+          while (cur != end && *cur != '\\' && !IsEOL(*cur)) {
+            ++cur;
+          }
+          if (cur == end) {
+            // The partial-value append below keeps what we have.
+            continue;
+          }
+          c = *cur;
+        }
         if (ParseValueCharacter(c, cur, tokenStart, oldValue)) {
           cur++;
         }
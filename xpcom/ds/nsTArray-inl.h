@@ -158,13 +158,19 @@ nsTArray_base<Alloc, RelocationStrategy>::EnsureCapacity(size_type aCapacity,
   size_t reqSize = sizeof(Header) + aCapacity * aElemSize;
 
   if (HasEmptyHeader()) {
-    // Malloc() new data
-    Header* header = static_cast<Header*>(ActualAlloc::Malloc(reqSize));
+    // Malloc() new data.  Round small first allocations up to the next power
+    // of two, as growth from a non-empty buffer does below; malloc would hand
+    // us a full size class anyway, and using the slop up front spares callers
+    // that append in a tight loop from a cascade of tiny initial reallocs.
+    size_t bytesToAlloc = reqSize < 8 * 1024 * 1024
+                              ? mozilla::RoundUpPow2(reqSize)
+                              : reqSize;
+    Header* header = static_cast<Header*>(ActualAlloc::Malloc(bytesToAlloc));
     if (!header) {
       return ActualAlloc::FailureResult();
     }
     header->mLength = 0;
-    header->mCapacity = aCapacity;
+    header->mCapacity = (bytesToAlloc - sizeof(Header)) / aElemSize;
     header->mIsAutoArray = 0;
     mHdr = header;
 
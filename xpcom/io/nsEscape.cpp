@@ -16,7 +16,6 @@
 #include "nsASCIIMask.h"
 
 static const char hexCharsUpper[] = "0123456789ABCDEF";
-static const char hexCharsUpperLower[] = "0123456789ABCDEFabcdef";
 
 static const int netCharType[256] =
     // clang-format off
@@ -112,12 +111,26 @@ char* nsEscape(const char* aStr, size_t aLength, size_t* aOutputLength,
 
   unsigned char* dst = (unsigned char*)result;
   src = (const unsigned char*)aStr;
-  if (aFlags == url_XPAlphas) {
-    for (size_t i = 0; i < aLength; ++i) {
+  const unsigned char* end = src + aLength;
+  if (charsToEscape == 0) {
+    /* nothing needs escaping (note that a space is not an OK character,
+     * so this is also safe for url_XPAlphas); copy wholesale */
+    memcpy(dst, src, aLength);
+    dst += aLength;
+  } else if (aFlags == url_XPAlphas) {
+    while (src != end) {
+      /* copy the run of OK characters in one go */
+      const unsigned char* runStart = src;
+      while (src != end && IS_OK(*src)) {
+        ++src;
+      }
+      memcpy(dst, runStart, src - runStart);
+      dst += src - runStart;
+      if (src == end) {
+        break;
+      }
       unsigned char c = *src++;
-      if (IS_OK(c)) {
-        *dst++ = c;
-      } else if (c == ' ') {
+      if (c == ' ') {
         *dst++ = '+'; /* convert spaces to pluses */
       } else {
         *dst++ = HEX_ESCAPE;
@@ -126,15 +139,21 @@ char* nsEscape(const char* aStr, size_t aLength, size_t* aOutputLength,
       }
     }
   } else {
-    for (size_t i = 0; i < aLength; ++i) {
-      unsigned char c = *src++;
-      if (IS_OK(c)) {
-        *dst++ = c;
-      } else {
-        *dst++ = HEX_ESCAPE;
-        *dst++ = hexCharsUpper[c >> 4];   /* high nibble */
-        *dst++ = hexCharsUpper[c & 0x0f]; /* low nibble */
+    while (src != end) {
+      /* copy the run of OK characters in one go */
+      const unsigned char* runStart = src;
+      while (src != end && IS_OK(*src)) {
+        ++src;
+      }
+      memcpy(dst, runStart, src - runStart);
+      dst += src - runStart;
+      if (src == end) {
+        break;
       }
+      unsigned char c = *src++;
+      *dst++ = HEX_ESCAPE;
+      *dst++ = hexCharsUpper[c >> 4];   /* high nibble */
+      *dst++ = hexCharsUpper[c & 0x0f]; /* low nibble */
     }
   }
 
@@ -161,11 +180,6 @@ int32_t nsUnescapeCount(char* aStr)
   char* src = aStr;
   char* dst = aStr;
 
-  char c1[] = " ";
-  char c2[] = " ";
-  char* const pc1 = c1;
-  char* const pc2 = c2;
-
   if (!*src) {
     // A null string was passed in.  Nothing to escape.
     // Returns early as the string might not actually be mutable with
@@ -174,27 +188,27 @@ int32_t nsUnescapeCount(char* aStr)
   }
 
   while (*src) {
-    c1[0] = *(src + 1);
-    if (*(src + 1) == '\0') {
-      c2[0] = '\0';
-    } else {
-      c2[0] = *(src + 2);
+    if (*src != HEX_ESCAPE) {
+      // Move the run up to the next escape (or the end of the string) in one
+      // go; most strings contain few or no escapes.
+      char* next = strchr(src, HEX_ESCAPE);
+      size_t runLength = next ? size_t(next - src) : strlen(src);
+      if (dst != src) {
+        memmove(dst, src, runLength);
+      }
+      dst += runLength;
+      src += runLength;
+      continue;
     }
 
-    if (*src != HEX_ESCAPE || PL_strpbrk(pc1, hexCharsUpperLower) == 0 ||
-        PL_strpbrk(pc2, hexCharsUpperLower) == 0) {
-      *dst++ = *src++;
+    // Reading src[2] is safe here because IsAsciiHexDigit short-circuits on
+    // a null src[1].
+    if (mozilla::IsAsciiHexDigit(src[1]) && mozilla::IsAsciiHexDigit(src[2])) {
+      *dst++ = char((UNHEX(src[1]) << 4) + UNHEX(src[2]));
+      src += 3;
     } else {
-      src++; /* walk over escape */
-      if (*src) {
-        *dst = UNHEX(*src) << 4;
-        src++;
-      }
-      if (*src) {
-        *dst = (*dst + UNHEX(*src));
-        src++;
-      }
-      dst++;
+      // Not a valid escape sequence; copy the '%' through unchanged.
+      *dst++ = *src++;
     }
   }
 
@@ -213,7 +227,19 @@ void nsAppendEscapedHTML(const nsACString& aSrc, nsACString& aDst) {
     aDst.SetCapacity(newCapacity.value());
   }
 
-  for (auto cur = aSrc.BeginReading(); cur != aSrc.EndReading(); cur++) {
+  const char* end = aSrc.EndReading();
+  for (auto cur = aSrc.BeginReading(); cur != end;) {
+    // Append runs that need no escaping in one go rather than a character
+    // at a time; markup-significant characters are sparse in typical input.
+    const char* runStart = cur;
+    while (cur != end && *cur != '<' && *cur != '>' && *cur != '&' &&
+           *cur != '"' && *cur != '\'') {
+      cur++;
+    }
+    aDst.Append(runStart, cur - runStart);
+    if (cur == end) {
+      break;
+    }
     if (*cur == '<') {
       aDst.AppendLiteral("&lt;");
     } else if (*cur == '>') {
@@ -222,11 +248,10 @@ void nsAppendEscapedHTML(const nsACString& aSrc, nsACString& aDst) {
       aDst.AppendLiteral("&amp;");
     } else if (*cur == '"') {
       aDst.AppendLiteral("&quot;");
-    } else if (*cur == '\'') {
-      aDst.AppendLiteral("&#39;");
     } else {
-      aDst.Append(*cur);
+      aDst.AppendLiteral("&#39;");
     }
+    cur++;
   }
 }
 
@@ -312,9 +337,34 @@ static nsresult T_EscapeURL(const typename T::char_type* aPart, size_t aPartLen,
   typename T::char_type tempBuffer[100];
   unsigned int tempBufferPos = 0;
 
+  // if the char has not to be escaped or whatever follows % is
+  // a valid escaped string, just copy the char.
+  //
+  // Also the % will not be escaped until forced
+  // See bugzilla bug 61269 for details why we changed this
+  //
+  // And, we will not escape non-ascii characters if requested.
+  // On special request we will also escape the colon even when
+  // not covered by the matrix.
+  // ignoreAscii is not honored for control characters (C0 and DEL)
+  //
+  // And, we should escape the '|' character when it occurs after any
+  // non-ASCII character as it may be aPart of a multi-byte character.
+  //
+  // 0x20..0x7e are the valid ASCII characters.
+  auto dontNeedEscapeHere = [&](unsigned_char_type aChar,
+                                bool aPreviousIsNonASCII) {
+    return (dontNeedEscape(aChar, aFlags) ||
+            (aChar == HEX_ESCAPE && !forced) ||
+            (aChar > 0x7f && ignoreNonAscii) ||
+            (aChar >= 0x20 && aChar < 0x7f && ignoreAscii)) &&
+           !(aChar == ':' && colon) && !(aChar == ' ' && spaces) &&
+           !(aPreviousIsNonASCII && aChar == '|' && !ignoreNonAscii);
+  };
+
   bool previousIsNonASCII = false;
-  for (size_t i = 0; i < aPartLen; ++i) {
-    unsigned_char_type c = *src++;
+  for (size_t i = 0; i < aPartLen;) {
+    unsigned_char_type c = src[i];
 
     // If there is a filter, we wish to skip any characters which match it.
     // This is needed so we don't perform an extra pass just to extract the
@@ -326,47 +376,61 @@ static nsresult T_EscapeURL(const typename T::char_type* aPart, size_t aPartLen,
         }
         writing = true;
       }
+      ++i;
       continue;
     }
 
-    // if the char has not to be escaped or whatever follows % is
-    // a valid escaped string, just copy the char.
-    //
-    // Also the % will not be escaped until forced
-    // See bugzilla bug 61269 for details why we changed this
-    //
-    // And, we will not escape non-ascii characters if requested.
-    // On special request we will also escape the colon even when
-    // not covered by the matrix.
-    // ignoreAscii is not honored for control characters (C0 and DEL)
-    //
-    // And, we should escape the '|' character when it occurs after any
-    // non-ASCII character as it may be aPart of a multi-byte character.
-    //
-    // 0x20..0x7e are the valid ASCII characters.
-    if ((dontNeedEscape(c, aFlags) || (c == HEX_ESCAPE && !forced) ||
-         (c > 0x7f && ignoreNonAscii) ||
-         (c >= 0x20 && c < 0x7f && ignoreAscii)) &&
-        !(c == ':' && colon) && !(c == ' ' && spaces) &&
-        !(previousIsNonASCII && c == '|' && !ignoreNonAscii)) {
+    if (dontNeedEscapeHere(c, previousIsNonASCII)) {
+      // Collect the whole run of characters that need no escaping and copy
+      // it in bulk instead of trickling it through tempBuffer one char at a
+      // time.  Escaped output tends to be long plain runs broken up by the
+      // occasional escape, so this is the hot case.
+      size_t runStart = i;
+      do {
+        previousIsNonASCII = (c > 0x7f);
+        ++i;
+        if (i == aPartLen) {
+          break;
+        }
+        c = src[i];
+        if (aFilterMask && mozilla::ASCIIMask::IsMasked(*aFilterMask, c)) {
+          break;
+        }
+      } while (dontNeedEscapeHere(c, previousIsNonASCII));
+
       if (writing) {
-        tempBuffer[tempBufferPos++] = c;
-      }
-    } else { /* do the escape magic */
-      if (!writing) {
-        if (!aResult.Append(aPart, i, mozilla::fallible)) {
-          return NS_ERROR_OUT_OF_MEMORY;
+        size_t runLen = i - runStart;
+        if (runLen <= mozilla::ArrayLength(tempBuffer) - ENCODE_MAX_LEN -
+                          tempBufferPos) {
+          traits::copy(tempBuffer + tempBufferPos, aPart + runStart, runLen);
+          tempBufferPos += runLen;
+        } else {
+          if (tempBufferPos &&
+              !aResult.Append(tempBuffer, tempBufferPos, mozilla::fallible)) {
+            return NS_ERROR_OUT_OF_MEMORY;
+          }
+          tempBufferPos = 0;
+          if (!aResult.Append(aPart + runStart, runLen, mozilla::fallible)) {
+            return NS_ERROR_OUT_OF_MEMORY;
+          }
         }
-        writing = true;
       }
-      uint32_t len = ::AppendPercentHex(tempBuffer + tempBufferPos, c);
-      tempBufferPos += len;
-      MOZ_ASSERT(len <= ENCODE_MAX_LEN, "potential buffer overflow");
+      continue;
+    }
+
+    /* do the escape magic */
+    if (!writing) {
+      if (!aResult.Append(aPart, i, mozilla::fallible)) {
+        return NS_ERROR_OUT_OF_MEMORY;
+      }
+      writing = true;
     }
+    uint32_t len = ::AppendPercentHex(tempBuffer + tempBufferPos, c);
+    tempBufferPos += len;
+    MOZ_ASSERT(len <= ENCODE_MAX_LEN, "potential buffer overflow");
 
     // Flush the temp buffer if it doesnt't have room for another encoded char.
     if (tempBufferPos >= mozilla::ArrayLength(tempBuffer) - ENCODE_MAX_LEN) {
-      NS_ASSERTION(writing, "should be writing");
       if (!aResult.Append(tempBuffer, tempBufferPos, mozilla::fallible)) {
         return NS_ERROR_OUT_OF_MEMORY;
       }
@@ -374,6 +438,7 @@ static nsresult T_EscapeURL(const typename T::char_type* aPart, size_t aPartLen,
     }
 
     previousIsNonASCII = (c > 0x7f);
+    ++i;
   }
   if (writing) {
     if (!aResult.Append(tempBuffer, tempBufferPos, mozilla::fallible)) {
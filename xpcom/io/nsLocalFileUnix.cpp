@@ -11,6 +11,7 @@
 #include "mozilla/ArrayUtils.h"
 #include "mozilla/Attributes.h"
 #include "mozilla/DebugOnly.h"
+#include "mozilla/IOInterposer.h"
 #include "mozilla/Sprintf.h"
 #include "mozilla/FilePreferences.h"
 #include "prtime.h"
@@ -429,13 +430,48 @@ nsLocalFile::CreateAllAncestors(uint32_t aPermissions) {
   return NS_OK;
 }
 
+namespace {
+
+/**
+ * RAII class for reporting nsLocalFile opens to the IOInterposer, so that
+ * observers such as the Gecko Profiler's FileIO markers and the main thread
+ * I/O logger can attribute them to a path. The NSPR interposer covers the
+ * reads and writes which follow, but PR_Open is not routed through the
+ * PRIOMethods table, so without this the open itself -- often the only
+ * main-thread operation performed on a file during startup -- would go
+ * unobserved.
+ */
+class LocalFileOpenAutoObservation final
+    : public IOInterposeObserver::Observation {
+ public:
+  explicit LocalFileOpenAutoObservation(const nsACString& aPath)
+      : IOInterposeObserver::Observation(IOInterposeObserver::OpCreateOrOpen,
+                                         "nsLocalFile") {
+    if (mShouldReport) {
+      CopyUTF8toUTF16(aPath, mFilename);
+    }
+  }
+
+  void Filename(nsAString& aFilename) override { aFilename = mFilename; }
+
+  ~LocalFileOpenAutoObservation() override { Report(); }
+
+ private:
+  nsString mFilename;
+};
+
+}  // namespace
+
 NS_IMETHODIMP
 nsLocalFile::OpenNSPRFileDesc(int32_t aFlags, int32_t aMode,
                               PRFileDesc** aResult) {
   if (!FilePreferences::IsAllowedPath(mPath)) {
     return NS_ERROR_FILE_ACCESS_DENIED;
   }
-  *aResult = PR_Open(mPath.get(), aFlags, aMode);
+  {
+    LocalFileOpenAutoObservation observation(mPath);
+    *aResult = PR_Open(mPath.get(), aFlags, aMode);
+  }
   if (!*aResult) {
     return NS_ErrorAccordingToNSPR();
   }
@@ -458,7 +494,10 @@ nsLocalFile::OpenANSIFileDesc(const char* aMode, FILE** aResult) {
   if (!FilePreferences::IsAllowedPath(mPath)) {
     return NS_ERROR_FILE_ACCESS_DENIED;
   }
-  *aResult = fopen(mPath.get(), aMode);
+  {
+    LocalFileOpenAutoObservation observation(mPath);
+    *aResult = fopen(mPath.get(), aMode);
+  }
   if (!*aResult) {
     return NS_ERROR_FAILURE;
   }
@@ -56,9 +56,15 @@ char* nsSegmentedBuffer::AppendNewSegment() {
     mSegmentArrayCount = newArraySize;
   }
 
-  char* seg = (char*)malloc(mSegmentSize);
-  if (!seg) {
-    return nullptr;
+  char* seg;
+  if (mRecycledSegment) {
+    seg = mRecycledSegment;
+    mRecycledSegment = nullptr;
+  } else {
+    seg = (char*)malloc(mSegmentSize);
+    if (!seg) {
+      return nullptr;
+    }
   }
   mSegmentArray[mLastSegmentIndex] = seg;
   mLastSegmentIndex = ModSegArraySize(mLastSegmentIndex + 1);
@@ -68,7 +74,7 @@ char* nsSegmentedBuffer::AppendNewSegment() {
 bool nsSegmentedBuffer::DeleteFirstSegment() {
   NS_ASSERTION(mSegmentArray[mFirstSegmentIndex] != nullptr,
                "deleting bad segment");
-  FreeOMT(mSegmentArray[mFirstSegmentIndex]);
+  RecycleOrFree(mSegmentArray[mFirstSegmentIndex]);
   mSegmentArray[mFirstSegmentIndex] = nullptr;
   int32_t last = ModSegArraySize(mLastSegmentIndex - 1);
   if (mFirstSegmentIndex == last) {
@@ -83,15 +89,26 @@ bool nsSegmentedBuffer::DeleteFirstSegment() {
 bool nsSegmentedBuffer::DeleteLastSegment() {
   int32_t last = ModSegArraySize(mLastSegmentIndex - 1);
   NS_ASSERTION(mSegmentArray[last] != nullptr, "deleting bad segment");
-  FreeOMT(mSegmentArray[last]);
+  RecycleOrFree(mSegmentArray[last]);
   mSegmentArray[last] = nullptr;
   mLastSegmentIndex = last;
   return (bool)(mLastSegmentIndex == mFirstSegmentIndex);
 }
 
+void nsSegmentedBuffer::RecycleOrFree(char* aSegment) {
+  if (!mSegmentsMayBeShrunk && !mRecycledSegment) {
+    mRecycledSegment = aSegment;
+    return;
+  }
+  FreeOMT(aSegment);
+}
+
 bool nsSegmentedBuffer::ReallocLastSegment(size_t aNewSize) {
   int32_t last = ModSegArraySize(mLastSegmentIndex - 1);
   NS_ASSERTION(mSegmentArray[last] != nullptr, "realloc'ing bad segment");
+  // From here on segments may be smaller than mSegmentSize, so they can no
+  // longer be recycled as full-size segments.
+  mSegmentsMayBeShrunk = true;
   char* newSegment = (char*)realloc(mSegmentArray[last], aNewSize);
   if (newSegment) {
     mSegmentArray[last] = newSegment;
@@ -107,6 +124,11 @@ void nsSegmentedBuffer::Empty() {
     mFirstSegmentIndex = mLastSegmentIndex = 0;
   });
 
+  if (mRecycledSegment) {
+    FreeOMT(mRecycledSegment);
+    mRecycledSegment = nullptr;
+  }
+
   // If mSegmentArray is null, there's no need to actually free anything
   if (!mSegmentArray) {
     return;
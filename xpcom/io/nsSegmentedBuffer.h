@@ -24,7 +24,9 @@ class nsSegmentedBuffer {
         mSegmentArray(nullptr),
         mSegmentArrayCount(0),
         mFirstSegmentIndex(0),
-        mLastSegmentIndex(0) {}
+        mLastSegmentIndex(0),
+        mRecycledSegment(nullptr),
+        mSegmentsMayBeShrunk(false) {}
 
   ~nsSegmentedBuffer() { Empty(); }
 
@@ -74,6 +76,10 @@ class nsSegmentedBuffer {
     return ModSegArraySize(mLastSegmentIndex + 1) == mFirstSegmentIndex;
   }
 
+  // Stash aSegment for reuse by AppendNewSegment(), or free it if the
+  // recycle slot is taken (or recycling is disabled).
+  void RecycleOrFree(char* aSegment);
+
  protected:
   uint32_t mSegmentSize;
   uint32_t mMaxSize;
@@ -82,6 +88,15 @@ class nsSegmentedBuffer {
   int32_t mFirstSegmentIndex;
   int32_t mLastSegmentIndex;
 
+  // The most recently deleted segment, kept for reuse by the next
+  // AppendNewSegment().  Steady-state producer/consumer flows through nsPipe
+  // delete and append one segment per buffer-full of data, so this spares a
+  // malloc/free round trip per segment.  Unused (and unset) once any segment
+  // has been shrunk by ReallocLastSegment(), since a shrunken block must not
+  // be handed out as a full-size segment.
+  char* mRecycledSegment;
+  bool mSegmentsMayBeShrunk;
+
  private:
   class FreeOMTPointers {
     NS_INLINE_DECL_THREADSAFE_REFCOUNTING(FreeOMTPointers)
@@ -18,6 +18,15 @@
 #  include "nsCRT.h"
 #  include "nsUTF8Utils.h"
 #  include "prdtoa.h"
+#  include "mozilla/SSE.h"
+
+#  include <type_traits>
+
+#  ifdef MOZILLA_MAY_SUPPORT_SSE2
+namespace mozilla::SSE2 {
+int32_t FindChar16(const char16_t* aStr, uint32_t aLength, char16_t aChar);
+}  // namespace mozilla::SSE2
+#  endif
 
 /* ***** BEGIN RICKG BLOCK *****
  *
@@ -108,6 +117,15 @@ static int32_t FindChar2(const char16_t* aDest, uint32_t aDestLength,
       const char16_t* max = root + aDestLength;
       const char16_t* end = (last < max) ? last : max;
 
+#  ifdef MOZILLA_MAY_SUPPORT_SSE2
+      if (mozilla::supports_sse2()) {
+        int32_t index =
+            mozilla::SSE2::FindChar16(left, end - left, aChar);
+        if (index >= 0) return (left - root) + index;
+        return kNotFound;
+      }
+#  endif
+
       while (left < end) {
         if (*left == aChar) return (left - root);
 
@@ -453,16 +471,21 @@ static int32_t CompressChars2(char16_t* aString, uint32_t aLength,
  * @return  the new length of the given buffer
  */
 static int32_t StripChars1(char* aString, uint32_t aLength, const char* aSet) {
-  // XXX(darin): this code should defer writing until necessary.
-
   char* to = aString;
-  char* from = aString - 1;
+  char* from = aString;
   char* end = aString + aLength;
 
   if (aSet && aString && (0 < aLength)) {
     uint32_t aSetLen = strlen(aSet);
-    while (++from < end) {
-      char theChar = *from;
+    // Defer writing until the first stripped character so that strings
+    // containing nothing from the set are never touched.
+    while (from < end &&
+           kNotFound == FindChar1(aSet, aSetLen, 0, *from, aSetLen)) {
+      ++from;
+    }
+    to = from;
+    while (from < end) {
+      char theChar = *from++;
       if (kNotFound == FindChar1(aSet, aSetLen, 0, theChar, aSetLen)) {
         *to++ = theChar;
       }
@@ -487,19 +510,25 @@ static int32_t StripChars1(char* aString, uint32_t aLength, const char* aSet) {
  */
 static int32_t StripChars2(char16_t* aString, uint32_t aLength,
                            const char* aSet) {
-  // XXX(darin): this code should defer writing until necessary.
-
   char16_t* to = aString;
-  char16_t* from = aString - 1;
+  char16_t* from = aString;
   char16_t* end = to + aLength;
 
   if (aSet && aString && (0 < aLength)) {
     uint32_t aSetLen = strlen(aSet);
-    while (++from < end) {
-      char16_t theChar = *from;
-      // Note the test for ascii range below. If you have a real unicode char,
-      // and you're searching for chars in the (given) ascii string, there's no
-      // point in doing the real search since it's out of the ascii range.
+    // Note the test for ascii range below. If you have a real unicode char,
+    // and you're searching for chars in the (given) ascii string, there's no
+    // point in doing the real search since it's out of the ascii range.
+    // Defer writing until the first stripped character so that strings
+    // containing nothing from the set are never touched.
+    while (from < end &&
+           ((255 < *from) ||
+            (kNotFound == FindChar1(aSet, aSetLen, 0, *from, aSetLen)))) {
+      ++from;
+    }
+    to = from;
+    while (from < end) {
+      char16_t theChar = *from++;
       if ((255 < theChar) ||
           (kNotFound == FindChar1(aSet, aSetLen, 0, theChar, aSetLen))) {
         *to++ = theChar;
@@ -617,6 +646,31 @@ static
   if (littleLen > bigLen) return kNotFound;
 
   int32_t i, max = int32_t(bigLen - littleLen);
+
+  if (!ignoreCase && littleLen > 0) {
+    // Only positions where the first character matches can start a match,
+    // so let find_char (memchr, or SSE2 for char16_t) skip ahead to them
+    // instead of running a full comparison at every offset.  Widening
+    // through the unsigned type matches what the compare routines do with
+    // narrow pattern characters.
+    const char16_t first =
+        char16_t(static_cast<typename std::make_unsigned<R>::type>(little[0]));
+    i = 0;
+    while (i <= max) {
+      int32_t found =
+          nsBufferRoutines<L>::find_char(big, bigLen, i, first, max - i + 1);
+      if (found == kNotFound) {
+        break;
+      }
+      if (nsBufferRoutines<L>::compare(big + found, little, littleLen,
+                                       false) == 0) {
+        return found;
+      }
+      i = found + 1;
+    }
+    return kNotFound;
+  }
+
   for (i = 0; i <= max; ++i, ++big) {
     if (nsBufferRoutines<L>::compare(big, little, littleLen, ignoreCase) == 0)
       return i;
@@ -0,0 +1,59 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+// This file should only be compiled if you're on x86 or x86_64.  Additionally,
+// you'll need to compile this file with -msse2 if you're using gcc.
+
+#include <emmintrin.h>
+#include <stdint.h>
+#include "mozilla/MathAlgorithms.h"
+#include "nscore.h"
+
+namespace mozilla::SSE2 {
+
+/**
+ * Scans [aStr, aStr + aLength) for aChar, eight char16_t units per probe.
+ * Returns the index of the first match, or -1 if there is none.  The scalar
+ * equivalent lives in nsStringObsolete.cpp (FindChar2); callers are expected
+ * to have checked mozilla::supports_sse2() already.
+ */
+int32_t FindChar16(const char16_t* aStr, uint32_t aLength, char16_t aChar) {
+  const uint32_t numUnicharsPerVector = 8;
+  const char16_t* const origin = aStr;
+  const char16_t* end = aStr + aLength;
+
+  // Align ourselves to a 16-byte boundary so the main loop can use aligned
+  // loads (MOVDQA).
+  while (aStr < end && (reinterpret_cast<uintptr_t>(aStr) & 0xf)) {
+    if (*aStr == aChar) {
+      return aStr - origin;
+    }
+    ++aStr;
+  }
+
+  const __m128i needle = _mm_set1_epi16(static_cast<int16_t>(aChar));
+  while (aStr + numUnicharsPerVector <= end) {
+    const __m128i vect = *reinterpret_cast<const __m128i*>(aStr);
+    const int mask = _mm_movemask_epi8(_mm_cmpeq_epi16(vect, needle));
+    if (mask) {
+      // Each matching char16_t sets two adjacent mask bits; the low set bit
+      // identifies the first match.
+      return (aStr - origin) + (mozilla::CountTrailingZeroes32(mask) >> 1);
+    }
+    aStr += numUnicharsPerVector;
+  }
+
+  // Take care of the remainder one character at a time.
+  for (; aStr < end; ++aStr) {
+    if (*aStr == aChar) {
+      return aStr - origin;
+    }
+  }
+
+  return -1;
+}
+
+}  // namespace mozilla::SSE2
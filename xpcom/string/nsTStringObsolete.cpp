@@ -190,8 +190,23 @@ void nsTString<T>::ReplaceChar(char_type aOldChar, char_type aNewChar) {
   if (!this->EnsureMutable())  // XXX do this lazily?
     this->AllocFailed(this->mLength);
 
-  for (uint32_t i = 0; i < this->mLength; ++i) {
-    if (this->mData[i] == aOldChar) this->mData[i] = aNewChar;
+  // Let find_char (memchr, or SSE2 for char16_t) locate the characters to
+  // replace instead of testing every position ourselves.  Widening through
+  // the unsigned type keeps high-bit narrow characters findable.
+  const char16_t oldChar =
+      char16_t(static_cast<typename std::make_unsigned<T>::type>(aOldChar));
+  char_type* data = this->mData;
+  uint32_t lenRemaining = this->mLength;
+
+  while (lenRemaining) {
+    int32_t i =
+        nsBufferRoutines<T>::find_char(data, lenRemaining, 0, oldChar,
+                                       int32_t(lenRemaining));
+    if (i == kNotFound) break;
+
+    data[i++] = aNewChar;
+    data += i;
+    lenRemaining -= i;
   }
 }
 
@@ -362,37 +377,37 @@ void nsTString<T>::Trim(const char* aSet, bool aTrimLeading, bool aTrimTrailing,
 
   uint32_t setLen = nsCharTraits<char>::length(aSet);
 
-  if (aTrimLeading) {
-    uint32_t cutStart = start - this->mData;
-    uint32_t cutLength = 0;
+  // Scan both ends before cutting anything so the trailing cut can happen
+  // first; cutting the leading run first would memmove trailing characters
+  // that are about to be cut anyway.
+  uint32_t cutStart = start - this->mData;
+  uint32_t leadingLength = 0;
 
+  if (aTrimLeading) {
     // walk forward from start to end
-    for (; start != end; ++start, ++cutLength) {
+    for (; start != end; ++start, ++leadingLength) {
       int32_t pos = FindChar1(aSet, setLen, 0, *start, setLen);
       if (pos == kNotFound) break;
     }
-
-    if (cutLength) {
-      this->Cut(cutStart, cutLength);
-
-      // reset iterators
-      start = this->mData + cutStart;
-      end = this->mData + this->mLength - cutStart;
-    }
   }
 
-  if (aTrimTrailing) {
-    uint32_t cutEnd = end - this->mData;
-    uint32_t cutLength = 0;
+  uint32_t cutEnd = end - this->mData;
+  uint32_t trailingLength = 0;
 
+  if (aTrimTrailing) {
     // walk backward from end to start
     --end;
-    for (; end >= start; --end, ++cutLength) {
+    for (; end >= start; --end, ++trailingLength) {
       int32_t pos = FindChar1(aSet, setLen, 0, *end, setLen);
       if (pos == kNotFound) break;
     }
+  }
 
-    if (cutLength) this->Cut(cutEnd - cutLength, cutLength);
+  if (trailingLength) {
+    this->Cut(cutEnd - trailingLength, trailingLength);
+  }
+  if (leadingLength) {
+    this->Cut(cutStart, leadingLength);
   }
 }
 
@@ -407,18 +422,29 @@ void nsTString<T>::CompressWhitespace(bool aTrimLeading, bool aTrimTrailing) {
     return;
   }
 
-  if (!this->EnsureMutable()) this->AllocFailed(this->mLength);
-
   const ASCIIMaskArray& mask = mozilla::ASCIIMask::MaskWhitespace();
 
-  char_type* to = this->mData;
-  char_type* from = this->mData;
+  // Find the first whitespace character before forcing a copy-on-write;
+  // strings without any whitespace need no work at all.
+  uint32_t first = 0;
+  while (first < this->mLength &&
+         !mozilla::ASCIIMask::IsMasked(mask, uint32_t(this->mData[first]))) {
+    ++first;
+  }
+  if (first == this->mLength) {
+    return;
+  }
+
+  if (!this->EnsureMutable()) this->AllocFailed(this->mLength);
+
+  char_type* to = this->mData + first;
+  char_type* from = to;
   char_type* end = this->mData + this->mLength;
 
   // Compresses runs of whitespace down to a normal space ' ' and convert
   // any whitespace to a normal space.  This assumes that whitespace is
   // all standard 7-bit ASCII.
-  bool skipWS = aTrimLeading;
+  bool skipWS = aTrimLeading && first == 0;
   while (from < end) {
     uint32_t theChar = *from++;
     if (mozilla::ASCIIMask::IsMasked(mask, theChar)) {
@@ -1095,14 +1095,18 @@ void nsTSubstring<T>::StripChar(char_type aChar) {
     return;
   }
 
-  if (!EnsureMutable()) {  // XXX do this lazily?
-    AllocFailed(this->mLength);
+  int32_t first = this->FindChar(aChar);
+  if (first == kNotFound) {
+    // Nothing to strip; skip both the copy-on-write and the compaction.
+    return;
   }
 
-  // XXX(darin): this code should defer writing until necessary.
+  if (!EnsureMutable()) {
+    AllocFailed(this->mLength);
+  }
 
-  char_type* to = this->mData;
-  char_type* from = this->mData;
+  char_type* to = this->mData + first;
+  char_type* from = to;
   char_type* end = this->mData + this->mLength;
 
   while (from < end) {
@@ -1121,24 +1125,34 @@ void nsTSubstring<T>::StripChars(const char_type* aChars) {
     return;
   }
 
-  if (!EnsureMutable()) {  // XXX do this lazily?
-    AllocFailed(this->mLength);
+  auto isStripped = [aChars](char_type aChar) {
+    const char_type* test = aChars;
+    for (; *test && *test != aChar; ++test)
+      ;
+    return *test != char_type(0);
+  };
+
+  // Find the first character that actually gets stripped before forcing a
+  // copy-on-write; most strings contain nothing from the set.
+  size_type first = 0;
+  while (first < this->mLength && !isStripped(this->mData[first])) {
+    ++first;
+  }
+  if (first == this->mLength) {
+    return;
   }
 
-  // XXX(darin): this code should defer writing until necessary.
+  if (!EnsureMutable()) {
+    AllocFailed(this->mLength);
+  }
 
-  char_type* to = this->mData;
-  char_type* from = this->mData;
+  char_type* to = this->mData + first;
+  char_type* from = to;
   char_type* end = this->mData + this->mLength;
 
   while (from < end) {
     char_type theChar = *from++;
-    const char_type* test = aChars;
-
-    for (; *test && *test != theChar; ++test)
-      ;
-
-    if (!*test) {
+    if (!isStripped(theChar)) {
       // Not stripped, copy this char.
       *to++ = theChar;
     }
@@ -1153,12 +1167,23 @@ void nsTSubstring<T>::StripTaggedASCII(const ASCIIMaskArray& aToStrip) {
     return;
   }
 
+  // Find the first masked character before forcing a copy-on-write; most
+  // strings have nothing to strip and can be left untouched.
+  size_type first = 0;
+  while (first < this->mLength &&
+         !mozilla::ASCIIMask::IsMasked(aToStrip, (uint32_t)this->mData[first])) {
+    ++first;
+  }
+  if (first == this->mLength) {
+    return;
+  }
+
   if (!EnsureMutable()) {
     AllocFailed(this->mLength);
   }
 
-  char_type* to = this->mData;
-  char_type* from = this->mData;
+  char_type* to = this->mData + first;
+  char_type* from = to;
   char_type* end = this->mData + this->mLength;
 
   while (from < end) {
@@ -207,6 +207,40 @@ int nsTextFormatter::cvt_ll(SprintfStateStr* aState, uint64_t aNum, int aWidth,
   */
   cvt = &cvtbuf[0] + ELEMENTS_OF(cvtbuf);
   digits = 0;
+  if (aRadix == 10) {
+    /* Decimal is the common case; dividing by a constant 100 lets the
+    ** compiler use multiplies, and we emit two digits per iteration. */
+    static const char digitPairs[201] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+    while (aNum >= 100) {
+      uint64_t rem = aNum % 100;
+      aNum /= 100;
+      cvt -= 2;
+      cvt[0] = char16_t(digitPairs[rem * 2]);
+      cvt[1] = char16_t(digitPairs[rem * 2 + 1]);
+      digits += 2;
+    }
+    if (aNum >= 10) {
+      cvt -= 2;
+      cvt[0] = char16_t(digitPairs[aNum * 2]);
+      cvt[1] = char16_t(digitPairs[aNum * 2 + 1]);
+      digits += 2;
+    } else {
+      *--cvt = char16_t('0' + aNum);
+      digits++;
+    }
+    return fill_n(aState, cvt, digits, aWidth, aPrec, aFlags);
+  }
+
   while (aNum != 0) {
     uint64_t quot = aNum / aRadix;
     uint64_t rem = aNum % aRadix;
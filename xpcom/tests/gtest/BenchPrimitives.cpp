@@ -0,0 +1,229 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* vim: set ts=8 sts=2 et sw=2 tw=80: */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+// Microbenchmarks for the core primitives most of the platform sits on:
+// PLDHashTable, nsTArray growth, nsTSubstring operations, TaskController
+// dispatch latency, nsPipe throughput and allocator size-class churn.
+//
+// Each benchmark uses MOZ_GTEST_BENCH so the median of several runs is
+// reported to PerfHerder (framework "platform_microbench") and regressions
+// can alert. The workloads are deterministic; MOZ_RELEASE_ASSERT is used on
+// results both to check them and to keep the compiler from optimizing the
+// measured work away.
+//
+// To run only these locally:
+//
+//   MOZ_RUN_GTEST=1 GTEST_FILTER='BenchPrimitives.*' \
+//       $OBJDIR/dist/bin/firefox -unittest
+
+#include "gtest/gtest.h"
+#include "gtest/MozGTestBench.h"  // For MOZ_GTEST_BENCH
+#include "mozilla/RefPtr.h"
+#include "nsCOMPtr.h"
+#include "nsIAsyncInputStream.h"
+#include "nsIAsyncOutputStream.h"
+#include "nsIPipe.h"
+#include "nsString.h"
+#include "nsTArray.h"
+#include "nsThreadUtils.h"
+#include "PLDHashTable.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+namespace {
+
+// PLDHashTable: add/search/remove cycle over unique pointer-sized keys.
+
+const size_t kHashEntries = 64 * 1024;
+
+static void* KeyForIndex(size_t aIndex) {
+  // Odd, nonzero, unique per index; cheap enough not to dominate the loop.
+  return reinterpret_cast<void*>(static_cast<uintptr_t>(aIndex) * 2 + 1);
+}
+
+static void BenchPLDHashTable() {
+  PLDHashTable table(PLDHashTable::StubOps(), sizeof(PLDHashEntryStub));
+
+  for (size_t i = 0; i < kHashEntries; i++) {
+    auto entry = static_cast<PLDHashEntryStub*>(table.Add(KeyForIndex(i)));
+    MOZ_RELEASE_ASSERT(!entry->key);
+    entry->key = KeyForIndex(i);
+  }
+
+  for (size_t i = 0; i < kHashEntries; i++) {
+    MOZ_RELEASE_ASSERT(table.Search(KeyForIndex(i)));
+  }
+
+  for (size_t i = 0; i < kHashEntries; i++) {
+    MOZ_RELEASE_ASSERT(!table.Search(KeyForIndex(kHashEntries + i)));
+  }
+
+  for (size_t i = 0; i < kHashEntries; i++) {
+    table.Remove(KeyForIndex(i));
+  }
+  MOZ_RELEASE_ASSERT(table.EntryCount() == 0);
+}
+
+// nsTArray: element-at-a-time append, with and without a capacity hint, so
+// the growth policy's reallocation cost shows up as the difference between
+// the two numbers.
+
+const size_t kArrayElements = 1024 * 1024;
+
+static void BenchTArrayAppend(bool aSetCapacity) {
+  nsTArray<uint64_t> array;
+  if (aSetCapacity) {
+    array.SetCapacity(kArrayElements);
+  }
+  for (size_t i = 0; i < kArrayElements; i++) {
+    array.AppendElement(uint64_t(i));
+  }
+  MOZ_RELEASE_ASSERT(array.Length() == kArrayElements);
+  MOZ_RELEASE_ASSERT(array[kArrayElements - 1] == kArrayElements - 1);
+}
+
+// nsTSubstring: incremental append growth, buffer-sharing assignment
+// followed by copy-on-write, and searching a large haystack.
+
+static void BenchStringAppend() {
+  const size_t kTargetLength = 1024 * 1024;
+  nsCString str;
+  while (str.Length() < kTargetLength) {
+    str.AppendLiteral("0123456789abc");
+  }
+  MOZ_RELEASE_ASSERT(str.Length() >= kTargetLength);
+}
+
+static void BenchStringAssignAndUnshare() {
+  nsCString original;
+  for (size_t i = 0; i < 4096; i++) {
+    original.AppendLiteral("0123456789abcdef");
+  }
+
+  for (size_t i = 0; i < 50000; i++) {
+    nsCString copy;
+    copy.Assign(original);  // Shares the refcounted buffer.
+    *copy.BeginWriting() = 'x';  // Forces the copy.
+    MOZ_RELEASE_ASSERT(copy.Length() == original.Length());
+  }
+}
+
+static void BenchStringFind() {
+  nsCString haystack;
+  for (size_t i = 0; i < 16384; i++) {
+    haystack.AppendLiteral("0123456789abcdef");
+  }
+  haystack.AppendLiteral("needle");
+
+  for (size_t i = 0; i < 200; i++) {
+    MOZ_RELEASE_ASSERT(haystack.Find("needle") ==
+                       int32_t(haystack.Length() - 6));
+  }
+}
+
+// TaskController: dispatch a burst of trivial runnables to the main thread
+// and drain them, measuring the whole enqueue-to-run round trip through the
+// main thread's task queue.
+
+static void BenchTaskDispatchAndDrain() {
+  const size_t kTasks = 10000;
+  size_t ran = 0;
+  for (size_t i = 0; i < kTasks; i++) {
+    NS_DispatchToCurrentThread(NS_NewRunnableFunction(
+        "BenchPrimitives::TaskDispatch", [&ran] { ran++; }));
+  }
+  NS_ProcessPendingEvents(nullptr);
+  MOZ_RELEASE_ASSERT(ran == kTasks);
+}
+
+// nsPipe: interleaved segmented writes and reads, the pattern stream
+// consumers (necko, IPC stream serialization) put the pipe through.
+
+static void BenchPipeWriteRead() {
+  const uint32_t kChunkSize = 64 * 1024;
+  const size_t kTotalBytes = 8 * 1024 * 1024;
+
+  nsCOMPtr<nsIAsyncInputStream> reader;
+  nsCOMPtr<nsIAsyncOutputStream> writer;
+  NS_NewPipe2(getter_AddRefs(reader), getter_AddRefs(writer), true, true, 4096,
+              kChunkSize / 4096);
+
+  char chunk[kChunkSize];
+  memset(chunk, 'p', sizeof(chunk));
+
+  size_t transferred = 0;
+  while (transferred < kTotalBytes) {
+    uint32_t written = 0;
+    MOZ_RELEASE_ASSERT(
+        NS_SUCCEEDED(writer->Write(chunk, kChunkSize, &written)));
+    MOZ_RELEASE_ASSERT(written == kChunkSize);
+
+    uint32_t read = 0;
+    while (read < written) {
+      uint32_t n = 0;
+      MOZ_RELEASE_ASSERT(NS_SUCCEEDED(
+          reader->Read(chunk, kChunkSize - read, &n)));
+      MOZ_RELEASE_ASSERT(n > 0);
+      read += n;
+    }
+    transferred += written;
+  }
+  MOZ_RELEASE_ASSERT(transferred == kTotalBytes);
+}
+
+// Allocator: alloc/free churn across the small and mid size classes, with a
+// round-robin window of live allocations so frees hit a mix of runs rather
+// than always the most recent allocation.
+
+static void BenchAllocatorSizeClasses() {
+  static const size_t kSizes[] = {8,   16,  32,   48,   64,   96,  128,
+                                  192, 256, 512, 1024, 2048, 4096};
+  const size_t kWindow = 64;
+  const size_t kAllocationsPerSize = 16384;
+
+  void* window[kWindow] = {nullptr};
+  size_t slot = 0;
+
+  for (size_t size : kSizes) {
+    for (size_t i = 0; i < kAllocationsPerSize; i++) {
+      free(window[slot]);
+      window[slot] = malloc(size);
+      MOZ_RELEASE_ASSERT(window[slot]);
+      static_cast<char*>(window[slot])[0] = char(i);
+      slot = (slot + 1) % kWindow;
+    }
+  }
+  for (size_t i = 0; i < kWindow; i++) {
+    free(window[i]);
+  }
+}
+
+}  // namespace
+
+MOZ_GTEST_BENCH(BenchPrimitives, PLDHashTableAddSearchRemove,
+                BenchPLDHashTable);
+
+MOZ_GTEST_BENCH(BenchPrimitives, TArrayAppendGrowth,
+                [] { BenchTArrayAppend(false); });
+
+MOZ_GTEST_BENCH(BenchPrimitives, TArrayAppendPresized,
+                [] { BenchTArrayAppend(true); });
+
+MOZ_GTEST_BENCH(BenchPrimitives, StringAppendGrowth, BenchStringAppend);
+
+MOZ_GTEST_BENCH(BenchPrimitives, StringAssignAndUnshare,
+                BenchStringAssignAndUnshare);
+
+MOZ_GTEST_BENCH(BenchPrimitives, StringFind, BenchStringFind);
+
+MOZ_GTEST_BENCH(BenchPrimitives, TaskDispatchAndDrain,
+                BenchTaskDispatchAndDrain);
+
+MOZ_GTEST_BENCH(BenchPrimitives, PipeWriteRead, BenchPipeWriteRead);
+
+MOZ_GTEST_BENCH(BenchPrimitives, AllocatorSizeClasses,
+                BenchAllocatorSizeClasses);
@@ -265,18 +265,45 @@ TEST(ArenaAllocator, Clear)
   sz = a.SizeOfExcludingThis(TestSizeOf);
   EXPECT_GT(sz, prev_sz);
 
-  // Clearing should reduce the size back to zero.
+  // Clearing retains a capped number of chunks for reuse, so the measured
+  // size must not grow, but may stay nonzero.
   a.Clear();
+  prev_sz = sz;
   sz = a.SizeOfExcludingThis(TestSizeOf);
-  EXPECT_EQ(sz, size_t(0));
+  EXPECT_LE(sz, prev_sz);
 
-  // Allocating should work after clearing an arena with allocations.
+  // Allocating should work after clearing an arena with allocations, and
+  // should draw from the recycled chunks rather than growing the arena.
   x = a.Allocate(10);
   EXPECT_TRUE(x);
 
   prev_sz = sz;
   sz = a.SizeOfExcludingThis(TestSizeOf);
-  EXPECT_GT(sz, prev_sz);
+  EXPECT_EQ(sz, prev_sz);
+}
+
+TEST(ArenaAllocator, Recycling)
+{
+  // Standard-sized chunks are recycled across Clear calls rather than handed
+  // back to malloc, so repeated fill/clear cycles should not move the
+  // high-water mark once it is established.
+  static const size_t kArenaSize = 4096;
+  ArenaAllocator<kArenaSize> a;
+
+  for (size_t cycle = 0; cycle < 3; cycle++) {
+    for (size_t i = 0; i < 4; i++) {
+      (void)a.Allocate(kArenaSize / 2);
+    }
+    a.Clear();
+  }
+
+  size_t highWater = a.HighWaterMark();
+  EXPECT_GT(highWater, size_t(0));
+
+  for (size_t i = 0; i < 4; i++) {
+    (void)a.Allocate(kArenaSize / 2);
+  }
+  EXPECT_EQ(a.HighWaterMark(), highWater);
 }
 
 TEST(ArenaAllocator, Extensions)
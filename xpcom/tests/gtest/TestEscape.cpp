@@ -142,3 +142,33 @@ TEST(Escape, EscapeSpaces)
   EXPECT_EQ(rv, NS_OK);
   EXPECT_STREQ(escaped.BeginReading(), "data:%0D%0A%20spa%20ces%C4%9F");
 }
+
+TEST(Escape, LongRunsWithEscapes)
+{
+  // Exercises the bulk-copy path for runs of characters that need no
+  // escaping, including runs longer than the internal temp buffer.
+  nsCString plainRun;
+  for (int i = 0; i < 300; ++i) {
+    plainRun.Append('a');
+  }
+
+  nsCString toEscape;
+  toEscape.Append(plainRun);
+  toEscape.AppendLiteral("\xC4\x9F");
+  toEscape.Append(plainRun);
+  toEscape.AppendLiteral(" ");
+  toEscape.Append(plainRun);
+
+  nsCString expected;
+  expected.Append(plainRun);
+  expected.AppendLiteral("%C4%9F");
+  expected.Append(plainRun);
+  expected.AppendLiteral("%20");
+  expected.Append(plainRun);
+
+  nsCString escaped;
+  nsresult rv = NS_EscapeURL(toEscape, esc_OnlyNonASCII | esc_Spaces, escaped,
+                             fallible);
+  EXPECT_EQ(rv, NS_OK);
+  EXPECT_STREQ(escaped.BeginReading(), expected.BeginReading());
+}
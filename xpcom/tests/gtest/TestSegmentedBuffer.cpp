@@ -38,3 +38,17 @@ TEST(SegmentedBuffer, AppendAndDelete)
   empty = buf->DeleteFirstSegment();
   EXPECT_TRUE(empty) << "DeleteFirstSegment failed";
 }
+
+TEST(SegmentedBuffer, RecycleSegment)
+{
+  auto buf = MakeUnique<nsSegmentedBuffer>();
+  buf->Init(4, 16);
+  char* seg = buf->AppendNewSegment();
+  EXPECT_TRUE(seg) << "AppendNewSegment failed";
+  bool empty = buf->DeleteFirstSegment();
+  EXPECT_TRUE(empty) << "DeleteFirstSegment failed";
+  // The deleted segment should be handed back by the next append.
+  char* seg2 = buf->AppendNewSegment();
+  EXPECT_EQ(seg, seg2) << "expected recycled segment";
+  EXPECT_TRUE(buf->DeleteFirstSegment()) << "DeleteFirstSegment failed";
+}
@@ -599,6 +599,29 @@ TEST_F(Strings, test1) {
   EXPECT_EQ(n, kNotFound);
 }
 
+TEST_F(Strings, find_char_16bit) {
+  // Long enough to cross the vectorized search's alignment prologue and
+  // main-loop boundaries.
+  nsAutoString buf;
+  for (int i = 0; i < 100; ++i) {
+    buf.Append(u'a');
+  }
+
+  EXPECT_EQ(buf.FindChar(u','), kNotFound);
+
+  for (int32_t pos : {0, 1, 7, 8, 15, 16, 63, 64, 97, 98, 99}) {
+    nsAutoString probe(buf);
+    probe.SetCharAt(u',', pos);
+    EXPECT_EQ(probe.FindChar(u','), pos);
+    EXPECT_EQ(probe.FindChar(u',', pos + 1), kNotFound);
+  }
+
+  // Non-Latin1 needles must work too.
+  nsAutoString wide(buf);
+  wide.SetCharAt(u'\x2603', 42);
+  EXPECT_EQ(wide.FindChar(u'\x2603'), 42);
+}
+
 TEST_F(Strings, test2) {
   nsCString data("hello world");
   const nsACString& aStr = data;
@@ -835,6 +858,25 @@ TEST_F(Strings, trim) {
   EXPECT_STREQ(s.get(), "");
 }
 
+TEST_F(Strings, replace_char) {
+  nsCString s("abc.def.ghi");
+  s.ReplaceChar('.', '-');
+  EXPECT_STREQ(s.get(), "abc-def-ghi");
+
+  // A character in the high half of the narrow range must still be found.
+  s.Assign("a\xe9z\xe9");
+  s.ReplaceChar('\xe9', '_');
+  EXPECT_STREQ(s.get(), "a_z_");
+
+  s.Assign("no matches here");
+  s.ReplaceChar('x', 'y');
+  EXPECT_STREQ(s.get(), "no matches here");
+
+  nsString w(u"w.x.y.z");
+  w.ReplaceChar(u'.', u' ');
+  EXPECT_TRUE(w.EqualsLiteral("w x y z"));
+}
+
 TEST_F(Strings, replace_substr) {
   const char text[] = "abc-ppp-qqq-ppp-xyz";
   nsCString s(text);
@@ -949,6 +991,28 @@ TEST_F(Strings, strip_ws) {
   }
 }
 
+TEST_F(Strings, strip_char) {
+  nsCString s("foo.bar.baz");
+  s.StripChar('.');
+  EXPECT_STREQ(s.get(), "foobarbaz");
+
+  s.AssignLiteral("no dots here");
+  s.StripChar('.');
+  EXPECT_STREQ(s.get(), "no dots here");
+
+  s.AssignLiteral("xxxx");
+  s.StripChar('x');
+  EXPECT_STREQ(s.get(), "");
+
+  s.AssignLiteral("a,b;c,d");
+  s.StripChars(",;");
+  EXPECT_STREQ(s.get(), "abcd");
+
+  s.AssignLiteral("untouched");
+  s.StripChars(",;");
+  EXPECT_STREQ(s.get(), "untouched");
+}
+
 TEST_F(Strings, equals_ic) {
   nsCString s;
   EXPECT_FALSE(s.LowerCaseEqualsLiteral("view-source"));
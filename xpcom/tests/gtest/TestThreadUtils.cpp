@@ -1324,6 +1324,27 @@ TEST(ThreadUtils, main)
   EXPECT_EQ(count += 2, rpt->mCount);
   EXPECT_EQ(11, rpt->mA0);
 
+  // A receiver passed as an rvalue nsCOMPtr should hand its reference
+  // straight to the runnable, with no refcount traffic in either direction.
+  {
+    nsCOMPtr<IThreadUtilsObject> comObj = rpt.get();
+    nsrefcnt countBefore = rpt->RefCnt();
+    nsCOMPtr<nsIRunnable> moveRunnable =
+        NewRunnableMethod("TestThreadUtils::IThreadUtilsObject::RefCnt",
+                          std::move(comObj), &IThreadUtilsObject::RefCnt);
+    EXPECT_EQ(countBefore, rpt->RefCnt());
+    moveRunnable = nullptr;
+    EXPECT_EQ(countBefore - 1, rpt->RefCnt());
+  }
+
+  // Likewise, do_AddRef on an expiring smart pointer steals its reference.
+  {
+    RefPtr<ThreadUtilsObject> extra = rpt;
+    nsrefcnt countBefore = rpt->RefCnt();
+    RefPtr<ThreadUtilsObject> back = do_AddRef(std::move(extra));
+    EXPECT_EQ(countBefore, rpt->RefCnt());
+  }
+
   // Test calling a method from a non-ref-counted base.
 
   r1 = NewRunnableMethod(
@@ -519,23 +519,27 @@ class MozPromise : public MozPromiseBase {
       aPromise->mMutex.AssertCurrentThreadOwns();
       MOZ_ASSERT(!aPromise->IsPending());
 
+      if (aPromise->mUseSynchronousTaskDispatch &&
+          mResponseTarget->IsOnCurrentThread()) {
+        // The promise is already settled and we are on the response target,
+        // so run the continuation in place rather than paying for a runnable
+        // allocation and a trip through the event loop.
+        PROMISE_LOG(
+            "%s Then() call made from %s [Promise=%p, ThenValue=%p] "
+            "running synchronously",
+            aPromise->mValue.IsResolve() ? "Resolving" : "Rejecting", mCallSite,
+            aPromise, this);
+        DoResolveOrReject(aPromise->Value());
+        return;
+      }
+
       nsCOMPtr<nsIRunnable> r = new ResolveOrRejectRunnable(this, aPromise);
       PROMISE_LOG(
           "%s Then() call made from %s [Runnable=%p, Promise=%p, ThenValue=%p] "
           "%s dispatch",
           aPromise->mValue.IsResolve() ? "Resolving" : "Rejecting", mCallSite,
           r.get(), aPromise, this,
-          aPromise->mUseSynchronousTaskDispatch ? "synchronous"
-          : aPromise->mUseDirectTaskDispatch    ? "directtask"
-                                                : "normal");
-
-      if (aPromise->mUseSynchronousTaskDispatch &&
-          mResponseTarget->IsOnCurrentThread()) {
-        PROMISE_LOG("ThenValue::Dispatch running task synchronously [this=%p]",
-                    this);
-        r->Run();
-        return;
-      }
+          aPromise->mUseDirectTaskDispatch ? "directtask" : "normal");
 
       if (aPromise->mUseDirectTaskDispatch &&
           mResponseTarget->IsOnCurrentThread()) {
@@ -1170,7 +1174,10 @@ class MozPromise : public MozPromiseBase {
 #  ifdef PROMISE_DEBUG
   uint32_t mMagic2 = sMagic;
 #  endif
-  nsTArray<RefPtr<Private>> mChainedPromises;
+  // Exclusive promises can only ever have a single chained promise, just as
+  // they have a single ThenValue; mirror mThenValues' inline capacity so the
+  // common case never touches the heap.
+  AutoTArray<RefPtr<Private>, IsExclusive ? 1 : 3> mChainedPromises;
 #  ifdef PROMISE_DEBUG
   uint32_t mMagic3 = sMagic;
 #  endif
@@ -50,6 +50,8 @@ namespace mozilla {
 //
 template <class T, size_t RequestedItemsPerPage = 256>
 class Queue {
+  struct Page;
+
  public:
   Queue() = default;
 
@@ -209,6 +211,48 @@ class Queue {
     return aMallocSizeOf(this) + ShallowSizeOfExcludingThis(aMallocSizeOf);
   }
 
+  // A forward iterator over the queue's elements, from oldest to newest.
+  // The queue must not be pushed to or popped from while iterating.
+  class ConstIterator {
+   public:
+    const T& operator*() const {
+      size_t offset = mPage == mQueue->mHead
+                          ? (mQueue->mOffsetHead + mIndex) % ItemsPerPage
+                          : mIndex;
+      return mPage->mEvents[offset];
+    }
+
+    ConstIterator& operator++() {
+      if (++mIndex == mQueue->PageLength(mPage)) {
+        mPage = mPage == mQueue->mTail ? nullptr : mPage->mNext;
+        mIndex = 0;
+      }
+      return *this;
+    }
+
+    bool operator==(const ConstIterator& aOther) const {
+      return mPage == aOther.mPage && mIndex == aOther.mIndex;
+    }
+    bool operator!=(const ConstIterator& aOther) const {
+      return !(*this == aOther);
+    }
+
+   private:
+    friend class Queue;
+
+    ConstIterator(const Queue* aQueue, const Page* aPage)
+        : mQueue(aQueue), mPage(aPage) {}
+
+    const Queue* mQueue;
+    const Page* mPage;
+    size_t mIndex = 0;
+  };
+
+  ConstIterator begin() const {
+    return ConstIterator(this, IsEmpty() ? nullptr : mHead);
+  }
+  ConstIterator end() const { return ConstIterator(this, nullptr); }
+
  private:
   static_assert(
       (RequestedItemsPerPage & (RequestedItemsPerPage - 1)) == 0,
@@ -229,6 +273,17 @@ class Queue {
     return static_cast<Page*>(moz_xcalloc(1, sizeof(Page)));
   }
 
+  // The number of items stored in the given page.
+  size_t PageLength(const Page* aPage) const {
+    if (aPage == mHead) {
+      return mHeadLength;
+    }
+    if (aPage == mTail) {
+      return mTailLength;
+    }
+    return ItemsPerPage;
+  }
+
   Page* mHead = nullptr;
   Page* mTail = nullptr;
 
@@ -314,6 +314,23 @@ void TaskController::AddTask(already_AddRefed<Task>&& aTask) {
     }
   }
 
+  // The task isn't visible to anyone else until it is inserted into the
+  // graph, so the timestamping and dispatch logging (which can do I/O and
+  // take its own locks) can happen before taking the graph mutex — that
+  // mutex is the hottest in the process under vsync + IPC task arrival.
+#ifdef MOZ_GECKO_PROFILER
+  task->mInsertionTime = TimeStamp::Now();
+#endif
+
+#ifdef DEBUG
+  for (const RefPtr<Task>& otherTask : task->mDependencies) {
+    MOZ_ASSERT(!otherTask->mTaskManager ||
+               otherTask->mTaskManager == task->mTaskManager);
+  }
+#endif
+
+  LogTask::LogDispatch(task);
+
   MutexAutoLock lock(mGraphMutex);
 
   if (TaskManager* manager = task->GetManager()) {
@@ -327,21 +344,10 @@ void TaskController::AddTask(already_AddRefed<Task>&& aTask) {
     task->mPriorityModifier = manager->mCurrentPriorityModifier;
   }
 
-#ifdef MOZ_GECKO_PROFILER
-  task->mInsertionTime = TimeStamp::Now();
-#endif
-
 #ifdef DEBUG
   task->mIsInGraph = true;
-
-  for (const RefPtr<Task>& otherTask : task->mDependencies) {
-    MOZ_ASSERT(!otherTask->mTaskManager ||
-               otherTask->mTaskManager == task->mTaskManager);
-  }
 #endif
 
-  LogTask::LogDispatch(task);
-
   std::pair<std::set<RefPtr<Task>, Task::PriorityCompare>::iterator, bool>
       insertion;
   if (task->IsMainThreadOnly()) {
@@ -692,6 +698,10 @@ bool TaskController::DoExecuteNextTaskOnlyMainThreadInternal(
       TaskManager* manager = task->GetManager();
       bool result = false;
 
+      TimeStamp taskStart;
+      TimeStamp taskEnd;
+      nsAutoCString taskName;
+
       {
         MutexAutoUnlock unlock(mGraphMutex);
         if (manager) {
@@ -734,6 +744,13 @@ bool TaskController::DoExecuteNextTaskOnlyMainThreadInternal(
                 task->GetPerformanceCounter(), now,
                 manager == mIdleTaskManager);
 
+        // Capture the name for the latency ledger now; RunnableTask drops its
+        // runnable once it has run.
+        if (!task->GetName(taskName)) {
+          taskName.AssignLiteral("(unnamed)");
+        }
+        taskStart = now;
+
         {
           LogTask::Run log(task);
           result = task->Run();
@@ -745,8 +762,12 @@ bool TaskController::DoExecuteNextTaskOnlyMainThreadInternal(
         }
 
         mPerformanceCounterState->RunnableDidRun(std::move(snapshot));
+
+        taskEnd = TimeStamp::Now();
       }
 
+      RecordTaskLatency(task, taskName, taskStart, taskEnd, aProofOfLock);
+
       // Task itself should keep manager alive.
       if (manager && result && manager->mTaskCount == 0) {
         mTaskManagers.erase(manager);
@@ -796,6 +817,54 @@ bool TaskController::DoExecuteNextTaskOnlyMainThreadInternal(
   return false;
 }
 
+void TaskController::RecordTaskLatency(Task* aTask, const nsACString& aName,
+                                       const TimeStamp& aStart,
+                                       const TimeStamp& aEnd,
+                                       const MutexAutoLock& aProofOfLock) {
+  uint64_t runUs = uint64_t((aEnd - aStart).ToMicroseconds());
+  uint64_t queueUs = 0;
+#ifdef MOZ_GECKO_PROFILER
+  if (aTask->mInsertionTime) {
+    queueUs = uint64_t((aStart - aTask->mInsertionTime).ToMicroseconds());
+  }
+#endif
+
+  TaskLatencyEntry* coldest = nullptr;
+  for (TaskLatencyEntry& entry : mLatencyLedger) {
+    if (entry.mName == aName) {
+      entry.mCount++;
+      entry.mQueueTimeUs += queueUs;
+      entry.mRunTimeUs += runUs;
+      entry.mMaxRunTimeUs = std::max(entry.mMaxRunTimeUs, runUs);
+      return;
+    }
+    if (!coldest || entry.mRunTimeUs < coldest->mRunTimeUs) {
+      coldest = &entry;
+    }
+  }
+
+  if (mLatencyLedger.Length() < kLatencyLedgerSize) {
+    coldest = mLatencyLedger.AppendElement();
+  } else if (runUs <= coldest->mRunTimeUs) {
+    // The ledger is full, and even the entry with the least accumulated run
+    // time has spent longer running than this task; keep the offenders we
+    // already track.
+    return;
+  }
+
+  coldest->mName = aName;
+  coldest->mCount = 1;
+  coldest->mQueueTimeUs = queueUs;
+  coldest->mRunTimeUs = runUs;
+  coldest->mMaxRunTimeUs = runUs;
+}
+
+void TaskController::GetMainThreadLatencyLedger(
+    nsTArray<TaskLatencyEntry>& aEntries) {
+  MutexAutoLock lock(mGraphMutex);
+  aEntries = mLatencyLedger.Clone();
+}
+
 Task* TaskController::GetFinalDependency(Task* aTask) {
   Task* nextTask;
 
@@ -16,6 +16,8 @@
 #include "mozilla/EventQueue.h"
 #include "nsISupportsImpl.h"
 #include "nsIEventTarget.h"
+#include "nsString.h"
+#include "nsTArray.h"
 
 #include <atomic>
 #include <memory>
@@ -261,6 +263,18 @@ class IdleTaskManager : public TaskManager {
   IdlePeriodState mIdlePeriodState;
 };
 
+// Aggregated queue and run times for all main thread tasks sharing a runnable
+// name. TaskController keeps a small fixed-size table of these so that main
+// thread latency can be attributed to specific runnables in production; see
+// TaskController::GetMainThreadLatencyLedger().
+struct TaskLatencyEntry {
+  nsCString mName;
+  uint32_t mCount = 0;
+  uint64_t mQueueTimeUs = 0;
+  uint64_t mRunTimeUs = 0;
+  uint64_t mMaxRunTimeUs = 0;
+};
+
 // The TaskController is the core class of the scheduler. It is used to
 // schedule tasks to be executed, as well as to reprioritize tasks that have
 // already been scheduled. The core functions to do this are AddTask and
@@ -323,6 +337,10 @@ class TaskController {
   // Let users know whether the last main thread task runnable did work.
   bool MTTaskRunnableProcessedTask() { return mMTTaskRunnableProcessedTask; }
 
+  // Copy the current contents of the main thread latency ledger. May be
+  // called from any thread.
+  void GetMainThreadLatencyLedger(nsTArray<TaskLatencyEntry>& aEntries);
+
  private:
   friend void ThreadFuncPoolThread(void* aIndex);
 
@@ -348,6 +366,10 @@ class TaskController {
 
   void ProcessUpdatedPriorityModifier(TaskManager* aManager);
 
+  void RecordTaskLatency(Task* aTask, const nsACString& aName,
+                         const TimeStamp& aStart, const TimeStamp& aEnd,
+                         const MutexAutoLock& aProofOfLock);
+
   void ShutdownThreadPoolInternal();
   void ShutdownInternal();
 
@@ -388,6 +410,13 @@ class TaskController {
   // This stores whether the last main thread task runnable did work.
   bool mMTTaskRunnableProcessedTask = false;
 
+  // A fixed-size ledger attributing main thread queue and run times to
+  // runnable names, protected by mGraphMutex. When full, the entry with the
+  // least accumulated run time is the replacement candidate, so the
+  // persistent offenders are retained.
+  static const size_t kLatencyLedgerSize = 64;
+  nsTArray<TaskLatencyEntry> mLatencyLedger;
+
   // Whether our thread pool is initialized. We use this currently to avoid
   // starting the threads in processes where it's never used. This is protected
   // by mPoolInitializationMutex.
@@ -311,8 +311,8 @@ nsresult TimerThread::Shutdown() {
     // might potentially call some code reentering the same lock
     // that leads to unexpected behavior or deadlock.
     // See bug 422472.
-    for (const UniquePtr<Entry>& entry : mTimers) {
-      timers.AppendElement(entry->Take());
+    for (HeapEntry& entry : mTimers) {
+      timers.AppendElement(entry.mEntry->Take());
     }
 
     mTimers.Clear();
@@ -394,7 +394,7 @@ TimerThread::Run() {
       RemoveLeadingCanceledTimersInternal();
 
       if (!mTimers.IsEmpty()) {
-        if (now >= mTimers[0]->Value()->mTimeout || forceRunThisTimer) {
+        if (now >= mTimers[0].mEntry->Value()->mTimeout || forceRunThisTimer) {
         next:
           // NB: AddRef before the Release under RemoveTimerInternal to avoid
           // mRefCnt passing through zero, in case all other refs than the one
@@ -402,7 +402,7 @@ TimerThread::Run() {
           // must be racing with us, blocked in gThread->RemoveTimer waiting
           // for TimerThread::mMonitor, under nsTimerImpl::Release.
 
-          RefPtr<nsTimerImpl> timerRef(mTimers[0]->Take());
+          RefPtr<nsTimerImpl> timerRef(mTimers[0].mEntry->Take());
           RemoveFirstTimerInternal();
 
           MOZ_LOG(GetTimerLog(), LogLevel::Debug,
@@ -451,7 +451,7 @@ TimerThread::Run() {
       RemoveLeadingCanceledTimersInternal();
 
       if (!mTimers.IsEmpty()) {
-        TimeStamp timeout = mTimers[0]->Value()->mTimeout;
+        TimeStamp timeout = mTimers[0].mEntry->Value()->mTimeout;
 
         // Don't wait at all (even for PR_INTERVAL_NO_WAIT) if the next timer
         // is due now or overdue.
@@ -523,7 +523,7 @@ nsresult TimerThread::AddTimer(nsTimerImpl* aTimer) {
   }
 
   // Awaken the timer thread.
-  if (mWaiting && mTimers[0]->Value() == aTimer) {
+  if (mWaiting && mTimers[0].mEntry->Value() == aTimer) {
     mNotified = true;
     mMonitor.Notify();
   }
@@ -560,14 +560,14 @@ TimeStamp TimerThread::FindNextFireTimeForCurrentThread(TimeStamp aDefault,
   TimeStamp firstTimeStamp;
   Entry* initialFirstEntry = nullptr;
   if (!mTimers.IsEmpty()) {
-    initialFirstEntry = mTimers[0].get();
-    firstTimeStamp = mTimers[0]->Timeout();
+    initialFirstEntry = mTimers[0].mEntry.get();
+    firstTimeStamp = mTimers[0].mEntry->Timeout();
   }
 #endif
 
   auto end = mTimers.end();
   while (end != mTimers.begin()) {
-    nsTimerImpl* timer = mTimers[0]->Value();
+    nsTimerImpl* timer = mTimers[0].mEntry->Value();
     if (timer) {
       if (timer->mTimeout > aDefault) {
         timeStamp = aDefault;
@@ -596,28 +596,28 @@ TimeStamp TimerThread::FindNextFireTimeForCurrentThread(TimeStamp aDefault,
       }
     }
 
-    std::pop_heap(mTimers.begin(), end, Entry::UniquePtrLessThan);
+    std::pop_heap(mTimers.begin(), end, HeapEntry::LessThan);
     --end;
   }
 
   while (end != mTimers.end()) {
     ++end;
-    std::push_heap(mTimers.begin(), end, Entry::UniquePtrLessThan);
+    std::push_heap(mTimers.begin(), end, HeapEntry::LessThan);
   }
 
 #ifdef DEBUG
   if (!mTimers.IsEmpty()) {
-    if (firstTimeStamp != mTimers[0]->Timeout()) {
+    if (firstTimeStamp != mTimers[0].mEntry->Timeout()) {
       TimeStamp now = TimeStamp::Now();
       printf_stderr(
-          "firstTimeStamp %f, mTimers[0]->Timeout() %f, "
+          "firstTimeStamp %f, mTimers[0].mEntry->Timeout() %f, "
           "initialFirstTimer %p, current first %p\n",
           (firstTimeStamp - now).ToMilliseconds(),
-          (mTimers[0]->Timeout() - now).ToMilliseconds(), initialFirstEntry,
-          mTimers[0].get());
+          (mTimers[0].mEntry->Timeout() - now).ToMilliseconds(), initialFirstEntry,
+          mTimers[0].mEntry.get());
     }
   }
-  MOZ_ASSERT_IF(!mTimers.IsEmpty(), firstTimeStamp == mTimers[0]->Timeout());
+  MOZ_ASSERT_IF(!mTimers.IsEmpty(), firstTimeStamp == mTimers[0].mEntry->Timeout());
 #endif
 
   return timeStamp;
@@ -634,13 +634,14 @@ bool TimerThread::AddTimerInternal(nsTimerImpl* aTimer) {
 
   LogTimerEvent::LogDispatch(aTimer);
 
-  UniquePtr<Entry>* entry = mTimers.AppendElement(
-      MakeUnique<Entry>(now, aTimer->mTimeout, aTimer), mozilla::fallible);
-  if (!entry) {
+  auto entry = MakeUnique<Entry>(now, aTimer->mTimeout, aTimer);
+  TimeStamp timeout = entry->Timeout();
+  if (!mTimers.AppendElement(HeapEntry{timeout, std::move(entry)},
+                             mozilla::fallible)) {
     return false;
   }
 
-  std::push_heap(mTimers.begin(), mTimers.end(), Entry::UniquePtrLessThan);
+  std::push_heap(mTimers.begin(), mTimers.end(), HeapEntry::LessThan);
 
 #ifdef MOZ_TASK_TRACER
   // Caller of AddTimer is the parent task of its timer event, so we store the
@@ -668,8 +669,8 @@ void TimerThread::RemoveLeadingCanceledTimersInternal() {
   // without actually removing them from the list so we can
   // modify the nsTArray in a single bulk operation.
   auto sortedEnd = mTimers.end();
-  while (sortedEnd != mTimers.begin() && !mTimers[0]->Value()) {
-    std::pop_heap(mTimers.begin(), sortedEnd, Entry::UniquePtrLessThan);
+  while (sortedEnd != mTimers.begin() && !mTimers[0].mEntry->Value()) {
+    std::pop_heap(mTimers.begin(), sortedEnd, HeapEntry::LessThan);
     --sortedEnd;
   }
 
@@ -686,7 +687,7 @@ void TimerThread::RemoveLeadingCanceledTimersInternal() {
 void TimerThread::RemoveFirstTimerInternal() {
   mMonitor.AssertCurrentThreadOwns();
   MOZ_ASSERT(!mTimers.IsEmpty());
-  std::pop_heap(mTimers.begin(), mTimers.end(), Entry::UniquePtrLessThan);
+  std::pop_heap(mTimers.begin(), mTimers.end(), HeapEntry::LessThan);
   mTimers.RemoveLastElement();
 }
 
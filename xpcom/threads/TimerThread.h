@@ -98,17 +98,25 @@ class TimerThread final : public mozilla::Runnable, public nsIObserver {
       return mTimerImpl.forget();
     }
 
-    static bool UniquePtrLessThan(mozilla::UniquePtr<Entry>& aLeft,
-                                  mozilla::UniquePtr<Entry>& aRight) {
+    TimeStamp Timeout() const { return mTimeout; }
+  };
+
+  // The timeout is duplicated in the array element so that the std::*_heap()
+  // maintenance below compares inline keys instead of chasing the Entry
+  // allocation (which has to stay put, because the timer points back at its
+  // holder).
+  struct HeapEntry {
+    TimeStamp mTimeout;
+    mozilla::UniquePtr<Entry> mEntry;
+
+    static bool LessThan(const HeapEntry& aLeft, const HeapEntry& aRight) {
       // This is reversed because std::push_heap() sorts the "largest" to
       // the front of the heap.  We want that to be the earliest timer.
-      return aRight->mTimeout < aLeft->mTimeout;
+      return aRight.mTimeout < aLeft.mTimeout;
     }
-
-    TimeStamp Timeout() const { return mTimeout; }
   };
 
-  nsTArray<mozilla::UniquePtr<Entry>> mTimers;
+  nsTArray<HeapEntry> mTimers;
   uint32_t mAllowedEarlyFiringMicroseconds;
 };
 
@@ -7,7 +7,9 @@
 #include "nsMemoryPressure.h"
 #include "mozilla/Assertions.h"
 #include "mozilla/Atomics.h"
+#include "mozilla/Services.h"
 
+#include "nsIObserverService.h"
 #include "nsThreadUtils.h"
 
 using namespace mozilla;
@@ -16,11 +18,67 @@ static Atomic<int32_t, Relaxed> sMemoryPressurePending;
 static_assert(MemPressure_None == 0,
               "Bad static initialization with the default constructor.");
 
+// Whether the last state delivered to observers was a (new or ongoing)
+// memory pressure. Only accessed on the main thread.
+static bool sUnderMemoryPressure = false;
+
+// How long the idle follow-up purge stage may wait for an idle slice before
+// running anyway.
+static const uint32_t kFollowUpPurgeTimeoutMs = 1000;
+
 MemoryPressureState NS_GetPendingMemoryPressure() {
   int32_t value = sMemoryPressurePending.exchange(MemPressure_None);
   return MemoryPressureState(value);
 }
 
+void NS_NotifyOfPendingMemoryPressure(MemoryPressureState aState) {
+  MOZ_ASSERT(NS_IsMainThread());
+  MOZ_ASSERT(aState != MemPressure_None);
+
+  nsCOMPtr<nsIObserverService> os = services::GetObserverService();
+  if (!os) {
+    NS_WARNING("Can't get observer service!");
+    return;
+  }
+
+  if (aState == MemPressure_Stopping) {
+    sUnderMemoryPressure = false;
+    os->NotifyObservers(nullptr, "memory-pressure-stop", nullptr);
+    return;
+  }
+
+  sUnderMemoryPressure = true;
+
+  // First stage: the regular "memory-pressure" broadcast, delivered
+  // synchronously so the aggressive purges run while memory is short.
+  os->NotifyObservers(nullptr, "memory-pressure",
+                      aState == MemPressure_New ? u"low-memory"
+                                                : u"low-memory-ongoing");
+
+  if (aState != MemPressure_New) {
+    return;
+  }
+
+  // Second stage: a softer "low-memory-ongoing" pass to reclaim allocations
+  // made while the first stage was purging. It runs at idle priority so it
+  // doesn't pile onto the jank of the first stage, and is dropped if the
+  // pressure stopped in the meantime.
+  NS_DispatchToCurrentThreadQueue(
+      NS_NewRunnableFunction("NS_NotifyOfPendingMemoryPressure follow-up",
+                             [] {
+                               if (!sUnderMemoryPressure) {
+                                 return;
+                               }
+                               nsCOMPtr<nsIObserverService> os =
+                                   services::GetObserverService();
+                               if (os) {
+                                 os->NotifyObservers(nullptr, "memory-pressure",
+                                                     u"low-memory-ongoing");
+                               }
+                             }),
+      kFollowUpPurgeTimeoutMs, EventQueuePriority::Idle);
+}
+
 void NS_DispatchEventualMemoryPressure(MemoryPressureState aState) {
   /*
    * A new memory pressure event erases an ongoing (or stop of) memory pressure,
@@ -62,6 +62,21 @@ enum MemoryPressureState {
  */
 MemoryPressureState NS_GetPendingMemoryPressure();
 
+/**
+ * Deliver the observer notifications for the given memory pressure state.
+ *
+ * Rather than asking every consumer to purge in one synchronous broadcast,
+ * delivery is staged: the "memory-pressure" notification fires immediately so
+ * the aggressive purges run while memory is short, and for a new pressure a
+ * follow-up "low-memory-ongoing" stage is dispatched at idle priority to
+ * clean up allocations made while the first stage was purging. The follow-up
+ * stage re-checks the pressure state and is dropped if the pressure has
+ * stopped in the meantime.
+ *
+ * Must be called on the main thread.
+ */
+void NS_NotifyOfPendingMemoryPressure(MemoryPressureState aState);
+
 /**
  * This function causes the main thread to fire a memory pressure event
  * before processing the next event, but if there are no events pending in
@@ -76,6 +76,7 @@ nsresult nsThreadPool::PutEvent(already_AddRefed<nsIRunnable> aEvent,
   // Avoid spawning a new thread while holding the event queue lock...
 
   bool spawnThread = false;
+  bool wakeIdleThread = false;
   uint32_t stackSize = 0;
   {
     MutexAutoLock lock(mMutex);
@@ -99,10 +100,18 @@ nsresult nsThreadPool::PutEvent(already_AddRefed<nsIRunnable> aEvent,
     nsCOMPtr<nsIRunnable> event(aEvent);
     LogRunnable::LogDispatch(event);
     mEvents.PutEvent(event.forget(), EventQueuePriority::Normal, lock);
-    mEventsAvailable.Notify();
+    // Only idle threads wait on mEventsAvailable; if none are waiting the
+    // notify would be wasted (busy threads re-check the queue before going
+    // idle, under this same lock).  Defer the notify itself until after we
+    // drop the lock so the woken thread doesn't immediately block on mMutex.
+    wakeIdleThread = mIdleCount > 0;
     stackSize = mStackSize;
   }
 
+  if (wakeIdleThread) {
+    mEventsAvailable.Notify();
+  }
+
   auto delay = MakeScopeExit([&]() {
     // Delay to encourage the receiving task to run before we do work.
     DelayForChaosMode(ChaosFeature::TaskDispatching, 1000);
@@ -757,6 +757,10 @@ struct nsRunnableMethodReceiver {
   explicit nsRunnableMethodReceiver(ClassType* aObj) : mObj(aObj) {}
   explicit nsRunnableMethodReceiver(RefPtr<ClassType>&& aObj)
       : mObj(std::move(aObj)) {}
+  // Allow receivers passed as std::move(nsCOMPtr) to transfer their
+  // reference instead of churning the refcount.
+  explicit nsRunnableMethodReceiver(nsCOMPtr<ClassType>&& aObj)
+      : mObj(ToRefPtr(std::move(aObj))) {}
   ~nsRunnableMethodReceiver() { Revoke(); }
   ClassType* Get() const { return mObj.get(); }
   void Revoke() { mObj = nullptr; }
@@ -950,6 +954,10 @@ struct StoreRefPtrPassByPtr {
   stored_type m;
   template <typename A>
   MOZ_IMPLICIT StoreRefPtrPassByPtr(A&& a) : m(std::forward<A>(a)) {}
+  // RefPtr can't consume an rvalue nsCOMPtr directly, so route it through
+  // ToRefPtr to keep the move (and skip the AddRef/Release pair).
+  MOZ_IMPLICIT StoreRefPtrPassByPtr(nsCOMPtr<T>&& a)
+      : m(ToRefPtr(std::move(a))) {}
   passed_type PassAsParameter() { return m.get(); }
 };
 template <typename S>